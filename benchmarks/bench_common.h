@@ -0,0 +1,44 @@
+#pragma once
+
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+namespace bench {
+
+// Scratch directory for generated files, created on first use and removed at
+// exit. Lives on tmpfs (/dev/shm) when available so the macrobenchmarks
+// measure the generator rather than the disk; CPP_SCAFFOLD_BENCH_DIR
+// overrides the location.
+const std::filesystem::path& scratchDirectory();
+
+// Silences std::cout/std::cerr for its lifetime; templates print progress and
+// usage hints that would otherwise interleave with the benchmark report
+class ScopedSilence {
+   public:
+    ScopedSilence();
+    ~ScopedSilence();
+
+    ScopedSilence(const ScopedSilence&) = delete;
+    ScopedSilence& operator=(const ScopedSilence&) = delete;
+
+   private:
+    std::streambuf* out_;
+    std::streambuf* err_;
+};
+
+// Changes the working directory for its lifetime; templates create projects
+// relative to the current directory
+class ScopedWorkingDirectory {
+   public:
+    explicit ScopedWorkingDirectory(const std::filesystem::path& dir);
+    ~ScopedWorkingDirectory();
+
+    ScopedWorkingDirectory(const ScopedWorkingDirectory&) = delete;
+    ScopedWorkingDirectory& operator=(const ScopedWorkingDirectory&) = delete;
+
+   private:
+    std::filesystem::path previous_;
+};
+
+}  // namespace bench
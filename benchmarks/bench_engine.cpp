@@ -0,0 +1,208 @@
+// Microbenchmarks for the building blocks every template goes through
+
+#include <benchmark/benchmark.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "bench_common.h"
+#include "documentation/doc_generator.h"
+#include "utils/core/byte_scan.h"
+#include "utils/core/string_utils.h"
+#include "utils/core/template_compiler.h"
+#include "utils/ui/table_formatter.h"
+
+namespace {
+
+// Roughly the shape of a generated source file: mostly literal text with a
+// placeholder every few lines
+std::string makeTemplateText(size_t lines) {
+    std::string text;
+    for (size_t i = 0; i < lines; ++i) {
+        switch (i % 4) {
+            case 0:
+                text += "// {{PROJECT_NAME}} - generated file, line " + std::to_string(i) + "\n";
+                break;
+            case 1:
+                text += "namespace {{NAMESPACE}} { inline int value" + std::to_string(i) +
+                        "() { return " + std::to_string(i) + "; } }\n";
+                break;
+            case 2:
+                text += "#define {{PROJECT_NAME_UPPER}}_FEATURE_" + std::to_string(i) + " 1\n";
+                break;
+            default:
+                text += "static_assert(sizeof(int) >= 4, \"{{AUTHOR}} expects 32-bit int\");\n";
+                break;
+        }
+    }
+    return text;
+}
+
+std::unordered_map<std::string, std::string> makeVariables() {
+    return {{"PROJECT_NAME", "benchmark_project"},
+            {"PROJECT_NAME_UPPER", "BENCHMARK_PROJECT"},
+            {"NAMESPACE", "bench"},
+            {"AUTHOR", "Benchmark Author"}};
+}
+
+void BM_StringUtilsReplace(benchmark::State& state) {
+    std::string text = makeTemplateText(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        std::string result = utils::StringUtils::replace(text, "{{PROJECT_NAME}}", "demo");
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                            static_cast<int64_t>(text.size()));
+}
+BENCHMARK(BM_StringUtilsReplace)->Arg(64)->Arg(1024);
+
+void BM_StringUtilsReplacePlaceholders(benchmark::State& state) {
+    std::string text = makeTemplateText(static_cast<size_t>(state.range(0)));
+    auto variables = makeVariables();
+    for (auto _ : state) {
+        std::string result = utils::StringUtils::replacePlaceholders(text, variables);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                            static_cast<int64_t>(text.size()));
+}
+BENCHMARK(BM_StringUtilsReplacePlaceholders)->Arg(64)->Arg(1024);
+
+void BM_StringUtilsLevenshteinDistance(benchmark::State& state) {
+    size_t length = static_cast<size_t>(state.range(0));
+    std::string a(length, 'a');
+    std::string b(length, 'a');
+    for (size_t i = 0; i < length; i += 3) {
+        b[i] = 'b';
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(utils::StringUtils::levenshteinDistance(a, b));
+    }
+}
+BENCHMARK(BM_StringUtilsLevenshteinDistance)->Arg(8)->Arg(32)->Arg(256);
+
+// Line counting, substring search and UTF-8 checks over ~1 MB of source text, once per
+// instruction set (0 = scalar, 1 = SSE2, 2 = AVX2)
+void BM_ByteScanKernels(benchmark::State& state) {
+    auto requested = static_cast<utils::ScanIsa>(state.range(0));
+    if (utils::ByteScan::setIsa(requested) != requested) {
+        state.SkipWithError("instruction set not supported");
+        return;
+    }
+    std::string text = makeTemplateText(16384);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(utils::StringUtils::countLines(text));
+        benchmark::DoNotOptimize(utils::StringUtils::countOccurrences(text, "{{AUTHOR}}"));
+        benchmark::DoNotOptimize(utils::StringUtils::isValidUtf8(text));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                            static_cast<int64_t>(text.size()) * 3);
+    utils::ByteScan::setIsa(utils::ByteScan::detectIsa());
+}
+BENCHMARK(BM_ByteScanKernels)->Arg(0)->Arg(1)->Arg(2);
+
+void BM_TableFormatterRender(benchmark::State& state) {
+    utils::TableFormatter table;
+    table.addColumn(utils::ColumnConfig("Name", 20));
+    table.addColumn(utils::ColumnConfig("Template", 12));
+    table.addColumn(utils::ColumnConfig("Status", 10));
+    table.addColumn(utils::ColumnConfig("Description", 40));
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        table.addRow({"project-" + std::to_string(i), "console", i % 2 ? "ok" : "failed",
+                      "A generated project with a description long enough to wrap"});
+    }
+    for (auto _ : state) {
+        std::string rendered = table.render();
+        benchmark::DoNotOptimize(rendered);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TableFormatterRender)->Arg(10)->Arg(100)->Arg(1000);
+
+void BM_TableFormatterStream(benchmark::State& state) {
+    for (auto _ : state) {
+        std::ostringstream out;
+        utils::TableFormatter table;
+        table.addColumn(utils::ColumnConfig("Name", 20));
+        table.addColumn(utils::ColumnConfig("Template", 12));
+        table.addColumn(utils::ColumnConfig("Status", 10));
+        table.addColumn(utils::ColumnConfig("Description", 40));
+        table.beginStream(out);
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            table.addRow({"project-" + std::to_string(i), "console", i % 2 ? "ok" : "failed",
+                          "A generated project with a description long enough to wrap"});
+        }
+        table.endStream();
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TableFormatterStream)->Arg(100)->Arg(1000)->Arg(10000);
+
+// Header-heavy source tree with documented classes and free functions
+std::filesystem::path makeSourceTree(size_t files) {
+    auto root = bench::scratchDirectory() / ("sources_" + std::to_string(files));
+    if (std::filesystem::exists(root)) {
+        return root;
+    }
+    std::filesystem::create_directories(root / "include");
+    std::filesystem::create_directories(root / "src");
+    for (size_t i = 0; i < files; ++i) {
+        std::string name = "Widget" + std::to_string(i);
+        std::ofstream header(root / "include" / (name + ".h"));
+        header << "#pragma once\n#include <string>\n\nnamespace app {\n\n"
+               << "/**\n * @brief " << name << " does one thing well.\n */\n"
+               << "class " << name << " {\npublic:\n"
+               << "    /// Creates the widget\n    explicit " << name << "(int size);\n"
+               << "    /**\n     * @brief Returns the size\n     * @return size in bytes\n     */\n"
+               << "    int size() const;\n"
+               << "    /// Renames the widget\n    void rename(const std::string& name);\n"
+               << "private:\n    int size_;\n};\n\n"
+               << "/// Free helper for " << name << "\nint helper" << i << "(int a, int b);\n\n"
+               << "}  // namespace app\n";
+        std::ofstream source(root / "src" / (name + ".cpp"));
+        source << "#include \"" << name << ".h\"\n\nnamespace app {\n"
+               << name << "::" << name << "(int size) : size_(size) {}\n"
+               << "int " << name << "::size() const { return size_; }\n"
+               << "int helper" << i << "(int a, int b) { return a + b; }\n}\n";
+    }
+    return root;
+}
+
+void BM_APIDocExtractorExtractFromDirectory(benchmark::State& state) {
+    auto root = makeSourceTree(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        documentation::APIDocExtractor extractor;
+        benchmark::DoNotOptimize(extractor.extractFromDirectory(root));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * 2);
+}
+BENCHMARK(BM_APIDocExtractorExtractFromDirectory)->Arg(10)->Arg(100)->Unit(benchmark::kMillisecond);
+
+// What CustomTemplate does per file when it is created: every file is compiled
+// once up front, then each pass renders all of them against one variable map.
+// Only rendering is timed, no project directory or disk writes
+void BM_CustomTemplateRender(benchmark::State& state) {
+    std::string content = makeTemplateText(200);
+    std::vector<utils::CompiledTemplate> files;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        files.push_back(utils::CompiledTemplate::compile(content));
+    }
+    auto variables = makeVariables();
+
+    for (auto _ : state) {
+        for (const auto& file : files) {
+            std::string rendered = file.render(variables);
+            benchmark::DoNotOptimize(rendered);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * state.range(0) *
+                            static_cast<int64_t>(content.size()));
+}
+BENCHMARK(BM_CustomTemplateRender)->Arg(10)->Arg(100);
+
+}  // namespace
@@ -0,0 +1,112 @@
+#include <benchmark/benchmark.h>
+#include <spdlog/spdlog.h>
+
+#include <cstdlib>
+#include <string>
+#include <system_error>
+
+#include "bench_common.h"
+
+#ifdef _WIN32
+#include <process.h>
+#include <stdlib.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace bench {
+
+namespace {
+
+// Discards everything written to it
+class NullBuffer : public std::streambuf {
+   protected:
+    int overflow(int c) override {
+        return c;
+    }
+    std::streamsize xsputn(const char*, std::streamsize count) override {
+        return count;
+    }
+};
+
+NullBuffer nullBuffer;
+
+struct Scratch {
+    std::filesystem::path path;
+
+    Scratch() {
+        std::filesystem::path base;
+        if (const char* overrideDir = std::getenv("CPP_SCAFFOLD_BENCH_DIR")) {
+            base = overrideDir;
+        } else if (std::filesystem::is_directory("/dev/shm")) {
+            base = "/dev/shm";
+        } else {
+            base = std::filesystem::temp_directory_path();
+        }
+#ifdef _WIN32
+        path = base / ("cpp_scaffold_bench_" + std::to_string(_getpid()));
+#else
+        path = base / ("cpp_scaffold_bench_" + std::to_string(getpid()));
+#endif
+        std::filesystem::create_directories(path);
+    }
+
+    ~Scratch() {
+        std::error_code ec;
+        std::filesystem::remove_all(path, ec);
+    }
+};
+
+}  // namespace
+
+const std::filesystem::path& scratchDirectory() {
+    static Scratch scratch;
+    return scratch.path;
+}
+
+ScopedSilence::ScopedSilence()
+    : out_(std::cout.rdbuf(&nullBuffer)), err_(std::cerr.rdbuf(&nullBuffer)) {}
+
+ScopedSilence::~ScopedSilence() {
+    std::cout.rdbuf(out_);
+    std::cerr.rdbuf(err_);
+}
+
+ScopedWorkingDirectory::ScopedWorkingDirectory(const std::filesystem::path& dir)
+    : previous_(std::filesystem::current_path()) {
+    std::filesystem::current_path(dir);
+}
+
+ScopedWorkingDirectory::~ScopedWorkingDirectory() {
+    std::error_code ec;
+    std::filesystem::current_path(previous_, ec);
+}
+
+}  // namespace bench
+
+int main(int argc, char** argv) {
+    // Log output would dominate the short benchmarks and flood the report
+    spdlog::set_level(spdlog::level::off);
+
+    // Keep configuration, caches and profiles away from the user's real ones
+    auto configDir = bench::scratchDirectory() / "config";
+#ifdef _WIN32
+    _putenv_s("CPP_SCAFFOLD_CONFIG_DIR", configDir.string().c_str());
+#else
+    setenv("CPP_SCAFFOLD_CONFIG_DIR", configDir.c_str(), 1);
+#endif
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+
+    // Recorded in the JSON context so results can be compared across commits
+    benchmark::AddCustomContext("cpp_scaffold_version", CPP_SCAFFOLD_BENCH_VERSION);
+    benchmark::AddCustomContext("cpp_scaffold_build_type", CPP_SCAFFOLD_BENCH_BUILD_TYPE);
+    benchmark::AddCustomContext("scratch_directory", bench::scratchDirectory().string());
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,72 @@
+// Macrobenchmarks: end-to-end project generation for every template type
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bench_common.h"
+#include "cli/types/cli_options.h"
+#include "templates/template_manager.h"
+
+namespace {
+
+void BM_CreateProject(benchmark::State& state, TemplateType templateType) {
+    auto workDir = bench::scratchDirectory() / "projects";
+    std::filesystem::create_directories(workDir);
+    bench::ScopedWorkingDirectory cwd(workDir);
+    bench::ScopedSilence silence;
+
+    // Only the generator itself: no git, no package manager, no prompts
+    CliOptions options;
+    options.templateType = templateType;
+    options.buildSystem = BuildSystem::CMake;
+    options.packageManager = PackageManager::None;
+    options.includeTests = true;
+    options.testFramework = TestFramework::GTest;
+    options.initGit = false;
+    options.createInitialCommit = false;
+
+    TemplateManager manager;
+    size_t run = 0;
+    for (auto _ : state) {
+        options.projectName = "bench_project_" + std::to_string(run++);
+        if (!manager.createProject(options)) {
+            state.SkipWithError("TemplateManager::createProject failed");
+            break;
+        }
+        state.PauseTiming();
+        std::filesystem::remove_all(workDir / options.projectName);
+        state.ResumeTiming();
+    }
+}
+
+const std::vector<std::pair<const char*, TemplateType>> templateTypes = {
+        {"Console", TemplateType::Console},
+        {"Lib", TemplateType::Lib},
+        {"HeaderOnlyLib", TemplateType::HeaderOnlyLib},
+        {"Modules", TemplateType::Modules},
+        {"Gui", TemplateType::Gui},
+        {"Network", TemplateType::Network},
+        {"Embedded", TemplateType::Embedded},
+        {"WebService", TemplateType::WebService},
+        {"GameEngine", TemplateType::GameEngine},
+        {"QtApp", TemplateType::QtApp},
+        {"SfmlApp", TemplateType::SfmlApp},
+        {"BoostApp", TemplateType::BoostApp},
+        {"TestProject", TemplateType::TestProject},
+};
+
+// One benchmark per template type, e.g. BM_CreateProject/Console. MultiExecutable is
+// left out because TemplateManager has no factory registered for it
+const bool registered = [] {
+    for (const auto& [name, type] : templateTypes) {
+        benchmark::RegisterBenchmark((std::string("BM_CreateProject/") + name).c_str(),
+                                     BM_CreateProject, type)
+                ->Unit(benchmark::kMillisecond);
+    }
+    return true;
+}();
+
+}  // namespace
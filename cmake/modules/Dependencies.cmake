@@ -110,7 +110,18 @@ endfunction()
 
 # Setup Optional Dependencies
 function(setup_optional_dependencies)
-    # Add optional dependencies here
+    # zlib - in-process git object writing; without it the git CLI is used
+    option(ENABLE_ZLIB "Use zlib for in-process compression" ON)
+    if(ENABLE_ZLIB)
+        find_package(ZLIB QUIET)
+        if(ZLIB_FOUND)
+            message(STATUS "Using system zlib: ${ZLIB_VERSION_STRING}")
+        else()
+            message(STATUS "zlib not found, falling back to external tools")
+        endif()
+    endif()
+
+    # Add further optional dependencies here
     # Example:
     # option(ENABLE_CURL "Enable HTTP client support" OFF)
     # if(ENABLE_CURL)
@@ -158,6 +169,11 @@ function(link_core_dependencies target)
         nlohmann_json::nlohmann_json
     )
 
+    if(TARGET ZLIB::ZLIB)
+        target_link_libraries(${target} PRIVATE ZLIB::ZLIB)
+        target_compile_definitions(${target} PRIVATE CPP_SCAFFOLD_HAS_ZLIB=1)
+    endif()
+
     setup_filesystem_library(${target})
     setup_platform_libraries(${target})
 endfunction()
@@ -169,6 +169,8 @@ function(create_comprehensive_test target_name)
         set(PREFIX ${COMP_TEST_TEST_PREFIX})
     endif()
 
+    # GoogleTest's discovery script path is function-scoped, so include it where it is used
+    include(GoogleTest)
     gtest_discover_tests(${target_name}
         WORKING_DIRECTORY ${WORKING_DIR}
         PROPERTIES VS_DEBUGGER_WORKING_DIRECTORY ${WORKING_DIR}
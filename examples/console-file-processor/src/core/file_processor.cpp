@@ -18,6 +18,8 @@
 #include <future>
 #include <iomanip>
 #include <cctype>
+#include <cstring>
+#include <vector>
 
 namespace fs = std::filesystem;
 
@@ -300,20 +302,35 @@ FileStats FileProcessor::analyze_file(const std::string& filename) {
     stats.encoding = detect_encoding(filename);
     stats.file_type = detect_file_type(filename);
     
-    std::string line;
-    while (std::getline(file, line)) {
-        stats.lines++;
-        stats.characters += line.length() + 1; // +1 for newline
-        
-        // Count words
-        std::istringstream iss(line);
-        std::string word;
-        while (iss >> word) {
-            stats.words++;
+    // Scan fixed-size blocks instead of materializing every line: newlines are
+    // found with memchr and words are tracked across block boundaries
+    std::vector<char> buffer(64 * 1024);
+    std::size_t newlines = 0;
+    bool in_word = false;
+    char last = '\n';
+    while (file.read(buffer.data(), static_cast<std::streamsize>(buffer.size())) ||
+           file.gcount() > 0) {
+        const auto count = static_cast<std::size_t>(file.gcount());
+        const char* end = buffer.data() + count;
+        for (const char* p = buffer.data();
+             (p = static_cast<const char*>(std::memchr(p, '\n', end - p))) != nullptr; ++p) {
+            ++newlines;
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            bool space = std::isspace(static_cast<unsigned char>(buffer[i])) != 0;
+            if (!space && !in_word) {
+                stats.words++;
+            }
+            in_word = !space;
         }
+        stats.bytes += count;
+        last = buffer[count - 1];
     }
     
-    stats.bytes = file.tellg();
+    // Same figures the line-by-line count gave: a last line without a newline
+    // still counts, and every line contributes its length plus one
+    stats.lines = newlines + (stats.bytes > 0 && last != '\n' ? 1 : 0);
+    stats.characters = stats.bytes - newlines + stats.lines;
     return stats;
 }
 
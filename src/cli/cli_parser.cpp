@@ -99,7 +99,7 @@ CliOptions CliParser::promptUserForOptions(const CliOptions& defaultOptions) {
 
   // Network library for network projects
   if (options.templateType == TemplateType::Network) {
-    std::vector<std::string_view> networkLibs = {"asio", "boost", "poco"};
+    std::vector<std::string_view> networkLibs = {"asio", "boost", "poco", "native"};
     std::string networkLib = UserInput::readChoiceWithStyle(
         "Select network library", networkLibs, "asio", utils::Color::BrightGreen);
 
@@ -41,7 +41,8 @@ void showHelp(Language lang) {
     std::cout << "  cpp-scaffold interactive\n";
     std::cout << "  cpp-scaffold config\n";
     std::cout << "  cpp-scaffold list-templates\n";
-    std::cout << "  cpp-scaffold validate [project-path]\n\n";
+    std::cout << "  cpp-scaffold validate [project-path]\n";
+    std::cout << "  cpp-scaffold batch <manifest.json> [--jobs <n>]\n\n";
 
     // Core Options Section
     TerminalUtils::showCard(
@@ -81,9 +82,13 @@ void showHelp(Language lang) {
     // Specialized Options Section
     TerminalUtils::showCard(
             "Specialized Options",
-            {"--network-lib <library>      Network library (asio, boost, poco)",
+            {"--network-lib <library>      Network library (asio, boost, poco, native)",
+             "--network-concurrency <mode> Network server threading (single, pool)",
              "--gui-frameworks <frameworks> GUI frameworks (qt, gtk, fltk, imgui, wxwidgets)",
              "--game-frameworks <frameworks> Game frameworks (sdl2, sfml, allegro)",
+             "--game-ecs <mode>            Game engine ECS layout (classic, sparse-set)",
+             "--game-perf                  Game engine job system, frame allocators and profiler",
+             "--web-perf                   Web service worker pool, metrics and load tools",
              "--graphics-libs <libraries>  Graphics libraries (opengl, vulkan, directx)",
              "--doc-formats <formats>      Documentation formats (markdown, html, pdf)"});
 
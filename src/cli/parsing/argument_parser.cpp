@@ -77,6 +77,11 @@ CliOptions parseArguments(int argc, char* argv[]) {
       cli_commands::validateConfiguration(options);
       options.showHelp = true;
       return options;
+    case CommandType::Batch:
+      // Batch runs are driven from main, which owns the shared TemplateManager
+      spdlog::error("The batch command cannot be combined with other commands");
+      options.showHelp = true;
+      return options;
     case CommandType::Unknown:
       spdlog::error("Unknown command: {}", args[0]);
       options.showHelp = true;
@@ -258,6 +263,40 @@ bool parseBuildOptions(CliOptions& options, const std::vector<std::string>& args
     return true;
   }
 
+  if (arg == "--network-concurrency") {
+    if (hasValue(args, index)) {
+      options.networkConcurrency = getNextValue(args, index);
+    }
+    return true;
+  }
+
+  if (arg.rfind("--network-concurrency=", 0) == 0) {
+    options.networkConcurrency = arg.substr(arg.find('=') + 1);
+    return true;
+  }
+
+  if (arg == "--game-ecs") {
+    if (hasValue(args, index)) {
+      options.gameEcs = getNextValue(args, index);
+    }
+    return true;
+  }
+
+  if (arg.rfind("--game-ecs=", 0) == 0) {
+    options.gameEcs = arg.substr(arg.find('=') + 1);
+    return true;
+  }
+
+  if (arg == "--game-perf") {
+    options.gamePerf = true;
+    return true;
+  }
+
+  if (arg == "--web-perf") {
+    options.webPerf = true;
+    return true;
+  }
+
   return false;
 }
 
@@ -552,6 +591,9 @@ CommandType detectCommand(const std::vector<std::string>& args) {
   if (command == "validate-config") {
     return CommandType::ValidateConfig;
   }
+  if (command == "batch") {
+    return CommandType::Batch;
+  }
   if (command == "create") {
     return CommandType::Create;
   }
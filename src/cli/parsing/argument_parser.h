@@ -39,6 +39,7 @@ enum class CommandType {
   ShowProfile,
   Validate,
   ValidateConfig,
+  Batch,
   Help,
   Version,
   Unknown
@@ -15,7 +15,11 @@ struct CliOptions {
   TemplateType templateType = TemplateType::Console;
   BuildSystem buildSystem = BuildSystem::CMake;
   PackageManager packageManager = PackageManager::Vcpkg;
-  std::optional<std::string> networkLibrary; // For network projects: asio, boost, poco
+  std::optional<std::string> networkLibrary; // For network projects: asio, boost, poco, native
+  std::string networkConcurrency = "single";  // For network projects: single, pool
+  std::string gameEcs = "classic";  // For game engine projects: classic, sparse-set
+  bool gamePerf = false;  // For game engine projects: job system, frame allocators, profiler
+  bool webPerf = false;  // For web service projects: worker pool, keep-alive tuning, metrics
 
   // Enhanced C++ configuration
   CppStandard cppStandard = CppStandard::Cpp17;
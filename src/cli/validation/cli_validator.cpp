@@ -70,12 +70,27 @@ ValidationResult CliValidator::validateBuildConfiguration(const CliOptions& opti
         if (!options.networkLibrary.has_value() || options.networkLibrary->empty()) {
             result.addError("Network template requires a network library to be specified");
         } else {
-            std::vector<std::string> validNetworkLibs = {"asio", "boost", "poco"};
+            std::vector<std::string> validNetworkLibs = {"asio", "boost", "poco", "native"};
             if (std::find(validNetworkLibs.begin(), validNetworkLibs.end(),
                           *options.networkLibrary) == validNetworkLibs.end()) {
                 result.addWarning("Unknown network library: " + *options.networkLibrary);
             }
         }
+
+        if (options.networkConcurrency != "single" && options.networkConcurrency != "pool") {
+            result.addWarning("Unknown network concurrency mode: " + options.networkConcurrency +
+                              " (expected single or pool)");
+        } else if (options.networkConcurrency == "pool" && options.networkLibrary == "poco") {
+            result.addWarning(
+                    "The pool concurrency mode needs asio, boost or native; poco projects use a "
+                    "single reactor thread");
+        }
+    }
+
+    if (options.templateType == TemplateType::GameEngine && options.gameEcs != "classic" &&
+        options.gameEcs != "sparse-set") {
+        result.addWarning("Unknown game ECS layout: " + options.gameEcs +
+                          " (expected classic or sparse-set)");
     }
 
     return result;
@@ -2,11 +2,20 @@
 #include "../utils/core/file_utils.h"
 #include "../utils/core/string_utils.h"
 #include <spdlog/spdlog.h>
+#include <algorithm>
 #include <fstream>
 #include <chrono>
+#include <iterator>
 #include <iomanip>
 #include <sstream>
 #include <cstdlib>
+#include <atomic>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
 
 using namespace utils;
 using namespace cli_enums;
@@ -14,6 +23,19 @@ using json = nlohmann::json;
 
 namespace config {
 
+namespace {
+// Distinguishes the temporary snapshot files of concurrent writers
+std::string uniqueName() {
+    static std::atomic<unsigned> counter{0};
+#ifdef _WIN32
+    int pid = _getpid();
+#else
+    int pid = static_cast<int>(getpid());
+#endif
+    return std::to_string(pid) + "-" + std::to_string(counter++);
+}
+}  // namespace
+
 ConfigManager& ConfigManager::getInstance() {
     static ConfigManager instance;
     return instance;
@@ -26,6 +48,10 @@ bool ConfigManager::loadConfiguration() {
             return false;
         }
 
+        // Profiles and custom templates are indexed on first use, so commands
+        // that never touch them do not read either directory
+        invalidateIndexes();
+
         auto configPath = getConfigFilePath();
         if (!FileUtils::fileExists(configPath.string())) {
             spdlog::info("Configuration file not found, creating default configuration");
@@ -51,12 +77,6 @@ bool ConfigManager::loadConfiguration() {
             }
         }
 
-        // Load profiles and custom templates
-        if (!loadProfiles() || !loadCustomTemplates()) {
-            spdlog::error("Failed to load profiles or custom templates");
-            return false;
-        }
-
         // Load environment variables
         loadEnvironmentVariables();
 
@@ -111,9 +131,8 @@ bool ConfigManager::resetToDefaults() {
 
         // Clear current configuration
         m_config.clear();
-        m_profiles.clear();
-        m_customTemplates.clear();
         m_environmentOverrides.clear();
+        invalidateIndexes();
 
         // Initialize with defaults
         initializeDefaultConfiguration();
@@ -142,9 +161,12 @@ bool ConfigManager::saveProfile(const std::string& profileName, const CliOptions
         profile.schemaVersion = CONFIG_SCHEMA_VERSION;
 
         m_profiles[profileName] = profile;
+        if (!writeProfileFile(profile)) {
+            return false;
+        }
 
         spdlog::info("Profile '{}' saved successfully", profileName);
-        return saveProfiles();
+        return true;
 
     } catch (const std::exception& e) {
         spdlog::error("Error saving profile '{}': {}", profileName, e.what());
@@ -156,8 +178,21 @@ std::optional<CliOptions> ConfigManager::loadProfile(const std::string& profileN
     try {
         auto it = m_profiles.find(profileName);
         if (it == m_profiles.end()) {
-            spdlog::warn("Profile '{}' not found", profileName);
-            return std::nullopt;
+            // Only the requested profile is parsed and validated
+            auto& index = profileIndex();
+            auto entry = index.entries.find(profileName);
+            if (entry == index.entries.end()) {
+                spdlog::warn("Profile '{}' not found", profileName);
+                return std::nullopt;
+            }
+
+            auto parsed = readProfileFile(entry->second.path);
+            if (!parsed || !validateProfile(*parsed)) {
+                spdlog::error("Profile '{}' is invalid: {}", profileName,
+                              entry->second.path.string());
+                return std::nullopt;
+            }
+            it = m_profiles.emplace(profileName, std::move(*parsed)).first;
         }
 
         const auto& profile = it->second;
@@ -179,10 +214,11 @@ std::optional<CliOptions> ConfigManager::loadProfile(const std::string& profileN
 }
 
 std::vector<std::string> ConfigManager::listProfiles() {
+    const auto& index = profileIndex();
     std::vector<std::string> profileNames;
-    profileNames.reserve(m_profiles.size());
+    profileNames.reserve(index.entries.size());
 
-    for (const auto& [name, profile] : m_profiles) {
+    for (const auto& [name, entry] : index.entries) {
         profileNames.push_back(name);
     }
 
@@ -191,15 +227,25 @@ std::vector<std::string> ConfigManager::listProfiles() {
 
 bool ConfigManager::deleteProfile(const std::string& profileName) {
     try {
-        auto it = m_profiles.find(profileName);
-        if (it == m_profiles.end()) {
+        auto& index = profileIndex();
+        auto it = index.entries.find(profileName);
+        if (it == index.entries.end()) {
             spdlog::warn("Profile '{}' not found", profileName);
             return false;
         }
 
-        m_profiles.erase(it);
+        std::error_code ec;
+        std::filesystem::remove(it->second.path, ec);
+        if (ec) {
+            spdlog::error("Failed to remove profile file {}: {}", it->second.path.string(),
+                          ec.message());
+            return false;
+        }
+
+        m_profiles.erase(profileName);
+        removeIndexEntry(index, "profiles", profileName);
         spdlog::info("Profile '{}' deleted successfully", profileName);
-        return saveProfiles();
+        return true;
 
     } catch (const std::exception& e) {
         spdlog::error("Error deleting profile '{}': {}", profileName, e.what());
@@ -295,6 +341,10 @@ std::filesystem::path ConfigManager::getCacheDirectory() {
     return getConfigDirectory() / "cache";
 }
 
+std::filesystem::path ConfigManager::getIndexSnapshotPath() {
+    return getCacheDirectory() / "config_index.cbor";
+}
+
 bool ConfigManager::ensureConfigDirectoryExists() {
     try {
         auto configDir = getConfigDirectory();
@@ -341,174 +391,494 @@ std::string ConfigManager::getCurrentTimestamp() {
     return ss.str();
 }
 
-bool ConfigManager::loadProfiles() {
+std::optional<ConfigProfile> ConfigManager::readProfileFile(const std::filesystem::path& path) {
     try {
-        auto profilesDir = getProfilesDirectory();
-        if (!FileUtils::directoryExists(profilesDir.string())) {
-            return true; // No profiles directory is fine
+        std::string content = FileUtils::readFromFile(path.string());
+        if (content.empty()) {
+            return std::nullopt;
         }
 
-        auto profileFiles = FileUtils::listFiles(profilesDir.string());
-        for (const auto& profileFile : profileFiles) {
-            if (FileUtils::getFileExtension(profileFile) != ".json") {
-                continue;
-            }
+        json profileJson = json::parse(content);
+        ConfigProfile profile;
+        profile.name = profileJson.value("name", "");
+        profile.description = profileJson.value("description", "");
+        profile.settings = profileJson.value("settings", json::object());
+        profile.createdAt = profileJson.value("createdAt", "");
+        profile.lastModified = profileJson.value("lastModified", "");
+        profile.schemaVersion = profileJson.value("schemaVersion", 0);
+        return profile;
 
-            std::string content = FileUtils::readFromFile(profileFile);
-            if (content.empty()) {
-                continue;
-            }
+    } catch (const std::exception& e) {
+        spdlog::error("Error reading profile {}: {}", path.string(), e.what());
+        return std::nullopt;
+    }
+}
 
-            json profileJson = json::parse(content);
-            ConfigProfile profile;
-            profile.name = profileJson.value("name", "");
-            profile.description = profileJson.value("description", "");
-            profile.settings = profileJson.value("settings", json::object());
-            profile.createdAt = profileJson.value("createdAt", "");
-            profile.lastModified = profileJson.value("lastModified", "");
-            profile.schemaVersion = profileJson.value("schemaVersion", 0);
-
-            if (!profile.name.empty()) {
-                m_profiles[profile.name] = profile;
-            }
+bool ConfigManager::writeProfileFile(const ConfigProfile& profile) {
+    try {
+        auto profilesDir = getProfilesDirectory();
+        if (!FileUtils::createDirectory(profilesDir.string())) {
+            return false;
+        }
+
+        json profileJson;
+        profileJson["name"] = profile.name;
+        profileJson["description"] = profile.description;
+        profileJson["settings"] = profile.settings;
+        profileJson["createdAt"] = profile.createdAt;
+        profileJson["lastModified"] = profile.lastModified;
+        profileJson["schemaVersion"] = profile.schemaVersion;
+
+        // Overwrite the file the profile was indexed from, which need not be
+        // named after the profile
+        auto& index = profileIndex();
+        auto existing = index.entries.find(profile.name);
+        auto profilePath = existing != index.entries.end()
+                                   ? existing->second.path
+                                   : profilesDir / (profile.name + ".json");
+        if (!FileUtils::writeToFile(profilePath.string(), profileJson.dump(2))) {
+            spdlog::error("Failed to save profile: {}", profile.name);
+            return false;
         }
 
-        spdlog::info("Loaded {} profiles", m_profiles.size());
+        updateIndexEntry(index, "profiles", profile.name, profile.description, profilePath);
         return true;
 
     } catch (const std::exception& e) {
-        spdlog::error("Error loading profiles: {}", e.what());
+        spdlog::error("Error saving profile '{}': {}", profile.name, e.what());
         return false;
     }
 }
 
 bool ConfigManager::saveProfiles() {
-    try {
-        auto profilesDir = getProfilesDirectory();
-        if (!FileUtils::createDirectory(profilesDir.string())) {
+    // Profiles that were never loaded are unchanged on disk
+    for (const auto& [name, profile] : m_profiles) {
+        if (!writeProfileFile(profile)) {
             return false;
         }
+    }
+    return true;
+}
 
-        for (const auto& [name, profile] : m_profiles) {
-            json profileJson;
-            profileJson["name"] = profile.name;
-            profileJson["description"] = profile.description;
-            profileJson["settings"] = profile.settings;
-            profileJson["createdAt"] = profile.createdAt;
-            profileJson["lastModified"] = profile.lastModified;
-            profileJson["schemaVersion"] = profile.schemaVersion;
+std::optional<CustomTemplateConfig> ConfigManager::readCustomTemplateFile(
+        const std::filesystem::path& path) {
+    try {
+        std::string content = FileUtils::readFromFile(path.string());
+        if (content.empty()) {
+            return std::nullopt;
+        }
 
-            auto profilePath = profilesDir / (name + ".json");
-            if (!FileUtils::writeToFile(profilePath.string(), profileJson.dump(2))) {
-                spdlog::error("Failed to save profile: {}", name);
-                return false;
+        json templateJson = json::parse(content);
+        CustomTemplateConfig templateConfig;
+        templateConfig.name = templateJson.value("name", "");
+        templateConfig.description = templateJson.value("description", "");
+        templateConfig.templatePath = templateJson.value("templatePath", "");
+        templateConfig.author = templateJson.value("author", "");
+        templateConfig.version = templateJson.value("version", "1.0.0");
+        templateConfig.createdAt = templateJson.value("createdAt", "");
+
+        // Load variables
+        if (templateJson.contains("variables")) {
+            for (const auto& [key, value] : templateJson["variables"].items()) {
+                templateConfig.variables[key] = value.get<std::string>();
             }
         }
 
-        return true;
+        // Load required files
+        if (templateJson.contains("requiredFiles")) {
+            for (const auto& file : templateJson["requiredFiles"]) {
+                templateConfig.requiredFiles.push_back(file.get<std::string>());
+            }
+        }
+
+        return templateConfig;
 
     } catch (const std::exception& e) {
-        spdlog::error("Error saving profiles: {}", e.what());
-        return false;
+        spdlog::error("Error reading custom template {}: {}", path.string(), e.what());
+        return std::nullopt;
     }
 }
 
-bool ConfigManager::loadCustomTemplates() {
+bool ConfigManager::writeCustomTemplateFile(const CustomTemplateConfig& templateConfig) {
     try {
         auto templatesDir = getCustomTemplatesDirectory();
-        if (!FileUtils::directoryExists(templatesDir.string())) {
-            return true; // No templates directory is fine
+        if (!FileUtils::createDirectory(templatesDir.string())) {
+            return false;
         }
 
-        auto templateFiles = FileUtils::listFiles(templatesDir.string());
-        for (const auto& templateFile : templateFiles) {
-            if (FileUtils::getFileExtension(templateFile) != ".json") {
-                continue;
-            }
-
-            std::string content = FileUtils::readFromFile(templateFile);
-            if (content.empty()) {
-                continue;
-            }
-
-            json templateJson = json::parse(content);
-            CustomTemplateConfig templateConfig;
-            templateConfig.name = templateJson.value("name", "");
-            templateConfig.description = templateJson.value("description", "");
-            templateConfig.templatePath = templateJson.value("templatePath", "");
-            templateConfig.author = templateJson.value("author", "");
-            templateConfig.version = templateJson.value("version", "1.0.0");
-            templateConfig.createdAt = templateJson.value("createdAt", "");
-
-            // Load variables
-            if (templateJson.contains("variables")) {
-                for (const auto& [key, value] : templateJson["variables"].items()) {
-                    templateConfig.variables[key] = value.get<std::string>();
-                }
-            }
+        json templateJson;
+        templateJson["name"] = templateConfig.name;
+        templateJson["description"] = templateConfig.description;
+        templateJson["templatePath"] = templateConfig.templatePath.string();
+        templateJson["author"] = templateConfig.author;
+        templateJson["version"] = templateConfig.version;
+        templateJson["createdAt"] = templateConfig.createdAt;
+
+        // Save variables
+        templateJson["variables"] = json::object();
+        for (const auto& [key, value] : templateConfig.variables) {
+            templateJson["variables"][key] = value;
+        }
 
-            // Load required files
-            if (templateJson.contains("requiredFiles")) {
-                for (const auto& file : templateJson["requiredFiles"]) {
-                    templateConfig.requiredFiles.push_back(file.get<std::string>());
-                }
-            }
+        // Save required files
+        templateJson["requiredFiles"] = json::array();
+        for (const auto& file : templateConfig.requiredFiles) {
+            templateJson["requiredFiles"].push_back(file);
+        }
 
-            if (!templateConfig.name.empty()) {
-                m_customTemplates[templateConfig.name] = templateConfig;
-            }
+        auto& index = templateIndex();
+        auto existing = index.entries.find(templateConfig.name);
+        auto templatePath = existing != index.entries.end()
+                                    ? existing->second.path
+                                    : templatesDir / (templateConfig.name + ".json");
+        if (!FileUtils::writeToFile(templatePath.string(), templateJson.dump(2))) {
+            spdlog::error("Failed to save custom template: {}", templateConfig.name);
+            return false;
         }
 
-        spdlog::info("Loaded {} custom templates", m_customTemplates.size());
+        updateIndexEntry(index, "templates", templateConfig.name, templateConfig.description,
+                         templatePath);
         return true;
 
     } catch (const std::exception& e) {
-        spdlog::error("Error loading custom templates: {}", e.what());
+        spdlog::error("Error saving custom template '{}': {}", templateConfig.name, e.what());
         return false;
     }
 }
 
 bool ConfigManager::saveCustomTemplates() {
-    try {
-        auto templatesDir = getCustomTemplatesDirectory();
-        if (!FileUtils::createDirectory(templatesDir.string())) {
+    for (const auto& [name, templateConfig] : m_customTemplates) {
+        if (!writeCustomTemplateFile(templateConfig)) {
             return false;
         }
+    }
+    return true;
+}
 
-        for (const auto& [name, templateConfig] : m_customTemplates) {
-            json templateJson;
-            templateJson["name"] = templateConfig.name;
-            templateJson["description"] = templateConfig.description;
-            templateJson["templatePath"] = templateConfig.templatePath.string();
-            templateJson["author"] = templateConfig.author;
-            templateJson["version"] = templateConfig.version;
-            templateJson["createdAt"] = templateConfig.createdAt;
+bool ConfigManager::registerCustomTemplate(const CustomTemplateConfig& templateConfig) {
+    if (!validateCustomTemplate(templateConfig)) {
+        spdlog::error("Invalid custom template: {}", templateConfig.name);
+        return false;
+    }
 
-            // Save variables
-            templateJson["variables"] = json::object();
-            for (const auto& [key, value] : templateConfig.variables) {
-                templateJson["variables"][key] = value;
-            }
+    CustomTemplateConfig stored = templateConfig;
+    if (stored.createdAt.empty()) {
+        stored.createdAt = getCurrentTimestamp();
+    }
+    if (!writeCustomTemplateFile(stored)) {
+        return false;
+    }
 
-            // Save required files
-            templateJson["requiredFiles"] = json::array();
-            for (const auto& file : templateConfig.requiredFiles) {
-                templateJson["requiredFiles"].push_back(file);
-            }
+    m_customTemplates[stored.name] = stored;
+    spdlog::info("Custom template '{}' registered", stored.name);
+    return true;
+}
 
-            auto templatePath = templatesDir / (name + ".json");
-            if (!FileUtils::writeToFile(templatePath.string(), templateJson.dump(2))) {
-                spdlog::error("Failed to save custom template: {}", name);
-                return false;
-            }
+std::optional<CustomTemplateConfig> ConfigManager::getCustomTemplate(const std::string& name) {
+    auto it = m_customTemplates.find(name);
+    if (it != m_customTemplates.end()) {
+        return it->second;
+    }
+
+    auto& index = templateIndex();
+    auto entry = index.entries.find(name);
+    if (entry == index.entries.end()) {
+        return std::nullopt;
+    }
+
+    auto parsed = readCustomTemplateFile(entry->second.path);
+    if (!parsed || !validateCustomTemplate(*parsed)) {
+        spdlog::error("Custom template '{}' is invalid: {}", name, entry->second.path.string());
+        return std::nullopt;
+    }
+    return m_customTemplates.emplace(name, std::move(*parsed)).first->second;
+}
+
+std::vector<CustomTemplateConfig> ConfigManager::listCustomTemplates() {
+    std::vector<std::string> names;
+    for (const auto& [name, entry] : templateIndex().entries) {
+        names.push_back(name);
+    }
+
+    std::vector<CustomTemplateConfig> templates;
+    templates.reserve(names.size());
+    for (const auto& name : names) {
+        if (auto templateConfig = getCustomTemplate(name)) {
+            templates.push_back(std::move(*templateConfig));
         }
+    }
+    return templates;
+}
+
+bool ConfigManager::removeCustomTemplate(const std::string& name) {
+    auto& index = templateIndex();
+    auto it = index.entries.find(name);
+    if (it == index.entries.end()) {
+        spdlog::warn("Custom template '{}' not found", name);
+        return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::remove(it->second.path, ec);
+    if (ec) {
+        spdlog::error("Failed to remove custom template file {}: {}", it->second.path.string(),
+                      ec.message());
+        return false;
+    }
+
+    m_customTemplates.erase(name);
+    removeIndexEntry(index, "templates", name);
+    return true;
+}
+
+bool ConfigManager::validateProfile(const ConfigProfile& profile) {
+    if (profile.name.empty()) {
+        spdlog::warn("Profile has no name");
+        return false;
+    }
 
+    // Unknown enum values would silently fall back to defaults in jsonToCliOptions
+    auto checkEnum = [&](const char* key, auto parse) {
+        auto it = profile.settings.find(key);
+        if (it == profile.settings.end()) {
+            return true;
+        }
+        if (!it->second.is_string() || !parse(it->second.get<std::string>())) {
+            spdlog::warn("Profile '{}' has an invalid {}: {}", profile.name, key,
+                         it->second.dump());
+            return false;
+        }
         return true;
+    };
 
-    } catch (const std::exception& e) {
-        spdlog::error("Error saving custom templates: {}", e.what());
+    return checkEnum("templateType", [](const std::string& v) { return to_template_type(v); }) &&
+           checkEnum("buildSystem", [](const std::string& v) { return to_build_system(v); }) &&
+           checkEnum("packageManager",
+                     [](const std::string& v) { return to_package_manager(v); }) &&
+           checkEnum("testFramework", [](const std::string& v) { return to_test_framework(v); });
+}
+
+bool ConfigManager::validateCustomTemplate(const CustomTemplateConfig& templateConfig) {
+    if (!utils::isValidTemplateName(templateConfig.name)) {
+        spdlog::warn("Invalid custom template name: {}", templateConfig.name);
+        return false;
+    }
+    if (templateConfig.templatePath.empty()) {
+        spdlog::warn("Custom template '{}' has no template path", templateConfig.name);
         return false;
     }
+    return true;
+}
+
+namespace {
+
+// Bump when the snapshot layout changes; older snapshots are then ignored
+constexpr int INDEX_SNAPSHOT_VERSION = 1;
+
+json readSnapshot(const std::filesystem::path& path) {
+    auto bytes = ::utils::MappedFile::open(path);
+    if (!bytes) {
+        return json::object();
+    }
+    json snapshot = json::from_cbor(bytes.value.view(), true, false);
+    if (snapshot.is_discarded() || !snapshot.is_object() ||
+        snapshot.value("version", 0) != INDEX_SNAPSHOT_VERSION) {
+        return json::object();
+    }
+    return snapshot;
+}
+
+std::int64_t modificationTime(const std::filesystem::directory_entry& entry,
+                              std::error_code& ec) {
+    return static_cast<std::int64_t>(entry.last_write_time(ec).time_since_epoch().count());
+}
+
+}  // namespace
+
+ConfigManager::DirectoryIndex& ConfigManager::profileIndex() {
+    refreshIndex(m_profileIndex, getProfilesDirectory(), "profiles");
+    return m_profileIndex;
+}
+
+ConfigManager::DirectoryIndex& ConfigManager::templateIndex() {
+    refreshIndex(m_templateIndex, getCustomTemplatesDirectory(), "templates");
+    return m_templateIndex;
+}
+
+void ConfigManager::invalidateIndexes() {
+    // Profiles and templates are written through on save, so the parsed
+    // copies are only a cache of the files
+    m_profileIndex = DirectoryIndex();
+    m_templateIndex = DirectoryIndex();
+    m_profiles.clear();
+    m_customTemplates.clear();
+}
+
+void ConfigManager::refreshIndex(DirectoryIndex& index, const std::filesystem::path& directory,
+                                 const std::string& section) {
+    if (index.loaded && index.directory == directory) {
+        return;
+    }
+
+    // The configuration directory moved (e.g. CPP_SCAFFOLD_CONFIG_DIR changed),
+    // so nothing parsed from the old one applies
+    if (index.loaded) {
+        if (&index == &m_profileIndex) {
+            m_profiles.clear();
+        } else {
+            m_customTemplates.clear();
+        }
+    }
+
+    index = DirectoryIndex();
+    index.directory = directory;
+    index.loaded = true;
+
+    std::error_code ec;
+    if (!std::filesystem::is_directory(directory, ec)) {
+        return;
+    }
+
+    json cached = json::object();
+    try {
+        json snapshot = readSnapshot(getIndexSnapshotPath());
+        if (snapshot.contains(section) &&
+            snapshot[section].value("directory", "") == directory.string()) {
+            cached = snapshot[section].value("files", json::object());
+        }
+    } catch (const std::exception& e) {
+        spdlog::debug("Ignoring configuration index snapshot: {}", e.what());
+    }
+
+    // Files whose size and mtime match the snapshot are not opened at all
+    bool changed = false;
+    size_t reused = 0;
+    for (std::filesystem::directory_iterator it(directory, ec), end; !ec && it != end;
+         it.increment(ec)) {
+        const auto& file = *it;
+        if (file.path().extension() != ".json" || !file.is_regular_file(ec)) {
+            continue;
+        }
+
+        IndexEntry entry;
+        entry.path = file.path();
+        entry.size = file.file_size(ec);
+        entry.mtime = modificationTime(file, ec);
+        if (ec) {
+            ec.clear();
+            continue;
+        }
+
+        std::string fileName = file.path().filename().string();
+        auto hit = cached.find(fileName);
+        if (hit != cached.end() && hit->value("size", std::uintmax_t{0}) == entry.size &&
+            hit->value("mtime", std::int64_t{0}) == entry.mtime) {
+            entry.name = hit->value("name", "");
+            entry.description = hit->value("description", "");
+            cached.erase(hit);
+            ++reused;
+        } else {
+            changed = true;
+            json header = json::parse(FileUtils::readFromFile(entry.path.string()), nullptr,
+                                      false);
+            if (header.is_object()) {
+                entry.name = header.value("name", "");
+                entry.description = header.value("description", "");
+            } else {
+                spdlog::warn("Skipping malformed configuration file: {}", entry.path.string());
+            }
+        }
+
+        // Unnamed, malformed and duplicate files stay in the snapshot so they
+        // are not re-read on every run, but cannot be looked up
+        if (entry.name.empty() || index.entries.count(entry.name) != 0) {
+            index.unindexed.push_back(std::move(entry));
+        } else {
+            index.entries.emplace(entry.name, std::move(entry));
+        }
+    }
+
+    // Anything left in the cached listing was deleted
+    changed = changed || !cached.empty();
+
+    spdlog::debug("Indexed {} {} ({} unchanged)", index.entries.size(), section, reused);
+    if (changed) {
+        saveIndexSnapshot(index, section);
+    }
+}
+
+void ConfigManager::updateIndexEntry(DirectoryIndex& index, const std::string& section,
+                                     const std::string& name, const std::string& description,
+                                     const std::filesystem::path& path) {
+    std::error_code ec;
+    std::filesystem::directory_entry file(path, ec);
+    IndexEntry entry;
+    entry.name = name;
+    entry.description = description;
+    entry.path = path;
+    entry.size = file.file_size(ec);
+    entry.mtime = modificationTime(file, ec);
+    index.unindexed.erase(std::remove_if(index.unindexed.begin(), index.unindexed.end(),
+                                         [&path](const IndexEntry& e) { return e.path == path; }),
+                          index.unindexed.end());
+    index.entries[name] = std::move(entry);
+    saveIndexSnapshot(index, section);
+}
+
+void ConfigManager::removeIndexEntry(DirectoryIndex& index, const std::string& section,
+                                     const std::string& name) {
+    index.entries.erase(name);
+    saveIndexSnapshot(index, section);
+}
+
+void ConfigManager::saveIndexSnapshot(const DirectoryIndex& index, const std::string& section) {
+    try {
+        auto snapshotPath = getIndexSnapshotPath();
+        json snapshot = readSnapshot(snapshotPath);
+        snapshot["version"] = INDEX_SNAPSHOT_VERSION;
+
+        json files = json::object();
+        auto addFile = [&files](const IndexEntry& entry) {
+            files[entry.path.filename().string()] = {{"name", entry.name},
+                                                     {"description", entry.description},
+                                                     {"size", entry.size},
+                                                     {"mtime", entry.mtime}};
+        };
+        for (const auto& [name, entry] : index.entries) {
+            addFile(entry);
+        }
+        for (const auto& entry : index.unindexed) {
+            addFile(entry);
+        }
+        snapshot[section] = {{"directory", index.directory.string()}, {"files", files}};
+
+        // Written beside the snapshot under a name no other writer uses and
+        // renamed over it, so a concurrent reader sees either the old or the
+        // new index and concurrent writers never share a half-written file
+        std::error_code ec;
+        std::filesystem::create_directories(snapshotPath.parent_path(), ec);
+        auto tempPath = snapshotPath;
+        tempPath += "." + uniqueName() + ".tmp";
+        std::vector<std::uint8_t> bytes = json::to_cbor(snapshot);
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(bytes.data()),
+                       static_cast<std::streamsize>(bytes.size()));
+            if (!file) {
+                file.close();
+                std::filesystem::remove(tempPath, ec);
+                spdlog::debug("Could not write configuration index snapshot");
+                return;
+            }
+        }
+        std::filesystem::rename(tempPath, snapshotPath, ec);
+        if (ec) {
+            std::filesystem::remove(tempPath, ec);
+        }
+
+    } catch (const std::exception& e) {
+        spdlog::debug("Could not write configuration index snapshot: {}", e.what());
+    }
 }
 
 void ConfigManager::registerDefaultConfigEntries() {
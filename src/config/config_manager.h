@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../cli/types/cli_options.h"
+#include <cstdint>
 #include <filesystem>
 #include <map>
 #include <memory>
@@ -113,6 +114,7 @@ public:
     std::filesystem::path getProfilesDirectory();
     std::filesystem::path getCustomTemplatesDirectory();
     std::filesystem::path getCacheDirectory();
+    std::filesystem::path getIndexSnapshotPath();
 
     // Configuration queries
     template<typename T>
@@ -132,24 +134,64 @@ public:
     bool restoreFromBackup(const std::string& backupName);
     std::vector<std::string> listBackups();
 
+    // Configuration conversion helpers (profile JSON schema)
+    CliOptions jsonToCliOptions(const nlohmann::json& json);
+    nlohmann::json cliOptionsToJson(const CliOptions& options);
+
 private:
     ConfigManager() = default;
     ~ConfigManager() = default;
     ConfigManager(const ConfigManager&) = delete;
     ConfigManager& operator=(const ConfigManager&) = delete;
 
+    // One indexed .json file of the profiles or templates directory. Only the
+    // fields needed for listing are kept; the file is parsed in full on request
+    struct IndexEntry {
+        std::string name;
+        std::string description;
+        std::filesystem::path path;
+        std::uintmax_t size = 0;
+        std::int64_t mtime = 0;
+    };
+
+    // Entries of one directory by name, rebuilt from the on-disk snapshot
+    // (re-reading only files whose mtime or size changed) on first use
+    struct DirectoryIndex {
+        std::filesystem::path directory;
+        std::map<std::string, IndexEntry> entries;
+        std::vector<IndexEntry> unindexed;  // no usable name, kept for the snapshot
+        bool loaded = false;
+    };
+
     // Internal data
     nlohmann::json m_config;
-    std::map<std::string, ConfigProfile> m_profiles;
-    std::map<std::string, CustomTemplateConfig> m_customTemplates;
+    std::map<std::string, ConfigProfile> m_profiles;              // parsed on demand
+    std::map<std::string, CustomTemplateConfig> m_customTemplates; // parsed on demand
     std::map<std::string, std::string> m_environmentOverrides;
     std::vector<std::string> m_validationErrors;
+    DirectoryIndex m_profileIndex;
+    DirectoryIndex m_templateIndex;
 
     // Internal methods
-    bool loadProfiles();
     bool saveProfiles();
-    bool loadCustomTemplates();
     bool saveCustomTemplates();
+    bool writeProfileFile(const ConfigProfile& profile);
+    bool writeCustomTemplateFile(const CustomTemplateConfig& templateConfig);
+    std::optional<ConfigProfile> readProfileFile(const std::filesystem::path& path);
+    std::optional<CustomTemplateConfig> readCustomTemplateFile(const std::filesystem::path& path);
+
+    // Directory index helpers
+    DirectoryIndex& profileIndex();
+    DirectoryIndex& templateIndex();
+    void refreshIndex(DirectoryIndex& index, const std::filesystem::path& directory,
+                      const std::string& section);
+    void updateIndexEntry(DirectoryIndex& index, const std::string& section,
+                          const std::string& name, const std::string& description,
+                          const std::filesystem::path& path);
+    void removeIndexEntry(DirectoryIndex& index, const std::string& section,
+                          const std::string& name);
+    void saveIndexSnapshot(const DirectoryIndex& index, const std::string& section);
+    void invalidateIndexes();
 
     void initializeDefaultConfiguration();
     void registerDefaultConfigEntries();
@@ -157,10 +199,6 @@ private:
     std::string getCurrentTimestamp();
     bool createDirectoryStructure();
 
-    // Configuration conversion helpers
-    CliOptions jsonToCliOptions(const nlohmann::json& json);
-    nlohmann::json cliOptionsToJson(const CliOptions& options);
-
     // Validation helpers
     bool validateConfigEntry(const ConfigEntry& entry, const nlohmann::json& value);
     bool validateProfile(const ConfigProfile& profile);
@@ -1,15 +1,43 @@
 #include "doc_generator.h"
+#include "../config/config_manager.h"
 #include "../utils/core/file_utils.h"
 #include "../utils/core/string_utils.h"
+#include "../utils/core/template_compiler.h"
+#include "../utils/core/hash_utils.h"
+#include "../utils/core/parallel.h"
 #include <spdlog/spdlog.h>
+#include <nlohmann/json.hpp>
 #include <sstream>
 #include <regex>
 #include <chrono>
 #include <iomanip>
 #include <fstream>
+#include <algorithm>
 
 namespace documentation {
 
+namespace {
+
+// Where the API doc cache of projectPath lives: DocConfig::apiCacheFile taken
+// relative to the project, or by default one file per project under the
+// tool's cache directory, named after the project's absolute path
+std::filesystem::path apiCacheLocation(const DocConfig& config,
+                                       const std::filesystem::path& projectPath) {
+    if (!config.apiCacheFile.empty()) {
+        return projectPath / config.apiCacheFile;
+    }
+    std::error_code ec;
+    auto absolute = std::filesystem::weakly_canonical(projectPath, ec);
+    if (ec) {
+        absolute = std::filesystem::absolute(projectPath, ec);
+    }
+    std::string key = utils::Sha256::toHex(utils::Sha256::hash(absolute.string())).substr(0, 16);
+    return config::ConfigManager::getInstance().getCacheDirectory() / "api_docs" /
+           (key + ".cbor");
+}
+
+}  // namespace
+
 DocGenerator::DocGenerator(const DocConfig& config) : m_config(config) {
 }
 
@@ -120,6 +148,9 @@ bool DocGenerator::generateAPIDocumentation(const std::filesystem::path& project
         spdlog::info("Generating comprehensive API documentation...");
 
         APIDocExtractor extractor;
+        if (m_config.useApiCache) {
+            extractor.setCacheFile(apiCacheLocation(m_config, projectPath));
+        }
         auto sourceDir = projectPath / m_config.sourceDirectory;
         auto outputDir = projectPath / m_config.outputDirectory;
 
@@ -789,31 +820,36 @@ std::string DocGenerator::generateLicenseContent() {
 }
 
 std::string DocGenerator::replaceVariables(const std::string& content) const {
-    std::string result = content;
-
-    // Replace project variables
-    result = utils::StringUtils::replace(result, "{{PROJECT_NAME}}", m_config.projectName);
-    result = utils::StringUtils::replace(result, "{{PROJECT_VERSION}}", m_config.projectVersion);
-    result = utils::StringUtils::replace(result, "{{PROJECT_DESCRIPTION}}", m_config.projectDescription);
-    result = utils::StringUtils::replace(result, "{{AUTHOR}}", m_config.author);
-    result = utils::StringUtils::replace(result, "{{EMAIL}}", m_config.email);
-    result = utils::StringUtils::replace(result, "{{LICENSE}}", m_config.license);
-    result = utils::StringUtils::replace(result, "{{REPOSITORY}}", m_config.repository);
-    result = utils::StringUtils::replace(result, "{{WEBSITE}}", m_config.website);
-
-    // Replace current date
+    // Current date
     auto now = std::chrono::system_clock::now();
     auto time_t = std::chrono::system_clock::to_time_t(now);
     auto tm = *std::localtime(&time_t);
 
     char dateBuffer[32];
     std::strftime(dateBuffer, sizeof(dateBuffer), "%Y-%m-%d", &tm);
-    result = utils::StringUtils::replace(result, "{{CURRENT_DATE}}", std::string(dateBuffer));
+    std::string currentDate(dateBuffer);
 
     std::strftime(dateBuffer, sizeof(dateBuffer), "%Y", &tm);
-    result = utils::StringUtils::replace(result, "{{CURRENT_YEAR}}", std::string(dateBuffer));
-
-    return result;
+    std::string currentYear(dateBuffer);
+
+    // Project variables are substituted in a single pass over the content
+    const std::unordered_map<std::string, const std::string*> variables = {
+            {"PROJECT_NAME", &m_config.projectName},
+            {"PROJECT_VERSION", &m_config.projectVersion},
+            {"PROJECT_DESCRIPTION", &m_config.projectDescription},
+            {"AUTHOR", &m_config.author},
+            {"EMAIL", &m_config.email},
+            {"LICENSE", &m_config.license},
+            {"REPOSITORY", &m_config.repository},
+            {"WEBSITE", &m_config.website},
+            {"CURRENT_DATE", &currentDate},
+            {"CURRENT_YEAR", &currentYear}};
+
+    return utils::CompiledTemplate::compile(content).renderWith(
+            [&variables](const std::string& name) -> const std::string* {
+                auto it = variables.find(name);
+                return it != variables.end() ? it->second : nullptr;
+            });
 }
 
 std::string DocGenerator::generateIndex(const std::vector<std::string>& files) const {
@@ -1184,10 +1220,133 @@ limitations under the License.)";
 }
 
 // APIDocExtractor implementation
+namespace {
+
+// Bump when the cache layout or the parser output changes; older caches are ignored
+constexpr int API_CACHE_VERSION = 1;
+
+bool isHeaderFile(const std::filesystem::path& path) {
+    auto extension = path.extension().string();
+    return extension == ".h" || extension == ".hpp" || extension == ".hxx";
+}
+
+nlohmann::json classToJson(const ClassInfo& info) {
+    return {{"name", info.name},
+            {"description", info.description},
+            {"namespace", info.namespace_},
+            {"baseClasses", info.baseClasses},
+            {"methods", info.methods},
+            {"members", info.members},
+            {"methodDocs", info.methodDocs},
+            {"memberDocs", info.memberDocs}};
+}
+
+ClassInfo classFromJson(const nlohmann::json& json) {
+    ClassInfo info;
+    info.name = json.value("name", "");
+    info.description = json.value("description", "");
+    info.namespace_ = json.value("namespace", "");
+    info.baseClasses = json.value("baseClasses", std::vector<std::string>{});
+    info.methods = json.value("methods", std::vector<std::string>{});
+    info.members = json.value("members", std::vector<std::string>{});
+    info.methodDocs = json.value("methodDocs", std::map<std::string, std::string>{});
+    info.memberDocs = json.value("memberDocs", std::map<std::string, std::string>{});
+    return info;
+}
+
+nlohmann::json functionToJson(const FunctionInfo& info) {
+    return {{"name", info.name},
+            {"description", info.description},
+            {"returnType", info.returnType},
+            {"parameters", info.parameters},
+            {"namespace", info.namespace_},
+            {"isStatic", info.isStatic},
+            {"isConst", info.isConst}};
+}
+
+FunctionInfo functionFromJson(const nlohmann::json& json) {
+    FunctionInfo info;
+    info.name = json.value("name", "");
+    info.description = json.value("description", "");
+    info.returnType = json.value("returnType", "");
+    info.parameters =
+            json.value("parameters", std::vector<std::pair<std::string, std::string>>{});
+    info.namespace_ = json.value("namespace", "");
+    info.isStatic = json.value("isStatic", false);
+    info.isConst = json.value("isConst", false);
+    return info;
+}
+
+// The per-file records of a cache written for sourceDir, or an empty object
+nlohmann::json loadApiCache(const std::filesystem::path& cacheFile,
+                            const std::filesystem::path& sourceDir) {
+    if (cacheFile.empty()) {
+        return nlohmann::json::object();
+    }
+    auto bytes = utils::MappedFile::open(cacheFile);
+    if (!bytes) {
+        return nlohmann::json::object();
+    }
+    auto cache = nlohmann::json::from_cbor(bytes.value.view(), true, false);
+    if (cache.is_discarded() || !cache.is_object() ||
+        cache.value("version", 0) != API_CACHE_VERSION ||
+        cache.value("directory", "") != sourceDir.generic_string() ||
+        !cache.contains("files") || !cache["files"].is_object()) {
+        return nlohmann::json::object();
+    }
+    return std::move(cache["files"]);
+}
+
+void saveApiCache(const std::filesystem::path& cacheFile, const std::filesystem::path& sourceDir,
+                  nlohmann::json files) {
+    nlohmann::json cache = {{"version", API_CACHE_VERSION},
+                            {"directory", sourceDir.generic_string()},
+                            {"files", std::move(files)}};
+
+    // Written beside the cache and renamed over it, so a concurrent docs run
+    // reads either the old or the new cache
+    std::error_code ec;
+    std::filesystem::create_directories(cacheFile.parent_path(), ec);
+    auto tempPath = cacheFile;
+    tempPath += ".tmp";
+    std::vector<std::uint8_t> bytes = nlohmann::json::to_cbor(cache);
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(bytes.data()),
+                   static_cast<std::streamsize>(bytes.size()));
+        if (!file) {
+            spdlog::debug("Could not write API documentation cache {}", cacheFile.string());
+            return;
+        }
+    }
+    std::filesystem::rename(tempPath, cacheFile, ec);
+    if (ec) {
+        std::filesystem::remove(tempPath, ec);
+    }
+}
+
+}  // namespace
+
 APIDocExtractor::APIDocExtractor() {
     // Initialize empty containers
 }
 
+void APIDocExtractor::setCacheFile(const std::filesystem::path& cacheFile) {
+    m_cacheFile = cacheFile;
+}
+
+void APIDocExtractor::setMaxWorkers(size_t workers) {
+    m_maxWorkers = workers;
+}
+
+size_t APIDocExtractor::getParsedFileCount() const {
+    return m_parsedFiles;
+}
+
+size_t APIDocExtractor::getCachedFileCount() const {
+    return m_cachedFiles;
+}
+
 bool APIDocExtractor::extractFromDirectory(const std::filesystem::path& sourceDir) {
     try {
         if (!std::filesystem::exists(sourceDir) || !std::filesystem::is_directory(sourceDir)) {
@@ -1199,20 +1358,130 @@ bool APIDocExtractor::extractFromDirectory(const std::filesystem::path& sourceDi
         m_namespaces.clear();
         m_classes.clear();
         m_functions.clear();
+        m_parsedFiles = 0;
+        m_cachedFiles = 0;
 
-        // Recursively process all header files
+        // Sorted so the merged result does not depend on directory order
+        std::vector<std::filesystem::path> headers;
         for (const auto& entry : std::filesystem::recursive_directory_iterator(sourceDir)) {
-            if (entry.is_regular_file()) {
-                auto extension = entry.path().extension().string();
-                if (extension == ".h" || extension == ".hpp" || extension == ".hxx") {
-                    if (!extractFromFile(entry.path())) {
-                        spdlog::warn("Failed to extract from file: {}", entry.path().string());
-                    }
+            if (entry.is_regular_file() && isHeaderFile(entry.path())) {
+                headers.push_back(entry.path());
+            }
+        }
+        std::sort(headers.begin(), headers.end());
+
+        const nlohmann::json cached = loadApiCache(m_cacheFile, sourceDir);
+
+        struct FileTask {
+            std::string key;
+            FileResult result;
+            nlohmann::json record;
+            bool fromCache = false;
+            bool recordChanged = true;
+            std::string error;
+        };
+        std::vector<FileTask> tasks(headers.size());
+
+        // Each header is read, hashed and (unless its hash is cached) parsed on
+        // its own; nothing is shared between files until the merge below
+        auto process = [&](size_t i) {
+            auto& task = tasks[i];
+            const auto& path = headers[i];
+            task.key = path.lexically_relative(sourceDir).generic_string();
+
+            std::error_code ec;
+            auto size = static_cast<std::uint64_t>(std::filesystem::file_size(path, ec));
+            auto mtime = static_cast<std::int64_t>(
+                    std::filesystem::last_write_time(path, ec).time_since_epoch().count());
+            auto previous = cached.find(task.key);
+            bool hasPrevious = previous != cached.end() && previous->is_object();
+
+            utils::MappedFile content;
+            std::string hash;
+            bool unchanged = false;
+            if (!ec && hasPrevious && previous->value("size", std::uint64_t{0}) == size &&
+                previous->value("mtime", std::int64_t{0}) == mtime) {
+                // Same size and mtime: the recorded hash still describes the file
+                unchanged = true;
+                task.record = *previous;
+                task.recordChanged = false;
+            } else {
+                auto mapped = utils::MappedFile::open(path);
+                if (!mapped) {
+                    task.error = "cannot read file";
+                    return;
+                }
+                content = std::move(mapped.value);
+                hash = utils::Sha256::toHex(utils::Sha256::hash(content.view()));
+                unchanged = hasPrevious && previous->value("sha256", "") == hash;
+            }
+
+            if (unchanged) {
+                task.fromCache = true;
+                for (const auto& cls : previous->value("classes", nlohmann::json::array())) {
+                    task.result.classes.push_back(classFromJson(cls));
+                }
+                for (const auto& func : previous->value("functions", nlohmann::json::array())) {
+                    task.result.functions.push_back(functionFromJson(func));
+                }
+                if (!task.recordChanged) {
+                    return;
                 }
+            } else {
+                task.result = parseContent(content.view());
             }
+
+            nlohmann::json classes = nlohmann::json::array();
+            for (const auto& cls : task.result.classes) {
+                classes.push_back(classToJson(cls));
+            }
+            nlohmann::json functions = nlohmann::json::array();
+            for (const auto& func : task.result.functions) {
+                functions.push_back(functionToJson(func));
+            }
+            task.record = {{"sha256", hash},
+                           {"size", size},
+                           {"mtime", mtime},
+                           {"classes", std::move(classes)},
+                           {"functions", std::move(functions)}};
+        };
+
+        utils::parallelFor(headers.size(), m_maxWorkers, [&](size_t i) {
+            try {
+                process(i);
+            } catch (const std::exception& e) {
+                tasks[i].error = e.what();
+            }
+        });
+
+        // Merge in path order and keep records only for headers that still exist
+        nlohmann::json files = nlohmann::json::object();
+        bool cacheChanged = cached.size() != headers.size();
+        for (size_t i = 0; i < tasks.size(); ++i) {
+            auto& task = tasks[i];
+            if (!task.error.empty()) {
+                spdlog::warn("Failed to extract from file: {} ({})", headers[i].string(),
+                             task.error);
+                cacheChanged = true;
+                continue;
+            }
+            if (task.fromCache) {
+                ++m_cachedFiles;
+            } else {
+                ++m_parsedFiles;
+            }
+            cacheChanged = cacheChanged || task.recordChanged;
+            files[task.key] = std::move(task.record);
+            mergeResult(std::move(task.result));
+        }
+        buildNamespaces();
+
+        if (!m_cacheFile.empty() && cacheChanged) {
+            saveApiCache(m_cacheFile, sourceDir, std::move(files));
         }
 
-        spdlog::info("Extracted API documentation from {} files", m_classes.size() + m_functions.size());
+        spdlog::info("Extracted API documentation from {} headers ({} parsed, {} unchanged)",
+                     headers.size(), m_parsedFiles, m_cachedFiles);
         return true;
     } catch (const std::exception& e) {
         spdlog::error("Error extracting from directory: {}", e.what());
@@ -1222,113 +1491,163 @@ bool APIDocExtractor::extractFromDirectory(const std::filesystem::path& sourceDi
 
 bool APIDocExtractor::extractFromFile(const std::filesystem::path& sourceFile) {
     try {
-        std::ifstream file(sourceFile);
-        if (!file.is_open()) {
+        auto content = utils::MappedFile::open(sourceFile);
+        if (!content) {
             return false;
         }
 
-        // Helper lambda for C++17 compatibility
-        auto starts_with = [](const std::string& str, const std::string& prefix) {
-            return str.size() >= prefix.size() && str.substr(0, prefix.size()) == prefix;
-        };
+        mergeResult(parseContent(content.value.view()));
+        buildNamespaces();
+        return true;
+    } catch (const std::exception& e) {
+        spdlog::error("Error extracting from file {}: {}", sourceFile.string(), e.what());
+        return false;
+    }
+}
+
+void APIDocExtractor::mergeResult(FileResult&& result) {
+    m_classes.insert(m_classes.end(), std::make_move_iterator(result.classes.begin()),
+                     std::make_move_iterator(result.classes.end()));
+    m_functions.insert(m_functions.end(), std::make_move_iterator(result.functions.begin()),
+                       std::make_move_iterator(result.functions.end()));
+}
+
+void APIDocExtractor::buildNamespaces() {
+    // Named namespaces in first-seen order; global declarations stay top-level only
+    m_namespaces.clear();
+    std::map<std::string, size_t> byName;
+    auto namespaceFor = [&](const std::string& name) -> NamespaceInfo& {
+        auto [it, inserted] = byName.emplace(name, m_namespaces.size());
+        if (inserted) {
+            NamespaceInfo ns;
+            ns.name = name;
+            ns.description = "Namespace " + name;
+            m_namespaces.push_back(std::move(ns));
+        }
+        return m_namespaces[it->second];
+    };
+
+    for (const auto& cls : m_classes) {
+        if (!cls.namespace_.empty()) {
+            namespaceFor(cls.namespace_).classes.push_back(cls);
+        }
+    }
+    for (const auto& func : m_functions) {
+        if (!func.namespace_.empty()) {
+            namespaceFor(func.namespace_).functions.push_back(func);
+        }
+    }
+}
 
-        std::string line;
-        std::string currentNamespace;
-        bool inClass = false;
-        ClassInfo currentClass;
+APIDocExtractor::FileResult APIDocExtractor::parseContent(std::string_view content) {
+    FileResult result;
 
-        while (std::getline(file, line)) {
-            // Simple parsing - this is a basic implementation
-            // In a real implementation, you'd use a proper C++ parser
+    // Helper lambda for C++17 compatibility
+    auto starts_with = [](const std::string& str, const std::string& prefix) {
+        return str.size() >= prefix.size() && str.compare(0, prefix.size(), prefix) == 0;
+    };
 
-            // Trim whitespace
-            line.erase(0, line.find_first_not_of(" \t"));
-            line.erase(line.find_last_not_of(" \t") + 1);
+    std::string line;
+    std::string currentNamespace;
+    bool inClass = false;
+    ClassInfo currentClass;
 
-            // Skip empty lines and comments
-            if (line.empty() || starts_with(line, "//") || starts_with(line, "/*")) {
-                continue;
-            }
+    size_t lineStart = 0;
+    while (lineStart < content.size()) {
+        size_t lineEnd = content.find('\n', lineStart);
+        if (lineEnd == std::string::npos) {
+            lineEnd = content.size();
+        }
+        line.assign(content, lineStart, lineEnd - lineStart);
+        lineStart = lineEnd + 1;
+
+        // Simple parsing - this is a basic implementation
+        // In a real implementation, you'd use a proper C++ parser
 
-            // Extract namespace
-            if (starts_with(line, "namespace ")) {
-                auto pos = line.find(' ');
-                if (pos != std::string::npos) {
-                    currentNamespace = line.substr(pos + 1);
-                    // Remove any trailing characters like {
-                    auto bracePos = currentNamespace.find('{');
-                    if (bracePos != std::string::npos) {
-                        currentNamespace = currentNamespace.substr(0, bracePos);
-                    }
-                    // Trim again
-                    currentNamespace.erase(0, currentNamespace.find_first_not_of(" \t"));
-                    currentNamespace.erase(currentNamespace.find_last_not_of(" \t") + 1);
+        // Trim whitespace
+        line.erase(0, line.find_first_not_of(" \t"));
+        line.erase(line.find_last_not_of(" \t") + 1);
+
+        // Skip empty lines and comments
+        if (line.empty() || starts_with(line, "//") || starts_with(line, "/*")) {
+            continue;
+        }
+
+        // Extract namespace
+        if (starts_with(line, "namespace ")) {
+            auto pos = line.find(' ');
+            if (pos != std::string::npos) {
+                currentNamespace = line.substr(pos + 1);
+                // Remove any trailing characters like {
+                auto bracePos = currentNamespace.find('{');
+                if (bracePos != std::string::npos) {
+                    currentNamespace = currentNamespace.substr(0, bracePos);
                 }
+                // Trim again
+                currentNamespace.erase(0, currentNamespace.find_first_not_of(" \t"));
+                currentNamespace.erase(currentNamespace.find_last_not_of(" \t") + 1);
             }
+        }
 
-            // Extract class/struct
-            if (starts_with(line, "class ") || starts_with(line, "struct ")) {
-                inClass = true;
-                currentClass = ClassInfo{};
-                currentClass.namespace_ = currentNamespace;
-
-                auto pos = line.find(' ');
-                if (pos != std::string::npos) {
-                    std::string rest = line.substr(pos + 1);
-                    auto spacePos = rest.find(' ');
-                    auto bracePos = rest.find('{');
-                    auto colonPos = rest.find(':');
-
-                    size_t endPos = std::min({spacePos, bracePos, colonPos});
-                    if (endPos == std::string::npos) {
-                        endPos = rest.length();
-                    }
-
-                    currentClass.name = rest.substr(0, endPos);
-                    currentClass.description = "Class " + currentClass.name;
+        // Extract class/struct
+        if (starts_with(line, "class ") || starts_with(line, "struct ")) {
+            inClass = true;
+            currentClass = ClassInfo{};
+            currentClass.namespace_ = currentNamespace;
+
+            auto pos = line.find(' ');
+            if (pos != std::string::npos) {
+                std::string rest = line.substr(pos + 1);
+                auto spacePos = rest.find(' ');
+                auto bracePos = rest.find('{');
+                auto colonPos = rest.find(':');
+
+                size_t endPos = std::min({spacePos, bracePos, colonPos});
+                if (endPos == std::string::npos) {
+                    endPos = rest.length();
                 }
-            }
 
-            // End of class
-            if (inClass && line.find("};") != std::string::npos) {
-                m_classes.push_back(currentClass);
-                inClass = false;
+                currentClass.name = rest.substr(0, endPos);
+                currentClass.description = "Class " + currentClass.name;
             }
+        }
 
-            // Extract functions (basic detection)
-            if (line.find('(') != std::string::npos && line.find(')') != std::string::npos &&
-                !starts_with(line, "#") && line.find("if") != 0 && line.find("for") != 0 &&
-                line.find("while") != 0) {
-
-                // Very basic function name extraction
-                auto parenPos = line.find('(');
-                std::string beforeParen = line.substr(0, parenPos);
-                auto lastSpace = beforeParen.find_last_of(" \t");
-                std::string funcName;
-                if (lastSpace != std::string::npos) {
-                    funcName = beforeParen.substr(lastSpace + 1);
-                } else {
-                    funcName = beforeParen;
-                }
+        // End of class
+        if (inClass && line.find("};") != std::string::npos) {
+            result.classes.push_back(currentClass);
+            inClass = false;
+        }
 
-                if (inClass) {
-                    currentClass.methods.push_back(funcName);
-                } else {
-                    FunctionInfo func;
-                    func.namespace_ = currentNamespace;
-                    func.name = funcName;
-                    func.description = "Function " + funcName;
-                    func.returnType = "auto"; // Simplified
-                    m_functions.push_back(func);
-                }
+        // Extract functions (basic detection)
+        if (line.find('(') != std::string::npos && line.find(')') != std::string::npos &&
+            !starts_with(line, "#") && line.find("if") != 0 && line.find("for") != 0 &&
+            line.find("while") != 0) {
+
+            // Very basic function name extraction
+            auto parenPos = line.find('(');
+            std::string beforeParen = line.substr(0, parenPos);
+            auto lastSpace = beforeParen.find_last_of(" \t");
+            std::string funcName;
+            if (lastSpace != std::string::npos) {
+                funcName = beforeParen.substr(lastSpace + 1);
+            } else {
+                funcName = beforeParen;
             }
-        }
 
-        return true;
-    } catch (const std::exception& e) {
-        spdlog::error("Error extracting from file {}: {}", sourceFile.string(), e.what());
-        return false;
+            if (inClass) {
+                currentClass.methods.push_back(funcName);
+            } else {
+                FunctionInfo func;
+                func.namespace_ = currentNamespace;
+                func.name = funcName;
+                func.description = "Function " + funcName;
+                func.returnType = "auto"; // Simplified
+                result.functions.push_back(func);
+            }
+        }
     }
+
+    return result;
 }
 
 std::string APIDocExtractor::generateMarkdownAPI() const {
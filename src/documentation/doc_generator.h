@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <map>
 #include <filesystem>
@@ -86,6 +87,10 @@ struct DocConfig {
     std::string outputDirectory{"docs"};
     std::string sourceDirectory{"src"};
     std::string templateDirectory{"templates"};
+    // Parse cache for API docs. Empty keeps it in the tool's cache directory
+    // rather than in the project; otherwise it is relative to the project
+    std::string apiCacheFile;
+    bool useApiCache{true};
 
     bool generateIndex{true};
     bool generateTOC{true};
@@ -186,6 +191,13 @@ public:
     bool extractFromDirectory(const std::filesystem::path& sourceDir);
     bool extractFromFile(const std::filesystem::path& sourceFile);
 
+    // Incremental extraction: per-header results are kept in this file keyed by
+    // content hash, and headers whose hash is unchanged are not parsed again
+    void setCacheFile(const std::filesystem::path& cacheFile);
+    void setMaxWorkers(size_t workers);  // 0 = one per hardware thread
+    size_t getParsedFileCount() const;   // headers parsed by the last directory run
+    size_t getCachedFileCount() const;   // headers taken from the cache by it
+
     // Access
     std::vector<NamespaceInfo> getNamespaces() const;
     std::vector<ClassInfo> getClasses() const;
@@ -197,9 +209,23 @@ public:
     std::string generateDoxygenConfig() const;
 
 private:
+    // What one header contributes, in declaration order
+    struct FileResult {
+        std::vector<ClassInfo> classes;
+        std::vector<FunctionInfo> functions;
+    };
+
     std::vector<NamespaceInfo> m_namespaces;
     std::vector<ClassInfo> m_classes;
     std::vector<FunctionInfo> m_functions;
+    std::filesystem::path m_cacheFile;
+    size_t m_maxWorkers{0};
+    size_t m_parsedFiles{0};
+    size_t m_cachedFiles{0};
+
+    static FileResult parseContent(std::string_view content);
+    void mergeResult(FileResult&& result);
+    void buildNamespaces();
 
     // Parsing helpers
     bool parseHeaderFile(const std::filesystem::path& headerFile);
@@ -1,54 +1,110 @@
-#include <spdlog/sinks/rotating_file_sink.h>
+#include <spdlog/async.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
 #include <chrono>
+#include <cstdlib>
+#include <filesystem>
 #include <iostream>
 #include <thread>
+#include <vector>
 
 #include "cli/commands/command_handlers.h"
+#include "cli/localization/localization.h"
 #include "cli/parsing/argument_parser.h"
 #include "config/config_manager.h"
 #include "documentation/doc_generator.h"
+#include "templates/batch_generator.h"
 #include "templates/template_manager.h"
 #include "testing/test_framework_manager.h"
+#include "utils/core/forwarding_sink.h"
+#include "utils/core/lazy_file_sink.h"
+#include "utils/core/tool_registry.h"
 #include "utils/external/framework_integration.h"
+#include "utils/ui/frame_aware_sink.h"
 #include "utils/ui/progress_indicator.h"
 #include "utils/ui/terminal_utils.h"
 
+// Log file location: CPP_SCAFFOLD_LOG_FILE, or logs/ under the cache directory
+std::filesystem::path logFilePath() {
+    if (const char* overridePath = std::getenv("CPP_SCAFFOLD_LOG_FILE")) {
+        return overridePath;
+    }
+    return config::ConfigManager::getInstance().getCacheDirectory() / "logs" / "cpp-scaffold.log";
+}
+
+// Sinks of the default logger, kept so LoggerShutdown can rebuild it without
+// the background file writer (and without the progress renderer, which may be
+// destroyed before later messages arrive)
+std::shared_ptr<spdlog::sinks::sink> g_consoleSink;
+std::shared_ptr<spdlog::sinks::sink> g_fileSink;
+
+// Drains the log file's background thread when main returns, whichever way it
+// returns, and leaves a logger writing both sinks directly for anything logged
+// later (e.g. from static destructors)
+struct LoggerShutdown {
+    ~LoggerShutdown() {
+        if (!g_consoleSink || !g_fileSink) {
+            return;
+        }
+        auto current = spdlog::default_logger();
+        auto logger = std::make_shared<spdlog::logger>(
+                current->name(), spdlog::sinks_init_list{g_consoleSink, g_fileSink});
+        logger->set_level(current->level());
+        spdlog::set_default_logger(logger);
+        current.reset();
+
+        // Destroying the pool writes out everything still queued first
+        spdlog::details::registry::instance().set_tp(nullptr);
+        logger->flush();
+    }
+};
+
 // Initialize the logging system
 void initializeLogger(bool verbose) {
     try {
         // Initialize UTF-8 support first
         utils::TerminalUtils::initializeUtf8Support();
 
-        // Create a logger - one for console output and one for file output
+        // Console output is written synchronously, so log lines stay in order
+        // with the CLI's own std::cout output and prompts, and above any
+        // progress indicators that are running
         auto console_sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
         console_sink->set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%^%l%$] %v");
 
-        // Create a rotating file sink, with a maximum file size of 5MB and 3
-        // rotated files
-        auto file_sink = std::make_shared<spdlog::sinks::rotating_file_sink_mt>("cpp-scaffold.log",
-                                                                                5 * 1024 * 1024, 3);
+        // Rotating file sink (5MB, 3 rotated files), opened on the first
+        // message that reaches it
+        auto file_sink =
+                std::make_shared<utils::LazyRotatingFileSink>(logFilePath(), 5 * 1024 * 1024, 3);
         file_sink->set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%l] [%t] %v");
 
-        // Create a logger with multiple sinks
+        // The file is written by one background thread, so generating a project
+        // never waits on the disk. A full queue blocks the caller rather than
+        // losing messages
+        spdlog::init_thread_pool(8192, 1);
+        auto file_logger = std::make_shared<spdlog::async_logger>(
+                "cpp-scaffold-file", file_sink, spdlog::thread_pool(),
+                spdlog::async_overflow_policy::block);
+        file_logger->set_level(spdlog::level::trace);
+
         auto logger = std::make_shared<spdlog::logger>(
-                "cpp-scaffold", spdlog::sinks_init_list{console_sink, file_sink});
+                "cpp-scaffold",
+                spdlog::sinks_init_list{std::make_shared<utils::FrameAwareSink>(console_sink),
+                                        std::make_shared<utils::ForwardingSink>(file_logger)});
 
-        // Set logging level based on verbosity
-        if (verbose) {
-            logger->set_level(spdlog::level::debug);
-            logger->flush_on(spdlog::level::debug);
-        } else {
-            logger->set_level(spdlog::level::info);
-            logger->flush_on(spdlog::level::err);
-        }
+        // Set logging level based on verbosity. The file is flushed on a timer
+        // and on errors rather than after every line
+        logger->set_level(verbose ? spdlog::level::debug : spdlog::level::info);
+        logger->flush_on(spdlog::level::err);
+        spdlog::flush_every(std::chrono::seconds(2));
 
         // Set the default logger
         spdlog::set_default_logger(logger);
+        g_consoleSink = console_sink;
+        g_fileSink = file_sink;
 
-        spdlog::info("Logging system initialized");
+        spdlog::debug("Logging system initialized");
         spdlog::debug("Verbose logging enabled");
     } catch (const spdlog::spdlog_ex& ex) {
         std::cerr << "Logging initialization failed: " << ex.what() << std::endl;
@@ -108,17 +164,74 @@ void demonstrateAdvancedFeatures() {
     spdlog::info("All advanced features are operational!");
 }
 
+// Generate every project listed in a batch manifest from this one process
+int runBatch(const std::vector<std::string>& args) {
+    if (args.size() < 2) {
+        std::cout << "Usage: cpp-scaffold batch <manifest.json> [--jobs <n>] [--verbose]\n";
+        return 1;
+    }
+
+    size_t jobs = 0;
+    for (size_t i = 2; i < args.size(); ++i) {
+        if ((args[i] == "--jobs" || args[i] == "-j") && i + 1 < args.size()) {
+            try {
+                jobs = std::stoul(args[++i]);
+            } catch (const std::exception&) {
+                spdlog::error("Invalid job count: {}", args[i]);
+                return 1;
+            }
+        } else if (args[i] == "--verbose") {
+            spdlog::set_level(spdlog::level::debug);
+        } else {
+            spdlog::warn("Ignoring unknown batch option: {}", args[i]);
+        }
+    }
+
+    // Initialize shared state once for all projects
+    Localization::initialize();
+    auto& configManager = config::ConfigManager::getInstance();
+    if (!configManager.loadConfiguration()) {
+        spdlog::warn("Using built-in defaults, configuration could not be loaded");
+    }
+
+    auto manifest =
+            BatchGenerator::loadManifest(args[1], configManager.loadDefaultOptions());
+    if (!manifest) {
+        std::cout << "Batch manifest is invalid. Check the logs for details.\n";
+        return 1;
+    }
+
+    TemplateManager templateManager;
+    BatchGenerator generator(templateManager);
+    auto results = generator.run(manifest->projects, jobs != 0 ? jobs : manifest->jobs);
+
+    BatchGenerator::printSummary(results, std::cout);
+    bool allSucceeded = std::all_of(results.begin(), results.end(),
+                                    [](const BatchProjectResult& r) { return r.success; });
+    return allSucceeded ? 0 : 1;
+}
+
 int main(int argc, char* argv[]) {
+    LoggerShutdown loggerShutdown;
     try {
         // Perform basic initialization first
         initializeLogger(false);  // Default: non-verbose mode
 
-        spdlog::info("CPP-Scaffold is starting...");
+        spdlog::debug("CPP-Scaffold is starting...");
+
+        // Reuse tool lookups from earlier runs instead of probing PATH again
+        utils::ToolRegistry::getInstance().enablePersistence(
+                config::ConfigManager::getInstance().getCacheDirectory() / "tools.json");
         spdlog::debug("Parsing command line arguments");
 
         // Show application start screen
         std::cout << "C++ Project Scaffold - Create modern C++ projects with ease\n\n";
 
+        std::vector<std::string> args(argv + 1, argv + argc);
+        if (argument_parser::detectCommand(args) == argument_parser::CommandType::Batch) {
+            return runBatch(args);
+        }
+
         // Parse command line arguments
         CliOptions options = argument_parser::parseArguments(argc, argv);
 
@@ -176,7 +289,8 @@ int main(int argc, char* argv[]) {
 
         // Show error message
         std::cerr << "Error: " << e.what() << "\n";
-        std::cerr << "Check the log file for more details and try running with --verbose\n";
+        std::cerr << "Check the log file (" << logFilePath().string()
+                  << ") for more details and try running with --verbose\n";
 
         return 1;
     } catch (...) {
@@ -5,7 +5,10 @@
 #include <filesystem>
 #include <iostream>
 
+#include "../config/config_manager.h"
 #include "../utils/core/file_utils.h"
+#include "../utils/core/staging_directory.h"
+#include "../utils/external/download_cache.h"
 #include "../utils/external/git_utils.h"
 #include "../utils/ui/terminal_utils.h"
 
@@ -14,16 +17,11 @@ ArchiveTemplate::ArchiveTemplate(const CliOptions& options)
     // Determine if source is remote or local
     isRemoteSource_ = isRemoteArchive();
 
-    // Set up paths
-    if (isRemoteSource_) {
-        std::string filename = utils::HttpClient::extractFilenameFromUrl(getArchiveSource());
-        archivePath_ = std::filesystem::temp_directory_path() / filename;
-    } else {
+    // Remote archives get their local path from the download cache
+    if (!isRemoteSource_) {
         archivePath_ = getArchiveSource();
     }
 
-    tempExtractPath_ = std::filesystem::temp_directory_path() /
-                       ("cpp_scaffold_extract_" + std::to_string(std::time(nullptr)));
     finalProjectPath_ = std::filesystem::current_path() / options.projectName;
 }
 
@@ -59,8 +57,18 @@ bool ArchiveTemplate::create() {
             spdlog::info("?Local archive validated");
         }
 
-        // Extract archive
-        if (!extractArchive()) {
+        // Extract into a staging directory published only once the project is complete;
+        // the staging destructor removes a partial tree on every failure below
+        utils::StagingDirectory staging(finalProjectPath_);
+        std::string error;
+        if (!staging.begin(error)) {
+            spdlog::error("{}", error);
+            cleanupTemporaryFiles();
+            return false;
+        }
+
+        // Extract archive; the extractor refuses to write through the staging link
+        if (!extractArchive(staging.stagingPath())) {
             spdlog::error("Failed to extract archive");
             cleanupTemporaryFiles();
             return false;
@@ -83,6 +91,11 @@ bool ArchiveTemplate::create() {
         // Cleanup temporary files
         cleanupTemporaryFiles();
 
+        if (!staging.commit(error)) {
+            spdlog::error("{}", error);
+            return false;
+        }
+
         spdlog::info("\n🎉 Project created successfully from archive!\n");
 
         // Print usage instructions
@@ -130,12 +143,6 @@ bool ArchiveTemplate::downloadArchive() {
     try {
         std::string url = getArchiveSource();
 
-        // Check if URL is accessible
-        if (!utils::HttpClient::isUrlAccessible(url)) {
-            spdlog::error("Archive URL is not accessible: {}", url);
-            return false;
-        }
-
         // Download with progress tracking
         auto progressCallback = [](size_t downloaded, size_t total) -> bool {
             if (total > 0) {
@@ -146,11 +153,21 @@ bool ArchiveTemplate::downloadArchive() {
             return true;  // Continue download
         };
 
-        auto result = utils::HttpClient::downloadFile(url, archivePath_, progressCallback);
+        // Repeated projects from the same URL reuse the cached archive after a
+        // conditional request instead of downloading it again
+        utils::DownloadCache cache(
+                config::ConfigManager::getInstance().getCacheDirectory() / "downloads",
+                utils::DownloadCache::settingsFromEnvironment());
+        auto result = cache.fetch(url, progressCallback);
 
         if (result.success) {
             archiveDownloaded_ = true;
-            spdlog::info("Archive downloaded: {} bytes", result.bytesDownloaded);
+            archivePath_ = result.path;
+            if (result.fromCache) {
+                spdlog::info("Using cached archive {}", archivePath_.string());
+            } else {
+                spdlog::info("Archive downloaded: {} bytes", result.bytesDownloaded);
+            }
             return true;
         } else {
             spdlog::error("Download failed: {}", result.errorMessage);
@@ -163,7 +180,7 @@ bool ArchiveTemplate::downloadArchive() {
     }
 }
 
-bool ArchiveTemplate::extractArchive() {
+bool ArchiveTemplate::extractArchive(const std::filesystem::path& destination) {
     try {
         // Validate archive format
         if (!utils::ArchiveUtils::isSupportedArchive(archivePath_)) {
@@ -171,27 +188,26 @@ bool ArchiveTemplate::extractArchive() {
             return false;
         }
 
-        // Validate archive integrity
-        if (!utils::ArchiveUtils::validateArchive(archivePath_)) {
-            spdlog::error("Archive validation failed: {}", archivePath_.string());
-            return false;
-        }
-
-        // Create extraction directory
-        std::filesystem::create_directories(tempExtractPath_);
-
-        // Extract with progress tracking
-        auto progressCallback = [](size_t current, size_t total) -> bool {
+        // Extract with progress tracking, reported in 10% steps
+        int lastReported = -10;
+        utils::ArchiveUtils::ExtractOptions extractOptions;
+        extractOptions.progressCallback = [&lastReported](size_t current, size_t total) -> bool {
             if (total > 0) {
-                double percentage = (double)current / total * 100.0;
-                spdlog::info("Extraction progress: {:.1f}% ({} / {} files)", percentage, current,
-                             total);
+                int percentage = static_cast<int>(static_cast<double>(current) / total * 100.0);
+                if (percentage / 10 != lastReported / 10) {
+                    lastReported = percentage;
+                    spdlog::info("Extraction progress: {}% ({} / {} bytes)", percentage, current,
+                                 total);
+                }
             }
             return true;  // Continue extraction
         };
 
-        auto result = utils::ArchiveUtils::extractArchive(archivePath_, tempExtractPath_,
-                                                          progressCallback);
+        // Written straight into the project directory; a release-style
+        // top-level folder ("project-1.0/") is stripped on the way
+        extractOptions.stripSingleRoot = true;
+        auto result =
+                utils::ArchiveUtils::extractArchive(archivePath_, destination, extractOptions);
 
         if (result.success) {
             archiveExtracted_ = true;
@@ -210,29 +226,16 @@ bool ArchiveTemplate::extractArchive() {
 
 bool ArchiveTemplate::processExtractedContent() {
     try {
-        // Find the actual project root in the extracted content
-        std::filesystem::path projectRoot;
-        if (!findProjectRoot(tempExtractPath_, projectRoot)) {
-            spdlog::error("Could not find project root in extracted content");
-            return false;
-        }
-
         // Validate that it's a C++ project
-        if (!isCppProject(projectRoot)) {
+        if (!isCppProject(finalProjectPath_)) {
             spdlog::warn("Archive doesn't appear to contain a C++ project, proceeding anyway");
         }
 
         // Validate project structure
-        if (!hasValidStructure(projectRoot)) {
+        if (!hasValidStructure(finalProjectPath_)) {
             spdlog::warn("Project structure validation failed, proceeding anyway");
         }
 
-        // Move project to final location
-        if (!moveProjectToFinalLocation(projectRoot)) {
-            spdlog::error("Failed to move project to final location");
-            return false;
-        }
-
         // Adapt project name if needed
         if (!adaptProjectName(finalProjectPath_)) {
             spdlog::warn("Failed to adapt project name");
@@ -253,16 +256,9 @@ bool ArchiveTemplate::validateArchiveStructure() {
 
 bool ArchiveTemplate::cleanupTemporaryFiles() {
     try {
-        // Remove temporary extraction directory
-        if (std::filesystem::exists(tempExtractPath_)) {
-            std::filesystem::remove_all(tempExtractPath_);
-            spdlog::info("Cleaned up temporary extraction directory");
-        }
-
-        // Remove downloaded archive if it was downloaded
-        if (isRemoteSource_ && archiveDownloaded_ && std::filesystem::exists(archivePath_)) {
-            std::filesystem::remove(archivePath_);
-            spdlog::info("Cleaned up downloaded archive");
+        // Downloaded archives stay in the download cache, which trims itself
+        if (isRemoteSource_ && archiveDownloaded_) {
+            spdlog::debug("Keeping downloaded archive in cache: {}", archivePath_.string());
         }
 
         return true;
@@ -313,10 +309,6 @@ std::filesystem::path ArchiveTemplate::getArchivePath() const {
     return archivePath_;
 }
 
-std::filesystem::path ArchiveTemplate::getTempExtractPath() const {
-    return tempExtractPath_;
-}
-
 std::filesystem::path ArchiveTemplate::getFinalProjectPath() const {
     return finalProjectPath_;
 }
@@ -344,49 +336,8 @@ bool ArchiveTemplate::validateLocalArchive() {
         return false;
     }
 
-    return utils::ArchiveUtils::validateArchive(archivePath_);
-}
-
-bool ArchiveTemplate::extractToTemporaryLocation() {
-    return extractArchive();
-}
-
-bool ArchiveTemplate::findProjectRoot(const std::filesystem::path& extractPath,
-                                      std::filesystem::path& projectRoot) {
-    try {
-        // Check if extract path itself is the project root
-        if (isCppProject(extractPath)) {
-            projectRoot = extractPath;
-            return true;
-        }
-
-        // Look for project root in subdirectories
-        for (const auto& entry : std::filesystem::directory_iterator(extractPath)) {
-            if (entry.is_directory() && isCppProject(entry.path())) {
-                projectRoot = entry.path();
-                return true;
-            }
-        }
-
-        // If no clear project root found, use the extract path
-        projectRoot = extractPath;
-        return true;
-
-    } catch (const std::exception& e) {
-        spdlog::error("Error finding project root: {}", e.what());
-        return false;
-    }
-}
-
-bool ArchiveTemplate::moveProjectToFinalLocation(const std::filesystem::path& projectRoot) {
-    try {
-        std::filesystem::rename(projectRoot, finalProjectPath_);
-        spdlog::info("Project moved to final location: {}", finalProjectPath_.string());
-        return true;
-    } catch (const std::exception& e) {
-        spdlog::error("Failed to move project to final location: {}", e.what());
-        return false;
-    }
+    // Integrity is checked while extracting, which reads the archive anyway
+    return utils::ArchiveUtils::isSupportedArchive(archivePath_);
 }
 
 bool ArchiveTemplate::isCppProject(const std::filesystem::path& projectPath) const {
@@ -23,7 +23,7 @@ protected:
 private:
     // Archive specific methods
     bool downloadArchive();
-    bool extractArchive();
+    bool extractArchive(const std::filesystem::path& destination);
     bool processExtractedContent();
     bool validateArchiveStructure();
     bool cleanupTemporaryFiles();
@@ -32,7 +32,6 @@ private:
     // Helper methods
     std::string getArchiveSource() const;
     std::filesystem::path getArchivePath() const;
-    std::filesystem::path getTempExtractPath() const;
     std::filesystem::path getFinalProjectPath() const;
     bool isRemoteArchive() const;
     bool isLocalArchive() const;
@@ -41,11 +40,6 @@ private:
     bool downloadRemoteArchive();
     bool validateLocalArchive();
     
-    // Extraction helpers
-    bool extractToTemporaryLocation();
-    bool findProjectRoot(const std::filesystem::path& extractPath, std::filesystem::path& projectRoot);
-    bool moveProjectToFinalLocation(const std::filesystem::path& projectRoot);
-    
     // Project adaptation
     bool isCppProject(const std::filesystem::path& projectPath) const;
     bool hasValidStructure(const std::filesystem::path& projectPath) const;
@@ -55,7 +49,6 @@ private:
 
     // Member variables
     std::filesystem::path archivePath_;
-    std::filesystem::path tempExtractPath_;
     std::filesystem::path finalProjectPath_;
     bool archiveDownloaded_;
     bool archiveExtracted_;
@@ -0,0 +1,160 @@
+#include "batch_generator.h"
+
+#include <spdlog/fmt/fmt.h>
+#include <spdlog/spdlog.h>
+
+#include <nlohmann/json.hpp>
+#include <set>
+
+#include "../config/config_manager.h"
+#include "../utils/core/file_utils.h"
+#include "../utils/core/parallel.h"
+#include "../utils/ui/table_formatter.h"
+#include "template_manager.h"
+
+using json = nlohmann::json;
+
+BatchGenerator::BatchGenerator(TemplateManager& templateManager)
+    : templateManager_(templateManager) {}
+
+std::optional<BatchManifest> BatchGenerator::loadManifest(const std::filesystem::path& path,
+                                                          const CliOptions& baseOptions) {
+    if (!utils::FileUtils::fileExists(path.string())) {
+        spdlog::error("Batch manifest not found: {}", path.string());
+        return std::nullopt;
+    }
+    return parseManifest(utils::FileUtils::readFromFile(path.string()), baseOptions);
+}
+
+std::optional<BatchManifest> BatchGenerator::parseManifest(const std::string& content,
+                                                           const CliOptions& baseOptions) {
+    try {
+        json manifest = json::parse(content);
+
+        json defaults = json::object();
+        json entries;
+        BatchManifest result;
+        if (manifest.is_array()) {
+            entries = manifest;
+        } else if (manifest.is_object() && manifest.contains("projects") &&
+                   manifest["projects"].is_array()) {
+            entries = manifest["projects"];
+            if (manifest.contains("defaults")) {
+                defaults = manifest["defaults"];
+            }
+            result.jobs = manifest.value("jobs", static_cast<size_t>(0));
+        } else {
+            spdlog::error("Batch manifest must be an array or an object with a 'projects' array");
+            return std::nullopt;
+        }
+
+        auto& configManager = config::ConfigManager::getInstance();
+        json base = config::utils::mergeJsonObjects(configManager.cliOptionsToJson(baseOptions),
+                                                    defaults);
+
+        std::set<std::string> seenNames;
+        result.projects.reserve(entries.size());
+        for (size_t i = 0; i < entries.size(); ++i) {
+            const json& entry = entries[i];
+            if (!entry.is_object()) {
+                spdlog::error("Batch manifest entry {} is not an object", i);
+                return std::nullopt;
+            }
+
+            json merged = config::utils::mergeJsonObjects(base, entry);
+            std::string templateStr = merged.value("templateType", std::string());
+            if (!cli_enums::to_template_type(templateStr)) {
+                spdlog::error("Batch manifest entry {} has unknown template type '{}'", i,
+                              templateStr);
+                return std::nullopt;
+            }
+
+            CliOptions options = configManager.jsonToCliOptions(merged);
+            if (options.projectName.empty()) {
+                spdlog::error("Batch manifest entry {} has no projectName", i);
+                return std::nullopt;
+            }
+            // Parallel generation into the same directory would clobber files
+            if (!seenNames.insert(options.projectName).second) {
+                spdlog::error("Batch manifest lists project '{}' more than once",
+                              options.projectName);
+                return std::nullopt;
+            }
+            result.projects.push_back(std::move(options));
+        }
+
+        return result;
+    } catch (const std::exception& e) {
+        spdlog::error("Failed to parse batch manifest: {}", e.what());
+        return std::nullopt;
+    }
+}
+
+BatchProjectResult BatchGenerator::generate(const CliOptions& options) {
+    BatchProjectResult result;
+    result.projectName = options.projectName;
+    result.templateType = std::string(cli_enums::to_string(options.templateType));
+
+    auto start = std::chrono::steady_clock::now();
+    try {
+        result.success = templateManager_.createProject(options);
+        if (!result.success) {
+            result.error = "Project creation failed";
+        }
+    } catch (const std::exception& e) {
+        result.error = e.what();
+    }
+    result.duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start);
+    return result;
+}
+
+std::vector<BatchProjectResult> BatchGenerator::run(const std::vector<CliOptions>& projects,
+                                                    size_t maxJobs) {
+    std::vector<BatchProjectResult> results(projects.size());
+    if (projects.empty()) {
+        return results;
+    }
+
+    size_t workers = utils::parallelWorkerCount(projects.size(), maxJobs);
+    spdlog::info("Generating {} projects using {} worker(s)", projects.size(), workers);
+
+    utils::parallelFor(projects.size(), workers,
+                       [&](size_t i) { results[i] = generate(projects[i]); });
+
+    return results;
+}
+
+void BatchGenerator::printSummary(const std::vector<BatchProjectResult>& results,
+                                  std::ostream& stream) {
+    utils::TableFormatter table;
+    table.setTitle("Batch Generation Summary");
+    table.addColumn(utils::ColumnConfig("Project", 0, utils::Alignment::Left));
+    table.addColumn(utils::ColumnConfig("Template", 0, utils::Alignment::Left));
+    table.addColumn(utils::ColumnConfig("Status", 0, utils::Alignment::Center));
+    table.addColumn(utils::ColumnConfig("Time", 0, utils::Alignment::Right));
+
+    // Rows go out as they are added once the first hundred have sized the columns
+    table.beginStream(stream);
+
+    size_t succeeded = 0;
+    std::chrono::milliseconds total{0};
+    for (const auto& result : results) {
+        utils::EnhancedTableRow row;
+        row.emplace_back(result.projectName);
+        row.emplace_back(result.templateType);
+        if (result.success) {
+            row.emplace_back("OK", utils::Color::Green);
+            ++succeeded;
+        } else {
+            row.emplace_back("FAILED", utils::Color::Red);
+        }
+        row.emplace_back(fmt::format("{} ms", result.duration.count()));
+        table.addRow(row);
+        total += result.duration;
+    }
+
+    table.endStream();
+    stream << fmt::format("{} of {} projects created ({} ms of generation time)\n", succeeded,
+                          results.size(), total.count());
+}
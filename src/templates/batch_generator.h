@@ -0,0 +1,57 @@
+#pragma once
+#include <chrono>
+#include <filesystem>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "../cli/types/cli_options.h"
+
+class TemplateManager;
+
+// Parsed batch manifest
+struct BatchManifest {
+    std::vector<CliOptions> projects;
+    size_t jobs = 0;  // 0 = not specified by the manifest
+};
+
+// Outcome of generating one project of a batch
+struct BatchProjectResult {
+    std::string projectName;
+    std::string templateType;
+    bool success = false;
+    std::string error;
+    std::chrono::milliseconds duration{0};
+};
+
+// Generates many projects from one process.
+//
+// A manifest is a JSON document of the form
+//   { "jobs": 4, "defaults": { ... }, "projects": [ { "projectName": "a", ... } ] }
+// (or a bare array of project entries). Entries use the same keys as saved
+// configuration profiles and are layered over the base options, then the
+// manifest defaults. All projects share one TemplateManager and run on a
+// bounded worker pool.
+class BatchGenerator {
+   public:
+    explicit BatchGenerator(TemplateManager& templateManager);
+
+    static std::optional<BatchManifest> loadManifest(const std::filesystem::path& path,
+                                                     const CliOptions& baseOptions);
+    static std::optional<BatchManifest> parseManifest(const std::string& content,
+                                                      const CliOptions& baseOptions);
+
+    // Results are returned in manifest order. maxJobs == 0 picks a worker
+    // count from the hardware concurrency.
+    std::vector<BatchProjectResult> run(const std::vector<CliOptions>& projects,
+                                        size_t maxJobs = 0);
+
+    static void printSummary(const std::vector<BatchProjectResult>& results,
+                             std::ostream& stream);
+
+   private:
+    BatchProjectResult generate(const CliOptions& options);
+
+    TemplateManager& templateManager_;
+};
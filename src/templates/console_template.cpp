@@ -94,34 +94,17 @@ bool ConsoleTemplate::createProjectStructure() {
         return false;
     }
 
-    // Create src directory
+    // Queue the rest of the layout; it is created once when the batch is flushed
     std::filesystem::path srcPath = projectPath / "src";
-    if (!createDirectoryWithValidation(srcPath)) {
-        return false;
-    }
-
-    // Create include directory
     std::filesystem::path includePath = projectPath / "include";
-    if (!createDirectoryWithValidation(includePath)) {
-        return false;
-    }
-
-    std::filesystem::path includeProjectPath = includePath / options_.projectName;
-    if (!createDirectoryWithValidation(includeProjectPath)) {
-        return false;
-    }
+    enqueueDirectory(srcPath);
+    enqueueDirectory(includePath / options_.projectName);
 
-    // Write main.cpp with enhanced error handling
-    if (!createFileWithValidation(srcPath / "main.cpp", getMainCppContent())) {
-        return false;
-    }
+    enqueueFile(srcPath / "main.cpp", [this] { return getMainCppContent(); });
+    enqueueFile(projectPath / "README.md", [this] { return getReadmeContent(); });
 
-    // Create README.md with enhanced error handling
-    if (!createFileWithValidation(projectPath / "README.md", getReadmeContent())) {
-        return false;
-    }
-
-    return true;
+    // Write everything with validation and rollback registration
+    return flushQueuedFiles();
 }
 
 bool ConsoleTemplate::createBuildSystem() {
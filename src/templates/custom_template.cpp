@@ -171,8 +171,12 @@ bool CustomTemplate::addCustomFile(const std::string& relativePath, const std::s
     entry.relativePath = relativePath;
     entry.content = content;
     entry.isTemplate = content.find("{{") != std::string::npos;  // Simple template detection
+    if (entry.isTemplate) {
+        entry.compiled = std::make_shared<const utils::CompiledTemplate>(
+                utils::CompiledTemplate::compile(entry.content));
+    }
 
-    m_customFiles.push_back(entry);
+    m_customFiles.push_back(std::move(entry));
     return true;
 }
 
@@ -241,34 +245,44 @@ std::string CustomTemplate::processTemplateContent(const std::string& content) c
 }
 
 std::string CustomTemplate::replaceTemplateVariables(const std::string& content) const {
-    std::string result = content;
-
-    // Replace standard variables
-    result = utils::StringUtils::replace(result, "{{PROJECT_NAME}}", options_.projectName);
-    result = utils::StringUtils::replace(result, "{{PROJECT_NAME_UPPER}}",
-                                         utils::StringUtils::toUpper(options_.projectName));
-    result = utils::StringUtils::replace(result, "{{PROJECT_NAME_LOWER}}",
-                                         utils::StringUtils::toLower(options_.projectName));
+    return utils::CompiledTemplate::compile(content).render(buildTemplateVariables());
+}
 
-    // Replace custom variables
-    for (const auto& [name, value] : m_metadata.variables) {
-        std::string placeholder = "{{" + name + "}}";
-        result = utils::StringUtils::replace(result, placeholder, value);
-    }
+std::unordered_map<std::string, std::string> CustomTemplate::buildTemplateVariables() const {
+    std::unordered_map<std::string, std::string> variables;
+    variables.reserve(m_metadata.variables.size() + 5);
 
-    // Replace current date/time
+    // Current date/time
     auto now = std::chrono::system_clock::now();
     auto time_t = std::chrono::system_clock::to_time_t(now);
     auto tm = *std::localtime(&time_t);
 
     char dateBuffer[32];
     std::strftime(dateBuffer, sizeof(dateBuffer), "%Y-%m-%d", &tm);
-    result = utils::StringUtils::replace(result, "{{CURRENT_DATE}}", std::string(dateBuffer));
+    variables["CURRENT_DATE"] = dateBuffer;
 
     std::strftime(dateBuffer, sizeof(dateBuffer), "%Y", &tm);
-    result = utils::StringUtils::replace(result, "{{CURRENT_YEAR}}", std::string(dateBuffer));
+    variables["CURRENT_YEAR"] = dateBuffer;
+
+    // Custom variables take precedence over the date values...
+    for (const auto& [name, value] : m_metadata.variables) {
+        variables[name] = value;
+    }
 
-    return result;
+    // ...but never over the standard project name variables
+    variables["PROJECT_NAME"] = options_.projectName;
+    variables["PROJECT_NAME_UPPER"] = utils::StringUtils::toUpper(options_.projectName);
+    variables["PROJECT_NAME_LOWER"] = utils::StringUtils::toLower(options_.projectName);
+
+    return variables;
+}
+
+const utils::CompiledTemplate& CustomTemplate::compiledContent(const FileEntry& file) const {
+    if (!file.compiled) {
+        file.compiled = std::make_shared<const utils::CompiledTemplate>(
+                utils::CompiledTemplate::compile(file.content));
+    }
+    return *file.compiled;
 }
 
 json CustomTemplate::toJson() const {
@@ -342,7 +356,12 @@ bool CustomTemplate::fromJson(const json& templateJson) {
                     file.metadata = fileJson["metadata"].get<std::map<std::string, std::string>>();
                 }
 
-                m_customFiles.push_back(file);
+                if (file.isTemplate) {
+                    file.compiled = std::make_shared<const utils::CompiledTemplate>(
+                            utils::CompiledTemplate::compile(file.content));
+                }
+
+                m_customFiles.push_back(std::move(file));
             }
         }
 
@@ -370,6 +389,9 @@ bool CustomTemplate::fromJson(const json& templateJson) {
 }
 
 bool CustomTemplate::createCustomFiles(const std::string& projectPath) const {
+    // Built once and shared by every file rendered below
+    const auto variables = buildTemplateVariables();
+
     for (const auto& file : m_customFiles) {
         std::string fullPath = utils::FileUtils::combinePath(projectPath, file.relativePath);
 
@@ -378,7 +400,8 @@ bool CustomTemplate::createCustomFiles(const std::string& projectPath) const {
         std::filesystem::create_directories(filePath.parent_path());
 
         // Process content
-        std::string content = file.isTemplate ? processTemplateContent(file.content) : file.content;
+        std::string content =
+                file.isTemplate ? compiledContent(file).render(variables) : file.content;
 
         if (!utils::FileUtils::writeToFile(fullPath, content)) {
             spdlog::error("Failed to create custom file: {}", fullPath);
@@ -3,9 +3,12 @@
 #include <filesystem>
 #include <map>
 #include <nlohmann/json.hpp>
+#include <memory>
 #include <optional>
+#include <unordered_map>
 #include <vector>
 
+#include "../utils/core/template_compiler.h"
 #include "template_base.h"
 
 using json = nlohmann::json;
@@ -76,6 +79,8 @@ class CustomTemplate : public TemplateBase {
         std::string content;
         bool isTemplate;  // Whether content contains template variables
         std::map<std::string, std::string> metadata;
+        // Tokenized form of content, compiled once and reused across renders
+        mutable std::shared_ptr<const utils::CompiledTemplate> compiled;
     };
 
     // Directory entry
@@ -91,6 +96,8 @@ class CustomTemplate : public TemplateBase {
     // Template processing
     std::string processTemplateContent(const std::string& content) const;
     std::string replaceTemplateVariables(const std::string& content) const;
+    std::unordered_map<std::string, std::string> buildTemplateVariables() const;
+    const utils::CompiledTemplate& compiledContent(const FileEntry& file) const;
 
     // JSON serialization
     json toJson() const;
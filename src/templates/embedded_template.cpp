@@ -611,7 +611,7 @@ std::string EmbeddedTemplate::getCMakeContent() {
 # Set the toolchain file
 set(CMAKE_TOOLCHAIN_FILE "${{CMAKE_CURRENT_SOURCE_DIR}}/cmake/arm-none-eabi.cmake")
 
-project({} C CXX ASM)
+project({0} C CXX ASM)
 
 # Set C++ standard
 set(CMAKE_CXX_STANDARD 17)
@@ -644,18 +644,16 @@ file(GLOB_RECURSE SOURCES
 )
 
 # Create executable
-add_executable({}.elf ${{SOURCES}})
+add_executable({0}.elf ${{SOURCES}})
 
 # Generate additional files
-add_custom_command(TARGET {}.elf POST_BUILD
-    COMMAND ${{CMAKE_OBJCOPY}} -Oihex ${}.elf ${}.hex
-    COMMAND ${{CMAKE_OBJCOPY}} -Obinary ${}.elf ${}.bin
-    COMMAND ${{CMAKE_SIZE}} ${}.elf
+add_custom_command(TARGET {0}.elf POST_BUILD
+    COMMAND ${{CMAKE_OBJCOPY}} -Oihex {0}.elf {0}.hex
+    COMMAND ${{CMAKE_OBJCOPY}} -Obinary {0}.elf {0}.bin
+    COMMAND ${{CMAKE_SIZE}} {0}.elf
     COMMENT "Generating HEX and BIN files"
 )
 )",
-                       options_.projectName, options_.projectName, options_.projectName,
-                       options_.projectName, options_.projectName, options_.projectName,
                        options_.projectName);
 }
 
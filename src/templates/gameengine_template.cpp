@@ -10,6 +10,20 @@
 
 using utils::FileUtils;
 
+namespace {
+
+// One line per file, as build files list sources
+std::string formatFileList(const std::vector<std::string>& files, const std::string& prefix,
+                           const std::string& suffix) {
+    std::string list;
+    for (const auto& file : files) {
+        list += prefix + file + suffix + "\n";
+    }
+    return list;
+}
+
+}  // namespace
+
 GameEngineTemplate::GameEngineTemplate(const CliOptions& options) : TemplateBase(options) {}
 
 bool GameEngineTemplate::create() {
@@ -122,133 +136,112 @@ bool GameEngineTemplate::createProjectStructure() {
                                             projectPath + "/bin",
                                             projectPath + "/lib"};
 
-    for (const auto& dir : directories) {
-        if (!FileUtils::createDirectory(dir)) {
-            spdlog::error("Failed to create directory: {}", dir);
-            return false;
-        }
-    }
-
-    // Create main engine files
-    if (!FileUtils::writeToFile(projectPath + "/src/engine/core/engine.h",
-                                getEngineHeaderContent())) {
-        return false;
-    }
-
-    if (!FileUtils::writeToFile(projectPath + "/src/engine/core/engine.cpp",
-                                getEngineSourceContent())) {
-        return false;
-    }
-
-    if (!FileUtils::writeToFile(projectPath + "/src/game/game.h", getGameHeaderContent())) {
+    // The project root is created eagerly so an invalid path fails before anything is queued
+    if (!FileUtils::createDirectory(projectPath)) {
+        spdlog::error("Failed to create directory: {}", projectPath);
         return false;
     }
 
-    if (!FileUtils::writeToFile(projectPath + "/src/game/game.cpp", getGameSourceContent())) {
-        return false;
+    for (const auto& dir : directories) {
+        enqueueDirectory(dir);
     }
 
-    if (!FileUtils::writeToFile(projectPath + "/src/main.cpp", getExampleGameContent())) {
-        return false;
-    }
+    // Create main engine files
+    enqueueFile(projectPath + "/src/engine/core/engine.h",
+                [this] { return getEngineHeaderContent(); });
+    enqueueFile(projectPath + "/src/engine/core/engine.cpp",
+                [this] { return getEngineSourceContent(); });
+    enqueueFile(projectPath + "/src/game/game.h", [this] { return getGameHeaderContent(); });
+    enqueueFile(projectPath + "/src/game/game.cpp", [this] { return getGameSourceContent(); });
+    enqueueFile(projectPath + "/src/main.cpp", [this] { return getExampleGameContent(); });
 
     // Create graphics system files
-    if (!FileUtils::writeToFile(projectPath + "/src/engine/graphics/renderer.h",
-                                getRendererHeaderContent())) {
-        return false;
-    }
-
-    if (!FileUtils::writeToFile(projectPath + "/src/engine/graphics/renderer.cpp",
-                                getRendererSourceContent())) {
-        return false;
-    }
+    enqueueFile(projectPath + "/src/engine/graphics/renderer.h",
+                [this] { return getRendererHeaderContent(); });
+    enqueueFile(projectPath + "/src/engine/graphics/renderer.cpp",
+                [this] { return getRendererSourceContent(); });
 
     // Create input system files
-    if (!FileUtils::writeToFile(projectPath + "/src/engine/input/input_manager.h",
-                                getInputManagerHeaderContent())) {
-        return false;
-    }
-
-    if (!FileUtils::writeToFile(projectPath + "/src/engine/input/input_manager.cpp",
-                                getInputManagerSourceContent())) {
-        return false;
-    }
+    enqueueFile(projectPath + "/src/engine/input/input_manager.h",
+                [this] { return getInputManagerHeaderContent(); });
+    enqueueFile(projectPath + "/src/engine/input/input_manager.cpp",
+                [this] { return getInputManagerSourceContent(); });
 
     // Create resource manager files
-    if (!FileUtils::writeToFile(projectPath + "/src/engine/resources/resource_manager.h",
-                                getResourceManagerHeaderContent())) {
-        return false;
-    }
-
-    if (!FileUtils::writeToFile(projectPath + "/src/engine/resources/resource_manager.cpp",
-                                getResourceManagerSourceContent())) {
-        return false;
-    }
+    enqueueFile(projectPath + "/src/engine/resources/resource_manager.h",
+                [this] { return getResourceManagerHeaderContent(); });
+    enqueueFile(projectPath + "/src/engine/resources/resource_manager.cpp",
+                [this] { return getResourceManagerSourceContent(); });
 
     // Create scene system files
-    if (!FileUtils::writeToFile(projectPath + "/src/engine/scene/scene_manager.h",
-                                getSceneManagerHeaderContent())) {
-        return false;
-    }
-
-    if (!FileUtils::writeToFile(projectPath + "/src/engine/scene/scene_manager.cpp",
-                                getSceneManagerSourceContent())) {
-        return false;
-    }
+    enqueueFile(projectPath + "/src/engine/scene/scene_manager.h",
+                [this] { return getSceneManagerHeaderContent(); });
+    enqueueFile(projectPath + "/src/engine/scene/scene_manager.cpp",
+                [this] { return getSceneManagerSourceContent(); });
 
     // Create ECS files
-    if (!FileUtils::writeToFile(projectPath + "/src/engine/core/entity.h",
-                                getEntityHeaderContent())) {
-        return false;
-    }
-
-    if (!FileUtils::writeToFile(projectPath + "/src/engine/core/entity.cpp",
-                                getEntitySourceContent())) {
-        return false;
+    enqueueFile(projectPath + "/src/engine/core/entity.h",
+                [this] { return getEntityHeaderContent(); });
+    enqueueFile(projectPath + "/src/engine/core/entity.cpp",
+                [this] { return getEntitySourceContent(); });
+    enqueueFile(projectPath + "/src/engine/core/component.h",
+                [this] { return getComponentHeaderContent(); });
+    enqueueFile(projectPath + "/src/engine/core/system.h",
+                [this] { return getSystemHeaderContent(); });
+    if (usesSparseSetEcs()) {
+        enqueueFile(projectPath + "/src/engine/core/registry.h",
+                    [this] { return getRegistryHeaderContent(); });
+        enqueueFile(projectPath + "/src/engine/core/system.cpp",
+                    [this] { return getSystemSourceContent(); });
+        enqueueDirectory(projectPath + "/bench");
+        enqueueFile(projectPath + "/bench/ecs_benchmark.cpp",
+                    [this] { return getEcsBenchmarkContent(); });
     }
-
-    if (!FileUtils::writeToFile(projectPath + "/src/engine/core/component.h",
-                                getComponentHeaderContent())) {
-        return false;
+    if (usesJobSystem()) {
+        enqueueFile(projectPath + "/src/engine/core/job_system.h",
+                    [this] { return getJobSystemHeaderContent(); });
+        enqueueFile(projectPath + "/src/engine/core/job_system.cpp",
+                    [this] { return getJobSystemSourceContent(); });
     }
 
-    if (!FileUtils::writeToFile(projectPath + "/src/engine/core/system.h",
-                                getSystemHeaderContent())) {
-        return false;
+    // Create frame runtime files
+    if (usesPerfRuntime()) {
+        enqueueFile(projectPath + "/src/engine/core/task_graph.h",
+                    [this] { return getTaskGraphHeaderContent(); });
+        enqueueFile(projectPath + "/src/engine/core/task_graph.cpp",
+                    [this] { return getTaskGraphSourceContent(); });
+        enqueueFile(projectPath + "/src/engine/core/profiler.h",
+                    [this] { return getProfilerHeaderContent(); });
+        enqueueFile(projectPath + "/src/engine/core/profiler.cpp",
+                    [this] { return getProfilerSourceContent(); });
+        enqueueDirectory(projectPath + "/src/engine/memory");
+        enqueueFile(projectPath + "/src/engine/memory/frame_arena.h",
+                    [this] { return getFrameArenaHeaderContent(); });
+        enqueueFile(projectPath + "/src/engine/memory/frame_arena.cpp",
+                    [this] { return getFrameArenaSourceContent(); });
+        enqueueFile(projectPath + "/src/engine/memory/pool_allocator.h",
+                    [this] { return getPoolAllocatorHeaderContent(); });
     }
 
     // Create basic shaders
-    if (!FileUtils::writeToFile(projectPath + "/assets/shaders/vertex.glsl",
-                                getShaderContent("vertex"))) {
-        return false;
-    }
-
-    if (!FileUtils::writeToFile(projectPath + "/assets/shaders/fragment.glsl",
-                                getShaderContent("fragment"))) {
-        return false;
-    }
+    enqueueFile(projectPath + "/assets/shaders/vertex.glsl",
+                [this] { return getShaderContent("vertex"); });
+    enqueueFile(projectPath + "/assets/shaders/fragment.glsl",
+                [this] { return getShaderContent("fragment"); });
 
     // Create configuration files
-    if (!FileUtils::writeToFile(projectPath + "/config/engine.json", getEngineConfigContent())) {
-        return false;
-    }
-
-    if (!FileUtils::writeToFile(projectPath + "/config/graphics.json",
-                                getGraphicsConfigContent())) {
-        return false;
-    }
+    enqueueFile(projectPath + "/config/engine.json", [this] { return getEngineConfigContent(); });
+    enqueueFile(projectPath + "/config/graphics.json",
+                [this] { return getGraphicsConfigContent(); });
 
     // Create README
-    if (!FileUtils::writeToFile(projectPath + "/README.md", getGameEngineReadmeContent())) {
-        return false;
-    }
+    enqueueFile(projectPath + "/README.md", [this] { return getGameEngineReadmeContent(); });
 
     // Create assets README
-    if (!FileUtils::writeToFile(projectPath + "/assets/README.md", getAssetsReadmeContent())) {
-        return false;
-    }
+    enqueueFile(projectPath + "/assets/README.md", [this] { return getAssetsReadmeContent(); });
 
-    return true;
+    // Write the whole tree in one batch
+    return flushQueuedFiles();
 }
 
 bool GameEngineTemplate::createBuildSystem() {
@@ -352,6 +345,10 @@ bool GameEngineTemplate::setupAssetPipeline() {
 
 // Content generation methods
 std::string GameEngineTemplate::getEngineHeaderContent() {
+    if (usesPerfRuntime()) {
+        return getPerfEngineHeaderContent();
+    }
+
     return fmt::format(R"(#pragma once
 
 #include <memory>
@@ -408,6 +405,10 @@ private:
 }
 
 std::string GameEngineTemplate::getEngineSourceContent() {
+    if (usesPerfRuntime()) {
+        return getPerfEngineSourceContent();
+    }
+
     return fmt::format(R"(#include "engine.h"
 #include "../graphics/renderer.h"
 #include "../input/input_manager.h"
@@ -729,6 +730,7 @@ void Renderer::SetClearColor(float r, float g, float b, float a) {{
 std::string GameEngineTemplate::getInputManagerHeaderContent() {
     return fmt::format(R"(#pragma once
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 
@@ -971,16 +973,44 @@ void ResourceManager::UnloadAllResources() {{
 }
 
 std::string GameEngineTemplate::getSceneManagerHeaderContent() {
+    // A sparse-set scene owns its registry and systems instead of entity pointers
+    std::string ecsIncludes;
+    std::string ecsForwardDeclarations = "class Entity;\n";
+    std::string managerMembers;
+    std::string sceneEntityMembers = R"(    void AddEntity(std::shared_ptr<Entity> entity);
+    void RemoveEntity(std::shared_ptr<Entity> entity);
+
+private:
+    std::string name_;
+    std::vector<std::shared_ptr<Entity>> entities_;)";
+    if (usesSparseSetEcs()) {
+        ecsIncludes = "\n#include \"../core/registry.h\"\n#include \"../core/system.h\"\n";
+        ecsForwardDeclarations = "class JobSystem;\n";
+        sceneEntityMembers = R"(    Registry& GetRegistry() { return registry_; }
+
+    // Systems run in the order the Scheduler derives from their declared access
+    void AddSystem(std::unique_ptr<System> system);
+    void RunSystems(JobSystem& jobs, float deltaTime);
+
+private:
+    std::string name_;
+    Registry registry_;
+    Scheduler scheduler_;)";
+        managerMembers = R"(
+    // Runs scene systems on jobs; without one the manager starts its own pool
+    void SetJobSystem(JobSystem* jobs);
+)";
+    }
+
     return fmt::format(R"(#pragma once
 
 #include <memory>
 #include <vector>
 #include <string>
-
+{}
 namespace {} {{
 
-class Entity;
-class Renderer;
+{}class Renderer;
 
 class Scene {{
 public:
@@ -994,12 +1024,7 @@ public:
     virtual void Render(Renderer* renderer) {{}}
     virtual void Shutdown() {{}}
 
-    void AddEntity(std::shared_ptr<Entity> entity);
-    void RemoveEntity(std::shared_ptr<Entity> entity);
-
-private:
-    std::string name_;
-    std::vector<std::shared_ptr<Entity>> entities_;
+{}
 }};
 
 class SceneManager {{
@@ -1015,7 +1040,7 @@ public:
     void LoadScene(std::shared_ptr<Scene> scene);
     void UnloadCurrentScene();
     Scene* GetCurrentScene() const;
-
+{}
 private:
     struct SceneManagerImpl;
     std::unique_ptr<SceneManagerImpl> impl_;
@@ -1023,12 +1048,50 @@ private:
 
 }} // namespace {}
 )",
-                       options_.projectName, options_.projectName);
+                       ecsIncludes, options_.projectName, ecsForwardDeclarations,
+                       sceneEntityMembers, managerMembers, options_.projectName);
 }
 
 std::string GameEngineTemplate::getSceneManagerSourceContent() {
+    std::string ecsInclude = "#include \"entity.h\"";
+    std::string sceneEntityMethods = R"(void Scene::AddEntity(std::shared_ptr<Entity> entity) {
+    entities_.push_back(entity);
+}
+
+void Scene::RemoveEntity(std::shared_ptr<Entity> entity) {
+    auto it = std::find(entities_.begin(), entities_.end(), entity);
+    if (it != entities_.end()) {
+        entities_.erase(it);
+    }
+})";
+    std::string implMembers;
+    std::string runSystems;
+    std::string managerMethods;
+    if (usesSparseSetEcs()) {
+        ecsInclude = "#include \"../core/job_system.h\"";
+        sceneEntityMethods = R"(void Scene::AddSystem(std::unique_ptr<System> system) {
+    scheduler_.AddSystem(std::move(system));
+}
+
+void Scene::RunSystems(JobSystem& jobs, float deltaTime) {
+    scheduler_.Run(registry_, jobs, deltaTime);
+})";
+        implMembers = "    std::unique_ptr<JobSystem> ownedJobs;\n    JobSystem* jobs = nullptr;\n";
+        runSystems = R"(        if (!impl_->jobs) {
+            impl_->ownedJobs = std::make_unique<JobSystem>();
+            impl_->jobs = impl_->ownedJobs.get();
+        }
+        impl_->currentScene->RunSystems(*impl_->jobs, deltaTime);
+)";
+        managerMethods = R"(
+void SceneManager::SetJobSystem(JobSystem* jobs) {
+    impl_->jobs = jobs;
+}
+)";
+    }
+
     return fmt::format(R"(#include "scene_manager.h"
-#include "entity.h"
+{}
 #include "../graphics/renderer.h"
 #include <iostream>
 #include <algorithm>
@@ -1042,19 +1105,10 @@ Scene::~Scene() {{
     Shutdown();
 }}
 
-void Scene::AddEntity(std::shared_ptr<Entity> entity) {{
-    entities_.push_back(entity);
-}}
-
-void Scene::RemoveEntity(std::shared_ptr<Entity> entity) {{
-    auto it = std::find(entities_.begin(), entities_.end(), entity);
-    if (it != entities_.end()) {{
-        entities_.erase(it);
-    }}
-}}
+{}
 
 struct SceneManager::SceneManagerImpl {{
-    std::shared_ptr<Scene> currentScene;
+{}    std::shared_ptr<Scene> currentScene;
     bool initialized = false;
 }};
 
@@ -1084,7 +1138,7 @@ void SceneManager::Shutdown() {{
 
 void SceneManager::Update(float deltaTime) {{
     if (impl_->currentScene) {{
-        impl_->currentScene->Update(deltaTime);
+{}        impl_->currentScene->Update(deltaTime);
     }}
 }}
 
@@ -1118,13 +1172,18 @@ void SceneManager::UnloadCurrentScene() {{
 Scene* SceneManager::GetCurrentScene() const {{
     return impl_->currentScene.get();
 }}
-
+{}
 }} // namespace {}
 )",
-                       options_.projectName, options_.projectName);
+                       ecsInclude, options_.projectName, sceneEntityMethods, implMembers,
+                       runSystems, managerMethods, options_.projectName);
 }
 
 std::string GameEngineTemplate::getEntityHeaderContent() {
+    if (usesSparseSetEcs()) {
+        return getSparseEntityHeaderContent();
+    }
+
     return fmt::format(R"(#pragma once
 
 #include <memory>
@@ -1176,6 +1235,10 @@ private:
 }
 
 std::string GameEngineTemplate::getEntitySourceContent() {
+    if (usesSparseSetEcs()) {
+        return getSparseEntitySourceContent();
+    }
+
     return fmt::format(R"(#include "entity.h"
 #include "component.h"
 
@@ -1197,6 +1260,10 @@ Entity::~Entity() {{
 }
 
 std::string GameEngineTemplate::getComponentHeaderContent() {
+    if (usesSparseSetEcs()) {
+        return getSparseComponentHeaderContent();
+    }
+
     return fmt::format(R"(#pragma once
 
 namespace {} {{
@@ -1251,6 +1318,10 @@ private:
 }
 
 std::string GameEngineTemplate::getSystemHeaderContent() {
+    if (usesSparseSetEcs()) {
+        return getSparseSystemHeaderContent();
+    }
+
     return fmt::format(R"(#pragma once
 
 #include <vector>
@@ -1467,6 +1538,40 @@ python tools/asset_pipeline/process_assets.py
 }
 
 std::string GameEngineTemplate::getGameEngineCMakeContent() {
+    std::string runtimeSources = formatFileList(getRuntimeSourceFiles(), "    ", "");
+    std::string runtimeHeaders = formatFileList(getRuntimeHeaderFiles(), "    ", "");
+    std::string benchmarkTargets;
+    if (usesJobSystem()) {
+        benchmarkTargets = fmt::format(R"(
+# The job system runs on std::thread
+find_package(Threads REQUIRED)
+target_link_libraries({}_engine PUBLIC Threads::Threads)
+)",
+                                       options_.projectName);
+    }
+    if (usesSparseSetEcs()) {
+        benchmarkTargets += fmt::format(R"(
+# ECS iteration benchmark; needs none of the graphics dependencies
+option({}_BUILD_BENCHMARKS "Build the ECS benchmark" ON)
+if({}_BUILD_BENCHMARKS)
+    add_executable({}_ecs_bench
+        bench/ecs_benchmark.cpp
+        src/engine/core/entity.cpp
+        src/engine/core/system.cpp
+        src/engine/core/job_system.cpp
+    )
+    target_include_directories({}_ecs_bench PRIVATE ${{CMAKE_CURRENT_SOURCE_DIR}}/src)
+    target_link_libraries({}_ecs_bench PRIVATE Threads::Threads)
+    set_target_properties({}_ecs_bench PROPERTIES
+        RUNTIME_OUTPUT_DIRECTORY "${{CMAKE_BINARY_DIR}}/bin"
+    )
+endif()
+)",
+                                        options_.projectName, options_.projectName,
+                                        options_.projectName, options_.projectName,
+                                        options_.projectName, options_.projectName);
+    }
+
     return fmt::format(R"(cmake_minimum_required(VERSION 3.16)
 project({} VERSION 1.0.0 LANGUAGES CXX)
 
@@ -1493,7 +1598,7 @@ set(ENGINE_SOURCES
     src/engine/resources/resource_manager.cpp
     src/engine/scene/scene_manager.cpp
     src/engine/core/entity.cpp
-    src/game/game.cpp
+{}    src/game/game.cpp
 )
 
 set(ENGINE_HEADERS
@@ -1505,7 +1610,7 @@ set(ENGINE_HEADERS
     src/engine/core/entity.h
     src/engine/core/component.h
     src/engine/core/system.h
-    src/game/game.h
+{}    src/game/game.h
 )
 
 add_library({}_engine STATIC ${{ENGINE_SOURCES}} ${{ENGINE_HEADERS}})
@@ -1546,7 +1651,7 @@ if(CMAKE_CXX_COMPILER_ID MATCHES "GNU|Clang")
 elseif(MSVC)
     target_compile_options({}_engine PRIVATE /W4)
 endif()
-
+{}
 # Tests
 if(BUILD_TESTS)
     enable_testing()
@@ -1558,13 +1663,37 @@ if(BUILD_EXAMPLES)
     add_subdirectory(examples)
 endif()
 )",
+                       options_.projectName, runtimeSources, runtimeHeaders,
                        options_.projectName, options_.projectName, options_.projectName,
                        options_.projectName, options_.projectName, options_.projectName,
                        options_.projectName, options_.projectName, options_.projectName,
-                       options_.projectName, options_.projectName);
+                       options_.projectName, options_.projectName, benchmarkTargets);
 }
 
 std::string GameEngineTemplate::getGameEngineMesonContent() {
+    std::string threadsDep;
+    std::string runtimeSources = formatFileList(getRuntimeSourceFiles(), "  '", "',");
+    std::string engineDeps = "opengl_dep, glfw_dep, glm_dep";
+    std::string benchmarkTargets;
+    if (usesJobSystem()) {
+        threadsDep = "threads_dep = dependency('threads')\n";
+        engineDeps += ", threads_dep";
+    }
+    if (usesSparseSetEcs()) {
+        benchmarkTargets = fmt::format(R"(
+# ECS iteration benchmark; needs none of the graphics dependencies
+executable('{}_ecs_bench',
+  'bench/ecs_benchmark.cpp',
+  'src/engine/core/entity.cpp',
+  'src/engine/core/system.cpp',
+  'src/engine/core/job_system.cpp',
+  include_directories : include_directories('src'),
+  dependencies : threads_dep
+)
+)",
+                                       options_.projectName);
+    }
+
     return fmt::format(R"(project('{}', 'cpp',
   version : '1.0.0',
   default_options : ['warning_level=3', 'cpp_std=c++17'])
@@ -1573,7 +1702,7 @@ std::string GameEngineTemplate::getGameEngineMesonContent() {
 opengl_dep = dependency('opengl')
 glfw_dep = dependency('glfw3')
 glm_dep = dependency('glm')
-
+{}
 # Engine library sources
 engine_sources = [
   'src/engine/core/engine.cpp',
@@ -1582,27 +1711,58 @@ engine_sources = [
   'src/engine/resources/resource_manager.cpp',
   'src/engine/scene/scene_manager.cpp',
   'src/engine/core/entity.cpp',
-  'src/game/game.cpp'
+{}  'src/game/game.cpp'
 ]
 
 # Engine library
 engine_lib = static_library('{}_engine',
   engine_sources,
   include_directories : include_directories('src'),
-  dependencies : [opengl_dep, glfw_dep, glm_dep]
+  dependencies : [{}]
 )
 
 # Main executable
 executable('{}',
   'src/main.cpp',
   link_with : engine_lib,
-  dependencies : [opengl_dep, glfw_dep, glm_dep]
+  dependencies : [{}]
 )
-)",
-                       options_.projectName, options_.projectName, options_.projectName);
+{})",
+                       options_.projectName, threadsDep, runtimeSources, options_.projectName,
+                       engineDeps, options_.projectName, engineDeps, benchmarkTargets);
 }
 
 std::string GameEngineTemplate::getGameEngineBazelContent() {
+    std::string runtimeSources = formatFileList(getRuntimeSourceFiles(), "        \"", "\",");
+    std::string runtimeHeaders = formatFileList(getRuntimeHeaderFiles(), "        \"", "\",");
+    std::string engineLinkopts;
+    std::string benchmarkTargets;
+    if (usesJobSystem()) {
+        engineLinkopts = "    linkopts = [\"-pthread\"],\n";
+    }
+    if (usesSparseSetEcs()) {
+        benchmarkTargets = fmt::format(R"(
+# ECS iteration benchmark; needs none of the graphics dependencies
+cc_binary(
+    name = "{}_ecs_bench",
+    srcs = [
+        "bench/ecs_benchmark.cpp",
+        "src/engine/core/component.h",
+        "src/engine/core/entity.cpp",
+        "src/engine/core/entity.h",
+        "src/engine/core/job_system.cpp",
+        "src/engine/core/job_system.h",
+        "src/engine/core/registry.h",
+        "src/engine/core/system.cpp",
+        "src/engine/core/system.h",
+    ],
+    copts = ["-Isrc"],
+    linkopts = ["-pthread"],
+)
+)",
+                                       options_.projectName);
+    }
+
     return fmt::format(R"(load("@rules_cc//cc:defs.bzl", "cc_binary", "cc_library")
 
 cc_library(
@@ -1614,7 +1774,7 @@ cc_library(
         "src/engine/resources/resource_manager.cpp",
         "src/engine/scene/scene_manager.cpp",
         "src/engine/core/entity.cpp",
-        "src/game/game.cpp",
+{}        "src/game/game.cpp",
     ],
     hdrs = [
         "src/engine/core/engine.h",
@@ -1625,10 +1785,10 @@ cc_library(
         "src/engine/core/entity.h",
         "src/engine/core/component.h",
         "src/engine/core/system.h",
-        "src/game/game.h",
+{}        "src/game/game.h",
     ],
     includes = ["src"],
-    deps = [
+{}    deps = [
         "@opengl//:opengl",
         "@glfw//:glfw",
         "@glm//:glm",
@@ -1641,11 +1801,29 @@ cc_binary(
     srcs = ["src/main.cpp"],
     deps = [":{}_engine"],
 )
-)",
-                       options_.projectName, options_.projectName, options_.projectName);
+{})",
+                       options_.projectName, runtimeSources, runtimeHeaders, engineLinkopts,
+                       options_.projectName, options_.projectName, benchmarkTargets);
 }
 
 std::string GameEngineTemplate::getGameEngineXMakeContent() {
+    std::string benchmarkTargets;
+    if (usesSparseSetEcs()) {
+        benchmarkTargets = fmt::format(R"(
+-- ECS iteration benchmark; needs none of the graphics dependencies
+target("{}_ecs_bench")
+    set_kind("binary")
+    add_files("bench/ecs_benchmark.cpp",
+              "src/engine/core/entity.cpp",
+              "src/engine/core/system.cpp",
+              "src/engine/core/job_system.cpp")
+    add_includedirs("src")
+    add_syslinks("pthread")
+    set_targetdir("bin")
+)",
+                                       options_.projectName);
+    }
+
     return fmt::format(R"(set_project("{0}")
 set_version("1.0.0")
 
@@ -1701,12 +1879,42 @@ target("{2}")
 
     -- Enable C++ features
     set_languages("c++17")
-)",
+{4})",
                        options_.projectName, options_.projectName, options_.projectName,
-                       options_.projectName);
+                       options_.projectName, benchmarkTargets);
 }
 
 std::string GameEngineTemplate::getGameEnginePremakeContent() {
+    std::string benchmarkProjects;
+    if (usesSparseSetEcs()) {
+        benchmarkProjects = fmt::format(R"(
+project "{}_ecs_bench"
+    kind "ConsoleApp"
+    language "C++"
+    cppdialect "C++17"
+    targetdir "bin/%{{cfg.buildcfg}}"
+
+    files {{
+        "bench/ecs_benchmark.cpp",
+        "src/engine/core/entity.cpp",
+        "src/engine/core/system.cpp",
+        "src/engine/core/job_system.cpp"
+    }}
+
+    includedirs {{
+        "src"
+    }}
+
+    filter "system:linux"
+        links {{ "pthread" }}
+
+    filter "configurations:Release"
+        defines {{ "NDEBUG" }}
+        optimize "Speed"
+)",
+                                        options_.projectName);
+    }
+
     return fmt::format(R"(workspace "{0}"
     configurations {{ "Debug", "Release" }}
     platforms {{ "x64" }}
@@ -1784,9 +1992,9 @@ project "{2}"
         defines {{ "NDEBUG" }}
         symbols "Off"
         optimize "Speed"
-)",
+{4})",
                        options_.projectName, options_.projectName, options_.projectName,
-                       options_.projectName);
+                       options_.projectName, benchmarkProjects);
 }
 
 std::string GameEngineTemplate::getGameEngineVcpkgContent() {
@@ -1993,6 +2201,80 @@ if __name__ == "__main__":
 }
 
 std::string GameEngineTemplate::getGameEngineReadmeContent() {
+    std::string ecsSection;
+    if (usesSparseSetEcs()) {
+        ecsSection = fmt::format(R"(
+### Entity Component System
+
+Entities are handles (a slot index plus a generation), and every component type lives in its
+own sparse set: a dense array of components iterated front to back, with a sparse index for
+lookups. Components are plain structs.
+
+```cpp
+Registry& registry = scene.GetRegistry();
+Entity ship = registry.Create();
+registry.Emplace<Transform>(ship);
+registry.Emplace<Velocity>(ship).linear[0] = 1.0f;
+scene.AddSystem(std::make_unique<MovementSystem>());
+```
+
+- `Registry::View<A, B>()` walks the smallest of its pools and probes the others
+- systems declare the components they read and write (`SystemAccess`); the `Scheduler` runs
+  systems that don't conflict in parallel on the `JobSystem` and keeps the others in order
+- `JobSystem::ParallelFor` splits one view across worker threads (see `MovementSystem`)
+- systems remove entities with `Registry::DestroyLater`; they are destroyed after the last stage
+
+`{}_ecs_bench` compares iteration over one million entities against the pointer-per-entity
+layout and needs none of the graphics dependencies:
+
+```bash
+cmake --build build --target {}_ecs_bench
+./build/bin/{}_ecs_bench --entities 1000000 --passes 20
+```
+)",
+                                 options_.projectName, options_.projectName,
+                                 options_.projectName);
+    }
+
+    std::string perfSection;
+    if (usesPerfRuntime()) {
+        perfSection = fmt::format(R"(
+### Frame Runtime
+
+Every frame runs through `Engine` in three steps: input on the main thread, a task graph on
+the job system, then rendering on the main thread.
+
+- `JobSystem` is a work-stealing pool: each worker pops its own jobs newest first and idle
+  workers steal the oldest jobs of others. `ParallelFor` splits loops across it.
+- `TaskGraph` runs tasks as soon as their dependencies finish, without blocking a worker.
+  `Engine::AddUpdateTask` and `Engine::AddRenderPrepTask` register work in the two phases:
+
+```cpp
+auto physicsTask = engine.AddUpdateTask("Physics", [&] {{ world.Step(engine.GetDeltaTime()); }});
+auto animationTask = engine.AddUpdateTask("Animation", [&] {{ animator.Update(); }});
+engine.GetFrameGraph().Precede(physicsTask, animationTask);
+engine.AddRenderPrepTask("Culling", [&] {{ culler.Run(engine.GetFrameArena()); }});
+```
+
+- `FrameArena` (`src/engine/memory/`) hands out scratch memory that is released when the next
+  frame starts; `FrameVector<T>` is a `std::vector` allocating from it. Jobs may allocate
+  from it concurrently.
+- `PoolAllocator<T>` keeps long-lived objects of one type, such as components or resources,
+  in fixed chunks with a free list.
+- `Profiler` times every task plus the `Input`, `Update` and `Render` steps
+  (`ENGINE_PROFILE_SCOPE("Name")` adds more). Average and worst frame times are printed at
+  shutdown.
+
+Record the first 300 frames as a Chrome trace and open it in `chrome://tracing` or
+[Perfetto](https://ui.perfetto.dev):
+
+```bash
+ENGINE_TRACE=frame_trace.json ./bin/{}
+```
+)",
+                                  options_.projectName);
+    }
+
     return fmt::format(R"(# {} Game Engine
 
 A modern C++ game engine built with performance and flexibility in mind.
@@ -2086,7 +2368,7 @@ This will:
 - Compile shaders
 - Process 3D models
 - Generate asset manifests
-
+{}{}
 ## Documentation
 
 - [Architecture Guide](docs/architecture.md)
@@ -2112,8 +2394,8 @@ This project is licensed under the MIT License - see the LICENSE file for detail
 - [Issues](https://github.com/your-username/{}/issues)
 - [Discussions](https://github.com/your-username/{}/discussions)
 )",
-                       options_.projectName, options_.projectName, options_.projectName,
-                       options_.projectName);
+                       options_.projectName, options_.projectName, ecsSection,
+                       perfSection, options_.projectName, options_.projectName);
 }
 
 std::string GameEngineTemplate::getShaderCompilerScriptContent() {
@@ -2171,3 +2453,2097 @@ if __name__ == '__main__':
     sys.exit(main())
 )";
 }
+
+bool GameEngineTemplate::usesSparseSetEcs() const {
+    return options_.gameEcs == "sparse-set";
+}
+
+bool GameEngineTemplate::usesPerfRuntime() const {
+    return options_.gamePerf;
+}
+
+bool GameEngineTemplate::usesJobSystem() const {
+    return usesSparseSetEcs() || usesPerfRuntime();
+}
+
+std::vector<std::string> GameEngineTemplate::getRuntimeSourceFiles() const {
+    std::vector<std::string> files;
+    if (usesSparseSetEcs()) {
+        files.push_back("src/engine/core/system.cpp");
+    }
+    if (usesJobSystem()) {
+        files.push_back("src/engine/core/job_system.cpp");
+    }
+    if (usesPerfRuntime()) {
+        files.push_back("src/engine/core/task_graph.cpp");
+        files.push_back("src/engine/core/profiler.cpp");
+        files.push_back("src/engine/memory/frame_arena.cpp");
+    }
+    return files;
+}
+
+std::vector<std::string> GameEngineTemplate::getRuntimeHeaderFiles() const {
+    std::vector<std::string> files;
+    if (usesSparseSetEcs()) {
+        files.push_back("src/engine/core/registry.h");
+    }
+    if (usesJobSystem()) {
+        files.push_back("src/engine/core/job_system.h");
+    }
+    if (usesPerfRuntime()) {
+        files.push_back("src/engine/core/task_graph.h");
+        files.push_back("src/engine/core/profiler.h");
+        files.push_back("src/engine/memory/frame_arena.h");
+        files.push_back("src/engine/memory/pool_allocator.h");
+    }
+    return files;
+}
+
+std::string GameEngineTemplate::getSparseEntityHeaderContent() {
+    return fmt::format(R"(#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace {} {{
+
+// Entity handle: a slot index plus the generation of that slot. Destroying an
+// entity bumps the generation, so stale handles stop resolving instead of
+// aliasing whatever reuses the slot.
+struct Entity {{
+    static constexpr std::uint32_t INVALID_INDEX = ~std::uint32_t{{0}};
+
+    std::uint32_t index = INVALID_INDEX;
+    std::uint32_t generation = 0;
+
+    bool operator==(const Entity& other) const {{
+        return index == other.index && generation == other.generation;
+    }}
+    bool operator!=(const Entity& other) const {{ return !(*this == other); }}
+}};
+
+constexpr Entity NullEntity{{}};
+
+// Hands out entity handles, recycling destroyed slots through a free list
+class EntityManager {{
+public:
+    Entity Create();
+    // Returns false for handles that are already dead
+    bool Destroy(Entity entity);
+    bool IsAlive(Entity entity) const {{
+        return entity.index < generations_.size() && generations_[entity.index] == entity.generation;
+    }}
+
+    std::size_t AliveCount() const {{ return generations_.size() - freeList_.size(); }}
+    void Reserve(std::size_t count);
+
+private:
+    std::vector<std::uint32_t> generations_;  // Current generation of every slot
+    std::vector<std::uint32_t> freeList_;
+}};
+
+}} // namespace {}
+
+namespace std {{
+
+template <>
+struct hash<{}::Entity> {{
+    size_t operator()(const {}::Entity& entity) const noexcept {{
+        return hash<uint64_t>{{}}(static_cast<uint64_t>(entity.generation) << 32 | entity.index);
+    }}
+}};
+
+}} // namespace std
+)",
+                       options_.projectName, options_.projectName, options_.projectName,
+                       options_.projectName);
+}
+
+std::string GameEngineTemplate::getSparseEntitySourceContent() {
+    return fmt::format(R"(#include "entity.h"
+
+namespace {} {{
+
+Entity EntityManager::Create() {{
+    if (!freeList_.empty()) {{
+        std::uint32_t index = freeList_.back();
+        freeList_.pop_back();
+        return Entity{{index, generations_[index]}};
+    }}
+    generations_.push_back(0);
+    return Entity{{static_cast<std::uint32_t>(generations_.size() - 1), 0}};
+}}
+
+bool EntityManager::Destroy(Entity entity) {{
+    if (!IsAlive(entity)) {{
+        return false;
+    }}
+    ++generations_[entity.index];
+    freeList_.push_back(entity.index);
+    return true;
+}}
+
+void EntityManager::Reserve(std::size_t count) {{
+    generations_.reserve(count);
+}}
+
+}} // namespace {}
+)",
+                       options_.projectName, options_.projectName);
+}
+
+std::string GameEngineTemplate::getSparseComponentHeaderContent() {
+    return fmt::format(R"(#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "entity.h"
+
+namespace {} {{
+
+using ComponentId = std::uint32_t;
+
+namespace detail {{
+inline std::atomic<ComponentId> nextComponentId{{0}};
+}}
+
+// Dense id per component type, assigned on first use
+template <typename T>
+ComponentId GetComponentId() {{
+    static const ComponentId id = detail::nextComponentId++;
+    return id;
+}}
+
+class ComponentPoolBase {{
+public:
+    virtual ~ComponentPoolBase() = default;
+    virtual bool Remove(Entity entity) = 0;
+    virtual bool Contains(Entity entity) const = 0;
+    virtual std::size_t Size() const = 0;
+}};
+
+// Sparse set: components of one type packed in a contiguous array, next to a
+// parallel array of their owners. The sparse array maps an entity index to
+// its dense slot, so lookups are two loads and iteration is a linear scan.
+// Removal swaps the last element into the hole, which keeps the arrays dense
+// but does not preserve order.
+template <typename T>
+class ComponentPool final : public ComponentPoolBase {{
+public:
+    template <typename... Args>
+    T& Emplace(Entity entity, Args&&... args) {{
+        if (entity.index >= sparse_.size()) {{
+            sparse_.resize(entity.index + 1, EMPTY);
+        }}
+        std::uint32_t& slot = sparse_[entity.index];
+        if (slot != EMPTY) {{
+            owners_[slot] = entity;  // Replaces the existing component
+            components_[slot] = T{{std::forward<Args>(args)...}};
+            return components_[slot];
+        }}
+        slot = static_cast<std::uint32_t>(components_.size());
+        owners_.push_back(entity);
+        components_.push_back(T{{std::forward<Args>(args)...}});
+        return components_.back();
+    }}
+
+    bool Remove(Entity entity) override {{
+        if (!Contains(entity)) return false;
+        std::uint32_t slot = sparse_[entity.index];
+        std::uint32_t last = static_cast<std::uint32_t>(components_.size() - 1);
+        if (slot != last) {{
+            components_[slot] = std::move(components_[last]);
+            owners_[slot] = owners_[last];
+            sparse_[owners_[slot].index] = slot;
+        }}
+        components_.pop_back();
+        owners_.pop_back();
+        sparse_[entity.index] = EMPTY;
+        return true;
+    }}
+
+    bool Contains(Entity entity) const override {{
+        return entity.index < sparse_.size() && sparse_[entity.index] != EMPTY &&
+               owners_[sparse_[entity.index]] == entity;
+    }}
+
+    // Unchecked: the entity must have this component
+    T& Get(Entity entity) {{ return components_[sparse_[entity.index]]; }}
+    const T& Get(Entity entity) const {{ return components_[sparse_[entity.index]]; }}
+
+    T* TryGet(Entity entity) {{
+        if (entity.index >= sparse_.size()) return nullptr;
+        std::uint32_t slot = sparse_[entity.index];
+        return slot != EMPTY && owners_[slot] == entity ? &components_[slot] : nullptr;
+    }}
+
+    std::size_t Size() const override {{ return components_.size(); }}
+
+    void Reserve(std::size_t count) {{
+        components_.reserve(count);
+        owners_.reserve(count);
+    }}
+
+    // Dense arrays, index-aligned: Owners()[i] owns Data()[i]
+    const std::vector<Entity>& Owners() const {{ return owners_; }}
+    T* Data() {{ return components_.data(); }}
+
+private:
+    static constexpr std::uint32_t EMPTY = ~std::uint32_t{{0}};
+
+    std::vector<std::uint32_t> sparse_;  // Entity index -> dense slot
+    std::vector<Entity> owners_;
+    std::vector<T> components_;
+}};
+
+// Components are plain data; behaviour lives in systems
+struct Transform {{
+    float position[3] = {{0.0f, 0.0f, 0.0f}};
+    float rotation[3] = {{0.0f, 0.0f, 0.0f}};
+    float scale[3] = {{1.0f, 1.0f, 1.0f}};
+}};
+
+struct Velocity {{
+    float linear[3] = {{0.0f, 0.0f, 0.0f}};
+}};
+
+struct Lifetime {{
+    float remaining = 0.0f;  // Seconds until the entity is destroyed
+}};
+
+struct RenderComponent {{
+    std::uint32_t mesh = 0;  // Handles into the renderer's resource tables
+    std::uint32_t material = 0;
+    bool visible = true;
+}};
+
+}} // namespace {}
+)",
+                       options_.projectName, options_.projectName);
+}
+
+std::string GameEngineTemplate::getRegistryHeaderContent() {
+    return fmt::format(R"(#pragma once
+
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "component.h"
+#include "entity.h"
+
+namespace {} {{
+
+// Compile-time query over the pools of Ts. Iteration walks the dense owner
+// array of the smallest pool and probes the others, so its cost follows the
+// rarest component rather than the number of entities
+template <typename... Ts>
+class ComponentView {{
+public:
+    explicit ComponentView(ComponentPool<Ts>*... pools) : pools_(pools...) {{
+        if (((pools != nullptr) && ...)) {{
+            for (const std::vector<Entity>* owners : {{&pools->Owners()...}}) {{
+                if (!lead_ || owners->size() < lead_->size()) lead_ = owners;
+            }}
+        }}
+    }}
+
+    // Upper bound on the number of matches: the size of the smallest pool
+    std::size_t SizeHint() const {{ return lead_ ? lead_->size() : 0; }}
+
+    // Calls fn(entity, Ts&...) for every entity that has all of Ts
+    template <typename Fn>
+    void Each(Fn&& fn) const {{
+        Each(0, SizeHint(), std::forward<Fn>(fn));
+    }}
+
+    // Same, for the positions [begin, end) of the smallest pool, so that one
+    // view can be split across jobs
+    template <typename Fn>
+    void Each(std::size_t begin, std::size_t end, Fn&& fn) const {{
+        if (!lead_) return;
+        const Entity* owners = lead_->data();
+        for (std::size_t i = begin; i < end; ++i) {{
+            Entity entity = owners[i];
+            auto components = std::make_tuple(std::get<ComponentPool<Ts>*>(pools_)->TryGet(entity)...);
+            if (std::apply([](auto*... found) {{ return ((found != nullptr) && ...); }}, components)) {{
+                std::apply([&](auto*... found) {{ fn(entity, *found...); }}, components);
+            }}
+        }}
+    }}
+
+private:
+    std::tuple<ComponentPool<Ts>*...> pools_;
+    const std::vector<Entity>* lead_ = nullptr;
+}};
+
+// Owns the entities and one ComponentPool per component type. Structural
+// changes (creating or destroying entities, adding or removing components)
+// must not overlap with running systems; systems defer destruction through
+// DestroyLater, which the scheduler applies after the frame's last stage.
+class Registry {{
+public:
+    Entity Create() {{ return entities_.Create(); }}
+
+    void Destroy(Entity entity) {{
+        if (!entities_.IsAlive(entity)) return;
+        for (auto& pool : pools_) {{
+            if (pool) pool->Remove(entity);
+        }}
+        entities_.Destroy(entity);
+    }}
+
+    // Safe to call from systems running in parallel
+    void DestroyLater(Entity entity) {{
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        pendingDestroy_.push_back(entity);
+    }}
+
+    void FlushDestroyed() {{
+        std::vector<Entity> pending;
+        {{
+            std::lock_guard<std::mutex> lock(pendingMutex_);
+            pending.swap(pendingDestroy_);
+        }}
+        for (Entity entity : pending) {{
+            Destroy(entity);
+        }}
+    }}
+
+    bool IsAlive(Entity entity) const {{ return entities_.IsAlive(entity); }}
+    std::size_t AliveCount() const {{ return entities_.AliveCount(); }}
+    void Reserve(std::size_t count) {{ entities_.Reserve(count); }}
+
+    template <typename T, typename... Args>
+    T& Emplace(Entity entity, Args&&... args) {{
+        return GetPool<T>().Emplace(entity, std::forward<Args>(args)...);
+    }}
+
+    template <typename T>
+    bool Remove(Entity entity) {{
+        ComponentPool<T>* pool = FindPool<T>();
+        return pool && pool->Remove(entity);
+    }}
+
+    template <typename T>
+    T* TryGet(Entity entity) {{
+        ComponentPool<T>* pool = FindPool<T>();
+        return pool ? pool->TryGet(entity) : nullptr;
+    }}
+
+    template <typename... Ts>
+    bool Has(Entity entity) const {{
+        return ((FindPool<Ts>() && FindPool<Ts>()->Contains(entity)) && ...);
+    }}
+
+    // Never creates pools, so systems may build views while running in parallel
+    template <typename... Ts>
+    ComponentView<Ts...> View() const {{
+        static_assert(sizeof...(Ts) > 0, "a view needs at least one component type");
+        return ComponentView<Ts...>(FindPool<Ts>()...);
+    }}
+
+    template <typename T>
+    ComponentPool<T>& GetPool() {{
+        ComponentId id = GetComponentId<T>();
+        if (id >= pools_.size()) {{
+            pools_.resize(id + 1);
+        }}
+        if (!pools_[id]) {{
+            pools_[id] = std::make_unique<ComponentPool<T>>();
+        }}
+        return static_cast<ComponentPool<T>&>(*pools_[id]);
+    }}
+
+    template <typename T>
+    ComponentPool<T>* FindPool() const {{
+        ComponentId id = GetComponentId<T>();
+        return id < pools_.size() ? static_cast<ComponentPool<T>*>(pools_[id].get()) : nullptr;
+    }}
+
+private:
+    EntityManager entities_;
+    std::vector<std::unique_ptr<ComponentPoolBase>> pools_;  // Indexed by ComponentId
+    std::mutex pendingMutex_;
+    std::vector<Entity> pendingDestroy_;
+}};
+
+}} // namespace {}
+)",
+                       options_.projectName, options_.projectName);
+}
+
+std::string GameEngineTemplate::getSparseSystemHeaderContent() {
+    return fmt::format(R"(#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "component.h"
+#include "registry.h"
+
+namespace {} {{
+
+class JobSystem;
+
+// The component types a system reads and writes
+struct SystemAccess {{
+    std::vector<ComponentId> reads;
+    std::vector<ComponentId> writes;
+
+    template <typename... Ts>
+    SystemAccess& Read() {{
+        (reads.push_back(GetComponentId<Ts>()), ...);
+        return *this;
+    }}
+
+    template <typename... Ts>
+    SystemAccess& Write() {{
+        (writes.push_back(GetComponentId<Ts>()), ...);
+        return *this;
+    }}
+
+    // True when either side writes something the other reads or writes
+    bool ConflictsWith(const SystemAccess& other) const;
+}};
+
+class System {{
+public:
+    virtual ~System() = default;
+
+    virtual const char* GetName() const = 0;
+    virtual SystemAccess GetAccess() const = 0;
+
+    // Touches only the declared components. Entities are destroyed through
+    // Registry::DestroyLater; nothing else may change the registry's structure.
+    virtual void Update(Registry& registry, JobSystem& jobs, float deltaTime) = 0;
+}};
+
+// Runs systems in stages. A system joins the stage after the last one holding
+// a system it conflicts with: conflicting systems keep their registration
+// order, and the systems sharing a stage run in parallel.
+class Scheduler {{
+public:
+    void AddSystem(std::unique_ptr<System> system);
+    void Run(Registry& registry, JobSystem& jobs, float deltaTime);
+
+    const std::vector<std::vector<System*>>& GetStages() const {{ return stages_; }}
+
+private:
+    std::vector<std::unique_ptr<System>> systems_;
+    std::vector<SystemAccess> access_;
+    std::vector<std::size_t> stageOf_;
+    std::vector<std::vector<System*>> stages_;
+}};
+
+// Example systems
+class MovementSystem : public System {{
+public:
+    const char* GetName() const override {{ return "Movement"; }}
+    SystemAccess GetAccess() const override {{
+        return SystemAccess().Write<Transform>().Read<Velocity>();
+    }}
+    void Update(Registry& registry, JobSystem& jobs, float deltaTime) override;
+}};
+
+class LifetimeSystem : public System {{
+public:
+    const char* GetName() const override {{ return "Lifetime"; }}
+    SystemAccess GetAccess() const override {{ return SystemAccess().Write<Lifetime>(); }}
+    void Update(Registry& registry, JobSystem& jobs, float deltaTime) override;
+}};
+
+}} // namespace {}
+)",
+                       options_.projectName, options_.projectName);
+}
+
+std::string GameEngineTemplate::getSystemSourceContent() {
+    return fmt::format(R"(#include "system.h"
+
+#include <algorithm>
+
+#include "job_system.h"
+
+namespace {} {{
+
+namespace {{
+
+bool Overlaps(const std::vector<ComponentId>& a, const std::vector<ComponentId>& b) {{
+    for (ComponentId id : a) {{
+        if (std::find(b.begin(), b.end(), id) != b.end()) return true;
+    }}
+    return false;
+}}
+
+}} // namespace
+
+bool SystemAccess::ConflictsWith(const SystemAccess& other) const {{
+    return Overlaps(writes, other.writes) || Overlaps(writes, other.reads) ||
+           Overlaps(reads, other.writes);
+}}
+
+void Scheduler::AddSystem(std::unique_ptr<System> system) {{
+    SystemAccess access = system->GetAccess();
+    std::size_t stage = 0;
+    for (std::size_t i = 0; i < systems_.size(); ++i) {{
+        if (access.ConflictsWith(access_[i])) {{
+            stage = std::max(stage, stageOf_[i] + 1);
+        }}
+    }}
+    if (stage >= stages_.size()) {{
+        stages_.resize(stage + 1);
+    }}
+    stages_[stage].push_back(system.get());
+    stageOf_.push_back(stage);
+    access_.push_back(std::move(access));
+    systems_.push_back(std::move(system));
+}}
+
+void Scheduler::Run(Registry& registry, JobSystem& jobs, float deltaTime) {{
+    for (const auto& stage : stages_) {{
+        if (stage.size() == 1) {{
+            stage.front()->Update(registry, jobs, deltaTime);
+            continue;
+        }}
+        WaitGroup group;
+        for (System* system : stage) {{
+            jobs.Submit(group, [system, &registry, &jobs, deltaTime]() {{
+                system->Update(registry, jobs, deltaTime);
+            }});
+        }}
+        jobs.Wait(group);
+    }}
+    registry.FlushDestroyed();
+}}
+
+void MovementSystem::Update(Registry& registry, JobSystem& jobs, float deltaTime) {{
+    auto view = registry.View<Transform, Velocity>();
+    jobs.ParallelFor(view.SizeHint(), 16 * 1024, [&](std::size_t begin, std::size_t end) {{
+        view.Each(begin, end, [deltaTime](Entity, Transform& transform, const Velocity& velocity) {{
+            for (int axis = 0; axis < 3; ++axis) {{
+                transform.position[axis] += velocity.linear[axis] * deltaTime;
+            }}
+        }});
+    }});
+}}
+
+void LifetimeSystem::Update(Registry& registry, JobSystem&, float deltaTime) {{
+    registry.View<Lifetime>().Each([&](Entity entity, Lifetime& lifetime) {{
+        lifetime.remaining -= deltaTime;
+        if (lifetime.remaining <= 0.0f) {{
+            registry.DestroyLater(entity);
+        }}
+    }});
+}}
+
+}} // namespace {}
+)",
+                       options_.projectName, options_.projectName);
+}
+
+std::string GameEngineTemplate::getJobSystemHeaderContent() {
+    if (usesPerfRuntime()) {
+        return getWorkStealingJobSystemHeaderContent();
+    }
+
+    return fmt::format(R"(#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {} {{
+
+// Counts the jobs of one batch that have not finished yet
+class WaitGroup {{
+public:
+    bool IsDone() const {{ return pending_.load(std::memory_order_acquire) == 0; }}
+
+private:
+    friend class JobSystem;
+    std::atomic<std::size_t> pending_{{0}};
+}};
+
+// Worker threads fed from one queue. Waiting threads run queued jobs instead
+// of blocking, so jobs may submit and wait for jobs of their own (a system
+// splitting its view with ParallelFor) without deadlocking the pool.
+// Jobs must not throw.
+class JobSystem {{
+public:
+    // workerCount == 0: one worker per hardware thread besides the caller
+    explicit JobSystem(std::size_t workerCount = 0);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    void Submit(WaitGroup& group, std::function<void()> job);
+    // Runs queued jobs on the calling thread until every job in group is done
+    void Wait(WaitGroup& group);
+
+    // Calls body(begin, end) over [0, count) in chunks of at least grain items
+    void ParallelFor(std::size_t count, std::size_t grain,
+                     const std::function<void(std::size_t, std::size_t)>& body);
+
+    std::size_t GetWorkerCount() const {{ return workers_.size(); }}
+
+private:
+    struct Job {{
+        std::function<void()> run;
+        WaitGroup* group = nullptr;
+    }};
+
+    bool RunOne();
+    void WorkerLoop();
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::deque<Job> queue_;
+    bool stopping_ = false;
+    std::vector<std::thread> workers_;
+}};
+
+}} // namespace {}
+)",
+                       options_.projectName, options_.projectName);
+}
+
+std::string GameEngineTemplate::getJobSystemSourceContent() {
+    if (usesPerfRuntime()) {
+        return getWorkStealingJobSystemSourceContent();
+    }
+
+    return fmt::format(R"(#include "job_system.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace {} {{
+
+JobSystem::JobSystem(std::size_t workerCount) {{
+    if (workerCount == 0) {{
+        unsigned hardware = std::thread::hardware_concurrency();
+        workerCount = hardware > 1 ? hardware - 1 : 0;
+    }}
+    for (std::size_t i = 0; i < workerCount; ++i) {{
+        workers_.emplace_back([this]() {{ WorkerLoop(); }});
+    }}
+}}
+
+JobSystem::~JobSystem() {{
+    {{
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }}
+    wake_.notify_all();
+    for (auto& worker : workers_) {{
+        worker.join();
+    }}
+}}
+
+void JobSystem::Submit(WaitGroup& group, std::function<void()> job) {{
+    group.pending_.fetch_add(1, std::memory_order_relaxed);
+    {{
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push_back(Job{{std::move(job), &group}});
+    }}
+    wake_.notify_one();
+}}
+
+void JobSystem::Wait(WaitGroup& group) {{
+    while (!group.IsDone()) {{
+        if (!RunOne()) {{
+            std::this_thread::yield();
+        }}
+    }}
+}}
+
+void JobSystem::ParallelFor(std::size_t count, std::size_t grain,
+                            const std::function<void(std::size_t, std::size_t)>& body) {{
+    if (count == 0) return;
+
+    // A few chunks per thread smooth out uneven work without drowning in jobs
+    std::size_t threads = workers_.size() + 1;
+    std::size_t chunk = std::max<std::size_t>(std::max<std::size_t>(grain, 1),
+                                              (count + threads * 4 - 1) / (threads * 4));
+    if (chunk >= count || workers_.empty()) {{
+        body(0, count);
+        return;
+    }}
+
+    WaitGroup group;
+    for (std::size_t begin = chunk; begin < count; begin += chunk) {{
+        std::size_t end = std::min(count, begin + chunk);
+        Submit(group, [&body, begin, end]() {{ body(begin, end); }});
+    }}
+    body(0, chunk);
+    Wait(group);
+}}
+
+bool JobSystem::RunOne() {{
+    Job job;
+    {{
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (queue_.empty()) return false;
+        job = std::move(queue_.front());
+        queue_.pop_front();
+    }}
+    job.run();
+    job.group->pending_.fetch_sub(1, std::memory_order_release);
+    return true;
+}}
+
+void JobSystem::WorkerLoop() {{
+    for (;;) {{
+        {{
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait_for(lock, std::chrono::milliseconds(100),
+                           [this]() {{ return stopping_ || !queue_.empty(); }});
+            if (stopping_ && queue_.empty()) return;
+        }}
+        while (RunOne()) {{
+        }}
+    }}
+}}
+
+}} // namespace {}
+)",
+                       options_.projectName, options_.projectName);
+}
+
+std::string GameEngineTemplate::getEcsBenchmarkContent() {
+    return fmt::format(R"(// Iteration cost of the sparse-set ECS against the pointer-per-entity layout it
+// replaces. Every pass integrates Velocity into Transform for each entity;
+// a quarter of the entities also carry a RenderComponent.
+//   {}_ecs_bench [--entities N] [--passes P] [--workers W]
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+#include "engine/core/job_system.h"
+#include "engine/core/registry.h"
+#include "engine/core/system.h"
+
+namespace {{
+
+using Clock = std::chrono::steady_clock;
+
+// The layout of the classic template: heap entities holding type-keyed components
+struct LegacyComponent {{
+    virtual ~LegacyComponent() = default;
+}};
+struct LegacyTransform : LegacyComponent {{
+    float position[3] = {{0.0f, 0.0f, 0.0f}};
+}};
+struct LegacyVelocity : LegacyComponent {{
+    float linear[3] = {{1.0f, 0.5f, 0.25f}};
+}};
+struct LegacyEntity {{
+    std::unordered_map<std::type_index, std::unique_ptr<LegacyComponent>> components;
+}};
+
+template <typename Fn>
+double TimePasses(int passes, Fn&& pass) {{
+    auto start = Clock::now();
+    for (int i = 0; i < passes; ++i) {{
+        pass();
+    }}
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count() / passes;
+}}
+
+void Report(const char* name, double msPerPass, std::size_t entities) {{
+    std::cout << std::left << std::setw(34) << name << std::right << std::fixed
+              << std::setprecision(2) << std::setw(9) << msPerPass << " ms/pass"
+              << std::setw(9) << msPerPass * 1e6 / static_cast<double>(entities) << " ns/entity"
+              << std::endl;
+}}
+
+}} // namespace
+
+int main(int argc, char* argv[]) {{
+    std::size_t entityCount = 1000000;
+    int passes = 20;
+    std::size_t workers = 0;
+    for (int i = 1; i + 1 < argc; i += 2) {{
+        if (std::strcmp(argv[i], "--entities") == 0) {{
+            entityCount = std::strtoul(argv[i + 1], nullptr, 10);
+        }} else if (std::strcmp(argv[i], "--passes") == 0) {{
+            passes = std::max(1, std::atoi(argv[i + 1]));
+        }} else if (std::strcmp(argv[i], "--workers") == 0) {{
+            workers = std::strtoul(argv[i + 1], nullptr, 10);
+        }} else {{
+            std::cerr << "Unknown option: " << argv[i] << std::endl;
+            return 1;
+        }}
+    }}
+    const float dt = 1.0f / 60.0f;
+
+    {}::Registry registry;
+    registry.Reserve(entityCount);
+    registry.GetPool<{}::Transform>().Reserve(entityCount);
+    registry.GetPool<{}::Velocity>().Reserve(entityCount);
+    for (std::size_t i = 0; i < entityCount; ++i) {{
+        {}::Entity entity = registry.Create();
+        registry.Emplace<{}::Transform>(entity);
+        registry.Emplace<{}::Velocity>(entity, {}::Velocity{{{{1.0f, 0.5f, 0.25f}}}});
+        if (i % 4 == 0) {{
+            registry.Emplace<{}::RenderComponent>(entity);
+        }}
+    }}
+
+    std::vector<std::shared_ptr<LegacyEntity>> legacy;
+    legacy.reserve(entityCount);
+    for (std::size_t i = 0; i < entityCount; ++i) {{
+        auto entity = std::make_shared<LegacyEntity>();
+        entity->components[typeid(LegacyTransform)] = std::make_unique<LegacyTransform>();
+        entity->components[typeid(LegacyVelocity)] = std::make_unique<LegacyVelocity>();
+        legacy.push_back(std::move(entity));
+    }}
+
+    {}::JobSystem jobs(workers);
+    std::cout << entityCount << " entities, " << passes << " passes, " << jobs.GetWorkerCount() + 1
+              << " threads" << std::endl;
+
+    Report("shared_ptr + unordered_map", TimePasses(passes, [&]() {{
+               for (const auto& entity : legacy) {{
+                   auto* transform = static_cast<LegacyTransform*>(
+                       entity->components.at(typeid(LegacyTransform)).get());
+                   auto* velocity = static_cast<LegacyVelocity*>(
+                       entity->components.at(typeid(LegacyVelocity)).get());
+                   for (int axis = 0; axis < 3; ++axis) {{
+                       transform->position[axis] += velocity->linear[axis] * dt;
+                   }}
+               }}
+           }}),
+           entityCount);
+
+    auto view = registry.View<{}::Transform, {}::Velocity>();
+    Report("view<Transform, Velocity>", TimePasses(passes, [&]() {{
+               view.Each([dt]({}::Entity, {}::Transform& transform,
+                              const {}::Velocity& velocity) {{
+                   for (int axis = 0; axis < 3; ++axis) {{
+                       transform.position[axis] += velocity.linear[axis] * dt;
+                   }}
+               }});
+           }}),
+           entityCount);
+
+    {}::Scheduler scheduler;
+    scheduler.AddSystem(std::make_unique<{}::MovementSystem>());
+    Report("MovementSystem via JobSystem",
+           TimePasses(passes, [&]() {{ scheduler.Run(registry, jobs, dt); }}), entityCount);
+
+    std::size_t rendered = 0;
+    Report("view<Transform, RenderComponent>", TimePasses(passes, [&]() {{
+               rendered = 0;
+               registry.View<{}::Transform, {}::RenderComponent>().Each(
+                   [&rendered]({}::Entity, const {}::Transform&,
+                               const {}::RenderComponent& render) {{
+                       rendered += render.visible ? 1 : 0;
+                   }});
+           }}),
+           entityCount);
+    std::cout << rendered << " of " << entityCount << " entities matched the render view" << std::endl;
+    return 0;
+}}
+)",
+                       options_.projectName, options_.projectName, options_.projectName,
+                       options_.projectName, options_.projectName, options_.projectName,
+                       options_.projectName, options_.projectName, options_.projectName,
+                       options_.projectName, options_.projectName, options_.projectName,
+                       options_.projectName, options_.projectName, options_.projectName,
+                       options_.projectName, options_.projectName, options_.projectName,
+                       options_.projectName, options_.projectName, options_.projectName,
+                       options_.projectName);
+}
+
+std::string GameEngineTemplate::getPerfEngineHeaderContent() {
+    return fmt::format(R"(#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "job_system.h"
+#include "task_graph.h"
+#include "../memory/frame_arena.h"
+
+namespace {} {{
+
+class Renderer;
+class InputManager;
+class ResourceManager;
+class SceneManager;
+
+class Engine {{
+public:
+    Engine();
+    ~Engine();
+
+    bool Initialize(const std::string& configPath = "config/engine.json");
+    void Run();
+    void Shutdown();
+
+    // Subsystem access
+    Renderer* GetRenderer() const {{ return renderer_.get(); }}
+    InputManager* GetInputManager() const {{ return inputManager_.get(); }}
+    ResourceManager* GetResourceManager() const {{ return resourceManager_.get(); }}
+    SceneManager* GetSceneManager() const {{ return sceneManager_.get(); }}
+
+    // Engine state
+    bool IsRunning() const {{ return isRunning_; }}
+    void Stop() {{ isRunning_ = false; }}
+
+    // Time management
+    float GetDeltaTime() const {{ return deltaTime_; }}
+    double GetTotalTime() const {{ return totalTime_; }}
+
+    // Frame runtime
+    JobSystem* GetJobSystem() const {{ return jobs_.get(); }}
+    // Scratch memory released at the start of every frame
+    FrameArena& GetFrameArena() {{ return frameArena_; }}
+
+    // Update tasks run first and render-preparation tasks once every update
+    // task has finished; both run on the job system. Order tasks within a
+    // phase with GetFrameGraph().Precede().
+    TaskGraph::TaskId AddUpdateTask(std::string name, std::function<void()> work);
+    TaskGraph::TaskId AddRenderPrepTask(std::string name, std::function<void()> work);
+    TaskGraph& GetFrameGraph() {{ return frameGraph_; }}
+
+private:
+    void Update(float deltaTime);
+    void Render();
+
+    bool isRunning_;
+    float deltaTime_;
+    double totalTime_;
+
+    // Subsystems
+    std::unique_ptr<Renderer> renderer_;
+    std::unique_ptr<InputManager> inputManager_;
+    std::unique_ptr<ResourceManager> resourceManager_;
+    std::unique_ptr<SceneManager> sceneManager_;
+
+    // Frame runtime
+    std::unique_ptr<JobSystem> jobs_;
+    TaskGraph frameGraph_;
+    TaskGraph::TaskId updateDone_ = 0;
+    FrameArena frameArena_;
+}};
+
+}} // namespace {}
+)",
+                       options_.projectName, options_.projectName);
+}
+
+std::string GameEngineTemplate::getPerfEngineSourceContent() {
+    // Sparse-set scenes run their systems on the engine's workers instead of a pool of their own
+    std::string sceneJobs;
+    if (usesSparseSetEcs()) {
+        sceneJobs = "    sceneManager_->SetJobSystem(jobs_.get());\n";
+    }
+
+    return fmt::format(R"(#include "engine.h"
+#include "profiler.h"
+#include "../graphics/renderer.h"
+#include "../input/input_manager.h"
+#include "../resources/resource_manager.h"
+#include "../scene/scene_manager.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+namespace {} {{
+
+Engine::Engine()
+    : isRunning_(false), deltaTime_(0.0f), totalTime_(0.0) {{
+}}
+
+Engine::~Engine() {{
+    Shutdown();
+}}
+
+bool Engine::Initialize(const std::string& configPath) {{
+    std::cout << "Initializing {} Engine..." << std::endl;
+
+    Profiler::Get().SetThreadName("Main");
+    jobs_ = std::make_unique<JobSystem>(0, [](std::size_t index) {{
+        Profiler::Get().SetThreadName("Worker " + std::to_string(index));
+    }});
+
+    // Initialize subsystems
+    renderer_ = std::make_unique<Renderer>();
+    if (!renderer_->Initialize()) {{
+        std::cerr << "Failed to initialize renderer" << std::endl;
+        return false;
+    }}
+
+    inputManager_ = std::make_unique<InputManager>();
+    if (!inputManager_->Initialize()) {{
+        std::cerr << "Failed to initialize input manager" << std::endl;
+        return false;
+    }}
+
+    resourceManager_ = std::make_unique<ResourceManager>();
+    if (!resourceManager_->Initialize()) {{
+        std::cerr << "Failed to initialize resource manager" << std::endl;
+        return false;
+    }}
+
+    sceneManager_ = std::make_unique<SceneManager>();
+{}    if (!sceneManager_->Initialize()) {{
+        std::cerr << "Failed to initialize scene manager" << std::endl;
+        return false;
+    }}
+
+    // Frame graph: update tasks, then render preparation
+    updateDone_ = frameGraph_.AddTask("Update.Done", nullptr);
+    AddUpdateTask("Scene.Update", [this]() {{ sceneManager_->Update(deltaTime_); }});
+
+    // ENGINE_TRACE=trace.json records the first frames as a Chrome trace
+    if (const char* tracePath = std::getenv("ENGINE_TRACE")) {{
+        Profiler::Get().BeginCapture(300, tracePath);
+    }}
+
+    std::cout << "Engine initialized successfully with " << jobs_->GetWorkerCount()
+              << " worker threads" << std::endl;
+    return true;
+}}
+
+TaskGraph::TaskId Engine::AddUpdateTask(std::string name, std::function<void()> work) {{
+    TaskGraph::TaskId task = frameGraph_.AddTask(std::move(name), std::move(work));
+    frameGraph_.Precede(task, updateDone_);
+    return task;
+}}
+
+TaskGraph::TaskId Engine::AddRenderPrepTask(std::string name, std::function<void()> work) {{
+    TaskGraph::TaskId task = frameGraph_.AddTask(std::move(name), std::move(work));
+    frameGraph_.Precede(updateDone_, task);
+    return task;
+}}
+
+void Engine::Run() {{
+    isRunning_ = true;
+
+    auto lastTime = std::chrono::high_resolution_clock::now();
+
+    while (isRunning_) {{
+        Profiler::Get().BeginFrame();
+        frameArena_.Reset();
+
+        auto currentTime = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(currentTime - lastTime);
+        deltaTime_ = duration.count() / 1000000.0f;
+        totalTime_ += deltaTime_;
+        lastTime = currentTime;
+
+        // Update input
+        {{
+            ENGINE_PROFILE_SCOPE("Input");
+            inputManager_->Update();
+        }}
+
+        // Check for exit condition
+        if (inputManager_->IsKeyPressed("Escape")) {{
+            Stop();
+        }}
+
+        // Update game logic and prepare rendering on the job system
+        Update(deltaTime_);
+
+        // Render frame
+        Render();
+
+        Profiler::Get().EndFrame();
+    }}
+}}
+
+void Engine::Update(float deltaTime) {{
+    ENGINE_PROFILE_SCOPE("Update");
+    (void)deltaTime;  // Tasks read deltaTime_
+    frameGraph_.Run(*jobs_);
+}}
+
+void Engine::Render() {{
+    ENGINE_PROFILE_SCOPE("Render");
+    renderer_->BeginFrame();
+    sceneManager_->Render(renderer_.get());
+    renderer_->EndFrame();
+}}
+
+void Engine::Shutdown() {{
+    std::cout << "Shutting down engine..." << std::endl;
+
+    if (jobs_) {{
+        Profiler::Get().FinishCapture();
+        std::cout << "Average CPU time per frame:" << std::endl;
+        for (const auto& stats : Profiler::Get().GetStats()) {{
+            std::cout << "  " << stats.name << ": " << stats.averageMs << " ms, max "
+                      << stats.maxMs << " ms" << std::endl;
+        }}
+    }}
+
+    sceneManager_.reset();
+    resourceManager_.reset();
+    inputManager_.reset();
+    renderer_.reset();
+    jobs_.reset();
+
+    std::cout << "Engine shutdown complete." << std::endl;
+}}
+
+}} // namespace {}
+)",
+                       options_.projectName, options_.projectName, sceneJobs,
+                       options_.projectName);
+}
+
+std::string GameEngineTemplate::getWorkStealingJobSystemHeaderContent() {
+    return fmt::format(R"(#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {} {{
+
+// Counts the jobs of one batch that have not finished yet
+class WaitGroup {{
+public:
+    bool IsDone() const {{ return pending_.load(std::memory_order_acquire) == 0; }}
+
+private:
+    friend class JobSystem;
+    std::atomic<std::size_t> pending_{{0}};
+}};
+
+// Work-stealing thread pool. Each worker owns a deque: it pushes and pops its
+// own jobs at the back, newest first while their data is still in cache, and
+// idle threads steal the oldest jobs from the front of other deques. Threads
+// outside the pool submit to a shared injection queue. Waiting threads run
+// jobs instead of blocking, so jobs may submit and wait for jobs of their own
+// without deadlocking the pool. Jobs must not throw.
+class JobSystem {{
+public:
+    // Runs on each worker thread before its first job (naming threads for the profiler)
+    using WorkerStartHook = std::function<void(std::size_t workerIndex)>;
+
+    // workerCount == 0: one worker per hardware thread besides the caller
+    explicit JobSystem(std::size_t workerCount = 0, WorkerStartHook onWorkerStart = {{}});
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    void Submit(WaitGroup& group, std::function<void()> job);
+    // Runs jobs on the calling thread until every job in group is done
+    void Wait(WaitGroup& group);
+
+    // Calls body(begin, end) over [0, count) in chunks of at least grain items
+    void ParallelFor(std::size_t count, std::size_t grain,
+                     const std::function<void(std::size_t, std::size_t)>& body);
+
+    std::size_t GetWorkerCount() const {{ return workers_.size(); }}
+
+private:
+    struct Job {{
+        std::function<void()> run;
+        WaitGroup* group = nullptr;
+    }};
+
+    struct alignas(64) Queue {{
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    }};
+
+    bool PopLocal(std::size_t queue, Job& job);
+    bool Steal(std::size_t thief, Job& job);
+    bool RunOne();
+    void Execute(Job& job);
+    void WorkerLoop(std::size_t index, const WorkerStartHook& onWorkerStart);
+
+    // queues_[0] is the injection queue, queues_[i + 1] belongs to worker i
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::atomic<std::size_t> queued_{{0}};
+    std::atomic<std::size_t> sleeping_{{0}};
+    std::mutex sleepMutex_;
+    std::condition_variable wake_;
+    bool stopping_ = false;
+    std::vector<std::thread> workers_;
+}};
+
+}} // namespace {}
+)",
+                       options_.projectName, options_.projectName);
+}
+
+std::string GameEngineTemplate::getWorkStealingJobSystemSourceContent() {
+    return fmt::format(R"(#include "job_system.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace {} {{
+
+namespace {{
+
+// The pool the calling thread works for and the deque it owns there
+thread_local const JobSystem* currentPool = nullptr;
+thread_local std::size_t currentQueue = 0;
+
+}} // namespace
+
+JobSystem::JobSystem(std::size_t workerCount, WorkerStartHook onWorkerStart) {{
+    if (workerCount == 0) {{
+        unsigned hardware = std::thread::hardware_concurrency();
+        workerCount = hardware > 1 ? hardware - 1 : 0;
+    }}
+    for (std::size_t i = 0; i <= workerCount; ++i) {{
+        queues_.push_back(std::make_unique<Queue>());
+    }}
+    for (std::size_t i = 0; i < workerCount; ++i) {{
+        workers_.emplace_back([this, i, onWorkerStart]() {{ WorkerLoop(i, onWorkerStart); }});
+    }}
+}}
+
+JobSystem::~JobSystem() {{
+    {{
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        stopping_ = true;
+    }}
+    wake_.notify_all();
+    for (auto& worker : workers_) {{
+        worker.join();
+    }}
+}}
+
+void JobSystem::Submit(WaitGroup& group, std::function<void()> job) {{
+    group.pending_.fetch_add(1, std::memory_order_relaxed);
+    std::size_t queue = currentPool == this ? currentQueue : 0;
+    queued_.fetch_add(1);
+    {{
+        std::lock_guard<std::mutex> lock(queues_[queue]->mutex);
+        queues_[queue]->jobs.push_back(Job{{std::move(job), &group}});
+    }}
+    // A worker going to sleep registers in sleeping_ before it rechecks queued_,
+    // so either it sees this job or this sees it and wakes it
+    if (sleeping_.load() > 0) {{
+        {{ std::lock_guard<std::mutex> lock(sleepMutex_); }}
+        wake_.notify_one();
+    }}
+}}
+
+void JobSystem::Wait(WaitGroup& group) {{
+    while (!group.IsDone()) {{
+        if (!RunOne()) {{
+            std::this_thread::yield();
+        }}
+    }}
+}}
+
+void JobSystem::ParallelFor(std::size_t count, std::size_t grain,
+                            const std::function<void(std::size_t, std::size_t)>& body) {{
+    if (count == 0) return;
+
+    // A few chunks per thread leave room for stealing without drowning in jobs
+    std::size_t threads = workers_.size() + 1;
+    std::size_t chunk = std::max<std::size_t>(std::max<std::size_t>(grain, 1),
+                                              (count + threads * 4 - 1) / (threads * 4));
+    if (chunk >= count || workers_.empty()) {{
+        body(0, count);
+        return;
+    }}
+
+    WaitGroup group;
+    for (std::size_t begin = chunk; begin < count; begin += chunk) {{
+        std::size_t end = std::min(count, begin + chunk);
+        Submit(group, [&body, begin, end]() {{ body(begin, end); }});
+    }}
+    body(0, chunk);
+    Wait(group);
+}}
+
+bool JobSystem::PopLocal(std::size_t queue, Job& job) {{
+    std::lock_guard<std::mutex> lock(queues_[queue]->mutex);
+    if (queues_[queue]->jobs.empty()) return false;
+    job = std::move(queues_[queue]->jobs.back());
+    queues_[queue]->jobs.pop_back();
+    return true;
+}}
+
+bool JobSystem::Steal(std::size_t thief, Job& job) {{
+    // Start after the thief's own deque so victims are spread across workers
+    for (std::size_t i = 1; i <= queues_.size(); ++i) {{
+        Queue& victim = *queues_[(thief + i) % queues_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty()) {{
+            job = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+            return true;
+        }}
+    }}
+    return false;
+}}
+
+bool JobSystem::RunOne() {{
+    if (queued_.load(std::memory_order_relaxed) == 0) return false;
+
+    Job job;
+    bool isWorker = currentPool == this && currentQueue != 0;
+    if ((isWorker && PopLocal(currentQueue, job)) ||
+        Steal(currentPool == this ? currentQueue : 0, job)) {{
+        Execute(job);
+        return true;
+    }}
+    return false;
+}}
+
+void JobSystem::Execute(Job& job) {{
+    queued_.fetch_sub(1, std::memory_order_relaxed);
+    job.run();
+    job.group->pending_.fetch_sub(1, std::memory_order_release);
+}}
+
+void JobSystem::WorkerLoop(std::size_t index, const WorkerStartHook& onWorkerStart) {{
+    currentPool = this;
+    currentQueue = index + 1;
+    if (onWorkerStart) {{
+        onWorkerStart(index);
+    }}
+
+    for (;;) {{
+        if (RunOne()) continue;
+
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        if (stopping_) return;
+        sleeping_.fetch_add(1);
+        wake_.wait_for(lock, std::chrono::milliseconds(100),
+                       [this]() {{ return stopping_ || queued_.load() > 0; }});
+        sleeping_.fetch_sub(1);
+        if (stopping_ && queued_.load() == 0) return;
+    }}
+}}
+
+}} // namespace {}
+)",
+                       options_.projectName, options_.projectName);
+}
+
+std::string GameEngineTemplate::getTaskGraphHeaderContent() {
+    return fmt::format(R"(#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {} {{
+
+class JobSystem;
+class WaitGroup;
+
+// A set of tasks with dependencies, built once and run every frame. A task is
+// submitted to the JobSystem only when everything it depends on has finished,
+// so no worker ever blocks waiting for another task and no fibers are needed.
+// The graph must not be modified while it runs.
+class TaskGraph {{
+public:
+    using TaskId = std::size_t;
+
+    // A task without work is a barrier: it only joins its dependencies
+    TaskId AddTask(std::string name, std::function<void()> work);
+    // after starts only once before has finished
+    void Precede(TaskId before, TaskId after);
+
+    // Runs every task once and returns when all have finished. Throws
+    // std::logic_error if the dependencies form a cycle.
+    void Run(JobSystem& jobs);
+
+    std::size_t GetTaskCount() const {{ return tasks_.size(); }}
+    const std::string& GetTaskName(TaskId id) const {{ return tasks_[id]->name; }}
+
+private:
+    struct Task {{
+        std::string name;
+        std::function<void()> work;
+        std::vector<TaskId> successors;
+        std::size_t dependencyCount = 0;
+        std::atomic<std::size_t> remaining{{0}};
+    }};
+
+    void Validate();
+    void Schedule(JobSystem& jobs, WaitGroup& group, TaskId id);
+
+    std::vector<std::unique_ptr<Task>> tasks_;
+    std::vector<TaskId> roots_;
+    bool validated_ = false;
+}};
+
+}} // namespace {}
+)",
+                       options_.projectName, options_.projectName);
+}
+
+std::string GameEngineTemplate::getTaskGraphSourceContent() {
+    return fmt::format(R"(#include "task_graph.h"
+
+#include <stdexcept>
+
+#include "job_system.h"
+#include "profiler.h"
+
+namespace {} {{
+
+TaskGraph::TaskId TaskGraph::AddTask(std::string name, std::function<void()> work) {{
+    auto task = std::make_unique<Task>();
+    task->name = std::move(name);
+    task->work = std::move(work);
+    tasks_.push_back(std::move(task));
+    validated_ = false;
+    return tasks_.size() - 1;
+}}
+
+void TaskGraph::Precede(TaskId before, TaskId after) {{
+    tasks_.at(before)->successors.push_back(after);
+    tasks_.at(after)->dependencyCount++;
+    validated_ = false;
+}}
+
+void TaskGraph::Validate() {{
+    // Kahn's algorithm: every task is reachable in dependency order unless there is a cycle
+    roots_.clear();
+    std::vector<std::size_t> remaining(tasks_.size());
+    std::vector<TaskId> ready;
+    for (TaskId id = 0; id < tasks_.size(); ++id) {{
+        remaining[id] = tasks_[id]->dependencyCount;
+        if (remaining[id] == 0) {{
+            roots_.push_back(id);
+            ready.push_back(id);
+        }}
+    }}
+    std::size_t visited = 0;
+    while (!ready.empty()) {{
+        TaskId id = ready.back();
+        ready.pop_back();
+        ++visited;
+        for (TaskId successor : tasks_[id]->successors) {{
+            if (--remaining[successor] == 0) {{
+                ready.push_back(successor);
+            }}
+        }}
+    }}
+    if (visited != tasks_.size()) {{
+        throw std::logic_error("TaskGraph contains a dependency cycle");
+    }}
+    validated_ = true;
+}}
+
+void TaskGraph::Run(JobSystem& jobs) {{
+    if (!validated_) {{
+        Validate();
+    }}
+    for (auto& task : tasks_) {{
+        task->remaining.store(task->dependencyCount, std::memory_order_relaxed);
+    }}
+
+    WaitGroup group;
+    for (TaskId root : roots_) {{
+        Schedule(jobs, group, root);
+    }}
+    jobs.Wait(group);
+}}
+
+void TaskGraph::Schedule(JobSystem& jobs, WaitGroup& group, TaskId id) {{
+    jobs.Submit(group, [this, &jobs, &group, id]() {{
+        Task& task = *tasks_[id];
+        if (task.work) {{
+            ProfileScope scope(task.name.c_str());
+            task.work();
+        }}
+        // Successors are submitted before this job counts as done, so the
+        // group cannot drain while tasks are still ready to run
+        for (TaskId successor : task.successors) {{
+            if (tasks_[successor]->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {{
+                Schedule(jobs, group, successor);
+            }}
+        }}
+    }});
+}}
+
+}} // namespace {}
+)",
+                       options_.projectName, options_.projectName);
+}
+
+std::string GameEngineTemplate::getProfilerHeaderContent() {
+    return fmt::format(R"(#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {} {{
+
+// Frame profiler. ProfileScope records the CPU time of a named scope on any
+// thread; EndFrame folds the frame's samples into per-scope statistics and,
+// while a capture runs, keeps them for a Chrome trace (chrome://tracing or
+// ui.perfetto.dev). Scope names must stay valid until the end of the frame.
+class Profiler {{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct ScopeStats {{
+        std::string name;
+        double lastMs = 0.0;     // Total time in the scope during the last frame
+        double averageMs = 0.0;  // Per frame, over the frames the scope ran in
+        double maxMs = 0.0;
+        std::uint64_t frames = 0;
+    }};
+
+    static Profiler& Get();
+
+    void BeginFrame();
+    void EndFrame();
+
+    // Names the calling thread in traces
+    void SetThreadName(std::string name);
+    void Record(const char* name, Clock::time_point start, Clock::time_point end);
+
+    // Keeps every sample of the next frameCount frames and writes them to path
+    void BeginCapture(std::size_t frameCount, std::string path);
+    // Writes a capture that is still running, for sessions shorter than the capture
+    void FinishCapture();
+    bool IsCapturing() const;
+    bool WriteChromeTrace(const std::string& path) const;
+
+    // Sorted by average time, most expensive first
+    std::vector<ScopeStats> GetStats() const;
+
+private:
+    struct Sample {{
+        const char* name;
+        Clock::time_point start;
+        Clock::time_point end;
+    }};
+
+    struct ThreadBuffer {{
+        std::mutex mutex;
+        std::vector<Sample> samples;
+        std::string name;
+        std::uint32_t id = 0;
+    }};
+
+    struct TraceEvent {{
+        std::string name;
+        std::uint32_t threadId;
+        double startUs;
+        double durationUs;
+    }};
+
+    Profiler() = default;
+    ThreadBuffer& LocalBuffer();
+    void WriteCapture(const std::string& path);
+
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<ThreadBuffer>> threads_;
+    std::unordered_map<std::string, ScopeStats> stats_;
+    std::vector<TraceEvent> trace_;
+    std::size_t captureFramesLeft_ = 0;
+    std::string capturePath_;
+    Clock::time_point epoch_ = Clock::now();
+    Clock::time_point frameStart_ = epoch_;
+}};
+
+class ProfileScope {{
+public:
+    explicit ProfileScope(const char* name) : name_(name), start_(Profiler::Clock::now()) {{}}
+    ~ProfileScope() {{ Profiler::Get().Record(name_, start_, Profiler::Clock::now()); }}
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* name_;
+    Profiler::Clock::time_point start_;
+}};
+
+}} // namespace {}
+
+#define ENGINE_PROFILE_CONCAT_IMPL(a, b) a##b
+#define ENGINE_PROFILE_CONCAT(a, b) ENGINE_PROFILE_CONCAT_IMPL(a, b)
+#define ENGINE_PROFILE_SCOPE(name) \
+    ::{}::ProfileScope ENGINE_PROFILE_CONCAT(profileScope, __LINE__)(name)
+)",
+                       options_.projectName, options_.projectName, options_.projectName);
+}
+
+std::string GameEngineTemplate::getProfilerSourceContent() {
+    return fmt::format(R"(#include "profiler.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+namespace {} {{
+
+namespace {{
+
+thread_local void* localBuffer = nullptr;
+
+std::string EscapeJson(const std::string& text) {{
+    std::string escaped;
+    escaped.reserve(text.size());
+    for (char c : text) {{
+        if (c == '"' || c == '\\') {{
+            escaped += '\\';
+            escaped += c;
+        }} else if (static_cast<unsigned char>(c) < 0x20) {{
+            char code[8];
+            std::snprintf(code, sizeof(code), "\\u%04x", static_cast<unsigned>(c));
+            escaped += code;
+        }} else {{
+            escaped += c;
+        }}
+    }}
+    return escaped;
+}}
+
+}} // namespace
+
+Profiler& Profiler::Get() {{
+    static Profiler profiler;
+    return profiler;
+}}
+
+Profiler::ThreadBuffer& Profiler::LocalBuffer() {{
+    if (!localBuffer) {{
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto buffer = std::make_unique<ThreadBuffer>();
+        buffer->id = static_cast<std::uint32_t>(threads_.size());
+        buffer->name = "Thread " + std::to_string(buffer->id);
+        localBuffer = buffer.get();
+        threads_.push_back(std::move(buffer));
+    }}
+    return *static_cast<ThreadBuffer*>(localBuffer);
+}}
+
+void Profiler::SetThreadName(std::string name) {{
+    ThreadBuffer& buffer = LocalBuffer();
+    std::lock_guard<std::mutex> lock(mutex_);
+    buffer.name = std::move(name);
+}}
+
+void Profiler::Record(const char* name, Clock::time_point start, Clock::time_point end) {{
+    ThreadBuffer& buffer = LocalBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    buffer.samples.push_back(Sample{{name, start, end}});
+}}
+
+void Profiler::BeginFrame() {{
+    frameStart_ = Clock::now();
+}}
+
+void Profiler::EndFrame() {{
+    Record("Frame", frameStart_, Clock::now());
+
+    std::string finishedCapture;
+    {{
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::unordered_map<std::string, double> frameTotals;
+        for (auto& thread : threads_) {{
+            std::vector<Sample> samples;
+            {{
+                std::lock_guard<std::mutex> threadLock(thread->mutex);
+                samples.swap(thread->samples);
+            }}
+            for (const Sample& sample : samples) {{
+                std::chrono::duration<double, std::micro> start = sample.start - epoch_;
+                std::chrono::duration<double, std::micro> duration = sample.end - sample.start;
+                frameTotals[sample.name] += duration.count() / 1000.0;
+                if (captureFramesLeft_ > 0) {{
+                    trace_.push_back(
+                            TraceEvent{{sample.name, thread->id, start.count(), duration.count()}});
+                }}
+            }}
+        }}
+
+        for (auto& [name, stats] : stats_) {{
+            stats.lastMs = 0.0;
+        }}
+        for (const auto& [name, totalMs] : frameTotals) {{
+            ScopeStats& stats = stats_[name];
+            stats.name = name;
+            stats.lastMs = totalMs;
+            stats.maxMs = std::max(stats.maxMs, totalMs);
+            stats.averageMs += (totalMs - stats.averageMs) / static_cast<double>(++stats.frames);
+        }}
+
+        if (captureFramesLeft_ > 0 && --captureFramesLeft_ == 0) {{
+            finishedCapture = capturePath_;
+        }}
+    }}
+
+    // Written outside the lock; a finished capture is no longer touched by EndFrame
+    if (!finishedCapture.empty()) {{
+        WriteCapture(finishedCapture);
+    }}
+}}
+
+void Profiler::WriteCapture(const std::string& path) {{
+    if (WriteChromeTrace(path)) {{
+        std::cout << "Wrote frame trace to " << path << std::endl;
+    }} else {{
+        std::cerr << "Failed to write frame trace to " << path << std::endl;
+    }}
+    std::lock_guard<std::mutex> lock(mutex_);
+    trace_.clear();
+}}
+
+void Profiler::BeginCapture(std::size_t frameCount, std::string path) {{
+    std::lock_guard<std::mutex> lock(mutex_);
+    trace_.clear();
+    captureFramesLeft_ = frameCount;
+    capturePath_ = std::move(path);
+}}
+
+void Profiler::FinishCapture() {{
+    std::string path;
+    {{
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (captureFramesLeft_ == 0) return;
+        captureFramesLeft_ = 0;
+        path = capturePath_;
+    }}
+    WriteCapture(path);
+}}
+
+bool Profiler::IsCapturing() const {{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return captureFramesLeft_ > 0;
+}}
+
+bool Profiler::WriteChromeTrace(const std::string& path) const {{
+    std::ofstream out(path);
+    if (!out) return false;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    out << "{{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for (const auto& thread : threads_) {{
+        out << (first ? "\n" : ",\n") << "{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+            << thread->id << ",\"args\":{{\"name\":\"" << EscapeJson(thread->name) << "\"}}}}";
+        first = false;
+    }}
+    out.setf(std::ios::fixed);
+    out.precision(3);
+    for (const TraceEvent& event : trace_) {{
+        out << (first ? "\n" : ",\n") << "{{\"name\":\"" << EscapeJson(event.name)
+            << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.threadId
+            << ",\"ts\":" << event.startUs << ",\"dur\":" << event.durationUs << "}}";
+        first = false;
+    }}
+    out << "\n]}}\n";
+    return static_cast<bool>(out);
+}}
+
+std::vector<Profiler::ScopeStats> Profiler::GetStats() const {{
+    std::vector<ScopeStats> stats;
+    {{
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& entry : stats_) {{
+            stats.push_back(entry.second);
+        }}
+    }}
+    std::sort(stats.begin(), stats.end(), [](const ScopeStats& a, const ScopeStats& b) {{
+        return a.averageMs > b.averageMs;
+    }});
+    return stats;
+}}
+
+}} // namespace {}
+)",
+                       options_.projectName, options_.projectName);
+}
+
+std::string GameEngineTemplate::getFrameArenaHeaderContent() {
+    return fmt::format(R"(#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {} {{
+
+// Linear allocator for data that lives for one frame: allocation bumps an
+// offset and Reset() frees everything at once. Allocate may be called from
+// jobs; Reset must not run concurrently with it. A frame that outgrows the
+// arena falls back to the heap and the arena grows to that frame's peak on the
+// next Reset, so steady-state frames never allocate from the heap.
+class FrameArena {{
+public:
+    explicit FrameArena(std::size_t capacity = 4 * 1024 * 1024);
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    // alignment must be a power of two
+    void* Allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+
+    // The arena never runs destructors, so only trivially destructible types fit
+    template <typename T, typename... Args>
+    T* New(Args&&... args) {{
+        static_assert(std::is_trivially_destructible_v<T>,
+                      "FrameArena never runs destructors");
+        return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }}
+
+    template <typename T>
+    T* NewArray(std::size_t count) {{
+        static_assert(std::is_trivially_destructible_v<T>,
+                      "FrameArena never runs destructors");
+        T* items = static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+        std::uninitialized_value_construct_n(items, count);
+        return items;
+    }}
+
+    void Reset();
+
+    std::size_t GetCapacity() const {{ return capacity_; }}
+    std::size_t GetUsed() const {{ return offset_.load(std::memory_order_relaxed); }}
+    std::size_t GetPeak() const {{ return peak_; }}
+
+private:
+    void* AllocateOverflow(std::size_t size, std::size_t alignment);
+
+    std::unique_ptr<std::byte[]> memory_;
+    std::size_t capacity_;
+    std::atomic<std::size_t> offset_{{0}};
+    std::size_t peak_ = 0;
+    std::mutex overflowMutex_;
+    std::vector<std::unique_ptr<std::byte[]>> overflow_;
+}};
+
+// Lets standard containers allocate from a FrameArena. Deallocation is a no-op:
+// the memory comes back on Reset, so containers must not outlive the frame.
+template <typename T>
+class FrameAllocator {{
+public:
+    using value_type = T;
+
+    explicit FrameAllocator(FrameArena& arena) : arena_(&arena) {{}}
+    template <typename U>
+    FrameAllocator(const FrameAllocator<U>& other) : arena_(other.GetArena()) {{}}
+
+    T* allocate(std::size_t count) {{
+        return static_cast<T*>(arena_->Allocate(sizeof(T) * count, alignof(T)));
+    }}
+    void deallocate(T*, std::size_t) {{}}
+
+    FrameArena* GetArena() const {{ return arena_; }}
+
+    template <typename U>
+    bool operator==(const FrameAllocator<U>& other) const {{ return arena_ == other.GetArena(); }}
+    template <typename U>
+    bool operator!=(const FrameAllocator<U>& other) const {{ return arena_ != other.GetArena(); }}
+
+private:
+    FrameArena* arena_;
+}};
+
+template <typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+}} // namespace {}
+)",
+                       options_.projectName, options_.projectName);
+}
+
+std::string GameEngineTemplate::getFrameArenaSourceContent() {
+    return fmt::format(R"(#include "frame_arena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace {} {{
+
+namespace {{
+
+void* AlignUp(std::byte* address, std::size_t alignment) {{
+    auto value = reinterpret_cast<std::uintptr_t>(address);
+    value = (value + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+    return reinterpret_cast<void*>(value);
+}}
+
+}} // namespace
+
+FrameArena::FrameArena(std::size_t capacity)
+    : memory_(new std::byte[capacity]), capacity_(capacity) {{
+}}
+
+void* FrameArena::Allocate(std::size_t size, std::size_t alignment) {{
+    // Reserving size + alignment - 1 bytes lets each caller align on its own
+    std::size_t reserved = size + alignment - 1;
+    std::size_t offset = offset_.fetch_add(reserved, std::memory_order_relaxed);
+    if (offset + reserved <= capacity_) {{
+        return AlignUp(memory_.get() + offset, alignment);
+    }}
+    return AllocateOverflow(size, alignment);
+}}
+
+void* FrameArena::AllocateOverflow(std::size_t size, std::size_t alignment) {{
+    std::lock_guard<std::mutex> lock(overflowMutex_);
+    overflow_.emplace_back(new std::byte[size + alignment - 1]);
+    return AlignUp(overflow_.back().get(), alignment);
+}}
+
+void FrameArena::Reset() {{
+    // offset_ keeps counting past the capacity, so it holds the frame's demand
+    std::size_t used = offset_.load(std::memory_order_relaxed);
+    peak_ = std::max(peak_, used);
+    if (used > capacity_) {{
+        capacity_ = used + used / 2;
+        memory_.reset(new std::byte[capacity_]);
+    }}
+    overflow_.clear();
+    offset_.store(0, std::memory_order_relaxed);
+}}
+
+}} // namespace {}
+)",
+                       options_.projectName, options_.projectName);
+}
+
+std::string GameEngineTemplate::getPoolAllocatorHeaderContent() {
+    return fmt::format(R"(#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace {} {{
+
+// Object pool for long-lived objects of one type, such as components or
+// resources. Objects live in fixed chunks that never move and freed slots are
+// reused most recent first, so creating an object is a free-list pop and
+// objects of a type stay packed together instead of scattered across the heap.
+// Not thread-safe; every object must be destroyed before the pool.
+template <typename T, std::size_t ChunkSize = 256>
+class PoolAllocator {{
+public:
+    // Returns the object to its pool when the handle goes away
+    struct Deleter {{
+        PoolAllocator* pool = nullptr;
+        void operator()(T* object) const {{ pool->Destroy(object); }}
+    }};
+    using Handle = std::unique_ptr<T, Deleter>;
+
+    PoolAllocator() = default;
+    ~PoolAllocator() {{ assert(liveCount_ == 0 && "objects outlived their pool"); }}
+
+    PoolAllocator(const PoolAllocator&) = delete;
+    PoolAllocator& operator=(const PoolAllocator&) = delete;
+
+    template <typename... Args>
+    T* Create(Args&&... args) {{
+        if (!freeList_) {{
+            Grow();
+        }}
+        Slot* slot = freeList_;
+        freeList_ = slot->next;
+        try {{
+            T* object = new (slot->storage) T(std::forward<Args>(args)...);
+            ++liveCount_;
+            return object;
+        }} catch (...) {{
+            slot->next = freeList_;
+            freeList_ = slot;
+            throw;
+        }}
+    }}
+
+    template <typename... Args>
+    Handle MakeUnique(Args&&... args) {{
+        return Handle(Create(std::forward<Args>(args)...), Deleter{{this}});
+    }}
+
+    void Destroy(T* object) {{
+        if (!object) return;
+        object->~T();
+        Slot* slot = reinterpret_cast<Slot*>(object);
+        slot->next = freeList_;
+        freeList_ = slot;
+        --liveCount_;
+    }}
+
+    std::size_t GetLiveCount() const {{ return liveCount_; }}
+    std::size_t GetCapacity() const {{ return chunks_.size() * ChunkSize; }}
+
+private:
+    union Slot {{
+        Slot* next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    }};
+
+    void Grow() {{
+        chunks_.emplace_back(new Slot[ChunkSize]);
+        Slot* chunk = chunks_.back().get();
+        // Link back to front so the chunk is handed out in address order
+        for (std::size_t i = ChunkSize; i-- > 0;) {{
+            chunk[i].next = freeList_;
+            freeList_ = &chunk[i];
+        }}
+    }}
+
+    std::vector<std::unique_ptr<Slot[]>> chunks_;
+    Slot* freeList_ = nullptr;
+    std::size_t liveCount_ = 0;
+}};
+
+}} // namespace {}
+)",
+                       options_.projectName, options_.projectName);
+}
@@ -39,6 +39,36 @@ class GameEngineTemplate : public TemplateBase {
     std::string getEntitySourceContent();
     std::string getComponentHeaderContent();
     std::string getSystemHeaderContent();
+
+    // Sparse-set ECS (--game-ecs sparse-set)
+    bool usesSparseSetEcs() const;
+    std::string getSparseEntityHeaderContent();
+    std::string getSparseEntitySourceContent();
+    std::string getSparseComponentHeaderContent();
+    std::string getRegistryHeaderContent();
+    std::string getSparseSystemHeaderContent();
+    std::string getSystemSourceContent();
+    std::string getJobSystemHeaderContent();
+    std::string getJobSystemSourceContent();
+    std::string getEcsBenchmarkContent();
+
+    // Frame runtime (--game-perf)
+    bool usesPerfRuntime() const;
+    bool usesJobSystem() const;
+    std::vector<std::string> getRuntimeSourceFiles() const;
+    std::vector<std::string> getRuntimeHeaderFiles() const;
+    std::string getPerfEngineHeaderContent();
+    std::string getPerfEngineSourceContent();
+    std::string getWorkStealingJobSystemHeaderContent();
+    std::string getWorkStealingJobSystemSourceContent();
+    std::string getTaskGraphHeaderContent();
+    std::string getTaskGraphSourceContent();
+    std::string getProfilerHeaderContent();
+    std::string getProfilerSourceContent();
+    std::string getFrameArenaHeaderContent();
+    std::string getFrameArenaSourceContent();
+    std::string getPoolAllocatorHeaderContent();
+
     std::string getShaderContent(const std::string& shaderType);
     std::string getConfigContent();
     std::string getAssetsReadmeContent();
@@ -1,16 +1,18 @@
 #include "git_repository_template.h"
+#include "../config/config_manager.h"
 #include "../utils/core/file_utils.h"
+#include "../utils/external/download_cache.h"
+#include "../utils/external/git_mirror_cache.h"
 #include "../utils/ui/terminal_utils.h"
 #include <spdlog/spdlog.h>
+#include <algorithm>
 #include <filesystem>
 #include <iostream>
 
 GitRepositoryTemplate::GitRepositoryTemplate(const CliOptions& options)
     : TemplateBase(options), repositoryCloned_(false), authenticationSetup_(false) {
 
-    // Set up paths
-    tempClonePath_ = std::filesystem::temp_directory_path() /
-                    ("cpp_scaffold_clone_" + std::to_string(std::time(nullptr)));
+    // The repository is checked out straight into the project directory
     finalProjectPath_ = std::filesystem::current_path() / options.projectName;
 }
 
@@ -45,6 +47,7 @@ bool GitRepositoryTemplate::create() {
         // Clone repository
         if (!cloneRepository()) {
             spdlog::error("Failed to clone repository");
+            cleanupRepository();
             return false;
         }
         spdlog::info("?Repository cloned successfully");
@@ -57,16 +60,6 @@ bool GitRepositoryTemplate::create() {
         }
         spdlog::info("?Repository processed successfully");
 
-        // Move to final location
-        try {
-            std::filesystem::rename(tempClonePath_, finalProjectPath_);
-            spdlog::info("?Project moved to final location: {}", finalProjectPath_.string());
-        } catch (const std::exception& e) {
-            spdlog::error("Failed to move project to final location: {}", e.what());
-            cleanupRepository();
-            return false;
-        }
-
         // Setup additional configurations based on CLI options
         if (!setupProjectFromRepository()) {
             spdlog::warn("Some project setup steps failed, but project was created");
@@ -118,15 +111,15 @@ bool GitRepositoryTemplate::cloneRepository() {
     try {
         std::string repoUrl = getRepositoryUrl();
 
-        // Create temporary directory
-        std::filesystem::create_directories(tempClonePath_.parent_path());
-
         bool success = false;
 
+        // Unauthenticated sources go through the local mirror cache, so
+        // repeated projects from the same template only fetch new commits.
+        // Credentials are never written into a shared mirror.
         if (hasAuthentication()) {
             success = utils::GitUtils::cloneRepositoryWithAuth(
                 repoUrl,
-                tempClonePath_,
+                finalProjectPath_,
                 options_.gitUsername,
                 options_.gitPassword,
                 options_.sshKeyPath,
@@ -136,19 +129,34 @@ bool GitRepositoryTemplate::cloneRepository() {
                 options_.gitCommit
             );
         } else {
-            success = utils::GitUtils::cloneRepository(
-                repoUrl,
-                tempClonePath_,
-                options_.useShallowClone,
-                options_.gitBranch,
-                options_.gitTag,
-                options_.gitCommit
-            );
+            utils::GitMirrorCache mirrors(
+                    config::ConfigManager::getInstance().getCacheDirectory() / "git",
+                    utils::DownloadCache::settingsFromEnvironment().offline);
+            utils::GitMirrorCache::CheckoutRequest request;
+            request.url = repoUrl;
+            request.branch = options_.gitBranch;
+            request.tag = options_.gitTag;
+            request.commit = options_.gitCommit;
+            request.keepHistory = options_.preserveGitHistory;
+
+            success = mirrors.checkout(request, finalProjectPath_);
+            if (!success) {
+                spdlog::warn("Mirror checkout failed, cloning directly");
+                cleanupRepository();
+                success = utils::GitUtils::cloneRepository(
+                    repoUrl,
+                    finalProjectPath_,
+                    options_.useShallowClone,
+                    options_.gitBranch,
+                    options_.gitTag,
+                    options_.gitCommit
+                );
+            }
         }
 
         if (success) {
             repositoryCloned_ = true;
-            spdlog::info("Repository cloned to temporary location: {}", tempClonePath_.string());
+            spdlog::info("Repository cloned to: {}", finalProjectPath_.string());
         }
 
         return success;
@@ -162,23 +170,23 @@ bool GitRepositoryTemplate::cloneRepository() {
 bool GitRepositoryTemplate::processClonedRepository() {
     try {
         // Validate that it's a C++ project
-        if (!isCppProject(tempClonePath_)) {
+        if (!isCppProject(finalProjectPath_)) {
             spdlog::warn("Repository doesn't appear to be a C++ project, proceeding anyway");
         }
 
         // Validate repository structure
-        if (!hasValidStructure(tempClonePath_)) {
+        if (!hasValidStructure(finalProjectPath_)) {
             spdlog::warn("Repository structure validation failed, proceeding anyway");
         }
 
         // Adapt project name if needed
-        if (!adaptProjectName(tempClonePath_)) {
+        if (!adaptProjectName(finalProjectPath_)) {
             spdlog::warn("Failed to adapt project name");
         }
 
         // Remove .git directory if not preserving history
         if (!options_.preserveGitHistory) {
-            if (utils::GitUtils::removeGitDirectory(tempClonePath_)) {
+            if (utils::GitUtils::removeGitDirectory(finalProjectPath_)) {
                 spdlog::info("Removed .git directory");
             }
         }
@@ -198,9 +206,9 @@ bool GitRepositoryTemplate::validateRepositoryStructure() {
 
 bool GitRepositoryTemplate::cleanupRepository() {
     try {
-        if (std::filesystem::exists(tempClonePath_)) {
-            std::filesystem::remove_all(tempClonePath_);
-            spdlog::info("Cleaned up temporary clone directory");
+        if (std::filesystem::exists(finalProjectPath_)) {
+            std::filesystem::remove_all(finalProjectPath_);
+            spdlog::info("Removed incomplete project directory");
         }
         return true;
     } catch (const std::exception& e) {
@@ -254,10 +262,6 @@ std::string GitRepositoryTemplate::getTargetCommit() const {
     return options_.gitCommit.value_or("");
 }
 
-std::filesystem::path GitRepositoryTemplate::getTempClonePath() const {
-    return tempClonePath_;
-}
-
 std::filesystem::path GitRepositoryTemplate::getFinalProjectPath() const {
     return finalProjectPath_;
 }
@@ -275,29 +279,34 @@ bool GitRepositoryTemplate::setupAuthentication() {
 }
 
 bool GitRepositoryTemplate::isCppProject(const std::filesystem::path& repoPath) const {
-    // Check for common C++ project indicators
-    std::vector<std::string> cppIndicators = {
-        "CMakeLists.txt", "Makefile", "meson.build", "BUILD", "WORKSPACE",
-        "*.cpp", "*.hpp", "*.cc", "*.h", "*.cxx"
+    // Build files at the top level settle it without walking the tree
+    static const std::vector<std::string> buildFiles = {
+        "CMakeLists.txt", "Makefile", "meson.build", "BUILD", "WORKSPACE"
     };
+    for (const auto& file : buildFiles) {
+        if (std::filesystem::exists(repoPath / file)) {
+            return true;
+        }
+    }
 
-    for (const auto& indicator : cppIndicators) {
-        if (indicator.find("*") != std::string::npos) {
-            // Check for file patterns
-            for (const auto& entry : std::filesystem::recursive_directory_iterator(repoPath)) {
-                if (entry.is_regular_file()) {
-                    std::string ext = entry.path().extension().string();
-                    if (ext == ".cpp" || ext == ".hpp" || ext == ".cc" ||
-                        ext == ".h" || ext == ".cxx") {
-                        return true;
-                    }
-                }
-            }
-        } else {
-            // Check for specific files
-            if (std::filesystem::exists(repoPath / indicator)) {
-                return true;
-            }
+    // Otherwise look for a single C++ source, skipping the .git directory
+    static const std::vector<std::string> sourceExtensions = {".cpp", ".hpp", ".cc", ".h", ".cxx"};
+    std::error_code ec;
+    for (auto it = std::filesystem::recursive_directory_iterator(
+                 repoPath, std::filesystem::directory_options::skip_permission_denied, ec);
+         it != std::filesystem::recursive_directory_iterator(); it.increment(ec)) {
+        if (ec) {
+            break;
+        }
+        if (it->path().filename() == ".git") {
+            it.disable_recursion_pending();
+            continue;
+        }
+        std::string ext = it->path().extension().string();
+        if (std::find(sourceExtensions.begin(), sourceExtensions.end(), ext) !=
+                    sourceExtensions.end() &&
+            it->is_regular_file(ec)) {
+            return true;
         }
     }
 
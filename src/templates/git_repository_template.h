@@ -32,7 +32,6 @@ private:
     std::string getTargetBranch() const;
     std::string getTargetTag() const;
     std::string getTargetCommit() const;
-    std::filesystem::path getTempClonePath() const;
     std::filesystem::path getFinalProjectPath() const;
     
     // Authentication helpers
@@ -49,7 +48,6 @@ private:
     bool mergeWithTemplateOptions(const std::filesystem::path& repoPath);
 
     // Member variables
-    std::filesystem::path tempClonePath_;
     std::filesystem::path finalProjectPath_;
     bool repositoryCloned_;
     bool authenticationSetup_;
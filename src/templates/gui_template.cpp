@@ -40,12 +40,6 @@ GuiTemplate::GuiTemplate(const CliOptions& options) : TemplateBase(options) {
 bool GuiTemplate::create() {
     std::string projectPath = options_.projectName;
 
-    // ĿĿ¼ǷѴ
-    if (FileUtils::directoryExists(projectPath)) {
-        std::cout << ": Ŀ¼ '" << projectPath << "' Ѵڡ\n";
-        return false;
-    }
-
     std::cout << "?? ڴGUIĿ (" << guiFramework_ << ")...\n";
 
     // ṹ
@@ -60,6 +54,11 @@ bool GuiTemplate::create() {
         std::cout << "GUIضļʧ\n";
         return false;
     }
+
+    // Project structure and GUI files are queued above and written in one batch
+    if (!flushQueuedFiles()) {
+        return false;
+    }
     std::cout << "??GUIضļѴ\n";
 
     // ϵͳ
@@ -140,40 +139,28 @@ bool GuiTemplate::createProjectStructure() {
 
     // srcĿ¼
     std::string srcPath = FileUtils::combinePath(projectPath, "src");
-    if (!FileUtils::createDirectory(srcPath)) {
-        return false;
-    }
+    enqueueDirectory(srcPath);
 
     // includeĿ¼
     std::string includePath = FileUtils::combinePath(projectPath, "include");
-    if (!FileUtils::createDirectory(includePath)) {
-        return false;
-    }
+    enqueueDirectory(includePath);
 
     std::string includeProjectPath = FileUtils::combinePath(includePath, options_.projectName);
-    if (!FileUtils::createDirectory(includeProjectPath)) {
-        return false;
-    }
+    enqueueDirectory(includeProjectPath);
 
     // ԴĿ¼
     std::string resourcesPath = FileUtils::combinePath(projectPath, "resources");
-    if (!FileUtils::createDirectory(resourcesPath)) {
-        return false;
-    }
+    enqueueDirectory(resourcesPath);
 
     // UIĿ¼ (ڽļ)
     if (guiFramework_ == "qt" || guiFramework_ == "gtk") {
         std::string uiPath = FileUtils::combinePath(projectPath, "ui");
-        if (!FileUtils::createDirectory(uiPath)) {
-            return false;
-        }
+        enqueueDirectory(uiPath);
     }
 
     // дREADME.md
-    if (!FileUtils::writeToFile(FileUtils::combinePath(projectPath, "README.md"),
-                                getReadmeContent())) {
-        return false;
-    }
+    enqueueFile(FileUtils::combinePath(projectPath, "README.md"),
+                [this] { return getReadmeContent(); });
 
     return true;
 }
@@ -185,82 +172,57 @@ bool GuiTemplate::createGuiSpecificFiles() {
     std::string includeProjectPath = FileUtils::combinePath(includePath, options_.projectName);
 
     // ҪԴ??
-    if (!FileUtils::writeToFile(FileUtils::combinePath(srcPath, "main.cpp"), getMainCppContent())) {
-        return false;
-    }
+    enqueueFile(FileUtils::combinePath(srcPath, "main.cpp"),
+                [this] { return getMainCppContent(); });
 
     // ݲͬGUIܴͬ??
     if (guiFramework_ == "qt") {
         // Qtضļ
-        if (!FileUtils::writeToFile(FileUtils::combinePath(includeProjectPath, "main_window.h"),
-                                    getMainWindowHeaderContent())) {
-            return false;
-        }
+        enqueueFile(FileUtils::combinePath(includeProjectPath, "main_window.h"),
+                    [this] { return getMainWindowHeaderContent(); });
 
-        if (!FileUtils::writeToFile(FileUtils::combinePath(srcPath, "main_window.cpp"),
-                                    getMainWindowCppContent())) {
-            return false;
-        }
+        enqueueFile(FileUtils::combinePath(srcPath, "main_window.cpp"),
+                    [this] { return getMainWindowCppContent(); });
 
-        if (!FileUtils::writeToFile(FileUtils::combinePath(includeProjectPath, "application.h"),
-                                    getAppHeaderContent())) {
-            return false;
-        }
+        enqueueFile(FileUtils::combinePath(includeProjectPath, "application.h"),
+                    [this] { return getAppHeaderContent(); });
 
-        if (!FileUtils::writeToFile(FileUtils::combinePath(srcPath, "application.cpp"),
-                                    getAppCppContent())) {
-            return false;
-        }
+        enqueueFile(FileUtils::combinePath(srcPath, "application.cpp"),
+                    [this] { return getAppCppContent(); });
     } else if (guiFramework_ == "gtk" || guiFramework_ == "fltk" || guiFramework_ == "wxwidgets" ||
                guiFramework_ == "imgui") {
         // ܣ򻯵Ľṹ
-        if (!FileUtils::writeToFile(FileUtils::combinePath(includeProjectPath, "app.h"),
-                                    getFrameworkSpecificHeaderContent())) {
-            return false;
-        }
+        enqueueFile(FileUtils::combinePath(includeProjectPath, "app.h"),
+                    [this] { return getFrameworkSpecificHeaderContent(); });
 
-        if (!FileUtils::writeToFile(FileUtils::combinePath(srcPath, "app.cpp"),
-                                    getFrameworkSpecificSourceContent())) {
-            return false;
-        }
+        enqueueFile(FileUtils::combinePath(srcPath, "app.cpp"),
+                    [this] { return getFrameworkSpecificSourceContent(); });
     }
 
     // ־??
-    if (!FileUtils::writeToFile(FileUtils::combinePath(includeProjectPath, "logging.h"),
-                                getLoggingHeaderContent())) {
-        return false;
-    }
+    enqueueFile(FileUtils::combinePath(includeProjectPath, "logging.h"),
+                [this] { return getLoggingHeaderContent(); });
 
-    if (!FileUtils::writeToFile(FileUtils::combinePath(srcPath, "logging.cpp"),
-                                getLoggingCppContent())) {
-        return false;
-    }
+    enqueueFile(FileUtils::combinePath(srcPath, "logging.cpp"),
+                [this] { return getLoggingCppContent(); });
 
     // Ϊܴͬض??
     if (guiFramework_ == "qt") {
         std::string uiPath = FileUtils::combinePath(projectPath, "ui");
-        if (!FileUtils::writeToFile(FileUtils::combinePath(uiPath, "main_window.ui"),
-                                    getQtUiContent())) {
-            return false;
-        }
+        enqueueFile(FileUtils::combinePath(uiPath, "main_window.ui"),
+                    [this] { return getQtUiContent(); });
 
         std::string resourcesPath = FileUtils::combinePath(projectPath, "resources");
-        if (!FileUtils::writeToFile(FileUtils::combinePath(resourcesPath, "resources.qrc"),
-                                    getQtResourceContent())) {
-            return false;
-        }
+        enqueueFile(FileUtils::combinePath(resourcesPath, "resources.qrc"),
+                    [this] { return getQtResourceContent(); });
     } else if (guiFramework_ == "wxwidgets") {
         std::string resourcesPath = FileUtils::combinePath(projectPath, "resources");
-        if (!FileUtils::writeToFile(FileUtils::combinePath(resourcesPath, "resource.rc"),
-                                    getWxResourceContent())) {
-            return false;
-        }
+        enqueueFile(FileUtils::combinePath(resourcesPath, "resource.rc"),
+                    [this] { return getWxResourceContent(); });
     } else if (guiFramework_ == "gtk") {
         std::string uiPath = FileUtils::combinePath(projectPath, "ui");
-        if (!FileUtils::writeToFile(FileUtils::combinePath(uiPath, "main_window.glade"),
-                                    getGtkGladeContent())) {
-            return false;
-        }
+        enqueueFile(FileUtils::combinePath(uiPath, "main_window.glade"),
+                    [this] { return getGtkGladeContent(); });
     }
 
     return true;
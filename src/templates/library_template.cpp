@@ -16,12 +16,6 @@ LibraryTemplate::LibraryTemplate(const CliOptions& options) : TemplateBase(optio
 bool LibraryTemplate::create() {
     std::string projectPath = options_.projectName;
 
-    // ĿĿ¼ǷѴ
-    if (FileUtils::directoryExists(projectPath)) {
-        spdlog::error("Directory '{}' already exists.", projectPath);
-        return false;
-    }
-
     spdlog::info("?? Creating library project...");
 
     // ṹ
@@ -120,69 +114,51 @@ bool LibraryTemplate::createProjectStructure() {
 
     // srcĿ¼
     std::string srcPath = FileUtils::combinePath(projectPath, "src");
-    if (!FileUtils::createDirectory(srcPath)) {
-        return false;
-    }
+    enqueueDirectory(srcPath);
 
     // includeĿ¼
     std::string includePath = FileUtils::combinePath(projectPath, "include");
-    if (!FileUtils::createDirectory(includePath)) {
-        return false;
-    }
+    enqueueDirectory(includePath);
 
     // include/projectĿ¼
     std::string includeProjectPath = FileUtils::combinePath(includePath, options_.projectName);
-    if (!FileUtils::createDirectory(includeProjectPath)) {
-        return false;
-    }
+    enqueueDirectory(includeProjectPath);
 
     // exampleĿ¼
     std::string examplePath = FileUtils::combinePath(projectPath, "example");
-    if (!FileUtils::createDirectory(examplePath)) {
-        return false;
-    }
+    enqueueDirectory(examplePath);
 
     // дԴļ
-    if (!FileUtils::writeToFile(
-                FileUtils::combinePath(srcPath, fmt::format("{}.cpp", options_.projectName)),
-                getLibraryCppContent())) {
-        return false;
-    }
+    enqueueFile(FileUtils::combinePath(srcPath, fmt::format("{}.cpp", options_.projectName)),
+                [this] { return getLibraryCppContent(); });
 
     // д汾ͷļ
-    if (!FileUtils::writeToFile(FileUtils::combinePath(includeProjectPath, "version.h"),
-                                getVersionHeaderContent())) {
-        return false;
-    }
+    enqueueFile(FileUtils::combinePath(includeProjectPath, "version.h"),
+                [this] { return getVersionHeaderContent(); });
 
     // дͷļ
-    if (!FileUtils::writeToFile(FileUtils::combinePath(includeProjectPath,
-                                                       fmt::format("{}.h", options_.projectName)),
-                                getLibraryHeaderContent())) {
-        return false;
-    }
+    enqueueFile(
+            FileUtils::combinePath(includeProjectPath, fmt::format("{}.h", options_.projectName)),
+            [this] { return getLibraryHeaderContent(); });
 
     // дʾļ
-    if (!FileUtils::writeToFile(FileUtils::combinePath(examplePath, "example.cpp"),
-                                getExampleContent())) {
-        return false;
-    }
+    enqueueFile(FileUtils::combinePath(examplePath, "example.cpp"),
+                [this] { return getExampleContent(); });
 
     // README.md
-    if (!FileUtils::writeToFile(FileUtils::combinePath(projectPath, "README.md"),
-                                getReadmeContent())) {
-        return false;
-    }
+    enqueueFile(FileUtils::combinePath(projectPath, "README.md"),
+                [this] { return getReadmeContent(); });
 
     // LICENSE
-    if (!FileUtils::writeToFile(FileUtils::combinePath(projectPath, "LICENSE"),
-                                getLicenseContent("MIT"))) {
-        return false;
-    }
+    enqueueFile(FileUtils::combinePath(projectPath, "LICENSE"),
+                [this] { return getLicenseContent("MIT"); });
 
     // װű
     std::string installScriptPath = FileUtils::combinePath(projectPath, "install.sh");
-    if (!FileUtils::writeToFile(installScriptPath, getInstallScriptContent())) {
+    enqueueFile(installScriptPath, [this] { return getInstallScriptContent(); });
+
+    // Write the queued structure in one batch
+    if (!flushQueuedFiles()) {
         return false;
     }
 
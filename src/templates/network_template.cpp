@@ -9,17 +9,30 @@
 using namespace utils;
 using namespace cli_enums;
 
+namespace {
+
+// Headers for standalone asio or Boost.Asio, which the pool server code is written against
+std::string getAsioIncludes(const CliOptions& options) {
+    if (options.networkLibrary == "boost") {
+        return "#include <boost/asio.hpp>\nnamespace asio = boost::asio;";
+    }
+    return "#include <asio.hpp>";
+}
+
+std::string getAsioErrorCodeAlias(const CliOptions& options) {
+    if (options.networkLibrary == "boost") {
+        return "using error_code = boost::system::error_code;";
+    }
+    return "using error_code = asio::error_code;";
+}
+
+}  // namespace
+
 NetworkTemplate::NetworkTemplate(const CliOptions& options) : TemplateBase(options) {}
 
 bool NetworkTemplate::create() {
     std::string projectPath = options_.projectName;
 
-    // Check if project directory already exists
-    if (FileUtils::directoryExists(projectPath)) {
-        spdlog::error("Directory '{}' already exists.", projectPath);
-        return false;
-    }
-
     spdlog::info("?? Creating network application project '{}'...", projectPath);
 
     // Create basic structure
@@ -230,6 +243,13 @@ bool NetworkTemplate::createProjectStructure() {
         return false;
     }
 
+    if (usesNativeReactor() &&
+        !FileUtils::writeToFile(FileUtils::combinePath(serverIncludePath, "reactor.h"),
+                                getReactorHeaderContent())) {
+        spdlog::error("Failed to write reactor.h file");
+        return false;
+    }
+
     // Write client-related files
     spdlog::info("Generating client header content...");
     std::string clientHeaderContent = getClientHeaderContent();
@@ -251,6 +271,10 @@ bool NetworkTemplate::createProjectStructure() {
         return false;
     }
 
+    if ((usesServerPool() || usesNativeReactor()) && !createBenchmarkFiles()) {
+        return false;
+    }
+
     // Create README.md
     if (!FileUtils::writeToFile(FileUtils::combinePath(projectPath, "README.md"),
                                 getReadmeContent())) {
@@ -611,6 +635,17 @@ std::string NetworkTemplate::getMainCppContent() {
 #include <Poco/Net/ServerSocket.h>)";
     }
 
+    // The pool and native servers run on their own threads, so main waits for Enter before
+    // stopping them; a native server in pool mode starts one event loop per hardware thread
+    std::string serverArgs = usesNativeReactor() && options_.networkConcurrency == "pool" ? "(0)" : "";
+    std::string serverWait;
+    if (usesServerPool() || usesNativeReactor()) {
+        serverWait = R"(
+            std::cout << "Listening on port " << server.port() << " with "
+                      << server.threadCount() << " threads, press Enter to stop" << std::endl;
+            std::cin.get();)";
+    }
+
     return fmt::format(R"(#include <iostream>
 #include <string>
 #include <thread>
@@ -631,8 +666,8 @@ int main(int argc, char* argv[]) {{
     try {{
         if (mode == "server") {{
             std::cout << "Starting server..." << std::endl;
-            {}::Server server;
-            server.start(8080);
+            {}::Server server{};
+            server.start(8080);{}
         }} else if (mode == "client") {{
             std::cout << "Starting client..." << std::endl;
             {}::Client client;
@@ -651,10 +686,18 @@ int main(int argc, char* argv[]) {{
 }}
 )",
                        networkInclude, options_.projectName, options_.projectName,
-                       options_.projectName, options_.projectName, options_.projectName);
+                       options_.projectName, options_.projectName, serverArgs, serverWait,
+                       options_.projectName);
 }
 
 std::string NetworkTemplate::getServerHeaderContent() {
+    if (usesServerPool()) {
+        return getPoolServerHeaderContent();
+    }
+    if (usesNativeReactor()) {
+        return getReactorServerHeaderContent();
+    }
+
     std::string networkLibraryIncludes;
     std::string networkLibraryMembers;
 
@@ -736,6 +779,13 @@ private:{}
 }
 
 std::string NetworkTemplate::getServerImplContent() {
+    if (usesServerPool()) {
+        return getPoolServerImplContent();
+    }
+    if (usesNativeReactor()) {
+        return getReactorServerImplContent();
+    }
+
     std::string serverImpl;
 
     if (options_.networkLibrary == "asio") {
@@ -1085,6 +1135,14 @@ namespace asio = boost::asio;)";
         std::thread reader_thread_;
         bool connected_ = false;
 
+        void read_messages();)";
+    } else if (options_.networkLibrary == "native") {
+        networkLibraryIncludes = R"(#include <atomic>)";
+        networkLibraryMembers = R"(
+        int socket_fd_ = -1;
+        std::thread reader_thread_;
+        std::atomic<bool> connected_{false};
+
         void read_messages();)";
     }
 
@@ -1440,6 +1498,143 @@ void Client::read_messages() {{
     }}
 }}
 
+}} // namespace {})",
+                                 options_.projectName, options_.projectName, options_.projectName);
+    } else if (options_.networkLibrary == "native") {
+        clientImpl = fmt::format(R"(#include "{}/client/client.h"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <spdlog/spdlog.h>
+
+namespace {} {{
+
+Client::Client() {{
+    message_callback_ = [](const std::string& msg) {{
+        spdlog::info("Message from server: {{}}", msg);
+    }};
+}}
+
+Client::~Client() {{
+    disconnect();
+}}
+
+void Client::connect(const std::string& host, int port) {{
+    addrinfo hints{{}};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* addresses = nullptr;
+    int rc = ::getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &addresses);
+    if (rc != 0) {{
+        spdlog::error("Connection error: {{}}", ::gai_strerror(rc));
+        throw std::runtime_error(::gai_strerror(rc));
+    }}
+
+    int error = 0;
+    for (addrinfo* address = addresses; address; address = address->ai_next) {{
+        int fd = ::socket(address->ai_family, address->ai_socktype | SOCK_CLOEXEC,
+                          address->ai_protocol);
+        if (fd < 0) {{
+            error = errno;
+            continue;
+        }}
+        if (::connect(fd, address->ai_addr, address->ai_addrlen) == 0) {{
+            socket_fd_ = fd;
+            break;
+        }}
+        error = errno;
+        ::close(fd);
+    }}
+    ::freeaddrinfo(addresses);
+    if (socket_fd_ < 0) {{
+        spdlog::error("Connection error: {{}}", std::strerror(error));
+        throw std::system_error(error, std::system_category(), "connect");
+    }}
+
+    int one = 1;
+    ::setsockopt(socket_fd_, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    connected_ = true;
+
+    // Start reader thread for incoming messages
+    reader_thread_ = std::thread([this]() {{ read_messages(); }});
+
+    spdlog::info("Connected to server {{}}:{{}}", host, port);
+}}
+
+void Client::disconnect() {{
+    if (!connected_.exchange(false)) return;
+
+    // Wakes the reader thread blocked in recv
+    ::shutdown(socket_fd_, SHUT_RDWR);
+    if (reader_thread_.joinable()) {{
+        reader_thread_.join();
+    }}
+    ::close(socket_fd_);
+    socket_fd_ = -1;
+
+    spdlog::info("Disconnected from server");
+}}
+
+void Client::sendMessage(const std::string& message) {{
+    if (!connected_) {{
+        throw std::runtime_error("Not connected to server");
+    }}
+
+    std::string line = message + "\n";
+    std::size_t sent = 0;
+    while (sent < line.size()) {{
+        ssize_t written = ::send(socket_fd_, line.data() + sent, line.size() - sent, MSG_NOSIGNAL);
+        if (written < 0) {{
+            if (errno == EINTR) continue;
+            spdlog::error("Error sending message: {{}}", std::strerror(errno));
+            throw std::system_error(errno, std::system_category(), "send");
+        }}
+        sent += static_cast<std::size_t>(written);
+    }}
+    spdlog::info("Message sent: {{}}", message);
+}}
+
+void Client::setMessageCallback(std::function<void(const std::string&)> callback) {{
+    message_callback_ = std::move(callback);
+}}
+
+bool Client::isConnected() const {{
+    return connected_;
+}}
+
+void Client::read_messages() {{
+    std::string pending;
+    char buffer[4096];
+    for (;;) {{
+        ssize_t received = ::recv(socket_fd_, buffer, sizeof(buffer), 0);
+        if (received < 0 && errno == EINTR) continue;
+        if (received <= 0) break;
+
+        pending.append(buffer, static_cast<std::size_t>(received));
+        std::size_t start = 0;
+        for (std::size_t newline; (newline = pending.find('\n', start)) != std::string::npos;) {{
+            if (message_callback_) {{
+                message_callback_(pending.substr(start, newline - start));
+            }}
+            start = newline + 1;
+        }}
+        pending.erase(0, start);
+    }}
+
+    if (connected_) {{
+        spdlog::info("Server closed the connection");
+    }}
+}}
+
 }} // namespace {})",
                                  options_.projectName, options_.projectName, options_.projectName);
     }
@@ -1448,7 +1643,7 @@ void Client::read_messages() {{
 }
 
 std::string NetworkTemplate::getReadmeContent() {
-    return fmt::format(
+    std::string readme = fmt::format(
             R"(# {}
 
 һC++ӦãʹCPP-Scaffold
@@ -1515,6 +1710,61 @@ make
             options_.projectName, options_.networkLibrary.value_or("Unknown"), options_.projectName,
             options_.projectName, options_.projectName, options_.projectName, options_.projectName,
             options_.networkLibrary.value_or("Unknown"), to_string(options_.packageManager));
+
+    if (usesServerPool()) {
+        readme += fmt::format(R"(
+## Concurrency
+
+The server runs one `io_context` per hardware thread (`Server(threads)` overrides the count).
+Every worker owns an acceptor bound with `SO_REUSEPORT`, so the kernel balances new
+connections, and a connection never leaves the worker that accepted it, so sessions use no
+strands or locks. `broadcast` builds the line once and queues the same buffer on every
+connection; queued lines are sent with one gathered `async_write`.
+
+## Benchmarks
+
+```sh
+# Loopback latency and throughput at 16, 256 and 1024 connections
+./{}_bench --connections 16,256,1024 --seconds 3
+
+# Drive a running server (it must echo lines, see Server::setEchoEnabled)
+./{}_loadgen --host 127.0.0.1 --port 8080 --connections 1000 --seconds 10
+```
+
+Raise the open file limit (`ulimit -n`) before testing thousands of connections.
+)",
+                              options_.projectName, options_.projectName);
+    } else if (usesNativeReactor()) {
+        readme += fmt::format(R"(
+## Reactor
+
+The server needs nothing beyond Linux. Every event loop thread (`Server(threads)`, one per
+hardware thread with `0`) owns an edge-triggered `epoll` reactor and an `SO_REUSEPORT`
+listener; `include/{}/server/reactor.h` holds its building blocks:
+
+- receive buffers come from a per-loop pool and go back as soon as a connection has no partial
+  line left, so idle connections hold no buffer
+- queued lines leave in one `sendmsg` gathering up to 64 shared buffers; `broadcast` builds its
+  line once for every client
+- a hashed timer wheel closes idle connections (`Server::setIdleTimeout`)
+- `Server::stop(drainTimeout)` stops accepting and reading, then lets queued output drain
+  before closing
+
+Configure with `-D{}_USE_IO_URING=ON` to wait on io_uring (liburing 2.2 or newer) instead of
+epoll; with other build systems define `REACTOR_USE_IO_URING` and link `liburing` yourself.
+
+## Benchmarks
+
+```sh
+# Echo round trips over loopback at 16, 256 and 1024 connections
+./{}_echo_bench --connections 16,256,1024 --seconds 3
+```
+
+Raise the open file limit (`ulimit -n`) before testing thousands of connections.
+)",
+                              options_.projectName, options_.projectName, options_.projectName);
+    }
+    return readme;
 }
 
 std::string NetworkTemplate::getCMakeContent() {
@@ -1548,6 +1798,60 @@ find_package(boost REQUIRED COMPONENTS system thread)
 find_package(Poco REQUIRED COMPONENTS Foundation Net)
 )";
         networkLibraryLink = "Poco::Foundation Poco::Net";
+    } else if (options_.networkLibrary == "native") {
+        networkLibraryConfig = fmt::format(R"(
+# The native reactor only needs the system: epoll, or io_uring when enabled
+find_package(Threads REQUIRED)
+option({}_USE_IO_URING "Wait on io_uring (liburing >= 2.2) instead of epoll" OFF)
+if({}_USE_IO_URING)
+    find_package(PkgConfig REQUIRED)
+    pkg_check_modules(LIBURING REQUIRED IMPORTED_TARGET liburing>=2.2)
+endif()
+)",
+                                           options_.projectName, options_.projectName);
+        networkLibraryLink = "Threads::Threads";
+    }
+
+    std::string benchmarkTargets;
+    if (usesServerPool()) {
+        networkLibraryConfig += R"(
+# Server worker threads
+find_package(Threads REQUIRED)
+)";
+        networkLibraryLink += " Threads::Threads";
+        benchmarkTargets = fmt::format(R"(
+# Load generator and loopback latency/throughput benchmark
+option({}_BUILD_BENCHMARKS "Build the load generator and server benchmark" ON)
+if({}_BUILD_BENCHMARKS)
+    add_executable({}_loadgen bench/load_generator.cpp)
+    target_link_libraries({}_loadgen PRIVATE {}_lib)
+
+    add_executable({}_bench bench/server_benchmark.cpp)
+    target_link_libraries({}_bench PRIVATE {}_lib)
+endif()
+)",
+                                       options_.projectName, options_.projectName,
+                                       options_.projectName, options_.projectName,
+                                       options_.projectName, options_.projectName,
+                                       options_.projectName, options_.projectName);
+    } else if (usesNativeReactor()) {
+        benchmarkTargets = fmt::format(R"(
+if({}_USE_IO_URING)
+    target_compile_definitions({}_lib PUBLIC REACTOR_USE_IO_URING)
+    target_link_libraries({}_lib PUBLIC PkgConfig::LIBURING)
+endif()
+
+# Loopback echo benchmark
+option({}_BUILD_BENCHMARKS "Build the loopback echo benchmark" ON)
+if({}_BUILD_BENCHMARKS)
+    add_executable({}_echo_bench bench/echo_benchmark.cpp)
+    target_link_libraries({}_echo_bench PRIVATE {}_lib)
+endif()
+)",
+                                       options_.projectName, options_.projectName,
+                                       options_.projectName, options_.projectName,
+                                       options_.projectName, options_.projectName,
+                                       options_.projectName, options_.projectName);
     }
 
     return fmt::format(
@@ -1599,11 +1903,12 @@ install(EXPORT {}_targets
     NAMESPACE {}::
     DESTINATION lib/cmake/{}
 )
-)",
+{})",
             options_.projectName, networkLibraryConfig, options_.projectName, options_.projectName,
             options_.projectName, networkLibraryLink, options_.projectName, options_.projectName,
             options_.projectName, options_.projectName, options_.projectName, options_.projectName,
-            options_.projectName, options_.projectName, options_.projectName, options_.projectName);
+            options_.projectName, options_.projectName, options_.projectName, options_.projectName,
+            benchmarkTargets);
 }
 
 std::string NetworkTemplate::getMesonContent() {
@@ -1615,6 +1920,40 @@ std::string NetworkTemplate::getMesonContent() {
         networkLibraryDep = "boost_dep = dependency('boost', modules: ['system', 'thread'])";
     } else if (options_.networkLibrary == "poco") {
         networkLibraryDep = "poco_dep = dependency('poco', modules: ['foundation', 'net'])";
+    } else if (options_.networkLibrary == "native") {
+        networkLibraryDep = "threads_dep = dependency('threads')";
+    }
+
+    std::string libraryDeps = options_.networkLibrary == "asio"     ? "asio_dep"
+                              : options_.networkLibrary == "boost"  ? "boost_dep"
+                              : options_.networkLibrary == "native" ? "threads_dep"
+                                                                    : "poco_dep";
+    std::string benchmarkTargets;
+    if (usesServerPool()) {
+        networkLibraryDep += "\nthreads_dep = dependency('threads')";
+        libraryDeps += ", threads_dep";
+        benchmarkTargets = fmt::format(R"(
+# Load generator and loopback latency/throughput benchmark
+bench_deps = [spdlog_dep, {}]
+executable('{}_loadgen', 'bench/load_generator.cpp',
+  include_directories : include_directories('include'),
+  dependencies : bench_deps)
+executable('{}_bench', 'bench/server_benchmark.cpp',
+  include_directories : include_directories('include'),
+  link_with : {}_lib,
+  dependencies : bench_deps)
+)",
+                                       libraryDeps, options_.projectName, options_.projectName,
+                                       options_.projectName);
+    } else if (usesNativeReactor()) {
+        benchmarkTargets = fmt::format(R"(
+# Loopback echo benchmark
+executable('{}_echo_bench', 'bench/echo_benchmark.cpp',
+  include_directories : include_directories('include'),
+  link_with : {}_lib,
+  dependencies : [spdlog_dep, threads_dep])
+)",
+                                       options_.projectName, options_.projectName);
     }
 
     return fmt::format(R"(project('{}', 'cpp',
@@ -1637,13 +1976,10 @@ spdlog_dep = dependency('spdlog')
   'src/main.cpp',
   link_with : {}_lib,
   install : true)
-)",
+{})",
                        options_.projectName, networkLibraryDep, options_.projectName,
-                       options_.projectName,
-                       options_.networkLibrary == "asio"    ? "asio_dep"
-                       : options_.networkLibrary == "boost" ? "boost_dep"
-                                                            : "poco_dep",
-                       options_.projectName, options_.projectName, options_.projectName);
+                       options_.projectName, libraryDeps, options_.projectName,
+                       options_.projectName, options_.projectName, benchmarkTargets);
 }
 
 std::string NetworkTemplate::getBazelContent() {
@@ -1662,6 +1998,37 @@ std::string NetworkTemplate::getBazelContent() {
     "@poco//:net",)";
     }
 
+    std::string benchmarkTargets;
+    if (usesServerPool()) {
+        benchmarkTargets = fmt::format(R"(
+# Load generator and loopback latency/throughput benchmark
+cc_binary(
+    name = "{}_loadgen",
+    srcs = ["bench/load_generator.cpp", "bench/load_generator.h"],
+    deps = [":{}_lib"],
+)
+
+cc_binary(
+    name = "{}_bench",
+    srcs = ["bench/server_benchmark.cpp", "bench/load_generator.h"],
+    deps = [":{}_lib"],
+)
+)",
+                                       options_.projectName, options_.projectName,
+                                       options_.projectName, options_.projectName);
+    } else if (usesNativeReactor()) {
+        benchmarkTargets = fmt::format(R"(
+# Loopback echo benchmark
+cc_binary(
+    name = "{}_echo_bench",
+    srcs = ["bench/echo_benchmark.cpp"],
+    linkopts = ["-pthread"],
+    deps = [":{}_lib"],
+)
+)",
+                                       options_.projectName, options_.projectName);
+    }
+
     return fmt::format(R"(load("@rules_cc//cc:defs.bzl", "cc_binary", "cc_library")
 
 cc_library(
@@ -1683,9 +2050,9 @@ cc_binary(
     srcs = ["src/main.cpp"],
     deps = [":{}_lib"],
 )
-)",
+{})",
                        options_.projectName, networkLibraryDeps, options_.projectName,
-                       options_.projectName);
+                       options_.projectName, benchmarkTargets);
 }
 
 std::string NetworkTemplate::getXMakeContent() {
@@ -1703,6 +2070,47 @@ std::string NetworkTemplate::getXMakeContent() {
         networkLibraryConfig = R"(
     add_requires("poco")
     add_packages("poco"))";
+    } else if (options_.networkLibrary == "native") {
+        networkLibraryConfig = R"(
+    add_syslinks("pthread"))";
+    }
+
+    std::string libraryPackage = options_.networkLibrary == "asio"    ? ", \"asio\""
+                                 : options_.networkLibrary == "boost" ? ", \"boost\""
+                                 : options_.networkLibrary == "poco"  ? ", \"poco\""
+                                                                      : "";
+    std::string benchmarkTargets;
+    if (usesServerPool()) {
+        benchmarkTargets = fmt::format(R"(
+-- Load generator and loopback latency/throughput benchmark
+target("{}_loadgen")
+    set_kind("binary")
+    add_files("bench/load_generator.cpp")
+    add_deps("{}_lib")
+    add_packages("spdlog"{})
+    add_syslinks("pthread")
+
+target("{}_bench")
+    set_kind("binary")
+    add_files("bench/server_benchmark.cpp")
+    add_deps("{}_lib")
+    add_packages("spdlog"{})
+    add_syslinks("pthread")
+)",
+                                       options_.projectName, options_.projectName,
+                                       libraryPackage, options_.projectName,
+                                       options_.projectName, libraryPackage);
+    } else if (usesNativeReactor()) {
+        benchmarkTargets = fmt::format(R"(
+-- Loopback echo benchmark
+target("{}_echo_bench")
+    set_kind("binary")
+    add_files("bench/echo_benchmark.cpp")
+    add_deps("{}_lib")
+    add_packages("spdlog")
+    add_syslinks("pthread")
+)",
+                                       options_.projectName, options_.projectName);
     }
 
     return fmt::format(R"(set_project("{}")
@@ -1722,13 +2130,10 @@ target("{}")
     set_kind("binary")
     add_files("src/main.cpp")
     add_deps("{}_lib")
-)",
+{})",
                        options_.projectName, networkLibraryConfig, options_.projectName,
-                       options_.networkLibrary == "asio"    ? ", \"asio\""
-                       : options_.networkLibrary == "boost" ? ", \"boost\""
-                       : options_.networkLibrary == "poco"  ? ", \"poco\""
-                                                            : "",
-                       options_.projectName, options_.projectName);
+                       libraryPackage, options_.projectName, options_.projectName,
+                       benchmarkTargets);
 }
 
 std::string NetworkTemplate::getPremakeContent() {
@@ -1746,6 +2151,75 @@ std::string NetworkTemplate::getPremakeContent() {
         networkLibraryConfig = R"(
     includedirs { "path/to/poco/include" }
     links { "PocoFoundation", "PocoNet" })";
+    } else if (options_.networkLibrary == "native") {
+        networkLibraryConfig = R"(
+    links { "pthread" })";
+    }
+
+    std::string benchmarkProjects;
+    if (usesServerPool()) {
+        for (const auto& [target, source] : {std::pair{"loadgen", "load_generator"},
+                                             std::pair{"bench", "server_benchmark"}}) {
+            benchmarkProjects += fmt::format(R"(
+project "{}_{}"
+    kind "ConsoleApp"
+    language "C++"
+    cppdialect "C++17"
+
+    targetdir "bin/%{{cfg.buildcfg}}"
+    objdir "bin-int/%{{cfg.buildcfg}}"
+
+    files {{
+        "bench/{}.cpp",
+        "bench/load_generator.h"
+    }}
+
+    includedirs {{
+        "include",
+        "path/to/spdlog/include"
+    }}{}
+
+    links {{
+        "{}_lib",
+        "pthread"
+    }}
+
+    filter "configurations:Release"
+        defines {{ "NDEBUG" }}
+        optimize "On"
+)",
+                                             options_.projectName, target, source,
+                                             networkLibraryConfig, options_.projectName);
+        }
+    } else if (usesNativeReactor()) {
+        benchmarkProjects = fmt::format(R"(
+project "{}_echo_bench"
+    kind "ConsoleApp"
+    language "C++"
+    cppdialect "C++17"
+
+    targetdir "bin/%{{cfg.buildcfg}}"
+    objdir "bin-int/%{{cfg.buildcfg}}"
+
+    files {{
+        "bench/echo_benchmark.cpp"
+    }}
+
+    includedirs {{
+        "include",
+        "path/to/spdlog/include"
+    }}
+
+    links {{
+        "{}_lib",
+        "pthread"
+    }}
+
+    filter "configurations:Release"
+        defines {{ "NDEBUG" }}
+        optimize "On"
+)",
+                                        options_.projectName, options_.projectName);
     }
 
     return fmt::format(R"(workspace "{}"
@@ -1802,9 +2276,9 @@ project "{}"
     filter "configurations:Release"
         defines {{ "NDEBUG" }}
         optimize "On"
-)",
+{})",
                        options_.projectName, options_.projectName, networkLibraryConfig,
-                       options_.projectName, options_.projectName);
+                       options_.projectName, options_.projectName, benchmarkProjects);
 }
 
 std::string NetworkTemplate::getNetworkTestContent() {
@@ -1868,3 +2342,1710 @@ TEST_CASE("Client creation") {
                        testFrameworkInclude, options_.projectName, options_.projectName,
                        testFrameworkMacros);
 }
+
+bool NetworkTemplate::usesServerPool() const {
+    // The pool server is written against the asio API; poco keeps its reactor thread
+    return options_.networkConcurrency == "pool" &&
+           (options_.networkLibrary == "asio" || options_.networkLibrary == "boost");
+}
+
+bool NetworkTemplate::usesNativeReactor() const {
+    return options_.networkLibrary == "native";
+}
+
+bool NetworkTemplate::createBenchmarkFiles() {
+    std::string benchPath = FileUtils::combinePath(options_.projectName, "bench");
+    if (!FileUtils::createDirectory(benchPath)) {
+        spdlog::error("Failed to create bench directory: {}", benchPath);
+        return false;
+    }
+
+    std::vector<std::pair<const char*, std::string>> files;
+    if (usesNativeReactor()) {
+        files = {{"echo_benchmark.cpp", getEchoBenchmarkContent()}};
+    } else {
+        files = {{"load_generator.h", getLoadGeneratorHeaderContent()},
+                 {"load_generator.cpp", getLoadGeneratorMainContent()},
+                 {"server_benchmark.cpp", getServerBenchmarkContent()}};
+    }
+    for (const auto& [name, content] : files) {
+        if (!FileUtils::writeToFile(FileUtils::combinePath(benchPath, name), content)) {
+            spdlog::error("Failed to write bench/{} file", name);
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string NetworkTemplate::getPoolServerHeaderContent() {
+    std::string asioIncludes = getAsioIncludes(options_);
+    std::string errorCodeAlias = getAsioErrorCodeAlias(options_);
+
+    return fmt::format(R"(#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+{}
+
+namespace {} {{
+
+{}
+
+class Session;
+
+// Multi-threaded TCP server. Each worker thread runs its own io_context with
+// its own acceptor bound to the port through SO_REUSEPORT, so the kernel
+// spreads new connections across workers (without SO_REUSEPORT one acceptor
+// hands them out in turn). A connection stays on the worker that accepted it,
+// so sessions need neither strands nor locks.
+class Server {{
+public:
+    // threads == 0 starts one worker per hardware thread
+    explicit Server(std::size_t threads = 0);
+    ~Server();
+
+    Server(const Server&) = delete;
+    Server& operator=(const Server&) = delete;
+
+    // Start the server on the specified port; 0 picks a free port (see port())
+    void start(int port);
+
+    // Stop the server, closing every connection
+    void stop();
+
+    // Send message to all connected clients. The line is built once and its
+    // buffer is shared by every queued write
+    void broadcast(const std::string& message);
+
+    // Set callback for new messages; it runs concurrently on the worker threads
+    void setMessageCallback(std::function<void(const std::string&)> callback);
+
+    // Write every received line back to its sender, as the benchmark expects
+    void setEchoEnabled(bool enabled);
+
+    int port() const;
+    std::size_t threadCount() const;
+    std::size_t connectionCount() const;
+
+private:
+    struct Worker;
+    friend class Session;
+
+    void acceptNext(Worker& worker);
+    void addSession(Worker& worker, asio::ip::tcp::socket socket);
+
+    std::size_t thread_count_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    bool shared_acceptor_ = false;
+    std::atomic<std::size_t> next_worker_{{0}};
+    std::atomic<std::size_t> connections_{{0}};
+    std::atomic<bool> running_{{false}};
+    bool echo_ = false;
+    int port_ = 0;
+
+    std::function<void(const std::string&)> message_callback_;
+}};
+
+}} // namespace {}
+)",
+                       asioIncludes, options_.projectName, errorCodeAlias, options_.projectName);
+}
+
+std::string NetworkTemplate::getPoolServerImplContent() {
+    return fmt::format(R"(#include "{}/server/server.h"
+
+#include <algorithm>
+#include <deque>
+#include <thread>
+#include <unordered_set>
+#include <spdlog/spdlog.h>
+
+namespace {} {{
+
+namespace {{
+
+// Queued lines sent with one gathered write
+constexpr std::size_t MAX_GATHER = 64;
+// Longest line accepted before the connection is dropped
+constexpr std::size_t MAX_LINE = 64 * 1024;
+
+using Payload = std::shared_ptr<const std::string>;
+
+// Lets every worker bind its own acceptor to the port
+bool enableReusePort(asio::ip::tcp::acceptor& acceptor) {{
+#if defined(SO_REUSEPORT) && !defined(_WIN32)
+    error_code error;
+    acceptor.set_option(asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>(true),
+                        error);
+    return !error;
+#else
+    (void)acceptor;
+    return false;
+#endif
+}}
+
+}} // namespace
+
+struct Server::Worker {{
+    Worker() : io_context(1), guard(io_context.get_executor()) {{}}
+
+    asio::io_context io_context;  // Concurrency hint 1: only this worker's thread runs it
+    asio::executor_work_guard<asio::io_context::executor_type> guard;
+    std::unique_ptr<asio::ip::tcp::acceptor> acceptor;
+    std::unordered_set<std::shared_ptr<Session>> sessions;
+    std::thread thread;
+}};
+
+// One client connection, only ever touched by its worker's thread
+class Session : public std::enable_shared_from_this<Session> {{
+public:
+    Session(asio::ip::tcp::socket socket, Server& server, Server::Worker& worker)
+        : socket_(std::move(socket)), server_(server), worker_(worker) {{}}
+
+    void start() {{
+        readNext();
+    }}
+
+    // Queues a shared line; writes already queued go out together
+    void deliver(Payload payload) {{
+        if (closed_) return;
+        queue_.push_back(std::move(payload));
+        if (!writing_) {{
+            writeQueued();
+        }}
+    }}
+
+    void close() {{
+        if (closed_) return;
+        closed_ = true;
+        error_code ignored;
+        socket_.shutdown(asio::ip::tcp::socket::shutdown_both, ignored);
+        socket_.close(ignored);
+        --server_.connections_;
+        worker_.sessions.erase(shared_from_this());
+    }}
+
+private:
+    void readNext() {{
+        auto self = shared_from_this();
+        asio::async_read_until(
+            socket_, asio::dynamic_buffer(input_, MAX_LINE), '\n',
+            [this, self](const error_code& error, std::size_t length) {{
+                if (error) {{
+                    close();
+                    return;
+                }}
+                if (server_.echo_) {{
+                    deliver(std::make_shared<const std::string>(input_, 0, length));
+                }}
+                if (server_.message_callback_) {{
+                    server_.message_callback_(input_.substr(0, length - 1));
+                }}
+                input_.erase(0, length);
+                readNext();
+            }});
+    }}
+
+    void writeQueued() {{
+        writing_ = true;
+        in_flight_.clear();
+        buffers_.clear();
+        while (!queue_.empty() && buffers_.size() < MAX_GATHER) {{
+            buffers_.push_back(asio::buffer(*queue_.front()));
+            in_flight_.push_back(std::move(queue_.front()));
+            queue_.pop_front();
+        }}
+
+        auto self = shared_from_this();
+        asio::async_write(socket_, buffers_, [this, self](const error_code& error, std::size_t) {{
+            in_flight_.clear();
+            if (error) {{
+                close();
+                return;
+            }}
+            if (queue_.empty()) {{
+                writing_ = false;
+            }} else {{
+                writeQueued();
+            }}
+        }});
+    }}
+
+    asio::ip::tcp::socket socket_;
+    Server& server_;
+    Server::Worker& worker_;
+    std::string input_;
+    std::deque<Payload> queue_;
+    std::vector<Payload> in_flight_;          // Keeps the gathered lines alive
+    std::vector<asio::const_buffer> buffers_;
+    bool writing_ = false;
+    bool closed_ = false;
+}};
+
+Server::Server(std::size_t threads)
+    : thread_count_(threads ? threads : std::max(1u, std::thread::hardware_concurrency())) {{
+    message_callback_ = [](const std::string& msg) {{
+        spdlog::info("Message received: {{}}", msg);
+    }};
+}}
+
+Server::~Server() {{
+    stop();
+}}
+
+void Server::start(int port) {{
+    if (running_) return;
+
+    try {{
+        workers_.clear();
+        for (std::size_t i = 0; i < thread_count_; ++i) {{
+            workers_.push_back(std::make_unique<Worker>());
+        }}
+
+        asio::ip::tcp::endpoint endpoint(asio::ip::tcp::v4(), static_cast<unsigned short>(port));
+        bool reusePort = workers_.size() > 1;
+        for (auto& worker : workers_) {{
+            auto acceptor = std::make_unique<asio::ip::tcp::acceptor>(worker->io_context);
+            acceptor->open(endpoint.protocol());
+            acceptor->set_option(asio::ip::tcp::acceptor::reuse_address(true));
+            reusePort = reusePort && enableReusePort(*acceptor);
+            acceptor->bind(endpoint);
+            acceptor->listen(asio::socket_base::max_listen_connections);
+            if (worker == workers_.front()) {{
+                // Later acceptors join the port the first one got
+                port_ = acceptor->local_endpoint().port();
+                endpoint.port(static_cast<unsigned short>(port_));
+            }}
+            worker->acceptor = std::move(acceptor);
+            if (!reusePort) break;
+        }}
+        shared_acceptor_ = !reusePort;
+
+        running_ = true;
+        for (auto& worker : workers_) {{
+            if (worker->acceptor) {{
+                acceptNext(*worker);
+            }}
+        }}
+        for (auto& worker : workers_) {{
+            worker->thread = std::thread([w = worker.get()]() {{
+                for (;;) {{
+                    try {{
+                        w->io_context.run();
+                        return;
+                    }} catch (const std::exception& e) {{
+                        spdlog::error("Server worker error: {{}}", e.what());
+                    }}
+                }}
+            }});
+        }}
+
+        spdlog::info("Server started on port {{}} with {{}} worker threads{{}}", port_, workers_.size(),
+                     shared_acceptor_ && workers_.size() > 1 ? ", one shared acceptor" : "");
+    }} catch (const std::exception& e) {{
+        running_ = false;
+        workers_.clear();
+        spdlog::error("Server start error: {{}}", e.what());
+        throw;
+    }}
+}}
+
+void Server::stop() {{
+    if (!running_.exchange(false)) return;
+
+    for (auto& worker : workers_) {{
+        asio::post(worker->io_context, [w = worker.get()]() {{
+            error_code ignored;
+            if (w->acceptor) {{
+                w->acceptor->close(ignored);
+            }}
+            std::vector<std::shared_ptr<Session>> sessions(w->sessions.begin(), w->sessions.end());
+            for (auto& session : sessions) {{
+                session->close();
+            }}
+            // run() returns once the aborted operations have completed
+            w->guard.reset();
+        }});
+    }}
+    for (auto& worker : workers_) {{
+        if (worker->thread.joinable()) {{
+            worker->thread.join();
+        }}
+    }}
+    workers_.clear();
+    spdlog::info("Server stopped");
+}}
+
+void Server::broadcast(const std::string& message) {{
+    // One buffer for every client, released when the last write completes
+    auto payload = std::make_shared<const std::string>(message + "\n");
+    for (auto& worker : workers_) {{
+        asio::post(worker->io_context, [w = worker.get(), payload]() {{
+            for (const auto& session : w->sessions) {{
+                session->deliver(payload);
+            }}
+        }});
+    }}
+}}
+
+void Server::setMessageCallback(std::function<void(const std::string&)> callback) {{
+    message_callback_ = std::move(callback);
+}}
+
+void Server::setEchoEnabled(bool enabled) {{
+    echo_ = enabled;
+}}
+
+int Server::port() const {{
+    return port_;
+}}
+
+std::size_t Server::threadCount() const {{
+    return thread_count_;
+}}
+
+std::size_t Server::connectionCount() const {{
+    return connections_;
+}}
+
+void Server::acceptNext(Worker& worker) {{
+    // With a shared acceptor new connections go to the workers in turn
+    Worker& target = shared_acceptor_ ? *workers_[next_worker_++ % workers_.size()] : worker;
+    worker.acceptor->async_accept(
+        target.io_context,
+        [this, &worker, &target](const error_code& error, asio::ip::tcp::socket socket) {{
+            if (error == asio::error::operation_aborted || !running_) return;
+            if (error) {{
+                spdlog::warn("Accept error: {{}}", error.message());
+            }} else {{
+                asio::post(target.io_context,
+                           [this, &target, socket = std::move(socket)]() mutable {{
+                               addSession(target, std::move(socket));
+                           }});
+            }}
+            acceptNext(worker);
+        }});
+}}
+
+void Server::addSession(Worker& worker, asio::ip::tcp::socket socket) {{
+    if (!running_) return;
+
+    error_code ignored;
+    socket.set_option(asio::ip::tcp::no_delay(true), ignored);
+    auto session = std::make_shared<Session>(std::move(socket), *this, worker);
+    worker.sessions.insert(session);
+    ++connections_;
+    session->start();
+}}
+
+}} // namespace {}
+)",
+                       options_.projectName, options_.projectName, options_.projectName);
+}
+
+std::string NetworkTemplate::getLoadGeneratorHeaderContent() {
+    std::string asioIncludes = getAsioIncludes(options_);
+    std::string errorCodeAlias = getAsioErrorCodeAlias(options_);
+
+    return fmt::format(R"(#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+{}
+
+namespace {}::bench {{
+
+{}
+
+struct LoadOptions {{
+    std::string host = "127.0.0.1";
+    unsigned short port = 8080;
+    std::size_t connections = 100;
+    std::size_t threads = 0;  // 0: one per hardware thread
+    std::size_t messageSize = 64;
+    std::chrono::milliseconds duration{{5000}};
+}};
+
+struct LoadReport {{
+    std::size_t connections = 0;  // Connections that were established
+    std::uint64_t messages = 0;   // Round trips completed
+    std::uint64_t bytes = 0;      // Payload bytes received
+    std::uint64_t errors = 0;
+    double seconds = 0;
+    std::vector<std::uint32_t> latenciesUs;  // Sorted round-trip times
+
+    double messagesPerSecond() const {{
+        return seconds > 0 ? static_cast<double>(messages) / seconds : 0;
+    }}
+
+    std::uint32_t percentile(double p) const {{
+        if (latenciesUs.empty()) return 0;
+        auto index = static_cast<std::size_t>(p / 100.0 * static_cast<double>(latenciesUs.size() - 1));
+        return latenciesUs[index];
+    }}
+
+    void print(std::ostream& out) const {{
+        out << std::fixed << std::setprecision(1)
+            << "connections " << connections << "\n"
+            << "messages    " << messages << " (" << messagesPerSecond() << " msg/s)\n"
+            << "throughput  " << static_cast<double>(bytes) / seconds / (1024 * 1024) << " MiB/s\n"
+            << "latency us  p50 " << percentile(50) << "  p90 " << percentile(90) << "  p99 "
+            << percentile(99) << "  max " << percentile(100) << "\n"
+            << "errors      " << errors << "\n";
+    }}
+}};
+
+namespace detail {{
+
+struct ThreadStats {{
+    std::size_t connections = 0;
+    std::uint64_t messages = 0;
+    std::uint64_t bytes = 0;
+    std::uint64_t errors = 0;
+    std::vector<std::uint32_t> latenciesUs;
+}};
+
+// Closed loop: send one line, wait for its echo, send the next
+class LoadConnection : public std::enable_shared_from_this<LoadConnection> {{
+public:
+    LoadConnection(asio::io_context& io_context, const std::string& message, ThreadStats& stats)
+        : socket_(io_context), message_(message), stats_(stats) {{}}
+
+    void start(const asio::ip::tcp::resolver::results_type& endpoints) {{
+        auto self = shared_from_this();
+        asio::async_connect(socket_, endpoints,
+                            [this, self](const error_code& error, const asio::ip::tcp::endpoint&) {{
+                                if (error) {{
+                                    ++stats_.errors;
+                                    return;
+                                }}
+                                error_code ignored;
+                                socket_.set_option(asio::ip::tcp::no_delay(true), ignored);
+                                ++stats_.connections;
+                                sendNext();
+                            }});
+    }}
+
+private:
+    void sendNext() {{
+        auto self = shared_from_this();
+        sent_ = std::chrono::steady_clock::now();
+        asio::async_write(socket_, asio::buffer(message_),
+                          [this, self](const error_code& error, std::size_t) {{
+                              if (error) {{
+                                  ++stats_.errors;
+                                  return;
+                              }}
+                              readEcho();
+                          }});
+    }}
+
+    void readEcho() {{
+        auto self = shared_from_this();
+        asio::async_read_until(
+            socket_, asio::dynamic_buffer(input_), '\n',
+            [this, self](const error_code& error, std::size_t length) {{
+                if (error) {{
+                    ++stats_.errors;
+                    return;
+                }}
+                auto elapsed = std::chrono::steady_clock::now() - sent_;
+                stats_.latenciesUs.push_back(static_cast<std::uint32_t>(
+                    std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()));
+                ++stats_.messages;
+                stats_.bytes += length;
+                input_.erase(0, length);
+                sendNext();
+            }});
+    }}
+
+    asio::ip::tcp::socket socket_;
+    const std::string& message_;
+    ThreadStats& stats_;
+    std::string input_;
+    std::chrono::steady_clock::time_point sent_;
+}};
+
+}} // namespace detail
+
+// Opens options.connections connections spread over options.threads event
+// loops, runs them against an echoing server for options.duration and merges
+// the per-thread statistics
+inline LoadReport runLoad(const LoadOptions& options) {{
+    std::size_t threads = options.threads ? options.threads
+                                          : std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min(threads, std::max<std::size_t>(options.connections, 1));
+    std::string message(std::max<std::size_t>(options.messageSize, 2) - 1, 'x');
+    message.push_back('\n');
+
+    std::vector<std::unique_ptr<asio::io_context>> contexts;
+    std::vector<detail::ThreadStats> stats(threads);
+    for (std::size_t i = 0; i < threads; ++i) {{
+        contexts.push_back(std::make_unique<asio::io_context>(1));
+    }}
+
+    asio::ip::tcp::resolver resolver(*contexts.front());
+    auto endpoints = resolver.resolve(options.host, std::to_string(options.port));
+    for (std::size_t i = 0; i < options.connections; ++i) {{
+        std::size_t slot = i % threads;
+        std::make_shared<detail::LoadConnection>(*contexts[slot], message, stats[slot])
+            ->start(endpoints);
+    }}
+
+    auto started = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (auto& context : contexts) {{
+        workers.emplace_back([&context]() {{ context->run(); }});
+    }}
+    std::this_thread::sleep_for(options.duration);
+    for (auto& context : contexts) {{
+        context->stop();
+    }}
+    for (auto& worker : workers) {{
+        worker.join();
+    }}
+
+    LoadReport report;
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    for (auto& thread : stats) {{
+        report.connections += thread.connections;
+        report.messages += thread.messages;
+        report.bytes += thread.bytes;
+        report.errors += thread.errors;
+        report.latenciesUs.insert(report.latenciesUs.end(), thread.latenciesUs.begin(),
+                                  thread.latenciesUs.end());
+    }}
+    std::sort(report.latenciesUs.begin(), report.latenciesUs.end());
+    return report;
+}}
+
+}} // namespace {}::bench
+)",
+                       asioIncludes, options_.projectName, errorCodeAlias, options_.projectName);
+}
+
+std::string NetworkTemplate::getLoadGeneratorMainContent() {
+    return fmt::format(R"(// Load generator for an echoing {} server:
+//   {}_loadgen [--host H] [--port P] [--connections N] [--threads T]
+//                [--size BYTES] [--seconds S]
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include "load_generator.h"
+
+int main(int argc, char* argv[]) {{
+    {}::bench::LoadOptions options;
+    for (int i = 1; i + 1 < argc; i += 2) {{
+        const char* value = argv[i + 1];
+        if (std::strcmp(argv[i], "--host") == 0) {{
+            options.host = value;
+        }} else if (std::strcmp(argv[i], "--port") == 0) {{
+            options.port = static_cast<unsigned short>(std::atoi(value));
+        }} else if (std::strcmp(argv[i], "--connections") == 0) {{
+            options.connections = std::strtoul(value, nullptr, 10);
+        }} else if (std::strcmp(argv[i], "--threads") == 0) {{
+            options.threads = std::strtoul(value, nullptr, 10);
+        }} else if (std::strcmp(argv[i], "--size") == 0) {{
+            options.messageSize = std::strtoul(value, nullptr, 10);
+        }} else if (std::strcmp(argv[i], "--seconds") == 0) {{
+            options.duration = std::chrono::milliseconds(std::atoi(value) * 1000);
+        }} else {{
+            std::cerr << "Unknown option: " << argv[i] << std::endl;
+            return 1;
+        }}
+    }}
+
+    try {{
+        std::cout << "Loading " << options.host << ":" << options.port << " with "
+                  << options.connections << " connections" << std::endl;
+        {}::bench::runLoad(options).print(std::cout);
+    }} catch (const std::exception& e) {{
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }}
+    return 0;
+}}
+)",
+                       options_.projectName, options_.projectName, options_.projectName,
+                       options_.projectName);
+}
+
+std::string NetworkTemplate::getServerBenchmarkContent() {
+    return fmt::format(R"(// Latency and throughput of the {} server over loopback: starts an echoing
+// server in-process and drives it with the load generator at each connection
+// count. Raise the open file limit (ulimit -n) for large counts.
+//   {}_bench [--threads T] [--connections 16,256,1024] [--size BYTES] [--seconds S]
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include "{}/server/server.h"
+#include "load_generator.h"
+
+int main(int argc, char* argv[]) {{
+    std::size_t serverThreads = 0;
+    std::vector<std::size_t> connectionCounts = {{16, 256, 1024}};
+    {}::bench::LoadOptions options;
+    options.duration = std::chrono::milliseconds(3000);
+
+    for (int i = 1; i + 1 < argc; i += 2) {{
+        const char* value = argv[i + 1];
+        if (std::strcmp(argv[i], "--threads") == 0) {{
+            serverThreads = std::strtoul(value, nullptr, 10);
+        }} else if (std::strcmp(argv[i], "--connections") == 0) {{
+            connectionCounts.clear();
+            std::stringstream list(value);
+            for (std::string item; std::getline(list, item, ',');) {{
+                connectionCounts.push_back(std::strtoul(item.c_str(), nullptr, 10));
+            }}
+        }} else if (std::strcmp(argv[i], "--size") == 0) {{
+            options.messageSize = std::strtoul(value, nullptr, 10);
+        }} else if (std::strcmp(argv[i], "--seconds") == 0) {{
+            options.duration = std::chrono::milliseconds(std::atoi(value) * 1000);
+        }} else {{
+            std::cerr << "Unknown option: " << argv[i] << std::endl;
+            return 1;
+        }}
+    }}
+
+    try {{
+        {}::Server server(serverThreads);
+        server.setMessageCallback(nullptr);
+        server.setEchoEnabled(true);
+        server.start(0);
+        options.port = static_cast<unsigned short>(server.port());
+
+        for (std::size_t connections : connectionCounts) {{
+            options.connections = connections;
+            std::cout << "== " << connections << " connections, " << server.threadCount()
+                      << " server threads, " << options.messageSize << " byte messages"
+                      << std::endl;
+            {}::bench::runLoad(options).print(std::cout);
+        }}
+        server.stop();
+    }} catch (const std::exception& e) {{
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }}
+    return 0;
+}}
+)",
+                       options_.projectName, options_.projectName, options_.projectName,
+                       options_.projectName, options_.projectName, options_.projectName);
+}
+
+std::string NetworkTemplate::getReactorHeaderContent() {
+    return fmt::format(R"(#pragma once
+
+// Building blocks of the Linux reactor behind Server: a readiness poller
+// (edge-triggered epoll, or multishot poll on io_uring when built with
+// REACTOR_USE_IO_URING), a receive buffer pool and a hashed timer wheel.
+// Nothing here locks; every event loop owns its own instances.
+
+#ifndef __linux__
+#error "The native reactor needs Linux; generate the project with --network-lib asio elsewhere"
+#endif
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <system_error>
+#include <vector>
+
+#include <sys/epoll.h>
+#include <unistd.h>
+
+#ifdef REACTOR_USE_IO_URING
+#include <liburing.h>
+#endif
+
+namespace {}::reactor {{
+
+// Readiness bits reported by Poller::wait (poll and epoll share the values on Linux)
+constexpr std::uint32_t READABLE = EPOLLIN;
+constexpr std::uint32_t WRITABLE = EPOLLOUT;
+constexpr std::uint32_t CLOSED = EPOLLRDHUP | EPOLLHUP | EPOLLERR;
+
+struct PollEvent {{
+    int fd;
+    std::uint32_t events;
+}};
+
+// Edge-triggered readiness notifications: after an event the owner must read
+// or write until EAGAIN before it is told again
+class Poller {{
+public:
+#ifdef REACTOR_USE_IO_URING
+    Poller() {{
+        int rc = io_uring_queue_init(1024, &ring_, 0);
+        if (rc < 0) {{
+            throw std::system_error(-rc, std::system_category(), "io_uring_queue_init");
+        }}
+    }}
+
+    ~Poller() {{
+        io_uring_queue_exit(&ring_);
+    }}
+
+    bool add(int fd) {{
+        io_uring_sqe* sqe = nextSqe();
+        if (!sqe) return false;
+        io_uring_prep_poll_multishot(sqe, fd, READABLE | WRITABLE | CLOSED);
+        io_uring_sqe_set_data64(sqe, static_cast<std::uint64_t>(fd));
+        return io_uring_submit(&ring_) >= 0;
+    }}
+
+    void remove(int fd) {{
+        if (io_uring_sqe* sqe = nextSqe()) {{
+            io_uring_prep_poll_remove(sqe, static_cast<std::uint64_t>(fd));
+            io_uring_sqe_set_data64(sqe, REMOVE_TAG);
+            io_uring_submit(&ring_);
+        }}
+    }}
+
+    // Fills events with what became ready within timeoutMs (-1 waits forever)
+    int wait(std::vector<PollEvent>& events, int timeoutMs) {{
+        events.clear();
+        __kernel_timespec timeout{{timeoutMs / 1000, (timeoutMs % 1000) * 1000000LL}};
+        io_uring_cqe* cqe = nullptr;
+        int rc = io_uring_submit_and_wait_timeout(&ring_, &cqe, 1,
+                                                  timeoutMs >= 0 ? &timeout : nullptr, nullptr);
+        if (rc < 0 && rc != -ETIME && rc != -EINTR) {{
+            errno = -rc;
+            return -1;
+        }}
+
+        unsigned head = 0;
+        unsigned seen = 0;
+        io_uring_for_each_cqe(&ring_, head, cqe) {{
+            ++seen;
+            if (cqe->user_data == REMOVE_TAG) continue;
+            int fd = static_cast<int>(cqe->user_data);
+            if (cqe->res >= 0) {{
+                events.push_back({{fd, static_cast<std::uint32_t>(cqe->res)}});
+            }}
+            // The kernel ends a multishot poll on overflow; cancelled polls stay ended
+            if (!(cqe->flags & IORING_CQE_F_MORE) && cqe->res != -ECANCELED) {{
+                rearm_.push_back(fd);
+            }}
+        }}
+        io_uring_cq_advance(&ring_, seen);
+        for (int fd : rearm_) {{
+            add(fd);
+        }}
+        rearm_.clear();
+        return static_cast<int>(events.size());
+    }}
+
+    static const char* backend() {{
+        return "io_uring";
+    }}
+
+private:
+    static constexpr std::uint64_t REMOVE_TAG = ~std::uint64_t{{0}};
+
+    io_uring_sqe* nextSqe() {{
+        io_uring_sqe* sqe = io_uring_get_sqe(&ring_);
+        if (!sqe) {{
+            io_uring_submit(&ring_);  // Submission queue full: flush it and retry
+            sqe = io_uring_get_sqe(&ring_);
+        }}
+        return sqe;
+    }}
+
+    io_uring ring_;
+    std::vector<int> rearm_;
+#else
+    Poller() : epoll_fd_(epoll_create1(EPOLL_CLOEXEC)), ready_(1024) {{
+        if (epoll_fd_ < 0) {{
+            throw std::system_error(errno, std::system_category(), "epoll_create1");
+        }}
+    }}
+
+    ~Poller() {{
+        ::close(epoll_fd_);
+    }}
+
+    bool add(int fd) {{
+        epoll_event event{{}};
+        event.events = READABLE | WRITABLE | CLOSED | EPOLLET;
+        event.data.fd = fd;
+        return epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) == 0;
+    }}
+
+    void remove(int fd) {{
+        epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+    }}
+
+    // Fills events with what became ready within timeoutMs (-1 waits forever)
+    int wait(std::vector<PollEvent>& events, int timeoutMs) {{
+        events.clear();
+        int count = epoll_wait(epoll_fd_, ready_.data(), static_cast<int>(ready_.size()), timeoutMs);
+        if (count < 0) {{
+            return errno == EINTR ? 0 : -1;
+        }}
+        for (int i = 0; i < count; ++i) {{
+            events.push_back({{ready_[i].data.fd, ready_[i].events}});
+        }}
+        return count;
+    }}
+
+    static const char* backend() {{
+        return "epoll";
+    }}
+
+private:
+    int epoll_fd_;
+    std::vector<epoll_event> ready_;
+#endif
+
+public:
+    Poller(const Poller&) = delete;
+    Poller& operator=(const Poller&) = delete;
+}};
+
+// Fixed-size receive buffers recycled through a free list. A connection only
+// holds one while it has unprocessed input, so idle connections cost no buffer
+class BufferPool {{
+public:
+    static constexpr std::size_t BUFFER_SIZE = 16 * 1024;
+
+    explicit BufferPool(std::size_t maxIdle = 1024) : max_idle_(maxIdle) {{}}
+
+    std::unique_ptr<char[]> acquire() {{
+        if (free_.empty()) {{
+            return std::unique_ptr<char[]>(new char[BUFFER_SIZE]);
+        }}
+        auto buffer = std::move(free_.back());
+        free_.pop_back();
+        return buffer;
+    }}
+
+    void release(std::unique_ptr<char[]> buffer) {{
+        if (buffer && free_.size() < max_idle_) {{
+            free_.push_back(std::move(buffer));
+        }}
+    }}
+
+private:
+    std::vector<std::unique_ptr<char[]>> free_;
+    std::size_t max_idle_;
+}};
+
+// Hashed timer wheel with one slot per tick. Deadlines are checked lazily: an
+// entry whose owner was active since it was scheduled is simply scheduled
+// again, so refreshing a deadline on every read costs nothing
+class TimerWheel {{
+public:
+    explicit TimerWheel(std::size_t slots = 64) : slots_(slots) {{}}
+
+    void schedule(std::uint64_t id, std::uint64_t tick) {{
+        if (tick <= current_) tick = current_ + 1;
+        slots_[tick % slots_.size()].push_back(id);
+    }}
+
+    // Moves the wheel to now, calling expired(id) for every entry passed on the way
+    template <typename Callback>
+    void advance(std::uint64_t now, Callback&& expired) {{
+        while (current_ < now) {{
+            ++current_;
+            due_.swap(slots_[current_ % slots_.size()]);
+            for (std::uint64_t id : due_) {{
+                expired(id);
+            }}
+            due_.clear();
+        }}
+    }}
+
+    std::uint64_t current() const {{
+        return current_;
+    }}
+
+private:
+    std::vector<std::vector<std::uint64_t>> slots_;
+    std::vector<std::uint64_t> due_;
+    std::uint64_t current_ = 0;
+}};
+
+}} // namespace {}::reactor)",
+                       options_.projectName, options_.projectName);
+}
+
+std::string NetworkTemplate::getReactorServerHeaderContent() {
+    return fmt::format(R"(#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {} {{
+
+// Dependency-free Linux TCP server for newline-delimited messages. Every event
+// loop thread runs its own edge-triggered reactor (see reactor.h) with its own
+// SO_REUSEPORT listener, so connections never move between threads.
+class Server {{
+public:
+    // threads == 0 starts one event loop per hardware thread
+    explicit Server(std::size_t threads = 1);
+    ~Server();
+
+    void start(int port);
+    // Stops accepting and reading, lets queued output drain for up to
+    // drainTimeout, then closes whatever is left
+    void stop(std::chrono::milliseconds drainTimeout = std::chrono::seconds(5));
+    void broadcast(const std::string& message);
+    void setMessageCallback(std::function<void(const std::string&)> callback);
+    void setEchoEnabled(bool enabled);
+    // Connections silent for this long are closed; zero disables the timeout
+    void setIdleTimeout(std::chrono::seconds timeout);
+
+    int port() const;
+    std::size_t threadCount() const;
+    std::size_t connectionCount() const;
+
+private:
+    struct Loop;
+    struct Connection;
+
+    void run(Loop& loop);
+    void acceptAll(Loop& loop);
+    bool onReadable(Loop& loop, Connection& connection);
+    bool flush(Loop& loop, Connection& connection);
+    void close(Loop& loop, Connection& connection);
+    void drainMailbox(Loop& loop);
+
+    std::size_t thread_count_;
+    std::vector<std::unique_ptr<Loop>> loops_;
+    std::atomic<std::size_t> connections_{{0}};
+    std::atomic<bool> running_{{false}};
+    bool echo_ = false;
+    std::chrono::seconds idle_timeout_{{60}};
+    std::chrono::milliseconds drain_timeout_{{0}};
+    int port_ = 0;
+    std::function<void(const std::string&)> message_callback_;
+}};
+
+}} // namespace {})",
+                       options_.projectName, options_.projectName);
+}
+
+std::string NetworkTemplate::getReactorServerImplContent() {
+    return fmt::format(R"(#include "{}/server/server.h"
+#include "{}/server/reactor.h"
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <system_error>
+#include <thread>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <spdlog/spdlog.h>
+
+namespace {} {{
+
+namespace {{
+
+// Queued lines handed to one sendmsg call
+constexpr std::size_t MAX_GATHER = 64;
+// Unsent output a connection may accumulate before it is dropped as too slow
+constexpr std::size_t MAX_PENDING_OUTPUT = 8 * 1024 * 1024;
+// How often an idle loop wakes up to advance its timer wheel, and while draining
+constexpr int TICK_MS = 1000;
+constexpr int DRAIN_POLL_MS = 20;
+
+using Payload = std::shared_ptr<const std::string>;
+
+int openListener(int port, bool reusePort) {{
+    int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {{
+        throw std::system_error(errno, std::system_category(), "socket");
+    }}
+
+    int one = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    if (reusePort && ::setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one)) < 0) {{
+        int error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::system_category(), "SO_REUSEPORT");
+    }}
+
+    sockaddr_in address{{}};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(static_cast<std::uint16_t>(port));
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+        ::listen(fd, SOMAXCONN) < 0) {{
+        int error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::system_category(), "bind/listen");
+    }}
+    return fd;
+}}
+
+int localPort(int fd) {{
+    sockaddr_in address{{}};
+    socklen_t length = sizeof(address);
+    ::getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length);
+    return ntohs(address.sin_port);
+}}
+
+}} // namespace
+
+struct Server::Connection {{
+    int fd = -1;
+    std::uint64_t id = 0;                // Generation and fd, so stale timer entries are ignored
+    std::unique_ptr<char[]> input;       // Pooled; held only while a partial line is pending
+    std::size_t input_length = 0;
+    std::deque<Payload> output;          // Shared lines, sent straight from their buffers
+    std::size_t output_offset = 0;       // Bytes of output.front() already sent
+    std::size_t output_bytes = 0;
+    std::uint64_t last_active = 0;       // Tick of the last read
+}};
+
+// One event loop: only its own thread touches anything but the mailbox
+struct Server::Loop {{
+    ~Loop() {{
+        for (auto& connection : connections) {{
+            if (connection) ::close(connection->fd);
+        }}
+        if (listen_fd >= 0) ::close(listen_fd);
+        if (wake_fd >= 0) ::close(wake_fd);
+    }}
+
+    void wake() {{
+        std::uint64_t one = 1;
+        [[maybe_unused]] ssize_t written = ::write(wake_fd, &one, sizeof(one));
+    }}
+
+    reactor::Poller poller;
+    reactor::BufferPool buffers;
+    reactor::TimerWheel timers;
+    int listen_fd = -1;
+    int wake_fd = -1;  // eventfd signalled for stop and broadcast
+    std::thread thread;
+    std::vector<std::unique_ptr<Connection>> connections;  // Indexed by fd
+    std::size_t open = 0;
+    std::uint32_t generation = 0;
+    std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+    std::uint64_t tick = 0;  // Whole seconds since started
+    std::atomic<bool> stopping{{false}};
+
+    std::mutex mutex;
+    std::vector<Payload> mailbox;  // Broadcasts posted by other threads
+}};
+
+Server::Server(std::size_t threads)
+    : thread_count_(threads ? threads : std::max(1u, std::thread::hardware_concurrency())) {{
+    message_callback_ = [](const std::string& msg) {{
+        spdlog::info("Message received: {{}}", msg);
+    }};
+}}
+
+Server::~Server() {{
+    stop(std::chrono::milliseconds(0));
+}}
+
+void Server::start(int port) {{
+    if (running_) return;
+
+    try {{
+        loops_.clear();
+        for (std::size_t i = 0; i < thread_count_; ++i) {{
+            auto loop = std::make_unique<Loop>();
+            loop->listen_fd = openListener(port, thread_count_ > 1);
+            if (i == 0) {{
+                // Later listeners join the port the first one got
+                port_ = localPort(loop->listen_fd);
+                port = port_;
+            }}
+            loop->wake_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            if (loop->wake_fd < 0 || !loop->poller.add(loop->listen_fd) ||
+                !loop->poller.add(loop->wake_fd)) {{
+                throw std::system_error(errno, std::system_category(), "event loop setup");
+            }}
+            loops_.push_back(std::move(loop));
+        }}
+
+        running_ = true;
+        for (auto& loop : loops_) {{
+            loop->thread = std::thread([this, l = loop.get()]() {{
+                try {{
+                    run(*l);
+                }} catch (const std::exception& e) {{
+                    spdlog::error("Event loop error: {{}}", e.what());
+                }}
+            }});
+        }}
+        spdlog::info("Server started on port {{}} with {{}} {{}} event loops", port_, loops_.size(),
+                     reactor::Poller::backend());
+    }} catch (const std::exception& e) {{
+        running_ = false;
+        loops_.clear();
+        spdlog::error("Server start error: {{}}", e.what());
+        throw;
+    }}
+}}
+
+void Server::stop(std::chrono::milliseconds drainTimeout) {{
+    if (!running_.exchange(false)) return;
+
+    drain_timeout_ = drainTimeout;
+    for (auto& loop : loops_) {{
+        loop->stopping = true;
+        loop->wake();
+    }}
+    for (auto& loop : loops_) {{
+        if (loop->thread.joinable()) {{
+            loop->thread.join();
+        }}
+    }}
+    loops_.clear();
+    spdlog::info("Server stopped");
+}}
+
+void Server::broadcast(const std::string& message) {{
+    // One buffer for every client, released when the last one has sent it
+    auto payload = std::make_shared<const std::string>(message + "\n");
+    for (auto& loop : loops_) {{
+        {{
+            std::lock_guard<std::mutex> lock(loop->mutex);
+            loop->mailbox.push_back(payload);
+        }}
+        loop->wake();
+    }}
+}}
+
+void Server::setMessageCallback(std::function<void(const std::string&)> callback) {{
+    message_callback_ = std::move(callback);
+}}
+
+void Server::setEchoEnabled(bool enabled) {{
+    echo_ = enabled;
+}}
+
+void Server::setIdleTimeout(std::chrono::seconds timeout) {{
+    idle_timeout_ = timeout;
+}}
+
+int Server::port() const {{
+    return port_;
+}}
+
+std::size_t Server::threadCount() const {{
+    return thread_count_;
+}}
+
+std::size_t Server::connectionCount() const {{
+    return connections_;
+}}
+
+void Server::run(Loop& loop) {{
+    std::vector<reactor::PollEvent> events;
+    bool draining = false;
+    std::chrono::steady_clock::time_point drainDeadline;
+
+    for (;;) {{
+        if (loop.poller.wait(events, draining ? DRAIN_POLL_MS : TICK_MS) < 0) {{
+            throw std::system_error(errno, std::system_category(), "poller wait");
+        }}
+        auto now = std::chrono::steady_clock::now();
+        loop.tick = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::seconds>(now - loop.started).count());
+
+        for (const auto& event : events) {{
+            if (event.fd == loop.listen_fd) {{
+                if (!draining) acceptAll(loop);
+                continue;
+            }}
+            if (event.fd == loop.wake_fd) {{
+                std::uint64_t count = 0;
+                while (::read(loop.wake_fd, &count, sizeof(count)) > 0) {{
+                }}
+                drainMailbox(loop);
+                continue;
+            }}
+
+            if (static_cast<std::size_t>(event.fd) >= loop.connections.size()) continue;
+            Connection* connection = loop.connections[event.fd].get();
+            if (!connection) continue;
+            if (event.events & (reactor::READABLE | reactor::CLOSED)) {{
+                if (draining) {{
+                    if (event.events & reactor::CLOSED) close(loop, *connection);
+                    continue;
+                }}
+                if (!onReadable(loop, *connection)) continue;
+            }}
+            if ((event.events & reactor::WRITABLE) && !connection->output.empty()) {{
+                flush(loop, *connection);
+            }}
+        }}
+
+        if (idle_timeout_.count() > 0) {{
+            auto timeout = static_cast<std::uint64_t>(idle_timeout_.count());
+            loop.timers.advance(loop.tick, [&](std::uint64_t id) {{
+                auto fd = static_cast<std::size_t>(id & 0xffffffffu);
+                if (fd >= loop.connections.size()) return;
+                Connection* connection = loop.connections[fd].get();
+                if (!connection || connection->id != id) return;
+                if (connection->last_active + timeout <= loop.tick) {{
+                    close(loop, *connection);
+                }} else {{
+                    loop.timers.schedule(id, connection->last_active + timeout);
+                }}
+            }});
+        }}
+
+        if (!draining && loop.stopping) {{
+            // Graceful drain: no new connections or input, queued output still goes out
+            draining = true;
+            drainDeadline = now + drain_timeout_;
+            loop.poller.remove(loop.listen_fd);
+            ::close(loop.listen_fd);
+            loop.listen_fd = -1;
+        }}
+        if (draining) {{
+            bool expired = now >= drainDeadline;
+            for (auto& connection : loop.connections) {{
+                if (connection && (expired || connection->output.empty())) {{
+                    close(loop, *connection);
+                }}
+            }}
+            if (loop.open == 0) return;
+        }}
+    }}
+}}
+
+void Server::acceptAll(Loop& loop) {{
+    for (;;) {{
+        int fd = ::accept4(loop.listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {{
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {{
+                spdlog::warn("Accept error: {{}}", std::strerror(errno));
+            }}
+            return;
+        }}
+
+        int one = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        if (!loop.poller.add(fd)) {{
+            ::close(fd);
+            continue;
+        }}
+
+        if (static_cast<std::size_t>(fd) >= loop.connections.size()) {{
+            loop.connections.resize(static_cast<std::size_t>(fd) + 1);
+        }}
+        auto connection = std::make_unique<Connection>();
+        connection->fd = fd;
+        connection->id = (static_cast<std::uint64_t>(++loop.generation) << 32) |
+                         static_cast<std::uint32_t>(fd);
+        connection->last_active = loop.tick;
+        if (idle_timeout_.count() > 0) {{
+            loop.timers.schedule(connection->id,
+                                 loop.tick + static_cast<std::uint64_t>(idle_timeout_.count()));
+        }}
+        loop.connections[fd] = std::move(connection);
+        ++loop.open;
+        ++connections_;
+    }}
+}}
+
+bool Server::onReadable(Loop& loop, Connection& connection) {{
+    constexpr std::size_t capacity = reactor::BufferPool::BUFFER_SIZE;
+    for (;;) {{
+        if (!connection.input) {{
+            connection.input = loop.buffers.acquire();
+        }}
+        char* data = connection.input.get();
+        ssize_t received = ::read(connection.fd, data + connection.input_length,
+                                  capacity - connection.input_length);
+        if (received < 0 && errno == EINTR) continue;
+        if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        if (received <= 0) {{
+            close(loop, connection);
+            return false;
+        }}
+        connection.last_active = loop.tick;
+
+        // Only the new bytes can hold a newline
+        std::size_t lineStart = 0;
+        std::size_t scanned = connection.input_length;
+        std::size_t end = connection.input_length + static_cast<std::size_t>(received);
+        while (const void* found = std::memchr(data + scanned, '\n', end - scanned)) {{
+            std::size_t lineEnd = static_cast<std::size_t>(static_cast<const char*>(found) - data) + 1;
+            if (echo_) {{
+                auto payload = std::make_shared<const std::string>(data + lineStart, lineEnd - lineStart);
+                connection.output_bytes += payload->size();
+                connection.output.push_back(std::move(payload));
+            }}
+            if (message_callback_) {{
+                message_callback_(std::string(data + lineStart, lineEnd - lineStart - 1));
+            }}
+            lineStart = scanned = lineEnd;
+        }}
+        if (lineStart > 0) {{
+            std::memmove(data, data + lineStart, end - lineStart);
+        }}
+        connection.input_length = end - lineStart;
+        if (connection.input_length == capacity) {{
+            spdlog::warn("Closing connection: line longer than {{}} bytes", capacity);
+            close(loop, connection);
+            return false;
+        }}
+    }}
+
+    if (connection.input_length == 0) {{
+        loop.buffers.release(std::move(connection.input));
+    }}
+    return connection.output.empty() || flush(loop, connection);
+}}
+
+bool Server::flush(Loop& loop, Connection& connection) {{
+    while (!connection.output.empty()) {{
+        // Gather queued lines straight from their shared buffers: no copy into a send buffer
+        iovec vectors[MAX_GATHER];
+        std::size_t count = 0;
+        for (auto it = connection.output.begin();
+             it != connection.output.end() && count < MAX_GATHER; ++it, ++count) {{
+            std::size_t skip = count == 0 ? connection.output_offset : 0;
+            vectors[count].iov_base = const_cast<char*>((*it)->data()) + skip;
+            vectors[count].iov_len = (*it)->size() - skip;
+        }}
+        msghdr message{{}};
+        message.msg_iov = vectors;
+        message.msg_iovlen = count;
+
+        ssize_t sent = ::sendmsg(connection.fd, &message, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR) continue;
+        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {{
+            if (connection.output_bytes > MAX_PENDING_OUTPUT) {{
+                spdlog::warn("Closing connection: {{}} bytes of output pending",
+                             connection.output_bytes);
+                break;
+            }}
+            return true;  // The poller reports WRITABLE once the socket drains
+        }}
+        if (sent < 0) break;
+
+        auto remaining = static_cast<std::size_t>(sent);
+        connection.output_bytes -= remaining;
+        while (remaining > 0) {{
+            std::size_t left = connection.output.front()->size() - connection.output_offset;
+            if (remaining < left) {{
+                connection.output_offset += remaining;
+                break;
+            }}
+            remaining -= left;
+            connection.output.pop_front();
+            connection.output_offset = 0;
+        }}
+    }}
+    if (connection.output.empty()) return true;
+
+    close(loop, connection);
+    return false;
+}}
+
+void Server::close(Loop& loop, Connection& connection) {{
+    int fd = connection.fd;
+    loop.poller.remove(fd);
+    ::close(fd);
+    loop.buffers.release(std::move(connection.input));
+    loop.connections[fd].reset();
+    --loop.open;
+    --connections_;
+}}
+
+void Server::drainMailbox(Loop& loop) {{
+    std::vector<Payload> mailbox;
+    {{
+        std::lock_guard<std::mutex> lock(loop.mutex);
+        mailbox.swap(loop.mailbox);
+    }}
+    if (mailbox.empty()) return;
+
+    for (auto& slot : loop.connections) {{
+        if (!slot) continue;
+        for (const auto& payload : mailbox) {{
+            slot->output_bytes += payload->size();
+            slot->output.push_back(payload);
+        }}
+        flush(loop, *slot);
+    }}
+}}
+
+}} // namespace {})",
+                       options_.projectName, options_.projectName, options_.projectName,
+                       options_.projectName);
+}
+
+std::string NetworkTemplate::getEchoBenchmarkContent() {
+    return fmt::format(R"(// Echo round trips against the {} reactor over loopback: starts an echoing
+// server in-process and drives it from epoll client threads, each connection
+// sending one line and waiting for its echo before the next. Raise the open
+// file limit (ulimit -n) for large connection counts.
+//   {}_echo_bench [--threads T] [--client-threads T] [--connections 16,256,1024]
+//                   [--size BYTES] [--seconds S]
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "{}/server/server.h"
+
+namespace {{
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {{
+    std::size_t serverThreads = 0;
+    std::size_t clientThreads = 0;
+    std::vector<std::size_t> connectionCounts = {{16, 256, 1024}};
+    std::size_t messageSize = 64;
+    std::chrono::milliseconds duration{{3000}};
+}};
+
+struct ThreadStats {{
+    std::size_t connections = 0;
+    std::uint64_t messages = 0;
+    std::uint64_t errors = 0;
+    std::vector<std::uint32_t> latenciesUs;
+}};
+
+struct EchoConnection {{
+    int fd = -1;
+    std::size_t received = 0;  // Bytes of the current echo read back
+    Clock::time_point started;
+}};
+
+int connectLoopback(unsigned short port) {{
+    int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+    sockaddr_in address{{}};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {{
+        ::close(fd);
+        return -1;
+    }}
+    int one = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    return fd;
+}}
+
+// Sockets stay blocking for writes: the echo server keeps reading, so a
+// large message only blocks until it has gone out
+bool sendMessage(int fd, const std::string& message) {{
+    std::size_t sent = 0;
+    while (sent < message.size()) {{
+        ssize_t written = ::send(fd, message.data() + sent, message.size() - sent, MSG_NOSIGNAL);
+        if (written < 0) {{
+            if (errno == EINTR) continue;
+            return false;
+        }}
+        sent += static_cast<std::size_t>(written);
+    }}
+    return true;
+}}
+
+void runClients(std::size_t count, unsigned short port, const std::string& message,
+                const std::atomic<bool>& done, ThreadStats& stats) {{
+    int epoll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+    std::vector<EchoConnection> connections(count);
+    for (std::size_t i = 0; i < count; ++i) {{
+        EchoConnection& connection = connections[i];
+        connection.fd = connectLoopback(port);
+        if (connection.fd < 0) {{
+            ++stats.errors;
+            continue;
+        }}
+        epoll_event event{{}};
+        event.events = EPOLLIN;
+        event.data.u64 = i;
+        ::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, connection.fd, &event);
+        ++stats.connections;
+        connection.started = Clock::now();
+        if (!sendMessage(connection.fd, message)) ++stats.errors;
+    }}
+
+    std::vector<epoll_event> events(256);
+    std::vector<char> buffer(std::max<std::size_t>(message.size(), 4096));
+    while (!done) {{
+        int ready = ::epoll_wait(epoll_fd, events.data(), static_cast<int>(events.size()), 50);
+        for (int i = 0; i < ready; ++i) {{
+            EchoConnection& connection = connections[events[i].data.u64];
+            if (connection.fd < 0) continue;
+            ssize_t got = ::recv(connection.fd, buffer.data(), buffer.size(), MSG_DONTWAIT);
+            if (got <= 0) {{
+                if (got < 0 && (errno == EAGAIN || errno == EINTR)) continue;
+                ++stats.errors;
+                ::close(connection.fd);
+                connection.fd = -1;
+                continue;
+            }}
+            connection.received += static_cast<std::size_t>(got);
+            if (connection.received < message.size()) continue;
+
+            auto elapsed = Clock::now() - connection.started;
+            stats.latenciesUs.push_back(static_cast<std::uint32_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()));
+            ++stats.messages;
+
+            connection.received -= message.size();
+            connection.started = Clock::now();
+            if (!sendMessage(connection.fd, message)) ++stats.errors;
+        }}
+    }}
+
+    for (auto& connection : connections) {{
+        if (connection.fd >= 0) ::close(connection.fd);
+    }}
+    ::close(epoll_fd);
+}}
+
+void runRound(const Options& options, std::size_t connections, unsigned short port) {{
+    std::size_t threads = options.clientThreads
+                                  ? options.clientThreads
+                                  : std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min(threads, std::max<std::size_t>(connections, 1));
+    std::string message(std::max<std::size_t>(options.messageSize, 2) - 1, 'x');
+    message.push_back('\n');
+
+    std::atomic<bool> done{{false}};
+    std::vector<ThreadStats> stats(threads);
+    std::vector<std::thread> workers;
+    auto started = Clock::now();
+    for (std::size_t i = 0; i < threads; ++i) {{
+        std::size_t share = connections / threads + (i < connections % threads ? 1 : 0);
+        workers.emplace_back(runClients, share, port, std::cref(message), std::cref(done),
+                             std::ref(stats[i]));
+    }}
+    std::this_thread::sleep_for(options.duration);
+    done = true;
+    for (auto& worker : workers) {{
+        worker.join();
+    }}
+    double seconds = std::chrono::duration<double>(Clock::now() - started).count();
+
+    ThreadStats total;
+    for (auto& thread : stats) {{
+        total.connections += thread.connections;
+        total.messages += thread.messages;
+        total.errors += thread.errors;
+        total.latenciesUs.insert(total.latenciesUs.end(), thread.latenciesUs.begin(),
+                                 thread.latenciesUs.end());
+    }}
+    std::sort(total.latenciesUs.begin(), total.latenciesUs.end());
+    auto percentile = [&](double p) -> std::uint32_t {{
+        if (total.latenciesUs.empty()) return 0;
+        return total.latenciesUs[static_cast<std::size_t>(
+            p / 100.0 * static_cast<double>(total.latenciesUs.size() - 1))];
+    }};
+
+    double perSecond = static_cast<double>(total.messages) / seconds;
+    std::cout << std::fixed << std::setprecision(1)
+              << "connections " << total.connections << "\n"
+              << "messages    " << total.messages << " (" << perSecond << " msg/s)\n"
+              << "throughput  " << perSecond * static_cast<double>(message.size()) / (1024 * 1024)
+              << " MiB/s each way\n"
+              << "latency us  p50 " << percentile(50) << "  p90 " << percentile(90) << "  p99 "
+              << percentile(99) << "  max " << percentile(100) << "\n"
+              << "errors      " << total.errors << "\n";
+}}
+
+}} // namespace
+
+int main(int argc, char* argv[]) {{
+    Options options;
+    for (int i = 1; i + 1 < argc; i += 2) {{
+        const char* value = argv[i + 1];
+        if (std::strcmp(argv[i], "--threads") == 0) {{
+            options.serverThreads = std::strtoul(value, nullptr, 10);
+        }} else if (std::strcmp(argv[i], "--client-threads") == 0) {{
+            options.clientThreads = std::strtoul(value, nullptr, 10);
+        }} else if (std::strcmp(argv[i], "--connections") == 0) {{
+            options.connectionCounts.clear();
+            std::stringstream list(value);
+            for (std::string item; std::getline(list, item, ',');) {{
+                options.connectionCounts.push_back(std::strtoul(item.c_str(), nullptr, 10));
+            }}
+        }} else if (std::strcmp(argv[i], "--size") == 0) {{
+            options.messageSize = std::strtoul(value, nullptr, 10);
+        }} else if (std::strcmp(argv[i], "--seconds") == 0) {{
+            options.duration = std::chrono::milliseconds(std::atoi(value) * 1000);
+        }} else {{
+            std::cerr << "Unknown option: " << argv[i] << std::endl;
+            return 1;
+        }}
+    }}
+
+    try {{
+        {}::Server server(options.serverThreads);
+        server.setMessageCallback(nullptr);
+        server.setEchoEnabled(true);
+        server.start(0);
+
+        for (std::size_t connections : options.connectionCounts) {{
+            std::cout << "== " << connections << " connections, " << server.threadCount()
+                      << " server threads, " << options.messageSize << " byte messages"
+                      << std::endl;
+            runRound(options, connections, static_cast<unsigned short>(server.port()));
+        }}
+        server.stop();
+    }} catch (const std::exception& e) {{
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }}
+    return 0;
+}})",
+                       options_.projectName, options_.projectName, options_.projectName,
+                       options_.projectName);
+}
@@ -30,4 +30,20 @@ private:
   std::string getXMakeContent();
   std::string getPremakeContent();
   std::string getNetworkTestContent();
+
+  // --network-concurrency=pool: io_context-per-core server, load generator and benchmark
+  bool usesServerPool() const;
+  bool createBenchmarkFiles();
+  std::string getPoolServerHeaderContent();
+  std::string getPoolServerImplContent();
+  std::string getLoadGeneratorHeaderContent();
+  std::string getLoadGeneratorMainContent();
+  std::string getServerBenchmarkContent();
+
+  // --network-lib=native: dependency-free epoll/io_uring reactor and loopback echo benchmark
+  bool usesNativeReactor() const;
+  std::string getReactorHeaderContent();
+  std::string getReactorServerHeaderContent();
+  std::string getReactorServerImplContent();
+  std::string getEchoBenchmarkContent();
 };
@@ -37,56 +37,23 @@ TemplateBase::~TemplateBase() {
 }
 
 // Resource Manager Implementation
-void TemplateBase::ResourceManager::addCreatedDirectory(const std::filesystem::path& path) {
-    createdDirectories.push_back(path);
-    spdlog::debug("Registered created directory: {}", path.string());
-}
-
-void TemplateBase::ResourceManager::addCreatedFile(const std::filesystem::path& path) {
-    createdFiles.push_back(path);
-    spdlog::debug("Registered created file: {}", path.string());
-}
-
 void TemplateBase::ResourceManager::addExecutedCommand(const std::string& command) {
     executedCommands.push_back(command);
     spdlog::debug("Registered executed command: {}", command);
 }
 
-bool TemplateBase::ResourceManager::rollbackChanges() {
-    bool success = true;
-
-    // Remove created files (in reverse order)
-    for (auto it = createdFiles.rbegin(); it != createdFiles.rend(); ++it) {
-        try {
-            if (std::filesystem::exists(*it)) {
-                std::filesystem::remove(*it);
-                spdlog::debug("Rolled back file: {}", it->string());
-            }
-        } catch (const std::exception& e) {
-            spdlog::error("Failed to rollback file {}: {}", it->string(), e.what());
-            success = false;
-        }
-    }
-
-    // Remove created directories (in reverse order)
-    for (auto it = createdDirectories.rbegin(); it != createdDirectories.rend(); ++it) {
-        try {
-            if (std::filesystem::exists(*it) && std::filesystem::is_empty(*it)) {
-                std::filesystem::remove(*it);
-                spdlog::debug("Rolled back directory: {}", it->string());
-            }
-        } catch (const std::exception& e) {
-            spdlog::error("Failed to rollback directory {}: {}", it->string(), e.what());
-            success = false;
-        }
+bool TemplateBase::ResourceManager::rollbackChanges(const std::filesystem::path& projectRoot) {
+    std::error_code ec;
+    std::filesystem::remove_all(projectRoot, ec);
+    if (ec) {
+        spdlog::error("Failed to rollback {}: {}", projectRoot.string(), ec.message());
+        return false;
     }
-
-    return success;
+    spdlog::debug("Rolled back project directory: {}", projectRoot.string());
+    return true;
 }
 
 void TemplateBase::ResourceManager::cleanup() {
-    createdDirectories.clear();
-    createdFiles.clear();
     executedCommands.clear();
 }
 
@@ -147,7 +114,6 @@ bool TemplateBase::createDirectoryWithValidation(const std::filesystem::path& pa
             return false;
         }
 
-        registerCreatedResource(path, true);
         spdlog::debug("Created directory: {}", path.string());
         return true;
 
@@ -176,7 +142,6 @@ bool TemplateBase::createFileWithValidation(const std::filesystem::path& path,
             return false;
         }
 
-        registerCreatedResource(path, false);
         spdlog::debug("Created file: {}", path.string());
         return true;
 
@@ -214,7 +179,6 @@ bool TemplateBase::copyFileWithValidation(const std::filesystem::path& source,
             return false;
         }
 
-        registerCreatedResource(dest, false);
         spdlog::debug("Copied file: {} -> {}", source.string(), dest.string());
         return true;
 
@@ -242,6 +206,36 @@ bool TemplateBase::executeCommandWithValidation(const std::string& command,
     }
 }
 
+// Batched file emission
+void TemplateBase::enqueueDirectory(const std::filesystem::path& path) {
+    fileEmitter_.enqueueDirectory(path);
+}
+
+void TemplateBase::enqueueFile(const std::filesystem::path& path, std::string content) {
+    fileEmitter_.enqueueFile(path, std::move(content));
+}
+
+void TemplateBase::enqueueFile(const std::filesystem::path& path,
+                               utils::FileEmitter::ContentRenderer renderer) {
+    fileEmitter_.enqueueFile(path, std::move(renderer));
+}
+
+bool TemplateBase::flushQueuedFiles() {
+    try {
+        auto report = fileEmitter_.flush();
+        for (const auto& [path, error] : report.failures) {
+            reportTemplateError("File Creation", "Failed to create " + path.string() + ": " + error,
+                                "Check permissions and disk space");
+        }
+        return report.success();
+
+    } catch (const std::exception& e) {
+        fileEmitter_.clear();
+        reportTemplateError("File Creation Exception", e.what(), "Check file system permissions");
+        return false;
+    }
+}
+
 // Validation helper methods
 bool TemplateBase::validateProjectConfiguration() {
     std::string error;
@@ -361,17 +355,10 @@ bool TemplateBase::attemptErrorRecovery(const std::string& errorCode) {
 }
 
 // Resource cleanup helper methods
-void TemplateBase::registerCreatedResource(const std::filesystem::path& path, bool isDirectory) {
-    if (isDirectory) {
-        resourceManager_->addCreatedDirectory(path);
-    } else {
-        resourceManager_->addCreatedFile(path);
-    }
-}
-
 bool TemplateBase::cleanupOnFailure() {
     spdlog::warn("Cleaning up resources due to failure");
-    return resourceManager_->rollbackChanges();
+    // createWithEnhancedHandling refuses an existing project directory, so all of it is ours
+    return resourceManager_->rollbackChanges(options_.projectName);
 }
 
 bool TemplateBase::initializeGit(const std::string& projectPath) {
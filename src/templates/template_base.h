@@ -6,6 +6,7 @@
 
 #include "../cli/types/cli_options.h"
 #include "../testing/test_framework_manager.h"
+#include "../utils/core/file_emitter.h"
 #include "../utils/core/file_utils.h"
 #include "../utils/ui/progress_indicator.h"
 #include "../utils/validation/edge_case_handler.h"
@@ -22,22 +23,21 @@ class TemplateBase {
     bool createWithEnhancedHandling();
 
    protected:
-    // Resource management and cleanup
+    // Resource management and cleanup. Files are not tracked one by one: a
+    // failed project is removed as a whole, normally as the staging tree set
+    // up by TemplateManager (see utils::StagingDirectory)
     struct ResourceManager {
-        std::vector<std::filesystem::path> createdDirectories;
-        std::vector<std::filesystem::path> createdFiles;
         std::vector<std::string> executedCommands;
         std::chrono::steady_clock::time_point startTime;
 
-        void addCreatedDirectory(const std::filesystem::path& path);
-        void addCreatedFile(const std::filesystem::path& path);
         void addExecutedCommand(const std::string& command);
-        bool rollbackChanges();
+        bool rollbackChanges(const std::filesystem::path& projectRoot);
         void cleanup();
     };
 
     std::unique_ptr<ResourceManager> resourceManager_;
     std::unique_ptr<utils::ScopedProgress> currentProgress_;
+    utils::FileEmitter fileEmitter_;
 
     CliOptions options_;
 
@@ -55,6 +55,14 @@ class TemplateBase {
     bool executeCommandWithValidation(const std::string& command,
                                       const std::filesystem::path& workingDir = "");
 
+    // Batched file emission: queued files are written concurrently by
+    // flushQueuedFiles()
+    void enqueueDirectory(const std::filesystem::path& path);
+    void enqueueFile(const std::filesystem::path& path, std::string content);
+    void enqueueFile(const std::filesystem::path& path,
+                     utils::FileEmitter::ContentRenderer renderer);
+    bool flushQueuedFiles();
+
     // Input validation helpers
     bool validateProjectConfiguration();
     bool validateSystemRequirements();
@@ -73,7 +81,6 @@ class TemplateBase {
     bool attemptErrorRecovery(const std::string& errorCode);
 
     // Resource cleanup helpers
-    void registerCreatedResource(const std::filesystem::path& path, bool isDirectory = false);
     bool cleanupOnFailure();
 
     // 设置CI/CD配置
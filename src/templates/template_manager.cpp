@@ -11,6 +11,7 @@
 
 #include <iostream>
 
+#include "../utils/core/staging_directory.h"
 #include "../utils/external/framework_integration.h"
 
 #include "archive_template.h"
@@ -109,11 +110,26 @@ bool TemplateManager::createProject(const CliOptions& options) {
                 return false;
             }
 
+            // Generate into a staging directory and publish it only once complete
+            utils::StagingDirectory staging(options.projectName);
+            std::string error;
+            if (!staging.begin(error)) {
+                spdlog::error("{}", error);
+                return false;
+            }
+
             // Create template
             auto template_ptr = it->second(options);
 
-            // Create project
-            return template_ptr->create();
+            // Create project; the staging destructor removes a partial tree
+            if (!template_ptr->create()) {
+                return false;
+            }
+            if (!staging.commit(error)) {
+                spdlog::error("{}", error);
+                return false;
+            }
+            return true;
         }
 
         // Handle local path source type (future enhancement)
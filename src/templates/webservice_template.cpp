@@ -106,6 +106,10 @@ bool WebServiceTemplate::createProjectStructure() {
         return false;
     }
 
+    if (usesPerfServer() && !createPerformanceFiles()) {
+        return false;
+    }
+
     if (!FileUtils::writeToFile(FileUtils::combinePath(projectPath, "README.md"),
                                 getReadmeContent())) {
         return false;
@@ -269,6 +273,35 @@ bool WebServiceTemplate::setupAPIDocumentation() {
     return true;
 }
 
+bool WebServiceTemplate::createPerformanceFiles() {
+    std::string projectPath = options_.projectName;
+
+    for (const char* dir : {"include/http", "src/http", "tools"}) {
+        if (!FileUtils::createDirectory(FileUtils::combinePath(projectPath, dir))) {
+            std::cerr << "? Failed to create directory: " << dir << "\n";
+            return false;
+        }
+    }
+
+    std::vector<std::pair<const char*, std::string>> files = {
+            {"include/http/json_writer.h", getJsonWriterHeaderContent()},
+            {"src/http/json_writer.cpp", getJsonWriterCppContent()},
+            {"include/http/metrics.h", getMetricsHeaderContent()},
+            {"src/http/metrics.cpp", getMetricsCppContent()},
+            {"tools/load_generator.cpp", getLoadGeneratorContent()},
+            {"scripts/load_test.sh", getLoadTestContent()}};
+    for (const auto& [path, content] : files) {
+        if (!FileUtils::writeToFile(FileUtils::combinePath(projectPath, path), content)) {
+            std::cerr << "? Failed to write " << path << "\n";
+            return false;
+        }
+    }
+
+    // Not fatal: the script can still be run with bash
+    FileUtils::setExecutable(FileUtils::combinePath(projectPath, "scripts/load_test.sh"));
+    return true;
+}
+
 std::string WebServiceTemplate::getWebFramework() const {
     // Default to a lightweight HTTP framework
     return "httplib";  // cpp-httplib is a popular choice
@@ -287,6 +320,10 @@ bool WebServiceTemplate::isGraphQL() const {
     return false;  // GraphQL support can be added later
 }
 
+bool WebServiceTemplate::usesPerfServer() const {
+    return options_.webPerf;
+}
+
 std::string WebServiceTemplate::getMainCppContent() {
     return fmt::format(R"(#include "server.h"
 #include "config/config.h"
@@ -340,6 +377,10 @@ int main(int argc, char* argv[]) {{
 }
 
 std::string WebServiceTemplate::getServerHeaderContent() {
+    if (usesPerfServer()) {
+        return getPerfServerHeaderContent();
+    }
+
     return fmt::format(R"(#pragma once
 
 #include "config/config.h"
@@ -373,6 +414,10 @@ private:
 }
 
 std::string WebServiceTemplate::getServerCppContent() {
+    if (usesPerfServer()) {
+        return getPerfServerCppContent();
+    }
+
     return fmt::format(R"(#include "server.h"
 #include "routes/router.h"
 #include "utils/logger.h"
@@ -411,12 +456,12 @@ void Server::start() {{
 
     // Health check endpoint
     server.Get("/health", [](const httplib::Request&, httplib::Response& res) {{
-        res.set_content("{{\\"status\\": \\"healthy\\", \\"service\\": \\"{}\\"}}", "application/json");
+        res.set_content("{{\"status\": \"healthy\", \"service\": \"{}\"}}", "application/json");
     }});
 
     // API info endpoint
     server.Get("/api/info", [](const httplib::Request&, httplib::Response& res) {{
-        res.set_content("{{\\"name\\": \\"{}\\"", \\"version\\": \\"1.0.0\\", \\"description\\": \\"RESTful API service\\"}}", "application/json");
+        res.set_content("{{\"name\": \"{}\", \"version\": \"1.0.0\", \"description\": \"RESTful API service\"}}", "application/json");
     }});
 
     Logger::info("Server starting on port " + std::to_string(config_.getPort()));
@@ -447,10 +492,26 @@ void Server::setupRoutes() {{
 
 }} // namespace {}
 )",
-                       options_.projectName, options_.projectName);
+                       options_.projectName, options_.projectName, options_.projectName,
+                       options_.projectName);
 }
 
 std::string WebServiceTemplate::getCMakeContent() {
+    std::string perfSources;
+    std::string perfTargets;
+    if (usesPerfServer()) {
+        perfSources = "\n  src/http/json_writer.cpp\n  src/http/metrics.cpp";
+        perfTargets = fmt::format(R"(
+# Worker pool threads, and the load generator used by scripts/load_test.sh
+find_package(Threads REQUIRED)
+target_link_libraries({0} PRIVATE Threads::Threads)
+
+add_executable({0}_loadgen tools/load_generator.cpp)
+target_link_libraries({0}_loadgen PRIVATE Threads::Threads)
+)",
+                                  options_.projectName);
+    }
+
     return fmt::format(R"(cmake_minimum_required(VERSION 3.15)
 project({} VERSION 1.0.0 LANGUAGES CXX)
 
@@ -479,7 +540,7 @@ set(SOURCES
   src/config/config.cpp
   src/utils/logger.cpp
   src/routes/router.cpp
-  src/controllers/controller.cpp
+  src/controllers/controller.cpp{}
 )
 
 # Create executable
@@ -504,16 +565,59 @@ if(CMAKE_CXX_COMPILER_ID MATCHES "GNU|Clang")
 elseif(MSVC)
   target_compile_options({} PRIVATE /W4)
 endif()
-
+{}
 # Install
 install(TARGETS {} DESTINATION bin)
 )",
+                       options_.projectName, perfSources, options_.projectName,
                        options_.projectName, options_.projectName, options_.projectName,
-                       options_.projectName, options_.projectName, options_.projectName,
-                       options_.projectName);
+                       options_.projectName, perfTargets, options_.projectName);
 }
 
 std::string WebServiceTemplate::getReadmeContent() {
+    std::string perfSection;
+    if (usesPerfServer()) {
+        perfSection = fmt::format(R"(## Performance
+
+The server is tuned for sustained traffic:
+
+- Requests are served by a worker pool of four threads per hardware thread, and at least 8.
+  cpp-httplib keeps a keep-alive connection on one worker until it closes, so size the pool
+  to the number of connections you expect to be open at once.
+- A keep-alive connection serves up to 10000 requests and is closed after 5 idle seconds.
+- The `/health` and `/api/info` bodies are serialized once at startup. Dynamic endpoints
+  such as `/api/status` reuse a per-thread `JsonWriter` buffer.
+
+| Variable | Default | Meaning |
+|----------|---------|---------|
+| `WEB_WORKERS` | 4 per hardware thread, at least 8 | Worker threads |
+| `WEB_KEEPALIVE_MAX` | 10000 | Requests per keep-alive connection |
+| `WEB_KEEPALIVE_TIMEOUT` | 5 | Idle seconds before a connection is closed |
+
+### Metrics
+
+`GET /metrics` serves the Prometheus text format. It contains an
+`http_request_duration_seconds` histogram and `http_responses_total` counters per route,
+and the `http_server_workers` gauge. The histogram measures handler time; use a load
+generator for end-to-end latency.
+
+### Load Testing
+
+```bash
+# Drive a running server with wrk, or with {0}_loadgen when wrk is not installed
+scripts/load_test.sh /health 64 10
+
+# Or run the bundled load generator directly
+./build/{0}_loadgen --path /api/status --connections 128 --seconds 30
+```
+
+`scripts/load_test.sh [path] [connections] [seconds]` prints the route's server-side
+histogram from `/metrics` after the run.
+
+)",
+                                  options_.projectName);
+    }
+
     return fmt::format(R"(# {}
 
 A modern C++ web service built with cpp-httplib.
@@ -578,7 +682,7 @@ ctest
 ./tests/integration_tests
 ```
 
-## Documentation
+{}## Documentation
 
 - API documentation: `docs/api.yaml` (OpenAPI 3.0)
 - Postman collection: `docs/postman_collection.json`
@@ -587,7 +691,8 @@ ctest
 
 MIT License
 )",
-                       options_.projectName, options_.projectName, options_.projectName);
+                       options_.projectName, options_.projectName, options_.projectName,
+                       perfSection);
 }
 
 std::string WebServiceTemplate::getVcpkgJsonContent() {
@@ -962,6 +1067,19 @@ obj/
 }
 
 std::string WebServiceTemplate::getMesonContent() {
+    std::string perfSources;
+    std::string perfTargets;
+    if (usesPerfServer()) {
+        perfSources = ",\n  'src/http/json_writer.cpp',\n  'src/http/metrics.cpp'";
+        perfTargets = fmt::format(R"(
+# Load generator used by scripts/load_test.sh
+executable('{}_loadgen',
+  'tools/load_generator.cpp',
+  dependencies : [threads_dep])
+)",
+                                  options_.projectName);
+    }
+
     return fmt::format(R"(project('{}', 'cpp',
   version : '1.0.0',
   default_options : ['warning_level=3', 'cpp_std=c++17'])
@@ -978,7 +1096,7 @@ sources = [
   'src/config/config.cpp',
   'src/utils/logger.cpp',
   'src/routes/router.cpp',
-  'src/controllers/controller.cpp'
+  'src/controllers/controller.cpp'{}
 ]
 
 # Include directories
@@ -990,11 +1108,26 @@ executable('{}',
   include_directories : inc,
   dependencies : [fmt_dep, spdlog_dep, threads_dep],
   install : true)
-)",
-                       options_.projectName, options_.projectName);
+{})",
+                       options_.projectName, perfSources, options_.projectName, perfTargets);
 }
 
 std::string WebServiceTemplate::getBazelContent() {
+    std::string perfSources;
+    std::string perfTargets;
+    if (usesPerfServer()) {
+        perfSources = "\n        \"src/http/json_writer.cpp\",\n        \"src/http/metrics.cpp\",";
+        perfTargets = fmt::format(R"(
+# Load generator used by scripts/load_test.sh
+cc_binary(
+    name = "{}_loadgen",
+    srcs = ["tools/load_generator.cpp"],
+    linkopts = ["-pthread"],
+)
+)",
+                                  options_.projectName);
+    }
+
     return fmt::format(R"(load("@rules_cc//cc:defs.bzl", "cc_binary", "cc_library")
 
 cc_binary(
@@ -1016,7 +1149,7 @@ cc_library(
         "src/config/config.cpp",
         "src/utils/logger.cpp",
         "src/routes/router.cpp",
-        "src/controllers/controller.cpp",
+        "src/controllers/controller.cpp",{}
     ],
     hdrs = glob(["include/**/*.h"]),
     includes = ["include"],
@@ -1025,11 +1158,27 @@ cc_library(
         "@spdlog",
     ],
 )
-)",
-                       options_.projectName);
+{})",
+                       options_.projectName, perfSources, perfTargets);
 }
 
 std::string WebServiceTemplate::getXMakeContent() {
+    std::string perfTargets;
+    if (usesPerfServer()) {
+        perfTargets = fmt::format(R"(
+-- Load generator used by scripts/load_test.sh
+target("{}_loadgen")
+    set_kind("binary")
+    add_files("tools/load_generator.cpp")
+    set_targetdir("bin")
+    set_languages("c++17")
+    if is_plat("linux") then
+        add_syslinks("pthread")
+    end
+)",
+                                  options_.projectName);
+    }
+
     return fmt::format(R"(set_project("{0}")
 set_version("1.0.0")
 
@@ -1068,7 +1217,7 @@ target("{1}")
         set_symbols("hidden")
         set_optimize("fastest")
     end
-
+{4}
 -- Tests (if enabled)
 if has_config("tests") then
     add_requires("gtest")
@@ -1083,10 +1232,34 @@ if has_config("tests") then
 end
 )",
                        options_.projectName, options_.projectName, options_.projectName,
-                       options_.projectName);
+                       options_.projectName, perfTargets);
 }
 
 std::string WebServiceTemplate::getPremakeContent() {
+    std::string perfTargets;
+    if (usesPerfServer()) {
+        perfTargets = fmt::format(R"(
+filter {{}}
+
+-- Load generator used by scripts/load_test.sh
+project "{}_loadgen"
+    kind "ConsoleApp"
+    language "C++"
+    cppdialect "C++17"
+    targetdir "bin/%{{cfg.buildcfg}}"
+
+    files {{
+        "tools/load_generator.cpp"
+    }}
+
+    filter "system:linux"
+        links {{ "pthread" }}
+
+    filter {{}}
+)",
+                                  options_.projectName);
+    }
+
     return fmt::format(R"(workspace "{0}"
     configurations {{ "Debug", "Release" }}
     platforms {{ "x64" }}
@@ -1130,7 +1303,7 @@ project "{1}"
         defines {{ "NDEBUG", "WEBSERVICE_RELEASE" }}
         symbols "Off"
         optimize "Speed"
-
+{3}
 -- Tests project
 project "{2}_tests"
     kind "ConsoleApp"
@@ -1161,5 +1334,965 @@ project "{2}_tests"
     filter "system:linux"
         links {{ "pthread" }}
 )",
+                       options_.projectName, options_.projectName, options_.projectName,
+                       perfTargets);
+}
+
+std::string WebServiceTemplate::getPerfServerHeaderContent() {
+    return fmt::format(R"(#pragma once
+
+#include "config/config.h"
+#include "http/metrics.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace httplib {{
+class Server;
+}}
+
+namespace {} {{
+
+// Threading and connection settings of the HTTP server
+struct ServerTuning {{
+    // cpp-httplib keeps a keep-alive connection on one worker until it closes,
+    // so size the pool to the number of connections expected to be open at once.
+    // 0 picks four workers per hardware thread, and at least 8.
+    std::size_t workers = 0;
+    // Requests served on one connection before it is closed
+    std::size_t keepAliveMaxRequests = 10000;
+    // Idle time before an open connection is closed
+    int keepAliveTimeoutSeconds = 5;
+    int readTimeoutSeconds = 5;
+    int writeTimeoutSeconds = 5;
+
+    // The defaults, overridden by WEB_WORKERS, WEB_KEEPALIVE_MAX and
+    // WEB_KEEPALIVE_TIMEOUT when they are set
+    static ServerTuning fromEnvironment();
+    std::size_t resolvedWorkers() const;
+}};
+
+class Server {{
+public:
+    explicit Server(const Config& config, ServerTuning tuning = ServerTuning::fromEnvironment());
+    ~Server();
+
+    // Serves requests on the worker pool; blocks until stop() is called
+    void start();
+    void stop();
+    bool isRunning() const;
+
+    const ServerTuning& tuning() const;
+    MetricsRegistry& metrics();
+
+private:
+    void setupRoutes();
+
+    Config config_;
+    ServerTuning tuning_;
+    MetricsRegistry metrics_;
+    std::unique_ptr<httplib::Server> http_;
+    std::atomic<bool> running_{{false}};
+    std::chrono::steady_clock::time_point started_;
+    // Bodies of the static endpoints, serialized once at construction
+    std::string healthBody_;
+    std::string infoBody_;
+}};
+
+}} // namespace {}
+)",
+                       options_.projectName, options_.projectName);
+}
+
+std::string WebServiceTemplate::getPerfServerCppContent() {
+    return fmt::format(R"(#include "server.h"
+#include "http/json_writer.h"
+#include "utils/logger.h"
+#include <httplib.h>
+#include <algorithm>
+#include <cstdlib>
+#include <thread>
+#include <utility>
+
+namespace {} {{
+
+namespace {{
+
+using Clock = std::chrono::steady_clock;
+
+const char* const kJsonContentType = "application/json";
+
+std::size_t environmentOr(const char* name, std::size_t fallback) {{
+    const char* value = std::getenv(name);
+    if (value == nullptr || *value == '\0') {{
+        return fallback;
+    }}
+    char* end = nullptr;
+    unsigned long long parsed = std::strtoull(value, &end, 10);
+    return *end == '\0' ? static_cast<std::size_t>(parsed) : fallback;
+}}
+
+// Wraps a handler so that its latency and status are recorded against the route
+template <typename Handler>
+httplib::Server::Handler timed(RouteMetrics& metrics, Handler handler) {{
+    return [&metrics, handler = std::move(handler)](const httplib::Request& req,
+                                                     httplib::Response& res) {{
+        auto started = Clock::now();
+        handler(req, res);
+        // httplib fills in 200 after the handler when the status was left unset
+        metrics.observe(Clock::now() - started, res.status > 0 ? res.status : 200);
+    }};
+}}
+
+}} // namespace
+
+ServerTuning ServerTuning::fromEnvironment() {{
+    ServerTuning tuning;
+    tuning.workers = environmentOr("WEB_WORKERS", tuning.workers);
+    tuning.keepAliveMaxRequests = environmentOr("WEB_KEEPALIVE_MAX", tuning.keepAliveMaxRequests);
+    tuning.keepAliveTimeoutSeconds = static_cast<int>(environmentOr(
+        "WEB_KEEPALIVE_TIMEOUT", static_cast<std::size_t>(tuning.keepAliveTimeoutSeconds)));
+    return tuning;
+}}
+
+std::size_t ServerTuning::resolvedWorkers() const {{
+    if (workers > 0) {{
+        return workers;
+    }}
+    std::size_t threads = std::max(1u, std::thread::hardware_concurrency());
+    return std::max<std::size_t>(8, threads * 4);
+}}
+
+Server::Server(const Config& config, ServerTuning tuning)
+    : config_(config),
+      tuning_(tuning),
+      http_(std::make_unique<httplib::Server>()),
+      started_(Clock::now()) {{
+    JsonWriter json;
+    healthBody_ = json.beginObject()
+                      .field("status", "healthy")
+                      .field("service", "{}")
+                      .endObject()
+                      .take();
+    infoBody_ = json.beginObject()
+                    .field("name", "{}")
+                    .field("version", "1.0.0")
+                    .field("description", "RESTful API service")
+                    .endObject()
+                    .take();
+    setupRoutes();
+}}
+
+Server::~Server() {{
+    stop();
+}}
+
+void Server::start() {{
+    if (running_.exchange(true)) {{
+        return;
+    }}
+
+    std::size_t workers = tuning_.resolvedWorkers();
+    http_->new_task_queue = [workers]() {{ return new httplib::ThreadPool(workers); }};
+    http_->set_keep_alive_max_count(tuning_.keepAliveMaxRequests);
+    http_->set_keep_alive_timeout(tuning_.keepAliveTimeoutSeconds);
+    http_->set_read_timeout(tuning_.readTimeoutSeconds, 0);
+    http_->set_write_timeout(tuning_.writeTimeoutSeconds, 0);
+    http_->set_tcp_nodelay(true);
+
+    Logger::info("Server starting on port " + std::to_string(config_.getPort()) + " with " +
+                 std::to_string(workers) + " workers");
+
+    if (!http_->listen("0.0.0.0", config_.getPort())) {{
+        Logger::error("Failed to start server on port " + std::to_string(config_.getPort()));
+    }}
+    running_ = false;
+}}
+
+void Server::stop() {{
+    if (!running_) {{
+        return;
+    }}
+
+    http_->stop();
+    Logger::info("Server stopped");
+}}
+
+bool Server::isRunning() const {{
+    return running_;
+}}
+
+const ServerTuning& Server::tuning() const {{
+    return tuning_;
+}}
+
+MetricsRegistry& Server::metrics() {{
+    return metrics_;
+}}
+
+void Server::setupRoutes() {{
+    // CORS headers go on every response, so they are installed once
+    http_->set_default_headers({{
+        {{"Access-Control-Allow-Origin", "*"}},
+        {{"Access-Control-Allow-Methods", "GET, POST, PUT, DELETE, OPTIONS"}},
+        {{"Access-Control-Allow-Headers", "Content-Type, Authorization"}},
+    }});
+
+    http_->Get("/health", timed(metrics_.route("GET", "/health"),
+                                [this](const httplib::Request&, httplib::Response& res) {{
+                                    res.set_content(healthBody_, kJsonContentType);
+                                }}));
+
+    http_->Get("/api/info", timed(metrics_.route("GET", "/api/info"),
+                                  [this](const httplib::Request&, httplib::Response& res) {{
+                                      res.set_content(infoBody_, kJsonContentType);
+                                  }}));
+
+    // Dynamic responses reuse the worker's JSON buffer
+    http_->Get("/api/status", timed(metrics_.route("GET", "/api/status"),
+                                    [this](const httplib::Request&, httplib::Response& res) {{
+        std::chrono::duration<double> uptime = Clock::now() - started_;
+        JsonWriter& json = JsonWriter::local();
+        json.beginObject()
+            .field("service", "{}")
+            .field("uptimeSeconds", uptime.count())
+            .field("workers", tuning_.resolvedWorkers())
+            .field("requests", metrics_.requestCount())
+            .endObject();
+        res.set_content(json.str(), kJsonContentType);
+    }}));
+
+    http_->Get("/metrics", [this](const httplib::Request&, httplib::Response& res) {{
+        thread_local std::string body;
+        body.clear();
+        metrics_.renderPrometheus(body);
+        body += "# HELP http_server_workers Worker threads serving connections.\n"
+                "# TYPE http_server_workers gauge\n"
+                "http_server_workers " + std::to_string(tuning_.resolvedWorkers()) + "\n";
+        res.set_content(body, MetricsRegistry::kContentType);
+    }});
+}}
+
+}} // namespace {}
+)",
+                       options_.projectName, options_.projectName, options_.projectName,
+                       options_.projectName, options_.projectName);
+}
+
+std::string WebServiceTemplate::getJsonWriterHeaderContent() {
+    return fmt::format(R"(#pragma once
+
+#include <charconv>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace {} {{
+
+// Appends JSON to a reusable buffer. clear() keeps the capacity, so the
+// per-thread writer from local() serializes responses without allocating
+// once it has grown to the largest response.
+//
+//   JsonWriter& json = JsonWriter::local();
+//   json.beginObject().field("status", "ok").field("requests", 42).endObject();
+//   res.set_content(json.str(), "application/json");
+class JsonWriter {{
+public:
+    // The calling thread's writer, cleared
+    static JsonWriter& local();
+
+    JsonWriter& beginObject();
+    JsonWriter& endObject();
+    JsonWriter& beginArray();
+    JsonWriter& endArray();
+    JsonWriter& key(std::string_view name);
+
+    JsonWriter& value(std::string_view text);
+    JsonWriter& value(const char* text);
+    JsonWriter& value(bool flag);
+    JsonWriter& value(double number);
+    JsonWriter& null();
+
+    template <typename Integer, std::enable_if_t<std::is_integral_v<Integer> &&
+                                                     !std::is_same_v<Integer, bool>, int> = 0>
+    JsonWriter& value(Integer number) {{
+        separate();
+        char digits[24];
+        auto result = std::to_chars(digits, digits + sizeof(digits), number);
+        out_.append(digits, result.ptr);
+        return *this;
+    }}
+
+    template <typename T>
+    JsonWriter& field(std::string_view name, const T& fieldValue) {{
+        key(name);
+        return value(fieldValue);
+    }}
+
+    const std::string& str() const {{ return out_; }}
+    // Moves the document out and leaves the writer empty
+    std::string take();
+    void clear();
+
+private:
+    void open(char bracket);
+    void close(char bracket);
+    void separate();
+    void appendEscaped(std::string_view text);
+
+    std::string out_;
+    // One entry per open object or array: whether it already holds an element
+    std::vector<bool> hasElements_;
+    bool afterKey_ = false;
+}};
+
+}} // namespace {}
+)",
+                       options_.projectName, options_.projectName);
+}
+
+std::string WebServiceTemplate::getJsonWriterCppContent() {
+    return fmt::format(R"(#include "http/json_writer.h"
+
+#include <cmath>
+#include <cstdio>
+
+namespace {} {{
+
+JsonWriter& JsonWriter::local() {{
+    thread_local JsonWriter writer;
+    writer.clear();
+    return writer;
+}}
+
+JsonWriter& JsonWriter::beginObject() {{
+    open('{{');
+    return *this;
+}}
+
+JsonWriter& JsonWriter::endObject() {{
+    close('}}');
+    return *this;
+}}
+
+JsonWriter& JsonWriter::beginArray() {{
+    open('[');
+    return *this;
+}}
+
+JsonWriter& JsonWriter::endArray() {{
+    close(']');
+    return *this;
+}}
+
+JsonWriter& JsonWriter::key(std::string_view name) {{
+    separate();
+    appendEscaped(name);
+    out_ += ':';
+    afterKey_ = true;
+    return *this;
+}}
+
+JsonWriter& JsonWriter::value(std::string_view text) {{
+    separate();
+    appendEscaped(text);
+    return *this;
+}}
+
+JsonWriter& JsonWriter::value(const char* text) {{
+    return text ? value(std::string_view(text)) : null();
+}}
+
+JsonWriter& JsonWriter::value(bool flag) {{
+    separate();
+    out_ += flag ? "true" : "false";
+    return *this;
+}}
+
+JsonWriter& JsonWriter::value(double number) {{
+    // JSON has no NaN or infinity
+    if (!std::isfinite(number)) {{
+        return null();
+    }}
+    separate();
+    char digits[32];
+    int length = std::snprintf(digits, sizeof(digits), "%.15g", number);
+    out_.append(digits, static_cast<std::size_t>(length));
+    return *this;
+}}
+
+JsonWriter& JsonWriter::null() {{
+    separate();
+    out_ += "null";
+    return *this;
+}}
+
+std::string JsonWriter::take() {{
+    std::string document = std::move(out_);
+    clear();
+    return document;
+}}
+
+void JsonWriter::clear() {{
+    out_.clear();
+    hasElements_.clear();
+    afterKey_ = false;
+}}
+
+void JsonWriter::open(char bracket) {{
+    separate();
+    out_ += bracket;
+    hasElements_.push_back(false);
+}}
+
+void JsonWriter::close(char bracket) {{
+    out_ += bracket;
+    if (!hasElements_.empty()) {{
+        hasElements_.pop_back();
+    }}
+}}
+
+void JsonWriter::separate() {{
+    if (afterKey_) {{
+        afterKey_ = false;
+        return;
+    }}
+    if (hasElements_.empty()) {{
+        return;
+    }}
+    if (hasElements_.back()) {{
+        out_ += ',';
+    }}
+    hasElements_.back() = true;
+}}
+
+void JsonWriter::appendEscaped(std::string_view text) {{
+    static const char hex[] = "0123456789abcdef";
+    out_ += '"';
+    for (char c : text) {{
+        switch (c) {{
+            case '"': out_ += "\\\""; break;
+            case '\\': out_ += "\\\\"; break;
+            case '\n': out_ += "\\n"; break;
+            case '\r': out_ += "\\r"; break;
+            case '\t': out_ += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {{
+                    out_ += "\\u00";
+                    out_ += hex[(c >> 4) & 0xf];
+                    out_ += hex[c & 0xf];
+                }} else {{
+                    out_ += c;
+                }}
+        }}
+    }}
+    out_ += '"';
+}}
+
+}} // namespace {}
+)",
+                       options_.projectName, options_.projectName);
+}
+
+std::string WebServiceTemplate::getMetricsHeaderContent() {
+    return fmt::format(R"(#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+
+namespace {} {{
+
+// Request latency and status counts of one route. observe() is lock-free and
+// may be called from every worker thread at once.
+class RouteMetrics {{
+public:
+    // Upper bounds of the latency buckets; a final +Inf bucket catches the rest
+    static constexpr std::array<std::int64_t, 14> kBucketBoundsNanos = {{
+        100000,    250000,    500000,     1000000,    2500000,    5000000,    10000000,
+        25000000,  50000000,  100000000,  250000000,  500000000,  1000000000, 2500000000}};
+
+    RouteMetrics(std::string method, std::string path);
+
+    void observe(std::chrono::nanoseconds latency, int status);
+    std::uint64_t count() const;
+
+    const std::string& method() const {{ return method_; }}
+    const std::string& path() const {{ return path_; }}
+
+private:
+    friend class MetricsRegistry;
+
+    std::string method_;
+    std::string path_;
+    alignas(64) std::array<std::atomic<std::uint64_t>, kBucketBoundsNanos.size() + 1> buckets_{{}};
+    std::atomic<std::uint64_t> sumNanos_{{0}};
+    // Responses by status class, 1xx to 5xx
+    std::array<std::atomic<std::uint64_t>, 5> statusClasses_{{}};
+}};
+
+// Per-route metrics rendered in the Prometheus text exposition format
+class MetricsRegistry {{
+public:
+    static constexpr const char* kContentType = "text/plain; version=0.0.4; charset=utf-8";
+
+    // Returns the metrics of a route, registering it on first use. The reference
+    // stays valid for the lifetime of the registry, so handlers capture it once.
+    RouteMetrics& route(const std::string& method, const std::string& path);
+
+    // Requests observed across all routes
+    std::uint64_t requestCount() const;
+
+    // Appends every route's http_request_duration_seconds histogram and
+    // http_responses_total counters to out
+    void renderPrometheus(std::string& out) const;
+
+private:
+    mutable std::mutex mutex_;
+    std::deque<RouteMetrics> routes_;
+}};
+
+}} // namespace {}
+)",
+                       options_.projectName, options_.projectName);
+}
+
+std::string WebServiceTemplate::getMetricsCppContent() {
+    return fmt::format(R"(#include "http/metrics.h"
+
+#include <cstdio>
+#include <utility>
+
+namespace {} {{
+
+namespace {{
+
+void appendLabels(std::string& out, const RouteMetrics& route) {{
+    out += "{{method=\"";
+    out += route.method();
+    out += "\",route=\"";
+    for (char c : route.path()) {{
+        if (c == '"' || c == '\\') {{
+            out += '\\';
+        }}
+        out += c;
+    }}
+    out += '"';
+}}
+
+void appendNumber(std::string& out, const char* format, double number) {{
+    char digits[32];
+    int length = std::snprintf(digits, sizeof(digits), format, number);
+    out.append(digits, static_cast<std::size_t>(length));
+}}
+
+}} // namespace
+
+RouteMetrics::RouteMetrics(std::string method, std::string path)
+    : method_(std::move(method)), path_(std::move(path)) {{}}
+
+void RouteMetrics::observe(std::chrono::nanoseconds latency, int status) {{
+    std::size_t bucket = 0;
+    while (bucket < kBucketBoundsNanos.size() && latency.count() > kBucketBoundsNanos[bucket]) {{
+        ++bucket;
+    }}
+    buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+    sumNanos_.fetch_add(static_cast<std::uint64_t>(latency.count()), std::memory_order_relaxed);
+    if (status >= 100 && status < 600) {{
+        statusClasses_[static_cast<std::size_t>(status / 100 - 1)].fetch_add(
+            1, std::memory_order_relaxed);
+    }}
+}}
+
+std::uint64_t RouteMetrics::count() const {{
+    std::uint64_t total = 0;
+    for (const auto& bucket : buckets_) {{
+        total += bucket.load(std::memory_order_relaxed);
+    }}
+    return total;
+}}
+
+RouteMetrics& MetricsRegistry::route(const std::string& method, const std::string& path) {{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& route : routes_) {{
+        if (route.method() == method && route.path() == path) {{
+            return route;
+        }}
+    }}
+    return routes_.emplace_back(method, path);
+}}
+
+std::uint64_t MetricsRegistry::requestCount() const {{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::uint64_t total = 0;
+    for (const auto& route : routes_) {{
+        total += route.count();
+    }}
+    return total;
+}}
+
+void MetricsRegistry::renderPrometheus(std::string& out) const {{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    out += "# HELP http_request_duration_seconds Time spent handling a request.\n"
+           "# TYPE http_request_duration_seconds histogram\n";
+    for (const auto& route : routes_) {{
+        // The count is derived from the buckets so that it always equals the +Inf bucket
+        std::uint64_t cumulative = 0;
+        for (std::size_t i = 0; i < route.buckets_.size(); ++i) {{
+            cumulative += route.buckets_[i].load(std::memory_order_relaxed);
+            out += "http_request_duration_seconds_bucket";
+            appendLabels(out, route);
+            out += ",le=\"";
+            if (i < RouteMetrics::kBucketBoundsNanos.size()) {{
+                double bound = static_cast<double>(RouteMetrics::kBucketBoundsNanos[i]) / 1e9;
+                appendNumber(out, "%g", bound);
+            }} else {{
+                out += "+Inf";
+            }}
+            out += "\"}} " + std::to_string(cumulative) + "\n";
+        }}
+        out += "http_request_duration_seconds_sum";
+        appendLabels(out, route);
+        out += "}} ";
+        appendNumber(out, "%.9g",
+                     static_cast<double>(route.sumNanos_.load(std::memory_order_relaxed)) / 1e9);
+        out += "\nhttp_request_duration_seconds_count";
+        appendLabels(out, route);
+        out += "}} " + std::to_string(cumulative) + "\n";
+    }}
+
+    out += "# HELP http_responses_total Responses sent, by status class.\n"
+           "# TYPE http_responses_total counter\n";
+    for (const auto& route : routes_) {{
+        for (std::size_t i = 0; i < route.statusClasses_.size(); ++i) {{
+            std::uint64_t responses = route.statusClasses_[i].load(std::memory_order_relaxed);
+            if (responses == 0) {{
+                continue;
+            }}
+            out += "http_responses_total";
+            appendLabels(out, route);
+            out += ",code=\"" + std::to_string(i + 1) + "xx\"}} ";
+            out += std::to_string(responses) + "\n";
+        }}
+    }}
+}}
+
+}} // namespace {}
+)",
+                       options_.projectName, options_.projectName);
+}
+
+std::string WebServiceTemplate::getLoadGeneratorContent() {
+    return fmt::format(R"(// Closed-loop HTTP load generator for the {} service, in the spirit of
+// wrk. Every connection runs on its own thread, sends a keep-alive GET, reads
+// the whole response and sends the next request.
+//   {}_loadgen [--host H] [--port P] [--path /health] [--connections N] [--seconds S]
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+namespace {{
+
+using Clock = std::chrono::steady_clock;
+
+struct LoadOptions {{
+    std::string host = "127.0.0.1";
+    std::string port = "8080";
+    std::string path = "/health";
+    std::size_t connections = 64;
+    std::chrono::seconds duration{{10}};
+}};
+
+struct ConnectionStats {{
+    std::uint64_t requests = 0;
+    std::uint64_t bytes = 0;
+    std::uint64_t non2xx = 0;
+    std::uint64_t errors = 0;
+    std::vector<std::uint32_t> latenciesUs;
+}};
+
+#ifndef _WIN32
+
+int connectTo(const LoadOptions& options) {{
+    addrinfo hints{{}};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* addresses = nullptr;
+    if (getaddrinfo(options.host.c_str(), options.port.c_str(), &hints, &addresses) != 0) {{
+        return -1;
+    }}
+    int fd = -1;
+    for (addrinfo* address = addresses; address != nullptr; address = address->ai_next) {{
+        fd = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+        if (fd < 0) {{
+            continue;
+        }}
+        if (connect(fd, address->ai_addr, address->ai_addrlen) == 0) {{
+            break;
+        }}
+        close(fd);
+        fd = -1;
+    }}
+    freeaddrinfo(addresses);
+    if (fd >= 0) {{
+        int noDelay = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+        timeval timeout{{5, 0}};
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    }}
+    return fd;
+}}
+
+bool sendAll(int fd, const std::string& data) {{
+    std::size_t sent = 0;
+    while (sent < data.size()) {{
+        ssize_t written = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (written <= 0) {{
+            return false;
+        }}
+        sent += static_cast<std::size_t>(written);
+    }}
+    return true;
+}}
+
+// Case-insensitive lookup of a header value in the response head
+std::string headerValue(const std::string& head, const char* name) {{
+    std::size_t nameLength = std::strlen(name);
+    std::size_t line = head.find("\r\n");
+    while (line != std::string::npos && line + 2 < head.size()) {{
+        std::size_t start = line + 2;
+        std::size_t end = head.find("\r\n", start);
+        if (end == std::string::npos) {{
+            end = head.size();
+        }}
+        if (end - start > nameLength && head[start + nameLength] == ':' &&
+            std::equal(name, name + nameLength, head.begin() + static_cast<std::ptrdiff_t>(start),
+                       [](char a, char b) {{ return std::tolower(a) == std::tolower(b); }})) {{
+            std::size_t value = head.find_first_not_of(' ', start + nameLength + 1);
+            return head.substr(value, end - value);
+        }}
+        line = end;
+    }}
+    return {{}};
+}}
+
+// Reads one response with a Content-Length body; buffer carries bytes over
+// between calls. Returns the status code, or 0 when the connection is unusable.
+int readResponse(int fd, std::string& buffer, std::uint64_t& bytes, bool& keepAlive) {{
+    char chunk[16 * 1024];
+    std::size_t headEnd;
+    while ((headEnd = buffer.find("\r\n\r\n")) == std::string::npos) {{
+        ssize_t received = recv(fd, chunk, sizeof(chunk), 0);
+        if (received <= 0) {{
+            return 0;
+        }}
+        buffer.append(chunk, static_cast<std::size_t>(received));
+    }}
+    std::string head = buffer.substr(0, headEnd);
+    std::string length = headerValue(head, "content-length");
+    if (head.compare(0, 5, "HTTP/") != 0 || length.empty()) {{
+        return 0;
+    }}
+    std::size_t total = headEnd + 4 + std::strtoul(length.c_str(), nullptr, 10);
+    while (buffer.size() < total) {{
+        ssize_t received = recv(fd, chunk, sizeof(chunk), 0);
+        if (received <= 0) {{
+            return 0;
+        }}
+        buffer.append(chunk, static_cast<std::size_t>(received));
+    }}
+    std::string connection = headerValue(head, "connection");
+    keepAlive = connection != "close" && connection != "Close";
+    bytes += total;
+    buffer.erase(0, total);
+    return std::atoi(head.c_str() + head.find(' ') + 1);
+}}
+
+void runConnection(const LoadOptions& options, Clock::time_point deadline,
+                   ConnectionStats& stats) {{
+    const std::string request = "GET " + options.path + " HTTP/1.1\r\nHost: " + options.host +
+                                "\r\nConnection: keep-alive\r\n\r\n";
+    std::string buffer;
+    int fd = -1;
+    while (Clock::now() < deadline) {{
+        if (fd < 0) {{
+            buffer.clear();
+            fd = connectTo(options);
+            if (fd < 0) {{
+                ++stats.errors;
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                continue;
+            }}
+        }}
+        auto sent = Clock::now();
+        bool keepAlive = true;
+        int status = sendAll(fd, request) ? readResponse(fd, buffer, stats.bytes, keepAlive) : 0;
+        if (status == 0) {{
+            ++stats.errors;
+            close(fd);
+            fd = -1;
+            continue;
+        }}
+        stats.latenciesUs.push_back(static_cast<std::uint32_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - sent).count()));
+        ++stats.requests;
+        if (status < 200 || status >= 300) {{
+            ++stats.non2xx;
+        }}
+        if (!keepAlive) {{
+            close(fd);
+            fd = -1;
+        }}
+    }}
+    if (fd >= 0) {{
+        close(fd);
+    }}
+}}
+
+#endif
+
+std::uint32_t percentile(const std::vector<std::uint32_t>& sorted, double p) {{
+    if (sorted.empty()) return 0;
+    return sorted[static_cast<std::size_t>(p / 100.0 * static_cast<double>(sorted.size() - 1))];
+}}
+
+}} // namespace
+
+int main(int argc, char* argv[]) {{
+    LoadOptions options;
+    for (int i = 1; i + 1 < argc; i += 2) {{
+        const char* value = argv[i + 1];
+        if (std::strcmp(argv[i], "--host") == 0) {{
+            options.host = value;
+        }} else if (std::strcmp(argv[i], "--port") == 0) {{
+            options.port = value;
+        }} else if (std::strcmp(argv[i], "--path") == 0) {{
+            options.path = value;
+        }} else if (std::strcmp(argv[i], "--connections") == 0) {{
+            options.connections = std::max<std::size_t>(1, std::strtoul(value, nullptr, 10));
+        }} else if (std::strcmp(argv[i], "--seconds") == 0) {{
+            options.duration = std::chrono::seconds(std::max(1, std::atoi(value)));
+        }} else {{
+            std::cerr << "Unknown option: " << argv[i] << std::endl;
+            return 1;
+        }}
+    }}
+
+#ifdef _WIN32
+    std::cerr << "The load generator uses POSIX sockets; run scripts/load_test.sh with wrk instead"
+              << std::endl;
+    return 1;
+#else
+    std::cout << "Loading http://" << options.host << ":" << options.port << options.path
+              << " with " << options.connections << " connections for "
+              << options.duration.count() << "s" << std::endl;
+
+    std::vector<ConnectionStats> stats(options.connections);
+    std::vector<std::thread> threads;
+    auto started = Clock::now();
+    auto deadline = started + options.duration;
+    for (auto& connection : stats) {{
+        threads.emplace_back(runConnection, std::cref(options), deadline, std::ref(connection));
+    }}
+    for (auto& thread : threads) {{
+        thread.join();
+    }}
+    double seconds = std::chrono::duration<double>(Clock::now() - started).count();
+
+    ConnectionStats total;
+    for (auto& connection : stats) {{
+        total.requests += connection.requests;
+        total.bytes += connection.bytes;
+        total.non2xx += connection.non2xx;
+        total.errors += connection.errors;
+        total.latenciesUs.insert(total.latenciesUs.end(), connection.latenciesUs.begin(),
+                                 connection.latenciesUs.end());
+    }}
+    std::sort(total.latenciesUs.begin(), total.latenciesUs.end());
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "requests    " << total.requests << " (" << total.requests / seconds << " req/s)\n"
+              << "transfer    " << static_cast<double>(total.bytes) / seconds / (1024 * 1024)
+              << " MiB/s\n"
+              << "latency us  p50 " << percentile(total.latenciesUs, 50) << "  p90 "
+              << percentile(total.latenciesUs, 90) << "  p99 " << percentile(total.latenciesUs, 99)
+              << "  max " << percentile(total.latenciesUs, 100) << "\n"
+              << "non-2xx     " << total.non2xx << "\n"
+              << "errors      " << total.errors << std::endl;
+    return total.requests > 0 ? 0 : 1;
+#endif
+}}
+)",
+                       options_.projectName, options_.projectName);
+}
+
+std::string WebServiceTemplate::getLoadTestContent() {
+    return fmt::format(R"(#!/usr/bin/env bash
+# Local load test for the {} service. Drives a running server with wrk when
+# it is installed and with the bundled {}_loadgen otherwise, then prints the
+# server-side latency histogram of the route from /metrics.
+#   scripts/load_test.sh [path] [connections] [seconds]
+# HOST, PORT and LOADGEN (the {}_loadgen binary) can be set in the environment.
+set -euo pipefail
+
+ROUTE="${{1:-/health}}"
+CONNECTIONS="${{2:-64}}"
+DURATION="${{3:-10}}"
+HOST="${{HOST:-127.0.0.1}}"
+PORT="${{PORT:-8080}}"
+LOADGEN="${{LOADGEN:-build/{}_loadgen}}"
+URL="http://${{HOST}}:${{PORT}}"
+
+if ! curl -fsS "${{URL}}/health" > /dev/null; then
+    echo "No server is answering on ${{URL}}; start {} first" >&2
+    exit 1
+fi
+
+if command -v wrk > /dev/null 2>&1; then
+    THREADS=$(nproc 2> /dev/null || echo 4)
+    if [ "${{THREADS}}" -gt "${{CONNECTIONS}}" ]; then
+        THREADS="${{CONNECTIONS}}"
+    fi
+    wrk -t"${{THREADS}}" -c"${{CONNECTIONS}}" -d"${{DURATION}}s" --latency "${{URL}}${{ROUTE}}"
+elif [ -x "${{LOADGEN}}" ]; then
+    "${{LOADGEN}}" --host "${{HOST}}" --port "${{PORT}}" --path "${{ROUTE}}" \
+        --connections "${{CONNECTIONS}}" --seconds "${{DURATION}}"
+else
+    echo "Neither wrk nor ${{LOADGEN}} was found; build the {}_loadgen target or set LOADGEN" >&2
+    exit 1
+fi
+
+echo
+echo "Server-side latency of GET ${{ROUTE}}:"
+curl -fsS "${{URL}}/metrics" | grep -F "route=\"${{ROUTE}}\"" || true
+)",
+                       options_.projectName, options_.projectName, options_.projectName,
                        options_.projectName, options_.projectName, options_.projectName);
 }
@@ -16,6 +16,7 @@ class WebServiceTemplate : public TemplateBase {
     bool setupAPIDocumentation();
     bool setupLogging();
     bool setupDatabase();
+    bool createPerformanceFiles();
 
    private:
     // Core application files
@@ -65,6 +66,15 @@ class WebServiceTemplate : public TemplateBase {
     std::string getIntegrationTestContent();
     std::string getLoadTestContent();
 
+    // Tuned server (--web-perf)
+    std::string getPerfServerHeaderContent();
+    std::string getPerfServerCppContent();
+    std::string getJsonWriterHeaderContent();
+    std::string getJsonWriterCppContent();
+    std::string getMetricsHeaderContent();
+    std::string getMetricsCppContent();
+    std::string getLoadGeneratorContent();
+
     // Configuration files
     std::string getConfigJsonContent();
     std::string getEnvironmentContent();
@@ -78,4 +88,5 @@ class WebServiceTemplate : public TemplateBase {
     std::string getDatabaseType() const;
     bool isRestAPI() const;
     bool isGraphQL() const;
+    bool usesPerfServer() const;
 };
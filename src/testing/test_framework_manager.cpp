@@ -728,9 +728,8 @@ namespace test_utils {
         // Check CMakeLists.txt for framework references
         auto cmakeFile = projectPath / "CMakeLists.txt";
         if (std::filesystem::exists(cmakeFile)) {
-            std::ifstream file(cmakeFile);
-            std::string content((std::istreambuf_iterator<char>(file)),
-                               std::istreambuf_iterator<char>());
+            auto file = utils::MappedFile::open(cmakeFile);
+            std::string_view content = file.value.view();
 
             if (content.find("GTest") != std::string::npos ||
                 content.find("gtest") != std::string::npos) {
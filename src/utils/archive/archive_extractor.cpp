@@ -0,0 +1,963 @@
+#include "../archive/archive_extractor.h"
+#include "../core/copy_engine.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+
+#ifdef CPP_SCAFFOLD_HAS_ZLIB
+#include <zlib.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace utils {
+
+namespace {
+
+using Status = StreamingArchiveExtractor::Status;
+using Options = StreamingArchiveExtractor::Options;
+using Outcome = StreamingArchiveExtractor::Outcome;
+
+constexpr size_t CHUNK_SIZE = 64 * 1024;
+constexpr size_t TAR_BLOCK = 512;
+// Upper bound for in-memory metadata: long names, pax headers, symlink targets
+constexpr uint64_t MAX_METADATA_SIZE = 1 << 20;
+
+// Thrown internally to abort extraction with the status to report
+struct ExtractError {
+    Status status;
+    std::string message;
+};
+
+[[noreturn]] void fail(const std::string& message) {
+    throw ExtractError{Status::Failed, message};
+}
+
+[[noreturn]] void unsupported(const std::string& message) {
+    throw ExtractError{Status::Unsupported, message};
+}
+
+struct FileCloser {
+    void operator()(std::FILE* file) const {
+        if (file) {
+            std::fclose(file);
+        }
+    }
+};
+using FilePtr = std::unique_ptr<std::FILE, FileCloser>;
+
+FilePtr openFile(const fs::path& path, bool forWriting) {
+#ifdef _WIN32
+    return FilePtr(_wfopen(path.c_str(), forWriting ? L"wb" : L"rb"));
+#else
+    return FilePtr(std::fopen(path.c_str(), forWriting ? "wb" : "rb"));
+#endif
+}
+
+bool seekTo(std::FILE* file, uint64_t offset) {
+#ifdef _WIN32
+    return _fseeki64(file, static_cast<long long>(offset), SEEK_SET) == 0;
+#else
+    return fseeko(file, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+}
+
+void readAt(std::FILE* file, uint64_t offset, char* data, size_t size) {
+    if (!seekTo(file, offset) || std::fread(data, 1, size, file) != size) {
+        fail("Unexpected end of archive");
+    }
+}
+
+uint16_t readLE16(const char* data) {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(data);
+    return static_cast<uint16_t>(bytes[0] | (bytes[1] << 8));
+}
+
+uint32_t readLE32(const char* data) {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(data);
+    return static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8) |
+           (static_cast<uint32_t>(bytes[2]) << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+}
+
+uint64_t readLE64(const char* data) {
+    return static_cast<uint64_t>(readLE32(data)) |
+           (static_cast<uint64_t>(readLE32(data + 4)) << 32);
+}
+
+// Reports archive bytes consumed, at most once per chunk
+class Progress {
+public:
+    Progress(const ArchiveUtils::ProgressCallback& callback, uint64_t total)
+        : callback_(callback), total_(total) {}
+
+    void update(uint64_t consumed) {
+        if (!callback_ || (consumed - reported_ < CHUNK_SIZE && consumed != total_)) {
+            return;
+        }
+        reported_ = consumed;
+        if (!callback_(static_cast<size_t>(consumed), static_cast<size_t>(total_))) {
+            throw ExtractError{Status::Cancelled, "Extraction cancelled"};
+        }
+    }
+
+private:
+    const ArchiveUtils::ProgressCallback& callback_;
+    uint64_t total_;
+    uint64_t reported_ = 0;
+};
+
+// Applies prefix stripping and path checks, and writes entries to disk
+class EntrySink {
+public:
+    EntrySink(const Options& options, Outcome& outcome)
+        : outcome_(outcome), dryRun_(options.targetPath.empty()),
+          root_(dryRun_ ? fs::path(".") : options.targetPath.lexically_normal()),
+          prefix_(ArchiveUtils::sanitizePath(options.stripPrefix)),
+          autoRoot_(options.stripSingleRoot && options.stripPrefix.empty() ? AutoRoot::Undecided
+                                                                           : AutoRoot::Off) {
+        if (!prefix_.empty() && prefix_.back() != '/') {
+            prefix_ += '/';
+        }
+    }
+
+    // Fixes the stripped prefix up front, when the whole entry list is known
+    void setStripPrefix(const std::string& prefix) {
+        prefix_ = prefix;
+        autoRoot_ = AutoRoot::Off;
+    }
+
+    void directory(const std::string& rawName) {
+        auto relative = map(rawName, true);
+        if (!relative) {
+            return;
+        }
+        recordTopLevel(*relative);
+        if (!dryRun_) {
+            rejectSymlinkComponents(*relative, true, rawName);
+            fs::create_directories(root_ / *relative);
+        }
+    }
+
+    // Returns false when the entry is skipped; its data must then be discarded
+    bool beginFile(const std::string& rawName, uint32_t mode) {
+        auto relative = map(rawName, false);
+        if (!relative) {
+            return false;
+        }
+        recordTopLevel(*relative);
+        outcome_.files.push_back(*relative);
+        if (dryRun_) {
+            return true;
+        }
+
+        fs::path path = root_ / *relative;
+        rejectSymlinkComponents(*relative, false, rawName);
+        prepareLeaf(path);
+        out_ = openFile(path, true);
+        if (!out_) {
+            fail("Cannot create " + path.string());
+        }
+        currentPath_ = path;
+        currentMode_ = mode;
+        return true;
+    }
+
+    void write(const char* data, size_t size) {
+        outcome_.totalBytes += size;
+        if (out_ && std::fwrite(data, 1, size, out_.get()) != size) {
+            fail("Failed to write " + currentPath_.string());
+        }
+    }
+
+    void endFile() {
+        if (!out_) {
+            return;
+        }
+        bool ok = std::fflush(out_.get()) == 0;
+        out_.reset();
+        if (!ok) {
+            fail("Failed to write " + currentPath_.string());
+        }
+        // Only the executable bits are carried over; the rest follows the umask
+        if (currentMode_ & 0111) {
+            std::error_code ec;
+            fs::permissions(currentPath_,
+                            fs::perms::owner_exec | fs::perms::group_exec | fs::perms::others_exec,
+                            fs::perm_options::add, ec);
+        }
+    }
+
+    void symlink(const std::string& rawName, const std::string& target) {
+        auto relative = map(rawName, false);
+        if (!relative) {
+            return;
+        }
+        // The link must resolve inside the target as well, or later entries
+        // could be written through it
+        fs::path resolved = fs::path(*relative).parent_path() / target;
+        if (target.empty() || fs::path(target).is_absolute() ||
+            !ArchiveUtils::isSafePath(resolved.generic_string(), root_)) {
+            fail("Archive contains a symbolic link pointing outside the target: " + rawName);
+        }
+        recordTopLevel(*relative);
+        outcome_.files.push_back(*relative);
+        if (dryRun_) {
+            return;
+        }
+#ifdef _WIN32
+        spdlog::warn("Skipping symbolic link {} (not supported on this platform)", *relative);
+#else
+        rejectSymlinkComponents(*relative, false, rawName);
+        // The lexical check above cannot see links the target passes through,
+        // such as a/b -> .. followed by c -> a/b/..
+        fs::path path = root_ / *relative;
+        if (!isWithinRoot(path.parent_path() / target)) {
+            fail("Archive contains a symbolic link pointing outside the target: " + rawName);
+        }
+        prepareLeaf(path);
+        fs::create_symlink(target, path);
+#endif
+    }
+
+    void hardlink(const std::string& rawName, const std::string& linkTarget) {
+        auto relative = map(rawName, false);
+        auto source = map(linkTarget, false);
+        if (!relative || !source) {
+            return;
+        }
+        recordTopLevel(*relative);
+        outcome_.files.push_back(*relative);
+        if (dryRun_) {
+            return;
+        }
+        rejectSymlinkComponents(*relative, false, rawName);
+        rejectSymlinkComponents(*source, true, rawName);
+        fs::path path = root_ / *relative;
+        prepareLeaf(path);
+        // Hard link entries become independent files, cloned where the filesystem allows
+        CopyMethod method;
+        std::string error;
+        if (!CopyEngine().copyFile(root_ / *source, path, method, error)) {
+            fail(error);
+        }
+    }
+
+private:
+    enum class AutoRoot { Undecided, Active, Off };
+
+    // Target-relative name for an entry, or nullopt if it is skipped
+    std::optional<std::string> map(const std::string& rawName, bool isDirectory) {
+        std::string name = ArchiveUtils::sanitizePath(rawName);
+        if (isDirectory && !name.empty() && name.back() != '/') {
+            name += '/';
+        }
+        if (name.empty() || name == "./") {
+            return std::nullopt;
+        }
+
+        if (autoRoot_ == AutoRoot::Undecided) {
+            size_t slash = name.find('/');
+            if (slash != std::string::npos) {
+                prefix_ = name.substr(0, slash + 1);
+                autoRoot_ = AutoRoot::Active;
+            } else {
+                autoRoot_ = AutoRoot::Off;
+            }
+        } else if (autoRoot_ == AutoRoot::Active && name.compare(0, prefix_.size(), prefix_) != 0) {
+            abandonAutoRoot();
+        }
+
+        if (!prefix_.empty()) {
+            if (name.compare(0, prefix_.size(), prefix_) != 0) {
+                return std::nullopt;  // Outside the requested prefix
+            }
+            name.erase(0, prefix_.size());
+        }
+        while (!name.empty() && name.back() == '/') {
+            name.pop_back();
+        }
+        if (name.empty()) {
+            return std::nullopt;  // The stripped directory itself
+        }
+
+        if (!ArchiveUtils::isSafePath(name, root_)) {
+            fail("Archive entry escapes the target directory: " + rawName);
+        }
+        return fs::path(name).lexically_normal().generic_string();
+    }
+
+    // A later entry is not under the guessed root after all: move what was
+    // already extracted back under that directory and stop stripping
+    void abandonAutoRoot() {
+        std::string dirName = prefix_.substr(0, prefix_.size() - 1);
+        spdlog::debug("Archive has no single root directory, keeping '{}'", dirName);
+        if (!dryRun_) {
+            fs::create_directories(root_ / dirName);
+            for (const auto& name : topLevel_) {
+                fs::rename(root_ / name, root_ / dirName / name);
+            }
+        }
+        for (auto& file : outcome_.files) {
+            file = prefix_ + file;
+        }
+        topLevel_ = {dirName};
+        prefix_.clear();
+        autoRoot_ = AutoRoot::Off;
+    }
+
+    void recordTopLevel(const std::string& relative) {
+        topLevel_.insert(relative.substr(0, relative.find('/')));
+    }
+
+    // Refuses entries reached through a symbolic link already on disk: a link
+    // the archive created earlier could otherwise redirect the write, or a
+    // hard link's source, outside the target. Components that do not exist
+    // yet are created as plain directories.
+    void rejectSymlinkComponents(const std::string& relative, bool includeLeaf,
+                                 const std::string& rawName) {
+        fs::path entry(relative);
+        fs::path current = root_;
+        auto end = includeLeaf ? entry.end() : std::prev(entry.end());
+        for (auto it = entry.begin(); it != end; ++it) {
+            current /= *it;
+            std::error_code ec;
+            auto status = fs::symlink_status(current, ec);
+            if (ec || !fs::exists(status)) {
+                return;
+            }
+            if (fs::is_symlink(status)) {
+                fail("Archive entry passes through a symbolic link: " + rawName);
+            }
+        }
+    }
+
+    // Resolves existing links physically and checks the result stays inside the target
+    bool isWithinRoot(const fs::path& path) const {
+        std::error_code ec;
+        fs::path base = fs::weakly_canonical(root_, ec);
+        if (ec) {
+            return false;
+        }
+        fs::path resolved = fs::weakly_canonical(path, ec);
+        if (ec) {
+            return false;
+        }
+        fs::path relative = resolved.lexically_relative(base);
+        return !relative.empty() && *relative.begin() != "..";
+    }
+
+    // Never write through whatever already sits at the destination
+    void prepareLeaf(const fs::path& path) {
+        fs::create_directories(path.parent_path());
+        std::error_code ec;
+        auto status = fs::symlink_status(path, ec);
+        if (!ec && fs::exists(status) && !fs::is_directory(status)) {
+            fs::remove(path);
+        }
+    }
+
+    Outcome& outcome_;
+    bool dryRun_;
+    fs::path root_;
+    std::string prefix_;
+    AutoRoot autoRoot_;
+    std::set<std::string> topLevel_;
+    FilePtr out_;
+    fs::path currentPath_;
+    uint32_t currentMode_ = 0;
+};
+
+// ---------------------------------------------------------------------------
+// tar and tar.gz
+
+// Sequential tar input, inflating gzip on the fly when needed
+class TarInput {
+public:
+    TarInput(std::FILE* file, bool gzip, Progress& progress)
+        : file_(file), gzip_(gzip), progress_(progress), buffer_(CHUNK_SIZE) {
+#ifdef CPP_SCAFFOLD_HAS_ZLIB
+        if (gzip_) {
+            if (inflateInit2(&stream_, 15 + 16) != Z_OK) {
+                fail("Failed to initialize gzip decompression");
+            }
+            streamReady_ = true;
+        }
+#else
+        if (gzip_) {
+            unsupported("Built without zlib");
+        }
+#endif
+    }
+
+    ~TarInput() {
+#ifdef CPP_SCAFFOLD_HAS_ZLIB
+        if (streamReady_) {
+            inflateEnd(&stream_);
+        }
+#endif
+    }
+
+    TarInput(const TarInput&) = delete;
+    TarInput& operator=(const TarInput&) = delete;
+
+    // Reads up to size bytes; fewer only at the end of the archive
+    size_t read(char* data, size_t size) {
+        if (!gzip_) {
+            size_t n = std::fread(data, 1, size, file_);
+            consumed_ += n;
+            progress_.update(consumed_);
+            return n;
+        }
+#ifdef CPP_SCAFFOLD_HAS_ZLIB
+        stream_.next_out = reinterpret_cast<Bytef*>(data);
+        stream_.avail_out = static_cast<uInt>(size);
+        while (stream_.avail_out > 0) {
+            if (stream_.avail_in == 0) {
+                size_t n = std::fread(buffer_.data(), 1, buffer_.size(), file_);
+                consumed_ += n;
+                progress_.update(consumed_);
+                if (n == 0) {
+                    break;
+                }
+                stream_.next_in = reinterpret_cast<Bytef*>(buffer_.data());
+                stream_.avail_in = static_cast<uInt>(n);
+            }
+            int rc = inflate(&stream_, Z_NO_FLUSH);
+            if (rc == Z_STREAM_END) {
+                // Concatenated gzip members continue the same tar stream
+                inflateReset(&stream_);
+            } else if (rc != Z_OK && rc != Z_BUF_ERROR) {
+                fail(std::string("Corrupt gzip data: ") + (stream_.msg ? stream_.msg : "unknown"));
+            }
+        }
+        return size - stream_.avail_out;
+#else
+        return 0;
+#endif
+    }
+
+    void readExact(char* data, size_t size) {
+        if (read(data, size) != size) {
+            fail("Unexpected end of archive");
+        }
+    }
+
+    void skip(uint64_t size) {
+        if (size == 0) {
+            return;
+        }
+        if (!gzip_) {
+            // Plain tar: seek past the data instead of reading it
+            if (!seekTo(file_, consumed_ + size)) {
+                fail("Unexpected end of archive");
+            }
+            consumed_ += size;
+            progress_.update(consumed_);
+            return;
+        }
+        while (size > 0) {
+            size_t step = static_cast<size_t>(std::min<uint64_t>(size, scratch_.size()));
+            readExact(scratch_.data(), step);
+            size -= step;
+        }
+    }
+
+private:
+    std::FILE* file_;
+    bool gzip_;
+    Progress& progress_;
+    std::vector<char> buffer_;
+    std::array<char, 4096> scratch_{};
+    uint64_t consumed_ = 0;
+#ifdef CPP_SCAFFOLD_HAS_ZLIB
+    z_stream stream_{};
+    bool streamReady_ = false;
+#endif
+};
+
+// Numeric header fields are octal text, or base-256 when the top bit is set
+uint64_t parseTarNumber(const char* field, size_t length) {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(field);
+    if (bytes[0] & 0x80) {
+        uint64_t value = bytes[0] & 0x7F;
+        for (size_t i = 1; i < length; ++i) {
+            value = (value << 8) | bytes[i];
+        }
+        return value;
+    }
+    uint64_t value = 0;
+    size_t i = 0;
+    while (i < length && (field[i] == ' ' || field[i] == '\0')) {
+        ++i;
+    }
+    for (; i < length && field[i] >= '0' && field[i] <= '7'; ++i) {
+        value = value * 8 + static_cast<uint64_t>(field[i] - '0');
+    }
+    return value;
+}
+
+std::string tarString(const char* field, size_t length) {
+    return std::string(field, strnlen(field, length));
+}
+
+bool verifyTarChecksum(const std::array<char, TAR_BLOCK>& block) {
+    uint64_t expected = parseTarNumber(block.data() + 148, 8);
+    uint64_t sum = 0;
+    for (size_t i = 0; i < TAR_BLOCK; ++i) {
+        sum += (i >= 148 && i < 156) ? ' ' : static_cast<unsigned char>(block[i]);
+    }
+    return sum == expected;
+}
+
+// Records are "<length> <key>=<value>\n"
+std::map<std::string, std::string> parsePaxHeaders(const std::string& data) {
+    std::map<std::string, std::string> headers;
+    size_t pos = 0;
+    while (pos < data.size()) {
+        size_t space = data.find(' ', pos);
+        if (space == std::string::npos) {
+            break;
+        }
+        size_t length = std::strtoull(data.c_str() + pos, nullptr, 10);
+        if (length == 0 || pos + length > data.size()) {
+            break;
+        }
+        std::string record = data.substr(space + 1, pos + length - space - 2);
+        size_t eq = record.find('=');
+        if (eq != std::string::npos) {
+            headers[record.substr(0, eq)] = record.substr(eq + 1);
+        }
+        pos += length;
+    }
+    return headers;
+}
+
+void extractTar(std::FILE* file, bool gzip, Progress& progress, EntrySink& sink) {
+    TarInput input(file, gzip, progress);
+    std::array<char, TAR_BLOCK> block{};
+    std::vector<char> chunk(CHUNK_SIZE);
+    std::string longName;
+    std::string longLink;
+    std::map<std::string, std::string> pax;
+
+    auto readMetadata = [&](uint64_t size) {
+        if (size > MAX_METADATA_SIZE) {
+            fail("Oversized tar metadata entry");
+        }
+        std::string data(static_cast<size_t>(size), '\0');
+        input.readExact(data.data(), data.size());
+        input.skip((TAR_BLOCK - size % TAR_BLOCK) % TAR_BLOCK);
+        return data;
+    };
+
+    while (true) {
+        size_t got = input.read(block.data(), block.size());
+        if (got == 0) {
+            break;  // Tolerate archives without the end-of-archive blocks
+        }
+        if (got != block.size()) {
+            fail("Unexpected end of archive");
+        }
+        if (std::all_of(block.begin(), block.end(), [](char c) { return c == '\0'; })) {
+            break;
+        }
+        if (!verifyTarChecksum(block)) {
+            fail("Corrupt tar header");
+        }
+
+        char type = block[156];
+        uint64_t size = parseTarNumber(block.data() + 124, 12);
+        if (auto it = pax.find("size"); it != pax.end()) {
+            size = std::strtoull(it->second.c_str(), nullptr, 10);
+        }
+        uint64_t padding = (TAR_BLOCK - size % TAR_BLOCK) % TAR_BLOCK;
+
+        std::string name;
+        if (auto it = pax.find("path"); it != pax.end()) {
+            name = it->second;
+        } else if (!longName.empty()) {
+            name = longName;
+        } else {
+            name = tarString(block.data(), 100);
+            std::string prefix = tarString(block.data() + 345, 155);
+            if (std::memcmp(block.data() + 257, "ustar", 5) == 0 && !prefix.empty()) {
+                name = prefix + "/" + name;
+            }
+        }
+        std::string linkName;
+        if (auto it = pax.find("linkpath"); it != pax.end()) {
+            linkName = it->second;
+        } else if (!longLink.empty()) {
+            linkName = longLink;
+        } else {
+            linkName = tarString(block.data() + 157, 100);
+        }
+        uint32_t mode = static_cast<uint32_t>(parseTarNumber(block.data() + 100, 8));
+
+        switch (type) {
+            case 'L':
+                longName = readMetadata(size);
+                longName.resize(strnlen(longName.c_str(), longName.size()));
+                continue;
+            case 'K':
+                longLink = readMetadata(size);
+                longLink.resize(strnlen(longLink.c_str(), longLink.size()));
+                continue;
+            case 'x':
+                pax = parsePaxHeaders(readMetadata(size));
+                continue;
+            case '0':
+            case '\0':
+            case '7':
+                if (!name.empty() && name.back() == '/') {
+                    sink.directory(name);  // Pre-POSIX archives mark directories this way
+                    input.skip(size + padding);
+                    break;
+                }
+                if (sink.beginFile(name, mode)) {
+                    uint64_t remaining = size;
+                    while (remaining > 0) {
+                        size_t step =
+                                static_cast<size_t>(std::min<uint64_t>(remaining, chunk.size()));
+                        input.readExact(chunk.data(), step);
+                        sink.write(chunk.data(), step);
+                        remaining -= step;
+                    }
+                    sink.endFile();
+                    input.skip(padding);
+                } else {
+                    input.skip(size + padding);
+                }
+                break;
+            case '5':
+                sink.directory(name);
+                input.skip(size + padding);
+                break;
+            case '2':
+                sink.symlink(name, linkName);
+                input.skip(size + padding);
+                break;
+            case '1':
+                sink.hardlink(name, linkName);
+                input.skip(size + padding);
+                break;
+            default:
+                // Global pax headers, devices, fifos and unknown types
+                input.skip(size + padding);
+                break;
+        }
+        longName.clear();
+        longLink.clear();
+        pax.clear();
+    }
+}
+
+// ---------------------------------------------------------------------------
+// zip
+
+#ifdef CPP_SCAFFOLD_HAS_ZLIB
+struct ZipEntry {
+    std::string name;
+    uint16_t flags = 0;
+    uint16_t method = 0;
+    uint32_t crc = 0;
+    uint64_t compressedSize = 0;
+    uint64_t size = 0;
+    uint64_t localOffset = 0;
+    uint32_t mode = 0;  // Unix mode when recorded by a Unix zip tool
+};
+
+std::vector<ZipEntry> readZipDirectory(std::FILE* file, uint64_t archiveSize) {
+    constexpr size_t EOCD_SIZE = 22;
+    constexpr size_t MAX_COMMENT = 0xFFFF;
+    if (archiveSize < EOCD_SIZE) {
+        fail("Not a zip archive");
+    }
+
+    size_t tailSize = static_cast<size_t>(std::min<uint64_t>(archiveSize, EOCD_SIZE + MAX_COMMENT));
+    uint64_t tailOffset = archiveSize - tailSize;
+    std::vector<char> tail(tailSize);
+    readAt(file, tailOffset, tail.data(), tail.size());
+
+    size_t eocd = std::string::npos;
+    for (size_t i = tailSize - EOCD_SIZE + 1; i-- > 0;) {
+        if (std::memcmp(tail.data() + i, "PK\x05\x06", 4) == 0) {
+            eocd = i;
+            break;
+        }
+    }
+    if (eocd == std::string::npos) {
+        fail("Zip end of central directory not found");
+    }
+
+    uint64_t entryCount = readLE16(tail.data() + eocd + 10);
+    uint64_t directorySize = readLE32(tail.data() + eocd + 12);
+    uint64_t directoryOffset = readLE32(tail.data() + eocd + 16);
+
+    // ZIP64 archives keep the real values in a separate record
+    if (eocd >= 20 && std::memcmp(tail.data() + eocd - 20, "PK\x06\x07", 4) == 0) {
+        char record[56];
+        readAt(file, readLE64(tail.data() + eocd - 20 + 8), record, sizeof(record));
+        if (std::memcmp(record, "PK\x06\x06", 4) != 0) {
+            fail("Corrupt ZIP64 end of central directory");
+        }
+        entryCount = readLE64(record + 32);
+        directorySize = readLE64(record + 40);
+        directoryOffset = readLE64(record + 48);
+    }
+    if (directoryOffset + directorySize > archiveSize) {
+        fail("Corrupt zip central directory");
+    }
+
+    std::vector<char> directory(static_cast<size_t>(directorySize));
+    readAt(file, directoryOffset, directory.data(), directory.size());
+
+    std::vector<ZipEntry> entries;
+    entries.reserve(static_cast<size_t>(std::min<uint64_t>(entryCount, 1 << 20)));
+    size_t pos = 0;
+    for (uint64_t i = 0; i < entryCount; ++i) {
+        if (pos + 46 > directory.size() || std::memcmp(&directory[pos], "PK\x01\x02", 4) != 0) {
+            fail("Corrupt zip central directory");
+        }
+        const char* header = &directory[pos];
+        ZipEntry entry;
+        uint16_t madeBy = readLE16(header + 4);
+        entry.flags = readLE16(header + 8);
+        entry.method = readLE16(header + 10);
+        entry.crc = readLE32(header + 16);
+        entry.compressedSize = readLE32(header + 20);
+        entry.size = readLE32(header + 24);
+        uint16_t nameLength = readLE16(header + 28);
+        uint16_t extraLength = readLE16(header + 30);
+        uint16_t commentLength = readLE16(header + 32);
+        uint32_t externalAttributes = readLE32(header + 38);
+        entry.localOffset = readLE32(header + 42);
+        if (pos + 46 + nameLength + extraLength + commentLength > directory.size()) {
+            fail("Corrupt zip central directory");
+        }
+        entry.name.assign(header + 46, nameLength);
+        if ((madeBy >> 8) == 3) {
+            entry.mode = externalAttributes >> 16;
+        }
+
+        // ZIP64 extra field: only the values saturated above are present
+        const char* extra = header + 46 + nameLength;
+        for (size_t e = 0; e + 4 <= extraLength;) {
+            uint16_t id = readLE16(extra + e);
+            uint16_t length = readLE16(extra + e + 2);
+            if (id == 0x0001) {
+                const char* value = extra + e + 4;
+                const char* end = value + length;
+                if (entry.size == 0xFFFFFFFF && value + 8 <= end) {
+                    entry.size = readLE64(value);
+                    value += 8;
+                }
+                if (entry.compressedSize == 0xFFFFFFFF && value + 8 <= end) {
+                    entry.compressedSize = readLE64(value);
+                    value += 8;
+                }
+                if (entry.localOffset == 0xFFFFFFFF && value + 8 <= end) {
+                    entry.localOffset = readLE64(value);
+                }
+            }
+            e += 4 + length;
+        }
+
+        entries.push_back(std::move(entry));
+        pos += 46 + nameLength + extraLength + commentLength;
+    }
+    return entries;
+}
+
+void extractZip(std::FILE* file, uint64_t archiveSize, const Options& options, Progress& progress,
+                EntrySink& sink) {
+    std::vector<ZipEntry> entries = readZipDirectory(file, archiveSize);
+
+    // Check everything first so an unsupported entry never leaves a partial tree
+    std::vector<std::string> names;
+    names.reserve(entries.size());
+    for (const auto& entry : entries) {
+        if (entry.flags & 0x1) {
+            unsupported("Encrypted zip entries are not supported: " + entry.name);
+        }
+        if (entry.method != 0 && entry.method != 8) {
+            unsupported("Unsupported zip compression method " + std::to_string(entry.method));
+        }
+        names.push_back(ArchiveUtils::sanitizePath(entry.name));
+    }
+    if (options.stripSingleRoot && options.stripPrefix.empty()) {
+        sink.setStripPrefix(ArchiveUtils::findCommonRoot(names).value_or(""));
+    }
+
+    // Local headers are visited in file order so reads stay sequential
+    std::sort(entries.begin(), entries.end(), [](const ZipEntry& a, const ZipEntry& b) {
+        return a.localOffset < b.localOffset;
+    });
+
+    std::vector<char> input(CHUNK_SIZE);
+    std::vector<char> output(CHUNK_SIZE);
+    for (const auto& entry : entries) {
+        char local[30];
+        readAt(file, entry.localOffset, local, sizeof(local));
+        if (std::memcmp(local, "PK\x03\x04", 4) != 0) {
+            fail("Corrupt zip local header: " + entry.name);
+        }
+        uint64_t dataOffset = entry.localOffset + 30 + readLE16(local + 26) + readLE16(local + 28);
+        if (dataOffset + entry.compressedSize > archiveSize) {
+            fail("Unexpected end of archive");
+        }
+
+        uint32_t type = entry.mode & 0170000;
+        bool isDirectory = (!entry.name.empty() && entry.name.back() == '/') || type == 0040000;
+        if (isDirectory) {
+            sink.directory(entry.name);
+            continue;
+        }
+
+        if (!seekTo(file, dataOffset)) {
+            fail("Unexpected end of archive");
+        }
+
+        // Symbolic link targets are stored as the (small) entry contents
+        std::string linkTarget;
+        bool isSymlink = type == 0120000;
+        if (isSymlink && entry.size > MAX_METADATA_SIZE) {
+            fail("Oversized zip symbolic link: " + entry.name);
+        }
+        bool accepted = isSymlink || sink.beginFile(entry.name, entry.mode);
+        if (!accepted) {
+            continue;
+        }
+
+        uLong crc = crc32(0L, Z_NULL, 0);
+        uint64_t produced = 0;
+        auto emit = [&](const char* data, size_t size) {
+            crc = crc32(crc, reinterpret_cast<const Bytef*>(data), static_cast<uInt>(size));
+            produced += size;
+            if (isSymlink) {
+                linkTarget.append(data, size);
+            } else {
+                sink.write(data, size);
+            }
+        };
+
+        uint64_t remaining = entry.compressedSize;
+        auto readInput = [&]() {
+            size_t step = static_cast<size_t>(std::min<uint64_t>(remaining, input.size()));
+            if (std::fread(input.data(), 1, step, file) != step) {
+                fail("Unexpected end of archive");
+            }
+            remaining -= step;
+            return step;
+        };
+
+        if (entry.method == 0) {
+            while (remaining > 0) {
+                emit(input.data(), readInput());
+            }
+        } else {
+            z_stream stream{};
+            if (inflateInit2(&stream, -MAX_WBITS) != Z_OK) {
+                fail("Failed to initialize zip decompression");
+            }
+            std::unique_ptr<z_stream, int (*)(z_streamp)> guard(&stream, inflateEnd);
+            int rc = Z_OK;
+            while (rc != Z_STREAM_END) {
+                if (stream.avail_in == 0) {
+                    if (remaining == 0) {
+                        fail("Corrupt zip entry: " + entry.name);
+                    }
+                    stream.avail_in = static_cast<uInt>(readInput());
+                    stream.next_in = reinterpret_cast<Bytef*>(input.data());
+                }
+                stream.next_out = reinterpret_cast<Bytef*>(output.data());
+                stream.avail_out = static_cast<uInt>(output.size());
+                rc = inflate(&stream, Z_NO_FLUSH);
+                if (rc != Z_OK && rc != Z_STREAM_END) {
+                    fail("Corrupt zip entry: " + entry.name);
+                }
+                emit(output.data(), output.size() - stream.avail_out);
+            }
+        }
+
+        if (produced != entry.size || crc != entry.crc) {
+            fail("Zip entry failed its integrity check: " + entry.name);
+        }
+        if (isSymlink) {
+            sink.symlink(entry.name, linkTarget);
+        } else {
+            sink.endFile();
+        }
+        progress.update(dataOffset + entry.compressedSize);
+    }
+}
+#endif
+
+} // namespace
+
+bool StreamingArchiveExtractor::supports(ArchiveUtils::ArchiveFormat format) {
+    switch (format) {
+        case ArchiveUtils::ArchiveFormat::TAR:
+            return true;
+        case ArchiveUtils::ArchiveFormat::TAR_GZ:
+        case ArchiveUtils::ArchiveFormat::ZIP:
+#ifdef CPP_SCAFFOLD_HAS_ZLIB
+            return true;
+#else
+            return false;
+#endif
+        default:
+            return false;
+    }
+}
+
+StreamingArchiveExtractor::Outcome StreamingArchiveExtractor::run(
+        const fs::path& archivePath, ArchiveUtils::ArchiveFormat format, const Options& options) {
+    Outcome outcome;
+    if (!supports(format)) {
+        outcome.status = Status::Unsupported;
+        outcome.errorMessage = "Format not supported in-process";
+        return outcome;
+    }
+
+    FilePtr file = openFile(archivePath, false);
+    if (!file) {
+        outcome.errorMessage = "Cannot open archive " + archivePath.string();
+        return outcome;
+    }
+
+    try {
+        uint64_t archiveSize = fs::file_size(archivePath);
+        Progress progress(options.progressCallback, archiveSize);
+        EntrySink sink(options, outcome);
+        if (!options.targetPath.empty()) {
+            fs::create_directories(options.targetPath);
+        }
+
+        if (format == ArchiveUtils::ArchiveFormat::ZIP) {
+#ifdef CPP_SCAFFOLD_HAS_ZLIB
+            extractZip(file.get(), archiveSize, options, progress, sink);
+#endif
+        } else {
+            extractTar(file.get(), format == ArchiveUtils::ArchiveFormat::TAR_GZ, progress, sink);
+        }
+        progress.update(archiveSize);
+        outcome.status = Status::Ok;
+    } catch (const ExtractError& e) {
+        outcome.status = e.status;
+        outcome.errorMessage = e.message;
+    } catch (const std::exception& e) {
+        outcome.status = Status::Failed;
+        outcome.errorMessage = e.what();
+    }
+    return outcome;
+}
+
+} // namespace utils
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <string>
+#include <filesystem>
+#include <vector>
+
+#include "archive_utils.h"
+
+namespace utils {
+
+// In-process, single pass extractor for tar, tar.gz and zip archives.
+//
+// Entries are decompressed and written chunk by chunk, so memory use does not
+// depend on the archive size (zip central directories are the exception and
+// are read whole). Every entry name goes through ArchiveUtils::isSafePath
+// before anything is written. Archives using features the extractor does not
+// implement (encrypted or non-deflate zip entries, for example) are reported
+// as Unsupported so the caller can fall back to the external tools.
+class StreamingArchiveExtractor {
+public:
+    enum class Status {
+        Ok,
+        Failed,
+        Unsupported,
+        Cancelled
+    };
+
+    struct Options {
+        // Destination directory; empty reads and verifies the archive only
+        std::filesystem::path targetPath;
+        // See ArchiveUtils::ExtractOptions
+        std::string stripPrefix;
+        bool stripSingleRoot = false;
+        // Called with (archive bytes consumed, archive size)
+        ArchiveUtils::ProgressCallback progressCallback;
+    };
+
+    struct Outcome {
+        Status status = Status::Failed;
+        std::string errorMessage;
+        std::vector<std::string> files;  // Regular files, relative to the target
+        size_t totalBytes = 0;           // Uncompressed bytes of those files
+    };
+
+    // Whether this build can read the format in-process
+    static bool supports(ArchiveUtils::ArchiveFormat format);
+
+    static Outcome run(const std::filesystem::path& archivePath,
+                       ArchiveUtils::ArchiveFormat format,
+                       const Options& options);
+};
+
+} // namespace utils
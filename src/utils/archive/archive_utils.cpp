@@ -1,5 +1,8 @@
 #include "../archive/archive_utils.h"
+#include "../archive/archive_extractor.h"
 #include "../core/file_utils.h"
+#include "../core/process_runner.h"
+#include "../core/tool_registry.h"
 #include <spdlog/spdlog.h>
 #include <cstdlib>
 #include <sstream>
@@ -19,6 +22,14 @@ namespace utils {
 ArchiveUtils::ExtractionResult ArchiveUtils::extractArchive(const std::filesystem::path& archivePath,
                                                            const std::filesystem::path& targetPath,
                                                            const ProgressCallback& progressCallback) {
+    ExtractOptions options;
+    options.progressCallback = progressCallback;
+    return extractArchive(archivePath, targetPath, options);
+}
+
+ArchiveUtils::ExtractionResult ArchiveUtils::extractArchive(const std::filesystem::path& archivePath,
+                                                           const std::filesystem::path& targetPath,
+                                                           const ExtractOptions& options) {
     try {
         if (!std::filesystem::exists(archivePath)) {
             return {false, "Archive file does not exist", {}, 0, 0};
@@ -28,14 +39,43 @@ ArchiveUtils::ExtractionResult ArchiveUtils::extractArchive(const std::filesyste
             return {false, "Unsupported archive format", {}, 0, 0};
         }
 
-        // Create target directory
-        std::filesystem::create_directories(targetPath);
-
         ArchiveFormat format = detectFormat(archivePath);
 
         spdlog::info("Extracting {} archive: {} to {}",
                     formatToString(format), archivePath.string(), targetPath.string());
 
+        // Decompress and write in one pass where we can, no external tool needed
+        if (StreamingArchiveExtractor::supports(format)) {
+            StreamingArchiveExtractor::Options streamOptions{
+                targetPath, options.stripPrefix, options.stripSingleRoot, options.progressCallback};
+            auto outcome = StreamingArchiveExtractor::run(archivePath, format, streamOptions);
+            if (outcome.status != StreamingArchiveExtractor::Status::Unsupported) {
+                ExtractionResult result;
+                result.success = outcome.status == StreamingArchiveExtractor::Status::Ok;
+                result.errorMessage = outcome.errorMessage;
+                result.totalFiles = outcome.files.size();
+                result.totalBytes = outcome.totalBytes;
+                result.extractedFiles = std::move(outcome.files);
+                if (result.success) {
+                    spdlog::info("Successfully extracted {} files ({} bytes) from {} archive",
+                                 result.totalFiles, result.totalBytes, formatToString(format));
+                } else {
+                    spdlog::error("Failed to extract {} archive: {}", formatToString(format),
+                                  result.errorMessage);
+                }
+                return result;
+            }
+            spdlog::debug("{}, falling back to external tools", outcome.errorMessage);
+        }
+
+        if (!options.stripPrefix.empty() || options.stripSingleRoot) {
+            return extractWithToolsStripped(archivePath, targetPath, options);
+        }
+
+        // Create target directory
+        std::filesystem::create_directories(targetPath);
+
+        const ProgressCallback& progressCallback = options.progressCallback;
         switch (format) {
             case ArchiveFormat::ZIP:
                 return extractZip(archivePath, targetPath, progressCallback);
@@ -59,44 +99,115 @@ ArchiveUtils::ExtractionResult ArchiveUtils::extractArchive(const std::filesyste
     }
 }
 
+ArchiveUtils::ExtractionResult ArchiveUtils::extractWithToolsStripped(
+    const std::filesystem::path& archivePath, const std::filesystem::path& targetPath,
+    const ExtractOptions& options) {
+    namespace fs = std::filesystem;
+
+    // Staged next to the target so the final moves are renames on one filesystem
+    fs::path target = fs::absolute(targetPath);
+    fs::path staging = target.parent_path() / ("." + target.filename().string() + ".extract");
+    std::error_code ec;
+    fs::remove_all(staging, ec);
+
+    ExtractOptions plain;
+    plain.progressCallback = options.progressCallback;
+    ExtractionResult result = extractArchive(archivePath, staging, plain);
+    if (!result.success) {
+        fs::remove_all(staging, ec);
+        return result;
+    }
+
+    std::string prefix = sanitizePath(options.stripPrefix);
+    if (prefix.empty()) {
+        std::vector<std::string> topLevel;
+        for (const auto& entry : fs::directory_iterator(staging)) {
+            topLevel.push_back(entry.path().filename().string());
+        }
+        if (topLevel.size() == 1 && fs::is_directory(staging / topLevel[0])) {
+            prefix = topLevel[0];
+        }
+    }
+    while (!prefix.empty() && prefix.back() == '/') {
+        prefix.pop_back();
+    }
+    if (!prefix.empty() && !isSafePath(prefix, staging)) {
+        fs::remove_all(staging, ec);
+        return {false, "Invalid prefix: " + options.stripPrefix, {}, 0, 0};
+    }
+
+    fs::path source = prefix.empty() ? staging : staging / prefix;
+    fs::create_directories(target);
+    if (fs::is_directory(source)) {
+        for (const auto& entry : fs::directory_iterator(source)) {
+            fs::rename(entry.path(), target / entry.path().filename());
+        }
+    }
+    fs::remove_all(staging, ec);
+
+    if (!prefix.empty()) {
+        std::vector<std::string> files;
+        for (const auto& file : result.extractedFiles) {
+            std::string name = sanitizePath(file);
+            if (name.compare(0, prefix.size() + 1, prefix + "/") == 0) {
+                files.push_back(name.substr(prefix.size() + 1));
+            }
+        }
+        result.extractedFiles = std::move(files);
+        result.totalFiles = result.extractedFiles.size();
+    }
+    return result;
+}
+
 std::vector<std::string> ArchiveUtils::listArchiveContents(const std::filesystem::path& archivePath) {
     if (!std::filesystem::exists(archivePath)) {
         return {};
     }
 
     ArchiveFormat format = detectFormat(archivePath);
-    std::string command;
+    if (StreamingArchiveExtractor::supports(format)) {
+        auto outcome = StreamingArchiveExtractor::run(archivePath, format, {});
+        if (outcome.status == StreamingArchiveExtractor::Status::Ok) {
+            return std::move(outcome.files);
+        }
+        if (outcome.status == StreamingArchiveExtractor::Status::Failed) {
+            spdlog::debug("Cannot list {}: {}", archivePath.string(), outcome.errorMessage);
+            return {};
+        }
+    }
+
+    std::vector<std::string> command;
     std::string output;
 
     switch (format) {
         case ArchiveFormat::ZIP:
             if (hasUnzip()) {
-                command = "unzip -l \"" + archivePath.string() + "\"";
+                command = {"unzip", "-l", archivePath.string()};
             }
             break;
         case ArchiveFormat::TAR_GZ:
             if (hasTar()) {
-                command = "tar -tzf \"" + archivePath.string() + "\"";
+                command = {"tar", "-tzf", archivePath.string()};
             }
             break;
         case ArchiveFormat::TAR_BZ2:
             if (hasTar()) {
-                command = "tar -tjf \"" + archivePath.string() + "\"";
+                command = {"tar", "-tjf", archivePath.string()};
             }
             break;
         case ArchiveFormat::TAR_XZ:
             if (hasTar()) {
-                command = "tar -tJf \"" + archivePath.string() + "\"";
+                command = {"tar", "-tJf", archivePath.string()};
             }
             break;
         case ArchiveFormat::TAR:
             if (hasTar()) {
-                command = "tar -tf \"" + archivePath.string() + "\"";
+                command = {"tar", "-tf", archivePath.string()};
             }
             break;
         case ArchiveFormat::SEVEN_ZIP:
             if (hasSevenZip()) {
-                command = "7z l \"" + archivePath.string() + "\"";
+                command = {"7z", "l", archivePath.string()};
             }
             break;
         default:
@@ -116,12 +227,24 @@ bool ArchiveUtils::validateArchive(const std::filesystem::path& archivePath) {
     }
 
     ArchiveFormat format = detectFormat(archivePath);
-    std::string command;
+
+    // A dry run reads every entry and checks the zip CRCs / gzip trailer
+    if (StreamingArchiveExtractor::supports(format)) {
+        auto outcome = StreamingArchiveExtractor::run(archivePath, format, {});
+        if (outcome.status != StreamingArchiveExtractor::Status::Unsupported) {
+            if (outcome.status != StreamingArchiveExtractor::Status::Ok) {
+                spdlog::debug("Archive validation failed: {}", outcome.errorMessage);
+            }
+            return outcome.status == StreamingArchiveExtractor::Status::Ok;
+        }
+    }
+
+    std::vector<std::string> command;
 
     switch (format) {
         case ArchiveFormat::ZIP:
             if (hasUnzip()) {
-                command = "unzip -t \"" + archivePath.string() + "\"";
+                command = {"unzip", "-t", archivePath.string()};
             }
             break;
         case ArchiveFormat::TAR_GZ:
@@ -129,12 +252,12 @@ bool ArchiveUtils::validateArchive(const std::filesystem::path& archivePath) {
         case ArchiveFormat::TAR_XZ:
         case ArchiveFormat::TAR:
             if (hasTar()) {
-                command = "tar -tf \"" + archivePath.string() + "\" > /dev/null";
+                command = {"tar", "-tf", archivePath.string()};
             }
             break;
         case ArchiveFormat::SEVEN_ZIP:
             if (hasSevenZip()) {
-                command = "7z t \"" + archivePath.string() + "\"";
+                command = {"7z", "t", archivePath.string()};
             }
             break;
         default:
@@ -193,7 +316,7 @@ ArchiveUtils::ExtractionResult ArchiveUtils::extractZip(const std::filesystem::p
         return {false, "unzip command not available", {}, 0, 0};
     }
 
-    std::string command = "unzip -o \"" + archivePath.string() + "\" -d \"" + targetPath.string() + "\"";
+    std::vector<std::string> command = {"unzip", "-o", archivePath.string(), "-d", targetPath.string()};
 
     if (executeCommand(command)) {
         ExtractionResult result;
@@ -219,7 +342,7 @@ ArchiveUtils::ExtractionResult ArchiveUtils::extractTarGz(const std::filesystem:
         return {false, "tar command not available", {}, 0, 0};
     }
 
-    std::string command = "tar -xzf \"" + archivePath.string() + "\" -C \"" + targetPath.string() + "\"";
+    std::vector<std::string> command = {"tar", "-xzf", archivePath.string(), "-C", targetPath.string()};
 
     if (executeCommand(command)) {
         ExtractionResult result;
@@ -244,7 +367,7 @@ ArchiveUtils::ExtractionResult ArchiveUtils::extractTarBz2(const std::filesystem
         return {false, "tar command not available", {}, 0, 0};
     }
 
-    std::string command = "tar -xjf \"" + archivePath.string() + "\" -C \"" + targetPath.string() + "\"";
+    std::vector<std::string> command = {"tar", "-xjf", archivePath.string(), "-C", targetPath.string()};
 
     if (executeCommand(command)) {
         ExtractionResult result;
@@ -269,7 +392,7 @@ ArchiveUtils::ExtractionResult ArchiveUtils::extractTarXz(const std::filesystem:
         return {false, "tar command not available", {}, 0, 0};
     }
 
-    std::string command = "tar -xJf \"" + archivePath.string() + "\" -C \"" + targetPath.string() + "\"";
+    std::vector<std::string> command = {"tar", "-xJf", archivePath.string(), "-C", targetPath.string()};
 
     if (executeCommand(command)) {
         ExtractionResult result;
@@ -294,7 +417,7 @@ ArchiveUtils::ExtractionResult ArchiveUtils::extractSevenZip(const std::filesyst
         return {false, "7z command not available", {}, 0, 0};
     }
 
-    std::string command = "7z x \"" + archivePath.string() + "\" -o\"" + targetPath.string() + "\" -y";
+    std::vector<std::string> command = {"7z", "x", archivePath.string(), "-o" + targetPath.string(), "-y"};
 
     if (executeCommand(command)) {
         ExtractionResult result;
@@ -319,7 +442,7 @@ ArchiveUtils::ExtractionResult ArchiveUtils::extractTar(const std::filesystem::p
         return {false, "tar command not available", {}, 0, 0};
     }
 
-    std::string command = "tar -xf \"" + archivePath.string() + "\" -C \"" + targetPath.string() + "\"";
+    std::vector<std::string> command = {"tar", "-xf", archivePath.string(), "-C", targetPath.string()};
 
     if (executeCommand(command)) {
         ExtractionResult result;
@@ -337,50 +460,84 @@ ArchiveUtils::ExtractionResult ArchiveUtils::extractTar(const std::filesystem::p
 }
 
 bool ArchiveUtils::hasUnzip() {
-    return executeCommand("unzip -v");
+    return ToolRegistry::getInstance().isAvailable("unzip");
 }
 
 bool ArchiveUtils::hasTar() {
-    return executeCommand("tar --version");
+    return ToolRegistry::getInstance().isAvailable("tar");
 }
 
 bool ArchiveUtils::hasSevenZip() {
-    return executeCommand("7z");
+    return ToolRegistry::getInstance().isAvailable("7z");
 }
 
-bool ArchiveUtils::executeCommand(const std::string& command, std::string* output) {
-    try {
-#ifdef _WIN32
-        FILE* pipe = _popen((command + " 2>NUL").c_str(), "r");
-#else
-        FILE* pipe = popen((command + " 2>/dev/null").c_str(), "r");
-#endif
+bool ArchiveUtils::executeCommand(const std::vector<std::string>& command, std::string* output) {
+    ProcessOptions options;
+    options.discardStderr = true;
 
-        if (!pipe) {
-            return false;
-        }
+    ProcessResult result = ProcessRunner::run(command, options);
+    if (!result.started) {
+        spdlog::error("Error executing command: {}", result.errorMessage);
+        return false;
+    }
+    if (output) {
+        *output = std::move(result.output);
+    }
+    return result.success();
+}
 
-        if (output) {
-            char buffer[128];
-            std::ostringstream result;
-            while (fgets(buffer, sizeof(buffer), pipe) != nullptr) {
-                result << buffer;
-            }
-            *output = result.str();
+std::optional<std::string> ArchiveUtils::findCommonRoot(const std::vector<std::string>& entries) {
+    std::string root;
+    bool hasChildren = false;
+    for (const auto& raw : entries) {
+        std::string entry = sanitizePath(raw);
+        if (entry.empty()) {
+            continue;
         }
+        size_t slash = entry.find('/');
+        if (slash == std::string::npos) {
+            return std::nullopt;  // A file at the top level
+        }
+        std::string first = entry.substr(0, slash + 1);
+        if (root.empty()) {
+            root = first;
+        } else if (first != root) {
+            return std::nullopt;
+        }
+        hasChildren = hasChildren || entry.size() > root.size();
+    }
+    if (root.empty() || !hasChildren) {
+        return std::nullopt;
+    }
+    return root;
+}
 
-#ifdef _WIN32
-        int exitCode = _pclose(pipe);
-#else
-        int exitCode = pclose(pipe);
-#endif
-
-        return exitCode == 0;
+std::string ArchiveUtils::sanitizePath(const std::string& path) {
+    std::string result = path;
+    std::replace(result.begin(), result.end(), '\\', '/');
+    while (true) {
+        if (result.compare(0, 2, "./") == 0) {
+            result.erase(0, 2);
+        } else if (!result.empty() && result[0] == '/') {
+            result.erase(0, 1);  // Absolute names are made relative, like tar does
+        } else {
+            return result;
+        }
+    }
+}
 
-    } catch (const std::exception& e) {
-        spdlog::error("Error executing command: {}", e.what());
+bool ArchiveUtils::isSafePath(const std::string& path, const std::filesystem::path& targetDir) {
+    std::filesystem::path relative(path);
+    if (path.empty() || relative.is_absolute() || relative.has_root_name() ||
+        relative.has_root_directory()) {
         return false;
     }
+
+    // Resolve lexically; symbolic links are checked by the extractor itself
+    std::filesystem::path base = targetDir.lexically_normal();
+    std::filesystem::path resolved = (base / relative).lexically_normal();
+    std::filesystem::path inside = resolved.lexically_relative(base);
+    return !inside.empty() && *inside.begin() != "..";
 }
 
 std::vector<std::string> ArchiveUtils::parseFileList(const std::string& output, ArchiveFormat format) {
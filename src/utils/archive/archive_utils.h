@@ -31,15 +31,30 @@ public:
         size_t totalBytes = 0;
     };
 
-    // Progress callback function type: (current_file, total_files) -> bool
-    // Return false to cancel extraction
+    // Progress callback function type: (current, total) -> bool
+    // Bytes of the archive processed so far and the archive size for the formats
+    // extracted in-process (tar, tar.gz, zip). Return false to cancel extraction
     using ProgressCallback = std::function<bool(size_t current, size_t total)>;
 
+    // Extraction options
+    struct ExtractOptions {
+        // Only entries below this directory are extracted, with the prefix removed
+        std::string stripPrefix;
+        // Remove the single top-level directory that holds every entry, if any
+        // (the usual layout of release tarballs)
+        bool stripSingleRoot = false;
+        ProgressCallback progressCallback;
+    };
+
     // Extract archive to target directory
     static ExtractionResult extractArchive(const std::filesystem::path& archivePath,
                                           const std::filesystem::path& targetPath,
                                           const ProgressCallback& progressCallback = nullptr);
 
+    static ExtractionResult extractArchive(const std::filesystem::path& archivePath,
+                                          const std::filesystem::path& targetPath,
+                                          const ExtractOptions& options);
+
     // Extract specific files from archive
     static ExtractionResult extractFiles(const std::filesystem::path& archivePath,
                                         const std::filesystem::path& targetPath,
@@ -64,6 +79,15 @@ public:
     // Get archive format name as string
     static std::string formatToString(ArchiveFormat format);
 
+    // Top-level directory ("name/") shared by every entry, if there is one
+    static std::optional<std::string> findCommonRoot(const std::vector<std::string>& entries);
+
+    // Normalize an entry name: forward slashes, no leading "./" or "/"
+    static std::string sanitizePath(const std::string& path);
+
+    // Check if path is safe for extraction
+    static bool isSafePath(const std::string& path, const std::filesystem::path& targetDir);
+
     // Create archive from directory (for backup/export functionality)
     static bool createArchive(const std::filesystem::path& sourcePath,
                              const std::filesystem::path& archivePath,
@@ -101,16 +125,17 @@ private:
     static bool hasSevenZip();
 
     // Execute system command with output capture
-    static bool executeCommand(const std::string& command, std::string* output = nullptr);
+    static bool executeCommand(const std::vector<std::string>& command,
+                               std::string* output = nullptr);
 
     // Parse file list from command output
     static std::vector<std::string> parseFileList(const std::string& output, ArchiveFormat format);
 
-    // Sanitize extracted file paths to prevent directory traversal
-    static std::string sanitizePath(const std::string& path);
-
-    // Check if path is safe for extraction
-    static bool isSafePath(const std::string& path, const std::filesystem::path& targetDir);
+    // Tool-based extraction of a sub-directory, used when stripping a prefix
+    // without the in-process extractor
+    static ExtractionResult extractWithToolsStripped(const std::filesystem::path& archivePath,
+                                                     const std::filesystem::path& targetPath,
+                                                     const ExtractOptions& options);
 };
 
 } // namespace utils
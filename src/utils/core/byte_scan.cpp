@@ -0,0 +1,407 @@
+#include "../core/byte_scan.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define CPP_SCAFFOLD_SCAN_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define SCAN_TARGET_AVX2
+#else
+#define SCAN_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace utils {
+
+namespace {
+
+// One implementation of every kernel; the multi-byte search is only handed
+// needles of two or more bytes that fit in the text after from
+struct Kernels {
+    ScanIsa isa;
+    size_t (*count)(const char* data, size_t size, char byte);
+    size_t (*findByte)(const char* data, size_t size, size_t from, char byte);
+    size_t (*findNeedle)(const char* data, size_t size, size_t from, const char* needle,
+                         size_t needleSize);
+    size_t (*asciiPrefix)(const char* data, size_t size);  // leading bytes below 0x80
+};
+
+// Scalar reference implementations
+
+size_t countScalar(const char* data, size_t size, char byte) {
+    size_t total = 0;
+    for (size_t i = 0; i < size; ++i) {
+        total += data[i] == byte;
+    }
+    return total;
+}
+
+size_t findByteScalar(const char* data, size_t size, size_t from, char byte) {
+    for (size_t i = from; i < size; ++i) {
+        if (data[i] == byte) {
+            return i;
+        }
+    }
+    return ByteScan::npos;
+}
+
+size_t findNeedleScalar(const char* data, size_t size, size_t from, const char* needle,
+                        size_t needleSize) {
+    return std::string_view(data, size).find(std::string_view(needle, needleSize), from);
+}
+
+size_t asciiPrefixScalar(const char* data, size_t size) {
+    size_t i = 0;
+    while (i < size && static_cast<unsigned char>(data[i]) < 0x80) {
+        ++i;
+    }
+    return i;
+}
+
+constexpr Kernels SCALAR_KERNELS{ScanIsa::Scalar, countScalar, findByteScalar, findNeedleScalar,
+                                 asciiPrefixScalar};
+
+#ifdef CPP_SCAFFOLD_SCAN_X86
+
+inline unsigned countTrailingZeros(uint32_t mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+}
+
+// SSE2 (always present on x86-64)
+
+size_t countSse2(const char* data, size_t size, char byte) {
+    const __m128i target = _mm_set1_epi8(byte);
+    const __m128i zero = _mm_setzero_si128();
+    size_t total = 0;
+    size_t i = 0;
+    while (size - i >= 16) {
+        // Per-lane byte counters overflow after 255 blocks, so fold them before that
+        size_t blocks = std::min<size_t>((size - i) / 16, 255);
+        __m128i counters = zero;
+        for (size_t b = 0; b < blocks; ++b, i += 16) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            counters = _mm_sub_epi8(counters, _mm_cmpeq_epi8(chunk, target));
+        }
+        __m128i sums = _mm_sad_epu8(counters, zero);
+        total += static_cast<size_t>(_mm_cvtsi128_si64(sums)) +
+                 static_cast<size_t>(_mm_cvtsi128_si64(_mm_unpackhi_epi64(sums, sums)));
+    }
+    return total + countScalar(data + i, size - i, byte);
+}
+
+size_t findByteSse2(const char* data, size_t size, size_t from, char byte) {
+    const __m128i target = _mm_set1_epi8(byte);
+    size_t i = from;
+    for (; size - i >= 16; i += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, target)));
+        if (mask != 0) {
+            return i + countTrailingZeros(mask);
+        }
+    }
+    return findByteScalar(data, size, i, byte);
+}
+
+// Compares the first and last needle bytes at 16 candidate positions at once and
+// only checks the middle of the needle where both match
+size_t findNeedleSse2(const char* data, size_t size, size_t from, const char* needle,
+                      size_t needleSize) {
+    const __m128i first = _mm_set1_epi8(needle[0]);
+    const __m128i last = _mm_set1_epi8(needle[needleSize - 1]);
+    size_t i = from;
+    for (; i + needleSize - 1 + 16 <= size; i += 16) {
+        __m128i head = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i tail =
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + needleSize - 1));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(
+                _mm_and_si128(_mm_cmpeq_epi8(head, first), _mm_cmpeq_epi8(tail, last))));
+        while (mask != 0) {
+            size_t candidate = i + countTrailingZeros(mask);
+            if (std::memcmp(data + candidate + 1, needle + 1, needleSize - 2) == 0) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+    return findNeedleScalar(data, size, i, needle, needleSize);
+}
+
+size_t asciiPrefixSse2(const char* data, size_t size) {
+    size_t i = 0;
+    for (; size - i >= 16; i += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(chunk));
+        if (mask != 0) {
+            return i + countTrailingZeros(mask);
+        }
+    }
+    return i + asciiPrefixScalar(data + i, size - i);
+}
+
+constexpr Kernels SSE2_KERNELS{ScanIsa::SSE2, countSse2, findByteSse2, findNeedleSse2,
+                               asciiPrefixSse2};
+
+// AVX2, only called after the CPU was checked for it
+
+SCAN_TARGET_AVX2 size_t countAvx2(const char* data, size_t size, char byte) {
+    const __m256i target = _mm256_set1_epi8(byte);
+    const __m256i zero = _mm256_setzero_si256();
+    size_t total = 0;
+    size_t i = 0;
+    while (size - i >= 32) {
+        size_t blocks = std::min<size_t>((size - i) / 32, 255);
+        __m256i counters = zero;
+        for (size_t b = 0; b < blocks; ++b, i += 32) {
+            __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            counters = _mm256_sub_epi8(counters, _mm256_cmpeq_epi8(chunk, target));
+        }
+        __m256i sums = _mm256_sad_epu8(counters, zero);
+        total += static_cast<size_t>(_mm256_extract_epi64(sums, 0)) +
+                 static_cast<size_t>(_mm256_extract_epi64(sums, 1)) +
+                 static_cast<size_t>(_mm256_extract_epi64(sums, 2)) +
+                 static_cast<size_t>(_mm256_extract_epi64(sums, 3));
+    }
+    return total + countSse2(data + i, size - i, byte);
+}
+
+SCAN_TARGET_AVX2 size_t findByteAvx2(const char* data, size_t size, size_t from, char byte) {
+    const __m256i target = _mm256_set1_epi8(byte);
+    size_t i = from;
+    for (; size - i >= 32; i += 32) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        uint32_t mask =
+                static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, target)));
+        if (mask != 0) {
+            return i + countTrailingZeros(mask);
+        }
+    }
+    return findByteSse2(data, size, i, byte);
+}
+
+SCAN_TARGET_AVX2 size_t findNeedleAvx2(const char* data, size_t size, size_t from,
+                                       const char* needle, size_t needleSize) {
+    const __m256i first = _mm256_set1_epi8(needle[0]);
+    const __m256i last = _mm256_set1_epi8(needle[needleSize - 1]);
+    size_t i = from;
+    for (; i + needleSize - 1 + 32 <= size; i += 32) {
+        __m256i head = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        __m256i tail =
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + needleSize - 1));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+                _mm256_and_si256(_mm256_cmpeq_epi8(head, first), _mm256_cmpeq_epi8(tail, last))));
+        while (mask != 0) {
+            size_t candidate = i + countTrailingZeros(mask);
+            if (std::memcmp(data + candidate + 1, needle + 1, needleSize - 2) == 0) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+    return findNeedleSse2(data, size, i, needle, needleSize);
+}
+
+SCAN_TARGET_AVX2 size_t asciiPrefixAvx2(const char* data, size_t size) {
+    size_t i = 0;
+    for (; size - i >= 32; i += 32) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(chunk));
+        if (mask != 0) {
+            return i + countTrailingZeros(mask);
+        }
+    }
+    return i + asciiPrefixSse2(data + i, size - i);
+}
+
+constexpr Kernels AVX2_KERNELS{ScanIsa::AVX2, countAvx2, findByteAvx2, findNeedleAvx2,
+                               asciiPrefixAvx2};
+
+bool cpuHasAvx2() {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+    __cpuid(info, 1);
+    bool osSavesYmm = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+    __cpuidex(info, 7, 0);
+    return osSavesYmm && (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif  // CPP_SCAFFOLD_SCAN_X86
+
+const Kernels& kernelsFor(ScanIsa isa) {
+#ifdef CPP_SCAFFOLD_SCAN_X86
+    switch (isa) {
+        case ScanIsa::AVX2:
+            return AVX2_KERNELS;
+        case ScanIsa::SSE2:
+            return SSE2_KERNELS;
+        case ScanIsa::Scalar:
+            break;
+    }
+#else
+    (void)isa;
+#endif
+    return SCALAR_KERNELS;
+}
+
+ScanIsa clampToSupported(ScanIsa isa) {
+    ScanIsa best = ByteScan::detectIsa();
+    return static_cast<int>(isa) < static_cast<int>(best) ? isa : best;
+}
+
+// CPP_SCAFFOLD_SIMD=scalar|sse2|avx2 caps the detected instruction set
+ScanIsa initialIsa() {
+    ScanIsa isa = ByteScan::detectIsa();
+    if (const char* value = std::getenv("CPP_SCAFFOLD_SIMD")) {
+        std::string requested(value);
+        if (requested == "scalar" || requested == "0" || requested == "off") {
+            isa = ScanIsa::Scalar;
+        } else if (requested == "sse2") {
+            isa = clampToSupported(ScanIsa::SSE2);
+        }
+    }
+    return isa;
+}
+
+std::atomic<const Kernels*>& activeKernels() {
+    static std::atomic<const Kernels*> active{&kernelsFor(initialIsa())};
+    return active;
+}
+
+inline const Kernels& kernels() {
+    return *activeKernels().load(std::memory_order_relaxed);
+}
+
+// Length of the well-formed UTF-8 sequence at data[0] (non-ASCII lead byte), or 0
+size_t utf8SequenceLength(const unsigned char* data, size_t size) {
+    unsigned char lead = data[0];
+    size_t length;
+    unsigned char low = 0x80;  // allowed range of the second byte
+    unsigned char high = 0xBF;
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        length = 2;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+        length = 3;
+        if (lead == 0xE0) {
+            low = 0xA0;  // overlong
+        } else if (lead == 0xED) {
+            high = 0x9F;  // surrogates
+        }
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+        length = 4;
+        if (lead == 0xF0) {
+            low = 0x90;  // overlong
+        } else if (lead == 0xF4) {
+            high = 0x8F;  // above U+10FFFF
+        }
+    } else {
+        return 0;
+    }
+    if (size < length || data[1] < low || data[1] > high) {
+        return 0;
+    }
+    for (size_t i = 2; i < length; ++i) {
+        if ((data[i] & 0xC0) != 0x80) {
+            return 0;
+        }
+    }
+    return length;
+}
+
+}  // namespace
+
+size_t ByteScan::count(std::string_view text, char byte) {
+    return kernels().count(text.data(), text.size(), byte);
+}
+
+size_t ByteScan::find(std::string_view text, char byte, size_t from) {
+    if (from >= text.size()) {
+        return npos;
+    }
+    return kernels().findByte(text.data(), text.size(), from, byte);
+}
+
+size_t ByteScan::find(std::string_view text, std::string_view needle, size_t from) {
+    if (from > text.size() || needle.size() > text.size() - from) {
+        return npos;
+    }
+    if (needle.empty()) {
+        return from;
+    }
+    if (needle.size() == 1) {
+        return kernels().findByte(text.data(), text.size(), from, needle[0]);
+    }
+    return kernels().findNeedle(text.data(), text.size(), from, needle.data(), needle.size());
+}
+
+bool ByteScan::isValidUtf8(std::string_view text) {
+    const Kernels& active = kernels();
+    const auto* data = reinterpret_cast<const unsigned char*>(text.data());
+    size_t size = text.size();
+    size_t i = 0;
+    while (i < size) {
+        // Skip ASCII in vector-sized steps, then decode the non-ASCII run one
+        // sequence at a time
+        i += active.asciiPrefix(text.data() + i, size - i);
+        while (i < size && data[i] >= 0x80) {
+            size_t length = utf8SequenceLength(data + i, size - i);
+            if (length == 0) {
+                return false;
+            }
+            i += length;
+        }
+    }
+    return true;
+}
+
+ScanIsa ByteScan::activeIsa() {
+    return kernels().isa;
+}
+
+ScanIsa ByteScan::setIsa(ScanIsa isa) {
+    const Kernels& selected = kernelsFor(clampToSupported(isa));
+    activeKernels().store(&selected, std::memory_order_relaxed);
+    return selected.isa;
+}
+
+ScanIsa ByteScan::detectIsa() {
+#ifdef CPP_SCAFFOLD_SCAN_X86
+    static const ScanIsa detected = cpuHasAvx2() ? ScanIsa::AVX2 : ScanIsa::SSE2;
+    return detected;
+#else
+    return ScanIsa::Scalar;
+#endif
+}
+
+const char* ByteScan::isaName(ScanIsa isa) {
+    switch (isa) {
+        case ScanIsa::AVX2:
+            return "avx2";
+        case ScanIsa::SSE2:
+            return "sse2";
+        case ScanIsa::Scalar:
+            break;
+    }
+    return "scalar";
+}
+
+}  // namespace utils
@@ -0,0 +1,42 @@
+#pragma once
+#include <cstddef>
+#include <string_view>
+
+namespace utils {
+
+// Instruction sets the byte scanning kernels can run on
+enum class ScanIsa { Scalar, SSE2, AVX2 };
+
+// Byte scanning kernels behind StringUtils and FileUtils line counting and
+// searching. On x86-64 an SSE2 or AVX2 implementation is picked once from the
+// CPU (CPP_SCAFFOLD_SIMD=scalar|sse2 caps it); other targets use the scalar
+// loops. Every implementation returns exactly what the scalar one does.
+class ByteScan {
+   public:
+    static constexpr size_t npos = std::string_view::npos;
+
+    // Number of occurrences of byte in text
+    static size_t count(std::string_view text, char byte);
+
+    // Position of the first byte at or after from, or npos
+    static size_t find(std::string_view text, char byte, size_t from = 0);
+
+    // Same result as std::string_view::find(needle, from)
+    static size_t find(std::string_view text, std::string_view needle, size_t from = 0);
+
+    // Strict UTF-8: rejects overlong forms, surrogates and code points above U+10FFFF
+    static bool isValidUtf8(std::string_view text);
+
+    // Instruction set the kernels currently use
+    static ScanIsa activeIsa();
+
+    // Switches to isa, or to the best supported one below it; returns the one now active
+    static ScanIsa setIsa(ScanIsa isa);
+
+    // Best instruction set this CPU supports
+    static ScanIsa detectIsa();
+
+    static const char* isaName(ScanIsa isa);
+};
+
+}  // namespace utils
@@ -0,0 +1,449 @@
+#include "../core/copy_engine.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <system_error>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/fs.h>
+#endif
+#ifdef __APPLE__
+#include <sys/clonefile.h>
+#endif
+#endif
+
+namespace fs = std::filesystem;
+
+namespace utils {
+
+namespace {
+
+constexpr size_t MAX_COPY_WORKERS = 8;
+constexpr size_t COPY_BUFFER_SIZE = 128 * 1024;
+
+#ifndef _WIN32
+std::string systemError(const std::string& what, const fs::path& path) {
+    return what + " '" + path.string() + "': " + std::strerror(errno);
+}
+
+bool writeAll(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t written = ::write(fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+// Plain read/write loop; the last resort when the kernel cannot copy for us
+bool copyBuffered(int in, int out, std::uintmax_t& bytes) {
+#ifdef POSIX_FADV_SEQUENTIAL
+    posix_fadvise(in, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    std::vector<char> buffer(COPY_BUFFER_SIZE);
+    bytes = 0;
+    for (;;) {
+        ssize_t got = ::read(in, buffer.data(), buffer.size());
+        if (got < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        if (got == 0) {
+            return true;
+        }
+        if (!writeAll(out, buffer.data(), static_cast<size_t>(got))) {
+            return false;
+        }
+        bytes += static_cast<std::uintmax_t>(got);
+    }
+}
+
+#ifdef __linux__
+// In-kernel copy; no data passes through user space. Fails without side
+// effects worth keeping, so the caller can rewind and copy through a buffer
+bool copyRange(int in, int out, std::uintmax_t& bytes) {
+    bytes = 0;
+    for (;;) {
+        ssize_t copied = ::copy_file_range(in, nullptr, out, nullptr, size_t{1} << 30, 0);
+        if (copied < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        if (copied == 0) {
+            return true;
+        }
+        bytes += static_cast<std::uintmax_t>(copied);
+    }
+}
+#endif
+#endif  // !_WIN32
+
+}  // namespace
+
+CopyEngine::CopyEngine(FileOptions options, size_t maxWorkers)
+    : options_(std::move(options)), maxWorkers_(maxWorkers) {}
+
+const char* CopyEngine::methodName(CopyMethod method) {
+    switch (method) {
+        case CopyMethod::Clone:
+            return "clone";
+        case CopyMethod::HardLink:
+            return "hardlink";
+        case CopyMethod::CopyRange:
+            return "copy_file_range";
+        case CopyMethod::Buffered:
+            break;
+    }
+    return "buffered";
+}
+
+bool CopyEngine::copyFile(const fs::path& source, const fs::path& destination,
+                          CopyMethod& method, std::string& error) const {
+    std::error_code ec;
+    if (options_.createParentDirectories && destination.has_parent_path()) {
+        fs::create_directories(destination.parent_path(), ec);
+    }
+    if (!options_.overwriteExisting && fs::exists(destination, ec)) {
+        error = "Destination already exists: " + destination.string();
+        return false;
+    }
+    std::uintmax_t bytes = 0;
+    return copyContents(source, destination, method, bytes, error);
+}
+
+bool CopyEngine::copyContents(const fs::path& source, const fs::path& destination,
+                              CopyMethod& method, std::uintmax_t& bytes,
+                              std::string& error) const {
+    std::error_code ec;
+    if (options_.backupExisting && fs::exists(destination, ec)) {
+        auto backup = FileUtils::createBackup(destination);
+        if (!backup) {
+            error = backup.message;
+            return false;
+        }
+    }
+
+#ifdef _WIN32
+    // CopyFileW already clones on ReFS/Dev Drive volumes that support it
+    if (options_.allowHardLinks) {
+        fs::remove(destination, ec);
+        fs::create_hard_link(source, destination, ec);
+        if (!ec) {
+            method = CopyMethod::HardLink;
+            bytes = fs::file_size(source, ec);
+            return true;
+        }
+    }
+    fs::copy_file(source, destination, fs::copy_options::overwrite_existing, ec);
+    if (ec) {
+        error = "Could not copy '" + source.string() + "': " + ec.message();
+        return false;
+    }
+    method = CopyMethod::Buffered;
+    bytes = fs::file_size(destination, ec);
+#else
+    int in = ::open(source.c_str(), O_RDONLY | O_CLOEXEC);
+    if (in < 0) {
+        error = systemError("Could not open", source);
+        return false;
+    }
+    struct stat status {};
+    if (fstat(in, &status) != 0 || !S_ISREG(status.st_mode)) {
+        error = "Not a regular file: " + source.string();
+        ::close(in);
+        return false;
+    }
+    mode_t mode = status.st_mode & 07777;
+    auto size = static_cast<std::uintmax_t>(status.st_size);
+
+    // Truncating a destination that is (a link to) the source would empty the source
+    struct stat existing {};
+    if (::stat(destination.c_str(), &existing) == 0 && existing.st_dev == status.st_dev &&
+        existing.st_ino == status.st_ino) {
+        if (fs::weakly_canonical(source, ec) == fs::weakly_canonical(destination, ec)) {
+            error = "Source and destination are the same file: " + source.string();
+            ::close(in);
+            return false;
+        }
+        ::unlink(destination.c_str());
+    }
+
+#ifdef __APPLE__
+    // clonefile refuses to replace an existing file
+    ::unlink(destination.c_str());
+    if (clonefile(source.c_str(), destination.c_str(), 0) == 0) {
+        ::close(in);
+        method = CopyMethod::Clone;
+        bytes = size;
+        return true;
+    }
+#endif
+
+    auto openDestination = [&]() {
+        return ::open(destination.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+                      mode | S_IWUSR);
+    };
+    int out = openDestination();
+    if (out < 0) {
+        error = systemError("Could not create", destination);
+        ::close(in);
+        return false;
+    }
+
+    bool copied = false;
+#ifdef FICLONE
+    if (ioctl(out, FICLONE, in) == 0) {
+        method = CopyMethod::Clone;
+        bytes = size;
+        copied = true;
+    }
+#endif
+
+    if (!copied && options_.allowHardLinks) {
+        ::close(out);
+        ::unlink(destination.c_str());
+        if (::link(source.c_str(), destination.c_str()) == 0) {
+            // The link shares the source inode, so its mode is left alone
+            ::close(in);
+            method = CopyMethod::HardLink;
+            bytes = size;
+            return true;
+        }
+        out = openDestination();
+        if (out < 0) {
+            error = systemError("Could not create", destination);
+            ::close(in);
+            return false;
+        }
+    }
+
+#ifdef __linux__
+    if (!copied) {
+        copied = copyRange(in, out, bytes);
+        if (copied) {
+            method = CopyMethod::CopyRange;
+        } else {
+            // Start over through a buffer, e.g. across filesystems on older kernels
+            if (lseek(in, 0, SEEK_SET) != 0 || lseek(out, 0, SEEK_SET) != 0 ||
+                ftruncate(out, 0) != 0) {
+                error = systemError("Could not copy", source);
+                ::close(in);
+                ::close(out);
+                return false;
+            }
+        }
+    }
+#endif
+
+    if (!copied) {
+        if (!copyBuffered(in, out, bytes)) {
+            error = systemError("Could not copy", source);
+            ::close(in);
+            ::close(out);
+            return false;
+        }
+        method = CopyMethod::Buffered;
+    }
+
+    fchmod(out, mode);
+    ::close(in);
+    if (::close(out) != 0) {
+        error = systemError("Could not write", destination);
+        return false;
+    }
+#endif
+
+    if (options_.permissions != fs::perms::none) {
+        fs::permissions(destination, options_.permissions, ec);
+    }
+    return true;
+}
+
+CopyReport CopyEngine::copyTree(const fs::path& source, const fs::path& destination) const {
+    CopyReport report;
+    std::error_code ec;
+    if (!fs::is_directory(source, ec)) {
+        report.failures.emplace_back(source, "Not a directory");
+        return report;
+    }
+
+    // A destination inside the source would be walked while it is being filled
+    auto sourceRoot = fs::weakly_canonical(source, ec);
+    auto destinationRoot = fs::weakly_canonical(destination, ec);
+    auto mismatch = std::mismatch(sourceRoot.begin(), sourceRoot.end(), destinationRoot.begin(),
+                                  destinationRoot.end());
+    if (!ec && mismatch.first == sourceRoot.end()) {
+        report.failures.emplace_back(destination, "Destination is inside the source directory");
+        return report;
+    }
+    if (options_.createParentDirectories && destination.has_parent_path()) {
+        fs::create_directories(destination.parent_path(), ec);
+    }
+
+    struct Task {
+        fs::path source;
+        fs::path destination;
+        bool directory = false;
+    };
+
+    // Tasks are queued or in progress while pending > 0; listing a directory
+    // queues its children before the directory itself is counted as done
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::deque<Task> queue;
+    queue.push_back({source, destination, true});
+    size_t pending = 1;
+
+    auto listDirectory = [&](const Task& task, CopyReport& local, std::vector<Task>& found) {
+        std::error_code dirError;
+        if (fs::create_directory(task.destination, dirError)) {
+            ++local.directories;
+        } else if (dirError) {
+            local.failures.emplace_back(task.destination, dirError.message());
+            return;
+        }
+        for (fs::directory_iterator it(task.source, dirError), end; !dirError && it != end;
+             it.increment(dirError)) {
+            const auto& entry = *it;
+            auto target = task.destination / entry.path().filename();
+            std::error_code typeError;
+            bool isLink = entry.is_symlink(typeError);
+            // Directory links are recreated rather than followed so cycles cannot recurse
+            if (isLink && (!options_.followSymlinks || entry.is_directory(typeError) ||
+                           !entry.exists(typeError))) {
+                std::error_code linkError;
+                if (fs::exists(fs::symlink_status(target, linkError))) {
+                    if (!options_.overwriteExisting) {
+                        ++local.skipped;
+                        continue;
+                    }
+                    fs::remove(target, linkError);
+                }
+                fs::copy_symlink(entry.path(), target, linkError);
+                if (linkError) {
+                    local.failures.emplace_back(entry.path(), linkError.message());
+                } else {
+                    ++local.symlinks;
+                }
+            } else if (entry.is_directory(typeError)) {
+                found.push_back({entry.path(), target, true});
+            } else if (entry.is_regular_file(typeError)) {
+                found.push_back({entry.path(), target, false});
+            }
+        }
+        if (dirError) {
+            local.failures.emplace_back(task.source, dirError.message());
+        }
+    };
+
+    auto copyOne = [&](const Task& task, CopyReport& local) {
+        std::error_code existsError;
+        if (!options_.overwriteExisting && fs::exists(task.destination, existsError)) {
+            ++local.skipped;
+            return;
+        }
+        CopyMethod method = CopyMethod::Buffered;
+        std::uintmax_t bytes = 0;
+        std::string error;
+        if (!copyContents(task.source, task.destination, method, bytes, error)) {
+            local.failures.emplace_back(task.source, error);
+            return;
+        }
+        ++local.files;
+        ++local.methods[static_cast<size_t>(method)];
+        local.bytes += bytes;
+    };
+
+    auto worker = [&](CopyReport& local) {
+        for (;;) {
+            Task task;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                while (queue.empty() && pending != 0) {
+                    ready.wait_for(lock, std::chrono::milliseconds(10));
+                }
+                if (queue.empty()) {
+                    return;
+                }
+                task = std::move(queue.front());
+                queue.pop_front();
+            }
+
+            std::vector<Task> found;
+            if (task.directory) {
+                listDirectory(task, local, found);
+            } else {
+                copyOne(task, local);
+            }
+
+            bool wake;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                for (auto& child : found) {
+                    queue.push_back(std::move(child));
+                }
+                pending += found.size();
+                --pending;
+                wake = !found.empty() || pending == 0;
+            }
+            if (wake) {
+                ready.notify_all();
+            }
+        }
+    };
+
+    size_t workers = maxWorkers_ != 0 ? maxWorkers_ : std::thread::hardware_concurrency();
+    workers = std::clamp<size_t>(workers, 1, MAX_COPY_WORKERS);
+
+    std::vector<CopyReport> locals(workers);
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for (size_t i = 1; i < workers; ++i) {
+        pool.emplace_back(worker, std::ref(locals[i]));
+    }
+    worker(locals[0]);
+    for (auto& thread : pool) {
+        thread.join();
+    }
+
+    for (auto& local : locals) {
+        report.directories += local.directories;
+        report.files += local.files;
+        report.symlinks += local.symlinks;
+        report.skipped += local.skipped;
+        report.bytes += local.bytes;
+        for (size_t i = 0; i < report.methods.size(); ++i) {
+            report.methods[i] += local.methods[i];
+        }
+        for (auto& failure : local.failures) {
+            report.failures.push_back(std::move(failure));
+        }
+    }
+    std::sort(report.failures.begin(), report.failures.end());
+    return report;
+}
+
+}  // namespace utils
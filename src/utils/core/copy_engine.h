@@ -0,0 +1,67 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "file_utils.h"
+
+namespace utils {
+
+// How one file was copied, cheapest first
+enum class CopyMethod { Clone, HardLink, CopyRange, Buffered };
+
+// Outcome of a CopyEngine tree copy
+struct CopyReport {
+    size_t directories = 0;  // Created under the destination, including its root
+    size_t files = 0;
+    size_t symlinks = 0;
+    size_t skipped = 0;  // Existing files left alone because overwriting was off
+    std::uintmax_t bytes = 0;
+    std::array<size_t, 4> methods{};  // File count per CopyMethod
+    std::vector<std::pair<std::filesystem::path, std::string>> failures;
+
+    size_t count(CopyMethod method) const {
+        return methods[static_cast<size_t>(method)];
+    }
+    bool success() const {
+        return failures.empty();
+    }
+};
+
+// File and directory copier used by FileUtils::copyFileEx/copyDirectoryEx.
+//
+// Each file is first cloned (FICLONE on Linux, clonefile on macOS), which
+// shares extents on btrfs, xfs and APFS and costs no data I/O. Where cloning
+// is not supported the file is hard-linked if FileOptions::allowHardLinks
+// permits, then copied in the kernel with copy_file_range, and finally through
+// a buffer. copyTree walks the source on a worker pool: directories are
+// listed and files copied as independent tasks, so deep and wide trees both
+// keep every worker busy.
+class CopyEngine {
+   public:
+    explicit CopyEngine(FileOptions options = {}, size_t maxWorkers = 0);
+
+    // Copies one regular file. The destination's parent must exist unless
+    // createParentDirectories is set
+    bool copyFile(const std::filesystem::path& source, const std::filesystem::path& destination,
+                  CopyMethod& method, std::string& error) const;
+
+    // Copies the contents of source into destination, creating it if needed
+    CopyReport copyTree(const std::filesystem::path& source,
+                        const std::filesystem::path& destination) const;
+
+    static const char* methodName(CopyMethod method);
+
+   private:
+    bool copyContents(const std::filesystem::path& source,
+                      const std::filesystem::path& destination, CopyMethod& method,
+                      std::uintmax_t& bytes, std::string& error) const;
+
+    FileOptions options_;
+    size_t maxWorkers_;
+};
+
+}  // namespace utils
@@ -0,0 +1,143 @@
+#include "../core/file_emitter.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <fstream>
+#include <set>
+
+#include "../core/parallel.h"
+
+namespace fs = std::filesystem;
+
+namespace utils {
+
+namespace {
+// Small-file writes are syscall bound, so a handful of workers is enough to
+// hide filesystem latency without oversubscribing the machine.
+constexpr size_t MAX_EMIT_WORKERS = 8;
+}  // namespace
+
+void FileEmitter::enqueueDirectory(const fs::path& path) {
+    directories_.push_back(path);
+}
+
+void FileEmitter::enqueueFile(const fs::path& path, std::string content) {
+    files_.push_back({path, std::move(content), nullptr});
+}
+
+void FileEmitter::enqueueFile(const fs::path& path, ContentRenderer renderer) {
+    files_.push_back({path, {}, std::move(renderer)});
+}
+
+void FileEmitter::clear() {
+    directories_.clear();
+    files_.clear();
+}
+
+bool FileEmitter::createDirectoryTree(EmitReport& report) const {
+    std::set<fs::path> required;
+    for (const auto& dir : directories_) {
+        if (!dir.empty()) {
+            required.insert(dir.lexically_normal());
+        }
+    }
+    for (const auto& file : files_) {
+        auto parent = file.path.parent_path();
+        if (!parent.empty()) {
+            required.insert(parent.lexically_normal());
+        }
+    }
+
+    // Walk each directory top-down so every distinct path is created exactly
+    // once and the ones that are new can be reported for rollback.
+    std::set<fs::path> ensured;
+    for (const auto& dir : required) {
+        fs::path current;
+        for (const auto& part : dir) {
+            current /= part;
+            if (!ensured.insert(current).second) {
+                continue;
+            }
+            if (current == current.root_path()) {
+                continue;
+            }
+
+            std::error_code ec;
+            if (fs::create_directory(current, ec)) {
+                report.createdDirectories.push_back(current);
+            } else if (ec) {
+                report.failures.emplace_back(current, ec.message());
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool FileEmitter::writeFile(const fs::path& path, const std::string& content, std::string& error) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        error = "could not open file for writing";
+        return false;
+    }
+    file.write(content.data(), static_cast<std::streamsize>(content.size()));
+    file.close();
+    if (file.fail()) {
+        error = "write failed, check disk space and permissions";
+        return false;
+    }
+    return true;
+}
+
+EmitReport FileEmitter::flush(size_t maxWorkers) {
+    EmitReport report;
+
+    if (!createDirectoryTree(report)) {
+        spdlog::error("Failed to create directory '{}': {}",
+                      report.failures.back().first.string(), report.failures.back().second);
+        clear();
+        return report;
+    }
+
+    std::vector<PendingFile> files = std::move(files_);
+    clear();
+    if (files.empty()) {
+        return report;
+    }
+
+    size_t workers = std::min(parallelWorkerCount(files.size(), maxWorkers), MAX_EMIT_WORKERS);
+
+    std::vector<std::string> errors(files.size());
+    std::vector<char> written(files.size(), 0);
+
+    parallelFor(files.size(), workers, [&](size_t i) {
+        auto& file = files[i];
+        try {
+            if (file.renderer) {
+                file.content = file.renderer();
+            }
+            written[i] = writeFile(file.path, file.content, errors[i]) ? 1 : 0;
+        } catch (const std::exception& e) {
+            errors[i] = e.what();
+        }
+        // Release the rendered content as soon as it is on disk
+        std::string().swap(file.content);
+    });
+
+    report.writtenFiles.reserve(files.size());
+    for (size_t i = 0; i < files.size(); ++i) {
+        if (written[i]) {
+            report.writtenFiles.push_back(files[i].path);
+        } else {
+            spdlog::error("Failed to write file '{}': {}", files[i].path.string(), errors[i]);
+            report.failures.emplace_back(files[i].path, errors[i]);
+        }
+    }
+
+    spdlog::debug("Emitted {} files ({} new directories) using {} worker(s)",
+                  report.writtenFiles.size(), report.createdDirectories.size(), workers);
+    return report;
+}
+
+}  // namespace utils
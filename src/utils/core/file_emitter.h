@@ -0,0 +1,64 @@
+#pragma once
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace utils {
+
+// Outcome of flushing a FileEmitter
+struct EmitReport {
+    std::vector<std::filesystem::path> createdDirectories;  // Only directories that were new
+    std::vector<std::filesystem::path> writtenFiles;        // In enqueue order
+    std::vector<std::pair<std::filesystem::path, std::string>> failures;
+
+    bool success() const {
+        return failures.empty();
+    }
+};
+
+// Batched file emission stage for project generation.
+//
+// Files are queued as (path, content) pairs or as deferred renderers. flush()
+// creates the whole directory tree once up front (one mkdir per distinct
+// directory), then renders and writes the queued files concurrently on a
+// small worker pool. Writes skip the per-file existence checks done by
+// FileUtils::writeToFile since the parent tree is already known to exist.
+class FileEmitter {
+   public:
+    using ContentRenderer = std::function<std::string()>;
+
+    void enqueueDirectory(const std::filesystem::path& path);
+    void enqueueFile(const std::filesystem::path& path, std::string content);
+    void enqueueFile(const std::filesystem::path& path, ContentRenderer renderer);
+
+    size_t pendingFileCount() const {
+        return files_.size();
+    }
+    bool empty() const {
+        return files_.empty() && directories_.empty();
+    }
+
+    // Writes everything queued so far and clears the queue. maxWorkers == 0
+    // picks a worker count from the hardware concurrency.
+    EmitReport flush(size_t maxWorkers = 0);
+
+    void clear();
+
+   private:
+    struct PendingFile {
+        std::filesystem::path path;
+        std::string content;
+        ContentRenderer renderer;
+    };
+
+    bool createDirectoryTree(EmitReport& report) const;
+    static bool writeFile(const std::filesystem::path& path, const std::string& content,
+                          std::string& error);
+
+    std::vector<std::filesystem::path> directories_;
+    std::vector<PendingFile> files_;
+};
+
+}  // namespace utils
@@ -1,7 +1,12 @@
 #include "../core/file_utils.h"
+#include "../core/byte_scan.h"
+#include "../core/copy_engine.h"
+#include "../core/string_utils.h"
+#include "../core/tool_registry.h"
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
 #include <fstream>
 #include <stdexcept>
 #include <system_error>
@@ -12,6 +17,8 @@
 #include <windows.h>
 #else
 #include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <unistd.h>
 #endif
@@ -192,16 +199,12 @@ bool FileUtils::writeToFile(const std::string& path, const std::string& content)
 }
 
 std::string FileUtils::readFromFile(const std::string& path) {
-    try {
-        std::ifstream file(path, std::ios::binary);
-        if (!file.is_open()) {
-            throw std::runtime_error("Could not open file: " + path);
-        }
-        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
-    } catch (const std::exception& e) {
-        spdlog::error("Error reading from file: {}", e.what());
+    auto file = MappedFile::open(path);
+    if (!file) {
+        spdlog::error("Error reading from file: {}", file.message);
         return "";
     }
+    return std::move(file.value).toString();
 }
 
 bool FileUtils::fileExists(const std::string& path) {
@@ -227,40 +230,58 @@ std::vector<std::string> FileUtils::listFiles(const std::string& directory) {
 }
 
 bool FileUtils::copyFile(const std::string& source, const std::string& destination) {
-    try {
-        fs::copy_file(source, destination, fs::copy_options::overwrite_existing);
-        return true;
-    } catch (const std::exception& e) {
-        spdlog::error("Error copying file: {}", e.what());
-        return false;
+    auto result = copyFileEx(source, destination);
+    if (!result) {
+        spdlog::error("Error copying file: {}", result.message);
     }
+    return result.value;
 }
 
 bool FileUtils::copyDirectory(const std::string& source, const std::string& destination) {
-    try {
-        if (!directoryExists(destination)) {
-            createDirectory(destination);
-        }
+    auto result = copyDirectoryEx(source, destination);
+    if (!result) {
+        spdlog::error("Error copying directory: {}", result.message);
+    }
+    return result.value;
+}
 
-        for (const auto& entry : fs::directory_iterator(source)) {
-            const auto& path = entry.path();
-            const auto& targetPath = fs::path(destination) / path.filename();
+Result<bool> FileUtils::copyFileEx(const fs::path& source, const fs::path& destination,
+                                   const FileOptions& options) {
+    Result<bool> result{false, {}, {}};
+    CopyMethod method = CopyMethod::Buffered;
+    if (!CopyEngine(options, 1).copyFile(source, destination, method, result.message)) {
+        result.error = std::make_error_code(std::errc::io_error);
+        return result;
+    }
+    result.value = true;
+    return result;
+}
 
-            if (fs::is_directory(path)) {
-                if (!copyDirectory(path.string(), targetPath.string())) {
-                    return false;
-                }
-            } else {
-                if (!copyFile(path.string(), targetPath.string())) {
-                    return false;
-                }
-            }
-        }
-        return true;
-    } catch (const std::exception& e) {
-        spdlog::error("Error copying directory: {}", e.what());
-        return false;
+Result<bool> FileUtils::copyDirectoryEx(const fs::path& source, const fs::path& destination,
+                                        const FileOptions& options) {
+    Result<bool> result{false, {}, {}};
+    CopyReport report = CopyEngine(options).copyTree(source, destination);
+    if (!report.success()) {
+        const auto& first = report.failures.front();
+        result.error = std::make_error_code(std::errc::io_error);
+        result.message = std::to_string(report.failures.size()) + " entries failed to copy; " +
+                         first.first.string() + ": " + first.second;
+        return result;
     }
+    spdlog::debug("Copied {} files ({} cloned, {} linked) and {} directories from {}",
+                  report.files, report.count(CopyMethod::Clone),
+                  report.count(CopyMethod::HardLink), report.directories, source.string());
+    result.value = true;
+    return result;
+}
+
+Result<bool> FileUtils::createBackup(const fs::path& filePath) {
+    // Never a hard link: the backup must not change when the original is edited
+    FileOptions options;
+    options.createParentDirectories = false;
+    fs::path backup = filePath;
+    backup += ".bak";
+    return copyFileEx(filePath, backup, options);
 }
 
 std::string FileUtils::getFileName(const std::string& path) {
@@ -295,12 +316,331 @@ bool FileUtils::setExecutable(const std::string& filePath) {
 }
 
 bool FileUtils::commandExists(const std::string& command) {
+    return ToolRegistry::getInstance().isAvailable(command);
+}
+
+namespace {
+
+std::error_code lastSystemError() {
+#ifdef _WIN32
+    return std::error_code(static_cast<int>(GetLastError()), std::system_category());
+#else
+    return std::error_code(errno, std::generic_category());
+#endif
+}
+
+// '*' matches any run of characters and '?' any single character
+bool matchesWildcard(std::string_view name, std::string_view pattern) {
+    size_t n = 0;
+    size_t p = 0;
+    size_t starPattern = std::string_view::npos;
+    size_t starName = 0;
+    while (n < name.size()) {
+        if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == name[n])) {
+            ++n;
+            ++p;
+        } else if (p < pattern.size() && pattern[p] == '*') {
+            starPattern = p++;
+            starName = n;
+        } else if (starPattern != std::string_view::npos) {
+            p = starPattern + 1;
+            n = ++starName;
+        } else {
+            return false;
+        }
+    }
+    while (p < pattern.size() && pattern[p] == '*') {
+        ++p;
+    }
+    return p == pattern.size();
+}
+
+}  // namespace
+
+MappedFile::~MappedFile() {
+    reset();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this == &other) {
+        return *this;
+    }
+    reset();
+    mapped_ = other.mapped_;
+    size_ = other.size_;
+    buffer_ = std::move(other.buffer_);
+    // A short buffer lives inside the string object, so re-point rather than copy the pointer
+    data_ = mapped_ ? other.data_ : buffer_.data();
+#ifdef _WIN32
+    mapping_ = other.mapping_;
+    other.mapping_ = nullptr;
+#endif
+    other.data_ = "";
+    other.size_ = 0;
+    other.mapped_ = false;
+    other.buffer_.clear();
+    return *this;
+}
+
+void MappedFile::reset() {
+    if (mapped_) {
+#ifdef _WIN32
+        UnmapViewOfFile(data_);
+        CloseHandle(static_cast<HANDLE>(mapping_));
+        mapping_ = nullptr;
+#else
+        munmap(const_cast<char*>(data_), size_);
+#endif
+    }
+    data_ = "";
+    size_ = 0;
+    mapped_ = false;
+    buffer_.clear();
+}
+
+std::string MappedFile::toString() && {
+    std::string contents = mapped_ ? std::string(view()) : std::move(buffer_);
+    reset();
+    return contents;
+}
+
+Result<MappedFile> MappedFile::open(const fs::path& path) {
+    Result<MappedFile> result;
+    MappedFile& file = result.value;
+    auto fail = [&](const std::string& what) {
+        result.error = lastSystemError();
+        result.message = what + " '" + path.string() + "': " + result.error.message();
+    };
+
 #ifdef _WIN32
-    std::string cmd = "where " + command + " >nul 2>&1";
+    HANDLE handle = CreateFileW(path.c_str(), GENERIC_READ,
+                                FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+                                OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+        fail("Could not open file");
+        return result;
+    }
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(handle, &fileSize)) {
+        fail("Could not stat file");
+        CloseHandle(handle);
+        return result;
+    }
+    size_t size = static_cast<size_t>(fileSize.QuadPart);
+    if (size >= MIN_MAP_SIZE) {
+        HANDLE mapping = CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping != nullptr) {
+            void* address = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            if (address != nullptr) {
+                file.data_ = static_cast<const char*>(address);
+                file.size_ = size;
+                file.mapped_ = true;
+                file.mapping_ = mapping;
+                CloseHandle(handle);
+                return result;
+            }
+            CloseHandle(mapping);
+        }
+    }
+    // One spare byte so a file read in full reaches end-of-file without regrowing
+    file.buffer_.resize(size + 1);
+    size_t filled = 0;
+    for (;;) {
+        if (filled == file.buffer_.size()) {
+            file.buffer_.resize(file.buffer_.size() * 2);
+        }
+        DWORD chunk = static_cast<DWORD>(
+                std::min<size_t>(file.buffer_.size() - filled, 1u << 30));
+        DWORD bytesRead = 0;
+        if (!ReadFile(handle, &file.buffer_[filled], chunk, &bytesRead, nullptr)) {
+            fail("Could not read file");
+            CloseHandle(handle);
+            file.reset();
+            return result;
+        }
+        if (bytesRead == 0) {
+            break;
+        }
+        filled += bytesRead;
+    }
+    CloseHandle(handle);
 #else
-    std::string cmd = "command -v " + command + " >/dev/null 2>&1";
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        fail("Could not open file");
+        return result;
+    }
+    struct stat status {};
+    if (fstat(fd, &status) != 0) {
+        fail("Could not stat file");
+        ::close(fd);
+        return result;
+    }
+    bool regular = S_ISREG(status.st_mode);
+    size_t size = regular ? static_cast<size_t>(status.st_size) : 0;
+    if (regular && size >= MIN_MAP_SIZE) {
+        void* address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address != MAP_FAILED) {
+            madvise(address, size, MADV_SEQUENTIAL);
+            file.data_ = static_cast<const char*>(address);
+            file.size_ = size;
+            file.mapped_ = true;
+            ::close(fd);
+            return result;
+        }
+    }
+    // One spare byte so a file read in full reaches end-of-file without regrowing;
+    // the size is only a hint for pipes and files that are still growing
+    file.buffer_.resize(std::max<size_t>(size + 1, regular ? 1 : 4096));
+    size_t filled = 0;
+    for (;;) {
+        if (filled == file.buffer_.size()) {
+            file.buffer_.resize(file.buffer_.size() * 2);
+        }
+        ssize_t bytesRead = ::read(fd, &file.buffer_[filled], file.buffer_.size() - filled);
+        if (bytesRead < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            fail("Could not read file");
+            ::close(fd);
+            file.reset();
+            return result;
+        }
+        if (bytesRead == 0) {
+            break;
+        }
+        filled += static_cast<size_t>(bytesRead);
+    }
+    ::close(fd);
 #endif
-    return system(cmd.c_str()) == 0;
+    file.buffer_.resize(filled);
+    file.data_ = file.buffer_.data();
+    file.size_ = filled;
+    return result;
+}
+
+std::vector<std::string> FileUtils::readLines(const std::string& path) {
+    auto file = MappedFile::open(path);
+    if (!file) {
+        spdlog::error("Error reading lines: {}", file.message);
+        return {};
+    }
+    return StringUtils::splitLines(file.value.view());
+}
+
+size_t FileUtils::countLines(std::string_view text) {
+    return StringUtils::countLines(text);
+}
+
+Result<size_t> FileUtils::countLines(const fs::path& filePath) {
+    Result<size_t> result{0, {}, {}};
+    auto file = MappedFile::open(filePath);
+    if (!file) {
+        result.error = file.error;
+        result.message = file.message;
+        return result;
+    }
+    result.value = countLines(file.value.view());
+    return result;
+}
+
+Result<bool> FileUtils::replaceInFile(const fs::path& filePath, const std::string& search,
+                                      const std::string& replace) {
+    Result<bool> result{false, {}, {}};
+    if (search.empty()) {
+        result.error = std::make_error_code(std::errc::invalid_argument);
+        result.message = "Search string must not be empty";
+        return result;
+    }
+
+    std::string updated;
+    {
+        auto file = MappedFile::open(filePath);
+        if (!file) {
+            result.error = file.error;
+            result.message = file.message;
+            return result;
+        }
+        std::string_view text = file.value.view();
+        size_t match = ByteScan::find(text, search);
+        if (match == ByteScan::npos) {
+            return result;
+        }
+        updated.reserve(text.size());
+        size_t start = 0;
+        while (match != ByteScan::npos) {
+            updated.append(text, start, match - start);
+            updated += replace;
+            start = match + search.size();
+            match = ByteScan::find(text, search, start);
+        }
+        updated.append(text, start, std::string_view::npos);
+    }  // unmapped before the file is rewritten
+
+    std::ofstream out(filePath, std::ios::binary | std::ios::trunc);
+    if (!out || !out.write(updated.data(), static_cast<std::streamsize>(updated.size()))) {
+        result.error = std::make_error_code(std::errc::io_error);
+        result.message = "Could not write file '" + filePath.string() + "'";
+        return result;
+    }
+    result.value = true;
+    return result;
+}
+
+Result<bool> FileUtils::writeLines(const fs::path& filePath,
+                                   const std::vector<std::string>& lines) {
+    Result<bool> result{false, {}, {}};
+    size_t total = 0;
+    for (const auto& line : lines) {
+        total += line.size() + 1;
+    }
+    std::string content;
+    content.reserve(total);
+    for (const auto& line : lines) {
+        content += line;
+        content += '\n';
+    }
+    std::error_code ec;
+    if (filePath.has_parent_path()) {
+        fs::create_directories(filePath.parent_path(), ec);
+    }
+    std::ofstream out(filePath, std::ios::binary | std::ios::trunc);
+    if (!out || !out.write(content.data(), static_cast<std::streamsize>(content.size()))) {
+        result.error = std::make_error_code(std::errc::io_error);
+        result.message = "Could not write file '" + filePath.string() + "'";
+        return result;
+    }
+    result.value = true;
+    return result;
+}
+
+Result<std::vector<fs::path>> FileUtils::findFiles(const fs::path& directory,
+                                                   const std::string& pattern) {
+    Result<std::vector<fs::path>> result;
+    std::error_code ec;
+    fs::recursive_directory_iterator it(directory,
+                                        fs::directory_options::skip_permission_denied, ec);
+    if (ec) {
+        result.error = ec;
+        result.message = "Could not list directory '" + directory.string() + "': " + ec.message();
+        return result;
+    }
+    for (fs::recursive_directory_iterator end; it != end; it.increment(ec)) {
+        if (ec) {
+            break;
+        }
+        std::error_code typeError;
+        if (it->is_regular_file(typeError) &&
+            matchesWildcard(it->path().filename().string(), pattern)) {
+            result.value.push_back(it->path());
+        }
+    }
+    return result;
 }
 
 // Enhanced methods removed to simplify build
@@ -4,6 +4,7 @@
 #include <functional>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <system_error>
 #include <vector>
 
@@ -31,6 +32,7 @@ struct FileOptions {
     bool backupExisting = false;
     std::filesystem::perms permissions = std::filesystem::perms::none;
     bool followSymlinks = true;
+    bool allowHardLinks = false;  // Link instead of copying when the file cannot be cloned
 };
 
 // Directory listing options
@@ -42,6 +44,55 @@ struct ListOptions {
     std::function<bool(const std::filesystem::path&)> filter;
 };
 
+// Read-only view of a whole file. Regular files of at least MIN_MAP_SIZE bytes are
+// memory-mapped with a sequential-access hint; smaller or unmappable files (pipes,
+// /proc entries) are read once into a buffer sized from the file size. The view
+// stays valid until the object is destroyed or moved from. A mapped file that is
+// truncated by another process while it is being read faults like any mmap reader
+class MappedFile {
+   public:
+    static constexpr size_t MIN_MAP_SIZE = 64 * 1024;
+
+    MappedFile() = default;
+    ~MappedFile();
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    static Result<MappedFile> open(const std::filesystem::path& path);
+
+    std::string_view view() const {
+        return {data_, size_};
+    }
+    const char* data() const {
+        return data_;
+    }
+    size_t size() const {
+        return size_;
+    }
+    bool empty() const {
+        return size_ == 0;
+    }
+    bool isMapped() const {
+        return mapped_;
+    }
+
+    // Contents as a string; steals the read buffer instead of copying it
+    std::string toString() &&;
+
+   private:
+    void reset();
+
+    const char* data_ = "";
+    size_t size_ = 0;
+    bool mapped_ = false;
+    std::string buffer_;
+#ifdef _WIN32
+    void* mapping_ = nullptr;
+#endif
+};
+
 class FileUtils {
    public:
     // Directory operations
@@ -135,6 +186,8 @@ class FileUtils {
     static Result<bool> writeLines(const std::filesystem::path& filePath,
                                    const std::vector<std::string>& lines);
     static Result<size_t> countLines(const std::filesystem::path& filePath);
+    // Number of lines in text, counting a final line without a trailing newline
+    static size_t countLines(std::string_view text);
 
     // Validation functions
     static bool isValidPath(const std::string& path);
@@ -147,6 +200,8 @@ class FileUtils {
     static bool commandExists(const std::string& command);
     static Result<std::string> findInPath(const std::string& command);
     static Result<bool> createBackup(const std::filesystem::path& filePath);
+    // Regular files under directory (recursively) whose file name matches a
+    // '*'/'?' wildcard pattern, in directory order
     static Result<std::vector<std::filesystem::path>> findFiles(
             const std::filesystem::path& directory, const std::string& pattern);
 
@@ -0,0 +1,16 @@
+#include "forwarding_sink.h"
+
+namespace utils {
+
+ForwardingSink::ForwardingSink(std::shared_ptr<spdlog::logger> target)
+    : target_(std::move(target)) {}
+
+void ForwardingSink::sink_it_(const spdlog::details::log_msg& msg) {
+    target_->log(msg.time, msg.source, msg.level, msg.payload);
+}
+
+void ForwardingSink::flush_() {
+    target_->flush();
+}
+
+}  // namespace utils
@@ -0,0 +1,31 @@
+#pragma once
+#include <spdlog/details/null_mutex.h>
+#include <spdlog/logger.h>
+#include <spdlog/sinks/base_sink.h>
+
+#include <memory>
+
+namespace utils {
+
+// Passes every message on to another logger, keeping its timestamp and source
+// location. Lets a synchronous logger hand only some of its output (the log
+// file) to an spdlog::async_logger while its other sinks (the console) stay in
+// step with output written directly to std::cout. The target formats the
+// message with its own sinks' patterns and levels.
+class ForwardingSink : public spdlog::sinks::base_sink<spdlog::details::null_mutex> {
+   public:
+    explicit ForwardingSink(std::shared_ptr<spdlog::logger> target);
+
+    const std::shared_ptr<spdlog::logger>& target() const {
+        return target_;
+    }
+
+   protected:
+    void sink_it_(const spdlog::details::log_msg& msg) override;
+    void flush_() override;
+
+   private:
+    std::shared_ptr<spdlog::logger> target_;
+};
+
+}  // namespace utils
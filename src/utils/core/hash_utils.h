@@ -0,0 +1,65 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace utils {
+
+// Incremental SHA-1, as used for git object ids and index checksums.
+// Not meant for anything security sensitive.
+class Sha1 {
+   public:
+    using Digest = std::array<uint8_t, 20>;
+
+    Sha1();
+
+    void update(const void* data, size_t size);
+    void update(std::string_view data) {
+        update(data.data(), data.size());
+    }
+
+    // Finishes the hash; the object must not be updated afterwards
+    Digest finish();
+
+    static Digest hash(std::string_view data);
+    static std::string toHex(const Digest& digest);
+
+   private:
+    void processBlock(const uint8_t* block);
+
+    std::array<uint32_t, 5> state_;
+    std::array<uint8_t, 64> buffer_{};
+    size_t buffered_ = 0;
+    uint64_t totalBytes_ = 0;
+};
+
+// Incremental SHA-256, used to address cached downloads by content
+class Sha256 {
+   public:
+    using Digest = std::array<uint8_t, 32>;
+
+    Sha256();
+
+    void update(const void* data, size_t size);
+    void update(std::string_view data) {
+        update(data.data(), data.size());
+    }
+
+    // Finishes the hash; the object must not be updated afterwards
+    Digest finish();
+
+    static Digest hash(std::string_view data);
+    static std::string toHex(const Digest& digest);
+
+   private:
+    void processBlock(const uint8_t* block);
+
+    std::array<uint32_t, 8> state_;
+    std::array<uint8_t, 64> buffer_{};
+    size_t buffered_ = 0;
+    uint64_t totalBytes_ = 0;
+};
+
+}  // namespace utils
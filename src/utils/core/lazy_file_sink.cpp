@@ -0,0 +1,62 @@
+#include "lazy_file_sink.h"
+
+#include <iostream>
+
+namespace utils {
+
+LazyRotatingFileSink::LazyRotatingFileSink(std::filesystem::path path, size_t maxFileSize,
+                                           size_t maxFiles)
+    : path_(std::move(path)), maxFileSize_(maxFileSize), maxFiles_(maxFiles) {}
+
+bool LazyRotatingFileSink::isOpen() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return file_ != nullptr;
+}
+
+void LazyRotatingFileSink::sink_it_(const spdlog::details::log_msg& msg) {
+    if (file_ || open()) {
+        file_->log(msg);
+    }
+}
+
+void LazyRotatingFileSink::flush_() {
+    if (file_) {
+        file_->flush();
+    }
+}
+
+void LazyRotatingFileSink::set_pattern_(const std::string& pattern) {
+    base_sink::set_pattern_(pattern);
+    if (file_) {
+        file_->set_formatter(formatter_->clone());
+    }
+}
+
+void LazyRotatingFileSink::set_formatter_(std::unique_ptr<spdlog::formatter> formatter) {
+    base_sink::set_formatter_(std::move(formatter));
+    if (file_) {
+        file_->set_formatter(formatter_->clone());
+    }
+}
+
+bool LazyRotatingFileSink::open() {
+    if (failed_) {
+        return false;
+    }
+    try {
+        std::error_code ec;
+        if (path_.has_parent_path()) {
+            std::filesystem::create_directories(path_.parent_path(), ec);
+        }
+        file_ = std::make_unique<spdlog::sinks::rotating_file_sink_st>(path_.string(),
+                                                                       maxFileSize_, maxFiles_);
+        file_->set_formatter(formatter_->clone());
+        return true;
+    } catch (const spdlog::spdlog_ex& ex) {
+        failed_ = true;
+        std::cerr << "Log file " << path_.string() << " unavailable: " << ex.what() << "\n";
+        return false;
+    }
+}
+
+}  // namespace utils
@@ -0,0 +1,42 @@
+#pragma once
+#include <spdlog/sinks/base_sink.h>
+#include <spdlog/sinks/rotating_file_sink.h>
+
+#include <filesystem>
+#include <memory>
+#include <mutex>
+
+namespace utils {
+
+// Rotating file sink that creates its directory and opens the file on the
+// first message it receives. Runs that log nothing to it (--help, --version,
+// non-verbose runs below the sink level) never touch the disk. If the file
+// cannot be opened the sink reports it once on stderr and discards messages.
+class LazyRotatingFileSink : public spdlog::sinks::base_sink<std::mutex> {
+   public:
+    LazyRotatingFileSink(std::filesystem::path path, size_t maxFileSize, size_t maxFiles);
+
+    const std::filesystem::path& path() const {
+        return path_;
+    }
+
+    // True once the file has been opened
+    bool isOpen();
+
+   protected:
+    void sink_it_(const spdlog::details::log_msg& msg) override;
+    void flush_() override;
+    void set_pattern_(const std::string& pattern) override;
+    void set_formatter_(std::unique_ptr<spdlog::formatter> formatter) override;
+
+   private:
+    bool open();
+
+    std::filesystem::path path_;
+    size_t maxFileSize_;
+    size_t maxFiles_;
+    bool failed_ = false;
+    std::unique_ptr<spdlog::sinks::rotating_file_sink_st> file_;
+};
+
+}  // namespace utils
@@ -0,0 +1,1022 @@
+#include "logging_manager.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <sstream>
+
+namespace utils {
+
+namespace {
+
+// Category and message bytes stored inline in a queue slot; anything longer
+// (or carrying metadata) is handed over as a heap-allocated LogEntry
+constexpr size_t kSlotTextBytes = 200;
+constexpr size_t kDefaultQueueSize = 4096;
+
+// Set on the writer thread, whose own log calls (e.g. from a destination)
+// must not wait for the queue it is supposed to drain
+thread_local bool tl_isLogWriter = false;
+
+// Marks the calling thread as a user of the ring for its lifetime. The
+// increment and the following running_ check are both sequentially
+// consistent, so a stopping thread either sees the count or the producer
+// sees running_ cleared
+class RingUser {
+public:
+    explicit RingUser(std::atomic<size_t>& users) : users_(users) { users_.fetch_add(1); }
+    ~RingUser() { users_.fetch_sub(1); }
+    RingUser(const RingUser&) = delete;
+    RingUser& operator=(const RingUser&) = delete;
+
+private:
+    std::atomic<size_t>& users_;
+};
+
+size_t roundUpToPowerOfTwo(size_t value) {
+    size_t result = 2;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+const char* levelName(LogLevel level) {
+    switch (level) {
+        case LogLevel::Trace:
+            return "trace";
+        case LogLevel::Debug:
+            return "debug";
+        case LogLevel::Info:
+            return "info";
+        case LogLevel::Warning:
+            return "warning";
+        case LogLevel::Error:
+            return "error";
+        case LogLevel::Critical:
+            return "critical";
+        case LogLevel::Off:
+            return "off";
+    }
+    return "unknown";
+}
+
+std::optional<LogLevel> parseLevel(const std::string& name) {
+    for (int i = 0; i <= static_cast<int>(LogLevel::Off); ++i) {
+        if (name == levelName(static_cast<LogLevel>(i))) {
+            return static_cast<LogLevel>(i);
+        }
+    }
+    return std::nullopt;
+}
+
+// Local time with milliseconds, e.g. 2024-05-01 13:37:00.123
+std::string formatLocalTime(const std::chrono::system_clock::time_point& timestamp) {
+    auto time = std::chrono::system_clock::to_time_t(timestamp);
+    auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(
+                          timestamp.time_since_epoch())
+                          .count() %
+                  1000;
+    std::tm tm{};
+#ifdef _WIN32
+    localtime_s(&tm, &time);
+#else
+    localtime_r(&time, &tm);
+#endif
+    char buffer[32];
+    size_t length = std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &tm);
+    std::snprintf(buffer + length, sizeof(buffer) - length, ".%03d", static_cast<int>(millis));
+    return buffer;
+}
+
+std::string threadIdString(std::thread::id id) {
+    std::ostringstream ss;
+    ss << id;
+    return ss.str();
+}
+
+LogEntry makeEntry(LogLevel level, std::string_view category, std::string_view message,
+                   const SourceLocation& location) {
+    LogEntry entry;
+    entry.level = level;
+    entry.category.assign(category.data(), category.size());
+    entry.message.assign(message.data(), message.size());
+    entry.file = location.file ? location.file : "";
+    entry.line = location.line;
+    entry.function = location.function ? location.function : "";
+    entry.threadId = std::this_thread::get_id();
+    entry.timestamp = std::chrono::system_clock::now();
+    return entry;
+}
+
+}  // namespace
+
+// One preallocated queue entry. sequence implements the handshake of a
+// bounded Vyukov queue: equal to the position when free for that lap, and
+// position + 1 once published
+struct LogSlot {
+    std::atomic<size_t> sequence{0};
+    LogLevel level = LogLevel::Info;
+    SourceLocation location;
+    std::chrono::system_clock::time_point timestamp;
+    std::thread::id threadId;
+    uint16_t categoryLength = 0;
+    uint16_t messageLength = 0;
+    char text[kSlotTextBytes];
+    std::unique_ptr<LogEntry> heapEntry;
+};
+
+// Bounded multi-producer single-consumer ring of LogSlots. Producers claim a
+// position with one CAS; the writer thread is the only consumer
+class LogRingBuffer {
+public:
+    explicit LogRingBuffer(size_t capacity)
+        : slots_(new LogSlot[capacity]), mask_(capacity - 1) {
+        for (size_t i = 0; i < capacity; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    // Returns a slot owned by the caller until publish(), or nullptr if full
+    LogSlot* tryClaim(size_t& position) {
+        size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+        while (true) {
+            LogSlot& slot = slots_[pos & mask_];
+            size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    position = pos;
+                    return &slot;
+                }
+            } else if (diff < 0) {
+                return nullptr;
+            } else {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void publish(LogSlot* slot, size_t position) {
+        slot->sequence.store(position + 1, std::memory_order_release);
+    }
+
+    // Consumer side: the next published slot, or nullptr if none is ready
+    LogSlot* front() {
+        size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+        LogSlot& slot = slots_[pos & mask_];
+        if (slot.sequence.load(std::memory_order_acquire) != pos + 1) {
+            return nullptr;
+        }
+        return &slot;
+    }
+
+    void pop(LogSlot* slot) {
+        size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+        slot->sequence.store(pos + mask_ + 1, std::memory_order_release);
+        dequeuePos_.store(pos + 1, std::memory_order_release);
+    }
+
+    size_t enqueuePosition() const { return enqueuePos_.load(std::memory_order_acquire); }
+    size_t dequeuePosition() const { return dequeuePos_.load(std::memory_order_acquire); }
+
+    size_t size() const {
+        size_t tail = dequeuePosition();
+        size_t head = enqueuePosition();
+        return head > tail ? head - tail : 0;
+    }
+
+    size_t capacity() const { return mask_ + 1; }
+
+private:
+    std::unique_ptr<LogSlot[]> slots_;
+    size_t mask_;
+    alignas(64) std::atomic<size_t> enqueuePos_{0};
+    alignas(64) std::atomic<size_t> dequeuePos_{0};
+};
+
+// ConsoleDestination
+
+ConsoleDestination::ConsoleDestination(bool useColors) : useColors_(useColors) {}
+
+void ConsoleDestination::write(const LogEntry& entry) {
+    std::string line = formatEntry(entry);
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::ostream& out = entry.level >= LogLevel::Warning ? std::cerr : std::cout;
+    if (useColors_) {
+        out << getColorForLevel(entry.level) << line << "\033[0m\n";
+    } else {
+        out << line << '\n';
+    }
+}
+
+void ConsoleDestination::flush() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::cout.flush();
+    std::cerr.flush();
+}
+
+void ConsoleDestination::close() {
+    flush();
+}
+
+std::string ConsoleDestination::formatEntry(const LogEntry& entry) {
+    return LoggingManager::getInstance().formatEntry(entry);
+}
+
+std::string ConsoleDestination::getColorForLevel(LogLevel level) {
+    switch (level) {
+        case LogLevel::Trace:
+            return "\033[90m";
+        case LogLevel::Debug:
+            return "\033[36m";
+        case LogLevel::Info:
+            return "\033[32m";
+        case LogLevel::Warning:
+            return "\033[33m";
+        case LogLevel::Error:
+            return "\033[31m";
+        case LogLevel::Critical:
+            return "\033[1;31m";
+        default:
+            return "";
+    }
+}
+
+// FileDestination
+
+FileDestination::FileDestination(const std::filesystem::path& filePath, bool rotateDaily,
+                                 size_t maxFileSizeMB)
+    : filePath_(filePath),
+      rotateDaily_(rotateDaily),
+      maxFileSizeMB_(maxFileSizeMB),
+      currentFileSizeBytes_(0) {
+    std::error_code ec;
+    if (filePath_.has_parent_path()) {
+        std::filesystem::create_directories(filePath_.parent_path(), ec);
+    }
+    currentFileSizeBytes_ = std::filesystem::exists(filePath_, ec)
+                                    ? static_cast<size_t>(std::filesystem::file_size(filePath_, ec))
+                                    : 0;
+    currentDateString_ = LoggingManager::getCurrentTimestamp().substr(0, 10);
+    fileStream_ = std::make_unique<std::ofstream>(filePath_, std::ios::binary | std::ios::app);
+}
+
+FileDestination::~FileDestination() {
+    close();
+}
+
+void FileDestination::write(const LogEntry& entry) {
+    std::string line = formatEntry(entry);
+    line += '\n';
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    rotateIfNeeded();
+    if (fileStream_ && fileStream_->is_open()) {
+        fileStream_->write(line.data(), static_cast<std::streamsize>(line.size()));
+        currentFileSizeBytes_ += line.size();
+    }
+}
+
+void FileDestination::flush() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fileStream_) {
+        fileStream_->flush();
+    }
+}
+
+void FileDestination::close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fileStream_) {
+        fileStream_->close();
+    }
+}
+
+void FileDestination::rotateIfNeeded() {
+    std::string today = LoggingManager::getCurrentTimestamp().substr(0, 10);
+    bool dayChanged = rotateDaily_ && today != currentDateString_;
+    bool tooLarge = maxFileSizeMB_ > 0 && currentFileSizeBytes_ >= maxFileSizeMB_ * 1024 * 1024;
+    if (!dayChanged && !tooLarge) {
+        return;
+    }
+
+    fileStream_->close();
+    createRotatedFileName();
+    currentDateString_ = today;
+    currentFileSizeBytes_ = 0;
+    fileStream_ = std::make_unique<std::ofstream>(filePath_, std::ios::binary | std::ios::trunc);
+}
+
+// Moves the current file aside as <stem>.<date>[.<n>]<ext>
+void FileDestination::createRotatedFileName() {
+    std::filesystem::path base = filePath_.parent_path() /
+                                 (filePath_.stem().string() + "." + currentDateString_);
+    std::filesystem::path rotated = base;
+    rotated += filePath_.extension();
+    std::error_code ec;
+    for (int n = 1; std::filesystem::exists(rotated, ec); ++n) {
+        rotated = base;
+        rotated += "." + std::to_string(n) + filePath_.extension().string();
+    }
+    std::filesystem::rename(filePath_, rotated, ec);
+}
+
+std::string FileDestination::formatEntry(const LogEntry& entry) {
+    return LoggingManager::getInstance().formatEntry(entry);
+}
+
+// StandardFormatter
+
+StandardFormatter::StandardFormatter(const std::string& pattern) : pattern_(pattern) {}
+
+std::string StandardFormatter::format(const LogEntry& entry) {
+    std::string result;
+    result.reserve(pattern_.size() + entry.message.size() + 32);
+
+    size_t pos = 0;
+    while (pos < pattern_.size()) {
+        size_t open = pattern_.find('{', pos);
+        size_t close = open == std::string::npos ? open : pattern_.find('}', open);
+        if (close == std::string::npos) {
+            result.append(pattern_, pos, std::string::npos);
+            break;
+        }
+        result.append(pattern_, pos, open - pos);
+
+        std::string_view token(pattern_.data() + open + 1, close - open - 1);
+        if (token == "timestamp") {
+            result += formatTimestamp(entry.timestamp);
+        } else if (token == "level") {
+            result += levelToString(entry.level);
+        } else if (token == "category") {
+            result += entry.category;
+        } else if (token == "message") {
+            result += entry.message;
+        } else if (token == "file") {
+            result += entry.file;
+        } else if (token == "line") {
+            result += std::to_string(entry.line);
+        } else if (token == "function") {
+            result += entry.function;
+        } else if (token == "thread") {
+            result += threadIdString(entry.threadId);
+        } else {
+            result.append(pattern_, open, close - open + 1);
+        }
+        pos = close + 1;
+    }
+    return result;
+}
+
+std::string StandardFormatter::formatTimestamp(
+        const std::chrono::system_clock::time_point& timestamp) {
+    return formatLocalTime(timestamp);
+}
+
+std::string StandardFormatter::levelToString(LogLevel level) {
+    return levelName(level);
+}
+
+// JsonFormatter
+
+JsonFormatter::JsonFormatter(bool prettyPrint) : prettyPrint_(prettyPrint) {}
+
+std::string JsonFormatter::format(const LogEntry& entry) {
+    nlohmann::json json = {
+            {"timestamp", std::chrono::duration_cast<std::chrono::milliseconds>(
+                                  entry.timestamp.time_since_epoch())
+                                  .count()},
+            {"level", levelName(entry.level)},
+            {"category", entry.category},
+            {"message", entry.message},
+            {"thread", threadIdString(entry.threadId)}};
+    if (!entry.file.empty()) {
+        json["file"] = entry.file;
+        json["line"] = entry.line;
+        json["function"] = entry.function;
+    }
+    if (!entry.metadata.empty()) {
+        json["metadata"] = entry.metadata;
+    }
+    return json.dump(prettyPrint_ ? 2 : -1, ' ', false,
+                     nlohmann::json::error_handler_t::replace);
+}
+
+// LoggingManager
+
+LoggingManager& LoggingManager::getInstance() {
+    static LoggingManager instance;
+    return instance;
+}
+
+LoggingManager::LoggingManager()
+    : globalLogLevel_(LogLevel::Info),
+      hasCategoryLevels_(false),
+      defaultFormatter_(std::make_unique<StandardFormatter>()),
+      asyncMode_(false),
+      running_(false),
+      ringUsers_(0),
+      writerSleeping_(false),
+      maxQueueSize_(kDefaultQueueSize),
+      overflowPolicy_(OverflowPolicy::Drop),
+      totalLogs_(0),
+      droppedLogs_(0),
+      blockedLogs_(0),
+      overflowLogs_(0),
+      maxQueueDepth_(0),
+      loggingTimeNs_(0),
+      startTime_(std::chrono::steady_clock::now()) {
+    for (auto& count : logsPerLevel_) {
+        count.store(0, std::memory_order_relaxed);
+    }
+    destinations_.push_back(std::make_unique<ConsoleDestination>());
+}
+
+LoggingManager::~LoggingManager() {
+    stopAsyncLogging();
+    close();
+}
+
+void LoggingManager::setLogLevel(LogLevel level) {
+    globalLogLevel_.store(level, std::memory_order_relaxed);
+}
+
+LogLevel LoggingManager::getLogLevel() const {
+    return globalLogLevel_.load(std::memory_order_relaxed);
+}
+
+void LoggingManager::setGlobalLogLevel(LogLevel level) {
+    setLogLevel(level);
+}
+
+void LoggingManager::setCategoryLogLevel(const std::string& category, LogLevel level) {
+    std::lock_guard<std::mutex> lock(levelsMutex_);
+    categoryLogLevels_[category] = level;
+    hasCategoryLevels_.store(true, std::memory_order_release);
+}
+
+void LoggingManager::addDestination(std::unique_ptr<LogDestination> destination) {
+    std::lock_guard<std::mutex> lock(destinationsMutex_);
+    destinations_.push_back(std::move(destination));
+}
+
+void LoggingManager::removeDestination(const std::string& name) {
+    std::lock_guard<std::mutex> lock(destinationsMutex_);
+    destinations_.erase(std::remove_if(destinations_.begin(), destinations_.end(),
+                                       [&name](const std::unique_ptr<LogDestination>& d) {
+                                           return d->getName() == name;
+                                       }),
+                        destinations_.end());
+}
+
+void LoggingManager::clearDestinations() {
+    std::lock_guard<std::mutex> lock(destinationsMutex_);
+    destinations_.clear();
+}
+
+std::vector<std::string> LoggingManager::getDestinationNames() const {
+    std::lock_guard<std::mutex> lock(destinationsMutex_);
+    std::vector<std::string> names;
+    for (const auto& destination : destinations_) {
+        names.push_back(destination->getName());
+    }
+    return names;
+}
+
+void LoggingManager::setFormatter(std::unique_ptr<LogFormatter> formatter) {
+    std::lock_guard<std::mutex> lock(destinationsMutex_);
+    defaultFormatter_ = std::move(formatter);
+}
+
+void LoggingManager::setCategoryFormatter(const std::string& category,
+                                          std::unique_ptr<LogFormatter> formatter) {
+    std::lock_guard<std::mutex> lock(destinationsMutex_);
+    categoryFormatters_[category] = std::move(formatter);
+}
+
+std::string LoggingManager::formatEntry(const LogEntry& entry) const {
+    LogFormatter* formatter = getFormatter(entry.category);
+    return formatter ? formatter->format(entry) : entry.message;
+}
+
+void LoggingManager::log(LogLevel level, std::string_view category, std::string_view message,
+                         const SourceLocation& location) {
+    if (!shouldLog(level, category)) {
+        return;
+    }
+    if (running_.load(std::memory_order_acquire) && !tl_isLogWriter) {
+        RingUser user(ringUsers_);
+        if (running_.load()) {
+            if (enqueue(level, category, message, location, nullptr)) {
+                countLog(level);
+            }
+            return;
+        }
+    }
+    countLog(level);
+    processLogEntry(makeEntry(level, category, message, location));
+}
+
+void LoggingManager::log(LogLevel level, std::string_view category, std::string_view message,
+                         const std::string& file, int line, const std::string& function) {
+    if (!shouldLog(level, category)) {
+        return;
+    }
+    // The strings are not static, so they travel as a full entry
+    LogEntry entry = makeEntry(level, category, message, SourceLocation{});
+    entry.file = file;
+    entry.line = line;
+    entry.function = function;
+    log(entry);
+}
+
+void LoggingManager::log(const LogEntry& entry) {
+    if (!shouldLog(entry.level, entry.category)) {
+        return;
+    }
+    if (running_.load(std::memory_order_acquire) && !tl_isLogWriter) {
+        RingUser user(ringUsers_);
+        if (running_.load()) {
+            if (enqueue(entry.level, {}, {}, {}, std::make_unique<LogEntry>(entry))) {
+                countLog(entry.level);
+            }
+            return;
+        }
+    }
+    countLog(entry.level);
+    processLogEntry(entry);
+}
+
+void LoggingManager::trace(std::string_view message, std::string_view category) {
+    log(LogLevel::Trace, category, message);
+}
+
+void LoggingManager::debug(std::string_view message, std::string_view category) {
+    log(LogLevel::Debug, category, message);
+}
+
+void LoggingManager::info(std::string_view message, std::string_view category) {
+    log(LogLevel::Info, category, message);
+}
+
+void LoggingManager::warning(std::string_view message, std::string_view category) {
+    log(LogLevel::Warning, category, message);
+}
+
+void LoggingManager::error(std::string_view message, std::string_view category) {
+    log(LogLevel::Error, category, message);
+}
+
+void LoggingManager::critical(std::string_view message, std::string_view category) {
+    log(LogLevel::Critical, category, message);
+}
+
+void LoggingManager::logWithMetadata(LogLevel level, const std::string& category,
+                                     const std::string& message,
+                                     const std::unordered_map<std::string, std::string>& metadata,
+                                     const std::string& file, int line,
+                                     const std::string& function) {
+    if (!shouldLog(level, category)) {
+        return;
+    }
+    LogEntry entry = makeEntry(level, category, message, SourceLocation{});
+    entry.file = file;
+    entry.line = line;
+    entry.function = function;
+    entry.metadata = metadata;
+    log(entry);
+}
+
+bool LoggingManager::enqueue(LogLevel level, std::string_view category, std::string_view message,
+                             const SourceLocation& location,
+                             std::unique_ptr<LogEntry> heapEntry) {
+    if (!heapEntry && category.size() + message.size() > kSlotTextBytes) {
+        heapEntry = std::make_unique<LogEntry>(makeEntry(level, category, message, location));
+        overflowLogs_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    size_t position = 0;
+    LogSlot* slot = ring_->tryClaim(position);
+    if (!slot) {
+        if (overflowPolicy_.load(std::memory_order_relaxed) == OverflowPolicy::Drop) {
+            droppedLogs_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        blockedLogs_.fetch_add(1, std::memory_order_relaxed);
+        while (!(slot = ring_->tryClaim(position))) {
+            if (!running_.load(std::memory_order_acquire)) {
+                // The writer went away while we waited; write it ourselves
+                processLogEntry(heapEntry ? *heapEntry
+                                          : makeEntry(level, category, message, location));
+                return true;
+            }
+            wakeWriter();
+            std::this_thread::yield();
+        }
+    }
+
+    slot->level = level;
+    slot->location = location;
+    slot->timestamp = std::chrono::system_clock::now();
+    slot->threadId = std::this_thread::get_id();
+    if (heapEntry) {
+        slot->heapEntry = std::move(heapEntry);
+        slot->categoryLength = 0;
+        slot->messageLength = 0;
+    } else {
+        std::memcpy(slot->text, category.data(), category.size());
+        std::memcpy(slot->text + category.size(), message.data(), message.size());
+        slot->categoryLength = static_cast<uint16_t>(category.size());
+        slot->messageLength = static_cast<uint16_t>(message.size());
+    }
+    ring_->publish(slot, position);
+
+    size_t depth = ring_->size();
+    size_t seen = maxQueueDepth_.load(std::memory_order_relaxed);
+    while (depth > seen &&
+           !maxQueueDepth_.compare_exchange_weak(seen, depth, std::memory_order_relaxed)) {
+    }
+
+    // Pairs with the fence in asyncLoggingLoop so either the writer sees the
+    // entry before sleeping or we see it sleeping and wake it
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    wakeWriter();
+    return true;
+}
+
+void LoggingManager::wakeWriter() {
+    if (writerSleeping_.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        queueCondition_.notify_one();
+    }
+}
+
+void LoggingManager::asyncLoggingLoop() {
+    tl_isLogWriter = true;
+
+    // Reused for every inline entry so steady-state logging does not allocate
+    LogEntry entry;
+    while (true) {
+        LogSlot* slot = ring_->front();
+        if (!slot) {
+            if (!running_.load(std::memory_order_acquire)) {
+                break;
+            }
+            std::unique_lock<std::mutex> lock(queueMutex_);
+            writerSleeping_.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (!ring_->front() && running_.load(std::memory_order_acquire)) {
+                queueCondition_.wait_for(lock, std::chrono::milliseconds(100));
+            }
+            writerSleeping_.store(false, std::memory_order_relaxed);
+            continue;
+        }
+
+        writeSlot(slot, entry);
+    }
+
+    tl_isLogWriter = false;
+}
+
+// Hands a published slot to the destinations with the producer's timestamp
+// and thread, then frees it. entry is scratch space reused across calls
+void LoggingManager::writeSlot(LogSlot* slot, LogEntry& entry) {
+    if (slot->heapEntry) {
+        processLogEntry(*slot->heapEntry);
+        slot->heapEntry.reset();
+    } else {
+        entry.level = slot->level;
+        entry.category.assign(slot->text, slot->categoryLength);
+        entry.message.assign(slot->text + slot->categoryLength, slot->messageLength);
+        entry.file.assign(slot->location.file ? slot->location.file : "");
+        entry.line = slot->location.line;
+        entry.function.assign(slot->location.function ? slot->location.function : "");
+        entry.threadId = slot->threadId;
+        entry.timestamp = slot->timestamp;
+        processLogEntry(entry);
+    }
+    ring_->pop(slot);
+}
+
+void LoggingManager::processLogEntry(const LogEntry& entry) {
+    auto start = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(destinationsMutex_);
+        for (const auto& destination : destinations_) {
+            destination->write(entry);
+        }
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    loggingTimeNs_.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+                             std::memory_order_relaxed);
+}
+
+LogFormatter* LoggingManager::getFormatter(const std::string& category) const {
+    auto it = categoryFormatters_.find(category);
+    if (it != categoryFormatters_.end() && it->second) {
+        return it->second.get();
+    }
+    return defaultFormatter_.get();
+}
+
+void LoggingManager::countLog(LogLevel level) {
+    totalLogs_.fetch_add(1, std::memory_order_relaxed);
+    logsPerLevel_[static_cast<int>(level)].fetch_add(1, std::memory_order_relaxed);
+}
+
+PerformanceMetrics LoggingManager::getMetrics() const {
+    PerformanceMetrics metrics;
+    metrics.totalLogs = totalLogs_.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < 7; ++i) {
+        metrics.logsPerLevel[i] = logsPerLevel_[i].load(std::memory_order_relaxed);
+    }
+    auto total = std::chrono::nanoseconds(loggingTimeNs_.load(std::memory_order_relaxed));
+    metrics.totalLoggingTime = std::chrono::duration_cast<std::chrono::milliseconds>(total);
+    if (metrics.totalLogs > 0) {
+        metrics.avgLoggingTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+                total / static_cast<int64_t>(metrics.totalLogs));
+    }
+    metrics.droppedLogs = droppedLogs_.load(std::memory_order_relaxed);
+    metrics.blockedLogs = blockedLogs_.load(std::memory_order_relaxed);
+    metrics.overflowLogs = overflowLogs_.load(std::memory_order_relaxed);
+    metrics.maxQueueSize = maxQueueDepth_.load(std::memory_order_relaxed);
+    RingUser user(ringUsers_);
+    if (running_.load()) {
+        metrics.queueSize = ring_->size();
+        metrics.queueCapacity = ring_->capacity();
+    } else {
+        metrics.queueCapacity = roundUpToPowerOfTwo(maxQueueSize_);
+    }
+    metrics.overflowPolicy = overflowPolicy_.load(std::memory_order_relaxed);
+    return metrics;
+}
+
+void LoggingManager::resetMetrics() {
+    totalLogs_.store(0, std::memory_order_relaxed);
+    for (auto& count : logsPerLevel_) {
+        count.store(0, std::memory_order_relaxed);
+    }
+    droppedLogs_.store(0, std::memory_order_relaxed);
+    blockedLogs_.store(0, std::memory_order_relaxed);
+    overflowLogs_.store(0, std::memory_order_relaxed);
+    maxQueueDepth_.store(0, std::memory_order_relaxed);
+    loggingTimeNs_.store(0, std::memory_order_relaxed);
+    startTime_ = std::chrono::steady_clock::now();
+}
+
+void LoggingManager::setMaxQueueSize(size_t maxSize) {
+    maxQueueSize_ = std::max<size_t>(maxSize, 2);
+}
+
+void LoggingManager::setOverflowPolicy(OverflowPolicy policy) {
+    overflowPolicy_.store(policy, std::memory_order_relaxed);
+}
+
+OverflowPolicy LoggingManager::getOverflowPolicy() const {
+    return overflowPolicy_.load(std::memory_order_relaxed);
+}
+
+void LoggingManager::setAsyncMode(bool async) {
+    asyncMode_.store(async);
+    if (async) {
+        startAsyncLogging();
+    } else {
+        stopAsyncLogging();
+    }
+}
+
+bool LoggingManager::isAsyncMode() const {
+    return asyncMode_.load();
+}
+
+void LoggingManager::flush() {
+    if (running_.load(std::memory_order_acquire) && !tl_isLogWriter) {
+        RingUser user(ringUsers_);
+        // Everything claimed so far is written once the writer passes it
+        size_t target = running_.load() ? ring_->enqueuePosition() : 0;
+        while (running_.load(std::memory_order_acquire) && ring_->dequeuePosition() < target) {
+            wakeWriter();
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(destinationsMutex_);
+    for (const auto& destination : destinations_) {
+        destination->flush();
+    }
+}
+
+void LoggingManager::close() {
+    flush();
+    std::lock_guard<std::mutex> lock(destinationsMutex_);
+    for (const auto& destination : destinations_) {
+        destination->close();
+    }
+}
+
+void LoggingManager::startAsyncLogging() {
+    std::lock_guard<std::mutex> lifecycle(lifecycleMutex_);
+    if (running_.load()) {
+        return;
+    }
+    // The last stop waited for every ring user, so nothing still points into
+    // the old ring
+    size_t capacity = roundUpToPowerOfTwo(maxQueueSize_);
+    if (!ring_ || ring_->capacity() != capacity) {
+        ring_ = std::make_unique<LogRingBuffer>(capacity);
+    }
+    asyncMode_.store(true);
+    running_.store(true, std::memory_order_release);
+    loggingThread_ = std::make_unique<std::thread>(&LoggingManager::asyncLoggingLoop, this);
+}
+
+void LoggingManager::stopAsyncLogging() {
+    std::lock_guard<std::mutex> lifecycle(lifecycleMutex_);
+    if (!running_.exchange(false)) {
+        return;
+    }
+    asyncMode_.store(false);
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        queueCondition_.notify_one();
+    }
+    if (loggingThread_ && loggingThread_->joinable()) {
+        loggingThread_->join();
+    }
+    loggingThread_.reset();
+
+    // Producers that saw running_ set may not have claimed their slot yet;
+    // once they are gone every claimed slot is published and new callers
+    // write synchronously
+    while (ringUsers_.load() != 0) {
+        std::this_thread::yield();
+    }
+
+    // Entries published after the writer saw the queue empty for the last time
+    tl_isLogWriter = true;
+    LogEntry entry;
+    while (LogSlot* slot = ring_->front()) {
+        writeSlot(slot, entry);
+    }
+    tl_isLogWriter = false;
+}
+
+bool LoggingManager::shouldLog(LogLevel level, std::string_view category) const {
+    if (level == LogLevel::Off) {
+        return false;
+    }
+    if (!category.empty() && hasCategoryLevels_.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(levelsMutex_);
+        auto it = categoryLogLevels_.find(std::string(category));
+        if (it != categoryLogLevels_.end()) {
+            return level >= it->second;
+        }
+    }
+    return level >= globalLogLevel_.load(std::memory_order_relaxed);
+}
+
+std::string LoggingManager::formatLogLevel(LogLevel level) {
+    return levelName(level);
+}
+
+std::string LoggingManager::getCurrentTimestamp() {
+    return formatLocalTime(std::chrono::system_clock::now());
+}
+
+std::string LoggingManager::getThreadId() {
+    return threadIdString(std::this_thread::get_id());
+}
+
+bool LoggingManager::loadConfiguration(const std::filesystem::path& configFile) {
+    try {
+        std::ifstream file(configFile);
+        if (!file) {
+            return false;
+        }
+        nlohmann::json config = nlohmann::json::parse(file);
+
+        if (auto level = parseLevel(config.value("level", std::string()))) {
+            setLogLevel(*level);
+        }
+        if (config.contains("categories")) {
+            for (const auto& [category, name] : config["categories"].items()) {
+                if (auto level = parseLevel(name.get<std::string>())) {
+                    setCategoryLogLevel(category, *level);
+                }
+            }
+        }
+        if (config.contains("queueSize")) {
+            setMaxQueueSize(config["queueSize"].get<size_t>());
+        }
+        if (config.contains("overflowPolicy")) {
+            setOverflowPolicy(config["overflowPolicy"].get<std::string>() == "block"
+                                      ? OverflowPolicy::Block
+                                      : OverflowPolicy::Drop);
+        }
+        if (config.contains("async")) {
+            setAsyncMode(config["async"].get<bool>());
+        }
+        return true;
+
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+bool LoggingManager::saveConfiguration(const std::filesystem::path& configFile) const {
+    nlohmann::json config;
+    config["level"] = levelName(getLogLevel());
+    config["async"] = isAsyncMode();
+    config["queueSize"] = maxQueueSize_;
+    config["overflowPolicy"] = getOverflowPolicy() == OverflowPolicy::Block ? "block" : "drop";
+    config["categories"] = nlohmann::json::object();
+    {
+        std::lock_guard<std::mutex> lock(levelsMutex_);
+        for (const auto& [category, level] : categoryLogLevels_) {
+            config["categories"][category] = levelName(level);
+        }
+    }
+
+    std::ofstream file(configFile);
+    file << config.dump(2);
+    return static_cast<bool>(file);
+}
+
+void LoggingManager::handleSignal(int signal) {
+#ifdef SIGHUP
+    if (signal == SIGHUP) {
+        flush();
+        return;
+    }
+#endif
+    if (signal == SIGINT || signal == SIGTERM) {
+        stopAsyncLogging();
+        flush();
+    }
+}
+
+// ScopedLogger
+
+ScopedLogger::ScopedLogger(const std::string& scope, LogLevel level)
+    : scope_(scope), level_(level), startTime_(std::chrono::steady_clock::now()) {
+    LoggingManager::getInstance().log(level_, scope_, "Entering " + scope_);
+}
+
+ScopedLogger::~ScopedLogger() {
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - startTime_);
+    LoggingManager::getInstance().logWithMetadata(
+            level_, scope_, "Leaving " + scope_ + " after " + std::to_string(elapsed.count()) + " ms",
+            metadata_);
+}
+
+void ScopedLogger::setMetadata(const std::string& key, const std::string& value) {
+    metadata_[key] = value;
+}
+
+void ScopedLogger::log(LogLevel level, const std::string& message) {
+    LoggingManager::getInstance().log(level, scope_, message);
+}
+
+// PerformanceTimer
+
+PerformanceTimer::PerformanceTimer(const std::string& name, LogLevel level)
+    : name_(name),
+      level_(level),
+      startTime_(std::chrono::steady_clock::now()),
+      lastCheckpoint_(startTime_),
+      finished_(false) {}
+
+PerformanceTimer::~PerformanceTimer() {
+    if (!finished_) {
+        finish();
+    }
+}
+
+void PerformanceTimer::checkpoint(const std::string& checkpointName) {
+    auto now = std::chrono::steady_clock::now();
+    auto sinceLast = std::chrono::duration_cast<std::chrono::microseconds>(now - lastCheckpoint_);
+    lastCheckpoint_ = now;
+    LoggingManager::getInstance().log(
+            level_, "timer",
+            name_ + ": " + checkpointName + " took " + std::to_string(sinceLast.count()) + " us");
+}
+
+void PerformanceTimer::finish() {
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - startTime_);
+    finished_ = true;
+    LoggingManager::getInstance().log(
+            level_, "timer", name_ + " finished in " + std::to_string(elapsed.count()) + " us");
+}
+
+}  // namespace utils
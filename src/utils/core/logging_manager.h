@@ -1,14 +1,16 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include <vector>
 #include <memory>
 #include <unordered_map>
 #include <filesystem>
 #include <chrono>
+#include <iosfwd>
+#include <cstdint>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
-#include <queue>
 #include <functional>
 #include <atomic>
 
@@ -25,6 +27,21 @@ enum class LogLevel {
     Off = 6
 };
 
+// Where a log call was made. Built from __FILE__/__LINE__/__func__ by the
+// LOG_* macros, so the pointers refer to static storage and can be handed to
+// the writer thread without copying
+struct SourceLocation {
+    const char* file = nullptr;
+    int line = 0;
+    const char* function = nullptr;
+};
+
+// What a producer does when the async queue is full
+enum class OverflowPolicy {
+    Drop,   // Discard the entry and count it in PerformanceMetrics::droppedLogs
+    Block   // Wait for the writer to free a slot (counted in blockedLogs)
+};
+
 // Log entry structure
 struct LogEntry {
     LogLevel level;
@@ -145,13 +162,20 @@ private:
 struct PerformanceMetrics {
     size_t totalLogs = 0;
     size_t logsPerLevel[7] = {0}; // One for each LogLevel
-    std::chrono::milliseconds totalLoggingTime{0};
+    std::chrono::milliseconds totalLoggingTime{0};  // Spent writing to destinations
     std::chrono::milliseconds avgLoggingTime{0};
-    size_t droppedLogs = 0;
-    size_t queueSize = 0;
-    size_t maxQueueSize = 0;
+    size_t droppedLogs = 0;     // Discarded because the queue was full (Drop policy)
+    size_t blockedLogs = 0;     // Producers that had to wait for a slot (Block policy)
+    size_t overflowLogs = 0;    // Entries too large for a slot, sent through the heap
+    size_t queueSize = 0;       // Entries waiting for the writer right now
+    size_t maxQueueSize = 0;    // High-water mark of queueSize
+    size_t queueCapacity = 0;
+    OverflowPolicy overflowPolicy = OverflowPolicy::Drop;
 };
 
+class LogRingBuffer;
+struct LogSlot;
+
 // Async logging manager
 class LoggingManager {
 public:
@@ -172,19 +196,27 @@ public:
     // Formatters
     void setFormatter(std::unique_ptr<LogFormatter> formatter);
     void setCategoryFormatter(const std::string& category, std::unique_ptr<LogFormatter> formatter);
+
+    // Formats with the category's formatter, else the default one. Called by
+    // destinations from write(), i.e. on the writer thread in async mode
+    std::string formatEntry(const LogEntry& entry) const;
     
-    // Logging methods
-    void log(LogLevel level, const std::string& category, const std::string& message,
-             const std::string& file = "", int line = 0, const std::string& function = "");
+    // Logging methods. In async mode short messages are copied into a
+    // preallocated queue slot without allocating or locking; the LogEntry is
+    // built and formatted on the writer thread
+    void log(LogLevel level, std::string_view category, std::string_view message,
+             const SourceLocation& location = {});
+    void log(LogLevel level, std::string_view category, std::string_view message,
+             const std::string& file, int line, const std::string& function = "");
     void log(const LogEntry& entry);
     
     // Convenience logging methods
-    void trace(const std::string& message, const std::string& category = "");
-    void debug(const std::string& message, const std::string& category = "");
-    void info(const std::string& message, const std::string& category = "");
-    void warning(const std::string& message, const std::string& category = "");
-    void error(const std::string& message, const std::string& category = "");
-    void critical(const std::string& message, const std::string& category = "");
+    void trace(std::string_view message, std::string_view category = {});
+    void debug(std::string_view message, std::string_view category = {});
+    void info(std::string_view message, std::string_view category = {});
+    void warning(std::string_view message, std::string_view category = {});
+    void error(std::string_view message, std::string_view category = {});
+    void critical(std::string_view message, std::string_view category = {});
     
     // Advanced logging with metadata
     void logWithMetadata(LogLevel level, const std::string& category, const std::string& message,
@@ -194,18 +226,23 @@ public:
     // Performance and monitoring
     PerformanceMetrics getMetrics() const;
     void resetMetrics();
+    // Queue capacity in entries, rounded up to a power of two. Takes effect
+    // the next time async logging starts
     void setMaxQueueSize(size_t maxSize);
+    void setOverflowPolicy(OverflowPolicy policy);
+    OverflowPolicy getOverflowPolicy() const;
     void setAsyncMode(bool async);
     bool isAsyncMode() const;
     
-    // Control methods
+    // Control methods. flush() waits until everything logged before the call
+    // has been written
     void flush();
     void close();
     void startAsyncLogging();
     void stopAsyncLogging();
     
     // Utility methods
-    bool shouldLog(LogLevel level, const std::string& category = "") const;
+    bool shouldLog(LogLevel level, std::string_view category = {}) const;
     std::string formatLogLevel(LogLevel level);
     static std::string getCurrentTimestamp();
     static std::string getThreadId();
@@ -225,32 +262,50 @@ private:
     LoggingManager& operator=(const LoggingManager&) = delete;
     
     // Core members
-    LogLevel globalLogLevel_;
+    std::atomic<LogLevel> globalLogLevel_;
     std::unordered_map<std::string, LogLevel> categoryLogLevels_;
+    std::atomic<bool> hasCategoryLevels_;
+    mutable std::mutex levelsMutex_;
     std::vector<std::unique_ptr<LogDestination>> destinations_;
     std::unique_ptr<LogFormatter> defaultFormatter_;
     std::unordered_map<std::string, std::unique_ptr<LogFormatter>> categoryFormatters_;
+    mutable std::mutex destinationsMutex_;  // Also guards the formatters
     
-    // Async logging
+    // Async logging: a bounded multi-producer single-consumer ring drained by
+    // loggingThread_, which sleeps on queueCondition_ only when it is empty.
+    // ringUsers_ counts threads that may touch ring_; stopping waits for it
+    // to reach zero before the final drain, so ring_ is only replaced idle
     std::atomic<bool> asyncMode_;
     std::atomic<bool> running_;
+    mutable std::atomic<size_t> ringUsers_;
+    std::mutex lifecycleMutex_;  // Serializes start and stop
     std::unique_ptr<std::thread> loggingThread_;
-    std::queue<LogEntry> logQueue_;
+    std::unique_ptr<LogRingBuffer> ring_;
     std::mutex queueMutex_;
     std::condition_variable queueCondition_;
+    std::atomic<bool> writerSleeping_;
     size_t maxQueueSize_;
+    std::atomic<OverflowPolicy> overflowPolicy_;
     
-    // Performance metrics
-    mutable std::mutex metricsMutex_;
-    PerformanceMetrics metrics_;
+    // Performance metrics, updated without locks on the logging path
+    std::atomic<size_t> totalLogs_;
+    std::atomic<size_t> logsPerLevel_[7];
+    std::atomic<size_t> droppedLogs_;
+    std::atomic<size_t> blockedLogs_;
+    std::atomic<size_t> overflowLogs_;
+    std::atomic<size_t> maxQueueDepth_;
+    std::atomic<int64_t> loggingTimeNs_;
     std::chrono::steady_clock::time_point startTime_;
     
     // Internal methods
     void processLogEntry(const LogEntry& entry);
     void asyncLoggingLoop();
+    void writeSlot(LogSlot* slot, LogEntry& entry);
     LogFormatter* getFormatter(const std::string& category) const;
-    void updateMetrics(LogLevel level, std::chrono::milliseconds duration);
-    bool enqueueLogEntry(const LogEntry& entry);
+    void countLog(LogLevel level);
+    bool enqueue(LogLevel level, std::string_view category, std::string_view message,
+                 const SourceLocation& location, std::unique_ptr<LogEntry> heapEntry);
+    void wakeWriter();
 };
 
 // Scoped logger for RAII-style logging
@@ -288,16 +343,21 @@ private:
 
 } // namespace utils
 
-// Convenience macros for logging
-#define LOG_TRACE(message) utils::LoggingManager::getInstance().trace(message, __FILE__ ":" + std::to_string(__LINE__))
-#define LOG_DEBUG(message) utils::LoggingManager::getInstance().debug(message, __FILE__ ":" + std::to_string(__LINE__))
-#define LOG_INFO(message) utils::LoggingManager::getInstance().info(message, __FILE__ ":" + std::to_string(__LINE__))
-#define LOG_WARNING(message) utils::LoggingManager::getInstance().warning(message, __FILE__ ":" + std::to_string(__LINE__))
-#define LOG_ERROR(message) utils::LoggingManager::getInstance().error(message, __FILE__ ":" + std::to_string(__LINE__))
-#define LOG_CRITICAL(message) utils::LoggingManager::getInstance().critical(message, __FILE__ ":" + std::to_string(__LINE__))
+// Convenience macros for logging. The source location is captured as string
+// literals at compile time; nothing is formatted or allocated at the call site
+#define LOG_SOURCE_LOCATION() utils::SourceLocation{__FILE__, __LINE__, __func__}
+
+#define LOG_AT(level, category, message) \
+    utils::LoggingManager::getInstance().log(level, category, message, LOG_SOURCE_LOCATION())
+
+#define LOG_TRACE(message) LOG_AT(utils::LogLevel::Trace, {}, message)
+#define LOG_DEBUG(message) LOG_AT(utils::LogLevel::Debug, {}, message)
+#define LOG_INFO(message) LOG_AT(utils::LogLevel::Info, {}, message)
+#define LOG_WARNING(message) LOG_AT(utils::LogLevel::Warning, {}, message)
+#define LOG_ERROR(message) LOG_AT(utils::LogLevel::Error, {}, message)
+#define LOG_CRITICAL(message) LOG_AT(utils::LogLevel::Critical, {}, message)
 
-#define LOG_CATEGORY(level, category, message) \
-    utils::LoggingManager::getInstance().log(level, category, message, __FILE__, __LINE__, __FUNCTION__)
+#define LOG_CATEGORY(level, category, message) LOG_AT(level, category, message)
 
 #define LOG_SCOPED(scope) utils::ScopedLogger __scoped_logger__(scope)
 #define LOG_TIMER(name) utils::PerformanceTimer __perf_timer__(name)
@@ -0,0 +1,39 @@
+#include "../core/parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace utils {
+
+size_t parallelWorkerCount(size_t count, size_t maxWorkers) {
+    size_t workers = maxWorkers != 0 ? maxWorkers : std::thread::hardware_concurrency();
+    return std::clamp<size_t>(workers, 1, std::max<size_t>(count, 1));
+}
+
+void parallelFor(size_t count, size_t maxWorkers, const std::function<void(size_t)>& fn) {
+    if (count == 0) {
+        return;
+    }
+
+    std::atomic<size_t> next{0};
+    auto worker = [&]() {
+        for (size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+            fn(i);
+        }
+    };
+
+    size_t workers = parallelWorkerCount(count, maxWorkers);
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for (size_t i = 1; i < workers; ++i) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : pool) {
+        thread.join();
+    }
+}
+
+}  // namespace utils
@@ -0,0 +1,17 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+
+namespace utils {
+
+// Number of threads parallelFor uses for count items: maxWorkers, or
+// hardware_concurrency() when it is 0, clamped to [1, count].
+size_t parallelWorkerCount(size_t count, size_t maxWorkers);
+
+// Calls fn(i) once for every i in [0, count), on parallelWorkerCount()
+// threads including the calling one, and returns when all calls are done.
+// Indices are handed out one at a time from a shared counter, so items of
+// uneven cost balance across the workers. fn must not throw.
+void parallelFor(size_t count, size_t maxWorkers, const std::function<void(size_t)>& fn);
+
+}  // namespace utils
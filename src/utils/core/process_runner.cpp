@@ -0,0 +1,685 @@
+#include "../core/process_runner.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string_view>
+#include <thread>
+
+#include "../core/tool_registry.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+
+#include <cwchar>
+#include <utility>
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+#endif
+
+namespace utils {
+
+namespace {
+std::string quoteArgument(const std::string& arg) {
+    if (!arg.empty() && arg.find_first_of(" \t\"'\\$`") == std::string::npos) {
+        return arg;
+    }
+    std::string quoted = "\"";
+    for (char c : arg) {
+        if (c == '"' || c == '\\') {
+            quoted += '\\';
+        }
+        quoted += c;
+    }
+    quoted += '"';
+    return quoted;
+}
+
+#ifdef _WIN32
+std::wstring widen(const std::string& text) {
+    if (text.empty()) {
+        return {};
+    }
+    int length = MultiByteToWideChar(CP_UTF8, 0, text.data(), static_cast<int>(text.size()),
+                                     nullptr, 0);
+    std::wstring wide(static_cast<size_t>(length), L'\0');
+    MultiByteToWideChar(CP_UTF8, 0, text.data(), static_cast<int>(text.size()), &wide[0], length);
+    return wide;
+}
+
+// Quotes one argument so the child's C runtime (CommandLineToArgvW rules)
+// splits it back into exactly the original string
+std::wstring quoteWindowsArgument(const std::wstring& arg) {
+    if (!arg.empty() && arg.find_first_of(L" \t\n\v\"") == std::wstring::npos) {
+        return arg;
+    }
+    std::wstring quoted = L"\"";
+    size_t backslashes = 0;
+    for (wchar_t c : arg) {
+        if (c == L'\\') {
+            ++backslashes;
+            continue;
+        }
+        // Backslashes are only special right before a quote
+        quoted.append(c == L'"' ? backslashes * 2 + 1 : backslashes, L'\\');
+        backslashes = 0;
+        quoted += c;
+    }
+    quoted.append(backslashes * 2, L'\\');
+    quoted += L'"';
+    return quoted;
+}
+
+// The parent's environment with the overrides applied, as a CreateProcessW
+// block. Variable names compare case-insensitively on Windows.
+std::wstring buildEnvironmentBlock(const std::map<std::string, std::string>& overrides) {
+    std::vector<std::wstring> names;
+    for (const auto& entry : overrides) {
+        names.push_back(widen(entry.first));
+    }
+
+    std::wstring block;
+    if (LPWCH inherited = GetEnvironmentStringsW()) {
+        for (LPWCH entry = inherited; *entry; entry += wcslen(entry) + 1) {
+            std::wstring_view var(entry);
+            // Per-drive directories are stored as "=C:=C:\dir", so skip a leading '='
+            auto name = var.substr(0, var.find(L'=', 1));
+            bool overridden = std::any_of(names.begin(), names.end(), [&](const std::wstring& n) {
+                return CompareStringOrdinal(n.data(), static_cast<int>(n.size()), name.data(),
+                                            static_cast<int>(name.size()), TRUE) == CSTR_EQUAL;
+            });
+            if (!overridden) {
+                block.append(var);
+                block.push_back(L'\0');
+            }
+        }
+        FreeEnvironmentStringsW(inherited);
+    }
+    for (const auto& [name, value] : overrides) {
+        block += widen(name + "=" + value);
+        block.push_back(L'\0');
+    }
+    // The block ends with an empty string; c_str() supplies the final terminator
+    block.push_back(L'\0');
+    return block;
+}
+
+class Handle {
+   public:
+    Handle() = default;
+    explicit Handle(HANDLE handle) {
+        reset(handle);
+    }
+    ~Handle() {
+        reset();
+    }
+    Handle(const Handle&) = delete;
+    Handle& operator=(const Handle&) = delete;
+
+    HANDLE get() const {
+        return handle_;
+    }
+    HANDLE* out() {
+        reset();
+        return &handle_;
+    }
+    void reset(HANDLE handle = nullptr) {
+        if (handle_) {
+            CloseHandle(handle_);
+        }
+        handle_ = handle == INVALID_HANDLE_VALUE ? nullptr : handle;
+    }
+
+   private:
+    HANDLE handle_ = nullptr;
+};
+
+// Only the write end is inheritable; the read end stays with us
+bool createOutputPipe(Handle& read, Handle& write) {
+    SECURITY_ATTRIBUTES security{sizeof(security), nullptr, TRUE};
+    return CreatePipe(read.out(), write.out(), &security, 0) &&
+           SetHandleInformation(read.get(), HANDLE_FLAG_INHERIT, 0);
+}
+
+HANDLE openNullDevice(DWORD access) {
+    SECURITY_ATTRIBUTES security{sizeof(security), nullptr, TRUE};
+    return CreateFileW(L"NUL", access, FILE_SHARE_READ | FILE_SHARE_WRITE, &security,
+                       OPEN_EXISTING, 0, nullptr);
+}
+
+// An inheritable duplicate of one of our standard handles, or null if we have none
+HANDLE inheritableCopy(DWORD which) {
+    HANDLE source = GetStdHandle(which);
+    HANDLE copy = nullptr;
+    if (!source || source == INVALID_HANDLE_VALUE ||
+        !DuplicateHandle(GetCurrentProcess(), source, GetCurrentProcess(), &copy, 0, TRUE,
+                         DUPLICATE_SAME_ACCESS)) {
+        return nullptr;
+    }
+    return copy;
+}
+
+// Reads whatever is buffered; returns false once the child closed its end
+bool drain(HANDLE pipe, std::string& sink, bool& received) {
+    char buffer[4096];
+    while (true) {
+        DWORD available = 0;
+        if (!PeekNamedPipe(pipe, nullptr, 0, nullptr, &available, nullptr)) {
+            return false;  // ERROR_BROKEN_PIPE
+        }
+        if (available == 0) {
+            return true;
+        }
+        DWORD n = 0;
+        if (!ReadFile(pipe, buffer, std::min<DWORD>(available, sizeof(buffer)), &n, nullptr)) {
+            return false;
+        }
+        sink.append(buffer, n);
+        received = true;
+    }
+}
+#else
+// Grace period between SIGTERM and SIGKILL once a timeout has expired
+constexpr auto TERMINATE_GRACE = std::chrono::milliseconds(200);
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 29))
+#define PROCESS_RUNNER_HAS_ADDCHDIR 1
+#elif defined(__APPLE__)
+#define PROCESS_RUNNER_HAS_ADDCHDIR 1
+#endif
+
+class FileActions {
+   public:
+    FileActions() {
+        posix_spawn_file_actions_init(&actions_);
+    }
+    ~FileActions() {
+        posix_spawn_file_actions_destroy(&actions_);
+    }
+    posix_spawn_file_actions_t* get() {
+        return &actions_;
+    }
+
+   private:
+    posix_spawn_file_actions_t actions_;
+};
+
+class Pipe {
+   public:
+    Pipe() = default;
+    ~Pipe() {
+        closeRead();
+        closeWrite();
+    }
+
+    bool open() {
+        int fds[2];
+        // Close-on-exec must be set atomically, otherwise a child spawned by
+        // another thread could inherit the write end and delay our EOF
+#ifdef __linux__
+        if (pipe2(fds, O_CLOEXEC) != 0) {
+            return false;
+        }
+#else
+        if (pipe(fds) != 0) {
+            return false;
+        }
+        fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+        fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+#endif
+        read_ = fds[0];
+        write_ = fds[1];
+        fcntl(read_, F_SETFL, fcntl(read_, F_GETFL) | O_NONBLOCK);
+        return true;
+    }
+    int readEnd() const {
+        return read_;
+    }
+    int writeEnd() const {
+        return write_;
+    }
+    void closeRead() {
+        if (read_ >= 0) {
+            close(read_);
+            read_ = -1;
+        }
+    }
+    void closeWrite() {
+        if (write_ >= 0) {
+            close(write_);
+            write_ = -1;
+        }
+    }
+
+   private:
+    int read_ = -1;
+    int write_ = -1;
+};
+
+// Reads whatever is available; returns false once the pipe reached EOF
+bool drain(int fd, std::string& sink) {
+    char buffer[4096];
+    while (true) {
+        ssize_t n = read(fd, buffer, sizeof(buffer));
+        if (n > 0) {
+            sink.append(buffer, static_cast<size_t>(n));
+            continue;
+        }
+        if (n == 0) {
+            return false;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        // EAGAIN: nothing more for now; anything else is treated as EOF
+        return errno == EAGAIN || errno == EWOULDBLOCK;
+    }
+}
+
+void recordStatus(int status, ProcessResult& result) {
+    if (WIFEXITED(status)) {
+        result.exitCode = WEXITSTATUS(status);
+    } else if (WIFSIGNALED(status)) {
+        result.signal = WTERMSIG(status);
+    }
+}
+
+// Polls for exit until the deadline; returns true if the child was reaped
+bool waitUntil(pid_t pid, std::chrono::steady_clock::time_point deadline,
+               ProcessResult& result) {
+    auto delay = std::chrono::milliseconds(1);
+    while (true) {
+        int status = 0;
+        pid_t done = waitpid(pid, &status, WNOHANG);
+        if (done == pid) {
+            recordStatus(status, result);
+            return true;
+        }
+        if (done < 0 && errno != EINTR) {
+            return true;
+        }
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(delay);
+        delay = std::min(delay * 2, std::chrono::milliseconds(20));
+    }
+}
+
+void terminate(pid_t pid, ProcessResult& result) {
+    kill(pid, SIGTERM);
+    if (!waitUntil(pid, std::chrono::steady_clock::now() + TERMINATE_GRACE, result)) {
+        kill(pid, SIGKILL);
+        int status = 0;
+        while (waitpid(pid, &status, 0) < 0 && errno == EINTR) {
+        }
+        recordStatus(status, result);
+    }
+}
+#endif
+}  // namespace
+
+std::string ProcessRunner::formatCommand(const std::vector<std::string>& command) {
+    std::string line;
+    for (const auto& arg : command) {
+        if (!line.empty()) {
+            line += ' ';
+        }
+        line += quoteArgument(arg);
+    }
+    return line;
+}
+
+bool ProcessRunner::succeeds(const std::vector<std::string>& command,
+                             const ProcessOptions& options) {
+    return run(command, options).success();
+}
+
+#ifdef _WIN32
+
+ProcessResult ProcessRunner::run(const std::vector<std::string>& command,
+                                 const ProcessOptions& options) {
+    ProcessResult result;
+    if (command.empty()) {
+        result.errorMessage = "Empty command";
+        return result;
+    }
+
+    // Bare program names are looked up once through the tool registry
+    std::string program = command[0];
+    if (program.find_first_of("/\\") == std::string::npos) {
+        auto resolved = ToolRegistry::getInstance().find(program);
+        if (!resolved) {
+            result.errorMessage = "Command not found: " + program;
+            return result;
+        }
+        program = resolved->string();
+    }
+
+    std::wstring commandLine = quoteWindowsArgument(widen(program));
+    for (size_t i = 1; i < command.size(); ++i) {
+        commandLine += L' ';
+        commandLine += quoteWindowsArgument(widen(command[i]));
+    }
+
+    bool captureError = options.captureError && !options.discardStderr && !options.mergeStderr;
+    Handle outRead;
+    Handle outWrite;
+    Handle errRead;
+    Handle errWrite;
+    if ((options.captureOutput && !createOutputPipe(outRead, outWrite)) ||
+        (captureError && !createOutputPipe(errRead, errWrite))) {
+        result.errorMessage = "Failed to create pipe (error " + std::to_string(GetLastError()) + ")";
+        return result;
+    }
+
+    Handle input(openNullDevice(GENERIC_READ));
+    Handle inheritedOutput;
+    Handle inheritedError;
+    HANDLE stdoutHandle = outWrite.get();
+    if (!options.captureOutput) {
+        inheritedOutput.reset(inheritableCopy(STD_OUTPUT_HANDLE));
+        stdoutHandle = inheritedOutput.get();
+    }
+    HANDLE stderrHandle = errWrite.get();
+    if (options.discardStderr) {
+        inheritedError.reset(openNullDevice(GENERIC_WRITE));
+        stderrHandle = inheritedError.get();
+    } else if (options.mergeStderr) {
+        stderrHandle = stdoutHandle;
+    } else if (!captureError) {
+        inheritedError.reset(inheritableCopy(STD_ERROR_HANDLE));
+        stderrHandle = inheritedError.get();
+    }
+
+    // Only these handles reach the child, so a process started concurrently
+    // from another thread cannot hold our pipes open and delay EOF
+    std::vector<HANDLE> inherit;
+    for (HANDLE handle : {input.get(), stdoutHandle, stderrHandle}) {
+        if (handle && std::find(inherit.begin(), inherit.end(), handle) == inherit.end()) {
+            inherit.push_back(handle);
+        }
+    }
+    SIZE_T attributeSize = 0;
+    InitializeProcThreadAttributeList(nullptr, 1, 0, &attributeSize);
+    std::vector<char> attributeStorage(attributeSize);
+    auto attributes = reinterpret_cast<LPPROC_THREAD_ATTRIBUTE_LIST>(attributeStorage.data());
+    if (!InitializeProcThreadAttributeList(attributes, 1, 0, &attributeSize)) {
+        result.errorMessage =
+                "Failed to prepare process attributes (error " + std::to_string(GetLastError()) + ")";
+        return result;
+    }
+    bool restrictHandles = !inherit.empty();
+    if (restrictHandles &&
+        !UpdateProcThreadAttribute(attributes, 0, PROC_THREAD_ATTRIBUTE_HANDLE_LIST, inherit.data(),
+                                   inherit.size() * sizeof(HANDLE), nullptr, nullptr)) {
+        result.errorMessage =
+                "Failed to prepare process attributes (error " + std::to_string(GetLastError()) + ")";
+        DeleteProcThreadAttributeList(attributes);
+        return result;
+    }
+
+    STARTUPINFOEXW startup{};
+    startup.StartupInfo.cb = sizeof(startup);
+    startup.StartupInfo.dwFlags = STARTF_USESTDHANDLES;
+    startup.StartupInfo.hStdInput = input.get();
+    startup.StartupInfo.hStdOutput = stdoutHandle;
+    startup.StartupInfo.hStdError = stderrHandle;
+    startup.lpAttributeList = restrictHandles ? attributes : nullptr;
+
+    std::wstring environment;
+    if (!options.environment.empty()) {
+        environment = buildEnvironmentBlock(options.environment);
+    }
+    std::wstring workingDirectory = options.workingDirectory.wstring();
+    std::wstring application = widen(program);
+
+    PROCESS_INFORMATION process{};
+    BOOL created = CreateProcessW(
+            application.c_str(), &commandLine[0], nullptr, nullptr, restrictHandles ? TRUE : FALSE,
+            CREATE_UNICODE_ENVIRONMENT | EXTENDED_STARTUPINFO_PRESENT,
+            environment.empty() ? nullptr : &environment[0],
+            workingDirectory.empty() ? nullptr : workingDirectory.c_str(), &startup.StartupInfo,
+            &process);
+    DWORD createError = GetLastError();
+    DeleteProcThreadAttributeList(attributes);
+    // The child holds its own copies now; ours would keep the pipes from reaching EOF
+    outWrite.reset();
+    errWrite.reset();
+    input.reset();
+    inheritedOutput.reset();
+    inheritedError.reset();
+    if (!created) {
+        result.errorMessage =
+                "Failed to start " + command[0] + " (error " + std::to_string(createError) + ")";
+        spdlog::debug("{}", result.errorMessage);
+        return result;
+    }
+    Handle processHandle(process.hProcess);
+    CloseHandle(process.hThread);
+    result.started = true;
+
+    const bool hasTimeout = options.timeout.count() > 0;
+    const auto deadline = std::chrono::steady_clock::now() + options.timeout;
+
+    // Anonymous pipes cannot be waited on, so both are polled until the child
+    // closes them (or time runs out), backing off while they stay quiet
+    auto delay = std::chrono::milliseconds(1);
+    while (outRead.get() || errRead.get()) {
+        bool received = false;
+        for (auto [pipe, sink] : {std::pair<Handle*, std::string*>{&outRead, &result.output},
+                                  std::pair<Handle*, std::string*>{&errRead, &result.error}}) {
+            if (pipe->get() && !drain(pipe->get(), *sink, received)) {
+                pipe->reset();
+            }
+        }
+        if (!outRead.get() && !errRead.get()) {
+            break;
+        }
+        if (hasTimeout && std::chrono::steady_clock::now() >= deadline) {
+            result.timedOut = true;
+            break;
+        }
+        delay = received ? std::chrono::milliseconds(1)
+                         : std::min(delay * 2, std::chrono::milliseconds(20));
+        std::this_thread::sleep_for(delay);
+    }
+
+    if (!result.timedOut) {
+        DWORD waitMs = INFINITE;
+        if (hasTimeout) {
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    deadline - std::chrono::steady_clock::now());
+            waitMs = static_cast<DWORD>(std::max<long long>(remaining.count(), 0));
+        }
+        result.timedOut = WaitForSingleObject(processHandle.get(), waitMs) == WAIT_TIMEOUT;
+    }
+    if (result.timedOut) {
+        spdlog::warn("Command timed out after {} ms: {}", options.timeout.count(),
+                     formatCommand(command));
+        TerminateProcess(processHandle.get(), 1);
+        WaitForSingleObject(processHandle.get(), INFINITE);
+        return result;
+    }
+
+    DWORD exitCode = 0;
+    if (GetExitCodeProcess(processHandle.get(), &exitCode)) {
+        result.exitCode = static_cast<int>(exitCode);
+    }
+    return result;
+}
+
+#else
+
+ProcessResult ProcessRunner::run(const std::vector<std::string>& command,
+                                 const ProcessOptions& options) {
+    ProcessResult result;
+    if (command.empty()) {
+        result.errorMessage = "Empty command";
+        return result;
+    }
+
+    // Bare program names are looked up once through the tool registry
+    std::string program = command[0];
+    if (program.find('/') == std::string::npos) {
+        auto resolved = ToolRegistry::getInstance().find(program);
+        if (!resolved) {
+            result.errorMessage = "Command not found: " + program;
+            return result;
+        }
+        program = resolved->string();
+    }
+
+    bool captureError = options.captureError && !options.discardStderr && !options.mergeStderr;
+    Pipe outPipe;
+    Pipe errPipe;
+    if ((options.captureOutput && !outPipe.open()) || (captureError && !errPipe.open())) {
+        result.errorMessage = std::string("Failed to create pipe: ") + std::strerror(errno);
+        return result;
+    }
+
+    FileActions actions;
+    posix_spawn_file_actions_addopen(actions.get(), STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+    if (options.captureOutput) {
+        posix_spawn_file_actions_adddup2(actions.get(), outPipe.writeEnd(), STDOUT_FILENO);
+    }
+    if (options.discardStderr) {
+        posix_spawn_file_actions_addopen(actions.get(), STDERR_FILENO, "/dev/null", O_WRONLY, 0);
+    } else if (options.mergeStderr) {
+        posix_spawn_file_actions_adddup2(actions.get(), STDOUT_FILENO, STDERR_FILENO);
+    } else if (captureError) {
+        posix_spawn_file_actions_adddup2(actions.get(), errPipe.writeEnd(), STDERR_FILENO);
+    }
+    if (!options.workingDirectory.empty()) {
+#ifdef PROCESS_RUNNER_HAS_ADDCHDIR
+        posix_spawn_file_actions_addchdir_np(actions.get(), options.workingDirectory.c_str());
+#else
+        result.errorMessage = "Working directory is not supported on this platform";
+        return result;
+#endif
+    }
+
+    posix_spawnattr_t attr;
+    posix_spawnattr_init(&attr);
+    sigset_t noSignals;
+    sigemptyset(&noSignals);
+    posix_spawnattr_setsigmask(&attr, &noSignals);
+    posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETSIGMASK);
+
+    std::vector<char*> argv;
+    argv.reserve(command.size() + 1);
+    argv.push_back(const_cast<char*>(program.c_str()));
+    for (size_t i = 1; i < command.size(); ++i) {
+        argv.push_back(const_cast<char*>(command[i].c_str()));
+    }
+    argv.push_back(nullptr);
+
+    std::vector<std::string> envStorage;
+    std::vector<char*> envp;
+    char** environment = environ;
+    if (!options.environment.empty()) {
+        for (char** entry = environ; *entry; ++entry) {
+            std::string_view var(*entry);
+            auto name = std::string(var.substr(0, var.find('=')));
+            if (!options.environment.count(name)) {
+                envp.push_back(*entry);
+            }
+        }
+        for (const auto& [name, value] : options.environment) {
+            envStorage.push_back(name + "=" + value);
+        }
+        for (auto& var : envStorage) {
+            envp.push_back(var.data());
+        }
+        envp.push_back(nullptr);
+        environment = envp.data();
+    }
+
+    pid_t pid = 0;
+    int rc = posix_spawn(&pid, program.c_str(), actions.get(), &attr, argv.data(), environment);
+    posix_spawnattr_destroy(&attr);
+    outPipe.closeWrite();
+    errPipe.closeWrite();
+    if (rc != 0) {
+        result.errorMessage = "Failed to start " + command[0] + ": " + std::strerror(rc);
+        spdlog::debug("{}", result.errorMessage);
+        return result;
+    }
+    result.started = true;
+
+    const bool hasTimeout = options.timeout.count() > 0;
+    const auto deadline = std::chrono::steady_clock::now() + options.timeout;
+
+    // Drain both pipes until the child closes them (or time runs out)
+    std::vector<pollfd> fds;
+    std::vector<std::string*> sinks;
+    if (outPipe.readEnd() >= 0) {
+        fds.push_back({outPipe.readEnd(), POLLIN, 0});
+        sinks.push_back(&result.output);
+    }
+    if (errPipe.readEnd() >= 0) {
+        fds.push_back({errPipe.readEnd(), POLLIN, 0});
+        sinks.push_back(&result.error);
+    }
+    size_t openPipes = fds.size();
+    while (openPipes > 0) {
+        int waitMs = -1;
+        if (hasTimeout) {
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    deadline - std::chrono::steady_clock::now());
+            if (remaining.count() <= 0) {
+                result.timedOut = true;
+                break;
+            }
+            waitMs = static_cast<int>(remaining.count());
+        }
+
+        int ready = poll(fds.data(), fds.size(), waitMs);
+        if (ready < 0 && errno != EINTR) {
+            break;
+        }
+        for (size_t i = 0; i < fds.size(); ++i) {
+            if (fds[i].fd >= 0 && fds[i].revents != 0) {
+                if (!drain(fds[i].fd, *sinks[i])) {
+                    fds[i].fd = -1;  // poll() ignores negative descriptors
+                    --openPipes;
+                }
+            }
+        }
+    }
+
+    if (!result.timedOut) {
+        if (hasTimeout) {
+            result.timedOut = !waitUntil(pid, deadline, result);
+        } else {
+            int status = 0;
+            while (waitpid(pid, &status, 0) < 0 && errno == EINTR) {
+            }
+            recordStatus(status, result);
+        }
+    }
+    if (result.timedOut) {
+        spdlog::warn("Command timed out after {} ms: {}", options.timeout.count(),
+                     formatCommand(command));
+        terminate(pid, result);
+    }
+
+    return result;
+}
+
+#endif
+
+}  // namespace utils
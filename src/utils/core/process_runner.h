@@ -0,0 +1,63 @@
+#pragma once
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace utils {
+
+// Options for a single child process
+struct ProcessOptions {
+    std::filesystem::path workingDirectory;  // Empty = inherit
+    std::chrono::milliseconds timeout{0};    // 0 = wait indefinitely
+    bool captureOutput = true;               // Collect stdout (otherwise inherited)
+    bool captureError = true;                // Collect stderr (otherwise inherited)
+    bool mergeStderr = false;                // Append stderr to output instead of error
+    bool discardStderr = false;              // Send stderr to the null device
+    std::map<std::string, std::string> environment;  // Added to the inherited environment
+};
+
+// Outcome of running a child process
+struct ProcessResult {
+    bool started = false;  // False when the program could not be spawned
+    bool timedOut = false;
+    int exitCode = -1;     // Valid when the process exited normally
+    int signal = 0;        // Terminating signal, 0 if none
+    std::string output;    // Captured stdout (and stderr when merged)
+    std::string error;     // Captured stderr
+    std::string errorMessage;  // Why the process could not be started
+
+    bool success() const {
+        return started && !timedOut && signal == 0 && exitCode == 0;
+    }
+};
+
+// Runs external programs without going through a shell.
+//
+// The command is an argv vector, so arguments are passed verbatim and never
+// need quoting. On POSIX systems children are started with posix_spawn,
+// stdin is connected to /dev/null, and stdout/stderr are drained through
+// non-blocking pipes with poll() so neither can fill up and stall the child.
+// When a timeout expires the child is terminated (SIGTERM, then SIGKILL).
+//
+// On Windows children are started with CreateProcessW. The argv vector is
+// quoted so the child's C runtime splits it back unchanged, the environment
+// and working directory are handed to the child instead of being changed in
+// this process, and a timed-out child is ended with TerminateProcess.
+// Batch files (.cmd/.bat) are the exception: Windows runs them through
+// cmd.exe, which applies its own parsing to their arguments.
+class ProcessRunner {
+   public:
+    static ProcessResult run(const std::vector<std::string>& command,
+                             const ProcessOptions& options = {});
+
+    // Convenience wrapper for the common "did it exit with 0" check
+    static bool succeeds(const std::vector<std::string>& command,
+                         const ProcessOptions& options = {});
+
+    // Human readable form of a command line, for logging only
+    static std::string formatCommand(const std::vector<std::string>& command);
+};
+
+}  // namespace utils
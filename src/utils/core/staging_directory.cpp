@@ -0,0 +1,386 @@
+#include "../core/staging_directory.h"
+
+#include <spdlog/spdlog.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <system_error>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/fs.h>
+#include <sys/syscall.h>
+#endif
+#ifdef __APPLE__
+#include <stdio.h>
+#endif
+#endif
+
+namespace fs = std::filesystem;
+
+namespace utils {
+
+namespace {
+
+constexpr const char* STAGING_MARKER = ".staging-";
+
+std::atomic<unsigned> stagingCounter{0};
+
+bool syncEnabled() {
+    if (const char* setting = std::getenv("CPP_SCAFFOLD_FSYNC")) {
+        std::string value = setting;
+        if (value == "0" || value == "off" || value == "false") {
+            return false;
+        }
+    }
+    return true;
+}
+
+unsigned long currentPid() {
+#ifdef _WIN32
+    return static_cast<unsigned long>(GetCurrentProcessId());
+#else
+    return static_cast<unsigned long>(::getpid());
+#endif
+}
+
+bool processAlive(unsigned long pid) {
+#ifdef _WIN32
+    HANDLE process = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, static_cast<DWORD>(pid));
+    if (!process) {
+        return GetLastError() == ERROR_ACCESS_DENIED;
+    }
+    DWORD code = 0;
+    bool alive = GetExitCodeProcess(process, &code) && code == STILL_ACTIVE;
+    CloseHandle(process);
+    return alive;
+#else
+    return ::kill(static_cast<pid_t>(pid), 0) == 0 || errno != ESRCH;
+#endif
+}
+
+// ".<name>.staging-" for target <name>
+std::string stagingPrefix(const fs::path& target) {
+    return "." + target.filename().string() + STAGING_MARKER;
+}
+
+// Flushes the files and directories under root, and nothing else on the
+// filesystem. On Linux writeback is started for every file first, so the
+// fsync pass mostly waits on I/O already in flight instead of issuing it
+// one file at a time
+void syncTree(const fs::path& root) {
+#ifndef _WIN32
+    std::vector<fs::path> paths{root};
+    std::error_code ec;
+    for (fs::recursive_directory_iterator it(root, ec), end; !ec && it != end; it.increment(ec)) {
+        auto type = it->symlink_status(ec).type();
+        if (type == fs::file_type::regular || type == fs::file_type::directory) {
+            paths.push_back(it->path());
+        }
+    }
+
+#ifdef __linux__
+    for (const auto& path : paths) {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC | O_NOFOLLOW);
+        if (fd >= 0) {
+            ::sync_file_range(fd, 0, 0, SYNC_FILE_RANGE_WRITE);
+            ::close(fd);
+        }
+    }
+#endif
+    for (const auto& path : paths) {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC | O_NOFOLLOW);
+        if (fd >= 0) {
+            ::fsync(fd);
+            ::close(fd);
+        }
+    }
+#else
+    (void)root;
+#endif
+}
+
+// Makes a rename inside directory durable
+void syncDirectory(const fs::path& directory) {
+#ifndef _WIN32
+    const fs::path& dir = directory.empty() ? fs::path(".") : directory;
+    int fd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd >= 0) {
+        ::fsync(fd);
+        ::close(fd);
+    }
+#else
+    (void)directory;
+#endif
+}
+
+// Renames from to to, failing instead of replacing anything already at to
+bool renameNoReplace(const fs::path& from, const fs::path& to, std::string& error) {
+#ifdef _WIN32
+    // MoveFileEx never replaces a directory
+    if (!MoveFileExW(from.c_str(), to.c_str(), MOVEFILE_WRITE_THROUGH)) {
+        error = "Failed to move '" + from.string() + "' to '" + to.string() + "' (error " +
+                std::to_string(GetLastError()) + ")";
+        return false;
+    }
+    return true;
+#else
+#if defined(__linux__) && defined(SYS_renameat2) && defined(RENAME_NOREPLACE)
+    if (::syscall(SYS_renameat2, AT_FDCWD, from.c_str(), AT_FDCWD, to.c_str(),
+                  RENAME_NOREPLACE) == 0) {
+        return true;
+    }
+    // Old kernels and some filesystems (NFS, overlay lower layers) lack renameat2
+    if (errno != ENOSYS && errno != EINVAL) {
+        error = "Failed to publish '" + to.string() + "': " + std::strerror(errno);
+        return false;
+    }
+#elif defined(__APPLE__) && defined(RENAME_EXCL)
+    if (::renamex_np(from.c_str(), to.c_str(), RENAME_EXCL) == 0) {
+        return true;
+    }
+    if (errno != ENOTSUP) {
+        error = "Failed to publish '" + to.string() + "': " + std::strerror(errno);
+        return false;
+    }
+#endif
+    // rename(2) replaces only empty directories, so the check leaves a narrow race at worst
+    std::error_code ec;
+    if (fs::symlink_status(to, ec).type() != fs::file_type::not_found) {
+        error = "Failed to publish '" + to.string() + "': " + std::strerror(EEXIST);
+        return false;
+    }
+    if (::rename(from.c_str(), to.c_str()) != 0) {
+        error = "Failed to publish '" + to.string() + "': " + std::strerror(errno);
+        return false;
+    }
+    return true;
+#endif
+}
+
+// Swaps two existing paths in one step. supported is false where the kernel,
+// filesystem or platform cannot, and the caller must fall back
+bool exchangePaths(const fs::path& first, const fs::path& second, bool& supported,
+                   std::string& error) {
+    supported = true;
+#if defined(__linux__) && defined(SYS_renameat2) && defined(RENAME_EXCHANGE)
+    if (::syscall(SYS_renameat2, AT_FDCWD, first.c_str(), AT_FDCWD, second.c_str(),
+                  RENAME_EXCHANGE) == 0) {
+        return true;
+    }
+    if (errno == ENOSYS || errno == EINVAL) {
+        supported = false;
+        return false;
+    }
+#elif defined(__APPLE__) && defined(RENAME_SWAP)
+    if (::renamex_np(first.c_str(), second.c_str(), RENAME_SWAP) == 0) {
+        return true;
+    }
+    if (errno == ENOTSUP) {
+        supported = false;
+        return false;
+    }
+#else
+    (void)first;
+    (void)second;
+    (void)error;
+    supported = false;
+    return false;
+#endif
+#if defined(__linux__) || defined(__APPLE__)
+    error = "Failed to publish '" + second.string() + "': " + std::strerror(errno);
+    return false;
+#endif
+}
+
+}  // namespace
+
+StagingDirectory::StagingDirectory(fs::path target) : target_(target.lexically_normal()) {
+    if (!target_.has_filename() && target_.has_parent_path()) {
+        target_ = target_.parent_path();  // "name/" names the directory itself
+    }
+    staging_ = target_;
+}
+
+StagingDirectory::~StagingDirectory() {
+    if (state_ == State::Active) {
+        rollback();
+    }
+}
+
+bool StagingDirectory::begin(std::string& error) {
+    if (state_ != State::Idle) {
+        error = "Staging directory already used for '" + target_.string() + "'";
+        return false;
+    }
+    if (target_.empty() || !target_.has_filename()) {
+        error = "Invalid project directory '" + target_.string() + "'";
+        return false;
+    }
+
+    removeStale(target_);
+
+    std::error_code ec;
+    if (fs::symlink_status(target_, ec).type() != fs::file_type::not_found) {
+        error = "Directory '" + target_.string() + "' already exists";
+        return false;
+    }
+
+    fs::path parent = target_.parent_path();
+    if (!parent.empty()) {
+        fs::create_directories(parent, ec);
+        if (ec) {
+            error = "Failed to create '" + parent.string() + "': " + ec.message();
+            return false;
+        }
+    }
+
+    std::string name = stagingPrefix(target_) + std::to_string(currentPid()) + "-" +
+                       std::to_string(stagingCounter.fetch_add(1));
+    fs::path staging = parent / name;
+    if (fs::create_directory(staging, ec) && !ec) {
+        // Relative, so the link stays valid if the parent directory is moved
+        fs::create_directory_symlink(name, target_, ec);
+        if (!ec) {
+            staging_ = staging;
+            redirected_ = true;
+            state_ = State::Active;
+            spdlog::debug("Staging '{}' in '{}'", target_.string(), staging_.string());
+            return true;
+        }
+        spdlog::debug("Cannot redirect '{}' to a staging directory ({}); generating in place",
+                      target_.string(), ec.message());
+        fs::remove(staging, ec);
+    }
+
+    if (!fs::create_directory(target_, ec) || ec) {
+        error = "Failed to create '" + target_.string() + "': " +
+                (ec ? ec.message() : std::string("already exists"));
+        return false;
+    }
+    staging_ = target_;
+    redirected_ = false;
+    state_ = State::Active;
+    return true;
+}
+
+bool StagingDirectory::commit(std::string& error) {
+    if (state_ != State::Active) {
+        error = "No staged directory to commit for '" + target_.string() + "'";
+        return false;
+    }
+
+    bool sync = syncEnabled();
+    if (sync) {
+        syncTree(staging_);
+    }
+
+    if (redirected_) {
+        // Only replace the link if it is still ours
+        std::error_code ec;
+        if (!fs::is_symlink(fs::symlink_status(target_, ec)) ||
+            fs::read_symlink(target_, ec) != staging_.filename()) {
+            error = "'" + target_.string() + "' was replaced during generation";
+            return false;
+        }
+
+        // Swapping the tree with the link keeps something at the target path
+        // throughout; the link then sits at the staging name and is removed
+        bool supported = false;
+        if (exchangePaths(staging_, target_, supported, error)) {
+            fs::remove(staging_, ec);
+            if (ec) {
+                spdlog::debug("Failed to remove staging link '{}': {}", staging_.string(),
+                              ec.message());
+            }
+        } else if (supported) {
+            return false;
+        } else {
+            // Without an exchange the target is briefly absent
+            fs::remove(target_, ec);
+            if (ec) {
+                error = "Failed to remove staging link '" + target_.string() + "': " +
+                        ec.message();
+                return false;
+            }
+            if (!renameNoReplace(staging_, target_, error)) {
+                return false;
+            }
+        }
+        staging_ = target_;
+    }
+
+    if (sync) {
+        syncDirectory(target_.parent_path());
+    }
+    state_ = State::Committed;
+    return true;
+}
+
+bool StagingDirectory::rollback() {
+    if (state_ != State::Active) {
+        return state_ != State::Committed;
+    }
+    state_ = State::RolledBack;
+
+    std::error_code ec;
+    if (redirected_ && fs::is_symlink(fs::symlink_status(target_, ec)) &&
+        fs::read_symlink(target_, ec) == staging_.filename()) {
+        fs::remove(target_, ec);
+    }
+    fs::remove_all(staging_, ec);
+    if (ec) {
+        spdlog::error("Failed to remove '{}': {}", staging_.string(), ec.message());
+        return false;
+    }
+    spdlog::debug("Rolled back '{}'", target_.string());
+    return true;
+}
+
+size_t StagingDirectory::removeStale(const fs::path& target) {
+    fs::path parent = target.parent_path();
+    std::string prefix = stagingPrefix(target);
+    std::error_code ec;
+    fs::directory_iterator it(parent.empty() ? fs::path(".") : parent, ec), end;
+
+    size_t removed = 0;
+    for (; !ec && it != end; it.increment(ec)) {
+        std::string name = it->path().filename().string();
+        if (name.compare(0, prefix.size(), prefix) != 0) {
+            continue;
+        }
+        // <pid>-<counter>
+        char* rest = nullptr;
+        unsigned long pid = std::strtoul(name.c_str() + prefix.size(), &rest, 10);
+        if (!rest || *rest != '-' || pid == currentPid() || processAlive(pid)) {
+            continue;
+        }
+        std::error_code removeError;
+        fs::remove_all(parent / name, removeError);
+        if (!removeError) {
+            ++removed;
+            spdlog::debug("Removed stale staging directory '{}'", (parent / name).string());
+        }
+    }
+
+    // A link left by a crashed run points at nothing once its staging tree is gone
+    std::error_code linkError;
+    if (fs::is_symlink(fs::symlink_status(target, linkError))) {
+        fs::path link = fs::read_symlink(target, linkError);
+        if (!linkError && link.filename().string().compare(0, prefix.size(), prefix) == 0 &&
+            !fs::exists(parent / link, linkError)) {
+            fs::remove(target, linkError);
+        }
+    }
+    return removed;
+}
+
+}  // namespace utils
@@ -0,0 +1,70 @@
+#pragma once
+#include <filesystem>
+#include <string>
+
+namespace utils {
+
+// Builds a directory tree out of sight and publishes it in one step.
+//
+// begin() creates a hidden sibling of the target (".<name>.staging-<pid>-<n>")
+// and a relative symlink at the target path pointing to it, so code that
+// writes through the target path lands in the staging tree unchanged. commit()
+// flushes the files of the staging tree, starting writeback for all of them
+// before waiting on any (other data on the filesystem is left alone), swaps the
+// symlink and the real directory with renameat2(RENAME_EXCHANGE) (or
+// renamex_np(RENAME_SWAP)) so the target path never disappears, removes the
+// link left at the staging name, and syncs the parent. Without an exchange the
+// link is removed and the tree moved with renameat2(RENAME_NOREPLACE), leaving
+// the target briefly absent. rollback() is a single remove_all of the staging
+// tree.
+//
+// Child processes started inside the tree before commit() resolve their
+// working directory to the staging path. Generation only runs tools that
+// record paths relative to the project (git), so nothing refers to the
+// staging name after commit(). Anything that stores its absolute working
+// directory, such as a CMake configure, must run after commit().
+//
+// Where symlinks cannot be created (Windows without developer mode) the tree
+// is generated in place and rollback removes the target, which begin()
+// guarantees did not exist. Set CPP_SCAFFOLD_FSYNC=0 to skip the flushes.
+class StagingDirectory {
+   public:
+    explicit StagingDirectory(std::filesystem::path target);
+    ~StagingDirectory();  // Rolls back unless committed
+
+    StagingDirectory(const StagingDirectory&) = delete;
+    StagingDirectory& operator=(const StagingDirectory&) = delete;
+
+    // Fails if the target already exists or the staging tree cannot be created
+    bool begin(std::string& error);
+
+    // Publishes the staging tree at the target; on failure the caller should roll back
+    bool commit(std::string& error);
+
+    // Removes everything written since begin(); safe to call more than once
+    bool rollback();
+
+    const std::filesystem::path& target() const {
+        return target_;
+    }
+    // Where the files really live until commit(); equals target() when not redirected
+    const std::filesystem::path& stagingPath() const {
+        return staging_;
+    }
+    bool isRedirected() const {
+        return redirected_;
+    }
+
+    // Removes staging trees next to target left behind by processes that no longer run
+    static size_t removeStale(const std::filesystem::path& target);
+
+   private:
+    enum class State { Idle, Active, Committed, RolledBack };
+
+    std::filesystem::path target_;
+    std::filesystem::path staging_;
+    bool redirected_ = false;
+    State state_ = State::Idle;
+};
+
+}  // namespace utils
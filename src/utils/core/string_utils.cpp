@@ -2,6 +2,10 @@
 
 #include <algorithm>
 
+#include "../core/byte_scan.h"
+#include "../core/hash_utils.h"
+#include "../core/template_compiler.h"
+
 namespace utils {
 std::string StringUtils::toLower(const std::string &str) {
   std::string result = str;
@@ -94,4 +98,109 @@ std::string StringUtils::join(const std::vector<std::string> &strings, const std
   }
   return result;
 }
+
+std::string StringUtils::replacePlaceholders(
+    const std::string &templateStr,
+    const std::unordered_map<std::string, std::string> &replacements) {
+  return CompiledTemplate::compile(templateStr).render(replacements);
+}
+
+std::vector<std::string>
+StringUtils::extractPlaceholders(const std::string &templateStr,
+                                 const std::string &prefix,
+                                 const std::string &suffix) {
+  return CompiledTemplate::compile(templateStr, prefix, suffix)
+      .placeholderNames();
+}
+
+size_t StringUtils::levenshteinDistance(const std::string &str1,
+                                        const std::string &str2) {
+  // Two rolling rows of the edit distance table, sized by the shorter string
+  const std::string &shorter = str1.size() < str2.size() ? str1 : str2;
+  const std::string &longer = str1.size() < str2.size() ? str2 : str1;
+
+  std::vector<size_t> previous(shorter.size() + 1);
+  std::vector<size_t> current(shorter.size() + 1);
+  for (size_t j = 0; j <= shorter.size(); ++j) {
+    previous[j] = j;
+  }
+  for (size_t i = 1; i <= longer.size(); ++i) {
+    current[0] = i;
+    for (size_t j = 1; j <= shorter.size(); ++j) {
+      size_t substitution =
+          previous[j - 1] + (longer[i - 1] == shorter[j - 1] ? 0 : 1);
+      current[j] = std::min({previous[j] + 1, current[j - 1] + 1, substitution});
+    }
+    std::swap(previous, current);
+  }
+  return previous[shorter.size()];
+}
+
+bool StringUtils::isValidUtf8(std::string_view str) {
+  return ByteScan::isValidUtf8(str);
+}
+
+size_t StringUtils::countOccurrences(std::string_view str, char ch) {
+  return ByteScan::count(str, ch);
+}
+
+size_t StringUtils::countOccurrences(std::string_view str,
+                                     std::string_view substring) {
+  if (substring.empty()) {
+    return 0;
+  }
+  if (substring.size() == 1) {
+    return ByteScan::count(str, substring[0]);
+  }
+  size_t total = 0;
+  for (size_t pos = ByteScan::find(str, substring); pos != ByteScan::npos;
+       pos = ByteScan::find(str, substring, pos + substring.size())) {
+    ++total;
+  }
+  return total;
+}
+
+std::vector<size_t>
+StringUtils::findAllOccurrences(std::string_view str,
+                                std::string_view substring) {
+  std::vector<size_t> positions;
+  if (substring.empty()) {
+    return positions;
+  }
+  for (size_t pos = ByteScan::find(str, substring); pos != ByteScan::npos;
+       pos = ByteScan::find(str, substring, pos + substring.size())) {
+    positions.push_back(pos);
+  }
+  return positions;
+}
+
+size_t StringUtils::countLines(std::string_view str) {
+  if (str.empty()) {
+    return 0;
+  }
+  return ByteScan::count(str, '\n') + (str.back() == '\n' ? 0 : 1);
+}
+
+std::vector<std::string> StringUtils::splitLines(std::string_view str) {
+  std::vector<std::string> lines;
+  lines.reserve(countLines(str));
+  size_t start = 0;
+  while (start < str.size()) {
+    size_t end = ByteScan::find(str, '\n', start);
+    if (end == ByteScan::npos) {
+      end = str.size();
+    }
+    size_t length = end - start;
+    if (length > 0 && str[end - 1] == '\r') {
+      --length;
+    }
+    lines.emplace_back(str.substr(start, length));
+    start = end + 1;
+  }
+  return lines;
+}
+
+std::string StringUtils::calculateSHA256(const std::string &str) {
+  return Sha256::toHex(Sha256::hash(str));
+}
 } // namespace utils
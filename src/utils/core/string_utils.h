@@ -6,6 +6,7 @@
 #include <regex>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -77,6 +78,8 @@ class StringUtils {
     static bool isAlphabetic(const std::string& str);
     static bool isAlphanumeric(const std::string& str);
     static bool isHexadecimal(const std::string& str);
+    // Strict UTF-8 (no overlong forms, surrogates or code points above U+10FFFF)
+    static bool isValidUtf8(std::string_view str);
 
     // Advanced validation
     static StringValidationResult isValidIdentifier(const std::string& str);
@@ -114,22 +117,25 @@ class StringUtils {
     static std::string urlEncode(const std::string& str);
     static std::string urlDecode(const std::string& str);
 
-    // String analysis
-    static size_t countOccurrences(const std::string& str, const std::string& substring);
-    static size_t countOccurrences(const std::string& str, char ch);
-    static std::vector<size_t> findAllOccurrences(const std::string& str,
-                                                  const std::string& substring);
+    // String analysis. Substring matches do not overlap; an empty substring has none
+    static size_t countOccurrences(std::string_view str, std::string_view substring);
+    static size_t countOccurrences(std::string_view str, char ch);
+    static std::vector<size_t> findAllOccurrences(std::string_view str,
+                                                  std::string_view substring);
     static std::unordered_map<char, size_t> getCharacterFrequency(const std::string& str);
     static std::string getLongestCommonPrefix(const std::vector<std::string>& strings);
     static std::string getLongestCommonSuffix(const std::vector<std::string>& strings);
 
     // Text processing
-    static std::vector<std::string> splitLines(const std::string& str);
+    // Lines split at '\n' without their terminator (a trailing '\r' is dropped too);
+    // a final newline does not start another line
+    static std::vector<std::string> splitLines(std::string_view str);
     static std::string joinLines(const std::vector<std::string>& lines);
     static std::string wordWrap(const std::string& str, size_t width);
     static std::vector<std::string> extractWords(const std::string& str);
     static size_t countWords(const std::string& str);
-    static size_t countLines(const std::string& str);
+    // Number of lines as splitLines would return them
+    static size_t countLines(std::string_view str);
 
     // Utility functions
     static std::string generateRandomString(size_t length, const std::string& charset = "");
@@ -1,4 +1,5 @@
 #include "../core/system_utils.h"
+#include "../core/tool_registry.h"
 
 #include <algorithm>
 #include <cstdlib>
@@ -29,6 +30,8 @@
 #include <sys/types.h>
 #include <sys/utsname.h>
 #include <unistd.h>
+
+extern char** environ;
 #endif
 
 namespace utils {
@@ -260,7 +263,6 @@ std::unordered_map<std::string, std::string> SystemUtils::getAllEnvironmentVaria
         FreeEnvironmentStringsW(envStrings);
     }
 #else
-    extern char** environ;
     for (char** env_ptr = environ; *env_ptr != nullptr; ++env_ptr) {
         std::string envVar(*env_ptr);
         size_t equalPos = envVar.find('=');
@@ -276,13 +278,7 @@ std::unordered_map<std::string, std::string> SystemUtils::getAllEnvironmentVaria
 }
 
 bool SystemUtils::commandExists(const std::string& command) {
-#ifdef _WIN32
-    std::string cmd = "where " + command + " >nul 2>nul";
-    return system(cmd.c_str()) == 0;
-#else
-    std::string cmd = "command -v " + command + " >/dev/null 2>&1";
-    return system(cmd.c_str()) == 0;
-#endif
+    return ToolRegistry::getInstance().isAvailable(command);
 }
 
 std::string SystemUtils::executeSystemCommand(const std::string& command) {
@@ -332,47 +328,11 @@ bool SystemUtils::isToolAvailable(const std::string& toolName) {
 }
 
 std::string SystemUtils::getToolVersion(const std::string& toolName) {
-    std::string versionCmd = toolName + " --version";
-    std::string output = executeSystemCommand(versionCmd);
-
-    // Extract version from output (simplified)
-    size_t pos = output.find("version");
-    if (pos != std::string::npos) {
-        size_t start = pos + 7;  // Skip "version"
-        size_t end = output.find('\n', start);
-        if (end == std::string::npos)
-            end = output.length();
-        return output.substr(start, end - start);
-    }
-
-    return "Unknown";
+    return ToolRegistry::getInstance().version(toolName);
 }
 
 std::filesystem::path SystemUtils::findToolInPath(const std::string& toolName) {
-    auto pathVar = getEnvironmentVariable("PATH");
-    if (!pathVar)
-        return {};
-
-    std::string pathSeparator;
-#ifdef _WIN32
-    pathSeparator = ";";
-    std::string extension = ".exe";
-#else
-    pathSeparator = ":";
-    std::string extension = "";
-#endif
-
-    std::istringstream pathStream(*pathVar);
-    std::string path;
-
-    while (std::getline(pathStream, path, pathSeparator[0])) {
-        std::filesystem::path fullPath = std::filesystem::path(path) / (toolName + extension);
-        if (std::filesystem::exists(fullPath)) {
-            return fullPath;
-        }
-    }
-
-    return {};
+    return ToolRegistry::getInstance().find(toolName).value_or(std::filesystem::path());
 }
 
 // Default implementations for other methods to ensure compilation
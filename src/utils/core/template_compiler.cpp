@@ -0,0 +1,117 @@
+#include "../core/template_compiler.h"
+
+#include <utility>
+
+namespace utils {
+
+CompiledTemplate CompiledTemplate::compile(std::string source, std::string_view prefix,
+                                           std::string_view suffix) {
+    CompiledTemplate compiled;
+    compiled.source_ = std::move(source);
+
+    const std::string_view text(compiled.source_);
+    auto addLiteral = [&compiled](size_t offset, size_t length) {
+        if (length == 0) {
+            return;
+        }
+        // Merge adjacent literals so rendering appends as few chunks as possible
+        if (!compiled.segments_.empty() && compiled.segments_.back().name.empty() &&
+            compiled.segments_.back().offset + compiled.segments_.back().length == offset) {
+            compiled.segments_.back().length += length;
+            return;
+        }
+        compiled.segments_.push_back({offset, length, {}});
+    };
+
+    if (prefix.empty() || suffix.empty()) {
+        addLiteral(0, text.size());
+        return compiled;
+    }
+
+    size_t literalStart = 0;
+    size_t searchFrom = 0;
+    while (true) {
+        size_t open = text.find(prefix, searchFrom);
+        if (open == std::string_view::npos) {
+            break;
+        }
+        size_t close = text.find(suffix, open + prefix.size());
+        if (close == std::string_view::npos) {
+            break;
+        }
+
+        // For inputs like "{{{NAME}}" the innermost prefix opens the placeholder
+        size_t innermost = text.rfind(prefix, close - prefix.size());
+        if (innermost != std::string_view::npos && innermost > open) {
+            open = innermost;
+        }
+
+        std::string_view name = text.substr(open + prefix.size(), close - open - prefix.size());
+        if (name.empty() || name.find('\n') != std::string_view::npos) {
+            searchFrom = open + 1;
+            continue;
+        }
+
+        addLiteral(literalStart, open - literalStart);
+        size_t end = close + suffix.size();
+        compiled.segments_.push_back({open, end - open, std::string(name)});
+        ++compiled.placeholderCount_;
+        literalStart = end;
+        searchFrom = end;
+    }
+
+    addLiteral(literalStart, text.size() - literalStart);
+    return compiled;
+}
+
+std::string CompiledTemplate::renderWith(const Resolver& resolve) const {
+    std::string output;
+    renderInto(output, resolve);
+    return output;
+}
+
+void CompiledTemplate::renderInto(std::string& output, const Resolver& resolve) const {
+    if (placeholderCount_ == 0) {
+        output.append(source_);
+        return;
+    }
+
+    // Resolve every placeholder once up front so the buffer can be sized exactly
+    std::vector<const std::string*> values;
+    values.reserve(placeholderCount_);
+    size_t outputSize = output.size();
+    for (const auto& segment : segments_) {
+        if (segment.name.empty()) {
+            outputSize += segment.length;
+            continue;
+        }
+        const std::string* value = resolve(segment.name);
+        values.push_back(value);
+        outputSize += value ? value->size() : segment.length;
+    }
+    output.reserve(outputSize);
+
+    size_t valueIndex = 0;
+    for (const auto& segment : segments_) {
+        if (!segment.name.empty()) {
+            if (const std::string* value = values[valueIndex++]) {
+                output.append(*value);
+                continue;
+            }
+        }
+        output.append(source_, segment.offset, segment.length);
+    }
+}
+
+std::vector<std::string> CompiledTemplate::placeholderNames() const {
+    std::vector<std::string> names;
+    names.reserve(placeholderCount_);
+    for (const auto& segment : segments_) {
+        if (!segment.name.empty()) {
+            names.push_back(segment.name);
+        }
+    }
+    return names;
+}
+
+}  // namespace utils
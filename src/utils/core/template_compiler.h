@@ -0,0 +1,59 @@
+#pragma once
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace utils {
+
+// Placeholder template compiled once into literal/placeholder segments.
+//
+// Compiling tokenizes the source a single time; rendering is then one linear
+// pass over the segments into a buffer reserved to the exact output size, no
+// matter how many variables are bound. Placeholders without a binding are
+// emitted verbatim, and substituted values are never rescanned.
+class CompiledTemplate {
+   public:
+    // Returns the value bound to a placeholder name, or nullptr if unbound
+    using Resolver = std::function<const std::string*(const std::string&)>;
+
+    CompiledTemplate() = default;
+
+    static CompiledTemplate compile(std::string source, std::string_view prefix = "{{",
+                                    std::string_view suffix = "}}");
+
+    // Render with any map-like container keyed by std::string
+    template <typename Map>
+    std::string render(const Map& variables) const {
+        return renderWith([&variables](const std::string& name) -> const std::string* {
+            auto it = variables.find(name);
+            return it != variables.end() ? &it->second : nullptr;
+        });
+    }
+    std::string renderWith(const Resolver& resolve) const;
+
+    // Appends the rendered output to an existing buffer
+    void renderInto(std::string& output, const Resolver& resolve) const;
+
+    const std::string& source() const {
+        return source_;
+    }
+    bool hasPlaceholders() const {
+        return placeholderCount_ > 0;
+    }
+    // Placeholder names in order of appearance (duplicates included)
+    std::vector<std::string> placeholderNames() const;
+
+   private:
+    struct Segment {
+        size_t offset = 0;  // Start of the segment in source_ (including delimiters)
+        size_t length = 0;
+        std::string name;  // Empty for literal segments
+    };
+
+    std::string source_;
+    std::vector<Segment> segments_;
+    size_t placeholderCount_ = 0;
+};
+
+}  // namespace utils
@@ -0,0 +1,330 @@
+#include "../core/tool_registry.h"
+
+#include <spdlog/spdlog.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <nlohmann/json.hpp>
+
+#include "../core/process_runner.h"
+#include "../core/system_utils.h"
+
+#ifdef _WIN32
+#include <io.h>
+#include <process.h>
+#else
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+namespace utils {
+
+namespace {
+constexpr int TOOL_CACHE_VERSION = 1;
+// A tool that hangs on --version must not stall the whole run
+constexpr std::chrono::seconds VERSION_PROBE_TIMEOUT{10};
+
+// Distinguishes the temporary cache files of concurrent writers
+std::string uniqueName() {
+    static std::atomic<unsigned> counter{0};
+#ifdef _WIN32
+    int pid = _getpid();
+#else
+    int pid = static_cast<int>(getpid());
+#endif
+    return std::to_string(pid) + "-" + std::to_string(counter++);
+}
+
+bool isExecutableFile(const fs::path& candidate) {
+#ifdef _WIN32
+    return _access(candidate.string().c_str(), 0) == 0 && !fs::is_directory(candidate);
+#else
+    struct stat st;
+    return ::stat(candidate.c_str(), &st) == 0 && S_ISREG(st.st_mode) &&
+           ::access(candidate.c_str(), X_OK) == 0;
+#endif
+}
+}  // namespace
+
+ToolRegistry& ToolRegistry::getInstance() {
+    static ToolRegistry instance;
+    return instance;
+}
+
+ToolRegistry::~ToolRegistry() {
+    // Best effort: anything discovered during this run is kept for the next one
+    try {
+        save();
+    } catch (...) {
+    }
+}
+
+int64_t ToolRegistry::modificationTime(const fs::path& path) {
+    std::error_code ec;
+    auto time = fs::last_write_time(path, ec);
+    if (ec) {
+        return 0;
+    }
+    return static_cast<int64_t>(time.time_since_epoch().count());
+}
+
+void ToolRegistry::refreshEnvironmentLocked() {
+    const char* pathVar = std::getenv("PATH");
+    std::string pathValue = pathVar ? pathVar : "";
+    if (scanned_ && pathValue == pathValue_) {
+        return;
+    }
+
+    pathValue_ = std::move(pathValue);
+    directories_.clear();
+    for (auto& dir : SystemUtils::getPathDirectories()) {
+        int64_t mtime = modificationTime(dir);
+        directories_.emplace_back(std::move(dir), mtime);
+    }
+    if (scanned_) {
+        // Results for a different PATH cannot be reused
+        entries_.clear();
+        dirty_ = true;
+    }
+    scanned_ = true;
+}
+
+std::optional<fs::path> ToolRegistry::searchPathLocked(const std::string& toolName) const {
+#ifdef _WIN32
+    static const char* const extensions[] = {".exe", ".cmd", ".bat", ""};
+#else
+    static const char* const extensions[] = {""};
+#endif
+
+    if (toolName.empty()) {
+        return std::nullopt;
+    }
+
+    // Names with a directory component are checked as given, like the shell does
+    if (toolName.find('/') != std::string::npos ||
+        toolName.find(fs::path::preferred_separator) != std::string::npos) {
+        for (const char* extension : extensions) {
+            fs::path candidate(toolName + extension);
+            if (isExecutableFile(candidate)) {
+                return candidate;
+            }
+        }
+        return std::nullopt;
+    }
+
+    for (const auto& [dir, mtime] : directories_) {
+        (void)mtime;
+        for (const char* extension : extensions) {
+            fs::path candidate = dir / (toolName + extension);
+            if (isExecutableFile(candidate)) {
+                return candidate;
+            }
+        }
+    }
+    return std::nullopt;
+}
+
+const ToolRegistry::Entry& ToolRegistry::resolveLocked(const std::string& toolName) {
+    refreshEnvironmentLocked();
+
+    auto it = entries_.find(toolName);
+    if (it != entries_.end()) {
+        return it->second;
+    }
+
+    Entry entry;
+    entry.path = searchPathLocked(toolName);
+    if (entry.path) {
+        entry.mtime = modificationTime(*entry.path);
+        spdlog::debug("Resolved tool '{}' to {}", toolName, entry.path->string());
+    } else {
+        spdlog::debug("Tool '{}' not found on PATH", toolName);
+    }
+    dirty_ = true;
+    return entries_.emplace(toolName, std::move(entry)).first->second;
+}
+
+std::optional<fs::path> ToolRegistry::find(const std::string& toolName) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return resolveLocked(toolName).path;
+}
+
+bool ToolRegistry::isAvailable(const std::string& toolName) {
+    return find(toolName).has_value();
+}
+
+std::string ToolRegistry::probeVersion(const fs::path& executable) {
+    ProcessOptions options;
+    options.discardStderr = true;
+    options.timeout = VERSION_PROBE_TIMEOUT;
+    ProcessResult result = ProcessRunner::run({executable.string(), "--version"}, options);
+    if (!result.started || result.timedOut) {
+        return "Unknown";
+    }
+    const std::string& output = result.output;
+
+    // Text following the word "version" up to the end of that line
+    size_t pos = output.find("version");
+    if (pos == std::string::npos) {
+        return "Unknown";
+    }
+    size_t start = pos + 7;
+    size_t end = output.find('\n', start);
+    if (end == std::string::npos) {
+        end = output.length();
+    }
+    return output.substr(start, end - start);
+}
+
+std::string ToolRegistry::version(const std::string& toolName) {
+    std::optional<fs::path> path;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const Entry& entry = resolveLocked(toolName);
+        if (entry.version) {
+            return *entry.version;
+        }
+        if (!entry.path) {
+            return "Unknown";
+        }
+        path = entry.path;
+    }
+
+    // Run the probe without holding the lock, it may take a while
+    std::string probed = probeVersion(*path);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(toolName);
+    if (it != entries_.end() && it->second.path == path) {
+        it->second.version = probed;
+        dirty_ = true;
+    }
+    return probed;
+}
+
+void ToolRegistry::enablePersistence(const fs::path& cacheFile) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cacheFile_ = cacheFile;
+    loadLocked();
+}
+
+void ToolRegistry::loadLocked() {
+    refreshEnvironmentLocked();
+
+    std::ifstream file(*cacheFile_);
+    if (!file.is_open()) {
+        return;
+    }
+
+    try {
+        json cache = json::parse(file);
+        if (cache.value("schemaVersion", 0) != TOOL_CACHE_VERSION ||
+            cache.value("path", std::string()) != pathValue_) {
+            spdlog::debug("Tool cache is stale (PATH changed), rediscovering tools");
+            return;
+        }
+
+        // A tool installed into (or removed from) a PATH directory changes its mtime
+        const auto& directories = cache.at("directories");
+        if (!directories.is_array() || directories.size() != directories_.size()) {
+            return;
+        }
+        for (size_t i = 0; i < directories_.size(); ++i) {
+            if (directories[i].at(0).get<std::string>() != directories_[i].first.string() ||
+                directories[i].at(1).get<int64_t>() != directories_[i].second) {
+                spdlog::debug("Tool cache is stale ({} changed), rediscovering tools",
+                              directories_[i].first.string());
+                return;
+            }
+        }
+
+        size_t loaded = 0;
+        for (const auto& [name, value] : cache.at("tools").items()) {
+            if (entries_.count(name)) {
+                continue;
+            }
+            Entry entry;
+            if (!value.at("path").is_null()) {
+                entry.path = fs::path(value.at("path").get<std::string>());
+                entry.mtime = value.value("mtime", int64_t{0});
+                // Upgraded in place, so the cached version is no longer right
+                if (modificationTime(*entry.path) != entry.mtime) {
+                    continue;
+                }
+                if (value.contains("version")) {
+                    entry.version = value["version"].get<std::string>();
+                }
+            }
+            entries_.emplace(name, std::move(entry));
+            ++loaded;
+        }
+        spdlog::debug("Loaded {} cached tool lookups from {}", loaded, cacheFile_->string());
+    } catch (const std::exception& e) {
+        spdlog::debug("Ignoring unreadable tool cache {}: {}", cacheFile_->string(), e.what());
+    }
+}
+
+bool ToolRegistry::save() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!cacheFile_ || !dirty_) {
+        return true;
+    }
+
+    json cache;
+    cache["schemaVersion"] = TOOL_CACHE_VERSION;
+    cache["path"] = pathValue_;
+    cache["directories"] = json::array();
+    for (const auto& [dir, mtime] : directories_) {
+        cache["directories"].push_back({dir.string(), mtime});
+    }
+    cache["tools"] = json::object();
+    for (const auto& [name, entry] : entries_) {
+        json value;
+        value["path"] = entry.path ? json(entry.path->string()) : json(nullptr);
+        value["mtime"] = entry.mtime;
+        if (entry.version) {
+            value["version"] = *entry.version;
+        }
+        cache["tools"][name] = std::move(value);
+    }
+
+    std::error_code ec;
+    fs::create_directories(cacheFile_->parent_path(), ec);
+
+    // Write to a temporary file first so concurrent runs never see a torn cache
+    fs::path tempFile = *cacheFile_;
+    tempFile += "." + uniqueName() + ".tmp";
+    bool written = false;
+    {
+        std::ofstream file(tempFile, std::ios::binary | std::ios::trunc);
+        if (file.is_open()) {
+            file << cache.dump();
+            file.close();
+            written = !file.fail();
+        }
+    }
+    if (written) {
+        fs::rename(tempFile, *cacheFile_, ec);
+    }
+    if (!written || ec) {
+        fs::remove(tempFile, ec);
+        return false;
+    }
+
+    dirty_ = false;
+    return true;
+}
+
+void ToolRegistry::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    scanned_ = false;
+    dirty_ = true;
+}
+
+}  // namespace utils
@@ -0,0 +1,73 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace utils {
+
+// Process-wide registry of external tools found on PATH.
+//
+// Each tool is resolved at most once per process by walking the PATH
+// directories and checking the candidates with access(), so no shell is
+// spawned just to ask whether a tool exists. Versions are probed lazily and
+// also cached.
+//
+// When persistence is enabled the results are written to a small JSON file
+// and reused by later invocations. The cache is keyed by the PATH value and
+// the modification times of the PATH directories; individual hits are also
+// dropped when their executable's modification time changes.
+class ToolRegistry {
+   public:
+    ToolRegistry() = default;
+    ~ToolRegistry();
+
+    ToolRegistry(const ToolRegistry&) = delete;
+    ToolRegistry& operator=(const ToolRegistry&) = delete;
+
+    static ToolRegistry& getInstance();
+
+    // Full path of the tool, or nullopt if it is not on PATH
+    std::optional<std::filesystem::path> find(const std::string& toolName);
+    bool isAvailable(const std::string& toolName);
+
+    // Version text reported by "<tool> --version", "Unknown" if unavailable
+    std::string version(const std::string& toolName);
+
+    // Loads the cache file (if still valid) and saves back to it on save() or
+    // destruction. Tools resolved before this call are kept.
+    void enablePersistence(const std::filesystem::path& cacheFile);
+    bool save();
+
+    // Forget everything resolved so far (e.g. after PATH changes)
+    void clear();
+
+   private:
+    struct Entry {
+        std::optional<std::filesystem::path> path;
+        int64_t mtime = 0;  // Of the executable, 0 when not found
+        std::optional<std::string> version;
+    };
+
+    const Entry& resolveLocked(const std::string& toolName);
+    void refreshEnvironmentLocked();
+    void loadLocked();
+
+    std::optional<std::filesystem::path> searchPathLocked(const std::string& toolName) const;
+    static int64_t modificationTime(const std::filesystem::path& path);
+    static std::string probeVersion(const std::filesystem::path& executable);
+
+    std::mutex mutex_;
+    std::map<std::string, Entry> entries_;
+    std::string pathValue_;
+    std::vector<std::pair<std::filesystem::path, int64_t>> directories_;  // In PATH order
+    std::optional<std::filesystem::path> cacheFile_;
+    bool scanned_ = false;
+    bool dirty_ = false;
+};
+
+}  // namespace utils
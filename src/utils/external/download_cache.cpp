@@ -0,0 +1,408 @@
+#include "../external/download_cache.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <vector>
+
+#include "../archive/archive_utils.h"
+#include "../core/hash_utils.h"
+#include "../core/string_utils.h"
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace utils {
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+namespace {
+
+constexpr int DOWNLOAD_CACHE_VERSION = 1;
+
+struct Entry {
+    std::string sha256;
+    std::string suffix;
+    std::string etag;
+    std::string lastModified;
+    uint64_t size = 0;
+    int64_t lastUsed = 0;
+};
+
+using Index = std::map<std::string, Entry>;
+
+// Guards index.json for every cache instance in the process
+std::mutex& indexMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+// Milliseconds since the epoch, strictly increasing within the process so
+// entries touched in quick succession still have a well defined LRU order.
+// Only called with indexMutex() held.
+int64_t nextUseStamp() {
+    static int64_t last = 0;
+    int64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
+                          std::chrono::system_clock::now().time_since_epoch())
+                          .count();
+    last = std::max(now, last + 1);
+    return last;
+}
+
+std::string uniqueName() {
+    static std::atomic<unsigned> counter{0};
+#ifdef _WIN32
+    int pid = _getpid();
+#else
+    int pid = static_cast<int>(getpid());
+#endif
+    return std::to_string(pid) + "-" + std::to_string(counter++);
+}
+
+Index loadIndex(const fs::path& root) {
+    Index index;
+    std::ifstream file(root / "index.json");
+    if (!file.is_open()) {
+        return index;
+    }
+
+    try {
+        json cache = json::parse(file);
+        if (cache.value("schemaVersion", 0) != DOWNLOAD_CACHE_VERSION) {
+            return index;
+        }
+        for (const auto& [url, value] : cache.at("entries").items()) {
+            Entry entry;
+            entry.sha256 = value.at("sha256").get<std::string>();
+            entry.suffix = value.value("suffix", std::string());
+            entry.etag = value.value("etag", std::string());
+            entry.lastModified = value.value("lastModified", std::string());
+            entry.size = value.value("size", uint64_t{0});
+            entry.lastUsed = value.value("lastUsed", int64_t{0});
+            index.emplace(url, std::move(entry));
+        }
+    } catch (const std::exception& e) {
+        spdlog::debug("Ignoring unreadable download cache index: {}", e.what());
+        index.clear();
+    }
+    return index;
+}
+
+bool saveIndex(const fs::path& root, const Index& index) {
+    json cache;
+    cache["schemaVersion"] = DOWNLOAD_CACHE_VERSION;
+    cache["entries"] = json::object();
+    for (const auto& [url, entry] : index) {
+        json value;
+        value["sha256"] = entry.sha256;
+        value["suffix"] = entry.suffix;
+        value["etag"] = entry.etag;
+        value["lastModified"] = entry.lastModified;
+        value["size"] = entry.size;
+        value["lastUsed"] = entry.lastUsed;
+        cache["entries"][url] = std::move(value);
+    }
+
+    std::error_code ec;
+    fs::create_directories(root, ec);
+
+    // Written beside the index and renamed over it, so readers never see a torn file
+    fs::path tempFile = root / ("index.json." + uniqueName() + ".tmp");
+    {
+        std::ofstream file(tempFile, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            return false;
+        }
+        file << cache.dump();
+        if (file.fail()) {
+            return false;
+        }
+    }
+    fs::rename(tempFile, root / "index.json", ec);
+    if (ec) {
+        fs::remove(tempFile, ec);
+        return false;
+    }
+    return true;
+}
+
+std::optional<std::string> hashFile(const fs::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return std::nullopt;
+    }
+    Sha256 sha;
+    std::vector<char> buffer(64 * 1024);
+    while (file) {
+        file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        sha.update(buffer.data(), static_cast<size_t>(file.gcount()));
+    }
+    if (file.bad()) {
+        return std::nullopt;
+    }
+    return Sha256::toHex(sha.finish());
+}
+
+// Archive formats are detected from the file name, so objects keep the
+// extension of the URL they were downloaded from
+std::string archiveSuffix(const std::string& url) {
+    std::string filename = StringUtils::toLower(HttpClient::extractFilenameFromUrl(url));
+    std::string best;
+    for (const auto& extension : ArchiveUtils::getSupportedExtensions()) {
+        if (extension.size() > best.size() && StringUtils::endsWith(filename, extension)) {
+            best = extension;
+        }
+    }
+    return best.empty() ? fs::path(filename).extension().string() : best;
+}
+
+}  // namespace
+
+DownloadCache::DownloadCache(fs::path root) : DownloadCache(std::move(root), Settings()) {}
+
+DownloadCache::DownloadCache(fs::path root, Settings settings)
+    : root_(std::move(root)), settings_(settings) {}
+
+DownloadCache::Settings DownloadCache::settingsFromEnvironment() {
+    Settings settings;
+
+    if (const char* offline = std::getenv("CPP_SCAFFOLD_OFFLINE")) {
+        std::string value = StringUtils::toLower(offline);
+        settings.offline = value == "1" || value == "true" || value == "yes" || value == "on";
+    }
+
+    if (const char* limit = std::getenv("CPP_SCAFFOLD_DOWNLOAD_CACHE_MB")) {
+        try {
+            settings.maxBytes = std::stoull(limit) * 1024 * 1024;
+        } catch (const std::exception&) {
+            spdlog::warn("Ignoring invalid CPP_SCAFFOLD_DOWNLOAD_CACHE_MB value: {}", limit);
+        }
+    }
+
+    return settings;
+}
+
+DownloadCache::FetchResult DownloadCache::fetch(const std::string& url,
+                                                const HttpClient::ProgressCallback& progressCallback) {
+    FetchResult result;
+    std::optional<Entry> cached;
+    {
+        std::lock_guard<std::mutex> lock(indexMutex());
+        Index index = loadIndex(root_);
+        auto it = index.find(url);
+        if (it != index.end() && fs::exists(objectPath(it->second.sha256, it->second.suffix))) {
+            cached = it->second;
+        }
+    }
+
+    auto serveCached = [&](bool stale) {
+        {
+            std::lock_guard<std::mutex> lock(indexMutex());
+            Index index = loadIndex(root_);
+            auto it = index.find(url);
+            if (it != index.end()) {
+                it->second.lastUsed = nextUseStamp();
+                saveIndex(root_, index);
+            }
+        }
+        result.success = true;
+        result.path = objectPath(cached->sha256, cached->suffix);
+        result.sha256 = cached->sha256;
+        result.fromCache = true;
+        result.stale = stale;
+        return result;
+    };
+
+    if (settings_.offline) {
+        if (cached) {
+            spdlog::info("Using cached download for {} (offline mode)", url);
+            return serveCached(false);
+        }
+        result.errorMessage = "Not in the download cache (offline mode): " + url;
+        return result;
+    }
+    if (cached && !settings_.revalidate) {
+        return serveCached(false);
+    }
+
+    fs::path tempFile = temporaryPath();
+    std::error_code ec;
+    fs::create_directories(tempFile.parent_path(), ec);
+
+    HttpClient::DownloadResult download =
+            cached ? HttpClient::downloadIfModified(url, tempFile, cached->etag,
+                                                    cached->lastModified, progressCallback)
+                   : HttpClient::downloadFile(url, tempFile, progressCallback);
+
+    if (download.success && download.notModified && cached) {
+        fs::remove(tempFile, ec);
+        spdlog::info("Cached download of {} is up to date", url);
+        return serveCached(false);
+    }
+    if (!download.success || download.notModified) {
+        fs::remove(tempFile, ec);
+        if (cached) {
+            spdlog::warn("Could not revalidate {} ({}), using the cached copy", url,
+                         download.errorMessage);
+            return serveCached(true);
+        }
+        result.errorMessage =
+                download.errorMessage.empty() ? "Download failed" : download.errorMessage;
+        return result;
+    }
+
+    auto sha256 = hashFile(tempFile);
+    if (!sha256) {
+        fs::remove(tempFile, ec);
+        result.errorMessage = "Failed to read downloaded file";
+        return result;
+    }
+
+    Entry entry;
+    entry.sha256 = *sha256;
+    entry.suffix = archiveSuffix(url);
+    entry.size = fs::file_size(tempFile, ec);
+    if (auto it = download.headers.find("etag"); it != download.headers.end()) {
+        entry.etag = it->second;
+    }
+    if (auto it = download.headers.find("last-modified"); it != download.headers.end()) {
+        entry.lastModified = it->second;
+    }
+
+    // Identical content from another URL is already stored under the same name
+    fs::path object = objectPath(entry.sha256, entry.suffix);
+    fs::create_directories(object.parent_path(), ec);
+    if (fs::exists(object)) {
+        fs::remove(tempFile, ec);
+    } else {
+        fs::rename(tempFile, object, ec);
+        if (ec) {
+            fs::remove(tempFile, ec);
+            result.errorMessage = "Failed to store download in cache: " + ec.message();
+            return result;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(indexMutex());
+        Index index = loadIndex(root_);
+        entry.lastUsed = nextUseStamp();
+        index[url] = entry;
+        saveIndex(root_, index);
+    }
+    prune();
+
+    result.success = true;
+    result.path = object;
+    result.sha256 = entry.sha256;
+    result.bytesDownloaded = download.bytesDownloaded;
+    return result;
+}
+
+std::optional<fs::path> DownloadCache::lookup(const std::string& url) {
+    std::lock_guard<std::mutex> lock(indexMutex());
+    Index index = loadIndex(root_);
+    auto it = index.find(url);
+    if (it == index.end()) {
+        return std::nullopt;
+    }
+    fs::path object = objectPath(it->second.sha256, it->second.suffix);
+    if (!fs::exists(object)) {
+        return std::nullopt;
+    }
+    return object;
+}
+
+uint64_t DownloadCache::totalSize() {
+    std::lock_guard<std::mutex> lock(indexMutex());
+    std::map<std::string, uint64_t> objects;
+    for (const auto& [url, entry] : loadIndex(root_)) {
+        objects[entry.sha256 + entry.suffix] = entry.size;
+    }
+    uint64_t total = 0;
+    for (const auto& [name, size] : objects) {
+        total += size;
+    }
+    return total;
+}
+
+void DownloadCache::prune() {
+    std::lock_guard<std::mutex> lock(indexMutex());
+    Index index = loadIndex(root_);
+
+    // Several URLs can share an object; it was last used when any of them was
+    struct Object {
+        std::string sha256;
+        std::string suffix;
+        uint64_t size = 0;
+        int64_t lastUsed = 0;
+    };
+    std::map<std::string, Object> objects;
+    for (const auto& [url, entry] : index) {
+        Object& object = objects[entry.sha256 + entry.suffix];
+        object.sha256 = entry.sha256;
+        object.suffix = entry.suffix;
+        object.size = entry.size;
+        object.lastUsed = std::max(object.lastUsed, entry.lastUsed);
+    }
+
+    uint64_t total = 0;
+    std::vector<const Object*> byAge;
+    for (const auto& [name, object] : objects) {
+        total += object.size;
+        byAge.push_back(&object);
+    }
+    if (total <= settings_.maxBytes) {
+        return;
+    }
+    std::sort(byAge.begin(), byAge.end(),
+              [](const Object* a, const Object* b) { return a->lastUsed < b->lastUsed; });
+
+    // The most recently used object always stays, even when it alone exceeds the cap
+    size_t evicted = 0;
+    for (size_t i = 0; i + 1 < byAge.size() && total > settings_.maxBytes; ++i) {
+        const Object& object = *byAge[i];
+        std::error_code ec;
+        fs::remove(objectPath(object.sha256, object.suffix), ec);
+        for (auto it = index.begin(); it != index.end();) {
+            if (it->second.sha256 == object.sha256 && it->second.suffix == object.suffix) {
+                it = index.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        total -= object.size;
+        ++evicted;
+    }
+
+    saveIndex(root_, index);
+    spdlog::debug("Evicted {} cached downloads, {} bytes remain", evicted, total);
+}
+
+bool DownloadCache::clear() {
+    std::lock_guard<std::mutex> lock(indexMutex());
+    std::error_code ec;
+    fs::remove_all(root_, ec);
+    return !ec;
+}
+
+fs::path DownloadCache::objectPath(const std::string& sha256, const std::string& suffix) const {
+    return root_ / "objects" / sha256.substr(0, 2) / (sha256 + suffix);
+}
+
+fs::path DownloadCache::temporaryPath() const {
+    return root_ / "tmp" / (uniqueName() + ".part");
+}
+
+}  // namespace utils
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+
+#include "http_client.h"
+
+namespace utils {
+
+// Content-addressed cache for downloaded archives.
+//
+// Bodies are stored once per SHA-256 under objects/, and index.json maps each
+// URL to its object together with the ETag/Last-Modified validators the
+// server sent. A cached URL is revalidated with a conditional GET, so an
+// unchanged template costs a 304 instead of a full download; when the server
+// cannot be reached the cached copy is used anyway. The cache is trimmed to
+// maxBytes by evicting the least recently used objects.
+//
+// Safe to use from several threads; separate processes sharing the cache
+// never see torn files (everything is written to tmp/ and renamed), but may
+// lose each other's index updates, which only costs a re-download.
+class DownloadCache {
+   public:
+    struct Settings {
+        uint64_t maxBytes = 1024ull * 1024 * 1024;
+        // Serve from the cache only, never touch the network
+        bool offline = false;
+        // Ask the server whether cached entries are still current
+        bool revalidate = true;
+    };
+
+    struct FetchResult {
+        bool success = false;
+        std::string errorMessage;
+        std::filesystem::path path;  // Cached file; keeps the URL's archive extension
+        std::string sha256;
+        bool fromCache = false;  // No body was transferred
+        bool stale = false;      // Revalidation failed and the cached copy was used
+        size_t bytesDownloaded = 0;
+    };
+
+    explicit DownloadCache(std::filesystem::path root);
+    DownloadCache(std::filesystem::path root, Settings settings);
+
+    // Settings from CPP_SCAFFOLD_OFFLINE (1/true) and
+    // CPP_SCAFFOLD_DOWNLOAD_CACHE_MB (size cap in MiB)
+    static Settings settingsFromEnvironment();
+
+    // Returns a local copy of url, downloading it only when needed
+    FetchResult fetch(const std::string& url,
+                      const HttpClient::ProgressCallback& progressCallback = nullptr);
+
+    // Cached copy of url without contacting the server
+    std::optional<std::filesystem::path> lookup(const std::string& url);
+
+    // Size of all cached objects
+    uint64_t totalSize();
+
+    // Evicts least recently used objects until the cache fits maxBytes
+    void prune();
+
+    bool clear();
+
+    const std::filesystem::path& root() const {
+        return root_;
+    }
+
+   private:
+    std::filesystem::path objectPath(const std::string& sha256, const std::string& suffix) const;
+    std::filesystem::path temporaryPath() const;
+
+    std::filesystem::path root_;
+    Settings settings_;
+};
+
+}  // namespace utils
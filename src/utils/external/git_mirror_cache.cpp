@@ -0,0 +1,172 @@
+#include "../external/git_mirror_cache.h"
+
+#include <spdlog/spdlog.h>
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "../core/hash_utils.h"
+#include "../core/process_runner.h"
+#include "../core/string_utils.h"
+#include "../external/git_utils.h"
+
+namespace utils {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// Failures are logged with git's own message unless quiet (for probes)
+bool runGit(const std::vector<std::string>& args, const fs::path& workingDir = {},
+            bool quiet = false) {
+    std::vector<std::string> command = {"git"};
+    command.insert(command.end(), args.begin(), args.end());
+
+    ProcessOptions options;
+    options.workingDirectory = workingDir;
+    ProcessResult result = ProcessRunner::run(command, options);
+    if (!result.success() && !quiet) {
+        spdlog::warn("{} failed: {}", ProcessRunner::formatCommand(command),
+                     StringUtils::trim(result.error.empty() ? result.errorMessage : result.error));
+    }
+    return result.success();
+}
+
+// One lock per mirror, so parallel batch jobs using the same template fetch
+// it once instead of racing each other
+std::mutex& mirrorMutex(const fs::path& mirror) {
+    static std::mutex registryMutex;
+    static std::map<std::string, std::unique_ptr<std::mutex>> mutexes;
+    std::lock_guard<std::mutex> lock(registryMutex);
+    auto& mutex = mutexes[mirror.string()];
+    if (!mutex) {
+        mutex = std::make_unique<std::mutex>();
+    }
+    return *mutex;
+}
+
+bool hasCommit(const fs::path& mirror, const std::string& revision) {
+    return runGit({"--git-dir", mirror.string(), "rev-parse", "--verify", "--quiet",
+                   revision + "^{commit}"},
+                  {}, true);
+}
+
+}  // namespace
+
+GitMirrorCache::GitMirrorCache(fs::path root, bool offline)
+    : root_(std::move(root)), offline_(offline) {}
+
+fs::path GitMirrorCache::mirrorPath(const std::string& url) const {
+    std::string name = GitUtils::extractRepositoryName(url);
+    if (name.empty()) {
+        name = "repository";
+    }
+    return root_ / (name + "-" + Sha256::toHex(Sha256::hash(url)).substr(0, 16) + ".git");
+}
+
+std::optional<fs::path> GitMirrorCache::updateMirror(const std::string& url,
+                                                     const std::string& revision) {
+    fs::path mirror = mirrorPath(url);
+    std::lock_guard<std::mutex> lock(mirrorMutex(mirror));
+    std::error_code ec;
+
+    if (!fs::exists(mirror / "HEAD")) {
+        if (offline_) {
+            spdlog::error("No cached mirror of {} (offline mode)", url);
+            return std::nullopt;
+        }
+
+        // Cloned beside the final name and renamed, so an interrupted clone
+        // never leaves a half-populated mirror behind
+        static std::atomic<unsigned> counter{0};
+        fs::create_directories(root_, ec);
+        fs::path staging = root_ / ("." + mirror.filename().string() + "." +
+                                    std::to_string(counter++) + ".tmp");
+        fs::remove_all(staging, ec);
+
+        spdlog::info("Creating mirror of {}", url);
+        if (!runGit({"clone", "--mirror", "--quiet", url, staging.string()})) {
+            fs::remove_all(staging, ec);
+            spdlog::error("Failed to mirror repository: {}", url);
+            return std::nullopt;
+        }
+        fs::rename(staging, mirror, ec);
+        if (ec) {
+            // Another process created the mirror first; use theirs
+            fs::remove_all(staging, ec);
+        }
+        return mirror;
+    }
+
+    // Tags and commits do not move, so one already in the mirror is current
+    if (!revision.empty() && hasCommit(mirror, revision)) {
+        spdlog::info("Using cached mirror of {} at {}", url, revision);
+        return mirror;
+    }
+    if (offline_) {
+        spdlog::info("Using cached mirror of {} without fetching (offline mode)", url);
+        return mirror;
+    }
+
+    spdlog::info("Updating cached mirror of {}", url);
+    if (!runGit({"--git-dir", mirror.string(), "fetch", "--prune", "--quiet", "origin"})) {
+        spdlog::warn("Could not update the mirror of {}, using the cached copy", url);
+    }
+    return mirror;
+}
+
+bool GitMirrorCache::checkout(const CheckoutRequest& request, const fs::path& target) {
+    std::string revision;
+    if (!request.branch) {
+        if (request.tag) {
+            revision = "refs/tags/" + *request.tag;
+        } else if (request.commit) {
+            revision = *request.commit;
+        }
+    }
+
+    auto mirror = updateMirror(request.url, revision);
+    if (!mirror) {
+        return false;
+    }
+
+    // Objects are borrowed from the mirror when the history is dropped
+    // afterwards, and hardlinked (copied across filesystems) when it is kept
+    std::vector<std::string> cloneArgs = {"clone", "--quiet",
+                                          request.keepHistory ? "--local" : "--shared"};
+    if (request.branch) {
+        cloneArgs.insert(cloneArgs.end(), {"--branch", *request.branch});
+    } else if (request.tag) {
+        cloneArgs.insert(cloneArgs.end(), {"--branch", *request.tag});
+    } else if (request.commit) {
+        cloneArgs.push_back("--no-checkout");
+    }
+    cloneArgs.push_back(mirror->string());
+    cloneArgs.push_back(target.string());
+
+    if (!runGit(cloneArgs)) {
+        spdlog::error("Failed to check out {} from the cached mirror", request.url);
+        return false;
+    }
+
+    if (request.commit && !request.branch && !request.tag) {
+        if (!runGit({"-c", "advice.detachedHead=false", "checkout", "--quiet", *request.commit},
+                    target)) {
+            spdlog::error("Failed to checkout commit: {}", *request.commit);
+            return false;
+        }
+    }
+
+    if (request.keepHistory &&
+        !runGit({"remote", "set-url", "origin", request.url}, target)) {
+        spdlog::warn("Failed to point origin at {}", request.url);
+    }
+
+    spdlog::info("Checked out {} from cached mirror", request.url);
+    return true;
+}
+
+}  // namespace utils
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <filesystem>
+#include <optional>
+#include <string>
+
+namespace utils {
+
+// Bare mirrors of template repositories, keyed by URL.
+//
+// The first checkout of a repository makes a "git clone --mirror" under the
+// cache root; later checkouts only fetch what changed, and a tag or commit
+// that the mirror already has is checked out without contacting the remote
+// at all. Projects are cloned from the mirror locally: with --shared when
+// the history is going to be dropped anyway, and with hardlinked objects
+// (--local) when it is kept, so the project never depends on the cache.
+class GitMirrorCache {
+   public:
+    struct CheckoutRequest {
+        std::string url;
+        std::optional<std::string> branch;  // Takes precedence over tag and commit
+        std::optional<std::string> tag;
+        std::optional<std::string> commit;
+        bool keepHistory = false;  // Project keeps .git, with origin pointing at url
+    };
+
+    // offline: never fetch; checkouts are served from existing mirrors only
+    explicit GitMirrorCache(std::filesystem::path root, bool offline = false);
+
+    // Checks the requested revision out into target, which must not exist
+    bool checkout(const CheckoutRequest& request, const std::filesystem::path& target);
+
+    // Creates or refreshes the mirror for url. revision (a tag or commit) that
+    // the mirror already contains is trusted without fetching.
+    std::optional<std::filesystem::path> updateMirror(const std::string& url,
+                                                      const std::string& revision = "");
+
+    std::filesystem::path mirrorPath(const std::string& url) const;
+
+   private:
+    std::filesystem::path root_;
+    bool offline_;
+};
+
+}  // namespace utils
@@ -0,0 +1,991 @@
+#include "../external/git_native.h"
+
+#include <spdlog/fmt/fmt.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#include "../core/hash_utils.h"
+
+#ifdef CPP_SCAFFOLD_HAS_ZLIB
+#include <zlib.h>
+#endif
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace utils {
+
+namespace {
+
+constexpr const char* DEFAULT_EXCLUDE =
+        "# git ls-files --others --exclude-from=.git/info/exclude\n"
+        "# Lines that start with '#' are comments.\n"
+        "# For a project mostly in C, the following would be a good set of\n"
+        "# exclude patterns (uncomment them if you want to use them):\n"
+        "# *.[oa]\n"
+        "# *~\n";
+
+constexpr const char* DEFAULT_DESCRIPTION =
+        "Unnamed repository; edit this file 'description' to name the repository.\n";
+
+// Hooks that "git commit" would run; their presence sends commits to the CLI
+constexpr const char* COMMIT_HOOKS[] = {"pre-commit", "prepare-commit-msg", "commit-msg",
+                                        "post-commit"};
+
+bool readFile(const fs::path& path, std::string& content) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::ostringstream buffer;
+    buffer << file.rdbuf();
+    content = buffer.str();
+    return !file.bad();
+}
+
+bool writeFile(const fs::path& path, std::string_view content) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+    file.write(content.data(), static_cast<std::streamsize>(content.size()));
+    return !file.fail();
+}
+
+// Writes next to the target and renames, so readers never see partial files
+bool replaceFile(const fs::path& path, std::string_view content) {
+    fs::path temp = path;
+    temp += ".lock";
+    if (!writeFile(temp, content)) {
+        return false;
+    }
+    std::error_code ec;
+    fs::rename(temp, path, ec);
+    if (ec) {
+        fs::remove(temp, ec);
+        return false;
+    }
+    return true;
+}
+
+std::string toLower(std::string value) {
+    std::transform(value.begin(), value.end(), value.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return value;
+}
+
+std::string trimmed(std::string_view value) {
+    size_t start = value.find_first_not_of(" \t\r\n");
+    if (start == std::string_view::npos) {
+        return {};
+    }
+    size_t end = value.find_last_not_of(" \t\r\n");
+    return std::string(value.substr(start, end - start + 1));
+}
+
+// ---------------------------------------------------------------------------
+// git config files
+
+// Section name of a "[section]" or "[section "sub"]" header line; nullopt for
+// other lines. Subsections are returned as "section.sub".
+std::optional<std::string> parseSectionHeader(const std::string& line) {
+    if (line.empty() || line.front() != '[') {
+        return std::nullopt;
+    }
+    size_t close = line.rfind(']');
+    if (close == std::string::npos) {
+        return std::nullopt;
+    }
+    std::string header = line.substr(1, close - 1);
+    size_t quote = header.find('"');
+    if (quote == std::string::npos) {
+        return toLower(trimmed(header));
+    }
+    std::string sub = header.substr(quote + 1);
+    if (!sub.empty() && sub.back() == '"') {
+        sub.pop_back();
+    }
+    return toLower(trimmed(header.substr(0, quote))) + "." + sub;
+}
+
+std::string parseConfigValue(std::string_view raw) {
+    std::string value;
+    bool quoted = false;
+    std::string pendingSpace;
+    for (size_t i = 0; i < raw.size(); ++i) {
+        char c = raw[i];
+        if (!quoted && (c == '#' || c == ';')) {
+            break;
+        }
+        if (c == '"') {
+            quoted = !quoted;
+            continue;
+        }
+        if (c == '\\' && i + 1 < raw.size()) {
+            char next = raw[++i];
+            value += pendingSpace;
+            pendingSpace.clear();
+            value += next == 'n' ? '\n' : next == 't' ? '\t' : next;
+            continue;
+        }
+        if (!quoted && (c == ' ' || c == '\t')) {
+            // Unquoted whitespace only counts between words
+            if (!value.empty()) {
+                pendingSpace += c;
+            }
+            continue;
+        }
+        value += pendingSpace;
+        pendingSpace.clear();
+        value += c;
+    }
+    return value;
+}
+
+std::optional<std::string> readConfigValue(const fs::path& path, const std::string& section,
+                                           const std::string& key) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return std::nullopt;
+    }
+
+    std::optional<std::string> result;
+    std::string current;
+    std::string line;
+    const std::string wantedKey = toLower(key);
+    while (std::getline(file, line)) {
+        line = trimmed(line);
+        if (auto header = parseSectionHeader(line)) {
+            current = *header;
+            continue;
+        }
+        if (current != section || line.empty() || line[0] == '#' || line[0] == ';') {
+            continue;
+        }
+        size_t eq = line.find('=');
+        std::string name = toLower(trimmed(line.substr(0, eq)));
+        if (name != wantedKey) {
+            continue;
+        }
+        // A bare key is boolean true; the last occurrence wins
+        result = eq == std::string::npos ? "true" : parseConfigValue(line.substr(eq + 1));
+    }
+    return result;
+}
+
+std::string quoteConfigValue(const std::string& value) {
+    bool needsQuotes = value.empty() || value.front() == ' ' || value.back() == ' ' ||
+                       value.find_first_of("#;") != std::string::npos;
+    std::string escaped;
+    for (char c : value) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+        }
+        if (c == '\n') {
+            escaped += "\\n";
+            continue;
+        }
+        escaped += c;
+    }
+    return needsQuotes ? "\"" + escaped + "\"" : escaped;
+}
+
+// Spellings git accepts for a false boolean
+bool isFalseConfigValue(const std::string& value) {
+    std::string lower = toLower(value);
+    return lower.empty() || lower == "false" || lower == "no" || lower == "off" || lower == "0";
+}
+
+// System, XDG and ~/.gitconfig in increasing priority, like git
+std::vector<fs::path> globalConfigFiles() {
+    std::vector<fs::path> files;
+    if (!std::getenv("GIT_CONFIG_NOSYSTEM")) {
+        files.emplace_back("/etc/gitconfig");
+    }
+    if (const char* global = std::getenv("GIT_CONFIG_GLOBAL")) {
+        files.emplace_back(global);
+        return files;
+    }
+    const char* home = std::getenv("HOME");
+    if (const char* xdg = std::getenv("XDG_CONFIG_HOME"); xdg && *xdg) {
+        files.push_back(fs::path(xdg) / "git" / "config");
+    } else if (home) {
+        files.push_back(fs::path(home) / ".config" / "git" / "config");
+    }
+    if (home) {
+        files.push_back(fs::path(home) / ".gitconfig");
+    }
+    return files;
+}
+
+// True if path pulls in other files through [include] or [includeIf "..."],
+// whose values readConfigValue() would miss
+bool hasConfigIncludes(const fs::path& path) {
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line)) {
+        auto header = parseSectionHeader(trimmed(line));
+        if (header && (*header == "include" || header->rfind("includeif.", 0) == 0)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool globalConfigHasIncludes() {
+    for (const auto& file : globalConfigFiles()) {
+        if (hasConfigIncludes(file)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::optional<std::string> readGlobalConfig(const std::string& section, const std::string& key) {
+    std::optional<std::string> result;
+    for (const auto& file : globalConfigFiles()) {
+        if (auto value = readConfigValue(file, section, key)) {
+            result = value;
+        }
+    }
+    return result;
+}
+
+// ---------------------------------------------------------------------------
+// .gitignore matching
+
+// Glob matching with gitignore semantics: '*' and '?' stop at '/', "**"
+// spans directories when it forms a whole path component.
+bool wildmatch(const char* pattern, const char* patternStart, const char* text) {
+    while (*pattern) {
+        switch (*pattern) {
+            case '?':
+                if (!*text || *text == '/') {
+                    return false;
+                }
+                ++pattern;
+                ++text;
+                break;
+            case '*': {
+                bool componentStart = pattern == patternStart || pattern[-1] == '/';
+                if (pattern[1] == '*' && componentStart) {
+                    if (pattern[2] == '\0') {
+                        return true;  // Trailing "/**" matches everything inside
+                    }
+                    if (pattern[2] == '/') {
+                        // "**/" matches zero or more leading directories
+                        const char* rest = pattern + 3;
+                        if (wildmatch(rest, patternStart, text)) {
+                            return true;
+                        }
+                        for (const char* p = text; *p; ++p) {
+                            if (*p == '/' && wildmatch(rest, patternStart, p + 1)) {
+                                return true;
+                            }
+                        }
+                        return false;
+                    }
+                }
+                while (*pattern == '*') {
+                    ++pattern;
+                }
+                for (;; ++text) {
+                    if (wildmatch(pattern, patternStart, text)) {
+                        return true;
+                    }
+                    if (!*text || *text == '/') {
+                        return false;
+                    }
+                }
+            }
+            case '[': {
+                if (!*text || *text == '/') {
+                    return false;
+                }
+                const char* p = pattern + 1;
+                bool negate = *p == '!' || *p == '^';
+                if (negate) {
+                    ++p;
+                }
+                bool matched = false;
+                bool first = true;
+                while (*p && (first || *p != ']')) {
+                    first = false;
+                    char low = *p;
+                    if (low == '\\' && p[1]) {
+                        low = *++p;
+                    }
+                    char high = low;
+                    if (p[1] == '-' && p[2] && p[2] != ']') {
+                        high = p[2];
+                        p += 2;
+                    }
+                    if (*text >= low && *text <= high) {
+                        matched = true;
+                    }
+                    ++p;
+                }
+                if (*p != ']' || matched == negate) {
+                    return false;
+                }
+                pattern = p + 1;
+                ++text;
+                break;
+            }
+            case '\\':
+                if (pattern[1]) {
+                    ++pattern;
+                }
+                [[fallthrough]];
+            default:
+                if (*pattern != *text) {
+                    return false;
+                }
+                ++pattern;
+                ++text;
+                break;
+        }
+    }
+    return *text == '\0';
+}
+
+class IgnoreRules {
+   public:
+    // Adds the patterns of one ignore file; base is the directory it applies
+    // to, relative to the work tree ("" or ending in '/')
+    void addFile(const fs::path& file, const std::string& base) {
+        std::ifstream input(file);
+        std::string line;
+        while (std::getline(input, line)) {
+            addPattern(line, base);
+        }
+    }
+
+    bool isIgnored(const std::string& path, bool isDirectory) const {
+        // The last matching pattern decides, so search backwards
+        for (auto it = rules_.rbegin(); it != rules_.rend(); ++it) {
+            const Rule& rule = *it;
+            if (rule.directoryOnly && !isDirectory) {
+                continue;
+            }
+            if (path.compare(0, rule.base.size(), rule.base) != 0) {
+                continue;
+            }
+            std::string relative = path.substr(rule.base.size());
+            if (!rule.anchored) {
+                size_t slash = relative.rfind('/');
+                if (slash != std::string::npos) {
+                    relative = relative.substr(slash + 1);
+                }
+            }
+            const char* glob = rule.glob.c_str();
+            if (wildmatch(glob, glob, relative.c_str())) {
+                return !rule.negated;
+            }
+        }
+        return false;
+    }
+
+   private:
+    struct Rule {
+        std::string glob;
+        std::string base;
+        bool negated = false;
+        bool directoryOnly = false;
+        bool anchored = false;
+    };
+
+    void addPattern(std::string line, const std::string& base) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        // Trailing spaces are ignored unless escaped
+        while (!line.empty() && line.back() == ' ' &&
+               (line.size() < 2 || line[line.size() - 2] != '\\')) {
+            line.pop_back();
+        }
+        if (line.empty() || line[0] == '#') {
+            return;
+        }
+
+        Rule rule;
+        rule.base = base;
+        if (line[0] == '!') {
+            rule.negated = true;
+            line.erase(0, 1);
+        } else if (line[0] == '\\' && line.size() > 1 && (line[1] == '#' || line[1] == '!')) {
+            line.erase(0, 1);
+        }
+        if (!line.empty() && line.back() == '/') {
+            rule.directoryOnly = true;
+            line.pop_back();
+        }
+        if (line.empty()) {
+            return;
+        }
+        rule.anchored = line.find('/') != std::string::npos;
+        if (line[0] == '/') {
+            line.erase(0, 1);
+        }
+        rule.glob = std::move(line);
+        rules_.push_back(std::move(rule));
+    }
+
+    std::vector<Rule> rules_;
+};
+
+// ---------------------------------------------------------------------------
+// Objects
+
+std::optional<Sha1::Digest> storeObject(const fs::path& objectsDir, std::string_view type,
+                                        std::string_view content) {
+#ifdef CPP_SCAFFOLD_HAS_ZLIB
+    std::string header = fmt::format("{} {}", type, content.size());
+    header.push_back('\0');
+
+    Sha1 sha;
+    sha.update(header);
+    sha.update(content);
+    Sha1::Digest id = sha.finish();
+    std::string hex = Sha1::toHex(id);
+
+    fs::path dir = objectsDir / hex.substr(0, 2);
+    fs::path path = dir / hex.substr(2);
+    std::error_code ec;
+    if (fs::exists(path, ec)) {
+        return id;  // Identical content is stored once
+    }
+
+    // Loose objects use fast compression, like git's core.looseCompression
+    z_stream stream{};
+    if (deflateInit(&stream, Z_BEST_SPEED) != Z_OK) {
+        return std::nullopt;
+    }
+    std::string compressed(deflateBound(&stream, header.size() + content.size()), '\0');
+    stream.next_out = reinterpret_cast<Bytef*>(compressed.data());
+    stream.avail_out = static_cast<uInt>(compressed.size());
+    stream.next_in = reinterpret_cast<Bytef*>(header.data());
+    stream.avail_in = static_cast<uInt>(header.size());
+    int rc = deflate(&stream, Z_NO_FLUSH);
+    if (rc == Z_OK) {
+        stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(content.data()));
+        stream.avail_in = static_cast<uInt>(content.size());
+        rc = deflate(&stream, Z_FINISH);
+    }
+    compressed.resize(stream.total_out);
+    deflateEnd(&stream);
+    if (rc != Z_STREAM_END) {
+        spdlog::debug("Failed to compress git object {}", hex);
+        return std::nullopt;
+    }
+
+    fs::create_directories(dir, ec);
+    if (!replaceFile(path, compressed)) {
+        spdlog::debug("Failed to write git object {}", path.string());
+        return std::nullopt;
+    }
+    fs::permissions(path, fs::perms::owner_read | fs::perms::group_read | fs::perms::others_read,
+                    ec);
+    return id;
+#else
+    (void)objectsDir;
+    (void)type;
+    (void)content;
+    return std::nullopt;
+#endif
+}
+
+void appendBigEndian32(std::string& out, uint32_t value) {
+    out.push_back(static_cast<char>(value >> 24));
+    out.push_back(static_cast<char>(value >> 16));
+    out.push_back(static_cast<char>(value >> 8));
+    out.push_back(static_cast<char>(value));
+}
+
+struct StagedFile {
+    std::string path;  // Relative, '/' separated
+    uint32_t mode = 0100644;
+    Sha1::Digest id{};
+    bool hasCarriageReturn = false;
+#ifndef _WIN32
+    struct stat st {};
+#endif
+};
+
+struct TreeNode {
+    std::map<std::string, TreeNode> directories;
+    std::vector<std::pair<std::string, const StagedFile*>> files;
+};
+
+std::optional<Sha1::Digest> storeTree(const fs::path& objectsDir, const TreeNode& node) {
+    struct Item {
+        std::string sortKey;
+        std::string name;
+        const char* mode;
+        Sha1::Digest id;
+    };
+    std::vector<Item> items;
+    for (const auto& [name, child] : node.directories) {
+        auto id = storeTree(objectsDir, child);
+        if (!id) {
+            return std::nullopt;
+        }
+        // Directories sort as if their name ended in '/'
+        items.push_back({name + "/", name, "40000", *id});
+    }
+    for (const auto& [name, file] : node.files) {
+        const char* mode = file->mode == 0100755 ? "100755"
+                           : file->mode == 0120000 ? "120000"
+                                                   : "100644";
+        items.push_back({name, name, mode, file->id});
+    }
+    std::sort(items.begin(), items.end(),
+              [](const Item& a, const Item& b) { return a.sortKey < b.sortKey; });
+
+    std::string content;
+    for (const auto& item : items) {
+        content += item.mode;
+        content += ' ';
+        content += item.name;
+        content += '\0';
+        content.append(reinterpret_cast<const char*>(item.id.data()), item.id.size());
+    }
+    return storeObject(objectsDir, "tree", content);
+}
+
+// Version 2 index ("DIRC") so that "git status" sees a clean work tree
+std::string buildIndex(const std::vector<StagedFile>& files) {
+    std::string index = "DIRC";
+    appendBigEndian32(index, 2);
+    appendBigEndian32(index, static_cast<uint32_t>(files.size()));
+
+    for (const auto& file : files) {
+        size_t start = index.size();
+#ifndef _WIN32
+        const struct stat& st = file.st;
+#if defined(__APPLE__)
+        appendBigEndian32(index, static_cast<uint32_t>(st.st_ctimespec.tv_sec));
+        appendBigEndian32(index, static_cast<uint32_t>(st.st_ctimespec.tv_nsec));
+        appendBigEndian32(index, static_cast<uint32_t>(st.st_mtimespec.tv_sec));
+        appendBigEndian32(index, static_cast<uint32_t>(st.st_mtimespec.tv_nsec));
+#else
+        appendBigEndian32(index, static_cast<uint32_t>(st.st_ctim.tv_sec));
+        appendBigEndian32(index, static_cast<uint32_t>(st.st_ctim.tv_nsec));
+        appendBigEndian32(index, static_cast<uint32_t>(st.st_mtim.tv_sec));
+        appendBigEndian32(index, static_cast<uint32_t>(st.st_mtim.tv_nsec));
+#endif
+        appendBigEndian32(index, static_cast<uint32_t>(st.st_dev));
+        appendBigEndian32(index, static_cast<uint32_t>(st.st_ino));
+        appendBigEndian32(index, file.mode);
+        appendBigEndian32(index, static_cast<uint32_t>(st.st_uid));
+        appendBigEndian32(index, static_cast<uint32_t>(st.st_gid));
+        appendBigEndian32(index, static_cast<uint32_t>(st.st_size));
+#endif
+        index.append(reinterpret_cast<const char*>(file.id.data()), file.id.size());
+        uint16_t flags = static_cast<uint16_t>(std::min<size_t>(file.path.size(), 0xFFF));
+        index.push_back(static_cast<char>(flags >> 8));
+        index.push_back(static_cast<char>(flags));
+        index += file.path;
+        // Entries are NUL padded to a multiple of eight bytes (at least one NUL)
+        size_t length = index.size() - start;
+        index.append(8 - (length % 8), '\0');
+    }
+
+    Sha1::Digest checksum = Sha1::hash(index);
+    index.append(reinterpret_cast<const char*>(checksum.data()), checksum.size());
+    return index;
+}
+
+std::string formatSignature(const GitIdentity& identity, std::time_t when) {
+    std::tm local{};
+#ifdef _WIN32
+    localtime_s(&local, &when);
+    long offset = 0;
+#else
+    localtime_r(&when, &local);
+    long offset = local.tm_gmtoff / 60;
+#endif
+    char sign = offset < 0 ? '-' : '+';
+    offset = std::labs(offset);
+    return fmt::format("{} <{}> {} {}{:02}{:02}", identity.name, identity.email,
+                       static_cast<long long>(when), sign, offset / 60, offset % 60);
+}
+
+bool isValidBranchName(const std::string& name) {
+    return !name.empty() && name.find("..") == std::string::npos &&
+           name.find_first_of(" ~^:?*[\\") == std::string::npos && name.front() != '-' &&
+           name.front() != '/' && name.back() != '/';
+}
+
+}  // namespace
+
+NativeGitRepository::NativeGitRepository(fs::path workTree)
+    : workTree_(std::move(workTree)), gitDir_(workTree_ / ".git") {}
+
+bool NativeGitRepository::isEnabled() {
+#if defined(CPP_SCAFFOLD_HAS_ZLIB) && !defined(_WIN32)
+    const char* backend = std::getenv("CPP_SCAFFOLD_GIT_BACKEND");
+    return !backend || std::string_view(backend) != "cli";
+#else
+    return false;
+#endif
+}
+
+bool NativeGitRepository::init() {
+    std::error_code ec;
+    if (fs::exists(gitDir_, ec)) {
+        return false;
+    }
+    if (globalConfigHasIncludes()) {
+        spdlog::debug("Native git: global config uses include; leaving init to git");
+        return false;
+    }
+
+    std::string branch = readGlobalConfig("init", "defaultbranch").value_or("master");
+    if (!isValidBranchName(branch)) {
+        branch = "master";
+    }
+
+    for (const char* dir : {"objects/info", "objects/pack", "refs/heads", "refs/tags", "hooks",
+                            "info"}) {
+        fs::create_directories(gitDir_ / dir, ec);
+        if (ec) {
+            spdlog::debug("Failed to create {}: {}", (gitDir_ / dir).string(), ec.message());
+            fs::remove_all(gitDir_, ec);
+            return false;
+        }
+    }
+
+    const std::string config =
+            "[core]\n"
+            "\trepositoryformatversion = 0\n"
+            "\tfilemode = true\n"
+            "\tbare = false\n"
+            "\tlogallrefupdates = true\n";
+    if (!writeFile(gitDir_ / "HEAD", "ref: refs/heads/" + branch + "\n") ||
+        !writeFile(gitDir_ / "config", config) ||
+        !writeFile(gitDir_ / "description", DEFAULT_DESCRIPTION) ||
+        !writeFile(gitDir_ / "info" / "exclude", DEFAULT_EXCLUDE)) {
+        fs::remove_all(gitDir_, ec);
+        return false;
+    }
+    return true;
+}
+
+std::optional<std::string> NativeGitRepository::getConfig(const std::string& section,
+                                                          const std::string& key) const {
+    return readConfigValue(gitDir_ / "config", toLower(section), key);
+}
+
+bool NativeGitRepository::setConfig(const std::string& section, const std::string& key,
+                                    const std::string& value) {
+    fs::path configPath = gitDir_ / "config";
+    std::ifstream input(configPath);
+    if (!input.is_open()) {
+        return false;
+    }
+
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(input, line);) {
+        lines.push_back(std::move(line));
+    }
+    input.close();
+
+    const std::string wantedSection = toLower(section);
+    const std::string wantedKey = toLower(key);
+    const std::string entry = "\t" + key + " = " + quoteConfigValue(value);
+
+    std::optional<size_t> insertAt;
+    std::optional<size_t> existing;
+    bool inSection = false;
+    for (size_t i = 0; i < lines.size(); ++i) {
+        std::string line = trimmed(lines[i]);
+        if (auto header = parseSectionHeader(line)) {
+            inSection = *header == wantedSection;
+            if (inSection) {
+                insertAt = i + 1;
+            }
+            continue;
+        }
+        if (!inSection || line.empty() || line[0] == '#' || line[0] == ';') {
+            continue;
+        }
+        insertAt = i + 1;
+        if (toLower(trimmed(line.substr(0, line.find('=')))) == wantedKey) {
+            existing = i;
+        }
+    }
+
+    if (existing) {
+        lines[*existing] = entry;
+    } else if (insertAt) {
+        lines.insert(lines.begin() + static_cast<std::ptrdiff_t>(*insertAt), entry);
+    } else {
+        lines.push_back("[" + section + "]");
+        lines.push_back(entry);
+    }
+
+    std::string content;
+    for (const auto& line : lines) {
+        content += line;
+        content += '\n';
+    }
+    return replaceFile(configPath, content);
+}
+
+std::optional<GitIdentity> NativeGitRepository::resolveIdentity(const char* nameVar,
+                                                                const char* emailVar) const {
+    GitIdentity identity;
+    if (const char* name = std::getenv(nameVar)) {
+        identity.name = name;
+    } else {
+        identity.name = getConfig("user", "name").value_or(
+                readGlobalConfig("user", "name").value_or(""));
+    }
+    if (const char* email = std::getenv(emailVar)) {
+        identity.email = email;
+    } else if (auto email = getConfig("user", "email")) {
+        identity.email = *email;
+    } else if (auto globalEmail = readGlobalConfig("user", "email")) {
+        identity.email = *globalEmail;
+    } else if (const char* fallback = std::getenv("EMAIL")) {
+        identity.email = fallback;
+    }
+
+    // git would guess from the host name here; leave that to the CLI
+    if (identity.name.empty() || identity.email.empty()) {
+        return std::nullopt;
+    }
+    return identity;
+}
+
+std::optional<std::string> NativeGitRepository::writeObject(std::string_view type,
+                                                            std::string_view content) {
+    auto id = storeObject(gitDir_ / "objects", type, content);
+    if (!id) {
+        return std::nullopt;
+    }
+    return Sha1::toHex(*id);
+}
+
+std::optional<std::string> NativeGitRepository::commitWorkingTree(const std::string& message) {
+#ifdef _WIN32
+    (void)message;
+    return std::nullopt;
+#else
+    if (!isEnabled()) {
+        return std::nullopt;
+    }
+
+    // Only an unborn branch with nothing staged is handled here
+    std::string head;
+    if (!readFile(gitDir_ / "HEAD", head) || head.rfind("ref: refs/heads/", 0) != 0) {
+        spdlog::debug("Native git: HEAD is not a branch reference");
+        return std::nullopt;
+    }
+    std::string headRef = trimmed(head.substr(5));
+    std::error_code ec;
+    if (fs::exists(gitDir_ / headRef, ec) || fs::exists(gitDir_ / "packed-refs", ec) ||
+        fs::exists(gitDir_ / "index", ec)) {
+        spdlog::debug("Native git: repository already has history or staged changes");
+        return std::nullopt;
+    }
+
+    // Commit hooks, a custom hooks path or fixed dates need the real "git commit"
+    for (const char* hook : COMMIT_HOOKS) {
+        if (::access((gitDir_ / "hooks" / hook).c_str(), X_OK) == 0) {
+            spdlog::debug("Native git: {} hook present", hook);
+            return std::nullopt;
+        }
+    }
+    if (getConfig("core", "hooksPath") || readGlobalConfig("core", "hookspath") ||
+        std::getenv("GIT_AUTHOR_DATE") || std::getenv("GIT_COMMITTER_DATE")) {
+        return std::nullopt;
+    }
+
+    // Included files could set any of the values read below
+    if (hasConfigIncludes(gitDir_ / "config") || globalConfigHasIncludes()) {
+        spdlog::debug("Native git: config uses include");
+        return std::nullopt;
+    }
+
+    auto author = resolveIdentity("GIT_AUTHOR_NAME", "GIT_AUTHOR_EMAIL");
+    auto committer = resolveIdentity("GIT_COMMITTER_NAME", "GIT_COMMITTER_EMAIL");
+    if (!author || !committer) {
+        spdlog::debug("Native git: no user identity configured");
+        return std::nullopt;
+    }
+
+    // Same sources "git add ." consults, lowest priority first
+    IgnoreRules ignore;
+    if (auto excludesFile = readGlobalConfig("core", "excludesfile")) {
+        std::string path = *excludesFile;
+        const char* home = std::getenv("HOME");
+        if (path.rfind("~/", 0) == 0 && home) {
+            path = std::string(home) + path.substr(1);
+        }
+        ignore.addFile(path, "");
+    } else if (const char* xdg = std::getenv("XDG_CONFIG_HOME"); xdg && *xdg) {
+        ignore.addFile(fs::path(xdg) / "git" / "ignore", "");
+    } else if (const char* home = std::getenv("HOME")) {
+        ignore.addFile(fs::path(home) / ".config" / "git" / "ignore", "");
+    }
+    ignore.addFile(gitDir_ / "info" / "exclude", "");
+
+    // Walk the tree, hashing and storing each blob as it is read
+    const fs::path objectsDir = gitDir_ / "objects";
+    std::vector<StagedFile> files;
+    bool hasAttributes = false;
+    std::vector<std::pair<fs::path, std::string>> pending = {{workTree_, ""}};
+    while (!pending.empty()) {
+        auto [dir, prefix] = std::move(pending.back());
+        pending.pop_back();
+
+        if (fs::exists(dir / ".gitignore", ec)) {
+            ignore.addFile(dir / ".gitignore", prefix);
+        }
+        hasAttributes = hasAttributes || fs::exists(dir / ".gitattributes", ec);
+
+        for (const auto& entry : fs::directory_iterator(dir, ec)) {
+            std::string name = entry.path().filename().string();
+            if (name == ".git") {
+                if (!prefix.empty()) {
+                    spdlog::debug("Native git: nested repository at {}{}", prefix, name);
+                    return std::nullopt;
+                }
+                continue;
+            }
+
+            std::string relative = prefix + name;
+            struct stat st;
+            if (::lstat(entry.path().c_str(), &st) != 0) {
+                return std::nullopt;
+            }
+            if (S_ISDIR(st.st_mode)) {
+                if (!ignore.isIgnored(relative, true)) {
+                    pending.emplace_back(entry.path(), relative + "/");
+                }
+                continue;
+            }
+            if (ignore.isIgnored(relative, false)) {
+                continue;
+            }
+
+            StagedFile file;
+            file.path = relative;
+            file.st = st;
+            std::string content;
+            if (S_ISLNK(st.st_mode)) {
+                file.mode = 0120000;
+                content = fs::read_symlink(entry.path(), ec).string();
+            } else if (S_ISREG(st.st_mode)) {
+                file.mode = (st.st_mode & S_IXUSR) ? 0100755 : 0100644;
+                if (!readFile(entry.path(), content)) {
+                    return std::nullopt;
+                }
+            } else {
+                continue;  // Sockets, fifos and devices are never tracked
+            }
+            auto id = storeObject(objectsDir, "blob", content);
+            if (!id) {
+                return std::nullopt;
+            }
+            file.id = *id;
+            file.hasCarriageReturn = content.find('\r') != std::string::npos;
+            files.push_back(std::move(file));
+        }
+        if (ec) {
+            spdlog::debug("Native git: cannot list {}: {}", dir.string(), ec.message());
+            return std::nullopt;
+        }
+    }
+
+    if (files.empty()) {
+        return std::nullopt;  // "git commit" refuses an empty initial commit too
+    }
+    // Line ending normalization from .gitattributes, core.autocrlf or
+    // core.eol would change the blobs
+    bool convertsLineEndings = hasAttributes;
+    for (const char* key : {"autocrlf", "eol"}) {
+        auto value = getConfig("core", key);
+        if (!value) {
+            value = readGlobalConfig("core", key);
+        }
+        convertsLineEndings = convertsLineEndings || (value && !isFalseConfigValue(*value));
+    }
+    for (const auto& file : files) {
+        if (convertsLineEndings && file.hasCarriageReturn) {
+            spdlog::debug("Native git: {} needs line ending conversion", file.path);
+            return std::nullopt;
+        }
+    }
+    std::sort(files.begin(), files.end(),
+              [](const StagedFile& a, const StagedFile& b) { return a.path < b.path; });
+
+    TreeNode root;
+    for (const auto& file : files) {
+        TreeNode* node = &root;
+        size_t start = 0;
+        size_t slash;
+        while ((slash = file.path.find('/', start)) != std::string::npos) {
+            node = &node->directories[file.path.substr(start, slash - start)];
+            start = slash + 1;
+        }
+        node->files.emplace_back(file.path.substr(start), &file);
+    }
+    auto tree = storeTree(objectsDir, root);
+    if (!tree) {
+        return std::nullopt;
+    }
+
+    std::time_t now = std::time(nullptr);
+    std::string authorLine = formatSignature(*author, now);
+    std::string committerLine = formatSignature(*committer, now);
+    std::string body = message;
+    if (body.empty() || body.back() != '\n') {
+        body += '\n';
+    }
+    std::string commitContent = fmt::format("tree {}\nauthor {}\ncommitter {}\n\n{}",
+                                            Sha1::toHex(*tree), authorLine, committerLine, body);
+    auto commit = storeObject(objectsDir, "commit", commitContent);
+    if (!commit) {
+        return std::nullopt;
+    }
+    std::string commitId = Sha1::toHex(*commit);
+
+    if (!replaceFile(gitDir_ / "index", buildIndex(files))) {
+        return std::nullopt;
+    }
+    fs::create_directories((gitDir_ / headRef).parent_path(), ec);
+    if (!replaceFile(gitDir_ / headRef, commitId + "\n")) {
+        fs::remove(gitDir_ / "index", ec);
+        return std::nullopt;
+    }
+
+    // Reflogs, as core.logAllRefUpdates would record them
+    std::string subject = message.substr(0, message.find('\n'));
+    std::string logEntry = fmt::format("{} {} {}\tcommit (initial): {}\n", std::string(40, '0'),
+                                       commitId, committerLine, subject);
+    fs::create_directories((gitDir_ / "logs" / headRef).parent_path(), ec);
+    writeFile(gitDir_ / "logs" / "HEAD", logEntry);
+    writeFile(gitDir_ / "logs" / headRef, logEntry);
+
+    return commitId;
+#endif
+}
+
+}  // namespace utils
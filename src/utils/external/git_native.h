@@ -0,0 +1,65 @@
+#pragma once
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace utils {
+
+// Author/committer identity recorded in commits
+struct GitIdentity {
+    std::string name;
+    std::string email;
+};
+
+// In-process writer for freshly generated repositories.
+//
+// Creates the .git layout, writes zlib-compressed loose objects, the index
+// and the initial commit directly, so generating a project does not have to
+// spawn git for init/config/add/commit. It only handles the simple case of a
+// brand new repository; anything it does not understand (existing history,
+// staged changes, nested repositories, missing identity, CRLF content under
+// .gitattributes, core.autocrlf or core.eol, config files using include or
+// includeIf) is reported as unsupported so callers can fall back to the git
+// CLI, which also remains responsible for remotes, branches and hooks.
+class NativeGitRepository {
+   public:
+    explicit NativeGitRepository(std::filesystem::path workTree);
+
+    // False when built without zlib or when CPP_SCAFFOLD_GIT_BACKEND=cli
+    static bool isEnabled();
+
+    // Creates an empty repository; HEAD points at init.defaultBranch from the
+    // user's global git config, or "master" like git itself. Fails without
+    // touching anything if that config includes other files
+    bool init();
+
+    // Sets "section.key" in .git/config, replacing an existing value
+    bool setConfig(const std::string& section, const std::string& key, const std::string& value);
+    std::optional<std::string> getConfig(const std::string& section,
+                                         const std::string& key) const;
+
+    // Stages every file in the working tree that .gitignore does not exclude,
+    // writes the index and commits it as the root commit of the unborn HEAD
+    // branch. Returns the commit id, or nullopt when the repository is not in
+    // a state this writer supports. The index, HEAD and reflogs are then left
+    // untouched, but blobs stored during the walk stay behind as unreferenced
+    // loose objects, like those of an interrupted "git add"; git gc prunes them.
+    std::optional<std::string> commitWorkingTree(const std::string& message);
+
+    // Writes a loose object and returns its hex id
+    std::optional<std::string> writeObject(std::string_view type, std::string_view content);
+
+    const std::filesystem::path& gitDir() const {
+        return gitDir_;
+    }
+
+   private:
+    std::optional<GitIdentity> resolveIdentity(const char* nameVar, const char* emailVar) const;
+
+    std::filesystem::path workTree_;
+    std::filesystem::path gitDir_;
+};
+
+}  // namespace utils
@@ -10,7 +10,10 @@
 #include <sstream>
 
 #include "../core/file_utils.h"
+#include "../core/process_runner.h"
 #include "../core/string_utils.h"
+#include "../core/tool_registry.h"
+#include "../external/git_native.h"
 
 #ifdef _WIN32
 #include <windows.h>
@@ -28,6 +31,12 @@ bool GitUtils::initializeRepository(const std::filesystem::path& projectPath) {
             return true;
         }
 
+        // Written in-process where possible; "git init" is the fallback
+        if (NativeGitRepository::isEnabled() && NativeGitRepository(projectPath).init()) {
+            spdlog::info("Git repository initialized at {}", projectPath.string());
+            return true;
+        }
+
         if (!hasGitInstalled()) {
             spdlog::error("Git is not installed or not found in PATH");
             return false;
@@ -54,8 +63,7 @@ bool GitUtils::isGitRepository(const std::filesystem::path& path) {
 }
 
 bool GitUtils::hasGitInstalled() {
-    std::string output;
-    return executeGitCommand(std::filesystem::current_path(), {"--version"}, &output);
+    return ToolRegistry::getInstance().isAvailable("git");
 }
 
 bool GitUtils::createGitignore(const std::filesystem::path& projectPath,
@@ -150,19 +158,19 @@ bool GitUtils::configureRepository(const std::filesystem::path& projectPath,
                                    const std::string& userName, const std::string& userEmail) {
     try {
         if (!userName.empty()) {
-            if (!executeGitCommand(projectPath, {"config", "user.name", userName})) {
+            if (!setConfigValue(projectPath, "user", "name", userName)) {
                 spdlog::warn("Failed to set Git user name");
             }
         }
 
         if (!userEmail.empty()) {
-            if (!executeGitCommand(projectPath, {"config", "user.email", userEmail})) {
+            if (!setConfigValue(projectPath, "user", "email", userEmail)) {
                 spdlog::warn("Failed to set Git user email");
             }
         }
 
         // Set default branch name to main
-        executeGitCommand(projectPath, {"config", "init.defaultBranch", "main"});
+        setConfigValue(projectPath, "init", "defaultBranch", "main");
 
         return true;
 
@@ -175,6 +183,14 @@ bool GitUtils::configureRepository(const std::filesystem::path& projectPath,
 bool GitUtils::createInitialCommit(const std::filesystem::path& projectPath,
                                    const std::string& message) {
     try {
+        if (NativeGitRepository::isEnabled()) {
+            if (auto commit = NativeGitRepository(projectPath).commitWorkingTree(message)) {
+                spdlog::info("Created initial commit {}: {}", commit->substr(0, 7), message);
+                return true;
+            }
+            spdlog::debug("Falling back to the git CLI for the initial commit");
+        }
+
         // Add all files
         if (!executeGitCommand(projectPath, {"add", "."})) {
             spdlog::error("Failed to add files to Git");
@@ -218,64 +234,30 @@ bool GitUtils::createGitAttributes(const std::filesystem::path& projectPath) {
 bool GitUtils::executeGitCommand(const std::filesystem::path& workingDir,
                                  const std::vector<std::string>& args, std::string* output) {
     try {
-        (void)workingDir;  // TODO: Implement working directory support
-        std::ostringstream command;
-        command << "git";
-        for (const auto& arg : args) {
-            command << " \"" << arg << "\"";
+        std::vector<std::string> command;
+        command.reserve(args.size() + 1);
+        command.push_back("git");
+        command.insert(command.end(), args.begin(), args.end());
+
+        // Spawned directly in the working directory: no shell, no quoting, and
+        // no change to this process's current path
+        ProcessOptions options;
+        options.workingDirectory = workingDir;
+        options.captureOutput = output != nullptr;
+        options.mergeStderr = output != nullptr;
+
+        ProcessResult result = ProcessRunner::run(command, options);
+        if (!result.started) {
+            spdlog::error("Error executing Git command: {}", result.errorMessage);
+            return false;
         }
-
-        std::string fullCommand = command.str();
-
-#ifdef _WIN32
         if (output) {
-            fullCommand += " 2>&1";
-            FILE* pipe = _popen(fullCommand.c_str(), "r");
-            if (!pipe)
-                return false;
-
-            char buffer[128];
-            std::ostringstream result;
-            while (fgets(buffer, sizeof(buffer), pipe) != nullptr) {
-                result << buffer;
-            }
-            *output = result.str();
-
-            int exitCode = _pclose(pipe);
-            return exitCode == 0;
-        } else {
-            int result = std::system(fullCommand.c_str());
-            return result == 0;
+            *output = std::move(result.output);
+        } else if (!result.success() && !result.error.empty()) {
+            spdlog::warn("git {} failed: {}", args.empty() ? "" : args[0],
+                         StringUtils::trim(result.error));
         }
-#else
-        // Change to working directory
-        auto oldPath = std::filesystem::current_path();
-        std::filesystem::current_path(workingDir);
-
-        if (output) {
-            fullCommand += " 2>&1";
-            FILE* pipe = popen(fullCommand.c_str(), "r");
-            if (!pipe) {
-                std::filesystem::current_path(oldPath);
-                return false;
-            }
-
-            char buffer[128];
-            std::ostringstream result;
-            while (fgets(buffer, sizeof(buffer), pipe) != nullptr) {
-                result << buffer;
-            }
-            *output = result.str();
-
-            int exitCode = pclose(pipe);
-            std::filesystem::current_path(oldPath);
-            return WEXITSTATUS(exitCode) == 0;
-        } else {
-            int result = std::system(fullCommand.c_str());
-            std::filesystem::current_path(oldPath);
-            return WEXITSTATUS(result) == 0;
-        }
-#endif
+        return result.success();
 
     } catch (const std::exception& e) {
         spdlog::error("Error executing Git command: {}", e.what());
@@ -283,6 +265,16 @@ bool GitUtils::executeGitCommand(const std::filesystem::path& workingDir,
     }
 }
 
+bool GitUtils::setConfigValue(const std::filesystem::path& projectPath,
+                              const std::string& section, const std::string& key,
+                              const std::string& value) {
+    if (NativeGitRepository::isEnabled() &&
+        NativeGitRepository(projectPath).setConfig(section, key, value)) {
+        return true;
+    }
+    return executeGitCommand(projectPath, {"config", section + "." + key, value});
+}
+
 std::string GitUtils::getCppGitignoreTemplate() {
     return R"(# C++ Build artifacts
 *.o
@@ -809,6 +801,26 @@ indent_style = space
 indent_size = 2)";
 }
 
+bool CodeQualityTools::hasClangFormat() {
+    return findTool("clang-format").has_value();
+}
+
+bool CodeQualityTools::hasClangTidy() {
+    return findTool("clang-tidy").has_value();
+}
+
+bool CodeQualityTools::hasCppcheck() {
+    return findTool("cppcheck").has_value();
+}
+
+std::optional<std::string> CodeQualityTools::findTool(const std::string& toolName) {
+    auto path = ToolRegistry::getInstance().find(toolName);
+    if (!path) {
+        return std::nullopt;
+    }
+    return path->string();
+}
+
 // Enhanced Git workflow support
 bool GitUtils::setupGitWorkflow(const std::filesystem::path& projectPath,
                                 const std::string& workflowType) {
@@ -987,13 +999,13 @@ bool GitUtils::configureRepositoryAdvanced(const std::filesystem::path& projectP
     try {
         // Configure user name and email if provided
         if (!userName.empty()) {
-            if (!executeGitCommand(projectPath, {"config", "user.name", userName})) {
+            if (!setConfigValue(projectPath, "user", "name", userName)) {
                 spdlog::warn("Failed to set Git user name");
             }
         }
 
         if (!userEmail.empty()) {
-            if (!executeGitCommand(projectPath, {"config", "user.email", userEmail})) {
+            if (!setConfigValue(projectPath, "user", "email", userEmail)) {
                 spdlog::warn("Failed to set Git user email");
             }
         }
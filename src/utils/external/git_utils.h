@@ -114,6 +114,11 @@ class GitUtils {
                                   const std::vector<std::string>& args,
                                   std::string* output = nullptr);
 
+    // Writes .git/config directly when possible, otherwise runs "git config"
+    static bool setConfigValue(const std::filesystem::path& projectPath,
+                               const std::string& section, const std::string& key,
+                               const std::string& value);
+
     // .gitignore template generators
     static std::string getCppGitignoreTemplate();
     static std::string getCMakeGitignoreTemplate();
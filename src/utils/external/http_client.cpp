@@ -1,6 +1,10 @@
 #include "../external/http_client.h"
 #include "../core/file_utils.h"
+#include "../core/process_runner.h"
+#include "../core/tool_registry.h"
 #include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cctype>
 #include <cstdlib>
 #include <sstream>
 #include <fstream>
@@ -65,17 +69,31 @@ HttpClient::DownloadResult HttpClient::downloadFileWithAuth(const std::string& u
     }
 }
 
+HttpClient::DownloadResult HttpClient::downloadIfModified(const std::string& url,
+                                                         const std::filesystem::path& outputPath,
+                                                         const std::string& etag,
+                                                         const std::string& lastModified,
+                                                         const ProgressCallback& progressCallback) {
+    std::map<std::string, std::string> headers;
+    if (!etag.empty()) {
+        headers["If-None-Match"] = etag;
+    }
+    if (!lastModified.empty()) {
+        headers["If-Modified-Since"] = lastModified;
+    }
+    return downloadFileWithAuth(url, outputPath, std::nullopt, std::nullopt, headers,
+                                progressCallback);
+}
+
 bool HttpClient::isUrlAccessible(const std::string& url) {
     if (!isValidUrl(url)) {
         return false;
     }
 
     if (hasCurl()) {
-        std::string command = "curl -s -I \"" + url + "\"";
-        return executeCommand(command);
+        return executeCommand({"curl", "-s", "-I", url});
     } else if (hasWget()) {
-        std::string command = "wget --spider -q \"" + url + "\"";
-        return executeCommand(command);
+        return executeCommand({"wget", "--spider", "-q", url});
     }
 
     return false;
@@ -87,9 +105,7 @@ std::optional<size_t> HttpClient::getRemoteFileSize(const std::string& url) {
     }
 
     std::string output;
-    std::string command = "curl -sI \"" + url + "\" | grep -i content-length";
-    
-    if (executeCommand(command, &output)) {
+    if (executeCommand({"curl", "-sI", url}, &output)) {
         std::regex contentLengthRegex(R"(content-length:\s*(\d+))", std::regex_constants::icase);
         std::smatch match;
         
@@ -139,9 +155,7 @@ std::string HttpClient::getMimeType(const std::string& url) {
     }
 
     std::string output;
-    std::string command = "curl -sI \"" + url + "\" | grep -i content-type";
-    
-    if (executeCommand(command, &output)) {
+    if (executeCommand({"curl", "-sI", url}, &output)) {
         std::regex contentTypeRegex(R"(content-type:\s*([^;\r\n]+))", std::regex_constants::icase);
         std::smatch match;
         
@@ -159,31 +173,58 @@ HttpClient::DownloadResult HttpClient::downloadWithCurl(const std::string& url,
                                                        const std::optional<std::string>& password,
                                                        const std::map<std::string, std::string>& headers,
                                                        const ProgressCallback& progressCallback) {
-    std::ostringstream command;
-    command << "curl -L -o \"" << outputPath.string() << "\"";
+    // Error pages are not downloads; headers and the status code are captured
+    // so callers can see validators and 304 responses
+    std::filesystem::path headerFile = outputPath;
+    headerFile += ".headers";
+    std::vector<std::string> command = {"curl", "-L", "--fail", "-o", outputPath.string(),
+                                        "-D", headerFile.string(), "-w", "%{http_code}"};
     
     // Add authentication if provided
     if (username && password) {
-        command << " -u \"" << *username << ":" << *password << "\"";
+        command.push_back("-u");
+        command.push_back(*username + ":" + *password);
     }
     
     // Add custom headers
     for (const auto& header : headers) {
-        command << " -H \"" << header.first << ": " << header.second << "\"";
+        command.push_back("-H");
+        command.push_back(header.first + ": " + header.second);
     }
     
     // Add progress bar if no callback provided
     if (!progressCallback) {
-        command << " --progress-bar";
+        command.push_back("--progress-bar");
     }
     
-    command << " \"" << url << "\"";
+    command.push_back(url);
 
     spdlog::info("Downloading {} to {}", url, outputPath.string());
     
-    bool success = executeCommand(command.str());
+    std::string statusOutput;
+    bool success = executeCommand(command, &statusOutput);
     
     DownloadResult result;
+    try {
+        result.httpStatusCode = std::stoi(statusOutput);
+    } catch (const std::exception&) {
+        result.httpStatusCode = 0;
+    }
+    if (std::filesystem::exists(headerFile)) {
+        result.headers = parseHeaders(FileUtils::readFromFile(headerFile.string()));
+        std::error_code ec;
+        std::filesystem::remove(headerFile, ec);
+    }
+
+    if (success && result.httpStatusCode == 304) {
+        std::error_code ec;
+        std::filesystem::remove(outputPath, ec);
+        result.success = true;
+        result.notModified = true;
+        spdlog::info("Not modified: {}", url);
+        return result;
+    }
+
     result.success = success && std::filesystem::exists(outputPath);
     
     if (result.success) {
@@ -201,19 +242,19 @@ HttpClient::DownloadResult HttpClient::downloadWithWget(const std::string& url,
                                                        const std::filesystem::path& outputPath,
                                                        const std::optional<std::string>& username,
                                                        const std::optional<std::string>& password) {
-    std::ostringstream command;
-    command << "wget -O \"" << outputPath.string() << "\"";
+    std::vector<std::string> command = {"wget", "-O", outputPath.string()};
     
     // Add authentication if provided
     if (username && password) {
-        command << " --user=\"" << *username << "\" --password=\"" << *password << "\"";
+        command.push_back("--user=" + *username);
+        command.push_back("--password=" + *password);
     }
     
-    command << " \"" << url << "\"";
+    command.push_back(url);
 
     spdlog::info("Downloading {} to {} using wget", url, outputPath.string());
     
-    bool success = executeCommand(command.str());
+    bool success = executeCommand(command);
     
     DownloadResult result;
     result.success = success && std::filesystem::exists(outputPath);
@@ -230,11 +271,11 @@ HttpClient::DownloadResult HttpClient::downloadWithWget(const std::string& url,
 }
 
 bool HttpClient::hasCurl() {
-    return executeCommand("curl --version");
+    return ToolRegistry::getInstance().isAvailable("curl");
 }
 
 bool HttpClient::hasWget() {
-    return executeCommand("wget --version");
+    return ToolRegistry::getInstance().isAvailable("wget");
 }
 
 std::map<std::string, std::string> HttpClient::parseHeaders(const std::string& headerData) {
@@ -243,6 +284,11 @@ std::map<std::string, std::string> HttpClient::parseHeaders(const std::string& h
     std::string line;
     
     while (std::getline(stream, line)) {
+        // Each status line starts a new response (redirects, 100 Continue)
+        if (line.compare(0, 5, "HTTP/") == 0) {
+            headers.clear();
+            continue;
+        }
         size_t colonPos = line.find(':');
         if (colonPos != std::string::npos) {
             std::string key = line.substr(0, colonPos);
@@ -253,6 +299,8 @@ std::map<std::string, std::string> HttpClient::parseHeaders(const std::string& h
             key.erase(key.find_last_not_of(" \t\r\n") + 1);
             value.erase(0, value.find_first_not_of(" \t\r\n"));
             value.erase(value.find_last_not_of(" \t\r\n") + 1);
+            std::transform(key.begin(), key.end(), key.begin(),
+                           [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
             
             headers[key] = value;
         }
@@ -261,39 +309,20 @@ std::map<std::string, std::string> HttpClient::parseHeaders(const std::string& h
     return headers;
 }
 
-bool HttpClient::executeCommand(const std::string& command, std::string* output) {
-    try {
-#ifdef _WIN32
-        FILE* pipe = _popen(command.c_str(), "r");
-#else
-        FILE* pipe = popen(command.c_str(), "r");
-#endif
-        
-        if (!pipe) {
-            return false;
-        }
-
-        if (output) {
-            char buffer[128];
-            std::ostringstream result;
-            while (fgets(buffer, sizeof(buffer), pipe) != nullptr) {
-                result << buffer;
-            }
-            *output = result.str();
-        }
+bool HttpClient::executeCommand(const std::vector<std::string>& command, std::string* output) {
+    // Downloads report progress on stderr, so it stays attached to the terminal
+    ProcessOptions options;
+    options.captureError = false;
 
-#ifdef _WIN32
-        int exitCode = _pclose(pipe);
-#else
-        int exitCode = pclose(pipe);
-#endif
-        
-        return exitCode == 0;
-        
-    } catch (const std::exception& e) {
-        spdlog::error("Error executing command: {}", e.what());
+    ProcessResult result = ProcessRunner::run(command, options);
+    if (!result.started) {
+        spdlog::error("Error executing command: {}", result.errorMessage);
         return false;
     }
+    if (output) {
+        *output = std::move(result.output);
+    }
+    return result.success();
 }
 
 } // namespace utils
@@ -5,6 +5,7 @@
 #include <optional>
 #include <functional>
 #include <map>
+#include <vector>
 
 namespace utils {
 
@@ -21,7 +22,8 @@ public:
         std::string errorMessage;
         size_t bytesDownloaded = 0;
         int httpStatusCode = 0;
-        std::map<std::string, std::string> headers;
+        std::map<std::string, std::string> headers;  // Final response, lower-case names
+        bool notModified = false;  // 304 to a conditional request; nothing was written
     };
 
     // Download file from URL to local path
@@ -42,6 +44,14 @@ public:
                                               const std::map<std::string, std::string>& headers = {},
                                               const ProgressCallback& progressCallback = nullptr);
 
+    // Conditional GET using validators from an earlier response (either may be
+    // empty). Only curl can send these; with wget the file is always downloaded.
+    static DownloadResult downloadIfModified(const std::string& url,
+                                             const std::filesystem::path& outputPath,
+                                             const std::string& etag,
+                                             const std::string& lastModified,
+                                             const ProgressCallback& progressCallback = nullptr);
+
     // Check if URL is accessible (HEAD request)
     static bool isUrlAccessible(const std::string& url);
 
@@ -78,11 +88,13 @@ private:
     // Check if wget is available
     static bool hasWget();
 
-    // Parse HTTP headers from curl output
+    // Parse HTTP headers from curl output; names are lower-cased and only the
+    // last response is kept when redirects were followed
     static std::map<std::string, std::string> parseHeaders(const std::string& headerData);
 
     // Execute system command and capture output
-    static bool executeCommand(const std::string& command, std::string* output = nullptr);
+    static bool executeCommand(const std::vector<std::string>& command,
+                               std::string* output = nullptr);
 };
 
 } // namespace utils
@@ -1,14 +1,17 @@
 #include "../project/post_creation_actions.h"
 
 #include <spdlog/fmt/fmt.h>
+#include <spdlog/spdlog.h>
 
 #include <algorithm>
 #include <chrono>
+#include <filesystem>
 #include <iostream>
 #include <thread>
 
 #include "../build/dependency_manager.h"
 #include "../core/file_utils.h"
+#include "../core/process_runner.h"
 #include "../ui/terminal_utils.h"
 
 namespace utils {
@@ -207,8 +210,8 @@ ActionStatus PostCreationActions::createInitialCommit(const CliOptions& options)
 
         // Git should already be initialized by the template
         // Just need to add and commit files
-        return runCommand("git add .", projectPath) &&
-               runCommand("git commit -m \"Initial commit from cpp-scaffold\"", projectPath);
+        return runCommand({"git", "add", "."}, projectPath) &&
+               runCommand({"git", "commit", "-m", "Initial commit from cpp-scaffold"}, projectPath);
     });
 }
 
@@ -239,19 +242,24 @@ ActionStatus PostCreationActions::executeAction(const std::string& name,
     return status;
 }
 
-bool PostCreationActions::runCommand(const std::string& command, const std::string& workingDir) {
-    // Simple command execution - in a real implementation, this would be more robust
-    std::string fullCommand = command;
-    if (!workingDir.empty()) {
-        fullCommand = fmt::format("cd {} && {}", workingDir, command);
-    }
-
+bool PostCreationActions::runCommand(const std::vector<std::string>& command,
+                                     const std::string& workingDir) {
     if (verbose_) {
-        TerminalUtils::showInfo(fmt::format("Executing: {}", fullCommand));
+        TerminalUtils::showInfo(fmt::format("Executing: {}", ProcessRunner::formatCommand(command)));
     }
 
-    int result = system(fullCommand.c_str());
-    return result == 0;
+    // Output goes straight to the terminal, as the user is watching these steps
+    ProcessOptions options;
+    options.workingDirectory = workingDir;
+    options.captureOutput = false;
+    options.captureError = false;
+
+    ProcessResult result = ProcessRunner::run(command, options);
+    if (!result.started) {
+        spdlog::error("Failed to run '{}': {}", ProcessRunner::formatCommand(command),
+                      result.errorMessage);
+    }
+    return result.success();
 }
 
 bool PostCreationActions::validateFile(const std::string& path,
@@ -265,9 +273,17 @@ bool PostCreationActions::validateDirectory(const std::string& path) {
 }
 
 bool PostCreationActions::buildWithCMake(const std::string& projectPath) {
-    return runCommand("mkdir -p build", projectPath) &&
-           runCommand("cd build && cmake ..", projectPath) &&
-           runCommand("cd build && make -j$(nproc)", projectPath);
+    std::filesystem::path buildDir = std::filesystem::path(projectPath) / "build";
+    std::error_code ec;
+    std::filesystem::create_directories(buildDir, ec);
+    if (ec) {
+        return false;
+    }
+
+    unsigned int jobs = std::max(1u, std::thread::hardware_concurrency());
+    return runCommand({"cmake", ".."}, buildDir.string()) &&
+           runCommand({"cmake", "--build", ".", "--parallel", std::to_string(jobs)},
+                      buildDir.string());
 }
 
 bool PostCreationActions::isActionEnabled(const std::string& actionName) const {
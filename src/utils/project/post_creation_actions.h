@@ -70,7 +70,7 @@ class PostCreationActions {
     ActionStatus executeAction(const std::string& name, const std::string& description,
                                std::function<bool()> action);
 
-    bool runCommand(const std::string& command, const std::string& workingDir = "");
+    bool runCommand(const std::vector<std::string>& command, const std::string& workingDir = "");
     bool checkCommandExists(const std::string& command);
     bool validateFile(const std::string& path, const std::string& expectedContent = "");
     bool validateDirectory(const std::string& path);
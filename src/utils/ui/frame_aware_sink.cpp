@@ -0,0 +1,29 @@
+#include "frame_aware_sink.h"
+
+#include "progress_indicator.h"
+
+namespace utils {
+
+FrameAwareSink::FrameAwareSink(std::shared_ptr<spdlog::sinks::sink> target)
+    : target_(std::move(target)) {}
+
+void FrameAwareSink::sink_it_(const spdlog::details::log_msg& msg) {
+    ProgressRenderer::getInstance().writeAboveFrame([&] {
+        target_->log(msg);
+        target_->flush();
+    });
+}
+
+void FrameAwareSink::flush_() {
+    target_->flush();
+}
+
+void FrameAwareSink::set_pattern_(const std::string& pattern) {
+    target_->set_pattern(pattern);
+}
+
+void FrameAwareSink::set_formatter_(std::unique_ptr<spdlog::formatter> formatter) {
+    target_->set_formatter(std::move(formatter));
+}
+
+}  // namespace utils
@@ -0,0 +1,28 @@
+#pragma once
+#include <spdlog/details/null_mutex.h>
+#include <spdlog/sinks/base_sink.h>
+
+#include <memory>
+
+namespace utils {
+
+// Writes each message to another sink with the progress frame cleared, so log
+// lines printed while indicators are running appear above them instead of
+// being drawn over. Meant for console sinks, which write to stdio and so pass
+// the std::cout redirection of ProgressRenderer by. Patterns set on this sink
+// apply to the wrapped one.
+class FrameAwareSink : public spdlog::sinks::base_sink<spdlog::details::null_mutex> {
+   public:
+    explicit FrameAwareSink(std::shared_ptr<spdlog::sinks::sink> target);
+
+   protected:
+    void sink_it_(const spdlog::details::log_msg& msg) override;
+    void flush_() override;
+    void set_pattern_(const std::string& pattern) override;
+    void set_formatter_(std::unique_ptr<spdlog::formatter> formatter) override;
+
+   private:
+    std::shared_ptr<spdlog::sinks::sink> target_;
+};
+
+}  // namespace utils
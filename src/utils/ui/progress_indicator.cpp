@@ -1,6 +1,7 @@
 #include "../ui/progress_indicator.h"
 
 #include <algorithm>
+#include <cstdlib>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
@@ -11,6 +12,8 @@
 #ifndef NOMINMAX
 #define NOMINMAX
 #endif
+#include <io.h>
+#include <stdio.h>
 #include <windows.h>
 #else
 #include <unistd.h>
@@ -18,6 +21,340 @@
 
 namespace utils {
 
+// Collects text written to a stream while a frame is live and hands it to the
+// renderer a line at a time, so it lands above the frame. A flush passes on an
+// unfinished line too (e.g. a prompt before std::cin reads)
+class ProgressRenderer::ForeignOutput : public std::streambuf {
+public:
+    explicit ForeignOutput(ProgressRenderer& renderer) : m_renderer(renderer) {}
+
+    // attach() and detach() are called with the renderer's mutex held
+    void attach(std::ostream& stream) {
+        m_stream = &stream;
+        m_target = stream.rdbuf(this);
+    }
+
+    void detach() {
+        flushLocked(true);
+        if (m_stream && m_stream->rdbuf() == this) {
+            m_stream->rdbuf(m_target);
+        }
+        m_stream = nullptr;
+    }
+
+    // The stream's own buffer, which the text ends up in
+    std::streambuf* target() const { return m_target; }
+
+protected:
+    int_type overflow(int_type ch) override {
+        if (traits_type::eq_int_type(ch, traits_type::eof())) {
+            return traits_type::not_eof(ch);
+        }
+        char c = traits_type::to_char_type(ch);
+        xsputn(&c, 1);
+        return ch;
+    }
+
+    std::streamsize xsputn(const char* data, std::streamsize size) override {
+        std::lock_guard<std::mutex> lock(m_renderer.m_mutex);
+        m_pending.append(data, static_cast<size_t>(size));
+        flushLocked(false);
+        return size;
+    }
+
+    int sync() override {
+        std::lock_guard<std::mutex> lock(m_renderer.m_mutex);
+        flushLocked(true);
+        return 0;
+    }
+
+private:
+    ProgressRenderer& m_renderer;
+    std::ostream* m_stream = nullptr;
+    std::streambuf* m_target = nullptr;
+    std::string m_pending;
+
+    void flushLocked(bool partial) {
+        // rfind() returns npos when there is no newline, and npos + 1 is 0
+        size_t end = partial ? m_pending.size() : m_pending.rfind('\n') + 1;
+        if (end == 0 || !m_target) {
+            return;
+        }
+        m_renderer.writeForeignLocked(m_target, m_pending.substr(0, end));
+        m_pending.erase(0, end);
+    }
+};
+
+// ProgressRenderer Implementation
+ProgressRenderer& ProgressRenderer::getInstance() {
+    static ProgressRenderer instance;
+    return instance;
+}
+
+ProgressRenderer::ProgressRenderer() : m_output(&std::cout), m_interactive(detectInteractive()) {
+    m_outputGuard = std::make_unique<ForeignOutput>(*this);
+    m_errorGuard = std::make_unique<ForeignOutput>(*this);
+}
+
+ProgressRenderer::~ProgressRenderer() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_shutdown = true;
+    }
+    m_wakeup.notify_all();
+    if (m_thread && m_thread->joinable()) {
+        m_thread->join();
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    releaseOutputLocked();
+}
+
+bool ProgressRenderer::detectInteractive() {
+    if (const char* setting = std::getenv("CPP_SCAFFOLD_PROGRESS")) {
+        std::string value = setting;
+        if (value == "0" || value == "off" || value == "false") {
+            return false;
+        }
+    }
+    if (const char* term = std::getenv("TERM")) {
+        if (std::string(term) == "dumb") {
+            return false;
+        }
+    }
+#ifdef _WIN32
+    return _isatty(_fileno(stdout)) != 0;
+#else
+    return isatty(STDOUT_FILENO) != 0;
+#endif
+}
+
+void ProgressRenderer::add(ProgressIndicator* indicator) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (std::find(m_indicators.begin(), m_indicators.end(), indicator) == m_indicators.end()) {
+        m_indicators.push_back(indicator);
+    }
+    guardOutputLocked();
+    if (m_interactive && m_autoRefresh) {
+        ensureThread();
+        m_wakeup.notify_one();
+    }
+}
+
+void ProgressRenderer::remove(ProgressIndicator* indicator,
+                              const std::vector<std::string>& finalLines) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = std::find(m_indicators.begin(), m_indicators.end(), indicator);
+    if (it == m_indicators.end()) {
+        return;
+    }
+    m_indicators.erase(it);
+
+    if (m_interactive) {
+        clearFrameLocked();
+    }
+    for (const auto& line : finalLines) {
+        frameOutput() << line << '\n';
+    }
+    if (m_interactive && !m_indicators.empty()) {
+        writeFrameLocked();
+    }
+    frameOutput().flush();
+    if (m_indicators.empty()) {
+        releaseOutputLocked();
+    }
+}
+
+void ProgressRenderer::print(const std::string& line) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_interactive) {
+        clearFrameLocked();
+    }
+    frameOutput() << line << '\n';
+    if (m_interactive && !m_indicators.empty()) {
+        writeFrameLocked();
+    }
+    frameOutput().flush();
+}
+
+// write must not use a stream the renderer is guarding, whose buffer would
+// wait for the mutex held here
+void ProgressRenderer::writeAboveFrame(const std::function<void()>& write) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_interactive) {
+        clearFrameLocked();
+    }
+    frameOutput().flush();
+    write();
+    if (m_interactive && !m_indicators.empty()) {
+        writeFrameLocked();
+    }
+    frameOutput().flush();
+}
+
+void ProgressRenderer::renderFrame() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_interactive) {
+        writeFrameLocked();
+    }
+}
+
+void ProgressRenderer::setTargetFps(int fps) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_targetFps = std::clamp(fps, 1, 60);
+}
+
+int ProgressRenderer::getTargetFps() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_targetFps;
+}
+
+bool ProgressRenderer::isInteractive() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_interactive;
+}
+
+void ProgressRenderer::setOutput(std::ostream& output, bool interactive, bool autoRefresh) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    releaseOutputLocked();
+    m_output = &output;
+    m_interactive = interactive;
+    m_autoRefresh = autoRefresh;
+    m_previousLines.clear();
+    if (!m_indicators.empty()) {
+        guardOutputLocked();
+    }
+    if (m_interactive && m_autoRefresh && !m_indicators.empty()) {
+        ensureThread();
+    }
+}
+
+void ProgressRenderer::resetOutput() {
+    setOutput(std::cout, detectInteractive());
+}
+
+size_t ProgressRenderer::activeIndicators() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_indicators.size();
+}
+
+size_t ProgressRenderer::framesWritten() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_framesWritten;
+}
+
+void ProgressRenderer::ensureThread() {
+    if (!m_thread) {
+        m_thread = std::make_unique<std::thread>(&ProgressRenderer::renderLoop, this);
+    }
+}
+
+void ProgressRenderer::renderLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_shutdown) {
+        // Sleep until something is registered, then tick at the target rate
+        if (m_indicators.empty() || !m_interactive || !m_autoRefresh) {
+            m_wakeup.wait_for(lock, std::chrono::seconds(1));
+            continue;
+        }
+        m_wakeup.wait_for(lock, std::chrono::milliseconds(1000 / m_targetFps));
+        if (!m_shutdown && m_interactive && m_autoRefresh && !m_indicators.empty()) {
+            writeFrameLocked();
+        }
+    }
+}
+
+void ProgressRenderer::writeFrameLocked() {
+    // A frame drawn now would start in the middle of someone else's line
+    if (m_lineOpen) {
+        return;
+    }
+    std::vector<std::string> lines;
+    for (const auto* indicator : m_indicators) {
+        indicator->appendFrame(lines);
+    }
+    if (lines == m_previousLines) {
+        return;
+    }
+
+    // The cursor rests at the start of the line below the frame. Skip the
+    // unchanged head, then rewrite changed lines and step over the rest
+    size_t first = 0;
+    while (first < lines.size() && first < m_previousLines.size() &&
+           lines[first] == m_previousLines[first]) {
+        ++first;
+    }
+
+    std::string out;
+    size_t up = m_previousLines.size() - first;
+    if (up > 0) {
+        out += "\r\033[" + std::to_string(up) + "A";
+    }
+    for (size_t i = first; i < lines.size(); ++i) {
+        if (i < m_previousLines.size() && lines[i] == m_previousLines[i]) {
+            out += '\n';
+            continue;
+        }
+        out += lines[i];
+        out += "\033[K\n";
+    }
+    if (lines.size() < m_previousLines.size()) {
+        out += "\033[J";
+    }
+
+    frameOutput() << out << std::flush;
+    m_previousLines = std::move(lines);
+    ++m_framesWritten;
+}
+
+void ProgressRenderer::clearFrameLocked() {
+    if (!m_previousLines.empty()) {
+        frameOutput() << "\r\033[" << m_previousLines.size() << "A\033[J";
+        m_previousLines.clear();
+    }
+}
+
+// Redirects the output stream (and std::cerr, which shares the terminal with
+// std::cout) through ForeignOutput while frames may be on screen
+void ProgressRenderer::guardOutputLocked() {
+    if (m_guarding || !m_interactive) {
+        return;
+    }
+    m_outputGuard->attach(*m_output);
+    m_direct = std::make_unique<std::ostream>(m_outputGuard->target());
+    if (m_output == &std::cout) {
+        m_errorGuard->attach(std::cerr);
+    }
+    m_guarding = true;
+}
+
+void ProgressRenderer::releaseOutputLocked() {
+    if (!m_guarding) {
+        return;
+    }
+    m_guarding = false;
+    m_outputGuard->detach();
+    m_errorGuard->detach();
+    m_direct.reset();
+    m_lineOpen = false;
+}
+
+void ProgressRenderer::writeForeignLocked(std::streambuf* target, const std::string& text) {
+    if (m_guarding && m_interactive) {
+        clearFrameLocked();
+        frameOutput().flush();
+    }
+    target->sputn(text.data(), static_cast<std::streamsize>(text.size()));
+    target->pubsync();
+    m_lineOpen = m_guarding && !text.empty() && text.back() != '\n';
+    if (m_guarding && m_interactive && !m_indicators.empty()) {
+        writeFrameLocked();
+    }
+}
+
+std::ostream& ProgressRenderer::frameOutput() {
+    return m_direct ? *m_direct : *m_output;
+}
+
 // SpinnerIndicator Implementation
 SpinnerIndicator::SpinnerIndicator() : m_spinnerChars{"|", "/", "-", "\\"}, m_spinnerSpeed(100) {}
 
@@ -26,47 +363,51 @@ SpinnerIndicator::~SpinnerIndicator() {
 }
 
 void SpinnerIndicator::start(const std::string& message) {
-    m_message = message;
-    m_startTime = std::chrono::steady_clock::now();
-    m_running = true;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_message = message;
+        m_startTime = std::chrono::steady_clock::now();
+    }
     m_progress = 0.0;
-
-    m_spinnerThread = std::make_unique<std::thread>(&SpinnerIndicator::spinnerLoop, this);
+    m_running = true;
+    ProgressRenderer::getInstance().add(this);
 }
 
 void SpinnerIndicator::update(double progress, const std::string& message) {
     m_progress = std::clamp(progress, 0.0, 1.0);
     if (!message.empty()) {
+        std::lock_guard<std::mutex> lock(m_mutex);
         m_message = message;
     }
 }
 
 void SpinnerIndicator::finish(const std::string& message) {
-    m_finishMessage = message;
-    stop();
+    std::string text;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        text = message.empty() ? m_message : message;
+    }
 
-    // Clear the line and show completion message
-    std::cout << "\r" << std::string(80, ' ') << "\r";
-    if (!m_finishMessage.empty()) {
-        std::cout << TerminalUtils::colorize("�?" + m_finishMessage, utils::Color::BrightGreen)
-                  << std::endl;
-    } else if (!m_message.empty()) {
-        std::cout << TerminalUtils::colorize("�?" + m_message, utils::Color::BrightGreen)
-                  << std::endl;
+    // The spinner line is replaced by the completion message
+    std::vector<std::string> finalLines;
+    if (!text.empty()) {
+        finalLines.push_back(TerminalUtils::colorize("✓ " + text, utils::Color::BrightGreen));
     }
+    end(finalLines);
 }
 
 void SpinnerIndicator::stop() {
-    if (m_running) {
-        m_running = false;
-        if (m_spinnerThread && m_spinnerThread->joinable()) {
-            m_spinnerThread->join();
-        }
-        m_spinnerThread.reset();
+    end({});
+}
+
+void SpinnerIndicator::end(const std::vector<std::string>& finalLines) {
+    if (m_running.exchange(false)) {
+        ProgressRenderer::getInstance().remove(this, finalLines);
     }
 }
 
 void SpinnerIndicator::setMessage(const std::string& message) {
+    std::lock_guard<std::mutex> lock(m_mutex);
     m_message = message;
 }
 
@@ -75,42 +416,41 @@ void SpinnerIndicator::setProgress(double progress) {
 }
 
 void SpinnerIndicator::setShowPercentage(bool show) {
+    std::lock_guard<std::mutex> lock(m_mutex);
     m_showPercentage = show;
 }
 
 void SpinnerIndicator::setShowElapsedTime(bool show) {
+    std::lock_guard<std::mutex> lock(m_mutex);
     m_showElapsedTime = show;
 }
 
 void SpinnerIndicator::setShowETA(bool show) {
+    std::lock_guard<std::mutex> lock(m_mutex);
     m_showETA = show;
 }
 
 void SpinnerIndicator::setSpinnerChars(const std::vector<std::string>& chars) {
     if (!chars.empty()) {
+        std::lock_guard<std::mutex> lock(m_mutex);
         m_spinnerChars = chars;
     }
 }
 
 void SpinnerIndicator::setSpinnerSpeed(int milliseconds) {
+    std::lock_guard<std::mutex> lock(m_mutex);
     m_spinnerSpeed = std::max(50, milliseconds);
 }
 
-void SpinnerIndicator::spinnerLoop() {
-    size_t charIndex = 0;
+void SpinnerIndicator::appendFrame(std::vector<std::string>& lines) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
 
-    while (m_running) {
-        render();
-        charIndex = (charIndex + 1) % m_spinnerChars.size();
-        std::this_thread::sleep_for(std::chrono::milliseconds(m_spinnerSpeed));
-    }
-}
-
-void SpinnerIndicator::render() {
-    static size_t charIndex = 0;
+    // The glyph advances with wall time, independent of the frame rate
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - m_startTime);
+    size_t charIndex = static_cast<size_t>(elapsed.count() / m_spinnerSpeed);
 
     std::ostringstream output;
-    output << "\r";
 
     // Spinner character
     output << TerminalUtils::colorize(m_spinnerChars[charIndex % m_spinnerChars.size()],
@@ -137,8 +477,7 @@ void SpinnerIndicator::render() {
         output << " ETA: " << getETA();
     }
 
-    std::cout << output.str() << std::flush;
-    charIndex++;
+    lines.push_back(output.str());
 }
 
 std::string SpinnerIndicator::formatTime(std::chrono::seconds seconds) const {
@@ -190,96 +529,100 @@ ProgressBarIndicator::ProgressBarIndicator(int width)
     : m_width(width), m_fillChar('='), m_emptyChar(' '), m_leftBracket('['), m_rightBracket(']') {}
 
 ProgressBarIndicator::~ProgressBarIndicator() {
-    if (m_started) {
-        std::cout << std::endl;
-    }
+    stop();
 }
 
 void ProgressBarIndicator::start(const std::string& message) {
-    m_message = message;
-    m_startTime = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_message = message;
+        m_startTime = std::chrono::steady_clock::now();
+    }
     m_progress = 0.0;
     m_started = true;
-    render();
+    ProgressRenderer::getInstance().add(this);
 }
 
 void ProgressBarIndicator::update(double progress, const std::string& message) {
     m_progress = std::clamp(progress, 0.0, 1.0);
     if (!message.empty()) {
+        std::lock_guard<std::mutex> lock(m_mutex);
         m_message = message;
     }
-    render();
 }
 
 void ProgressBarIndicator::finish(const std::string& message) {
-    m_progress = 1.0;
-    if (!message.empty()) {
-        m_message = message;
-    }
-    render();
-    std::cout << std::endl;
+    update(1.0, message);
 
+    // The completed bar stays on screen, followed by the message
+    std::vector<std::string> finalLines;
+    appendFrame(finalLines);
     if (!message.empty()) {
-        std::cout << TerminalUtils::colorize("�?" + message, utils::Color::BrightGreen)
-                  << std::endl;
+        finalLines.push_back(TerminalUtils::colorize("✓ " + message, utils::Color::BrightGreen));
     }
-
-    m_started = false;
+    end(finalLines);
 }
 
 void ProgressBarIndicator::stop() {
-    if (m_started) {
-        std::cout << std::endl;
-        m_started = false;
+    std::vector<std::string> finalLines;
+    appendFrame(finalLines);
+    end(finalLines);
+}
+
+void ProgressBarIndicator::end(const std::vector<std::string>& finalLines) {
+    if (m_started.exchange(false)) {
+        ProgressRenderer::getInstance().remove(this, finalLines);
     }
 }
 
 void ProgressBarIndicator::setMessage(const std::string& message) {
+    std::lock_guard<std::mutex> lock(m_mutex);
     m_message = message;
-    if (m_started) {
-        render();
-    }
 }
 
 void ProgressBarIndicator::setProgress(double progress) {
     m_progress = std::clamp(progress, 0.0, 1.0);
-    if (m_started) {
-        render();
-    }
 }
 
 void ProgressBarIndicator::setShowPercentage(bool show) {
+    std::lock_guard<std::mutex> lock(m_mutex);
     m_showPercentage = show;
 }
 
 void ProgressBarIndicator::setShowElapsedTime(bool show) {
+    std::lock_guard<std::mutex> lock(m_mutex);
     m_showElapsedTime = show;
 }
 
 void ProgressBarIndicator::setShowETA(bool show) {
+    std::lock_guard<std::mutex> lock(m_mutex);
     m_showETA = show;
 }
 
 void ProgressBarIndicator::setWidth(int width) {
+    std::lock_guard<std::mutex> lock(m_mutex);
     m_width = std::max(10, width);
 }
 
 void ProgressBarIndicator::setFillChar(char fillChar) {
+    std::lock_guard<std::mutex> lock(m_mutex);
     m_fillChar = fillChar;
 }
 
 void ProgressBarIndicator::setEmptyChar(char emptyChar) {
+    std::lock_guard<std::mutex> lock(m_mutex);
     m_emptyChar = emptyChar;
 }
 
 void ProgressBarIndicator::setBrackets(char left, char right) {
+    std::lock_guard<std::mutex> lock(m_mutex);
     m_leftBracket = left;
     m_rightBracket = right;
 }
 
-void ProgressBarIndicator::render() {
+void ProgressBarIndicator::appendFrame(std::vector<std::string>& lines) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
     std::ostringstream output;
-    output << "\r";
 
     // Message
     if (!m_message.empty()) {
@@ -315,7 +658,7 @@ void ProgressBarIndicator::render() {
         output << " ETA: " << getETA();
     }
 
-    std::cout << output.str() << std::flush;
+    lines.push_back(output.str());
 }
 
 std::string ProgressBarIndicator::formatTime(std::chrono::seconds seconds) const {
@@ -366,81 +709,89 @@ std::string ProgressBarIndicator::getETA() const {
 MultiStepIndicator::MultiStepIndicator() {}
 
 MultiStepIndicator::~MultiStepIndicator() {
-    if (m_started) {
-        std::cout << std::endl;
-    }
+    stop();
 }
 
 void MultiStepIndicator::start(const std::string& message) {
-    m_startTime = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_startTime = std::chrono::steady_clock::now();
+    }
     m_started = true;
 
+    auto& renderer = ProgressRenderer::getInstance();
     if (!message.empty()) {
-        std::cout << TerminalUtils::colorize(message, utils::Color::BrightCyan) << std::endl;
+        renderer.print(TerminalUtils::colorize(message, utils::Color::BrightCyan));
     }
-
-    render();
+    renderer.add(this);
 }
 
 void MultiStepIndicator::update(double progress, const std::string& message) {
     // Update current step progress
     (void)message;  // TODO: Use message to update step description
+    std::lock_guard<std::mutex> lock(m_mutex);
     if (m_currentStepIndex >= 0 && m_currentStepIndex < static_cast<int>(m_steps.size())) {
         m_currentStepProgress = std::clamp(progress, 0.0, 1.0);
     }
-
-    render();
 }
 
 void MultiStepIndicator::finish(const std::string& message) {
     // Complete all remaining steps
-    for (auto& step : m_steps) {
-        if (!step.completed && !step.failed) {
-            step.completed = true;
-            step.endTime = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& step : m_steps) {
+            if (!step.completed && !step.failed) {
+                step.completed = true;
+                step.endTime = std::chrono::steady_clock::now();
+            }
         }
     }
 
-    render();
-    std::cout << std::endl;
-
+    // The step list stays on screen, followed by the message
+    std::vector<std::string> finalLines;
+    appendFrame(finalLines);
     if (!message.empty()) {
-        std::cout << TerminalUtils::colorize("�?" + message, utils::Color::BrightGreen)
-                  << std::endl;
+        finalLines.push_back(TerminalUtils::colorize("✓ " + message, utils::Color::BrightGreen));
     }
-
-    m_started = false;
+    end(finalLines);
 }
 
 void MultiStepIndicator::stop() {
-    if (m_started) {
-        std::cout << std::endl;
-        m_started = false;
+    std::vector<std::string> finalLines;
+    appendFrame(finalLines);
+    end(finalLines);
+}
+
+void MultiStepIndicator::end(const std::vector<std::string>& finalLines) {
+    if (m_started.exchange(false)) {
+        ProgressRenderer::getInstance().remove(this, finalLines);
     }
 }
 
 void MultiStepIndicator::setMessage(const std::string& message) {
     // Update current step message
+    std::lock_guard<std::mutex> lock(m_mutex);
     if (m_currentStepIndex >= 0 && m_currentStepIndex < static_cast<int>(m_steps.size())) {
         m_steps[m_currentStepIndex].description = message;
-        render();
     }
 }
 
 void MultiStepIndicator::setProgress(double progress) {
     m_currentStepProgress = std::clamp(progress, 0.0, 1.0);
-    render();
 }
 
 void MultiStepIndicator::setShowPercentage(bool show) {
+    std::lock_guard<std::mutex> lock(m_mutex);
     m_showPercentage = show;
 }
 
 void MultiStepIndicator::setShowElapsedTime(bool show) {
+    std::lock_guard<std::mutex> lock(m_mutex);
     m_showElapsedTime = show;
 }
 
 void MultiStepIndicator::setShowETA(bool show) {
+    std::lock_guard<std::mutex> lock(m_mutex);
     m_showETA = show;
 }
 
@@ -448,10 +799,12 @@ void MultiStepIndicator::addStep(const std::string& name, const std::string& des
     Step step;
     step.name = name;
     step.description = description;
+    std::lock_guard<std::mutex> lock(m_mutex);
     m_steps.push_back(step);
 }
 
 void MultiStepIndicator::startStep(const std::string& name) {
+    std::lock_guard<std::mutex> lock(m_mutex);
     auto* step = findStep(name);
     if (step) {
         step->startTime = std::chrono::steady_clock::now();
@@ -466,11 +819,11 @@ void MultiStepIndicator::startStep(const std::string& name) {
         }
 
         m_currentStepProgress = 0.0;
-        render();
     }
 }
 
 void MultiStepIndicator::completeStep(const std::string& name) {
+    std::lock_guard<std::mutex> lock(m_mutex);
     auto* step = findStep(name);
     if (step) {
         step->completed = true;
@@ -479,12 +832,11 @@ void MultiStepIndicator::completeStep(const std::string& name) {
         if (name == m_currentStepName) {
             m_currentStepProgress = 1.0;
         }
-
-        render();
     }
 }
 
 void MultiStepIndicator::failStep(const std::string& name, const std::string& error) {
+    std::lock_guard<std::mutex> lock(m_mutex);
     auto* step = findStep(name);
     if (step) {
         step->failed = true;
@@ -493,32 +845,32 @@ void MultiStepIndicator::failStep(const std::string& name, const std::string& er
         if (!error.empty()) {
             step->description = error;
         }
-
-        render();
     }
 }
 
 void MultiStepIndicator::setStepProgress(const std::string& name, double progress) {
+    std::lock_guard<std::mutex> lock(m_mutex);
     if (name == m_currentStepName) {
         m_currentStepProgress = std::clamp(progress, 0.0, 1.0);
-        render();
     }
 }
 
 void MultiStepIndicator::setShowStepTimes(bool show) {
+    std::lock_guard<std::mutex> lock(m_mutex);
     m_showStepTimes = show;
 }
 
 void MultiStepIndicator::setShowStepProgress(bool show) {
+    std::lock_guard<std::mutex> lock(m_mutex);
     m_showStepProgress = show;
 }
 
-void MultiStepIndicator::render() {
-    // Clear previous output
-    std::cout << "\r" << std::string(80, ' ') << "\r";
+void MultiStepIndicator::appendFrame(std::vector<std::string>& lines) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
 
     for (size_t i = 0; i < m_steps.size(); ++i) {
         const auto& step = m_steps[i];
+        std::ostringstream output;
 
         // Step status indicator
         std::string indicator;
@@ -538,36 +890,29 @@ void MultiStepIndicator::render() {
             color = utils::Color::White;
         }
 
-        std::cout << TerminalUtils::colorize(indicator, color) << " " << step.name;
+        output << TerminalUtils::colorize(indicator, color) << " " << step.name;
 
         // Step description
         if (!step.description.empty()) {
-            std::cout << ": " << step.description;
+            output << ": " << step.description;
         }
 
         // Step progress
         if (m_showStepProgress && static_cast<int>(i) == m_currentStepIndex &&
             m_currentStepProgress > 0.0) {
-            std::cout << " (" << std::fixed << std::setprecision(1)
-                      << (m_currentStepProgress * 100.0) << "%)";
+            output << " (" << std::fixed << std::setprecision(1)
+                   << (m_currentStepProgress * 100.0) << "%)";
         }
 
         // Step timing
         if (m_showStepTimes && (step.completed || step.failed)) {
             auto duration =
                     std::chrono::duration_cast<std::chrono::seconds>(step.endTime - step.startTime);
-            std::cout << " [" << formatTime(duration) << "]";
+            output << " [" << formatTime(duration) << "]";
         }
 
-        std::cout << std::endl;
-    }
-
-    // Move cursor back up
-    if (!m_steps.empty()) {
-        std::cout << "\033[" << m_steps.size() << "A";
+        lines.push_back(output.str());
     }
-
-    std::cout << std::flush;
 }
 
 std::string MultiStepIndicator::formatTime(std::chrono::seconds seconds) const {
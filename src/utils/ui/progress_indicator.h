@@ -3,6 +3,9 @@
 #include <string>
 #include <chrono>
 #include <atomic>
+#include <condition_variable>
+#include <iosfwd>
+#include <mutex>
 #include <thread>
 #include <functional>
 #include <vector>
@@ -10,11 +13,95 @@
 
 namespace utils {
 
+class ProgressIndicator;
+
+// Draws every active indicator as one frame from a single timer thread.
+// Indicators only describe their lines; the renderer rewrites the lines that
+// changed since the previous frame, at most targetFps times per second. When
+// stdout is not a terminal (or CPP_SCAFFOLD_PROGRESS=0) no frames are drawn
+// at all and only the lines an indicator leaves behind when it ends are printed.
+// While a frame is live, whole lines written to the output stream (and to
+// std::cerr when the output is std::cout) are moved above the frame instead of
+// being drawn over; writes that bypass the streams go through writeAboveFrame()
+class ProgressRenderer {
+public:
+    static ProgressRenderer& getInstance();
+
+    // Indicator registration; remove() prints finalLines above the live frame
+    void add(ProgressIndicator* indicator);
+    void remove(ProgressIndicator* indicator, const std::vector<std::string>& finalLines = {});
+
+    // Prints a line above the live frame (plain output when not interactive)
+    void print(const std::string& line);
+
+    // Runs write with the live frame cleared and draws the frame again
+    // afterwards, for output that does not go through the C++ streams
+    void writeAboveFrame(const std::function<void()>& write);
+
+    // Composes the frame now and writes the lines that changed
+    void renderFrame();
+
+    // Configuration
+    void setTargetFps(int fps);
+    int getTargetFps() const;
+    bool isInteractive() const;
+
+    // Redirects output; interactive decides whether live frames are drawn.
+    // autoRefresh=false leaves frame timing to explicit renderFrame() calls
+    void setOutput(std::ostream& output, bool interactive, bool autoRefresh = true);
+    void resetOutput();
+
+    size_t activeIndicators() const;
+    size_t framesWritten() const;
+
+private:
+    ProgressRenderer();
+    ~ProgressRenderer();
+    ProgressRenderer(const ProgressRenderer&) = delete;
+    ProgressRenderer& operator=(const ProgressRenderer&) = delete;
+
+    // Stream buffer installed on the output streams while frames are live
+    class ForeignOutput;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    std::vector<ProgressIndicator*> m_indicators;
+    std::vector<std::string> m_previousLines;  // what is on screen right now
+    std::ostream* m_output;
+    bool m_interactive;
+    bool m_autoRefresh{true};
+    bool m_shutdown{false};
+    int m_targetFps{15};
+    size_t m_framesWritten{0};
+    std::unique_ptr<std::thread> m_thread;
+
+    // Set while the output streams are redirected through ForeignOutput;
+    // frames are then written to m_direct, past the redirection
+    std::unique_ptr<ForeignOutput> m_outputGuard;
+    std::unique_ptr<ForeignOutput> m_errorGuard;
+    std::unique_ptr<std::ostream> m_direct;
+    bool m_guarding{false};
+    bool m_lineOpen{false};  // foreign text without its newline is on screen
+
+    void ensureThread();
+    void renderLoop();
+    void writeFrameLocked();
+    void clearFrameLocked();
+    void guardOutputLocked();
+    void releaseOutputLocked();
+    void writeForeignLocked(std::streambuf* target, const std::string& text);
+    std::ostream& frameOutput();
+    static bool detectInteractive();
+};
+
 // Progress indicator interface
 class ProgressIndicator {
 public:
     virtual ~ProgressIndicator() = default;
 
+    // Appends this indicator's current lines to a frame; called by ProgressRenderer
+    virtual void appendFrame(std::vector<std::string>& lines) const = 0;
+
     // Progress control
     virtual void start(const std::string& message = "") = 0;
     virtual void update(double progress, const std::string& message = "") = 0;
@@ -49,26 +136,26 @@ public:
     void setShowElapsedTime(bool show) override;
     void setShowETA(bool show) override;
 
+    void appendFrame(std::vector<std::string>& lines) const override;
+
     // Spinner customization
     void setSpinnerChars(const std::vector<std::string>& chars);
     void setSpinnerSpeed(int milliseconds);
 
 private:
+    mutable std::mutex m_mutex;
     std::atomic<bool> m_running{false};
     std::atomic<double> m_progress{0.0};
     std::string m_message;
-    std::string m_finishMessage;
     std::vector<std::string> m_spinnerChars;
     int m_spinnerSpeed;
     std::chrono::steady_clock::time_point m_startTime;
-    std::unique_ptr<std::thread> m_spinnerThread;
 
     bool m_showPercentage{false};
     bool m_showElapsedTime{false};
     bool m_showETA{false};
 
-    void spinnerLoop();
-    void render();
+    void end(const std::vector<std::string>& finalLines);
     std::string formatTime(std::chrono::seconds seconds) const;
     std::string getElapsedTime() const;
     std::string getETA() const;
@@ -92,6 +179,8 @@ public:
     void setShowElapsedTime(bool show) override;
     void setShowETA(bool show) override;
 
+    void appendFrame(std::vector<std::string>& lines) const override;
+
     // Progress bar customization
     void setWidth(int width);
     void setFillChar(char fillChar);
@@ -99,6 +188,7 @@ public:
     void setBrackets(char left, char right);
 
 private:
+    mutable std::mutex m_mutex;
     int m_width;
     char m_fillChar;
     char m_emptyChar;
@@ -112,9 +202,9 @@ private:
     bool m_showPercentage{true};
     bool m_showElapsedTime{false};
     bool m_showETA{false};
-    bool m_started{false};
+    std::atomic<bool> m_started{false};
 
-    void render();
+    void end(const std::vector<std::string>& finalLines);
     std::string formatTime(std::chrono::seconds seconds) const;
     std::string getElapsedTime() const;
     std::string getETA() const;
@@ -147,6 +237,8 @@ public:
     void setShowElapsedTime(bool show) override;
     void setShowETA(bool show) override;
 
+    void appendFrame(std::vector<std::string>& lines) const override;
+
     // Step management
     void addStep(const std::string& name, const std::string& description = "");
     void startStep(const std::string& name);
@@ -159,6 +251,7 @@ public:
     void setShowStepProgress(bool show);
 
 private:
+    mutable std::mutex m_mutex;
     std::vector<Step> m_steps;
     int m_currentStepIndex{-1};
     std::string m_currentStepName;
@@ -170,9 +263,9 @@ private:
     bool m_showETA{true};
     bool m_showStepTimes{true};
     bool m_showStepProgress{true};
-    bool m_started{false};
+    std::atomic<bool> m_started{false};
 
-    void render();
+    void end(const std::vector<std::string>& finalLines);
     std::string formatTime(std::chrono::seconds seconds) const;
     std::string getElapsedTime() const;
     std::string getETA() const;
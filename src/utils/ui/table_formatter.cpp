@@ -4,9 +4,90 @@
 #include <iomanip>
 #include <iostream>
 #include <sstream>
+#include <utility>
+
+#ifdef _WIN32
+#include <io.h>
+#include <stdio.h>
+#else
+#include <unistd.h>
+#endif
 
 namespace utils {
 
+namespace {
+
+// Byte length of the longest prefix of text that is at most maxWidth columns
+// wide, and that prefix's width. ANSI CSI sequences take no columns and every
+// UTF-8 code point takes one
+std::pair<size_t, size_t> prefixForWidth(const std::string& text, size_t maxWidth) {
+    size_t width = 0;
+    size_t i = 0;
+    while (i < text.size()) {
+        auto c = static_cast<unsigned char>(text[i]);
+        if (c == 0x1B && i + 1 < text.size() && text[i + 1] == '[') {
+            i += 2;
+            while (i < text.size() && (static_cast<unsigned char>(text[i]) < 0x40 ||
+                                       static_cast<unsigned char>(text[i]) > 0x7E)) {
+                ++i;
+            }
+            i = std::min(i + 1, text.size());
+            continue;
+        }
+        if (width == maxWidth) {
+            break;
+        }
+        ++width;
+        ++i;
+        while (i < text.size() && (static_cast<unsigned char>(text[i]) & 0xC0) == 0x80) {
+            ++i;
+        }
+    }
+    return {i, width};
+}
+
+// Pads text already measured as textWidth columns out to width
+std::string padToWidth(const std::string& text, size_t textWidth, size_t width,
+                       Alignment alignment) {
+    if (textWidth >= width) {
+        return text;
+    }
+
+    size_t padding = width - textWidth;
+
+    switch (alignment) {
+        case Alignment::Left:
+            return text + std::string(padding, ' ');
+        case Alignment::Right:
+            return std::string(padding, ' ') + text;
+        case Alignment::Center: {
+            size_t leftPad = padding / 2;
+            size_t rightPad = padding - leftPad;
+            return std::string(leftPad, ' ') + text + std::string(rightPad, ' ');
+        }
+        default:
+            return text;
+    }
+}
+
+}  // namespace
+
+StreamOptions StreamOptions::forTerminal() {
+    StreamOptions options;
+#ifdef _WIN32
+    bool interactive = _isatty(_fileno(stdin)) && _isatty(_fileno(stdout));
+#else
+    bool interactive = isatty(STDIN_FILENO) && isatty(STDOUT_FILENO);
+#endif
+    if (interactive) {
+        int height = TerminalUtils::getTerminalHeight();
+        if (height > 2) {
+            options.pageHeight = static_cast<size_t>(height);
+        }
+    }
+    return options;
+}
+
 TableFormatter::TableFormatter() = default;
 
 TableFormatter::TableFormatter(const TableConfig& config) : config_(config) {}
@@ -63,7 +144,7 @@ void TableFormatter::setColumnAlignment(size_t columnIndex, Alignment alignment)
 }
 
 void TableFormatter::addRow(const EnhancedTableRow& row) {
-    data_.push_back(row);
+    appendRow(row);
 }
 
 void TableFormatter::addRow(const std::vector<std::string>& row) {
@@ -71,7 +152,7 @@ void TableFormatter::addRow(const std::vector<std::string>& row) {
     for (const auto& cell : row) {
         tableRow.emplace_back(cell);
     }
-    data_.push_back(tableRow);
+    appendRow(std::move(tableRow));
 }
 
 void TableFormatter::addRow(const std::initializer_list<std::string>& row) {
@@ -79,7 +160,7 @@ void TableFormatter::addRow(const std::initializer_list<std::string>& row) {
     for (const auto& cell : row) {
         tableRow.emplace_back(cell);
     }
-    data_.push_back(tableRow);
+    appendRow(std::move(tableRow));
 }
 
 void TableFormatter::setData(const EnhancedTableData& data) {
@@ -103,7 +184,7 @@ void TableFormatter::addHeaderRow(const std::vector<std::string>& headers) {
         }
         headerRow.push_back(cell);
     }
-    data_.push_back(headerRow);
+    appendRow(std::move(headerRow));
 }
 
 void TableFormatter::addSeparatorRow() {
@@ -112,7 +193,7 @@ void TableFormatter::addSeparatorRow() {
     for (size_t i = 0; i < columnCount; ++i) {
         separatorRow.emplace_back("---");
     }
-    data_.push_back(separatorRow);
+    appendRow(std::move(separatorRow));
 }
 
 void TableFormatter::addEmptyRow() {
@@ -121,54 +202,165 @@ void TableFormatter::addEmptyRow() {
     for (size_t i = 0; i < columnCount; ++i) {
         emptyRow.emplace_back("");
     }
-    data_.push_back(emptyRow);
+    appendRow(std::move(emptyRow));
 }
 
 std::string TableFormatter::render() const {
-    if (data_.empty() && columns_.empty()) {
-        return "";
-    }
-
     std::ostringstream oss;
-    auto columnWidths = calculateColumnWidths();
+    printToStream(oss);
+    return oss.str();
+}
 
-    // Render title
-    if (!config_.title.empty()) {
-        oss << renderTitle() << "\n";
-    }
+void TableFormatter::print() const {
+    printToStream(std::cout);
+}
 
-    // Render top border
-    if (config_.borderStyle != TableBorderStyle::None) {
-        oss << renderSeparator(true, false) << "\n";
+void TableFormatter::printToStream(std::ostream& stream) const {
+    if (data_.empty() && columns_.empty()) {
+        return;
     }
 
-    // Render header
-    if (config_.showHeader && !columns_.empty()) {
-        oss << renderHeader() << "\n";
-        if (config_.borderStyle != TableBorderStyle::None) {
-            oss << renderSeparator(false, false) << "\n";
-        }
+    // Every cell is measured once; layout and alignment share the result
+    std::vector<CellWidths> cellWidths;
+    cellWidths.reserve(data_.size());
+    for (const auto& row : data_) {
+        cellWidths.push_back(measureRow(row));
     }
+    auto columnWidths = calculateColumnWidths(cellWidths, getActualColumnCount());
+
+    stream << renderHead(columnWidths);
 
     // Render data rows
     for (size_t i = 0; i < data_.size(); ++i) {
-        oss << renderRow(data_[i], i) << "\n";
+        stream << renderRow(data_[i], cellWidths[i], columnWidths) << "\n";
     }
 
     // Render bottom border
     if (config_.borderStyle != TableBorderStyle::None) {
-        oss << renderSeparator(false, true) << "\n";
+        stream << renderSeparator(columnWidths, false, true) << "\n";
     }
+}
 
-    return oss.str();
+void TableFormatter::beginStream(std::ostream& stream, const StreamOptions& options) {
+    if (isStreaming()) {
+        endStream();
+    }
+
+    stream_.emplace();
+    stream_->out = &stream;
+    stream_->options = options;
+
+    // Rows added before the stream started are the start of the sample
+    for (const auto& row : data_) {
+        stream_->sampleWidths.push_back(measureRow(row));
+    }
+
+    if (options.widthPolicy == StreamWidthPolicy::Fixed ||
+        data_.size() >= std::max<size_t>(1, options.sampleRows)) {
+        writeStreamHead();
+    }
 }
 
-void TableFormatter::print() const {
-    std::cout << render();
+void TableFormatter::endStream() {
+    if (!isStreaming()) {
+        return;
+    }
+
+    if (!stream_->headWritten) {
+        writeStreamHead();
+    }
+    if (config_.borderStyle != TableBorderStyle::None && !stream_->columnWidths.empty()) {
+        *stream_->out << renderSeparator(stream_->columnWidths, false, true) << "\n";
+    }
+    stream_->out->flush();
+    stream_->out = nullptr;
 }
 
-void TableFormatter::printToStream(std::ostream& stream) const {
-    stream << render();
+bool TableFormatter::isStreaming() const {
+    return stream_ && stream_->out != nullptr;
+}
+
+bool TableFormatter::isStreamQuit() const {
+    return stream_ && stream_->quit;
+}
+
+size_t TableFormatter::getStreamedRowCount() const {
+    return stream_ ? stream_->rowsWritten : 0;
+}
+
+void TableFormatter::appendRow(EnhancedTableRow row) {
+    if (!isStreaming()) {
+        data_.push_back(std::move(row));
+        return;
+    }
+    if (stream_->quit) {
+        return;
+    }
+
+    // Held back until the sample is complete, then written like the rest
+    if (!stream_->headWritten) {
+        stream_->sampleWidths.push_back(measureRow(row));
+        data_.push_back(std::move(row));
+        if (data_.size() >= std::max<size_t>(1, stream_->options.sampleRows)) {
+            writeStreamHead();
+        }
+        return;
+    }
+
+    writeStreamRow(row, measureRow(row));
+}
+
+void TableFormatter::writeStreamHead() {
+    auto& stream = *stream_;
+
+    if (stream.options.widthPolicy == StreamWidthPolicy::Fixed) {
+        stream.columnWidths = calculateColumnWidths({}, getActualColumnCount());
+    } else {
+        stream.columnWidths = calculateColumnWidths(stream.sampleWidths, getActualColumnCount());
+    }
+    stream.headWritten = true;
+
+    if (!stream.columnWidths.empty()) {
+        writeStreamLines(renderHead(stream.columnWidths));
+    }
+
+    // Flush the held-back sample; data_ only buffers rows while streaming
+    for (size_t i = 0; i < data_.size(); ++i) {
+        writeStreamRow(data_[i], stream.sampleWidths[i]);
+    }
+    data_.clear();
+    stream.sampleWidths.clear();
+}
+
+void TableFormatter::writeStreamRow(const EnhancedTableRow& row, const CellWidths& cellWidths) {
+    auto& stream = *stream_;
+    if (stream.quit || stream.columnWidths.empty()) {
+        return;
+    }
+
+    // Keep one line of the page for the prompt
+    size_t pageHeight = stream.options.pageHeight;
+    if (pageHeight > 1 && stream.linesOnPage + 1 >= pageHeight) {
+        *stream.out << "-- More -- (Enter: next page, q: quit) " << std::flush;
+        std::istream& input = stream.options.pageInput ? *stream.options.pageInput : std::cin;
+        std::string answer;
+        if (!std::getline(input, answer)) {
+            stream.options.pageHeight = 0;  // nobody to answer, write the rest
+            *stream.out << "\n";
+        } else if (!answer.empty() && (answer[0] == 'q' || answer[0] == 'Q')) {
+            stream.quit = true;
+            return;
+        }
+        stream.linesOnPage = 0;
+    }
+
+    writeStreamLines(renderRow(row, cellWidths, stream.columnWidths) + "\n");
+    ++stream.rowsWritten;
+}
+
+void TableFormatter::writeStreamLines(const std::string& text) {
+    *stream_->out << text;
+    stream_->linesOnPage += static_cast<size_t>(std::count(text.begin(), text.end(), '\n'));
 }
 
 size_t TableFormatter::getColumnCount() const {
@@ -180,7 +372,10 @@ size_t TableFormatter::getRowCount() const {
 }
 
 size_t TableFormatter::getEstimatedWidth() const {
-    auto columnWidths = calculateColumnWidths();
+    return getTableWidth(calculateColumnWidths());
+}
+
+size_t TableFormatter::getTableWidth(const std::vector<size_t>& columnWidths) const {
     size_t totalWidth = 0;
 
     for (size_t width : columnWidths) {
@@ -218,26 +413,7 @@ size_t TableFormatter::getEstimatedHeight() const {
 }
 
 std::string TableFormatter::alignText(const std::string& text, size_t width, Alignment alignment) {
-    size_t textWidth = getDisplayWidth(text);
-    if (textWidth >= width) {
-        return text;
-    }
-
-    size_t padding = width - textWidth;
-
-    switch (alignment) {
-        case Alignment::Left:
-            return text + std::string(padding, ' ');
-        case Alignment::Right:
-            return std::string(padding, ' ') + text;
-        case Alignment::Center: {
-            size_t leftPad = padding / 2;
-            size_t rightPad = padding - leftPad;
-            return std::string(leftPad, ' ') + text + std::string(rightPad, ' ');
-        }
-        default:
-            return text;
-    }
+    return padToWidth(text, getDisplayWidth(text), width, alignment);
 }
 
 std::vector<std::string> TableFormatter::wrapText(const std::string& text, size_t width) {
@@ -274,9 +450,7 @@ std::vector<std::string> TableFormatter::wrapText(const std::string& text, size_
 }
 
 size_t TableFormatter::getDisplayWidth(const std::string& text) {
-    // Simple implementation - doesn't handle ANSI escape codes
-    // In a full implementation, you'd strip ANSI codes before measuring
-    return text.length();
+    return prefixForWidth(text, std::string::npos).second;
 }
 
 TableFormatter::BorderChars TableFormatter::getBorderChars() const {
@@ -296,37 +470,50 @@ TableFormatter::BorderChars TableFormatter::getBorderChars() const {
     }
 }
 
+TableFormatter::CellWidths TableFormatter::measureRow(const EnhancedTableRow& row) {
+    CellWidths widths;
+    widths.reserve(row.size());
+    for (const auto& cell : row) {
+        widths.push_back(getDisplayWidth(cell.content));
+    }
+    return widths;
+}
+
 std::vector<size_t> TableFormatter::calculateColumnWidths() const {
-    size_t columnCount = getActualColumnCount();
+    std::vector<CellWidths> cellWidths;
+    cellWidths.reserve(data_.size());
+    for (const auto& row : data_) {
+        cellWidths.push_back(measureRow(row));
+    }
+    return calculateColumnWidths(cellWidths, getActualColumnCount());
+}
+
+std::vector<size_t> TableFormatter::calculateColumnWidths(
+        const std::vector<CellWidths>& cellWidths, size_t columnCount) const {
     std::vector<size_t> widths(columnCount, 0);
 
-    // Initialize with configured widths or minimum widths
+    // Initialize with configured widths or minimum widths, then the header widths
     for (size_t i = 0; i < columnCount && i < columns_.size(); ++i) {
         if (columns_[i].width > 0) {
             widths[i] = columns_[i].width;
         } else {
             widths[i] = columns_[i].minWidth;
         }
-    }
-
-    // Calculate required widths based on content
-    for (size_t i = 0; i < columnCount; ++i) {
-        // Check header width
-        if (i < columns_.size() && config_.showHeader) {
+        if (config_.showHeader) {
             widths[i] = std::max(widths[i], getDisplayWidth(columns_[i].header));
         }
+    }
 
-        // Check data widths
-        for (const auto& row : data_) {
-            if (i < row.size()) {
-                widths[i] = std::max(widths[i], getDisplayWidth(row[i].content));
-            }
+    // Calculate required widths based on content
+    for (const auto& row : cellWidths) {
+        for (size_t i = 0; i < row.size() && i < columnCount; ++i) {
+            widths[i] = std::max(widths[i], row[i]);
         }
+    }
 
-        // Apply maximum width constraint
-        if (i < columns_.size()) {
-            widths[i] = std::min(widths[i], columns_[i].maxWidth);
-        }
+    // Apply maximum width constraint
+    for (size_t i = 0; i < columnCount && i < columns_.size(); ++i) {
+        widths[i] = std::min(widths[i], columns_[i].maxWidth);
     }
 
     return widths;
@@ -342,12 +529,36 @@ size_t TableFormatter::getActualColumnCount() const {
     return maxColumns;
 }
 
-std::string TableFormatter::renderTitle() const {
+std::string TableFormatter::renderHead(const std::vector<size_t>& columnWidths) const {
+    std::string head;
+
+    // Render title
+    if (!config_.title.empty()) {
+        head += renderTitle(columnWidths) + "\n";
+    }
+
+    // Render top border
+    if (config_.borderStyle != TableBorderStyle::None) {
+        head += renderSeparator(columnWidths, true, false) + "\n";
+    }
+
+    // Render header
+    if (config_.showHeader && !columns_.empty()) {
+        head += renderHeader(columnWidths) + "\n";
+        if (config_.borderStyle != TableBorderStyle::None) {
+            head += renderSeparator(columnWidths, false, false) + "\n";
+        }
+    }
+
+    return head;
+}
+
+std::string TableFormatter::renderTitle(const std::vector<size_t>& columnWidths) const {
     if (config_.title.empty()) {
         return "";
     }
 
-    size_t tableWidth = getEstimatedWidth();
+    size_t tableWidth = getTableWidth(columnWidths);
     std::string title = config_.title;
 
     if (config_.centerTitle) {
@@ -357,7 +568,7 @@ std::string TableFormatter::renderTitle() const {
     return TerminalUtils::colorAndStyle(title, config_.titleColor, config_.titleStyles);
 }
 
-std::string TableFormatter::renderHeader() const {
+std::string TableFormatter::renderHeader(const std::vector<size_t>& columnWidths) const {
     if (columns_.empty()) {
         return "";
     }
@@ -370,92 +581,94 @@ std::string TableFormatter::renderHeader() const {
         headerRow.push_back(cell);
     }
 
-    return renderRow(headerRow, 0);
+    return renderRow(headerRow, measureRow(headerRow), columnWidths);
 }
 
-std::string TableFormatter::renderSeparator(bool isTop, bool isBottom) const {
+std::string TableFormatter::renderSeparator(const std::vector<size_t>& columnWidths, bool isTop,
+                                            bool isBottom) const {
     auto borderChars = getBorderChars();
-    auto columnWidths = calculateColumnWidths();
 
-    std::ostringstream oss;
+    std::string line;
 
     // Left corner
     if (isTop) {
-        oss << borderChars.topLeft;
+        line += borderChars.topLeft;
     } else if (isBottom) {
-        oss << borderChars.bottomLeft;
+        line += borderChars.bottomLeft;
     } else {
-        oss << borderChars.leftJunction;
+        line += borderChars.leftJunction;
     }
 
     // Columns with separators
     for (size_t i = 0; i < columnWidths.size(); ++i) {
         // Horizontal line for column
         size_t lineWidth = columnWidths[i] + config_.leftPadding + config_.rightPadding;
-        oss << std::string(lineWidth, borderChars.horizontal);
+        line.append(lineWidth, borderChars.horizontal);
 
         // Junction or corner
         if (i < columnWidths.size() - 1) {
             if (isTop) {
-                oss << borderChars.topJunction;
+                line += borderChars.topJunction;
             } else if (isBottom) {
-                oss << borderChars.bottomJunction;
+                line += borderChars.bottomJunction;
             } else {
-                oss << borderChars.cross;
+                line += borderChars.cross;
             }
         }
     }
 
     // Right corner
     if (isTop) {
-        oss << borderChars.topRight;
+        line += borderChars.topRight;
     } else if (isBottom) {
-        oss << borderChars.bottomRight;
+        line += borderChars.bottomRight;
     } else {
-        oss << borderChars.rightJunction;
+        line += borderChars.rightJunction;
     }
 
-    return oss.str();
+    return line;
 }
 
-std::string TableFormatter::renderRow(const EnhancedTableRow& row, size_t rowIndex) const {
-    auto columnWidths = calculateColumnWidths();
+std::string TableFormatter::renderRow(const EnhancedTableRow& row, const CellWidths& cellWidths,
+                                      const std::vector<size_t>& columnWidths) const {
     auto borderChars = getBorderChars();
+    bool bordered = config_.borderStyle != TableBorderStyle::None;
 
-    std::ostringstream oss;
+    std::string line;
 
     // Left border
-    if (config_.borderStyle != TableBorderStyle::None) {
-        oss << borderChars.vertical;
+    if (bordered) {
+        line += borderChars.vertical;
     }
 
     // Cells
     for (size_t i = 0; i < columnWidths.size(); ++i) {
         // Padding
-        oss << std::string(config_.leftPadding, ' ');
+        line.append(config_.leftPadding, ' ');
 
         // Cell content
         if (i < row.size()) {
-            oss << renderCell(row[i], columnWidths[i], i);
+            line += renderCell(row[i], cellWidths[i], columnWidths[i], i);
         } else {
-            oss << std::string(columnWidths[i], ' ');
+            line.append(columnWidths[i], ' ');
         }
 
         // Padding
-        oss << std::string(config_.rightPadding, ' ');
+        line.append(config_.rightPadding, ' ');
 
         // Column separator
-        if (config_.borderStyle != TableBorderStyle::None) {
-            oss << borderChars.vertical;
+        if (bordered) {
+            line += borderChars.vertical;
         }
     }
 
-    return oss.str();
+    return line;
 }
 
-std::string TableFormatter::renderCell(const EnhancedTableCell& cell, size_t width,
-                                       size_t columnIndex) const {
-    std::string content = formatCellContent(cell.content, cell, width);
+std::string TableFormatter::renderCell(const EnhancedTableCell& cell, size_t contentWidth,
+                                       size_t width, size_t columnIndex) const {
+    std::string content = formatCellContent(cell.content, contentWidth, width);
+    size_t shownWidth = std::min(contentWidth, width);
 
     // Apply alignment
     Alignment alignment = cell.alignment;
@@ -463,7 +676,7 @@ std::string TableFormatter::renderCell(const EnhancedTableCell& cell, size_t wid
         alignment = columns_[columnIndex].alignment;
     }
 
-    content = alignText(content, width, alignment);
+    content = padToWidth(content, shownWidth, width, alignment);
 
     // Apply colors and styles
     if (cell.textColor != Color::White || !cell.styles.empty()) {
@@ -473,17 +686,17 @@ std::string TableFormatter::renderCell(const EnhancedTableCell& cell, size_t wid
     return content;
 }
 
-std::string TableFormatter::formatCellContent(const std::string& content,
-                                              const EnhancedTableCell& cell, size_t width) const {
-    if (content.length() <= width) {
+std::string TableFormatter::formatCellContent(const std::string& content, size_t contentWidth,
+                                              size_t width) const {
+    if (contentWidth <= width) {
         return content;
     }
 
-    // Truncate if too long
+    // Truncate if too long, on a code point boundary
     if (width > 3) {
-        return content.substr(0, width - 3) + "...";
+        return content.substr(0, prefixForWidth(content, width - 3).first) + "...";
     } else {
-        return content.substr(0, width);
+        return content.substr(0, prefixForWidth(content, width).first);
     }
 }
 
@@ -541,25 +754,27 @@ void StatusTable::addProgressRow(const std::string& item, int progress,
 }
 
 void StatusTable::addErrorRow(const std::string& item, const std::string& error) {
-    addStatusRow(item, "ERROR", Color::Red);
-    // Update the last row to include error details
-    if (!data_.empty()) {
-        data_.back()[2] = EnhancedTableCell(error, Color::Red);
-    }
+    EnhancedTableRow row;
+    row.emplace_back(item);
+    row.emplace_back("ERROR", Color::Red);
+    row.emplace_back(error, Color::Red);
+    addRow(row);
 }
 
 void StatusTable::addWarningRow(const std::string& item, const std::string& warning) {
-    addStatusRow(item, "WARNING", Color::Yellow);
-    if (!data_.empty()) {
-        data_.back()[2] = EnhancedTableCell(warning, Color::Yellow);
-    }
+    EnhancedTableRow row;
+    row.emplace_back(item);
+    row.emplace_back("WARNING", Color::Yellow);
+    row.emplace_back(warning, Color::Yellow);
+    addRow(row);
 }
 
 void StatusTable::addInfoRow(const std::string& item, const std::string& info) {
-    addStatusRow(item, "INFO", Color::Cyan);
-    if (!data_.empty()) {
-        data_.back()[2] = EnhancedTableCell(info, Color::Cyan);
-    }
+    EnhancedTableRow row;
+    row.emplace_back(item);
+    row.emplace_back("INFO", Color::Cyan);
+    row.emplace_back(info, Color::Cyan);
+    addRow(row);
 }
 
 // ConfigurationTable implementation
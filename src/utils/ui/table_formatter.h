@@ -1,6 +1,7 @@
 #pragma once
 
 #include <functional>
+#include <iosfwd>
 #include <optional>
 #include <string>
 #include <unordered_map>
@@ -76,6 +77,23 @@ struct TableConfig {
     size_t bottomPadding = 0;
 };
 
+// How a streamed table sizes columns whose ColumnConfig::width is 0
+enum class StreamWidthPolicy {
+    Fixed,   // header width (at least minWidth); the header is written immediately
+    Sampled  // measured over the first sampleRows rows, which are held back until then
+};
+
+// Streaming output options. Cells wider than their column are truncated
+struct StreamOptions {
+    StreamWidthPolicy widthPolicy = StreamWidthPolicy::Sampled;
+    size_t sampleRows = 100;
+    size_t pageHeight = 0;              // lines per page; 0 disables paging
+    std::istream* pageInput = nullptr;  // answers the pager prompt, std::cin if null
+
+    // Pages at the terminal height when stdin and stdout are terminals
+    static StreamOptions forTerminal();
+};
+
 // Table data structure
 using EnhancedTableRow = std::vector<EnhancedTableCell>;
 using EnhancedTableData = std::vector<EnhancedTableRow>;
@@ -118,6 +136,14 @@ class TableFormatter {
     void print() const;
     void printToStream(std::ostream& stream) const;
 
+    // Streaming: rows added between beginStream() and endStream() are written to
+    // the stream instead of being stored. endStream() writes the bottom border
+    void beginStream(std::ostream& stream, const StreamOptions& options = {});
+    void endStream();
+    bool isStreaming() const;
+    bool isStreamQuit() const;  // the pager was quit; further rows are dropped
+    size_t getStreamedRowCount() const;
+
     // Statistics and information
     size_t getColumnCount() const;
     size_t getRowCount() const;
@@ -127,7 +153,7 @@ class TableFormatter {
     // Utility methods
     static std::string alignText(const std::string& text, size_t width, Alignment alignment);
     static std::vector<std::string> wrapText(const std::string& text, size_t width);
-    static size_t getDisplayWidth(const std::string& text);  // Handles ANSI codes
+    static size_t getDisplayWidth(const std::string& text);  // Skips ANSI codes, counts code points
 
    protected:
     TableConfig config_;
@@ -143,16 +169,46 @@ class TableFormatter {
         char cross;
     };
 
+    // Display width of every cell of a row, measured once per row
+    using CellWidths = std::vector<size_t>;
+
+    struct StreamState {
+        std::ostream* out = nullptr;
+        StreamOptions options;
+        std::vector<size_t> columnWidths;  // fixed once the head is written
+        std::vector<CellWidths> sampleWidths;  // of the rows held back in data_
+        bool headWritten = false;
+        bool quit = false;
+        size_t rowsWritten = 0;
+        size_t linesOnPage = 0;
+    };
+
+    std::optional<StreamState> stream_;
+
     BorderChars getBorderChars() const;
+    static CellWidths measureRow(const EnhancedTableRow& row);
     std::vector<size_t> calculateColumnWidths() const;
-    std::string renderTitle() const;
-    std::string renderHeader() const;
-    std::string renderSeparator(bool isTop = false, bool isBottom = false) const;
-    std::string renderRow(const EnhancedTableRow& row, size_t rowIndex) const;
-    std::string renderCell(const EnhancedTableCell& cell, size_t width, size_t columnIndex) const;
-    std::string formatCellContent(const std::string& content, const EnhancedTableCell& cell,
+    std::vector<size_t> calculateColumnWidths(const std::vector<CellWidths>& cellWidths,
+                                              size_t columnCount) const;
+    size_t getTableWidth(const std::vector<size_t>& columnWidths) const;
+    std::string renderHead(const std::vector<size_t>& columnWidths) const;
+    std::string renderTitle(const std::vector<size_t>& columnWidths) const;
+    std::string renderHeader(const std::vector<size_t>& columnWidths) const;
+    std::string renderSeparator(const std::vector<size_t>& columnWidths, bool isTop = false,
+                                bool isBottom = false) const;
+    std::string renderRow(const EnhancedTableRow& row, const CellWidths& cellWidths,
+                          const std::vector<size_t>& columnWidths) const;
+    std::string renderCell(const EnhancedTableCell& cell, size_t contentWidth, size_t width,
+                           size_t columnIndex) const;
+    std::string formatCellContent(const std::string& content, size_t contentWidth,
                                   size_t width) const;
 
+    // Streaming helpers
+    void appendRow(EnhancedTableRow row);
+    void writeStreamHead();
+    void writeStreamRow(const EnhancedTableRow& row, const CellWidths& cellWidths);
+    void writeStreamLines(const std::string& text);
+
     // Helper methods
     size_t getActualColumnCount() const;
     EnhancedTableCell createCell(const std::string& content, size_t columnIndex) const;
@@ -1,5 +1,7 @@
 #include "../ui/terminal_utils.h"
 
+#include "../core/string_utils.h"
+
 #include <algorithm>
 #include <cctype>
 #include <clocale>
@@ -126,12 +128,11 @@ bool TerminalUtils::testUtf8Encoding() {
             "العربية"             // Arabic
     };
 
-    // For now, we'll assume UTF-8 works if we can output without crashing
+    // For now, we'll assume UTF-8 works if the strings survived as valid UTF-8
     // A more sophisticated test would check actual rendering
     try {
         for (const auto& test : testStrings) {
-            // Just verify the string is valid UTF-8 by checking length
-            if (test.empty()) {
+            if (test.empty() || !StringUtils::isValidUtf8(test)) {
                 return false;
             }
         }
@@ -10,11 +10,10 @@
 #ifdef _WIN32
 #include <io.h>
 #include <windows.h>
-#define popen _popen
-#define pclose _pclose
 #endif
 
 #include "../core/file_utils.h"
+#include "../core/process_runner.h"
 #include "../ui/terminal_utils.h"
 
 using namespace utils;
@@ -99,7 +98,7 @@ MSYS2Validator::ValidationResult MSYS2Validator::validateMSYS2Environment() {
     }
 
     // Check for pacman
-    std::string pacmanVersion = executeCommand("pacman --version");
+    std::string pacmanVersion = executeCommand({"pacman", "--version"});
     if (pacmanVersion.empty()) {
         result.errors.push_back("pacman package manager not found");
         result.isValid = false;
@@ -166,21 +165,12 @@ MSYS2Validator::BuildTestResult MSYS2Validator::testMSYS2Build(const std::string
     return result;
 }
 
-std::string MSYS2Validator::executeCommand(const std::string& command) {
-    std::string result;
-    char buffer[128];
-
-    FILE* pipe = popen(command.c_str(), "r");
-    if (!pipe) {
-        return "";
-    }
-
-    while (fgets(buffer, sizeof(buffer), pipe) != nullptr) {
-        result += buffer;
-    }
-
-    pclose(pipe);
-    return result;
+std::string MSYS2Validator::executeCommand(const std::vector<std::string>& command,
+                                           const std::string& workingDir) {
+    ProcessOptions options;
+    options.workingDirectory = workingDir;
+    options.discardStderr = true;
+    return ProcessRunner::run(command, options).output;
 }
 
 bool MSYS2Validator::isMSYS2Environment() {
@@ -300,15 +290,12 @@ MSYS2Validator::ValidationResult MSYS2Validator::validateBuildTools() {
     result.isValid = true;
 
     // Check for essential build tools
-    std::vector<std::pair<std::string, std::string>> tools = {{"cmake", "cmake --version"},
-                                                              {"ninja", "ninja --version"},
-                                                              {"gcc", "gcc --version"},
-                                                              {"make", "make --version"}};
+    std::vector<std::string> tools = {"cmake", "ninja", "gcc", "make"};
 
     for (const auto& tool : tools) {
-        std::string output = executeCommand(tool.second);
+        std::string output = executeCommand({tool, "--version"});
         if (output.empty()) {
-            result.warnings.push_back("Build tool not found: " + tool.first);
+            result.warnings.push_back("Build tool not found: " + tool);
         }
     }
 
@@ -341,8 +328,7 @@ std::optional<std::string> MSYS2Validator::getPackageInfo(const std::string& pac
         return std::nullopt;
     }
 
-    std::string command = "pacman -Si " + packageName + " 2>/dev/null";
-    std::string output = executeCommand(command);
+    std::string output = executeCommand({"pacman", "-Si", packageName});
 
     if (output.empty()) {
         return std::nullopt;
@@ -356,8 +342,7 @@ bool MSYS2Validator::isPackageInstalled(const std::string& packageName) {
         return false;
     }
 
-    std::string command = "pacman -Q " + packageName + " 2>/dev/null";
-    std::string output = executeCommand(command);
+    std::string output = executeCommand({"pacman", "-Q", packageName});
 
     return !output.empty();
 }
@@ -422,13 +407,9 @@ MSYS2Validator::ValidationResult MSYS2Validator::testPackageBuild(const std::str
         return result;
     }
 
-    // Change to project directory
-    std::filesystem::path originalPath = std::filesystem::current_path();
-    std::filesystem::current_path(projectPath);
-
     try {
         // Test makepkg --printsrcinfo (syntax check)
-        std::string makepkgTest = executeCommand("makepkg --printsrcinfo");
+        std::string makepkgTest = executeCommand({"makepkg", "--printsrcinfo"}, projectPath);
         if (makepkgTest.empty()) {
             result.errors.push_back("makepkg --printsrcinfo failed - PKGBUILD syntax error");
             result.isValid = false;
@@ -437,8 +418,9 @@ MSYS2Validator::ValidationResult MSYS2Validator::testPackageBuild(const std::str
         }
 
         // Test source preparation (if possible)
-        if (std::filesystem::exists("PKGBUILD")) {
-            std::string sourceTest = executeCommand("makepkg --nobuild --noextract --nodeps");
+        if (std::filesystem::exists(std::filesystem::path(projectPath) / "PKGBUILD")) {
+            std::string sourceTest = executeCommand(
+                    {"makepkg", "--nobuild", "--noextract", "--nodeps"}, projectPath);
             if (!sourceTest.empty() && sourceTest.find("error") == std::string::npos) {
                 result.suggestions.push_back("Source preparation test passed");
             } else {
@@ -450,9 +432,6 @@ MSYS2Validator::ValidationResult MSYS2Validator::testPackageBuild(const std::str
         result.warnings.push_back("Package build test encountered error: " + std::string(e.what()));
     }
 
-    // Restore original directory
-    std::filesystem::current_path(originalPath);
-
     return result;
 }
 
@@ -114,10 +114,12 @@ class MSYS2Validator {
    private:
     /**
      * @brief Execute a command and capture output
-     * @param command Command to execute
+     * @param command Program and arguments (no shell is involved)
+     * @param workingDir Directory to run the command in, empty for the current one
      * @return Command output or empty string on failure
      */
-    static std::string executeCommand(const std::string& command);
+    static std::string executeCommand(const std::vector<std::string>& command,
+                                      const std::string& workingDir = "");
 
     /**
      * @brief Check if we're running in MSYS2 environment
@@ -191,6 +191,177 @@ TEST_F(IntegrationTest, EndToEndNetworkProjectWithCustomLibrary) {
     verifyFileContains("test-network/CMakeLists.txt", "boost");
 }
 
+TEST_F(IntegrationTest, EndToEndNetworkProjectWithServerPool) {
+    std::vector<std::string> args = {
+        "cpp-scaffold", "create", "test-network-pool",
+        "--template", "network",
+        "--build", "cmake",
+        "--network-lib", "boost",
+        "--network-concurrency=pool",
+        "--package", "none",
+        "--no-git"
+    };
+
+    std::vector<char*> argv;
+    for (auto& arg : args) {
+        argv.push_back(const_cast<char*>(arg.c_str()));
+    }
+
+    CliOptions options = CliParser::parse(static_cast<int>(argv.size()), argv.data());
+    EXPECT_EQ("pool", options.networkConcurrency);
+
+    TemplateManager manager;
+    EXPECT_TRUE(manager.createProject(options));
+    verifyBasicProjectStructure("test-network-pool");
+
+    // io_context per worker with SO_REUSEPORT acceptors and shared broadcast buffers
+    verifyFileContains("test-network-pool/src/server/server.cpp", "SO_REUSEPORT");
+    verifyFileContains("test-network-pool/include/test-network-pool/server/server.h",
+                       "namespace asio = boost::asio;");
+    verifyFileContains("test-network-pool/include/test-network-pool/server/server.h",
+                       "std::size_t threads = 0");
+    verifyFileContains("test-network-pool/bench/load_generator.h", "runLoad");
+    verifyFileContains("test-network-pool/bench/server_benchmark.cpp", "setEchoEnabled(true)");
+    verifyFileContains("test-network-pool/CMakeLists.txt", "test-network-pool_bench");
+    verifyFileContains("test-network-pool/CMakeLists.txt", "Threads::Threads");
+}
+
+TEST_F(IntegrationTest, EndToEndNetworkProjectWithNativeReactor) {
+    std::vector<std::string> args = {
+        "cpp-scaffold", "create", "test-network-native",
+        "--template", "network",
+        "--build", "cmake",
+        "--network-lib", "native",
+        "--package", "none",
+        "--no-git"
+    };
+
+    std::vector<char*> argv;
+    for (auto& arg : args) {
+        argv.push_back(const_cast<char*>(arg.c_str()));
+    }
+
+    CliOptions options = CliParser::parse(static_cast<int>(argv.size()), argv.data());
+    EXPECT_EQ("native", options.networkLibrary.value_or(""));
+
+    TemplateManager manager;
+    EXPECT_TRUE(manager.createProject(options));
+    verifyBasicProjectStructure("test-network-native");
+
+    // Edge-triggered epoll loops, optional io_uring backend and no third-party network library
+    verifyFileContains("test-network-native/include/test-network-native/server/reactor.h",
+                       "EPOLLET");
+    verifyFileContains("test-network-native/include/test-network-native/server/reactor.h",
+                       "io_uring_prep_poll_multishot");
+    verifyFileContains("test-network-native/src/server/server.cpp", "sendmsg");
+    verifyFileContains("test-network-native/bench/echo_benchmark.cpp", "setEchoEnabled(true)");
+    verifyFileContains("test-network-native/CMakeLists.txt", "test-network-native_USE_IO_URING");
+    verifyFileContains("test-network-native/CMakeLists.txt", "test-network-native_echo_bench");
+    EXPECT_EQ(std::string::npos,
+              FileUtils::readFromFile("test-network-native/CMakeLists.txt").find("asio"));
+}
+
+TEST_F(IntegrationTest, EndToEndGameEngineProjectWithSparseSetEcs) {
+    std::vector<std::string> args = {
+        "cpp-scaffold", "create", "test_game_ecs",
+        "--template", "gameengine",
+        "--build", "cmake",
+        "--game-ecs", "sparse-set",
+        "--package", "none",
+        "--no-git"
+    };
+
+    std::vector<char*> argv;
+    for (auto& arg : args) {
+        argv.push_back(const_cast<char*>(arg.c_str()));
+    }
+
+    CliOptions options = CliParser::parse(static_cast<int>(argv.size()), argv.data());
+    EXPECT_EQ("sparse-set", options.gameEcs);
+
+    TemplateManager manager;
+    EXPECT_TRUE(manager.createProject(options));
+    verifyBasicProjectStructure("test_game_ecs");
+
+    // Component pools, access-based scheduling and a benchmark free of graphics dependencies
+    verifyFileContains("test_game_ecs/src/engine/core/component.h", "class ComponentPool");
+    verifyFileContains("test_game_ecs/src/engine/core/registry.h", "ComponentView<Ts...> View()");
+    verifyFileContains("test_game_ecs/src/engine/core/system.h", "class Scheduler");
+    verifyFileContains("test_game_ecs/src/engine/core/job_system.cpp", "JobSystem::ParallelFor");
+    verifyFileContains("test_game_ecs/src/engine/scene/scene_manager.h", "Registry registry_;");
+    verifyFileContains("test_game_ecs/bench/ecs_benchmark.cpp", "MovementSystem");
+    verifyFileContains("test_game_ecs/CMakeLists.txt", "add_executable(test_game_ecs_ecs_bench");
+    verifyFileContains("test_game_ecs/CMakeLists.txt", "src/engine/core/job_system.cpp");
+}
+
+TEST_F(IntegrationTest, EndToEndGameEngineProjectWithFrameRuntime) {
+    std::vector<std::string> args = {
+        "cpp-scaffold", "create", "test_game_perf",
+        "--template", "gameengine",
+        "--build", "cmake",
+        "--game-ecs", "sparse-set",
+        "--game-perf",
+        "--package", "none",
+        "--no-git"
+    };
+
+    std::vector<char*> argv;
+    for (auto& arg : args) {
+        argv.push_back(const_cast<char*>(arg.c_str()));
+    }
+
+    CliOptions options = CliParser::parse(static_cast<int>(argv.size()), argv.data());
+    EXPECT_TRUE(options.gamePerf);
+
+    TemplateManager manager;
+    EXPECT_TRUE(manager.createProject(options));
+    verifyBasicProjectStructure("test_game_perf");
+
+    // Work-stealing jobs shared with the ECS, a frame task graph, allocators and tracing
+    verifyFileContains("test_game_perf/src/engine/core/job_system.cpp", "JobSystem::Steal");
+    verifyFileContains("test_game_perf/src/engine/core/task_graph.h", "class TaskGraph");
+    verifyFileContains("test_game_perf/src/engine/core/profiler.cpp", "traceEvents");
+    verifyFileContains("test_game_perf/src/engine/memory/frame_arena.h", "class FrameArena");
+    verifyFileContains("test_game_perf/src/engine/memory/pool_allocator.h", "class PoolAllocator");
+    verifyFileContains("test_game_perf/src/engine/core/engine.cpp", "frameGraph_.Run(*jobs_)");
+    verifyFileContains("test_game_perf/src/engine/core/engine.cpp",
+                       "sceneManager_->SetJobSystem(jobs_.get())");
+    verifyFileContains("test_game_perf/CMakeLists.txt", "src/engine/memory/frame_arena.cpp");
+}
+
+TEST_F(IntegrationTest, EndToEndWebServiceProjectWithPerfServer) {
+    std::vector<std::string> args = {
+        "cpp-scaffold", "create", "test_web_perf",
+        "--template", "webservice",
+        "--build", "cmake",
+        "--web-perf",
+        "--package", "none",
+        "--no-git"
+    };
+
+    std::vector<char*> argv;
+    for (auto& arg : args) {
+        argv.push_back(const_cast<char*>(arg.c_str()));
+    }
+
+    CliOptions options = CliParser::parse(static_cast<int>(argv.size()), argv.data());
+    EXPECT_TRUE(options.webPerf);
+
+    TemplateManager manager;
+    EXPECT_TRUE(manager.createProject(options));
+    verifyBasicProjectStructure("test_web_perf");
+
+    // Tuned worker pool, pre-serialized responses, Prometheus metrics and load tools
+    verifyFileContains("test_web_perf/src/server.cpp", "new httplib::ThreadPool(workers)");
+    verifyFileContains("test_web_perf/src/server.cpp", "set_keep_alive_max_count");
+    verifyFileContains("test_web_perf/src/server.cpp", "res.set_content(healthBody_");
+    verifyFileContains("test_web_perf/include/http/json_writer.h", "class JsonWriter");
+    verifyFileContains("test_web_perf/src/http/metrics.cpp", "http_request_duration_seconds_bucket");
+    verifyFileContains("test_web_perf/scripts/load_test.sh", "wrk -t");
+    verifyFileContains("test_web_perf/tools/load_generator.cpp", "Connection: keep-alive");
+    verifyFileContains("test_web_perf/CMakeLists.txt", "add_executable(test_web_perf_loadgen");
+}
+
 TEST_F(IntegrationTest, EndToEndProjectWithMesonBuildSystem) {
     std::vector<std::string> args = {
         "cpp-scaffold", "create", "test-meson",
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "config/config_manager.h"
+#include <chrono>
 #include <filesystem>
 #include <fstream>
 #include <nlohmann/json.hpp>
@@ -272,3 +273,55 @@ TEST_F(ConfigManagerTest, ConfigurationMigration) {
     // Just test that methods don't crash
     EXPECT_TRUE((loadResult && saveResult) || (!loadResult || !saveResult));
 }
+
+TEST_F(ConfigManagerTest, ProfileIndexReusesSnapshotForUnchangedFiles) {
+    auto profilesDir = testDir / "profiles";
+    std::filesystem::create_directories(profilesDir);
+    auto writeProfile = [&](const std::string& file, const json& profile) {
+        std::ofstream(profilesDir / file) << profile.dump();
+    };
+    writeProfile("a.json", {{"name", "alpha"}, {"settings", {{"templateType", "lib"}}}});
+    writeProfile("b.json", {{"name", "beta"}, {"settings", {{"templateType", "nope"}}}});
+
+    ASSERT_TRUE(configManager->loadConfiguration());
+    EXPECT_EQ(configManager->listProfiles(), (std::vector<std::string>{"alpha", "beta"}));
+    EXPECT_TRUE(std::filesystem::exists(configManager->getIndexSnapshotPath()));
+    // The snapshot's temporary file was renamed into place, not left behind
+    for (const auto& entry :
+         std::filesystem::directory_iterator(configManager->getIndexSnapshotPath().parent_path())) {
+        EXPECT_NE(entry.path().extension(), ".tmp");
+    }
+
+    // Profiles are parsed and validated only when requested
+    auto alpha = configManager->loadProfile("alpha");
+    ASSERT_TRUE(alpha.has_value());
+    EXPECT_EQ(alpha->templateType, TemplateType::Lib);
+    EXPECT_FALSE(configManager->loadProfile("beta").has_value());
+
+    // Same size and mtime: the snapshot is trusted and the file is not re-read
+    auto mtime = std::filesystem::last_write_time(profilesDir / "a.json");
+    writeProfile("a.json", {{"name", "gamma"}, {"settings", {{"templateType", "lib"}}}});
+    std::filesystem::last_write_time(profilesDir / "a.json", mtime);
+    ASSERT_TRUE(configManager->loadConfiguration());
+    EXPECT_EQ(configManager->listProfiles(), (std::vector<std::string>{"alpha", "beta"}));
+
+    // A changed mtime re-indexes just that file
+    std::filesystem::last_write_time(profilesDir / "a.json",
+                                     mtime + std::chrono::seconds(5));
+    ASSERT_TRUE(configManager->loadConfiguration());
+    EXPECT_EQ(configManager->listProfiles(), (std::vector<std::string>{"beta", "gamma"}));
+}
+
+TEST_F(ConfigManagerTest, DeleteProfileRemovesFileAndIndexEntry) {
+    ASSERT_TRUE(configManager->loadConfiguration());
+    ASSERT_TRUE(configManager->saveProfile("doomed", createTestOptions()));
+    EXPECT_TRUE(std::filesystem::exists(testDir / "profiles" / "doomed.json"));
+
+    EXPECT_TRUE(configManager->deleteProfile("doomed"));
+    EXPECT_FALSE(std::filesystem::exists(testDir / "profiles" / "doomed.json"));
+    EXPECT_TRUE(configManager->listProfiles().empty());
+
+    // A fresh index built from the snapshot agrees
+    ASSERT_TRUE(configManager->loadConfiguration());
+    EXPECT_TRUE(configManager->listProfiles().empty());
+}
@@ -1,7 +1,10 @@
 #include <gtest/gtest.h>
 #include "documentation/doc_generator.h"
+#include <chrono>
+#include <cstdlib>
 #include <filesystem>
 #include <fstream>
+#include <iterator>
 #include <string>
 
 using namespace documentation;
@@ -17,6 +20,12 @@ protected:
         sourceDir = testDir / "src";
         std::filesystem::create_directories(sourceDir);
 
+        // Keep the tool's cache directory (and the API doc cache in it) here
+        const char* configDir = std::getenv("CPP_SCAFFOLD_CONFIG_DIR");
+        hadConfigDir = configDir != nullptr;
+        originalConfigDir = configDir ? configDir : "";
+        setConfigDir((testDir / "config").string());
+
         // Create a simple header file for testing
         createTestHeaderFile();
 
@@ -26,12 +35,32 @@ protected:
     }
 
     void TearDown() override {
+        if (hadConfigDir) {
+            setConfigDir(originalConfigDir);
+        } else {
+#ifdef _WIN32
+            _putenv_s("CPP_SCAFFOLD_CONFIG_DIR", "");
+#else
+            unsetenv("CPP_SCAFFOLD_CONFIG_DIR");
+#endif
+        }
+
         // Clean up test directory
         if (std::filesystem::exists(testDir)) {
             std::filesystem::remove_all(testDir);
         }
     }
 
+    static void setConfigDir(const std::string& dir) {
+#ifdef _WIN32
+        _putenv_s("CPP_SCAFFOLD_CONFIG_DIR", dir.c_str());
+#else
+        setenv("CPP_SCAFFOLD_CONFIG_DIR", dir.c_str(), 1);
+#endif
+    }
+
+    bool hadConfigDir = false;
+    std::string originalConfigDir;
     std::filesystem::path testDir;
     std::filesystem::path sourceDir;
     DocConfig docConfig;
@@ -169,3 +198,88 @@ TEST_F(DocGeneratorTest, BasicDocumentationGeneration) {
     result = docGenerator->generateLicense(testDir);
     EXPECT_TRUE(result || !result); // Just test that it doesn't crash
 }
+
+TEST_F(DocGeneratorTest, ExtractorMergesParallelResultsIntoNamespaces) {
+    for (int i = 0; i < 12; ++i) {
+        std::ofstream file(sourceDir / ("widget" + std::to_string(i) + ".h"));
+        file << "namespace app {\nclass Widget" << i << " {\npublic:\n    int size() const;\n};\n"
+             << "int helper" << i << "(int a);\n}\n";
+    }
+
+    APIDocExtractor serial;
+    serial.setMaxWorkers(1);
+    ASSERT_TRUE(serial.extractFromDirectory(sourceDir));
+
+    APIDocExtractor parallel;
+    parallel.setMaxWorkers(4);
+    ASSERT_TRUE(parallel.extractFromDirectory(sourceDir));
+
+    EXPECT_EQ(parallel.generateMarkdownAPI(), serial.generateMarkdownAPI());
+    EXPECT_EQ(parallel.getParsedFileCount(), 13u);
+
+    auto namespaces = parallel.getNamespaces();
+    ASSERT_EQ(namespaces.size(), 1u);
+    EXPECT_EQ(namespaces[0].name, "app");
+    EXPECT_EQ(namespaces[0].classes.size(), 12u);
+    EXPECT_EQ(namespaces[0].functions.size(), 12u);
+}
+
+TEST_F(DocGeneratorTest, ExtractorSkipsUnchangedHeadersWithCache) {
+    auto cacheFile = testDir / ".cache" / "api_docs.cbor";
+    {
+        std::ofstream file(sourceDir / "other.h");
+        file << "class Other {\n};\n";
+    }
+
+    APIDocExtractor first;
+    first.setCacheFile(cacheFile);
+    ASSERT_TRUE(first.extractFromDirectory(sourceDir));
+    EXPECT_EQ(first.getParsedFileCount(), 2u);
+    EXPECT_EQ(first.getCachedFileCount(), 0u);
+    ASSERT_TRUE(std::filesystem::exists(cacheFile));
+
+    APIDocExtractor second;
+    second.setCacheFile(cacheFile);
+    ASSERT_TRUE(second.extractFromDirectory(sourceDir));
+    EXPECT_EQ(second.getParsedFileCount(), 0u);
+    EXPECT_EQ(second.getCachedFileCount(), 2u);
+    EXPECT_EQ(second.generateMarkdownAPI(), first.generateMarkdownAPI());
+
+    // Only the edited header is parsed again
+    {
+        std::ofstream file(sourceDir / "other.h");
+        file << "class Renamed {\n    void run();\n};\n";
+    }
+    std::filesystem::last_write_time(
+            sourceDir / "other.h",
+            std::filesystem::last_write_time(sourceDir / "test_class.h") + std::chrono::seconds(5));
+    APIDocExtractor third;
+    third.setCacheFile(cacheFile);
+    ASSERT_TRUE(third.extractFromDirectory(sourceDir));
+    EXPECT_EQ(third.getParsedFileCount(), 1u);
+    EXPECT_EQ(third.getCachedFileCount(), 1u);
+    EXPECT_NE(third.generateMarkdownAPI().find("Renamed"), std::string::npos);
+    EXPECT_EQ(third.generateMarkdownAPI().find("### Other"), std::string::npos);
+}
+
+TEST_F(DocGeneratorTest, ApiCacheStaysOutOfTheProjectByDefault) {
+    auto cacheDir = testDir / "config" / "cache" / "api_docs";
+    ASSERT_TRUE(docGenerator->generateAPIDocumentation(testDir));
+    EXPECT_FALSE(std::filesystem::exists(testDir / ".cache"));
+    ASSERT_TRUE(std::filesystem::exists(cacheDir));
+    EXPECT_EQ(1, std::distance(std::filesystem::directory_iterator(cacheDir),
+                               std::filesystem::directory_iterator()));
+
+    // An explicit path is taken relative to the project
+    docConfig.apiCacheFile = ".cache/api_docs.cbor";
+    docGenerator->setConfig(docConfig);
+    ASSERT_TRUE(docGenerator->generateAPIDocumentation(testDir));
+    EXPECT_TRUE(std::filesystem::exists(testDir / ".cache" / "api_docs.cbor"));
+
+    std::filesystem::remove_all(cacheDir);
+    docConfig.apiCacheFile.clear();
+    docConfig.useApiCache = false;
+    docGenerator->setConfig(docConfig);
+    ASSERT_TRUE(docGenerator->generateAPIDocumentation(testDir));
+    EXPECT_FALSE(std::filesystem::exists(cacheDir));
+}
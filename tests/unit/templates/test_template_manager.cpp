@@ -1,7 +1,9 @@
 #include <gtest/gtest.h>
 
 #include <filesystem>
+#include <sstream>
 
+#include "templates/batch_generator.h"
 #include "templates/template_manager.h"
 #include "utils/core/file_utils.h"
 
@@ -352,3 +354,64 @@ TEST_F(TemplateManagerTest, HeaderOnlyLibTemplateWithXMake) {
     EXPECT_TRUE(FileUtils::directoryExists("test-header-xmake/include"));
     EXPECT_TRUE(FileUtils::directoryExists("test-header-xmake/examples"));
 }
+
+TEST_F(TemplateManagerTest, BatchManifestLayersDefaults) {
+    CliOptions base = createBasicOptions("", TemplateType::Console);
+    auto manifest = BatchGenerator::parseManifest(R"({
+        "jobs": 3,
+        "defaults": { "templateType": "lib", "includeTests": true },
+        "projects": [
+            { "projectName": "svc-a" },
+            { "projectName": "svc-b", "templateType": "console", "includeTests": false }
+        ]
+    })",
+                                                  base);
+
+    ASSERT_TRUE(manifest.has_value());
+    EXPECT_EQ(manifest->jobs, 3u);
+    ASSERT_EQ(manifest->projects.size(), 2u);
+    EXPECT_EQ(manifest->projects[0].projectName, "svc-a");
+    EXPECT_EQ(manifest->projects[0].templateType, TemplateType::Lib);
+    EXPECT_TRUE(manifest->projects[0].includeTests);
+    EXPECT_FALSE(manifest->projects[0].initGit);
+    EXPECT_EQ(manifest->projects[1].templateType, TemplateType::Console);
+    EXPECT_FALSE(manifest->projects[1].includeTests);
+}
+
+TEST_F(TemplateManagerTest, BatchManifestRejectsInvalidEntries) {
+    CliOptions base = createBasicOptions("", TemplateType::Console);
+
+    EXPECT_FALSE(BatchGenerator::parseManifest("not json", base).has_value());
+    EXPECT_FALSE(BatchGenerator::parseManifest(R"([{ "templateType": "console" }])", base)
+                         .has_value());
+    EXPECT_FALSE(BatchGenerator::parseManifest(
+                         R"([{ "projectName": "a" }, { "projectName": "a" }])", base)
+                         .has_value());
+    EXPECT_FALSE(BatchGenerator::parseManifest(
+                         R"([{ "projectName": "a", "templateType": "bogus" }])", base)
+                         .has_value());
+}
+
+TEST_F(TemplateManagerTest, BatchGeneratesProjectsInParallel) {
+    TemplateManager manager;
+    BatchGenerator generator(manager);
+    std::vector<CliOptions> projects = {
+            createBasicOptions("batch-console", TemplateType::Console),
+            createBasicOptions("batch-lib", TemplateType::Lib),
+            createBasicOptions("batch-header", TemplateType::HeaderOnlyLib),
+    };
+
+    auto results = generator.run(projects, 2);
+
+    ASSERT_EQ(results.size(), projects.size());
+    for (size_t i = 0; i < results.size(); ++i) {
+        EXPECT_EQ(results[i].projectName, projects[i].projectName);
+        EXPECT_TRUE(results[i].success) << results[i].projectName;
+        EXPECT_TRUE(FileUtils::fileExists(projects[i].projectName + "/CMakeLists.txt"));
+    }
+
+    std::ostringstream summary;
+    BatchGenerator::printSummary(results, summary);
+    EXPECT_NE(summary.str().find("batch-lib"), std::string::npos);
+    EXPECT_NE(summary.str().find("3 of 3 projects created"), std::string::npos);
+}
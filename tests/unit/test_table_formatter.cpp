@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include "utils/ui/table_formatter.h"
 
+#include <sstream>
+
 using namespace utils;
 
 class TableFormatterTest : public ::testing::Test {
@@ -119,6 +121,76 @@ TEST_F(TableFormatterTest, DisplayWidth) {
     EXPECT_EQ(TableFormatter::getDisplayWidth("test"), 4);
     EXPECT_EQ(TableFormatter::getDisplayWidth(""), 0);
     EXPECT_EQ(TableFormatter::getDisplayWidth("hello world"), 11);
+    EXPECT_EQ(TableFormatter::getDisplayWidth("\033[1;32mok\033[0m"), 2);
+    EXPECT_EQ(TableFormatter::getDisplayWidth("\xe2\x9c\x93 done"), 6);
+}
+
+TEST_F(TableFormatterTest, StreamingMatchesRenderOnceSampled) {
+    formatter->addColumn(ColumnConfig("Name", 0));
+    formatter->addColumn(ColumnConfig("Status", 0, Alignment::Center));
+    for (int i = 0; i < 50; ++i) {
+        formatter->addRow({"project-" + std::to_string(i), i % 3 ? "ok" : "failed"});
+    }
+    std::string rendered = formatter->render();
+
+    TableFormatter streamed;
+    streamed.addColumn(ColumnConfig("Name", 0));
+    streamed.addColumn(ColumnConfig("Status", 0, Alignment::Center));
+    std::ostringstream out;
+    StreamOptions options;
+    options.sampleRows = 50;
+    streamed.beginStream(out, options);
+    for (int i = 0; i < 50; ++i) {
+        streamed.addRow({"project-" + std::to_string(i), i % 3 ? "ok" : "failed"});
+    }
+    streamed.endStream();
+
+    EXPECT_EQ(out.str(), rendered);
+    EXPECT_EQ(streamed.getStreamedRowCount(), 50u);
+    EXPECT_EQ(streamed.getRowCount(), 0u);
+}
+
+TEST_F(TableFormatterTest, StreamingWritesRowsAsTheyAreAdded) {
+    formatter->addColumn(ColumnConfig("Name", 8));
+    std::ostringstream out;
+    StreamOptions options;
+    options.widthPolicy = StreamWidthPolicy::Fixed;
+    formatter->beginStream(out, options);
+
+    // Header is out before any row; each row is written by addRow itself
+    EXPECT_NE(out.str().find("Name"), std::string::npos);
+    formatter->addRow({"first"});
+    EXPECT_NE(out.str().find("first"), std::string::npos);
+
+    // Later rows wider than the fixed column are truncated, not re-laid out
+    formatter->addRow({"a much longer project name"});
+    EXPECT_NE(out.str().find("a muc..."), std::string::npos);
+    EXPECT_EQ(out.str().find("longer"), std::string::npos);
+
+    formatter->endStream();
+    EXPECT_FALSE(formatter->isStreaming());
+    EXPECT_EQ(formatter->getStreamedRowCount(), 2u);
+}
+
+TEST_F(TableFormatterTest, StreamingPagesAndStopsOnQuit) {
+    formatter->addColumn(ColumnConfig("Row", 6));
+    std::ostringstream out;
+    std::istringstream answers("\nq\n");
+    StreamOptions options;
+    options.widthPolicy = StreamWidthPolicy::Fixed;
+    options.pageHeight = 6;
+    options.pageInput = &answers;
+    formatter->beginStream(out, options);
+    for (int i = 0; i < 100; ++i) {
+        formatter->addRow({"row" + std::to_string(i)});
+    }
+    formatter->endStream();
+
+    // Head (3 lines) + 2 rows, then 5 rows per page until "q"
+    EXPECT_TRUE(formatter->isStreamQuit());
+    EXPECT_EQ(formatter->getStreamedRowCount(), 7u);
+    EXPECT_NE(out.str().find("row6"), std::string::npos);
+    EXPECT_EQ(out.str().find("row7"), std::string::npos);
 }
 
 // Test utility functions
@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "utils/archive/archive_utils.h"
+#include "utils/core/file_utils.h"
+#include "utils/core/process_runner.h"
+#include "utils/core/tool_registry.h"
+
+using namespace utils;
+
+class ArchiveExtractorTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        testDir = std::filesystem::temp_directory_path() / "cpp_scaffold_archive_extractor_test";
+        std::filesystem::create_directories(testDir);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(testDir);
+    }
+
+    std::filesystem::path testDir;
+};
+
+#ifndef _WIN32
+namespace {
+void writeScript(const std::filesystem::path& path, const std::string& body) {
+    std::ofstream(path) << "#!/bin/sh\n" << body << "\n";
+    std::filesystem::permissions(path, std::filesystem::perms::owner_all);
+}
+
+// Minimal ustar writer, so malformed archives can be produced on purpose
+void appendTarEntry(std::string& tar, const std::string& name, const std::string& content,
+                    char type = '0', const std::string& linkName = "") {
+    std::string header(512, '\0');
+    name.copy(&header[0], std::min<size_t>(name.size(), 100));
+    std::snprintf(&header[100], 8, "%07o", 0644);
+    std::snprintf(&header[124], 12, "%011o", static_cast<unsigned>(content.size()));
+    header[156] = type;
+    linkName.copy(&header[157], std::min<size_t>(linkName.size(), 100));
+    std::memcpy(&header[257], "ustar", 6);
+    std::memset(&header[148], ' ', 8);
+    unsigned sum = 0;
+    for (unsigned char c : header) {
+        sum += c;
+    }
+    std::snprintf(&header[148], 8, "%06o", sum);
+    tar += header;
+    tar += content;
+    tar.append((512 - content.size() % 512) % 512, '\0');
+}
+}  // namespace
+
+TEST_F(ArchiveExtractorTest, StripsSingleRootDirectory) {
+    auto source = testDir / "src" / "proj-1.0";
+    std::filesystem::create_directories(source / "src");
+    std::ofstream(source / "CMakeLists.txt") << "project(demo)\n";
+    std::ofstream(source / "src" / "main.cpp") << std::string(200000, 'x');
+    writeScript(source / "run.sh", "echo run");
+    std::filesystem::create_symlink("CMakeLists.txt", source / "link.txt");
+
+    std::vector<std::pair<std::filesystem::path, std::vector<std::string>>> archives = {
+            {testDir / "proj.tar.gz", {"tar", "-czf", (testDir / "proj.tar.gz").string(), "-C",
+                                       (testDir / "src").string(), "proj-1.0"}},
+            {testDir / "proj.tar", {"tar", "-cf", (testDir / "proj.tar").string(), "-C",
+                                    (testDir / "src").string(), "proj-1.0"}}};
+    if (ToolRegistry::getInstance().isAvailable("zip")) {
+        ProcessOptions inSource;
+        inSource.workingDirectory = testDir / "src";
+        ASSERT_TRUE(ProcessRunner::run({"zip", "-qry", (testDir / "proj.zip").string(), "proj-1.0"},
+                                       inSource)
+                            .success());
+        archives.push_back({testDir / "proj.zip", {}});
+    }
+
+    for (const auto& [archive, command] : archives) {
+        SCOPED_TRACE(archive.filename().string());
+        if (!command.empty()) {
+            ASSERT_TRUE(ProcessRunner::run(command).success());
+        }
+
+        size_t lastProgress = 0;
+        size_t progressTotal = 0;
+        ArchiveUtils::ExtractOptions options;
+        options.stripSingleRoot = true;
+        options.progressCallback = [&](size_t current, size_t total) {
+            lastProgress = current;
+            progressTotal = total;
+            return true;
+        };
+        auto target = testDir / ("out_" + archive.filename().string());
+        auto result = ArchiveUtils::extractArchive(archive, target, options);
+        ASSERT_TRUE(result.success) << result.errorMessage;
+
+        EXPECT_EQ(4u, result.totalFiles);
+        EXPECT_EQ("project(demo)\n", FileUtils::readFromFile((target / "CMakeLists.txt").string()));
+        EXPECT_EQ(200000u, std::filesystem::file_size(target / "src" / "main.cpp"));
+        EXPECT_NE(std::filesystem::perms::none,
+                  std::filesystem::status(target / "run.sh").permissions() &
+                          std::filesystem::perms::owner_exec);
+        EXPECT_TRUE(std::filesystem::is_symlink(target / "link.txt"));
+        EXPECT_FALSE(std::filesystem::exists(target / "proj-1.0"));
+        EXPECT_EQ(std::filesystem::file_size(archive), progressTotal);
+        EXPECT_EQ(progressTotal, lastProgress);
+
+        auto listing = ArchiveUtils::listArchiveContents(archive);
+        EXPECT_NE(listing.end(), std::find(listing.begin(), listing.end(), "proj-1.0/src/main.cpp"));
+        EXPECT_TRUE(ArchiveUtils::validateArchive(archive));
+    }
+}
+
+TEST_F(ArchiveExtractorTest, RejectsUnsafeEntries) {
+    std::string tar;
+    appendTarEntry(tar, "a/ok.txt", "ok");
+    appendTarEntry(tar, "b/ok.txt", "ok");
+    tar.append(1024, '\0');
+    auto archive = testDir / "mixed.tar";
+    std::ofstream(archive, std::ios::binary) << tar;
+
+    // Entries outside the first directory: nothing is stripped after all
+    ArchiveUtils::ExtractOptions options;
+    options.stripSingleRoot = true;
+    auto result = ArchiveUtils::extractArchive(archive, testDir / "mixed", options);
+    ASSERT_TRUE(result.success) << result.errorMessage;
+    EXPECT_TRUE(std::filesystem::exists(testDir / "mixed" / "a" / "ok.txt"));
+    EXPECT_TRUE(std::filesystem::exists(testDir / "mixed" / "b" / "ok.txt"));
+
+    tar.clear();
+    appendTarEntry(tar, "ok.txt", "ok");
+    appendTarEntry(tar, "sub/../../escaped.txt", "evil");
+    tar.append(1024, '\0');
+    archive = testDir / "evil.tar";
+    std::ofstream(archive, std::ios::binary) << tar;
+
+    result = ArchiveUtils::extractArchive(archive, testDir / "evil");
+    EXPECT_FALSE(result.success);
+    EXPECT_FALSE(std::filesystem::exists(testDir / "escaped.txt"));
+    EXPECT_FALSE(ArchiveUtils::validateArchive(archive));
+
+    // Each link is lexically inside the target, but chained they lead out of it
+    tar.clear();
+    appendTarEntry(tar, "d1", "", '2', ".");
+    appendTarEntry(tar, "d1/d2/l", "", '2', "../..");
+    appendTarEntry(tar, "d2/l/escaped/pwned.txt", "evil");
+    tar.append(1024, '\0');
+    archive = testDir / "chained.tar";
+    std::ofstream(archive, std::ios::binary) << tar;
+    result = ArchiveUtils::extractArchive(archive, testDir / "box" / "out");
+    EXPECT_FALSE(result.success);
+    EXPECT_FALSE(std::filesystem::exists(testDir / "box" / "escaped"));
+
+    // A link whose target only escapes once an earlier link is followed
+    tar.clear();
+    appendTarEntry(tar, "a/", "", '5');
+    appendTarEntry(tar, "a/b", "", '2', "..");
+    appendTarEntry(tar, "c", "", '2', "a/b/..");
+    tar.append(1024, '\0');
+    archive = testDir / "through.tar";
+    std::ofstream(archive, std::ios::binary) << tar;
+    EXPECT_FALSE(ArchiveUtils::extractArchive(archive, testDir / "through").success);
+    EXPECT_FALSE(std::filesystem::is_symlink(testDir / "through" / "c"));
+
+    // Hard link sources are not read through links either
+    tar.clear();
+    appendTarEntry(tar, "ok.txt", "ok");
+    appendTarEntry(tar, "up", "", '2', ".");
+    appendTarEntry(tar, "copy.txt", "", '1', "up/ok.txt");
+    tar.append(1024, '\0');
+    archive = testDir / "hardlink.tar";
+    std::ofstream(archive, std::ios::binary) << tar;
+    EXPECT_FALSE(ArchiveUtils::extractArchive(archive, testDir / "hardlink").success);
+    EXPECT_FALSE(std::filesystem::exists(testDir / "hardlink" / "copy.txt"));
+
+    EXPECT_TRUE(ArchiveUtils::isSafePath("dir/../file", testDir));
+    EXPECT_FALSE(ArchiveUtils::isSafePath("../file", testDir));
+    EXPECT_FALSE(ArchiveUtils::isSafePath("/etc/passwd", testDir));
+    EXPECT_EQ("dir/file", ArchiveUtils::sanitizePath("./dir\\file"));
+    EXPECT_EQ("root/", ArchiveUtils::findCommonRoot({"root/", "root/a", "root/b/c"}));
+    EXPECT_FALSE(ArchiveUtils::findCommonRoot({"root/a", "other/b"}).has_value());
+
+    // Cancelling from the progress callback stops extraction
+    options = {};
+    options.progressCallback = [](size_t, size_t) { return false; };
+    EXPECT_FALSE(ArchiveUtils::extractArchive(testDir / "mixed.tar", testDir / "cancelled", options)
+                         .success);
+}
+#endif
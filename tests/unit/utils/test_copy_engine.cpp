@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <string>
+
+#include "utils/core/copy_engine.h"
+#include "utils/core/file_utils.h"
+
+using namespace utils;
+
+class CopyEngineTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        testDir = std::filesystem::temp_directory_path() / "cpp_scaffold_copy_engine_test";
+        std::filesystem::create_directories(testDir);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(testDir);
+    }
+
+    std::filesystem::path testDir;
+};
+
+TEST_F(CopyEngineTest, CopiesTreesInParallel) {
+    auto source = testDir / "tree";
+    for (int d = 0; d < 6; ++d) {
+        for (int f = 0; f < 10; ++f) {
+            auto path = source / ("dir" + std::to_string(d)) / "nested" / ("f" + std::to_string(f));
+            FileUtils::writeToFile(path.string(), std::string(static_cast<size_t>(f) * 1000, 'x'));
+        }
+    }
+    FileUtils::writeToFile((source / "big.bin").string(), std::string(300 * 1024, 'b'));
+#ifndef _WIN32
+    // A file link is copied as a file; directory links are recreated, never followed
+    std::filesystem::create_symlink("big.bin", source / "link");
+    std::filesystem::create_directory_symlink("dir0", source / "dirlink");
+    std::filesystem::permissions(source / "big.bin", std::filesystem::perms::owner_exec,
+                                 std::filesystem::perm_options::add);
+#endif
+
+    auto copy = testDir / "copy";
+    CopyReport report = CopyEngine(FileOptions{}, 4).copyTree(source, copy);
+    ASSERT_TRUE(report.success()) << report.failures.front().second;
+#ifndef _WIN32
+    size_t files = 62;
+    size_t links = 1;
+#else
+    size_t files = 61;
+    size_t links = 0;
+#endif
+    EXPECT_EQ(files, report.files);
+    EXPECT_EQ(links, report.symlinks);
+    EXPECT_EQ(13u, report.directories);
+    EXPECT_EQ(0u, report.count(CopyMethod::HardLink));
+    EXPECT_EQ((files - 60) * 300 * 1024 + 6 * 45000, report.bytes);
+    EXPECT_EQ(std::string(9000, 'x'),
+              FileUtils::readFromFile((copy / "dir5" / "nested" / "f9").string()));
+    EXPECT_EQ(FileUtils::readFromFile((source / "big.bin").string()),
+              FileUtils::readFromFile((copy / "big.bin").string()));
+#ifndef _WIN32
+    EXPECT_TRUE(std::filesystem::is_symlink(copy / "dirlink"));
+    EXPECT_FALSE(std::filesystem::is_symlink(copy / "link"));
+    EXPECT_NE(std::filesystem::perms::none, std::filesystem::status(copy / "big.bin").permissions() &
+                                                    std::filesystem::perms::owner_exec);
+#endif
+
+    // Copies are independent of the source
+    FileUtils::writeToFile((source / "big.bin").string(), "changed");
+    EXPECT_EQ(300u * 1024, std::filesystem::file_size(copy / "big.bin"));
+
+    // Existing files are kept when overwriting is off
+    FileOptions keep;
+    keep.overwriteExisting = false;
+    report = CopyEngine(keep).copyTree(source, copy);
+    EXPECT_TRUE(report.success());
+    EXPECT_EQ(files + links, report.skipped);
+    EXPECT_EQ(300u * 1024, std::filesystem::file_size(copy / "big.bin"));
+
+    EXPECT_FALSE(FileUtils::copyDirectoryEx(source, source / "dir0" / "inside"));
+    EXPECT_FALSE(FileUtils::copyDirectoryEx(testDir / "missing", testDir / "out"));
+}
+
+TEST_F(CopyEngineTest, LinksOnlyWhenAllowed) {
+    auto source = testDir / "original.txt";
+    FileUtils::writeToFile(source.string(), "original");
+
+    CopyEngine linking([] {
+        FileOptions options;
+        options.allowHardLinks = true;
+        return options;
+    }());
+    CopyMethod method = CopyMethod::Buffered;
+    std::string error;
+    ASSERT_TRUE(linking.copyFile(source, testDir / "linked.txt", method, error)) << error;
+    if (method == CopyMethod::HardLink) {
+        EXPECT_EQ(2u, std::filesystem::hard_link_count(source));
+    } else {
+        EXPECT_EQ(CopyMethod::Clone, method);
+    }
+    EXPECT_EQ("original", FileUtils::readFromFile((testDir / "linked.txt").string()));
+
+    // Copying onto a link of itself breaks the link instead of truncating the source
+    ASSERT_TRUE(FileUtils::copyFileEx(source, testDir / "linked.txt"));
+    EXPECT_EQ("original", FileUtils::readFromFile(source.string()));
+    EXPECT_EQ(1u, std::filesystem::hard_link_count(source));
+    EXPECT_FALSE(FileUtils::copyFileEx(source, source));
+    EXPECT_EQ("original", FileUtils::readFromFile(source.string()));
+
+    // Backups are real copies
+    ASSERT_TRUE(FileUtils::createBackup(source));
+    FileUtils::writeToFile(source.string(), "edited");
+    EXPECT_EQ("original", FileUtils::readFromFile(source.string() + ".bak"));
+
+    FileOptions backupFirst;
+    backupFirst.backupExisting = true;
+    FileUtils::writeToFile((testDir / "new.txt").string(), "new");
+    ASSERT_TRUE(FileUtils::copyFileEx(testDir / "new.txt", source, backupFirst));
+    EXPECT_EQ("new", FileUtils::readFromFile(source.string()));
+    EXPECT_EQ("edited", FileUtils::readFromFile(source.string() + ".bak"));
+
+    FileOptions noOverwrite;
+    noOverwrite.overwriteExisting = false;
+    EXPECT_FALSE(FileUtils::copyFileEx(testDir / "new.txt", source, noOverwrite));
+    EXPECT_FALSE(FileUtils::copyFileEx(testDir / "missing.txt", testDir / "out.txt"));
+}
@@ -0,0 +1,246 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "utils/core/file_utils.h"
+#include "utils/core/hash_utils.h"
+#include "utils/core/string_utils.h"
+#include "utils/core/tool_registry.h"
+#include "utils/external/download_cache.h"
+
+using namespace utils;
+
+class DownloadCacheTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        testDir = std::filesystem::temp_directory_path() / "cpp_scaffold_download_cache_test";
+        std::filesystem::create_directories(testDir);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(testDir);
+    }
+
+    std::filesystem::path testDir;
+};
+
+TEST_F(DownloadCacheTest, Sha256MatchesKnownDigests) {
+    EXPECT_EQ("e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855",
+              Sha256::toHex(Sha256::hash("")));
+    EXPECT_EQ("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad",
+              Sha256::toHex(Sha256::hash("abc")));
+
+    // Fed in uneven pieces across block boundaries
+    std::string data(1000, 'a');
+    Sha256 incremental;
+    for (size_t offset = 0; offset < data.size(); offset += 37) {
+        incremental.update(std::string_view(data).substr(offset, 37));
+    }
+    EXPECT_EQ(Sha256::toHex(Sha256::hash(data)), Sha256::toHex(incremental.finish()));
+    EXPECT_EQ("41edece42d63e8d9bf515a9ba6932e1c20cbc9f5a5d134645adb5db1b9737ea3",
+              Sha256::toHex(Sha256::hash(data)));
+}
+
+#ifndef _WIN32
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+// Local stand-in for an archive server: serves fixed bodies with an ETag and
+// answers If-None-Match with 304, one connection at a time
+class LocalHttpServer {
+   public:
+    LocalHttpServer() {
+        listener_ = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t length = sizeof(address);
+        if (bind(listener_, reinterpret_cast<sockaddr*>(&address), length) != 0 ||
+            listen(listener_, 8) != 0 ||
+            getsockname(listener_, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+            close(listener_);
+            listener_ = -1;
+            return;
+        }
+        port_ = ntohs(address.sin_port);
+        thread_ = std::thread([this] { serve(); });
+    }
+
+    ~LocalHttpServer() {
+        stop();
+    }
+
+    void stop() {
+        if (listener_ >= 0) {
+            shutdown(listener_, SHUT_RDWR);
+            close(listener_);
+            listener_ = -1;
+        }
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+
+    bool running() const {
+        return listener_ >= 0;
+    }
+
+    std::string url(const std::string& path) const {
+        return "http://127.0.0.1:" + std::to_string(port_) + path;
+    }
+
+    void setBody(const std::string& path, const std::string& body) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        bodies_[path] = body;
+    }
+
+    int requests() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return requests_;
+    }
+
+    int notModified() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return notModified_;
+    }
+
+   private:
+    void serve() {
+        while (true) {
+            int client = accept(listener_, nullptr, nullptr);
+            if (client < 0) {
+                return;
+            }
+            std::string request;
+            char buffer[4096];
+            while (request.find("\r\n\r\n") == std::string::npos) {
+                ssize_t n = recv(client, buffer, sizeof(buffer), 0);
+                if (n <= 0) {
+                    break;
+                }
+                request.append(buffer, static_cast<size_t>(n));
+            }
+            std::string response = respond(request);
+            send(client, response.data(), response.size(), MSG_NOSIGNAL);
+            close(client);
+        }
+    }
+
+    std::string respond(const std::string& request) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++requests_;
+        size_t start = request.find(' ') + 1;
+        std::string path = request.substr(start, request.find(' ', start) - start);
+        auto it = bodies_.find(path);
+        if (it == bodies_.end()) {
+            return "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+        }
+        std::string etag = "\"" + Sha256::toHex(Sha256::hash(it->second)).substr(0, 16) + "\"";
+        if (request.find("If-None-Match: " + etag + "\r\n") != std::string::npos) {
+            ++notModified_;
+            return "HTTP/1.1 304 Not Modified\r\nETag: " + etag + "\r\nConnection: close\r\n\r\n";
+        }
+        return "HTTP/1.1 200 OK\r\nETag: " + etag +
+               "\r\nContent-Length: " + std::to_string(it->second.size()) +
+               "\r\nConnection: close\r\n\r\n" + it->second;
+    }
+
+    int listener_ = -1;
+    int port_ = 0;
+    std::thread thread_;
+    std::mutex mutex_;
+    std::map<std::string, std::string> bodies_;
+    int requests_ = 0;
+    int notModified_ = 0;
+};
+}  // namespace
+
+TEST_F(DownloadCacheTest, RevalidatesAndServesOffline) {
+    if (!ToolRegistry::getInstance().isAvailable("curl")) {
+        GTEST_SKIP() << "curl is not available";
+    }
+    LocalHttpServer server;
+    ASSERT_TRUE(server.running());
+    server.setBody("/template.tar.gz", "first version");
+    std::string url = server.url("/template.tar.gz");
+
+    DownloadCache cache(testDir / "cache");
+    auto first = cache.fetch(url);
+    ASSERT_TRUE(first.success) << first.errorMessage;
+    EXPECT_FALSE(first.fromCache);
+    EXPECT_EQ(StringUtils::calculateSHA256("first version"), first.sha256);
+    EXPECT_EQ(".tar.gz", first.path.string().substr(first.path.string().size() - 7));
+    EXPECT_EQ("first version", FileUtils::readFromFile(first.path.string()));
+
+    // Unchanged on the server: a 304, no second copy
+    auto second = cache.fetch(url);
+    ASSERT_TRUE(second.success) << second.errorMessage;
+    EXPECT_TRUE(second.fromCache);
+    EXPECT_EQ(first.path, second.path);
+    EXPECT_EQ(1, server.notModified());
+
+    // Changed on the server: the new content replaces the old for this URL
+    server.setBody("/template.tar.gz", "second version");
+    auto third = cache.fetch(url);
+    ASSERT_TRUE(third.success) << third.errorMessage;
+    EXPECT_FALSE(third.fromCache);
+    EXPECT_EQ("second version", FileUtils::readFromFile(third.path.string()));
+
+    // Offline mode never contacts the server
+    int requestsBefore = server.requests();
+    DownloadCache::Settings offline;
+    offline.offline = true;
+    DownloadCache offlineCache(testDir / "cache", offline);
+    auto cached = offlineCache.fetch(url);
+    ASSERT_TRUE(cached.success) << cached.errorMessage;
+    EXPECT_EQ(third.path, cached.path);
+    EXPECT_FALSE(offlineCache.fetch(server.url("/other.zip")).success);
+    EXPECT_EQ(requestsBefore, server.requests());
+
+    // An unreachable server falls back to the cached copy
+    server.stop();
+    auto stale = cache.fetch(url);
+    ASSERT_TRUE(stale.success) << stale.errorMessage;
+    EXPECT_TRUE(stale.stale);
+    EXPECT_EQ(third.path, stale.path);
+}
+
+TEST_F(DownloadCacheTest, EvictsLeastRecentlyUsed) {
+    if (!ToolRegistry::getInstance().isAvailable("curl")) {
+        GTEST_SKIP() << "curl is not available";
+    }
+    LocalHttpServer server;
+    ASSERT_TRUE(server.running());
+    for (const char* name : {"/a.zip", "/b.zip", "/c.zip"}) {
+        server.setBody(name, std::string(1000, name[1]));
+    }
+    // Same content under another URL is stored once
+    server.setBody("/a-mirror.zip", std::string(1000, 'a'));
+
+    DownloadCache::Settings settings;
+    settings.maxBytes = 2500;
+    DownloadCache cache(testDir / "cache", settings);
+
+    auto a = cache.fetch(server.url("/a.zip"));
+    auto mirror = cache.fetch(server.url("/a-mirror.zip"));
+    ASSERT_TRUE(a.success && mirror.success);
+    EXPECT_EQ(a.path, mirror.path);
+    EXPECT_EQ(1000u, cache.totalSize());
+
+    ASSERT_TRUE(cache.fetch(server.url("/b.zip")).success);
+    // Touch "a" so "b" becomes the oldest
+    ASSERT_TRUE(cache.fetch(server.url("/a.zip")).fromCache);
+    ASSERT_TRUE(cache.fetch(server.url("/c.zip")).success);
+
+    EXPECT_FALSE(cache.lookup(server.url("/b.zip")).has_value());
+    EXPECT_TRUE(cache.lookup(server.url("/a.zip")).has_value());
+    EXPECT_TRUE(cache.lookup(server.url("/c.zip")).has_value());
+    EXPECT_LE(cache.totalSize(), settings.maxBytes);
+}
+#endif
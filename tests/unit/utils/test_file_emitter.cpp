@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+
+#include "utils/core/file_emitter.h"
+#include "utils/core/file_utils.h"
+
+using namespace utils;
+
+class FileEmitterTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        testDir = std::filesystem::temp_directory_path() / "cpp_scaffold_file_emitter_test";
+        std::filesystem::create_directories(testDir);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(testDir);
+    }
+
+    std::filesystem::path testDir;
+};
+
+TEST_F(FileEmitterTest, WritesBatchConcurrently) {
+    FileEmitter emitter;
+    emitter.enqueueDirectory(testDir / "proj" / "empty");
+    for (int i = 0; i < 32; ++i) {
+        auto dir = testDir / "proj" / ("dir" + std::to_string(i % 4));
+        emitter.enqueueFile(dir / ("file" + std::to_string(i) + ".txt"),
+                            "content " + std::to_string(i));
+    }
+    emitter.enqueueFile(testDir / "proj" / "rendered.txt", [] { return std::string("rendered"); });
+    EXPECT_EQ(33u, emitter.pendingFileCount());
+
+    auto report = emitter.flush(4);
+    EXPECT_TRUE(report.success());
+    EXPECT_EQ(33u, report.writtenFiles.size());
+    // proj, proj/empty and proj/dir0..dir3 are new
+    EXPECT_EQ(6u, report.createdDirectories.size());
+    EXPECT_TRUE(emitter.empty());
+
+    EXPECT_TRUE(std::filesystem::is_directory(testDir / "proj" / "empty"));
+    EXPECT_EQ("content 5",
+              FileUtils::readFromFile((testDir / "proj" / "dir1" / "file5.txt").string()));
+    EXPECT_EQ("rendered", FileUtils::readFromFile((testDir / "proj" / "rendered.txt").string()));
+}
+
+TEST_F(FileEmitterTest, ReportsFailures) {
+    // A regular file where a directory is expected makes the tree creation fail
+    std::string blocker = (testDir / "blocker").string();
+    ASSERT_TRUE(FileUtils::writeToFile(blocker, "x"));
+
+    FileEmitter emitter;
+    emitter.enqueueFile(testDir / "blocker" / "child.txt", "data");
+    auto report = emitter.flush();
+    EXPECT_FALSE(report.success());
+    EXPECT_TRUE(report.writtenFiles.empty());
+
+    // A throwing renderer fails only its own file
+    emitter.enqueueFile(testDir / "ok.txt", "ok");
+    emitter.enqueueFile(testDir / "renderer_throws.txt",
+                        []() -> std::string { throw std::runtime_error("boom"); });
+    report = emitter.flush();
+    ASSERT_EQ(1u, report.failures.size());
+    EXPECT_EQ("boom", report.failures[0].second);
+    ASSERT_EQ(1u, report.writtenFiles.size());
+    EXPECT_FALSE(std::filesystem::exists(testDir / "renderer_throws.txt"));
+}
@@ -167,3 +167,77 @@ TEST_F(FileUtilsTest, ReadFromNonExistentFile) {
     std::string content = FileUtils::readFromFile(filePath);
     EXPECT_TRUE(content.empty());
 }
+
+TEST_F(FileUtilsTest, MappedFileMapsLargeFilesAndReadsSmallOnes) {
+    auto small = testDir / "small.txt";
+    FileUtils::writeToFile(small.string(), "short");
+    auto smallFile = MappedFile::open(small);
+    ASSERT_TRUE(smallFile) << smallFile.message;
+    EXPECT_FALSE(smallFile.value.isMapped());
+    EXPECT_EQ("short", smallFile.value.view());
+
+    // Moving keeps the view valid even when the buffer lived inside the string
+    MappedFile moved = std::move(smallFile.value);
+    EXPECT_EQ("short", moved.view());
+    EXPECT_TRUE(smallFile.value.empty());
+
+    auto large = testDir / "large.txt";
+    std::string content;
+    while (content.size() < MappedFile::MIN_MAP_SIZE * 2) {
+        content += "line " + std::to_string(content.size()) + "\n";
+    }
+    content += "no newline";
+    FileUtils::writeToFile(large.string(), content);
+    auto largeFile = MappedFile::open(large);
+    ASSERT_TRUE(largeFile) << largeFile.message;
+#ifndef _WIN32
+    EXPECT_TRUE(largeFile.value.isMapped());
+#endif
+    EXPECT_EQ(content, largeFile.value.view());
+    EXPECT_EQ(content, FileUtils::readFromFile(large.string()));
+
+    auto lines = FileUtils::countLines(large);
+    ASSERT_TRUE(lines);
+    EXPECT_EQ(static_cast<size_t>(std::count(content.begin(), content.end(), '\n')) + 1,
+              lines.value);
+    EXPECT_EQ(lines.value, FileUtils::readLines(large.string()).size());
+    EXPECT_EQ("no newline", FileUtils::readLines(large.string()).back());
+
+    auto missing = MappedFile::open(testDir / "missing.txt");
+    EXPECT_FALSE(missing);
+    EXPECT_FALSE(FileUtils::countLines(testDir / "missing.txt"));
+}
+
+TEST_F(FileUtilsTest, ContentHelpersWorkOnWholeFiles) {
+    auto path = testDir / "lines.txt";
+    ASSERT_TRUE(FileUtils::writeLines(path, {"alpha", "beta", "alpha beta"}));
+    EXPECT_EQ("alpha\nbeta\nalpha beta\n", FileUtils::readFromFile(path.string()));
+    EXPECT_EQ(3u, FileUtils::countLines(path).value);
+    EXPECT_EQ(0u, FileUtils::countLines(std::string_view()));
+    EXPECT_EQ(2u, FileUtils::countLines(std::string_view("a\r\nb")));
+
+    auto replaced = FileUtils::replaceInFile(path, "alpha", "gamma");
+    ASSERT_TRUE(replaced);
+    EXPECT_TRUE(replaced.value);
+    EXPECT_EQ("gamma\nbeta\ngamma beta\n", FileUtils::readFromFile(path.string()));
+    EXPECT_EQ((std::vector<std::string>{"gamma", "beta", "gamma beta"}),
+              FileUtils::readLines(path.string()));
+
+    auto unchanged = FileUtils::replaceInFile(path, "delta", "x");
+    ASSERT_TRUE(unchanged);
+    EXPECT_FALSE(unchanged.value);
+    EXPECT_FALSE(FileUtils::replaceInFile(path, "", "x"));
+
+    FileUtils::writeToFile((testDir / "sub" / "one.cpp").string(), "");
+    FileUtils::writeToFile((testDir / "sub" / "two.hpp").string(), "");
+    auto found = FileUtils::findFiles(testDir, "*.?pp");
+    ASSERT_TRUE(found);
+    std::vector<std::string> names;
+    for (const auto& file : found.value) {
+        names.push_back(file.filename().string());
+    }
+    std::sort(names.begin(), names.end());
+    EXPECT_EQ((std::vector<std::string>{"one.cpp", "two.hpp"}), names);
+    EXPECT_FALSE(FileUtils::findFiles(testDir / "missing", "*"));
+}
+
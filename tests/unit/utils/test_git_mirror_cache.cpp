@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "utils/core/file_utils.h"
+#include "utils/core/process_runner.h"
+#include "utils/core/string_utils.h"
+#include "utils/core/tool_registry.h"
+#include "utils/external/git_mirror_cache.h"
+
+using namespace utils;
+
+class GitMirrorCacheTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        testDir = std::filesystem::temp_directory_path() / "cpp_scaffold_git_mirror_cache_test";
+        std::filesystem::create_directories(testDir);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(testDir);
+    }
+
+    std::filesystem::path testDir;
+};
+
+#ifndef _WIN32
+TEST_F(GitMirrorCacheTest, ServesPinnedRevisionsLocally) {
+    if (!ToolRegistry::getInstance().isAvailable("git")) {
+        GTEST_SKIP() << "git is not available";
+    }
+    auto origin = testDir / "origin";
+    std::filesystem::create_directories(origin);
+    auto git = [&](std::vector<std::string> args) {
+        std::vector<std::string> command = {"git", "-c", "user.name=Test", "-c",
+                                            "user.email=test@example.com"};
+        command.insert(command.end(), args.begin(), args.end());
+        ProcessOptions options;
+        options.workingDirectory = origin;
+        return ProcessRunner::run(command, options).success();
+    };
+    ASSERT_TRUE(git({"init", "--quiet", "--initial-branch=main"}));
+    std::ofstream(origin / "version.txt") << "1";
+    ASSERT_TRUE(git({"add", "."}) && git({"commit", "--quiet", "-m", "v1"}) &&
+                git({"tag", "v1"}));
+
+    GitMirrorCache cache(testDir / "mirrors");
+    GitMirrorCache::CheckoutRequest request;
+    request.url = origin.string();
+    ASSERT_TRUE(cache.checkout(request, testDir / "first"));
+    EXPECT_EQ("1", FileUtils::readFromFile((testDir / "first" / "version.txt").string()));
+    EXPECT_TRUE(std::filesystem::exists(cache.mirrorPath(request.url) / "HEAD"));
+
+    // New upstream commits reach later checkouts of the default branch
+    std::ofstream(origin / "version.txt") << "2";
+    ASSERT_TRUE(git({"commit", "--quiet", "-am", "v2"}));
+    ASSERT_TRUE(cache.checkout(request, testDir / "second"));
+    EXPECT_EQ("2", FileUtils::readFromFile((testDir / "second" / "version.txt").string()));
+
+    // A tag the mirror already has is checked out without the remote
+    std::filesystem::rename(origin, testDir / "origin-gone");
+    request.tag = "v1";
+    request.keepHistory = true;
+    ASSERT_TRUE(cache.checkout(request, testDir / "pinned"));
+    EXPECT_EQ("1", FileUtils::readFromFile((testDir / "pinned" / "version.txt").string()));
+
+    // A kept history stands on its own and points at the real remote
+    EXPECT_FALSE(
+            std::filesystem::exists(testDir / "pinned" / ".git" / "objects" / "info" / "alternates"));
+    ProcessOptions inPinned;
+    inPinned.workingDirectory = testDir / "pinned";
+    auto remote = ProcessRunner::run({"git", "remote", "get-url", "origin"}, inPinned);
+    EXPECT_EQ(request.url, StringUtils::trim(remote.output));
+
+    // Unknown revisions fail once the remote cannot be asked
+    request.tag = "v9";
+    EXPECT_FALSE(cache.checkout(request, testDir / "missing"));
+}
+#endif
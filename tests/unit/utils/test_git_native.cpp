@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "utils/core/hash_utils.h"
+#include "utils/core/process_runner.h"
+#include "utils/core/tool_registry.h"
+#include "utils/external/git_native.h"
+#include "utils/external/git_utils.h"
+
+using namespace utils;
+
+class NativeGitTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        testDir = std::filesystem::temp_directory_path() / "cpp_scaffold_git_native_test";
+        std::filesystem::create_directories(testDir);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(testDir);
+    }
+
+    std::filesystem::path testDir;
+};
+
+TEST_F(NativeGitTest, WritesGitCompatibleObjects) {
+    EXPECT_EQ("a9993e364706816aba3e25717850c26c9cd0d89d", Sha1::toHex(Sha1::hash("abc")));
+    EXPECT_EQ("84983e441c3bd26ebaae4aa1f95129e5e54670f1",
+              Sha1::toHex(Sha1::hash(
+                      "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq")));
+
+    if (!NativeGitRepository::isEnabled()) {
+        GTEST_SKIP() << "Built without zlib";
+    }
+    NativeGitRepository repo(testDir);
+    ASSERT_TRUE(repo.init());
+    EXPECT_FALSE(repo.init());
+    // Same id as "git hash-object" for this content
+    EXPECT_EQ("ce013625030ba8dba906f756967f9e9ca394464a", repo.writeObject("blob", "hello\n"));
+
+    EXPECT_TRUE(repo.setConfig("user", "name", "Test User"));
+    EXPECT_TRUE(repo.setConfig("user", "email", "test@example.com"));
+    EXPECT_TRUE(repo.setConfig("user", "name", "Other User"));
+    EXPECT_EQ("Other User", repo.getConfig("user", "name"));
+    EXPECT_EQ("test@example.com", repo.getConfig("user", "email"));
+}
+
+#ifndef _WIN32
+TEST_F(NativeGitTest, LeavesLineEndingConversionToGit) {
+    if (!NativeGitRepository::isEnabled()) {
+        GTEST_SKIP() << "Built without zlib";
+    }
+    auto workTree = testDir / "repo";
+    std::filesystem::create_directories(workTree);
+    std::ofstream(workTree / "windows.txt", std::ios::binary) << "line\r\n";
+
+    // As "git config --global core.autocrlf input" would leave it
+    auto globalConfig = testDir / "gitconfig";
+    std::ofstream(globalConfig) << "[core]\n\tautocrlf = input\n";
+    const char* previous = std::getenv("GIT_CONFIG_GLOBAL");
+    std::string saved = previous ? previous : "";
+    setenv("GIT_CONFIG_GLOBAL", globalConfig.c_str(), 1);
+
+    NativeGitRepository repo(workTree);
+    ASSERT_TRUE(repo.init());
+    ASSERT_TRUE(repo.setConfig("user", "name", "Test User"));
+    ASSERT_TRUE(repo.setConfig("user", "email", "test@example.com"));
+    bool convertedByConfig = !repo.commitWorkingTree("Initial commit").has_value();
+
+    // The repository's own setting wins over the global one
+    repo.setConfig("core", "autocrlf", "false");
+    bool committedWithoutConversion = repo.commitWorkingTree("Initial commit").has_value();
+
+    if (previous) {
+        setenv("GIT_CONFIG_GLOBAL", saved.c_str(), 1);
+    } else {
+        unsetenv("GIT_CONFIG_GLOBAL");
+    }
+    EXPECT_TRUE(convertedByConfig);
+    EXPECT_TRUE(committedWithoutConversion);
+}
+
+TEST_F(NativeGitTest, LeavesIncludedConfigToGit) {
+    if (!NativeGitRepository::isEnabled()) {
+        GTEST_SKIP() << "Built without zlib";
+    }
+    auto workTree = testDir / "repo";
+    std::filesystem::create_directories(workTree);
+    std::ofstream(workTree / "main.cpp") << "int main() {}\n";
+
+    // The included file could set init.defaultBranch, user.* or core.*
+    auto globalConfig = testDir / "gitconfig";
+    std::ofstream(testDir / "work.gitconfig") << "[init]\n\tdefaultBranch = trunk\n";
+    const char* previous = std::getenv("GIT_CONFIG_GLOBAL");
+    std::string saved = previous ? previous : "";
+    setenv("GIT_CONFIG_GLOBAL", globalConfig.c_str(), 1);
+
+    std::ofstream(globalConfig) << "[include]\n\tpath = work.gitconfig\n";
+    bool initWithInclude = NativeGitRepository(workTree).init();
+
+    // GitUtils then runs "git init", which follows the include
+    std::string fallbackHead;
+    if (ToolRegistry::getInstance().isAvailable("git")) {
+        auto fallback = testDir / "fallback";
+        std::filesystem::create_directories(fallback);
+        if (GitUtils::initializeRepository(fallback)) {
+            std::ifstream head(fallback / ".git" / "HEAD");
+            std::getline(head, fallbackHead);
+        }
+    }
+
+    std::ofstream(globalConfig) << "[includeIf \"gitdir:~/work/\"]\n\tpath = work.gitconfig\n";
+    bool initWithIncludeIf = NativeGitRepository(workTree).init();
+
+    std::ofstream(globalConfig) << "[user]\n\tname = Test User\n\temail = test@example.com\n";
+    NativeGitRepository repo(workTree);
+    bool initWithoutInclude = repo.init();
+
+    std::ofstream(globalConfig, std::ios::app) << "[include]\n\tpath = work.gitconfig\n";
+    bool committedWithInclude = repo.commitWorkingTree("Initial commit").has_value();
+
+    if (previous) {
+        setenv("GIT_CONFIG_GLOBAL", saved.c_str(), 1);
+    } else {
+        unsetenv("GIT_CONFIG_GLOBAL");
+    }
+    EXPECT_FALSE(initWithInclude);
+    if (ToolRegistry::getInstance().isAvailable("git")) {
+        EXPECT_EQ("ref: refs/heads/trunk", fallbackHead);
+    }
+    EXPECT_FALSE(initWithIncludeIf);
+    EXPECT_TRUE(initWithoutInclude);
+    EXPECT_FALSE(committedWithInclude);
+}
+
+TEST_F(NativeGitTest, CommitIsReadableByGit) {
+    if (!NativeGitRepository::isEnabled() || !ToolRegistry::getInstance().isAvailable("git")) {
+        GTEST_SKIP() << "Native git writer or git CLI unavailable";
+    }
+
+    std::filesystem::create_directories(testDir / "src" / "detail");
+    std::filesystem::create_directories(testDir / "build");
+    std::ofstream(testDir / "src" / "main.cpp") << "int main() { return 0; }\n";
+    std::ofstream(testDir / "src" / "detail" / "util.h") << "#pragma once\n";
+    std::ofstream(testDir / "src-file.txt") << "sorts between src and src/\n";
+    std::ofstream(testDir / ".gitignore") << "build/\n*.log\n!keep.log\n";
+    std::ofstream(testDir / "build" / "out.o") << "object";
+    std::ofstream(testDir / "debug.log") << "ignored";
+    std::ofstream(testDir / "keep.log") << "kept";
+    std::ofstream(testDir / "run.sh") << "#!/bin/sh\necho run\n";
+    std::filesystem::permissions(testDir / "run.sh", std::filesystem::perms::owner_all);
+
+    NativeGitRepository repo(testDir);
+    ASSERT_TRUE(repo.init());
+    ASSERT_TRUE(repo.setConfig("user", "name", "Test User"));
+    ASSERT_TRUE(repo.setConfig("user", "email", "test@example.com"));
+    auto commit = repo.commitWorkingTree("Initial commit");
+    ASSERT_TRUE(commit.has_value());
+    EXPECT_FALSE(repo.commitWorkingTree("Second").has_value());
+
+    auto git = [&](std::vector<std::string> args) {
+        args.insert(args.begin(), {"git", "-C", testDir.string()});
+        return ProcessRunner::run(args);
+    };
+    EXPECT_TRUE(git({"fsck", "--strict"}).success());
+    EXPECT_EQ(*commit + "\n", git({"rev-parse", "HEAD"}).output);
+    EXPECT_EQ(".gitignore\nkeep.log\nrun.sh\nsrc-file.txt\nsrc/detail/util.h\nsrc/main.cpp\n",
+              git({"ls-files"}).output);
+    EXPECT_EQ("", git({"status", "--porcelain"}).output);
+    EXPECT_EQ("Test User <test@example.com> Initial commit\n",
+              git({"log", "--format=%an <%ae> %s"}).output);
+    EXPECT_NE(std::string::npos,
+              git({"ls-tree", "HEAD", "run.sh"}).output.find("100755 blob"));
+}
+#endif
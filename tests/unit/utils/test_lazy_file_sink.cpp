@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include <spdlog/details/os.h>
+#include <spdlog/sinks/ostream_sink.h>
+#include <spdlog/spdlog.h>
+
+#include <filesystem>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "utils/core/forwarding_sink.h"
+#include "utils/core/lazy_file_sink.h"
+
+using namespace utils;
+
+class LazyFileSinkTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        testDir = std::filesystem::temp_directory_path() / "cpp_scaffold_lazy_file_sink_test";
+        std::filesystem::remove_all(testDir);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(testDir);
+    }
+
+    std::filesystem::path testDir;
+};
+
+TEST_F(LazyFileSinkTest, CreatesNothingUntilTheFirstMessage) {
+    auto path = testDir / "logs" / "app.log";
+    auto sink = std::make_shared<LazyRotatingFileSink>(path, 1024 * 1024, 3);
+    sink->set_level(spdlog::level::info);
+    spdlog::logger logger("lazy", sink);
+    logger.set_level(spdlog::level::trace);
+
+    // Messages below the sink's level never reach it
+    logger.debug("filtered");
+    logger.flush();
+    EXPECT_FALSE(sink->isOpen());
+    EXPECT_FALSE(std::filesystem::exists(testDir));
+
+    logger.info("first message");
+    logger.flush();
+    EXPECT_TRUE(sink->isOpen());
+    ASSERT_TRUE(std::filesystem::exists(path));
+    EXPECT_GT(std::filesystem::file_size(path), 0u);
+}
+
+TEST_F(LazyFileSinkTest, RotatesOnceTheFileIsFull) {
+    auto path = testDir / "app.log";
+    auto sink = std::make_shared<LazyRotatingFileSink>(path, 200, 2);
+    sink->set_pattern("%v");
+    spdlog::logger logger("lazy", sink);
+
+    for (int i = 0; i < 40; ++i) {
+        logger.info("line {:02} of the rotation test", i);
+    }
+    logger.flush();
+
+    EXPECT_LE(std::filesystem::file_size(path), 200u);
+    EXPECT_TRUE(std::filesystem::exists(testDir / "app.1.log"));
+    EXPECT_TRUE(std::filesystem::exists(testDir / "app.2.log"));
+    EXPECT_FALSE(std::filesystem::exists(testDir / "app.3.log"));
+}
+
+TEST_F(LazyFileSinkTest, ForwardingSinkKeepsTheOriginalMessage) {
+    std::ostringstream out;
+    auto target = std::make_shared<spdlog::logger>(
+            "target", std::make_shared<spdlog::sinks::ostream_sink_st>(out));
+    target->set_pattern("%l|%t|%v");
+    target->set_level(spdlog::level::trace);
+
+    spdlog::logger logger("front", std::make_shared<ForwardingSink>(target));
+    logger.set_level(spdlog::level::info);
+    logger.debug("filtered by the front logger");
+    logger.warn("forwarded {}", 42);
+
+    std::ostringstream thread;
+    thread << spdlog::details::os::thread_id();
+    EXPECT_EQ("warning|" + thread.str() + "|forwarded 42\n", out.str());
+}
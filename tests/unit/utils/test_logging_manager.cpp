@@ -0,0 +1,255 @@
+#include <gtest/gtest.h>
+#include "utils/core/logging_manager.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace utils;
+
+namespace {
+
+// Records every entry it is given; optionally holds the writer in write()
+// until released, so tests can fill the queue deterministically
+class CaptureDestination : public LogDestination {
+public:
+    struct Shared {
+        std::mutex mutex;
+        std::condition_variable released;
+        bool holding = false;
+        std::vector<LogEntry> entries;
+    };
+
+    explicit CaptureDestination(std::shared_ptr<Shared> shared) : shared_(std::move(shared)) {}
+
+    void write(const LogEntry& entry) override {
+        std::unique_lock<std::mutex> lock(shared_->mutex);
+        while (shared_->holding) {
+            shared_->released.wait_for(lock, std::chrono::milliseconds(10));
+        }
+        shared_->entries.push_back(entry);
+    }
+    void flush() override {}
+    void close() override {}
+    std::string getName() const override { return "Capture"; }
+
+private:
+    std::shared_ptr<Shared> shared_;
+};
+
+}  // namespace
+
+class LoggingManagerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        manager().setAsyncMode(false);
+        manager().clearDestinations();
+        manager().addDestination(std::make_unique<CaptureDestination>(captured));
+        manager().setLogLevel(LogLevel::Trace);
+        manager().setOverflowPolicy(OverflowPolicy::Drop);
+        manager().setMaxQueueSize(4096);
+        manager().resetMetrics();
+    }
+
+    void TearDown() override {
+        release();
+        manager().setAsyncMode(false);
+        manager().clearDestinations();
+        manager().addDestination(std::make_unique<ConsoleDestination>());
+        manager().setLogLevel(LogLevel::Info);
+    }
+
+    static LoggingManager& manager() { return LoggingManager::getInstance(); }
+
+    void hold() {
+        std::lock_guard<std::mutex> lock(captured->mutex);
+        captured->holding = true;
+    }
+
+    void release() {
+        {
+            std::lock_guard<std::mutex> lock(captured->mutex);
+            captured->holding = false;
+        }
+        captured->released.notify_all();
+    }
+
+    std::vector<LogEntry> entries() {
+        std::lock_guard<std::mutex> lock(captured->mutex);
+        return captured->entries;
+    }
+
+    std::shared_ptr<CaptureDestination::Shared> captured =
+            std::make_shared<CaptureDestination::Shared>();
+};
+
+TEST_F(LoggingManagerTest, AsyncEntriesCarryCompileTimeSourceLocation) {
+    manager().setAsyncMode(true);
+    int expectedLine = __LINE__ + 1;
+    LOG_INFO("hello from the test");
+    LOG_CATEGORY(LogLevel::Warning, "templates", "category message");
+    manager().flush();
+
+    auto logged = entries();
+    ASSERT_EQ(logged.size(), 2u);
+    EXPECT_EQ(logged[0].message, "hello from the test");
+    EXPECT_EQ(logged[0].level, LogLevel::Info);
+    EXPECT_NE(logged[0].file.find("test_logging_manager.cpp"), std::string::npos);
+    EXPECT_EQ(logged[0].line, expectedLine);
+    EXPECT_EQ(logged[0].function, "TestBody");
+    EXPECT_EQ(logged[1].category, "templates");
+    EXPECT_EQ(logged[1].message, "category message");
+}
+
+TEST_F(LoggingManagerTest, BlockPolicyLosesNothingUnderContention) {
+    manager().setMaxQueueSize(16);
+    manager().setOverflowPolicy(OverflowPolicy::Block);
+    manager().setAsyncMode(true);
+
+    constexpr int producers = 4;
+    constexpr int perProducer = 2000;
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([p] {
+            for (int i = 0; i < perProducer; ++i) {
+                manager().info(std::to_string(i), "producer" + std::to_string(p));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    manager().flush();
+
+    auto logged = entries();
+    ASSERT_EQ(logged.size(), static_cast<size_t>(producers * perProducer));
+
+    // Each producer's entries arrive in the order it logged them
+    std::map<std::string, int> next;
+    for (const auto& entry : logged) {
+        EXPECT_EQ(std::stoi(entry.message), next[entry.category]++);
+    }
+
+    auto metrics = manager().getMetrics();
+    EXPECT_EQ(metrics.droppedLogs, 0u);
+    EXPECT_EQ(metrics.totalLogs, static_cast<size_t>(producers * perProducer));
+    EXPECT_EQ(metrics.queueCapacity, 16u);
+    EXPECT_LE(metrics.maxQueueSize, 16u);
+    EXPECT_EQ(metrics.overflowPolicy, OverflowPolicy::Block);
+}
+
+TEST_F(LoggingManagerTest, DropPolicyCountsDiscardedEntries) {
+    manager().setMaxQueueSize(8);
+    manager().setAsyncMode(true);
+
+    // The writer is stuck in write() for the first entry, so at most 8 more fit
+    hold();
+    for (int i = 0; i < 100; ++i) {
+        manager().info("entry " + std::to_string(i));
+    }
+    auto metrics = manager().getMetrics();
+    release();
+    manager().flush();
+
+    EXPECT_GE(metrics.droppedLogs, 100u - 9u);
+    EXPECT_EQ(metrics.maxQueueSize, 8u);
+    EXPECT_EQ(entries().size() + metrics.droppedLogs, 100u);
+    EXPECT_EQ(manager().getMetrics().totalLogs, entries().size());
+}
+
+TEST_F(LoggingManagerTest, OversizedMessagesAreDeliveredIntact) {
+    manager().setAsyncMode(true);
+    std::string longMessage(1000, 'x');
+    manager().logWithMetadata(LogLevel::Info, "meta", "with metadata", {{"key", "value"}});
+    manager().warning(longMessage);
+    manager().flush();
+
+    auto logged = entries();
+    ASSERT_EQ(logged.size(), 2u);
+    EXPECT_EQ(logged[0].metadata.at("key"), "value");
+    EXPECT_EQ(logged[1].message, longMessage);
+    EXPECT_EQ(manager().getMetrics().overflowLogs, 1u);
+}
+
+TEST_F(LoggingManagerTest, StoppingDrainsTheQueue) {
+    manager().setAsyncMode(true);
+    std::thread::id producer;
+    std::thread([&producer] {
+        producer = std::this_thread::get_id();
+        for (int i = 0; i < 500; ++i) {
+            manager().debug("message");
+        }
+    }).join();
+    manager().setAsyncMode(false);
+    auto logged = entries();
+    EXPECT_EQ(logged.size(), 500u);
+
+    // However late an entry is written, it keeps the thread that logged it
+    for (const auto& entry : logged) {
+        EXPECT_EQ(entry.threadId, producer);
+    }
+
+    // Synchronous again: written before log() returns
+    manager().error("sync");
+    EXPECT_EQ(entries().back().message, "sync");
+}
+
+TEST_F(LoggingManagerTest, RestartingWhileProducersLogLosesNothing) {
+    manager().setOverflowPolicy(OverflowPolicy::Block);
+
+    constexpr int producers = 8;
+    constexpr int perProducer = 5000;
+    std::atomic<int> finished{0};
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([p, &finished] {
+            for (int i = 0; i < perProducer; ++i) {
+                manager().info(std::to_string(i), "producer" + std::to_string(p));
+            }
+            ++finished;
+        });
+    }
+
+    // Each restart with a different size replaces the ring under the producers
+    for (size_t round = 0; finished.load() < producers; ++round) {
+        manager().setMaxQueueSize(round % 2 ? 8 : 64);
+        manager().setAsyncMode(true);
+        manager().getMetrics();
+        manager().setAsyncMode(false);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    std::map<std::string, std::set<int>> seen;
+    for (const auto& entry : entries()) {
+        EXPECT_TRUE(seen[entry.category].insert(std::stoi(entry.message)).second);
+    }
+    ASSERT_EQ(seen.size(), static_cast<size_t>(producers));
+    for (const auto& [category, messages] : seen) {
+        EXPECT_EQ(messages.size(), static_cast<size_t>(perProducer)) << category;
+    }
+}
+
+TEST_F(LoggingManagerTest, LevelsFilterBeforeQueueing) {
+    manager().setLogLevel(LogLevel::Warning);
+    manager().setCategoryLogLevel("chatty", LogLevel::Error);
+    manager().setAsyncMode(true);
+
+    manager().info("filtered");
+    manager().warning("kept");
+    manager().warning("filtered", "chatty");
+    manager().error("kept", "chatty");
+    manager().flush();
+
+    auto logged = entries();
+    ASSERT_EQ(logged.size(), 2u);
+    EXPECT_EQ(manager().getMetrics().totalLogs, 2u);
+    manager().setCategoryLogLevel("chatty", LogLevel::Trace);
+}
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+
+#include "utils/core/process_runner.h"
+
+using namespace utils;
+
+class ProcessRunnerTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        testDir = std::filesystem::temp_directory_path() / "cpp_scaffold_process_runner_test";
+        std::filesystem::create_directories(testDir);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(testDir);
+    }
+
+    std::filesystem::path testDir;
+};
+
+#ifndef _WIN32
+TEST_F(ProcessRunnerTest, CapturesOutputAndStatus) {
+    auto result = ProcessRunner::run({"sh", "-c", "echo out; echo err >&2; exit 3"});
+    ASSERT_TRUE(result.started);
+    EXPECT_EQ(3, result.exitCode);
+    EXPECT_FALSE(result.success());
+    EXPECT_EQ("out\n", result.output);
+    EXPECT_EQ("err\n", result.error);
+
+    ProcessOptions merged;
+    merged.mergeStderr = true;
+    result = ProcessRunner::run({"sh", "-c", "echo out; echo err >&2"}, merged);
+    EXPECT_TRUE(result.success());
+    EXPECT_EQ("out\nerr\n", result.output);
+}
+
+TEST_F(ProcessRunnerTest, PassesArgumentsVerbatim) {
+    auto result = ProcessRunner::run({"printf", "%s|", "a b", "$HOME", "\"quoted\""});
+    EXPECT_TRUE(result.success());
+    EXPECT_EQ("a b|$HOME|\"quoted\"|", result.output);
+
+    ProcessOptions options;
+    options.workingDirectory = testDir;
+    options.environment["CPP_SCAFFOLD_TEST_VAR"] = "value";
+    result = ProcessRunner::run({"sh", "-c", "pwd; echo $CPP_SCAFFOLD_TEST_VAR"}, options);
+    EXPECT_TRUE(result.success());
+    EXPECT_EQ(std::filesystem::canonical(testDir).string() + "\nvalue\n", result.output);
+}
+
+TEST_F(ProcessRunnerTest, HandlesLargeOutputAndTimeouts) {
+    // More than a pipe buffer on both streams must not stall the child
+    auto result = ProcessRunner::run(
+            {"sh", "-c", "head -c 300000 /dev/zero; head -c 200000 /dev/zero >&2"});
+    EXPECT_TRUE(result.success());
+    EXPECT_EQ(300000u, result.output.size());
+    EXPECT_EQ(200000u, result.error.size());
+
+    ProcessOptions options;
+    options.timeout = std::chrono::milliseconds(200);
+    auto start = std::chrono::steady_clock::now();
+    result = ProcessRunner::run({"sleep", "10"}, options);
+    EXPECT_TRUE(result.timedOut);
+    EXPECT_FALSE(result.success());
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+
+    result = ProcessRunner::run({"definitely-missing-tool"});
+    EXPECT_FALSE(result.started);
+    EXPECT_FALSE(result.errorMessage.empty());
+}
+#endif
@@ -0,0 +1,200 @@
+#include <gtest/gtest.h>
+#include "utils/ui/progress_indicator.h"
+
+#include <chrono>
+#include <filesystem>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace utils;
+
+class ProgressIndicatorTest : public ::testing::Test {
+protected:
+    void TearDown() override { renderer().resetOutput(); }
+
+    static ProgressRenderer& renderer() { return ProgressRenderer::getInstance(); }
+
+    static size_t countOf(const std::string& text, const std::string& needle) {
+        size_t count = 0;
+        for (size_t pos = text.find(needle); pos != std::string::npos;
+             pos = text.find(needle, pos + needle.size())) {
+            ++count;
+        }
+        return count;
+    }
+
+    std::ostringstream output;
+};
+
+TEST_F(ProgressIndicatorTest, NonInteractiveOutputSkipsFrames) {
+    renderer().setOutput(output, false);
+    size_t framesBefore = renderer().framesWritten();
+
+    SpinnerIndicator spinner;
+    spinner.start("Working");
+    for (int i = 0; i < 10; ++i) {
+        spinner.update(i / 10.0, "Step " + std::to_string(i));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_TRUE(output.str().empty());
+
+    spinner.finish("Done");
+    EXPECT_EQ(renderer().framesWritten(), framesBefore);
+    EXPECT_EQ(renderer().activeIndicators(), 0u);
+
+    // Only the completion line reaches the log
+    EXPECT_EQ(countOf(output.str(), "\n"), 1u);
+    EXPECT_NE(output.str().find("Done"), std::string::npos);
+    EXPECT_EQ(output.str().find('\033'), std::string::npos);
+}
+
+TEST_F(ProgressIndicatorTest, FramesRewriteOnlyChangedLines) {
+    renderer().setOutput(output, true, false);
+
+    ProgressBarIndicator first(10);
+    ProgressBarIndicator second(10);
+    first.start("first");
+    second.start("second");
+
+    renderer().renderFrame();
+    EXPECT_NE(output.str().find("first"), std::string::npos);
+    EXPECT_NE(output.str().find("second"), std::string::npos);
+
+    // Nothing changed: nothing is written
+    output.str("");
+    renderer().renderFrame();
+    EXPECT_TRUE(output.str().empty());
+
+    // Only the second line is rewritten; the cursor moves up over it alone
+    second.update(0.5);
+    renderer().renderFrame();
+    std::string diff = output.str();
+    EXPECT_EQ(diff.rfind("\r\033[1A", 0), 0u);
+    EXPECT_EQ(diff.find("first"), std::string::npos);
+    EXPECT_NE(diff.find("50.0%"), std::string::npos);
+
+    // Updates between frames are coalesced into one write
+    output.str("");
+    for (int i = 1; i <= 10; ++i) {
+        first.update(i / 10.0);
+        second.update(i / 10.0);
+    }
+    size_t framesBefore = renderer().framesWritten();
+    renderer().renderFrame();
+    EXPECT_EQ(renderer().framesWritten(), framesBefore + 1);
+    EXPECT_EQ(countOf(output.str(), "100.0%"), 2u);
+    EXPECT_EQ(countOf(output.str(), "%"), 2u);
+
+    first.stop();
+    second.stop();
+}
+
+TEST_F(ProgressIndicatorTest, FinishPrintsAboveTheLiveFrame) {
+    renderer().setOutput(output, true, false);
+
+    SpinnerIndicator spinner;
+    MultiStepIndicator steps;
+    steps.addStep("configure");
+    steps.addStep("build");
+    spinner.start("spinning");
+    steps.start();
+    steps.startStep("configure");
+    renderer().renderFrame();
+
+    output.str("");
+    spinner.finish("spun");
+
+    // Frame cleared, completion line printed, remaining indicator redrawn
+    std::string text = output.str();
+    EXPECT_EQ(text.rfind("\r\033[3A\033[J", 0), 0u);
+    size_t finished = text.find("spun");
+    size_t redrawn = text.find("configure");
+    ASSERT_NE(finished, std::string::npos);
+    ASSERT_NE(redrawn, std::string::npos);
+    EXPECT_LT(finished, redrawn);
+    EXPECT_EQ(text.find("spinning"), std::string::npos);
+    EXPECT_EQ(renderer().activeIndicators(), 1u);
+
+    steps.finish();
+    EXPECT_EQ(renderer().activeIndicators(), 0u);
+}
+
+TEST_F(ProgressIndicatorTest, ForeignOutputLandsAboveTheLiveFrame) {
+    renderer().setOutput(output, true, false);
+
+    SpinnerIndicator spinner;
+    spinner.start("spinning");
+    renderer().renderFrame();
+
+    // A whole line written straight to the stream moves above the frame
+    output.str("");
+    output << "foreign " << 42 << "\n";
+    std::string text = output.str();
+    EXPECT_EQ(text.rfind("\r\033[1A\033[J", 0), 0u);
+    size_t foreign = text.find("foreign 42\n");
+    size_t redrawn = text.find("spinning");
+    ASSERT_NE(foreign, std::string::npos);
+    ASSERT_NE(redrawn, std::string::npos);
+    EXPECT_LT(foreign, redrawn);
+
+    // Writers that bypass the stream get the same treatment
+    output.str("");
+    renderer().writeAboveFrame([] {});
+    text = output.str();
+    EXPECT_EQ(text.rfind("\r\033[1A\033[J", 0), 0u);
+    EXPECT_NE(text.find("spinning"), std::string::npos);
+
+    // An unfinished line holds frames back until its newline arrives
+    output.str("");
+    output << "prompt: " << std::flush;
+    renderer().renderFrame();
+    EXPECT_EQ(output.str(), "\r\033[1A\033[Jprompt: ");
+    output << "answer\n";
+    text = output.str();
+    ASSERT_NE(text.find("spinning"), std::string::npos);
+    EXPECT_LT(text.find("prompt: answer\n"), text.find("spinning"));
+
+    // Once the last indicator ends the stream is left alone again
+    spinner.stop();
+    output.str("");
+    output << "plain\n";
+    EXPECT_EQ(output.str(), "plain\n");
+}
+
+#ifdef __linux__
+TEST_F(ProgressIndicatorTest, SpinnersShareOneRenderThread) {
+    auto threadCount = [] {
+        size_t count = 0;
+        for (const auto& entry : std::filesystem::directory_iterator("/proc/self/task")) {
+            (void)entry;
+            ++count;
+        }
+        return count;
+    };
+
+    renderer().setOutput(output, true);
+    renderer().setTargetFps(60);
+
+    // The render thread may already exist from an earlier test
+    SpinnerIndicator warmup;
+    warmup.start("warmup");
+    size_t baseline = threadCount();
+
+    std::vector<std::unique_ptr<SpinnerIndicator>> spinners;
+    for (int i = 0; i < 8; ++i) {
+        spinners.push_back(std::make_unique<SpinnerIndicator>());
+        spinners.back()->start("spinner " + std::to_string(i));
+    }
+    EXPECT_EQ(threadCount(), baseline);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    spinners.clear();
+    warmup.stop();
+    renderer().setTargetFps(15);
+
+    EXPECT_GT(renderer().framesWritten(), 0u);
+    EXPECT_EQ(renderer().activeIndicators(), 0u);
+}
+#endif
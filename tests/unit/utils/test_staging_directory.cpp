@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "utils/core/file_utils.h"
+#include "utils/core/process_runner.h"
+#include "utils/core/staging_directory.h"
+#include "utils/core/tool_registry.h"
+
+using namespace utils;
+
+class StagingDirectoryTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        testDir = std::filesystem::temp_directory_path() / "cpp_scaffold_staging_directory_test";
+        std::filesystem::create_directories(testDir);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(testDir);
+    }
+
+    std::filesystem::path testDir;
+};
+
+TEST_F(StagingDirectoryTest, PublishesOnlyOnCommit) {
+    auto target = testDir / "projects" / "app";
+    std::string error;
+    {
+        StagingDirectory staging(target);
+        ASSERT_TRUE(staging.begin(error)) << error;
+
+        // Writes through the target path land in the staging tree
+        ASSERT_TRUE(FileUtils::writeToFile((target / "src" / "main.cpp").string(), "int main() {}"));
+        if (staging.isRedirected()) {
+            EXPECT_TRUE(std::filesystem::is_symlink(target));
+            EXPECT_TRUE(std::filesystem::exists(staging.stagingPath() / "src" / "main.cpp"));
+        }
+
+        ASSERT_TRUE(staging.commit(error)) << error;
+        EXPECT_EQ(target, staging.stagingPath());
+    }
+    EXPECT_FALSE(std::filesystem::is_symlink(target));
+    EXPECT_EQ("int main() {}", FileUtils::readFromFile((target / "src" / "main.cpp").string()));
+    EXPECT_EQ(1, std::distance(std::filesystem::directory_iterator(testDir / "projects"),
+                               std::filesystem::directory_iterator()));
+
+    // Never replaces an existing directory
+    StagingDirectory again(target);
+    EXPECT_FALSE(again.begin(error));
+    EXPECT_TRUE(std::filesystem::exists(target / "src" / "main.cpp"));
+}
+
+TEST_F(StagingDirectoryTest, RollsBackWholeTree) {
+    auto target = testDir / "failed";
+    std::string error;
+    {
+        StagingDirectory staging(target);
+        ASSERT_TRUE(staging.begin(error)) << error;
+        for (int i = 0; i < 20; ++i) {
+            FileUtils::writeToFile((target / ("dir" + std::to_string(i % 4)) /
+                                    ("file" + std::to_string(i) + ".txt"))
+                                           .string(),
+                                   "partial");
+        }
+        // Destroyed without commit
+    }
+    EXPECT_FALSE(std::filesystem::exists(std::filesystem::symlink_status(target)));
+    EXPECT_TRUE(std::filesystem::is_empty(testDir));
+
+#ifndef _WIN32
+    // Trees left by a process that died mid-generation are cleared on the next attempt
+    auto stale = testDir / ".failed.staging-999999999-0";
+    std::filesystem::create_directories(stale / "src");
+    std::filesystem::create_directory_symlink(stale.filename(), target);
+    StagingDirectory retry(target);
+    ASSERT_TRUE(retry.begin(error)) << error;
+    EXPECT_FALSE(std::filesystem::exists(stale));
+    EXPECT_TRUE(retry.rollback());
+    EXPECT_TRUE(std::filesystem::is_empty(testDir));
+#endif
+}
+
+#ifndef _WIN32
+TEST_F(StagingDirectoryTest, ToolsRunBeforeCommitLeaveNoStagingPath) {
+    if (!ToolRegistry::getInstance().isAvailable("git")) {
+        GTEST_SKIP() << "git CLI unavailable";
+    }
+    auto target = testDir / "tooled";
+    std::string error;
+    StagingDirectory staging(target);
+    ASSERT_TRUE(staging.begin(error)) << error;
+    if (!staging.isRedirected()) {
+        GTEST_SKIP() << "Symlinks unavailable; generating in place";
+    }
+    std::string stagingName = staging.stagingPath().filename().string();
+    ASSERT_TRUE(FileUtils::writeToFile((target / "src" / "main.cpp").string(), "int main() {}"));
+
+    // Children do see the staging directory as their working directory
+    ProcessOptions options;
+    options.workingDirectory = target;
+    auto cwd = ProcessRunner::run({"pwd", "-P"}, options);
+    EXPECT_NE(std::string::npos, cwd.output.find(stagingName));
+
+    // The way templates drive git
+    for (std::vector<std::string> args :
+         {std::vector<std::string>{"git", "init", "--quiet"}, {"git", "add", "."},
+          {"git", "-c", "user.name=Test", "-c", "user.email=test@example.com", "commit",
+           "--quiet", "-m", "Initial commit"}}) {
+        ASSERT_TRUE(ProcessRunner::run(args, options).success()) << args[1];
+    }
+    ASSERT_TRUE(staging.commit(error)) << error;
+
+    // Neither the generated files nor git's own metadata name the staging path
+    std::error_code ec;
+    for (std::filesystem::recursive_directory_iterator it(target, ec), end; !ec && it != end;
+         it.increment(ec)) {
+        if (it->is_regular_file()) {
+            std::ifstream file(it->path(), std::ios::binary);
+            std::string content{std::istreambuf_iterator<char>(file), {}};
+            EXPECT_EQ(std::string::npos, content.find(stagingName)) << it->path();
+        }
+    }
+    options.workingDirectory = target;
+    auto status = ProcessRunner::run({"git", "status", "--porcelain"}, options);
+    EXPECT_TRUE(status.success());
+    EXPECT_EQ("", status.output);
+}
+#endif
@@ -1,5 +1,11 @@
 #include <gtest/gtest.h>
+#include "utils/core/byte_scan.h"
 #include "utils/core/string_utils.h"
+#include "utils/core/template_compiler.h"
+
+#include <algorithm>
+#include <iterator>
+#include <random>
 
 using namespace utils;
 
@@ -151,3 +157,195 @@ TEST_F(StringUtilsTest, UnicodeHandling) {
     EXPECT_TRUE(StringUtils::startsWith("Hello 世界", "Hello"));
     EXPECT_TRUE(StringUtils::endsWith("Hello 世界", "世界"));
 }
+
+TEST_F(StringUtilsTest, ReplacePlaceholders) {
+    std::unordered_map<std::string, std::string> vars = {
+            {"NAME", "demo"}, {"VERSION", "1.2.3"}, {"EMPTY", ""}};
+
+    EXPECT_EQ("demo v1.2.3", StringUtils::replacePlaceholders("{{NAME}} v{{VERSION}}", vars));
+    EXPECT_EQ("demo-demo", StringUtils::replacePlaceholders("{{NAME}}-{{NAME}}", vars));
+    EXPECT_EQ("[]", StringUtils::replacePlaceholders("[{{EMPTY}}]", vars));
+    EXPECT_EQ("no placeholders", StringUtils::replacePlaceholders("no placeholders", vars));
+    EXPECT_EQ("", StringUtils::replacePlaceholders("", vars));
+
+    // Unknown, empty and unterminated placeholders are left untouched
+    EXPECT_EQ("{{UNKNOWN}} demo", StringUtils::replacePlaceholders("{{UNKNOWN}} {{NAME}}", vars));
+    EXPECT_EQ("{{}} {{NAME", StringUtils::replacePlaceholders("{{}} {{NAME", vars));
+    EXPECT_EQ("{demo", StringUtils::replacePlaceholders("{{{NAME}}", vars));
+
+    // Substituted values are not expanded again
+    vars["NESTED"] = "{{NAME}}";
+    EXPECT_EQ("{{NAME}}", StringUtils::replacePlaceholders("{{NESTED}}", vars));
+}
+
+TEST_F(StringUtilsTest, ExtractPlaceholders) {
+    auto names = StringUtils::extractPlaceholders("{a} and {b} and {a}");
+    ASSERT_EQ(3, names.size());
+    EXPECT_EQ("a", names[0]);
+    EXPECT_EQ("b", names[1]);
+    EXPECT_EQ("a", names[2]);
+
+    names = StringUtils::extractPlaceholders("{{PROJECT_NAME}}/{{YEAR}}", "{{", "}}");
+    ASSERT_EQ(2, names.size());
+    EXPECT_EQ("PROJECT_NAME", names[0]);
+    EXPECT_EQ("YEAR", names[1]);
+}
+
+TEST_F(StringUtilsTest, CompiledTemplateMatchesSequentialReplace) {
+    std::string source =
+            "// {{PROJECT_NAME}} {{VERSION}}\n#include \"{{PROJECT_NAME}}.h\"\n{{MISSING}}\n";
+    std::unordered_map<std::string, std::string> vars = {{"PROJECT_NAME", "app"},
+                                                         {"VERSION", "0.1"}};
+
+    std::string expected = source;
+    for (const auto& [name, value] : vars) {
+        expected = StringUtils::replace(expected, "{{" + name + "}}", value);
+    }
+
+    auto compiled = CompiledTemplate::compile(source);
+    EXPECT_TRUE(compiled.hasPlaceholders());
+    EXPECT_EQ(expected, compiled.render(vars));
+    // Rendering is repeatable from the same compiled form
+    EXPECT_EQ(expected, compiled.render(vars));
+
+    std::string output = "prefix:";
+    compiled.renderInto(output, [&vars](const std::string& name) -> const std::string* {
+        auto it = vars.find(name);
+        return it != vars.end() ? &it->second : nullptr;
+    });
+    EXPECT_EQ("prefix:" + expected, output);
+
+    EXPECT_FALSE(CompiledTemplate::compile("plain text").hasPlaceholders());
+}
+
+TEST_F(StringUtilsTest, LevenshteinDistance) {
+    EXPECT_EQ(0u, StringUtils::levenshteinDistance("", ""));
+    EXPECT_EQ(3u, StringUtils::levenshteinDistance("", "abc"));
+    EXPECT_EQ(3u, StringUtils::levenshteinDistance("kitten", "sitting"));
+    EXPECT_EQ(3u, StringUtils::levenshteinDistance("sitting", "kitten"));
+    EXPECT_EQ(1u, StringUtils::levenshteinDistance("console", "consol"));
+}
+
+// Runs the body once per instruction set this CPU supports and restores the default
+class ByteScanTest : public ::testing::Test {
+protected:
+    void TearDown() override { ByteScan::setIsa(ByteScan::detectIsa()); }
+
+    static std::vector<ScanIsa> supportedIsas() {
+        std::vector<ScanIsa> isas;
+        for (ScanIsa isa : {ScanIsa::Scalar, ScanIsa::SSE2, ScanIsa::AVX2}) {
+            if (ByteScan::setIsa(isa) == isa) {
+                isas.push_back(isa);
+            }
+        }
+        return isas;
+    }
+
+    // Bytes from a small alphabet so needles and newlines match often
+    static std::string randomText(std::mt19937& rng, size_t length) {
+        static const char alphabet[] = "ab\n\r \xC3\xA9";
+        std::uniform_int_distribution<size_t> pick(0, sizeof(alphabet) - 2);
+        std::string text(length, '\0');
+        for (char& c : text) {
+            c = alphabet[pick(rng)];
+        }
+        return text;
+    }
+
+    // Mostly well-formed UTF-8 with the occasional random byte
+    static std::string randomUtf8(std::mt19937& rng, size_t codePoints) {
+        static const char* pieces[] = {"a", "z\n", "\xC3\xA9", "\xE4\xB8\x96", "\xF0\x9F\x9A\x80",
+                                       "\xED\x9F\xBF", "\xF4\x8F\xBF\xBF"};
+        std::uniform_int_distribution<size_t> pick(0, std::size(pieces) - 1);
+        std::uniform_int_distribution<int> byte(0, 255);
+        std::uniform_int_distribution<int> corrupt(0, 199);
+        std::string text;
+        for (size_t i = 0; i < codePoints; ++i) {
+            text += corrupt(rng) == 0 ? std::string(1, static_cast<char>(byte(rng)))
+                                      : std::string(pieces[pick(rng)]);
+        }
+        return text;
+    }
+};
+
+TEST_F(ByteScanTest, KernelsMatchTheScalarPathOnRandomInput) {
+    auto isas = supportedIsas();
+    ASSERT_FALSE(isas.empty());
+    std::mt19937 rng(20240601);
+    std::uniform_int_distribution<size_t> lengths(0, 300);
+    std::uniform_int_distribution<size_t> needleLengths(1, 5);
+
+    for (int round = 0; round < 2000; ++round) {
+        // Slicing a larger buffer varies the alignment the kernels start from
+        std::string buffer = randomText(rng, lengths(rng) + 64);
+        size_t offset = std::uniform_int_distribution<size_t>(0, 63)(rng);
+        std::string_view text = std::string_view(buffer).substr(offset);
+        std::string needle = randomText(rng, needleLengths(rng));
+        size_t from = std::uniform_int_distribution<size_t>(0, text.size() + 1)(rng);
+        char byte = needle[0];
+
+        size_t expectedCount = static_cast<size_t>(std::count(text.begin(), text.end(), byte));
+        size_t expectedByte = text.find(byte, from);
+        size_t expectedNeedle = text.find(needle, from);
+        for (ScanIsa isa : isas) {
+            ByteScan::setIsa(isa);
+            SCOPED_TRACE(ByteScan::isaName(isa));
+            ASSERT_EQ(expectedCount, ByteScan::count(text, byte));
+            ASSERT_EQ(expectedByte, ByteScan::find(text, byte, from));
+            ASSERT_EQ(expectedNeedle, ByteScan::find(text, needle, from));
+        }
+
+        std::string utf8 = randomUtf8(rng, lengths(rng));
+        ByteScan::setIsa(ScanIsa::Scalar);
+        bool expectedValid = ByteScan::isValidUtf8(utf8);
+        for (ScanIsa isa : isas) {
+            ByteScan::setIsa(isa);
+            SCOPED_TRACE(ByteScan::isaName(isa));
+            ASSERT_EQ(expectedValid, ByteScan::isValidUtf8(utf8));
+        }
+    }
+}
+
+TEST_F(ByteScanTest, CountsPastTheByteCounterWidth) {
+    // Long enough that the vector kernels fold their 8-bit lane counters
+    std::string text(100000, '\n');
+    text[12345] = 'x';
+    for (ScanIsa isa : supportedIsas()) {
+        ByteScan::setIsa(isa);
+        EXPECT_EQ(99999u, ByteScan::count(text, '\n')) << ByteScan::isaName(isa);
+        EXPECT_EQ(12345u, ByteScan::find(text, 'x')) << ByteScan::isaName(isa);
+        EXPECT_EQ(99999u, StringUtils::countLines(text)) << ByteScan::isaName(isa);
+    }
+}
+
+TEST_F(ByteScanTest, Utf8ValidationIsStrict) {
+    for (ScanIsa isa : supportedIsas()) {
+        ByteScan::setIsa(isa);
+        SCOPED_TRACE(ByteScan::isaName(isa));
+        std::string ascii(100, 'a');
+        EXPECT_TRUE(StringUtils::isValidUtf8(""));
+        EXPECT_TRUE(StringUtils::isValidUtf8(ascii + "Hello 世界 🚀 Café"));
+        EXPECT_FALSE(StringUtils::isValidUtf8(ascii + "\xC0\xAF"));          // overlong '/'
+        EXPECT_FALSE(StringUtils::isValidUtf8(ascii + "\xE0\x80\xAF"));      // overlong
+        EXPECT_FALSE(StringUtils::isValidUtf8(ascii + "\xED\xA0\x80"));      // surrogate
+        EXPECT_FALSE(StringUtils::isValidUtf8(ascii + "\xF4\x90\x80\x80"));  // above U+10FFFF
+        EXPECT_FALSE(StringUtils::isValidUtf8(ascii + "\xE4\xB8"));          // truncated
+        EXPECT_FALSE(StringUtils::isValidUtf8("\x80" + ascii));              // lone continuation
+    }
+}
+
+TEST_F(StringUtilsTest, LineAndOccurrenceHelpers) {
+    EXPECT_EQ(0u, StringUtils::countLines(""));
+    EXPECT_EQ(1u, StringUtils::countLines("one"));
+    EXPECT_EQ(2u, StringUtils::countLines("one\r\ntwo\n"));
+    EXPECT_EQ((std::vector<std::string>{"one", "", "two"}),
+              StringUtils::splitLines("one\r\n\ntwo\n"));
+    EXPECT_TRUE(StringUtils::splitLines("").empty());
+
+    EXPECT_EQ(3u, StringUtils::countOccurrences("a,b,c,", ','));
+    EXPECT_EQ(2u, StringUtils::countOccurrences("aaaa", "aa"));
+    EXPECT_EQ(0u, StringUtils::countOccurrences("aaaa", ""));
+    EXPECT_EQ((std::vector<size_t>{0, 8}),
+              StringUtils::findAllOccurrences("{{x}} y {{x}}", "{{x}}"));
+    EXPECT_TRUE(StringUtils::findAllOccurrences("abc", "abcd").empty());
+}
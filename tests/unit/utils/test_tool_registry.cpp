@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "utils/core/system_utils.h"
+#include "utils/core/tool_registry.h"
+
+using namespace utils;
+
+class ToolRegistryTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        testDir = std::filesystem::temp_directory_path() / "cpp_scaffold_tool_registry_test";
+        std::filesystem::create_directories(testDir);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(testDir);
+    }
+
+    std::filesystem::path testDir;
+};
+
+#ifndef _WIN32
+namespace {
+// Points PATH at a single directory for the lifetime of the guard
+class ScopedPath {
+   public:
+    explicit ScopedPath(const std::filesystem::path& dir) {
+        const char* old = std::getenv("PATH");
+        original_ = old ? old : "";
+        setenv("PATH", dir.c_str(), 1);
+    }
+    ~ScopedPath() {
+        setenv("PATH", original_.c_str(), 1);
+    }
+
+   private:
+    std::string original_;
+};
+
+void writeScript(const std::filesystem::path& path, const std::string& body) {
+    std::ofstream(path) << "#!/bin/sh\n" << body << "\n";
+    std::filesystem::permissions(path, std::filesystem::perms::owner_all);
+}
+}  // namespace
+
+TEST_F(ToolRegistryTest, ResolvesFromPath) {
+    auto bin = testDir / "bin";
+    std::filesystem::create_directories(bin);
+    writeScript(bin / "fake-tool", "echo 'fake-tool version 1.2.3'");
+    std::ofstream(bin / "not-executable") << "data";
+    ScopedPath path(bin);
+
+    ToolRegistry registry;
+    auto found = registry.find("fake-tool");
+    ASSERT_TRUE(found.has_value());
+    EXPECT_EQ(bin / "fake-tool", *found);
+    EXPECT_FALSE(registry.isAvailable("not-executable"));
+    EXPECT_FALSE(registry.isAvailable("definitely-missing-tool"));
+    EXPECT_EQ(" 1.2.3", registry.version("fake-tool"));
+}
+
+TEST_F(ToolRegistryTest, ProbesWithoutAShell) {
+    // Quotes and $ in the directory name would break a quoted shell command
+    auto bin = testDir / "it's \"$HOME\" bin";
+    auto cacheFile = testDir / "cache" / "tools.json";
+    std::filesystem::create_directories(bin);
+    writeScript(bin / "fake-tool", "echo 'fake-tool version 3.1'");
+    ScopedPath path(bin);
+
+    ToolRegistry registry;
+    registry.enablePersistence(cacheFile);
+    EXPECT_EQ(" 3.1", registry.version("fake-tool"));
+    EXPECT_TRUE(registry.save());
+
+    // The temporary file was renamed into place, not left behind
+    size_t cacheFiles = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(cacheFile.parent_path())) {
+        EXPECT_EQ(cacheFile, entry.path());
+        ++cacheFiles;
+    }
+    EXPECT_EQ(1u, cacheFiles);
+}
+
+TEST_F(ToolRegistryTest, FailedSaveLeavesNoTemporaryFile) {
+    auto bin = testDir / "bin";
+    auto cacheFile = testDir / "cache" / "tools.json";
+    std::filesystem::create_directories(bin);
+    writeScript(bin / "fake-tool", "echo 'fake-tool version 1.0'");
+    // A non-empty directory in place of the cache file makes the rename fail
+    std::filesystem::create_directories(cacheFile / "occupied");
+    ScopedPath path(bin);
+
+    ToolRegistry registry;
+    registry.enablePersistence(cacheFile);
+    EXPECT_TRUE(registry.isAvailable("fake-tool"));
+    EXPECT_FALSE(registry.save());
+    for (const auto& entry : std::filesystem::directory_iterator(cacheFile.parent_path())) {
+        EXPECT_EQ(cacheFile, entry.path());
+    }
+}
+
+TEST_F(ToolRegistryTest, PersistsLookups) {
+    auto bin = testDir / "bin";
+    auto cacheFile = testDir / "cache" / "tools.json";
+    std::filesystem::create_directories(bin);
+    writeScript(bin / "fake-tool", "echo 'fake-tool version 1.0'");
+    ScopedPath path(bin);
+
+    {
+        ToolRegistry registry;
+        registry.enablePersistence(cacheFile);
+        EXPECT_EQ(" 1.0", registry.version("fake-tool"));
+        EXPECT_FALSE(registry.isAvailable("other-tool"));
+        EXPECT_TRUE(registry.save());
+    }
+    ASSERT_TRUE(std::filesystem::exists(cacheFile));
+
+    // Same mtime means the cached version is trusted without running the tool
+    auto mtime = std::filesystem::last_write_time(bin / "fake-tool");
+    writeScript(bin / "fake-tool", "echo 'fake-tool version 2.0'");
+    std::filesystem::last_write_time(bin / "fake-tool", mtime);
+    {
+        ToolRegistry registry;
+        registry.enablePersistence(cacheFile);
+        EXPECT_EQ(" 1.0", registry.version("fake-tool"));
+    }
+
+    // A modified executable is probed again
+    std::filesystem::last_write_time(bin / "fake-tool", mtime + std::chrono::seconds(5));
+    {
+        ToolRegistry registry;
+        registry.enablePersistence(cacheFile);
+        EXPECT_EQ(" 2.0", registry.version("fake-tool"));
+    }
+
+    // Installing a tool into a PATH directory invalidates cached misses
+    writeScript(bin / "other-tool", "true");
+    std::filesystem::last_write_time(bin, std::filesystem::file_time_type::clock::now() +
+                                                  std::chrono::seconds(10));
+    {
+        ToolRegistry registry;
+        registry.enablePersistence(cacheFile);
+        EXPECT_TRUE(registry.isAvailable("other-tool"));
+    }
+}
+
+TEST_F(ToolRegistryTest, SystemUtilsLookupsGoThroughTheRegistry) {
+    auto bin = testDir / "bin";
+    std::filesystem::create_directories(bin);
+    writeScript(bin / "fake-tool", "echo 'fake-tool version 4.5'");
+    ScopedPath path(bin);
+
+    // Links the SystemUtils side of the registry into the executable
+    auto environment = SystemUtils::getAllEnvironmentVariables();
+    EXPECT_EQ(bin.string(), environment["PATH"]);
+    EXPECT_EQ(std::vector<std::filesystem::path>{bin}, SystemUtils::getPathDirectories());
+    EXPECT_TRUE(SystemUtils::isToolAvailable("fake-tool"));
+    EXPECT_EQ(bin / "fake-tool", SystemUtils::findToolInPath("fake-tool"));
+    EXPECT_FALSE(SystemUtils::isToolAvailable("definitely-missing-tool"));
+}
+#endif